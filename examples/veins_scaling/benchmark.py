@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+
+#
+# Copyright (C) 2026 Veins contributors
+#
+# Documentation for these modules is at http://veins.car2x.org/
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""
+Runs the configurations of the scaling benchmark and reports their performance
+
+Requires the scenarios to have been generated by generate.py and veins_launchd to be listening for connections.
+"""
+
+import argparse
+import csv
+import glob
+import os
+import re
+import subprocess
+import sys
+import time
+
+CONFIGS = ['Grid1k', 'Grid5k', 'Grid10k', 'Grid20k', 'Highway1k', 'Highway5k', 'Highway10k', 'Highway20k']
+FIELDS = ['config', 'fes', 'events', 'sim_time', 'wall_time', 'events_per_second', 'wall_time_per_sim_second', 'peak_rss_mib', 'traci_time_share']
+
+
+def read_scalar(sca_file, name):
+    """Sum the values of all scalars called name in sca_file"""
+    total = 0.0
+    with open(sca_file) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 4 and fields[0] == 'scalar' and fields[2] == name:
+                total += float(fields[3])
+    return total
+
+
+def run_config(config, fes, extra_args):
+    for sca_file in glob.glob(os.path.join('results', config + '-*.sca')):
+        os.remove(sca_file)
+
+    cmdline = ['./run', '-u', 'Cmdenv', '-c', config, '-r', '0'] + extra_args
+    if fes:
+        cmdline.append('--futureeventset-class=%s' % fes)
+    start = time.monotonic()
+    process = subprocess.Popen(cmdline, stdout=subprocess.PIPE, universal_newlines=True)
+    output = process.stdout.read()
+    _, status, rusage = os.wait4(process.pid, 0)
+    wall_time = time.monotonic() - start
+    if status != 0:
+        sys.stderr.write(output)
+        raise RuntimeError('%s failed with exit status %d' % (' '.join(cmdline), status))
+
+    # Cmdenv reports e.g. "<!> Simulation time limit reached -- at t=100s, event #123456"
+    match = re.findall(r'at t=([0-9.e+-]+)s?, event #([0-9]+)', output)
+    if not match:
+        raise RuntimeError('could not find the number of events in the output of %s' % config)
+    sim_time = float(match[-1][0])
+    events = int(match[-1][1])
+
+    sca_files = glob.glob(os.path.join('results', config + '-*.sca'))
+    traci_time = read_scalar(sca_files[0], 'traciStepWallTime') if sca_files else float('nan')
+
+    return {
+        'config': config,
+        'fes': fes or 'default',
+        'events': events,
+        'sim_time': sim_time,
+        'wall_time': wall_time,
+        'events_per_second': events / wall_time,
+        'wall_time_per_sim_second': wall_time / sim_time,
+        'peak_rss_mib': rusage.ru_maxrss / 1024.0,  # kiB on Linux
+        'traci_time_share': traci_time / wall_time,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('-c', '--configs', nargs='+', default=CONFIGS, help='configurations to run (default: %(default)s)')
+    parser.add_argument('-o', '--output', help='also write the results to this CSV file')
+    parser.add_argument('-f', '--fes', nargs='+', default=[None], metavar='CLASS', help='future event set classes to run every configuration with, e.g. omnetpp::cEventHeap veins::CalendarEventSet (default: that of omnetpp.ini)')
+    parser.add_argument('--', dest='arguments', help='arguments to pass to ./run')
+    args, extra_args = parser.parse_known_args()
+    if extra_args and extra_args[0] == '--':
+        extra_args = extra_args[1:]
+
+    os.chdir(os.path.dirname(os.path.realpath(__file__)))
+
+    results = []
+    writer = csv.DictWriter(sys.stdout, fieldnames=FIELDS)
+    writer.writeheader()
+    for config in args.configs:
+        for fes in args.fes:
+            result = run_config(config, fes, extra_args)
+            writer.writerow(result)
+            sys.stdout.flush()
+            results.append(result)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            writer = csv.DictWriter(f, fieldnames=FIELDS)
+            writer.writeheader()
+            writer.writerows(results)
+
+
+if __name__ == '__main__':
+    main()
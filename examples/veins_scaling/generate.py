@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+
+
+#
+# Copyright (C) 2026 Veins contributors
+#
+# Documentation for these modules is at http://veins.car2x.org/
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""
+Generates the SUMO scenarios of the scaling benchmark (requires SUMO_HOME to be set)
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+SEED = 42
+SIZES = [1000, 5000, 10000, 20000]
+DEPART_INTERVAL = 60  # all vehicles depart within this many seconds
+
+SUMO_CFG = """<?xml version="1.0" encoding="UTF-8"?>
+
+<configuration xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance" xsi:noNamespaceSchemaLocation="http://sumo.dlr.de/xsd/sumoConfiguration.xsd">
+
+    <input>
+        <net-file value="{net}"/>
+        <route-files value="{routes}"/>
+    </input>
+
+    <time>
+        <begin value="0"/>
+        <end value="1000"/>
+        <step-length value="0.1"/>
+    </time>
+
+    <random_number>
+        <seed value="{seed}"/>
+    </random_number>
+
+    <report>
+        <xml-validation value="never"/>
+        <xml-validation.net value="never"/>
+        <no-step-log value="true"/>
+    </report>
+
+</configuration>
+"""
+
+LAUNCHD_CFG = """<?xml version="1.0"?>
+
+<launch>
+    <copy file="{net}" />
+    <copy file="{routes}" />
+    <copy file="{cfg}" type="config" />
+</launch>
+"""
+
+HIGHWAY_NODES = """<?xml version="1.0" encoding="UTF-8"?>
+
+<nodes>
+{nodes}
+</nodes>
+"""
+
+HIGHWAY_EDGES = """<?xml version="1.0" encoding="UTF-8"?>
+
+<edges>
+{edges}
+</edges>
+"""
+
+
+def sumo_tool(*path):
+    if 'SUMO_HOME' not in os.environ:
+        sys.exit('Please set SUMO_HOME to the root of your SUMO installation')
+    return os.path.join(os.environ['SUMO_HOME'], *path)
+
+
+def sumo_binary(name):
+    path = sumo_tool('bin', name)
+    return path if os.path.exists(path) else name
+
+
+def make_grid():
+    """Manhattan grid of 20x20 junctions, 200m apart, two lanes per direction"""
+    subprocess.check_call([sumo_binary('netgenerate'), '--grid', '--grid.number', '20', '--grid.length', '200', '--default.lanenumber', '2', '--default.speed', '13.89', '--seed', str(SEED), '--no-turnarounds', 'true', '-o', 'grid.net.xml'])
+    return 'grid.net.xml'
+
+
+def make_highway(size):
+    """Straight highway, three lanes per direction, 5km per 1000 vehicles, with a junction every 1km"""
+    length = 5000 * size // 1000
+    name = 'highway_%dk' % (size // 1000)
+    xs = range(0, length + 1, 1000)
+    nodes = ['    <node id="n%d" x="%d" y="0" type="priority"/>' % (x, x) for x in xs]
+    edges = []
+    for a, b in zip(xs[:-1], xs[1:]):
+        edges.append('    <edge id="e%d_%d" from="n%d" to="n%d" numLanes="3" speed="33.33"/>' % (a, b, a, b))
+        edges.append('    <edge id="e%d_%d" from="n%d" to="n%d" numLanes="3" speed="33.33"/>' % (b, a, b, a))
+    with open(name + '.nod.xml', 'w') as f:
+        f.write(HIGHWAY_NODES.format(nodes='\n'.join(nodes)))
+    with open(name + '.edg.xml', 'w') as f:
+        f.write(HIGHWAY_EDGES.format(edges='\n'.join(edges)))
+    subprocess.check_call([sumo_binary('netconvert'), '-n', name + '.nod.xml', '-e', name + '.edg.xml', '--no-turnarounds', 'true', '-o', name + '.net.xml'])
+    os.remove(name + '.nod.xml')
+    os.remove(name + '.edg.xml')
+    return name + '.net.xml'
+
+
+def make_routes(net, name, size, min_distance):
+    """Random trips of size vehicles, departing at random positions within DEPART_INTERVAL"""
+    subprocess.check_call([sys.executable, sumo_tool('tools', 'randomTrips.py'), '-n', net, '-r', name + '.rou.xml', '-o', name + '.trips.xml', '--seed', str(SEED), '--begin', '0', '--end', str(DEPART_INTERVAL), '--period', str(float(DEPART_INTERVAL) / size), '--min-distance', str(min_distance), '--trip-attributes', 'departPos="random" departLane="best" departSpeed="max"', '--validate'])
+    os.remove(name + '.trips.xml')
+    return name + '.rou.xml'
+
+
+def write_configs(net, routes, name):
+    cfg = name + '.sumo.cfg'
+    with open(cfg, 'w') as f:
+        f.write(SUMO_CFG.format(net=net, routes=routes, seed=SEED))
+    with open(name + '.launchd.xml', 'w') as f:
+        f.write(LAUNCHD_CFG.format(net=net, routes=routes, cfg=cfg))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--sizes', type=int, nargs='+', default=SIZES, help='numbers of vehicles to generate scenarios for (default: %(default)s)')
+    args = parser.parse_args()
+
+    os.chdir(os.path.dirname(os.path.realpath(__file__)))
+
+    grid = make_grid()
+    for size in args.sizes:
+        name = 'grid_%dk' % (size // 1000)
+        write_configs(grid, make_routes(grid, name, size, 1000), name)
+
+        highway = make_highway(size)
+        name = 'highway_%dk' % (size // 1000)
+        write_configs(highway, make_routes(highway, name, size, 2000), name)
+
+
+if __name__ == '__main__':
+    main()
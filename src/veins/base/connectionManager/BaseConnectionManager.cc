@@ -23,14 +23,26 @@
 //
 
 #include "veins/base/connectionManager/BaseConnectionManager.h"
+#include "veins/base/utils/Profiling.h"
+
+#include <algorithm>
+#include <cmath>
 
 #include "veins/base/connectionManager/NicEntryDebug.h"
 #include "veins/base/connectionManager/NicEntryDirect.h"
 #include "veins/base/modules/BaseWorldUtility.h"
 #include "veins/base/utils/FindModule.h"
+#include "veins/modules/utility/TaskScheduler.h"
 
 using namespace veins;
 
+const simsignal_t BaseConnectionManager::traciTimestepEndSignal = registerSignal("org_car2x_veins_modules_mobility_traciTimestepEnd");
+const simsignal_t BaseConnectionManager::connectsSignal = registerSignal("org_car2x_veins_base_connectionManager_connects");
+const simsignal_t BaseConnectionManager::disconnectsSignal = registerSignal("org_car2x_veins_base_connectionManager_disconnects");
+const simsignal_t BaseConnectionManager::rangeChecksSignal = registerSignal("org_car2x_veins_base_connectionManager_rangeChecks");
+const simsignal_t BaseConnectionManager::updateConnectionsTimeSignal = registerSignal("org_car2x_veins_base_connectionManager_updateConnectionsTime");
+const simsignal_t BaseConnectionManager::connectionsSignal = registerSignal("org_car2x_veins_base_connectionManager_connections");
+
 namespace {
 /**
  * On a torus the end and the begin of the axes are connected so you
@@ -70,6 +82,8 @@ void BaseConnectionManager::initialize(int stage)
 
         EV_TRACE << "initializing BaseConnectionManager\n";
 
+        memoryRegistration = MemoryAccounting::add("connectionManager", [this]() { return getMemoryUsage(); });
+
         BaseWorldUtility* world = FindModule<BaseWorldUtility*>::findGlobalModule();
 
         ASSERT(world != nullptr);
@@ -82,92 +96,271 @@ void BaseConnectionManager::initialize(int stage)
         else
             sendDirect = false;
 
+        useFlatGrid = hasPar("useFlatGrid") ? par("useFlatGrid").boolValue() : true;
+
+        connectionUpdateSlack = hasPar("connectionUpdateSlack") ? par("connectionUpdateSlack").doubleValue() : 0;
+        if (connectionUpdateSlack < 0) throw cRuntimeError("connectionUpdateSlack must not be negative");
+
+        batchPositionUpdates = hasPar("batchPositionUpdates") ? par("batchPositionUpdates").boolValue() : false;
+        recordStatistics = hasPar("recordStatistics") ? par("recordStatistics").boolValue() : false;
+
+        connectOnSend = hasPar("connectOnSend") ? par("connectOnSend").boolValue() : false;
+        if (connectOnSend) {
+            if (!sendDirect) throw cRuntimeError("connectOnSend requires sendDirect");
+            if (!useFlatGrid) throw cRuntimeError("connectOnSend requires useFlatGrid");
+            // nics in range are found from their current positions
+            connectionUpdateSlack = 0;
+        }
+        if (batchPositionUpdates || recordStatistics) {
+            getSystemModule()->subscribe(traciTimestepEndSignal, this);
+        }
+        if (batchPositionUpdates) {
+
+            int numWorkerThreads = hasPar("numWorkerThreads") ? par("numWorkerThreads").intValue() : 0;
+            if (numWorkerThreads < -1) throw cRuntimeError("numWorkerThreads must not be less than -1");
+            if (numWorkerThreads == -1) {
+                workerPool = TaskScheduler::getSharedPool(this);
+            }
+            if (numWorkerThreads > 0) {
+                workerPool = std::make_shared<WorkerPool>(numWorkerThreads);
+            }
+        }
+
         maxInterferenceDistance = calcInterfDist();
-        maxDistSquared = maxInterferenceDistance * maxInterferenceDistance;
-
-        // ----initialize node grid-----
-        // step 1 - calculate dimension of grid
-        // one cell should have at least the size of maxInterferenceDistance
-        // but also should divide the playground in equal parts
-        Coord dim((*playgroundSize) / maxInterferenceDistance);
-        gridDim = GridCoord(dim);
-
-        // A grid smaller or equal to 3x3 would mean that every cell has every
-        // other cell as direct neighbor (if our playground is a torus, even if
-        // not the most of the cells are direct neighbors of each other. So we
-        // reduce the grid size to 1x1.
-        if ((gridDim.x <= 3) && (gridDim.y <= 3) && (gridDim.z <= 3)) {
-            gridDim.x = 1;
-            gridDim.y = 1;
-            gridDim.z = 1;
+
+        const double farFieldDistance = hasPar("farFieldDistance") ? par("farFieldDistance").doubleValue() : 0;
+        if (farFieldDistance < 0) throw cRuntimeError("farFieldDistance must not be negative");
+        if (farFieldDistance > 0) {
+            farFieldInterference.reset(new FarFieldInterference(farFieldDistance, par("farFieldCellSize").doubleValue(), par("farFieldSliceDuration").doubleValue(), par("farFieldRetention").doubleValue(), par("farFieldPathlossAlpha").doubleValue()));
+        }
+
+        // nics only re-check their connections after moving by connectionUpdateSlack, so links are kept a bit farther
+        const double maxConnectionDistance = getMaxConnectionDistance();
+        maxDistSquared = maxConnectionDistance * maxConnectionDistance;
+
+        useSparseGrid = hasPar("useSparseGrid") ? par("useSparseGrid").boolValue() : false;
+        if (useSparseGrid) {
+            if (!useFlatGrid) throw cRuntimeError("useSparseGrid requires useFlatGrid");
+            if (useTorus) throw cRuntimeError("useSparseGrid does not support playgrounds that are a torus");
+
+            // cells of (just over) maxConnectionDistance, wherever there are nics, only using the z axis if nics can be that far apart in height
+            const auto epsilon = 0.001;
+            findDistance = Coord(maxConnectionDistance + epsilon, maxConnectionDistance + epsilon, maxConnectionDistance + epsilon);
+            sparseGrid3D = playgroundSize->z > maxConnectionDistance;
+            EV_TRACE << " using sparse" << (sparseGrid3D ? " 3D" : "") << " grid, findDistance is " << findDistance.info() << endl;
         }
         else {
-            gridDim.x = std::max(1, gridDim.x);
-            gridDim.y = std::max(1, gridDim.y);
-            gridDim.z = std::max(1, gridDim.z);
-        }
-
-        // step 2 - initialize the matrix which represents our grid
-        NicEntries entries;
-        RowVector row;
-        NicMatrix matrix;
-
-        for (int i = 0; i < gridDim.z; ++i) {
-            row.push_back(entries); // copy empty NicEntries to RowVector
-        }
-        for (int i = 0; i < gridDim.y; ++i) { // fill the ColVector with copies of
-            matrix.push_back(row); // the RowVector.
-        }
-        for (int i = 0; i < gridDim.x; ++i) { // fill the grid with copies of
-            nicGrid.push_back(matrix); // the matrix.
-        }
-        EV_TRACE << " using " << gridDim.x << "x" << gridDim.y << "x" << gridDim.z << " grid" << endl;
-
-        // step 3 -    calculate the factor which maps the coordinate of a node
-        //            to the grid cell
-        // if we use a 1x1 grid every coordinate is mapped to (0,0, 0)
-        findDistance = Coord(std::max(playgroundSize->x, maxInterferenceDistance), std::max(playgroundSize->y, maxInterferenceDistance), std::max(playgroundSize->z, maxInterferenceDistance));
-        // otherwise we divide the playground into cells of size of the maximum
-        // interference distance
-        if (gridDim.x != 1) findDistance.x = playgroundSize->x / gridDim.x;
-        if (gridDim.y != 1) findDistance.y = playgroundSize->y / gridDim.y;
-        if (gridDim.z != 1) findDistance.z = playgroundSize->z / gridDim.z;
-
-        // since the upper playground borders (at pg-size) are part of the
-        // playground we have to assure that they are mapped to a valid
-        // (the last) grid cell we do this by increasing the find distance
-        // by a small value.
-        // This also assures that findDistance is never zero.
-        const auto epsilon = 0.001;
-        findDistance += Coord(epsilon, epsilon, epsilon);
-
-        // findDistance (equals cell size) has to be greater or equal
-        // maxInt-distance
-        ASSERT(findDistance.x >= maxInterferenceDistance);
-        ASSERT(findDistance.y >= maxInterferenceDistance);
-        ASSERT(findDistance.z >= maxInterferenceDistance);
-
-        // playGroundSize has to be part of the playGround
-        ASSERT(GridCoord(*playgroundSize, findDistance).x == gridDim.x - 1);
-        ASSERT(GridCoord(*playgroundSize, findDistance).y == gridDim.y - 1);
-        ASSERT(GridCoord(*playgroundSize, findDistance).z == gridDim.z - 1);
-        EV_TRACE << "findDistance is " << findDistance.info() << endl;
+            // ----initialize node grid-----
+            // step 1 - calculate dimension of grid
+            // one cell should have at least the size of maxConnectionDistance
+            // but also should divide the playground in equal parts
+            Coord dim((*playgroundSize) / maxConnectionDistance);
+            gridDim = GridCoord(dim);
+
+            // A grid smaller or equal to 3x3 would mean that every cell has every
+            // other cell as direct neighbor (if our playground is a torus, even if
+            // not the most of the cells are direct neighbors of each other. So we
+            // reduce the grid size to 1x1.
+            if ((gridDim.x <= 3) && (gridDim.y <= 3) && (gridDim.z <= 3)) {
+                gridDim.x = 1;
+                gridDim.y = 1;
+                gridDim.z = 1;
+            }
+            else {
+                gridDim.x = std::max(1, gridDim.x);
+                gridDim.y = std::max(1, gridDim.y);
+                gridDim.z = std::max(1, gridDim.z);
+            }
+
+            // step 2 - initialize the matrix which represents our grid
+            if (useFlatGrid) {
+                flatGrid.resize(static_cast<size_t>(gridDim.x) * gridDim.y * gridDim.z);
+            }
+            else {
+                NicEntries entries;
+                RowVector row;
+                NicMatrix matrix;
+
+                for (int i = 0; i < gridDim.z; ++i) {
+                    row.push_back(entries); // copy empty NicEntries to RowVector
+                }
+                for (int i = 0; i < gridDim.y; ++i) { // fill the ColVector with copies of
+                    matrix.push_back(row); // the RowVector.
+                }
+                for (int i = 0; i < gridDim.x; ++i) { // fill the grid with copies of
+                    nicGrid.push_back(matrix); // the matrix.
+                }
+            }
+            EV_TRACE << " using " << gridDim.x << "x" << gridDim.y << "x" << gridDim.z << (useFlatGrid ? " flat" : "") << " grid" << endl;
+
+            // step 3 -    calculate the factor which maps the coordinate of a node
+            //            to the grid cell
+            // if we use a 1x1 grid every coordinate is mapped to (0,0, 0)
+            findDistance = Coord(std::max(playgroundSize->x, maxConnectionDistance), std::max(playgroundSize->y, maxConnectionDistance), std::max(playgroundSize->z, maxConnectionDistance));
+            // otherwise we divide the playground into cells of size of the maximum
+            // interference distance
+            if (gridDim.x != 1) findDistance.x = playgroundSize->x / gridDim.x;
+            if (gridDim.y != 1) findDistance.y = playgroundSize->y / gridDim.y;
+            if (gridDim.z != 1) findDistance.z = playgroundSize->z / gridDim.z;
+
+            // since the upper playground borders (at pg-size) are part of the
+            // playground we have to assure that they are mapped to a valid
+            // (the last) grid cell we do this by increasing the find distance
+            // by a small value.
+            // This also assures that findDistance is never zero.
+            const auto epsilon = 0.001;
+            findDistance += Coord(epsilon, epsilon, epsilon);
+
+            // findDistance (equals cell size) has to be greater or equal
+            // maxInt-distance (plus slack)
+            ASSERT(findDistance.x >= maxConnectionDistance);
+            ASSERT(findDistance.y >= maxConnectionDistance);
+            ASSERT(findDistance.z >= maxConnectionDistance);
+
+            // playGroundSize has to be part of the playGround
+            ASSERT(GridCoord(*playgroundSize, findDistance).x == gridDim.x - 1);
+            ASSERT(GridCoord(*playgroundSize, findDistance).y == gridDim.y - 1);
+            ASSERT(GridCoord(*playgroundSize, findDistance).z == gridDim.z - 1);
+            EV_TRACE << "findDistance is " << findDistance.info() << endl;
+        }
     }
     else if (stage == 1) {
     }
 }
 
-BaseConnectionManager::GridCoord BaseConnectionManager::getCellForCoordinate(const Coord& c)
+MemoryAccounting::Usage BaseConnectionManager::getMemoryUsage() const
+{
+    MemoryAccounting::Usage usage;
+    usage.objects += nics.size();
+    usage.bytes += MemoryAccounting::bytesOfNodes(nics);
+    for (const auto& entry : nics) {
+        usage.bytes += sizeof(NicEntry) + MemoryAccounting::bytesOf(entry.second->getGateList());
+    }
+    usage.bytes += MemoryAccounting::bytesOf(nicsInRange);
+    for (const auto& matrix : nicGrid) {
+        usage.bytes += MemoryAccounting::bytesOf(matrix);
+        for (const auto& row : matrix) {
+            usage.bytes += MemoryAccounting::bytesOf(row);
+            for (const auto& cell : row) usage.bytes += MemoryAccounting::bytesOfNodes(cell);
+        }
+    }
+    usage.bytes += MemoryAccounting::bytesOf(flatGrid);
+    for (const auto& cell : flatGrid) usage.bytes += MemoryAccounting::bytesOf(cell.nics) + MemoryAccounting::bytesOf(cell.positions);
+    // the cells of sparseGrid cannot be iterated, assume they are packed as tightly as those of flatGrid
+    usage.bytes += sparseGrid.bytesOfTable() + (useSparseGrid ? nics.size() * (sizeof(NicEntry*) + sizeof(Coord)) : 0);
+    return usage;
+}
+
+void BaseConnectionManager::finish()
+{
+    if (batchPositionUpdates || recordStatistics) {
+        getSystemModule()->unsubscribe(traciTimestepEndSignal, this);
+    }
+    if (recordStatistics) {
+        recordStatisticsSummary();
+    }
+    if (farFieldInterference) {
+        recordScalar("farFieldTransmissions", farFieldInterference->getNumTransmissions());
+    }
+    cSimpleModule::finish();
+}
+
+void BaseConnectionManager::receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details)
+{
+    if (signalID == traciTimestepEndSignal) {
+        if (batchPositionUpdates) commitPositionUpdates();
+        if (recordStatistics) emitStepStatistics();
+    }
+}
+
+void BaseConnectionManager::emitStepStatistics()
+{
+    emit(connectsSignal, static_cast<unsigned long>(stepStatistics.numConnects));
+    emit(disconnectsSignal, static_cast<unsigned long>(stepStatistics.numDisconnects));
+    emit(rangeChecksSignal, static_cast<unsigned long>(stepStatistics.numRangeChecks));
+    emit(updateConnectionsTimeSignal, std::chrono::duration<double>(stepStatistics.updateTime).count());
+    emit(connectionsSignal, static_cast<unsigned long>(getNumConnections() / 2));
+
+    totalStatistics.numConnects += stepStatistics.numConnects;
+    totalStatistics.numDisconnects += stepStatistics.numDisconnects;
+    totalStatistics.numRangeChecks += stepStatistics.numRangeChecks;
+    totalStatistics.updateTime += stepStatistics.updateTime;
+    stepStatistics = ConnectionStatistics();
+}
+
+void BaseConnectionManager::recordStatisticsSummary()
+{
+    const ConnectionStatistics& step = stepStatistics;
+    recordScalar("totalConnects", totalStatistics.numConnects + step.numConnects);
+    recordScalar("totalDisconnects", totalStatistics.numDisconnects + step.numDisconnects);
+    recordScalar("totalRangeChecks", totalStatistics.numRangeChecks + step.numRangeChecks);
+    recordScalar("totalUpdateConnectionsTime", std::chrono::duration<double>(totalStatistics.updateTime + step.updateTime).count(), "s");
+
+    // nics per cell, counting the empty cells of bounded grids
+    std::map<size_t, size_t> nicsPerCell;
+    for (const auto& entry : nics) {
+        nicsPerCell[getFlatIndex(getCellForCoordinate(entry.second->pos))]++;
+    }
+    cHistogram cellOccupancy("cellOccupancy");
+    for (const auto& cell : nicsPerCell) cellOccupancy.collect(cell.second);
+    if (!useSparseGrid) {
+        const size_t numCells = static_cast<size_t>(gridDim.x) * gridDim.y * gridDim.z;
+        for (size_t i = nicsPerCell.size(); i < numCells; ++i) cellOccupancy.collect(0);
+    }
+    cellOccupancy.record();
+
+    // without connections, count the nics in range instead
+    cHistogram neighboursPerNic("neighboursPerNic");
+    for (const auto& entry : nics) {
+        if (connectOnSend) {
+            findNicsInRange(entry.second);
+            neighboursPerNic.collect(nicsInRange.size());
+        }
+        else {
+            neighboursPerNic.collect(entry.second->getGateList().size());
+        }
+    }
+    neighboursPerNic.record();
+}
+
+BaseConnectionManager::GridCoord BaseConnectionManager::getCellForCoordinate(const Coord& c) const
 {
+    if (useSparseGrid) {
+        // cells may have negative coordinates here, so round down rather than towards zero
+        return GridCoord(static_cast<int>(std::floor(c.x / findDistance.x)), static_cast<int>(std::floor(c.y / findDistance.y)), sparseGrid3D ? static_cast<int>(std::floor(c.z / findDistance.z)) : 0);
+    }
     return GridCoord(c, findDistance);
 }
 
+const BaseConnectionManager::FlatCell& BaseConnectionManager::getFlatCell(size_t index) const
+{
+    if (!useSparseGrid) return flatGrid[index];
+
+    static const FlatCell emptyCell;
+    const FlatCell* cell = sparseGrid.find(index);
+    return cell ? *cell : emptyCell;
+}
+
+BaseConnectionManager::FlatCell& BaseConnectionManager::getOrAddFlatCell(size_t index)
+{
+    if (!useSparseGrid) return flatGrid[index];
+    return sparseGrid[index];
+}
+
 void BaseConnectionManager::updateConnections(int nicID, Coord oldPos, Coord newPos)
 {
+    VEINS_PROFILE_SCOPE("BaseConnectionManager::updateConnections");
+    const auto start = recordStatistics ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
     GridCoord oldCell = getCellForCoordinate(oldPos);
     GridCoord newCell = getCellForCoordinate(newPos);
 
-    checkGrid(oldCell, newCell, nicID);
+    if (useFlatGrid) {
+        checkFlatGrid(oldCell, newCell, nics[nicID]);
+    }
+    else {
+        checkGrid(oldCell, newCell, nicID);
+    }
+    if (recordStatistics) stepStatistics.updateTime += std::chrono::steady_clock::now() - start;
 }
 
 BaseConnectionManager::NicEntries& BaseConnectionManager::getCellEntries(BaseConnectionManager::GridCoord& cell)
@@ -184,8 +377,13 @@ void BaseConnectionManager::registerNicExt(int nicID)
     EV_TRACE << " registering (ext) nic at loc " << cell.info() << std::endl;
 
     // add to matrix
-    NicEntries& cellEntries = getCellEntries(cell);
-    cellEntries[nicID] = nicEntry;
+    if (useFlatGrid) {
+        insertIntoCell(getOrAddFlatCell(getFlatIndex(cell)), nicEntry);
+    }
+    else {
+        NicEntries& cellEntries = getCellEntries(cell);
+        cellEntries[nicID] = nicEntry;
+    }
 }
 
 void BaseConnectionManager::checkGrid(BaseConnectionManager::GridCoord& oldCell, BaseConnectionManager::GridCoord& newCell, int id)
@@ -227,6 +425,116 @@ void BaseConnectionManager::checkGrid(BaseConnectionManager::GridCoord& oldCell,
     }
 }
 
+void BaseConnectionManager::checkFlatGrid(const GridCoord& oldCell, const GridCoord& newCell, NicEntries::mapped_type nic)
+{
+    // move nic to a new cell
+    if (oldCell != newCell) {
+        removeFromCell(getOrAddFlatCell(getFlatIndex(oldCell)), nic);
+        insertIntoCell(getOrAddFlatCell(getFlatIndex(newCell)), nic);
+    }
+    else {
+        updatePositionInCell(getOrAddFlatCell(getFlatIndex(newCell)), nic);
+    }
+
+    // union of cells around old and new position
+    CellIndexSet cells;
+    fillCellsWithNeighbors(cells, oldCell);
+    if (oldCell != newCell) {
+        fillCellsWithNeighbors(cells, newCell);
+    }
+
+    for (auto index : cells) {
+        for (auto other : getFlatCell(index)) {
+            updateNicConnection(nic, other);
+        }
+    }
+}
+
+void BaseConnectionManager::fillCellsWithNeighbors(CellIndexSet& cells, const GridCoord& cell)
+{
+    if (useSparseGrid) {
+        fillSparseCellsWithNeighbors(cells, cell);
+        return;
+    }
+
+    if ((gridDim.x == 1) && (gridDim.y == 1) && (gridDim.z == 1)) {
+        cells.add(0);
+        return;
+    }
+
+    for (int iz = cell.z - 1; iz <= cell.z + 1; iz++) {
+        int cz = wrapIfTorus(iz, gridDim.z);
+        if (cz == -1) {
+            continue;
+        }
+        for (int ix = cell.x - 1; ix <= cell.x + 1; ix++) {
+            int cx = wrapIfTorus(ix, gridDim.x);
+            if (cx == -1) {
+                continue;
+            }
+            for (int iy = cell.y - 1; iy <= cell.y + 1; iy++) {
+                int cy = wrapIfTorus(iy, gridDim.y);
+                if (cy != -1) {
+                    cells.add(getFlatIndex(GridCoord(cx, cy, cz)));
+                }
+            }
+        }
+    }
+}
+
+void BaseConnectionManager::fillSparseCellsWithNeighbors(CellIndexSet& cells, const GridCoord& cell) const
+{
+    // the sparse grid has no bounds (and does not wrap)
+    const int zRange = sparseGrid3D ? 1 : 0;
+    for (int iz = cell.z - zRange; iz <= cell.z + zRange; iz++) {
+        for (int ix = cell.x - 1; ix <= cell.x + 1; ix++) {
+            for (int iy = cell.y - 1; iy <= cell.y + 1; iy++) {
+                cells.add(getFlatIndex(GridCoord(ix, iy, iz)));
+            }
+        }
+    }
+}
+
+void BaseConnectionManager::insertIntoCell(FlatCell& cell, NicEntries::mapped_type nic)
+{
+    auto it = std::lower_bound(cell.nics.begin(), cell.nics.end(), nic, [](const NicEntry* a, const NicEntry* b) { return a->nicId < b->nicId; });
+    ASSERT(it == cell.nics.end() || *it != nic);
+    cell.positions.insert(cell.positions.begin() + (it - cell.nics.begin()), nic->pos);
+    cell.nics.insert(it, nic);
+}
+
+void BaseConnectionManager::removeFromCell(FlatCell& cell, NicEntries::mapped_type nic)
+{
+    auto it = std::lower_bound(cell.nics.begin(), cell.nics.end(), nic, [](const NicEntry* a, const NicEntry* b) { return a->nicId < b->nicId; });
+    ASSERT(it != cell.nics.end() && *it == nic);
+    cell.positions.erase(cell.positions.begin() + (it - cell.nics.begin()));
+    cell.nics.erase(it);
+}
+
+void BaseConnectionManager::updatePositionInCell(FlatCell& cell, NicEntries::mapped_type nic)
+{
+    auto it = std::lower_bound(cell.nics.begin(), cell.nics.end(), nic, [](const NicEntry* a, const NicEntry* b) { return a->nicId < b->nicId; });
+    ASSERT(it != cell.nics.end() && *it == nic);
+    cell.positions[it - cell.nics.begin()] = nic->pos;
+}
+
+void BaseConnectionManager::moveInGrid(NicEntries::mapped_type nic, const GridCoord& oldCell, const GridCoord& newCell)
+{
+    if (oldCell == newCell) {
+        if (useFlatGrid) updatePositionInCell(getOrAddFlatCell(getFlatIndex(newCell)), nic);
+        return;
+    }
+
+    if (useFlatGrid) {
+        removeFromCell(getOrAddFlatCell(getFlatIndex(oldCell)), nic);
+        insertIntoCell(getOrAddFlatCell(getFlatIndex(newCell)), nic);
+    }
+    else {
+        nicGrid[oldCell.x][oldCell.y][oldCell.z].erase(nic->nicId);
+        nicGrid[newCell.x][newCell.y][newCell.z][nic->nicId] = nic;
+    }
+}
+
 int BaseConnectionManager::wrapIfTorus(int value, int max)
 {
     if (value < 0) {
@@ -272,6 +580,71 @@ void BaseConnectionManager::fillUnionWithNeighbors(CoordSet& gridUnion, GridCoor
     }
 }
 
+size_t BaseConnectionManager::getNumConnections() const
+{
+    size_t numConnections = 0;
+    for (const auto& nic : nics) {
+        numConnections += nic.second->getGateList().size();
+    }
+    return numConnections;
+}
+
+bool BaseConnectionManager::hasNicInRange(const Coord& pos, int excludeHostId) const
+{
+    const double maxDist2 = maxInterferenceDistance * maxInterferenceDistance;
+    auto inRange = [&](const NicEntry* nic) {
+        if (nic->hostId == excludeHostId) return false;
+        double dist2 = useTorus ? sqrTorusDist(pos, nic->pos, *playgroundSize) : pos.sqrdist(nic->pos);
+        return dist2 <= maxDist2;
+    };
+    auto wrap = [&](int value, int max) {
+        if ((value >= 0) && (value < max)) return value;
+        if (!useTorus) return -1;
+        return (value < 0) ? max + value : value - max;
+    };
+
+    // nics with a batched move already carry their new position, but are still filed under their old cell
+    for (const NicEntry* nic : pendingMoves) {
+        if (inRange(nic)) return true;
+    }
+
+    if (useSparseGrid) {
+        CellIndexSet cells;
+        fillSparseCellsWithNeighbors(cells, getCellForCoordinate(pos));
+        for (auto index : cells) {
+            for (const NicEntry* nic : getFlatCell(index)) {
+                if (inRange(nic)) return true;
+            }
+        }
+        return false;
+    }
+
+    GridCoord cell(pos, findDistance);
+    for (int ix = cell.x - 1; ix <= cell.x + 1; ix++) {
+        int cx = wrap(ix, gridDim.x);
+        if (cx == -1) continue;
+        for (int iy = cell.y - 1; iy <= cell.y + 1; iy++) {
+            int cy = wrap(iy, gridDim.y);
+            if (cy == -1) continue;
+            for (int iz = cell.z - 1; iz <= cell.z + 1; iz++) {
+                int cz = wrap(iz, gridDim.z);
+                if (cz == -1) continue;
+                if (useFlatGrid) {
+                    for (const NicEntry* nic : flatGrid[getFlatIndex(GridCoord(cx, cy, cz))]) {
+                        if (inRange(nic)) return true;
+                    }
+                }
+                else {
+                    for (const auto& entry : nicGrid[cx][cy][cz]) {
+                        if (inRange(entry.second)) return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
 bool BaseConnectionManager::isInRange(BaseConnectionManager::NicEntries::mapped_type pFromNic, BaseConnectionManager::NicEntries::mapped_type pToNic)
 {
     double dDistance = 0.0;
@@ -286,32 +659,99 @@ bool BaseConnectionManager::isInRange(BaseConnectionManager::NicEntries::mapped_
 }
 
 void BaseConnectionManager::updateNicConnections(NicEntries& nmap, BaseConnectionManager::NicEntries::mapped_type nic)
+{
+    for (NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
+        updateNicConnection(nic, i->second);
+    }
+}
+
+void BaseConnectionManager::updateNicConnection(NicEntries::mapped_type nic, NicEntries::mapped_type nic_i)
 {
     int id = nic->nicId;
 
-    for (NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
-        NicEntries::mapped_type nic_i = i->second;
+    // no recursive connections
+    if (nic_i->nicId == id) return;
 
-        // no recursive connections
-        if (nic_i->nicId == id) continue;
+    bool inRange = isInRange(nic, nic_i);
+    bool connected = nic->isConnected(nic_i);
+    stepStatistics.numRangeChecks++;
 
-        bool inRange = isInRange(nic, nic_i);
-        bool connected = nic->isConnected(nic_i);
+    if (inRange && !connected) {
+        // nodes within communication range: connect
+        // nodes within communication range && not yet connected
+        EV_TRACE << "nic #" << id << " and #" << nic_i->nicId << " are in range" << endl;
+        connectNics(nic, nic_i);
+    }
+    else if (!inRange && connected) {
+        // out of range: disconnect
+        // out of range, and still connected
+        EV_TRACE << "nic #" << id << " and #" << nic_i->nicId << " are NOT in range" << endl;
+        disconnectNics(nic, nic_i);
+    }
+}
 
-        if (inRange && !connected) {
-            // nodes within communication range: connect
-            // nodes within communication range && not yet connected
-            EV_TRACE << "nic #" << id << " and #" << nic_i->nicId << " are in range" << endl;
-            nic->connectTo(nic_i);
-            nic_i->connectTo(nic);
-        }
-        else if (!inRange && connected) {
-            // out of range: disconnect
-            // out of range, and still connected
-            EV_TRACE << "nic #" << id << " and #" << nic_i->nicId << " are NOT in range" << endl;
-            nic->disconnectFrom(nic_i);
-            nic_i->disconnectFrom(nic);
-        }
+void BaseConnectionManager::connectNics(NicEntry* a, NicEntry* b)
+{
+    a->connectTo(b);
+    b->connectTo(a);
+    stepStatistics.numConnects++;
+    notifyNeighbourListeners(a, b, &NeighbourListener::neighbourEntered);
+    notifyNeighbourListeners(b, a, &NeighbourListener::neighbourEntered);
+}
+
+void BaseConnectionManager::disconnectNics(NicEntry* a, NicEntry* b)
+{
+    a->disconnectFrom(b);
+    b->disconnectFrom(a);
+    stepStatistics.numDisconnects++;
+    notifyNeighbourListeners(a, b, &NeighbourListener::neighbourLeft);
+    notifyNeighbourListeners(b, a, &NeighbourListener::neighbourLeft);
+}
+
+void BaseConnectionManager::notifyNeighbourLeft(NicEntry* nic, const NicEntry* neighbour)
+{
+    notifyNeighbourListeners(nic, neighbour, &NeighbourListener::neighbourLeft);
+}
+
+void BaseConnectionManager::notifyNeighbourListeners(NicEntry* nic, const NicEntry* neighbour, void (NeighbourListener::*notify)(cModule*, cModule*))
+{
+    // listeners may (un)subscribe while being notified: ones subscribed meanwhile are appended (and not notified yet),
+    // ones unsubscribed meanwhile are only set to nullptr (and skipped), as they may be deleted right away
+    std::vector<NeighbourListener*>& listeners = nic->neighbourListeners;
+    const size_t numListeners = listeners.size();
+    nic->neighbourNotifications++;
+    for (size_t i = 0; i < numListeners; ++i) {
+        if (listeners[i]) (listeners[i]->*notify)(nic->nicPtr, neighbour->nicPtr);
+    }
+    if (--nic->neighbourNotifications == 0) {
+        listeners.erase(std::remove(listeners.begin(), listeners.end(), nullptr), listeners.end());
+    }
+}
+
+void BaseConnectionManager::subscribeNeighbourChanges(cModule* nic, NeighbourListener* listener)
+{
+    ASSERT(nic != nullptr && listener != nullptr);
+    if (connectOnSend) throw cRuntimeError("Neighbour changes cannot be subscribed to with connectOnSend, which keeps no connections");
+    NicEntries::iterator it = nics.find(nic->getId());
+    if (it == nics.end()) throw cRuntimeError("No nic with this ID (%d) is registered with this ConnectionManager.", nic->getId());
+    NicEntry* nicEntry = it->second;
+    nicEntry->neighbourListeners.push_back(listener);
+    for (const auto& connection : nicEntry->getGateList()) {
+        listener->neighbourEntered(nicEntry->nicPtr, connection.first->nicPtr);
+    }
+}
+
+void BaseConnectionManager::unsubscribeNeighbourChanges(cModule* nic, NeighbourListener* listener)
+{
+    NicEntries::iterator it = nics.find(nic->getId());
+    if (it == nics.end()) return;
+    auto& listeners = it->second->neighbourListeners;
+    if (it->second->neighbourNotifications > 0) {
+        // being notified: keep the indices of the others, see notifyNeighbourListeners()
+        std::replace(listeners.begin(), listeners.end(), listener, static_cast<NeighbourListener*>(nullptr));
+    }
+    else {
+        listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
     }
 }
 
@@ -335,6 +775,7 @@ bool BaseConnectionManager::registerNic(cModule* nic, ChannelAccess* chAccess, C
     nicEntry->nicId = nicID;
     nicEntry->hostId = nic->getParentModule()->getId();
     nicEntry->pos = nicPos;
+    nicEntry->lastCheckedPos = nicPos;
     nicEntry->heading = heading;
     nicEntry->chAccess = chAccess;
 
@@ -343,7 +784,7 @@ bool BaseConnectionManager::registerNic(cModule* nic, ChannelAccess* chAccess, C
 
     registerNicExt(nicID);
 
-    updateConnections(nicID, nicPos, nicPos);
+    if (!connectOnSend) updateConnections(nicID, nicPos, nicPos);
 
     if (drawMIR) {
         nic->getParentModule()->getDisplayString().setTagArg("r", 0, maxInterferenceDistance);
@@ -365,29 +806,33 @@ bool BaseConnectionManager::unregisterNic(cModule* nicModule)
     ASSERT(nics.find(nicID) != nics.end());
     NicEntries::mapped_type nicEntry = nics[nicID];
 
-    // get all affected grid squares
-    CoordSet gridUnion(74);
-    GridCoord cell = getCellForCoordinate(nicEntry->pos);
-    if ((gridDim.x == 1) && (gridDim.y == 1) && (gridDim.z == 1)) {
-        gridUnion.add(cell);
-    }
-    else {
-        fillUnionWithNeighbors(gridUnion, cell);
+    // bring grid membership and connections of the nic up to date first
+    if (nicEntry->hasPendingMove) {
+        pendingMoves.erase(std::find(pendingMoves.begin(), pendingMoves.end(), nicEntry));
+        nicEntry->hasPendingMove = false;
+        applyNicMove(nicEntry, nicEntry->pendingOldPos);
     }
 
-    // disconnect from all NICs in these grid squares
-    GridCoord* c = gridUnion.next();
-    while (c != nullptr) {
-        EV_TRACE << "Update cons in [" << c->info() << "]" << endl;
-        NicEntries& nmap = getCellEntries(*c);
-        for (NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
-            NicEntries::mapped_type other = i->second;
-            if (other == nicEntry) continue;
-            if (!other->isConnected(nicEntry)) continue;
+    // connections are symmetric, so the nic's own list names all nics connected to it
+    // (links padded by connectionUpdateSlack can reach beyond the cells around the nic)
+    const NicEntry::GateList connections = nicEntry->getGateList();
+    for (const auto& connection : connections) {
+        NicEntry* other = const_cast<NicEntry*>(connection.first);
+        if (other->isConnected(nicEntry)) {
             other->disconnectFrom(nicEntry);
-            nicEntry->disconnectFrom(other);
+            stepStatistics.numDisconnects++;
+            notifyNeighbourLeft(other, nicEntry);
         }
-        c = gridUnion.next();
+        nicEntry->disconnectFrom(other);
+    }
+
+    GridCoord cell = getCellForCoordinate(nicEntry->pos);
+
+    if (useFlatGrid) {
+        removeFromCell(getOrAddFlatCell(getFlatIndex(cell)), nicEntry);
+        nics.erase(nicID);
+        delete nicEntry;
+        return true;
     }
 
     // erase from grid
@@ -402,16 +847,340 @@ bool BaseConnectionManager::unregisterNic(cModule* nicModule)
     return true;
 }
 
+void BaseConnectionManager::unregisterNics(const std::vector<cModule*>& nicModules)
+{
+    std::vector<NicEntries::mapped_type> removed;
+    removed.reserve(nicModules.size());
+    bool anyPendingMove = false;
+    for (cModule* nicModule : nicModules) {
+        ASSERT(nicModule != nullptr);
+        EV_TRACE << " unregistering nic #" << nicModule->getId() << endl;
+        auto found = nics.find(nicModule->getId());
+        ASSERT(found != nics.end());
+        removed.push_back(found->second);
+        anyPendingMove = anyPendingMove || found->second->hasPendingMove;
+    }
+
+    // a nic with a pending move is still in the cell of the position it had before that move (and connected as from there)
+    std::vector<GridCoord> cells;
+    cells.reserve(removed.size());
+    for (auto nicEntry : removed) {
+        cells.push_back(getCellForCoordinate(nicEntry->hasPendingMove ? nicEntry->pendingOldPos : nicEntry->pos));
+        nicEntry->hasPendingMove = false;
+    }
+    if (anyPendingMove) {
+        std::vector<NicEntries::mapped_type> sorted(removed);
+        std::sort(sorted.begin(), sorted.end());
+        pendingMoves.erase(std::remove_if(pendingMoves.begin(), pendingMoves.end(), [&sorted](NicEntry* nic) { return std::binary_search(sorted.begin(), sorted.end(), nic); }), pendingMoves.end());
+    }
+
+    // nics unregistered together do not notify each other
+    for (auto nicEntry : removed) nicEntry->neighbourListeners.clear();
+
+    for (size_t i = 0; i < removed.size(); ++i) {
+        NicEntries::mapped_type nicEntry = removed[i];
+
+        // connections are symmetric, so the nic's own list names all nics connected to it
+        const NicEntry::GateList connections = nicEntry->getGateList();
+        for (const auto& connection : connections) {
+            NicEntry* other = const_cast<NicEntry*>(connection.first);
+            if (other->isConnected(nicEntry)) {
+                other->disconnectFrom(nicEntry);
+                stepStatistics.numDisconnects++;
+                notifyNeighbourLeft(other, nicEntry);
+            }
+            nicEntry->disconnectFrom(other);
+        }
+
+        if (useFlatGrid) {
+            removeFromCell(getOrAddFlatCell(getFlatIndex(cells[i])), nicEntry);
+        }
+        else {
+            getCellEntries(cells[i]).erase(nicEntry->nicId);
+        }
+        nics.erase(nicEntry->nicId);
+        delete nicEntry;
+    }
+}
+
 void BaseConnectionManager::updateNicPos(int nicID, Coord newPos, Heading heading)
 {
     NicEntries::iterator ItNic = nics.find(nicID);
     if (ItNic == nics.end()) throw cRuntimeError("No nic with this ID (%d) is registered with this ConnectionManager.", nicID);
 
-    Coord oldPos = ItNic->second->pos;
-    ItNic->second->pos = newPos;
-    ItNic->second->heading = heading;
+    NicEntries::mapped_type nic = ItNic->second;
+
+    if (batchPositionUpdates) {
+        if (!nic->hasPendingMove) {
+            nic->hasPendingMove = true;
+            nic->pendingOldPos = nic->pos;
+            pendingMoves.push_back(nic);
+        }
+        nic->pos = newPos;
+        nic->heading = heading;
+        return;
+    }
+
+    Coord oldPos = nic->pos;
+    nic->pos = newPos;
+    nic->heading = heading;
+
+    applyNicMove(nic, oldPos);
+}
+
+void BaseConnectionManager::applyNicMove(NicEntries::mapped_type nic, Coord oldPos)
+{
+    const Coord newPos = nic->pos;
+
+    if (connectOnSend) {
+        // there are no connections to update
+        moveInGrid(nic, getCellForCoordinate(oldPos), getCellForCoordinate(newPos));
+        return;
+    }
+
+    if (connectionUpdateSlack > 0) {
+        if (nic->lastCheckedPos.sqrdist(newPos) < connectionUpdateSlack * connectionUpdateSlack) {
+            // moved less than the slack: only keep grid membership up to date
+            moveInGrid(nic, getCellForCoordinate(oldPos), getCellForCoordinate(newPos));
+            return;
+        }
+
+        // re-check connections starting from the position they were last checked at,
+        // so that links made there are covered as well
+        moveInGrid(nic, getCellForCoordinate(oldPos), getCellForCoordinate(nic->lastCheckedPos));
+        oldPos = nic->lastCheckedPos;
+    }
+    nic->lastCheckedPos = newPos;
+
+    updateConnections(nic->nicId, oldPos, newPos);
+}
+
+void BaseConnectionManager::commitPositionUpdates()
+{
+    if (pendingMoves.empty()) return;
+
+    EV_TRACE << "committing position updates of " << pendingMoves.size() << " nics" << endl;
+
+    // process nics cell by cell (and by nic id within a cell) for locality and a deterministic order
+    if (useFlatGrid) {
+        std::sort(pendingMoves.begin(), pendingMoves.end(), [this](const NicEntry* a, const NicEntry* b) {
+            size_t cellA = getFlatIndex(getCellForCoordinate(a->pos));
+            size_t cellB = getFlatIndex(getCellForCoordinate(b->pos));
+            return (cellA < cellB) || ((cellA == cellB) && (a->nicId < b->nicId));
+        });
+    }
+    else {
+        std::sort(pendingMoves.begin(), pendingMoves.end(), [](const NicEntry* a, const NicEntry* b) { return a->nicId < b->nicId; });
+
+        for (auto nic : pendingMoves) {
+            nic->hasPendingMove = false;
+            applyNicMove(nic, nic->pendingOldPos);
+        }
+        pendingMoves.clear();
+        return;
+    }
+
+    // step 1 - move all nics to their new cells and collect the ones whose connections need checking
+    const auto start = recordStatistics ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    size_t numChecks = 0;
+    for (auto nic : pendingMoves) {
+        nic->hasPendingMove = false;
+
+        GridCoord oldCell = getCellForCoordinate(nic->pendingOldPos);
+        GridCoord newCell = getCellForCoordinate(nic->pos);
+        moveInGrid(nic, oldCell, newCell);
+        if (connectOnSend) continue;
+
+        if (connectionUpdateSlack > 0) {
+            if (nic->lastCheckedPos.sqrdist(nic->pos) < connectionUpdateSlack * connectionUpdateSlack) continue;
+            oldCell = getCellForCoordinate(nic->lastCheckedPos);
+        }
+        nic->lastCheckedPos = nic->pos;
+
+        if (numChecks == connectionChecks.size()) connectionChecks.emplace_back();
+        ConnectionCheck& check = connectionChecks[numChecks++];
+        check.nic = nic;
+        check.oldCell = oldCell;
+        check.newCell = newCell;
+        check.changes.clear();
+        check.numRangeChecks = 0;
+    }
+    pendingMoves.clear();
+
+    // step 2 - find connections that need to change; only reads nic state, so can run in parallel
+    auto findChanges = [this](size_t i) {
+        ConnectionCheck& check = connectionChecks[i];
+
+        CellIndexSet cells;
+        fillCellsWithNeighbors(cells, check.oldCell);
+        if (check.oldCell != check.newCell) {
+            fillCellsWithNeighbors(cells, check.newCell);
+        }
+
+        for (auto index : cells) {
+            const auto& others = getFlatCell(index);
+            if (batchedRangeChecks && !useTorus) {
+                // all moves were applied in step 1, so the positions stored in the cells are current
+                check.sqrDistances.resize(others.size());
+                distancesSquared(check.nic->pos, others.positions.data(), others.size(), check.sqrDistances.data());
+            }
+            for (size_t j = 0; j < others.size(); ++j) {
+                NicEntry* other = others[j];
+                if (other == check.nic) continue;
+                check.numRangeChecks++;
+                bool inRange = (batchedRangeChecks && !useTorus) ? (check.sqrDistances[j] <= maxDistSquared) : isInRange(check.nic, other);
+                if (inRange != check.nic->isConnected(other)) {
+                    check.changes.emplace_back(other, inRange);
+                }
+            }
+        }
+    };
+    if (workerPool) {
+        workerPool->run(numChecks, findChanges);
+    }
+    else {
+        for (size_t i = 0; i < numChecks; ++i) findChanges(i);
+    }
+
+    // step 3 - change connections, in deterministic order
+    for (size_t i = 0; i < numChecks; ++i) {
+        NicEntry* nic = connectionChecks[i].nic;
+        stepStatistics.numRangeChecks += connectionChecks[i].numRangeChecks;
+        for (const auto& change : connectionChecks[i].changes) {
+            NicEntry* other = change.first;
+            bool inRange = change.second;
+
+            // both nics moved: the other one might have already changed this connection
+            if (inRange == nic->isConnected(other)) continue;
+
+            if (inRange) {
+                EV_TRACE << "nic #" << nic->nicId << " and #" << other->nicId << " are in range" << endl;
+                connectNics(nic, other);
+            }
+            else {
+                EV_TRACE << "nic #" << nic->nicId << " and #" << other->nicId << " are NOT in range" << endl;
+                disconnectNics(nic, other);
+            }
+        }
+    }
+    if (recordStatistics) stepStatistics.updateTime += std::chrono::steady_clock::now() - start;
+}
+
+const NicEntry::GateList& BaseConnectionManager::getGateList(int nicID)
+{
+    commitPositionUpdates();
+    if (connectOnSend) {
+        NicEntries::iterator ItNic = nics.find(nicID);
+        if (ItNic == nics.end()) throw cRuntimeError("No nic with this ID (%d) is registered with this ConnectionManager.", nicID);
+        findNicsInRange(ItNic->second);
+        return nicsInRange;
+    }
+    return static_cast<const BaseConnectionManager*>(this)->getGateList(nicID);
+}
+
+void BaseConnectionManager::findNicsInRange(NicEntries::mapped_type nic)
+{
+    VEINS_PROFILE_SCOPE("BaseConnectionManager::findNicsInRange");
+    nicsInRange.clear();
+
+    CellIndexSet cells;
+    fillCellsWithNeighbors(cells, getCellForCoordinate(nic->pos));
+    for (auto index : cells) {
+        for (auto other : getFlatCell(index)) {
+            if (other == nic) continue;
+            stepStatistics.numRangeChecks++;
+            if (isInRange(nic, other)) nicsInRange.emplace_back(other, other->getRadioInGate());
+        }
+    }
+
+    // same order as the connections of a nic, so results do not depend on the grid
+    std::sort(nicsInRange.begin(), nicsInRange.end(), [](const NicEntry::Connection& a, const NicEntry::Connection& b) { return a.first->nicId < b.first->nicId; });
+}
+
+template <typename Visit>
+void BaseConnectionManager::forEachNicWithin(const Coord& pos, double radius, Visit visit) const
+{
+    const double sqrRadius = radius * radius;
+    auto visitIfWithin = [&](const NicEntry* nic) {
+        if (sqrDistance(pos, nic->pos) <= sqrRadius) visit(nic);
+    };
+
+    // range of cells overlapped by the radius, per axis (wrapped on a torus, clamped to the grid otherwise)
+    // (rounding down, as the range may extend beyond the playground)
+    auto cellOf = [](double value, double cellSize) { return static_cast<int>(std::floor(value / cellSize)); };
+    const GridCoord first(cellOf(pos.x - radius, findDistance.x), cellOf(pos.y - radius, findDistance.y), cellOf(pos.z - radius, findDistance.z));
+    const GridCoord last(cellOf(pos.x + radius, findDistance.x), cellOf(pos.y + radius, findDistance.y), cellOf(pos.z + radius, findDistance.z));
+    struct Range {
+        int first;
+        int count;
+    };
+    auto range = [this](int firstCell, int lastCell, int dim) {
+        if (useSparseGrid) return Range{firstCell, lastCell - firstCell + 1};
+        if (useTorus) return (lastCell - firstCell + 1 >= dim) ? Range{0, dim} : Range{firstCell, lastCell - firstCell + 1};
+        firstCell = std::max(firstCell, 0);
+        lastCell = std::min(lastCell, dim - 1);
+        return Range{firstCell, std::max(lastCell - firstCell + 1, 0)};
+    };
+    const Range xs = range(first.x, last.x, gridDim.x);
+    const Range ys = range(first.y, last.y, gridDim.y);
+    const Range zs = (useSparseGrid && !sparseGrid3D) ? Range{0, 1} : range(first.z, last.z, gridDim.z);
+
+    if (static_cast<double>(xs.count) * ys.count * zs.count > nics.size()) {
+        for (const auto& entry : nics) visitIfWithin(entry.second);
+        return;
+    }
+
+    auto wrap = [this](int value, int dim) {
+        if (useSparseGrid || !useTorus) return value;
+        return ((value % dim) + dim) % dim;
+    };
+    for (int ix = xs.first; ix < xs.first + xs.count; ix++) {
+        for (int iy = ys.first; iy < ys.first + ys.count; iy++) {
+            for (int iz = zs.first; iz < zs.first + zs.count; iz++) {
+                const GridCoord cell(wrap(ix, gridDim.x), wrap(iy, gridDim.y), wrap(iz, gridDim.z));
+                if (useFlatGrid) {
+                    for (const NicEntry* nic : getFlatCell(getFlatIndex(cell))) visitIfWithin(nic);
+                }
+                else {
+                    for (const auto& entry : nicGrid[cell.x][cell.y][cell.z]) visitIfWithin(entry.second);
+                }
+            }
+        }
+    }
+}
+
+void BaseConnectionManager::queryNodesInRadius(const Coord& pos, double radius, std::vector<const NicEntry*>& nodes)
+{
+    commitPositionUpdates();
+
+    nodes.clear();
+    forEachNicWithin(pos, radius, [&nodes](const NicEntry* nic) { nodes.push_back(nic); });
+    std::sort(nodes.begin(), nodes.end(), [](const NicEntry* a, const NicEntry* b) { return a->nicId < b->nicId; });
+}
+
+void BaseConnectionManager::kNearest(const Coord& pos, size_t k, std::vector<const NicEntry*>& nodes)
+{
+    commitPositionUpdates();
+
+    nodes.clear();
+    k = std::min(k, nics.size());
+    if (k == 0) return;
+
+    // grow the radius until it holds k nics; every nic within it is a candidate, as the k nearest are among them
+    std::vector<std::pair<double, const NicEntry*>>& candidates = nearestCandidates;
+    double radius = std::max(findDistance.x, findDistance.y);
+    while (true) {
+        candidates.clear();
+        forEachNicWithin(pos, radius, [&](const NicEntry* nic) { candidates.emplace_back(sqrDistance(pos, nic->pos), nic); });
+        if (candidates.size() >= k) break;
+        radius *= 2;
+    }
 
-    updateConnections(nicID, oldPos, newPos);
+    auto closer = [](const std::pair<double, const NicEntry*>& a, const std::pair<double, const NicEntry*>& b) {
+        return (a.first < b.first) || ((a.first == b.first) && (a.second->nicId < b.second->nicId));
+    };
+    std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end(), closer);
+    for (size_t i = 0; i < k; ++i) nodes.push_back(candidates[i].second);
 }
 
 const NicEntry::GateList& BaseConnectionManager::getGateList(int nicID) const
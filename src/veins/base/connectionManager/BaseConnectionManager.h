@@ -24,11 +24,20 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <map>
+
 #include "veins/veins.h"
 
 #include "veins/base/utils/AntennaPosition.h"
 #include "veins/base/connectionManager/NicEntry.h"
+#include "veins/base/connectionManager/FarFieldInterference.h"
 #include "veins/base/utils/Heading.h"
+#include "veins/base/utils/WorkerPool.h"
+#include "veins/base/utils/ModuleRegistry.h"
+#include "veins/base/utils/FlatHashMap.h"
+#include "veins/base/utils/MemoryAccounting.h"
 
 namespace veins {
 
@@ -42,6 +51,10 @@ class ChannelAccess;
  * nodes, and handles dynamic gate creation. BaseConnectionManager therefore
  * periodically communicates with the ChannelAccess modules
  *
+ * If batchPositionUpdates is set, position updates are only recorded
+ * and committed in one pass at the end of each TraCI timestep (or
+ * whenever connections are queried).
+ *
  * You may not instantiate BaseConnectionManager!
  * Use ConnectionManager instead.
  *
@@ -50,7 +63,7 @@ class ChannelAccess;
  * @author Christoph Sommer ("unregisterNic()"-method)
  * @sa ChannelAccess
  */
-class VEINS_API BaseConnectionManager : public cSimpleModule {
+class VEINS_API BaseConnectionManager : public cSimpleModule, public cListener {
 private:
     /**
      * @brief Represents a position inside a grid.
@@ -243,6 +256,46 @@ private:
         }
     };
 
+    /**
+     * @brief Represents a small, fixed-capacity set of flat grid cell indices.
+     *
+     * Holds the union of (at most) two 3x3x3 neighbourhoods without
+     * allocating, as used by the flat grid mode.
+     */
+    class VEINS_API CellIndexSet {
+    public:
+        /** @brief Two neighbourhoods of 27 cells each.*/
+        static const size_t maxSize = 2 * 27;
+
+    protected:
+        std::array<size_t, maxSize> data;
+        size_t size = 0;
+
+    public:
+        /**
+         * @brief Adds a cell index to the set.
+         * If the index is already contained nothing happens.
+         */
+        void add(size_t index)
+        {
+            for (size_t i = 0; i < size; ++i) {
+                if (data[i] == index) return;
+            }
+            ASSERT(size < maxSize);
+            data[size++] = index;
+        }
+
+        const size_t* begin() const
+        {
+            return data.data();
+        }
+
+        const size_t* end() const
+        {
+            return data.data() + size;
+        }
+    };
+
 protected:
     /** @brief Type for map from nic-module id to nic-module pointer.*/
     typedef std::map<int, NicEntry*> NicEntries;
@@ -259,10 +312,91 @@ protected:
     /** @brief the biggest interference distance in the network.*/
     double maxInterferenceDistance;
 
-    /** @brief Square of maxInterferenceDistance cache a value that
+    /** @brief Square of the (padded) maximum connection distance, cache of a value that
      * is often used */
     double maxDistSquared;
 
+    /**
+     * @brief Distance a nic may move before its connections are checked again.
+     *
+     * If non-zero, connections are only re-evaluated once a nic has moved
+     * this far from where they were last evaluated. To not miss any link,
+     * the connection distance is padded, see getMaxConnectionDistance().
+     */
+    double connectionUpdateSlack;
+
+    /** @brief Defer position updates until the end of a timestep?*/
+    bool batchPositionUpdates;
+
+    /** @brief Keep no connections, but find the nics in range of a sender when it asks for its gate list?*/
+    bool connectOnSend;
+
+    /** @brief The nics in range of the last sender, as returned by getGateList() if connectOnSend is set.*/
+    NicEntry::GateList nicsInRange;
+
+    /** @brief Nics with uncommitted position updates, in order of their first update.*/
+    std::vector<NicEntry*> pendingMoves;
+
+    /**
+     * @brief Connection check of one moved nic, as done by commitPositionUpdates().
+     */
+    struct ConnectionCheck {
+        /** @brief the moved nic */
+        NicEntry* nic;
+        /** @brief cell the nic was in when its connections were last checked */
+        GridCoord oldCell;
+        /** @brief cell the nic is in now */
+        GridCoord newCell;
+        /** @brief connections to change: other nic and whether it is in range */
+        std::vector<std::pair<NicEntry*, bool>> changes;
+        /** @brief scratch space for batched range checks: squared distances to the nics in a cell */
+        std::vector<double> sqrDistances;
+        /** @brief number of nics checked for being in range */
+        size_t numRangeChecks = 0;
+    };
+
+    /**
+     * @brief Counts of connection updates, see recordStatistics.
+     */
+    struct ConnectionStatistics {
+        /** @brief connections made */
+        uint64_t numConnects = 0;
+        /** @brief connections broken (also by unregistering nics) */
+        uint64_t numDisconnects = 0;
+        /** @brief pairs of nics checked for being in range (by isInRange() or batched distance checks) */
+        uint64_t numRangeChecks = 0;
+        /** @brief wall-clock time spent updating connections (only measured if recordStatistics is set) */
+        std::chrono::steady_clock::duration updateTime = std::chrono::steady_clock::duration::zero();
+    };
+
+    /** @brief Whether to emit connection statistics at the end of each TraCI timestep and record summaries in finish().*/
+    bool recordStatistics = false;
+
+    /** @brief Connection updates since the last TraCI timestep ended.*/
+    ConnectionStatistics stepStatistics;
+
+    /** @brief Connection updates of previous TraCI timesteps (not including stepStatistics).*/
+    ConnectionStatistics totalStatistics;
+
+    /** @brief Signals emitted at the end of each TraCI timestep if recordStatistics is set.*/
+    static const simsignal_t connectsSignal;
+    static const simsignal_t disconnectsSignal;
+    static const simsignal_t rangeChecksSignal;
+    static const simsignal_t updateConnectionsTimeSignal;
+    static const simsignal_t connectionsSignal;
+
+    /** @brief Connection checks of the current commit (kept to reuse their storage).*/
+    std::vector<ConnectionCheck> connectionChecks;
+
+    /** @brief Threads used to check connections when committing position updates, if any.*/
+    std::shared_ptr<WorkerPool> workerPool;
+
+    /** @brief Aggregated interference of far field transmitters (nullptr if farFieldDistance is 0).*/
+    std::unique_ptr<FarFieldInterference> farFieldInterference;
+
+    /** @brief Signal emitted by TraCIScenarioManager when it finished a timestep.*/
+    static const simsignal_t traciTimestepEndSignal;
+
     /** @brief Stores the useTorus flag of the WorldUtility */
     bool useTorus;
 
@@ -298,10 +432,81 @@ protected:
     /** @brief The size of the grid */
     GridCoord gridDim;
 
+    /** @brief Use the flat grid (flatGrid) instead of the nested one (nicGrid)?*/
+    bool useFlatGrid;
+
+    /** @brief Keep the cells of the flat grid in sparseGrid (by packed cell coordinates) instead of flatGrid?*/
+    bool useSparseGrid;
+
+    /** @brief Whether sparseGrid has more than one layer of cells in z direction */
+    bool sparseGrid3D = false;
+
+    /**
+     * @brief Whether connection updates check the nics of a cell in one batch, by squared distance.
+     *
+     * This is equivalent to the default isInRange() (which it bypasses) on playgrounds that are not a torus.
+     * Subclasses that override isInRange() must clear this.
+     */
+    bool batchedRangeChecks = true;
+
+    /**
+     * @brief One cell of the flat grid: nics sorted by nic id, along with their positions.
+     *
+     * The positions are the hot data of range checks. Keeping them next to each
+     * other (rather than reading them from the NicEntry objects, which mostly hold
+     * cold data like module pointers, gates and logging state) makes scanning a
+     * cell cache-linear. They equal NicEntry::pos of the nics once their position
+     * updates are committed.
+     */
+    struct FlatCell {
+        std::vector<NicEntry*> nics;
+        std::vector<Coord> positions; ///< position of each nic in nics, at the same index
+
+        std::vector<NicEntry*>::const_iterator begin() const
+        {
+            return nics.begin();
+        }
+
+        std::vector<NicEntry*>::const_iterator end() const
+        {
+            return nics.end();
+        }
+
+        size_t size() const
+        {
+            return nics.size();
+        }
+
+        NicEntry* operator[](size_t i) const
+        {
+            return nics[i];
+        }
+    };
+
+    /**
+     * @brief Contiguous register of all nics, one FlatCell per grid cell
+     *
+     * Alternative to nicGrid, indexed by getFlatIndex(). Only used if
+     * useFlatGrid is set.
+     */
+    std::vector<FlatCell> flatGrid;
+
+    /**
+     * @brief Cells of the flat grid that ever held a nic, by getFlatIndex()
+     *
+     * Alternative to flatGrid that is not bounded by the playground and
+     * whose memory scales with the occupied cells only. Only used if
+     * useSparseGrid is set.
+     */
+    FlatHashMap<FlatCell> sparseGrid;
+
 private:
     /** @brief Manages the connections of a registered nic. */
     void updateNicConnections(NicEntries& nmap, NicEntries::mapped_type nic);
 
+    /** @brief Connects or disconnects two nics depending on whether they are in range. */
+    void updateNicConnection(NicEntries::mapped_type nic, NicEntries::mapped_type other);
+
     /**
      * @brief Check connections of a nic in the grid
      */
@@ -310,7 +515,7 @@ private:
     /**
      * @brief Calculates the corresponding cell of a coordinate.
      */
-    GridCoord getCellForCoordinate(const Coord& c);
+    GridCoord getCellForCoordinate(const Coord& c) const;
 
     /**
      * @brief Returns the NicEntries of the cell with specified
@@ -330,6 +535,112 @@ private:
      */
     void fillUnionWithNeighbors(CoordSet& gridUnion, GridCoord cell);
 
+    /**
+     * @brief Flat grid counterpart of checkGrid().
+     */
+    void checkFlatGrid(const GridCoord& oldCell, const GridCoord& newCell, NicEntries::mapped_type nic);
+
+    /**
+     * @brief Returns the index of a cell in flatGrid (or its key in sparseGrid).
+     */
+    size_t getFlatIndex(const GridCoord& cell) const
+    {
+        if (useSparseGrid) {
+            // 21 bits per (offset) coordinate
+            auto pack = [](int value) { return static_cast<uint64_t>(value + (1 << 20)) & ((uint64_t(1) << 21) - 1); };
+            return static_cast<size_t>((pack(cell.x) << 42) | (pack(cell.y) << 21) | pack(cell.z));
+        }
+        return (static_cast<size_t>(cell.x) * gridDim.y + cell.y) * gridDim.z + cell.z;
+    }
+
+    /**
+     * @brief Returns the nics in the flat grid cell of the passed index (an empty cell if sparseGrid has none there).
+     */
+    const FlatCell& getFlatCell(size_t index) const;
+
+    /**
+     * @brief Returns the nics in the flat grid cell of the passed index, adding the cell to sparseGrid if needed.
+     */
+    FlatCell& getOrAddFlatCell(size_t index);
+
+    /**
+     * @brief sparseGrid counterpart of fillCellsWithNeighbors().
+     */
+    void fillSparseCellsWithNeighbors(CellIndexSet& cells, const GridCoord& cell) const;
+
+    /**
+     * @brief Adds the flat indices of every direct neighbor of a cell (and the cell itself) to a set.
+     *
+     * Flat grid counterpart of fillUnionWithNeighbors(), using a fixed 27 cell stencil.
+     */
+    void fillCellsWithNeighbors(CellIndexSet& cells, const GridCoord& cell);
+
+    /** @brief Inserts a nic into a flat grid cell, keeping it sorted by nic id.*/
+    static void insertIntoCell(FlatCell& cell, NicEntries::mapped_type nic);
+
+    /** @brief Removes a nic from a flat grid cell.*/
+    static void removeFromCell(FlatCell& cell, NicEntries::mapped_type nic);
+
+    /** @brief Stores the current position of a nic in its flat grid cell.*/
+    static void updatePositionInCell(FlatCell& cell, NicEntries::mapped_type nic);
+
+    /**
+     * @brief Updates grid membership and connections of a nic whose position
+     * changed from oldPos to its current position.
+     */
+    void applyNicMove(NicEntries::mapped_type nic, Coord oldPos);
+
+    /**
+     * @brief Moves a nic from one grid cell to another without checking its connections.
+     */
+    void moveInGrid(NicEntries::mapped_type nic, const GridCoord& oldCell, const GridCoord& newCell);
+
+    /**
+     * @brief Collects all nics in range of the passed one into nicsInRange, sorted by nic id (like the connections of a nic).
+     */
+    void findNicsInRange(NicEntries::mapped_type nic);
+
+    /**
+     * @brief Connects nics a and b (in both directions) and notifies their listeners.
+     */
+    void connectNics(NicEntry* a, NicEntry* b);
+
+    /**
+     * @brief Disconnects nics a and b (in both directions) and notifies their listeners.
+     */
+    void disconnectNics(NicEntry* a, NicEntry* b);
+
+    /**
+     * @brief Notifies the listeners of nic that neighbour was disconnected from it (as neighbour is unregistered).
+     */
+    void notifyNeighbourLeft(NicEntry* nic, const NicEntry* neighbour);
+
+    /**
+     * @brief Calls notify on all listeners of nic, skipping the ones unsubscribed meanwhile (see NicEntry::neighbourNotifications).
+     */
+    void notifyNeighbourListeners(NicEntry* nic, const NicEntry* neighbour, void (NeighbourListener::*notify)(cModule*, cModule*));
+
+    /**
+     * @brief Emits the statistics of the TraCI timestep that just ended and adds them to the totals.
+     */
+    void emitStepStatistics();
+
+    /**
+     * @brief Records totals of the connection statistics, and histograms of nics per grid cell and neighbours per nic.
+     */
+    void recordStatisticsSummary();
+
+    /**
+     * @brief Calls visit for every nic within radius of pos, scanning only the grid cells the radius overlaps.
+     *
+     * Falls back to scanning all nics if the radius overlaps more cells than there are nics.
+     */
+    template <typename Visit>
+    void forEachNicWithin(const Coord& pos, double radius, Visit visit) const;
+
+    /** @brief Per nearest neighbour query, the nics found and their squared distances (kept to reuse their storage).*/
+    std::vector<std::pair<double, const NicEntry*>> nearestCandidates;
+
 protected:
     /**
      * @brief Calculate interference distance
@@ -343,6 +654,18 @@ protected:
      */
     virtual double calcInterfDist() = 0;
 
+    /**
+     * @brief Returns the distance up to which nics are connected, i.e., maxInterferenceDistance padded by connectionUpdateSlack.
+     *
+     * When one end of a pair is checked, the other may have moved up to the slack from where it was last checked,
+     * and may then move across to the opposite side before being checked again. Together with the first end moving
+     * up to the slack as well, the pair can close in by three times the slack without either end being checked.
+     */
+    double getMaxConnectionDistance() const
+    {
+        return maxInterferenceDistance + 3 * connectionUpdateSlack;
+    }
+
     /**
      * @brief Called by "registerNic()" after the nic has been
      * registered. That means that the NicEntry for the nic has already been
@@ -376,6 +699,7 @@ protected:
      *
      * This function will be used to decide if two nic's shall be connected or not. It
      * is simple to overload this function to enhance the decision for connection or not.
+     * Overriding it requires clearing batchedRangeChecks.
      *
      * @param pFromNic Nic source point which should be checked.
      * @param pToNic   Nic target point which should be checked.
@@ -398,6 +722,17 @@ public:
      **/
     void initialize(int stage) override;
 
+    void finish() override;
+
+    void finish(cComponent* component, simsignal_t signalID) override
+    {
+        cListener::finish(component, signalID);
+    }
+
+    /** @brief Commits batched position updates at the end of a TraCI timestep.*/
+    using cListener::receiveSignal;
+    void receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details) override;
+
     /**
      * @brief Registers a nic to have its connections managed by ConnectionManager.
      *
@@ -420,14 +755,149 @@ public:
      */
     bool unregisterNic(cModule* nic);
 
-    /** @brief Updates the position information of a registered nic.*/
+    /**
+     * @brief Unregisters several NICs at once, like calling unregisterNic() for each.
+     *
+     * Their connections are dropped by walking their own connection lists rather than
+     * all NICs in the neighbouring cells, and their pending position updates are
+     * discarded (not applied) in a single pass.
+     *
+     * @param nics the NIC modules to be unregistered (each previously registered with this ConnectionManager)
+     */
+    void unregisterNics(const std::vector<cModule*>& nics);
+
+    /**
+     * @brief Updates the position information of a registered nic.
+     *
+     * If batchPositionUpdates is set, the connections of the nic are
+     * only updated by the next call to commitPositionUpdates().
+     */
     void updateNicPos(int nicID, Coord newPos, Heading heading);
 
-    /** @brief Returns the ingates of all nics in range*/
+    /**
+     * @brief Updates grid membership and connections of all nics moved since the last call.
+     *
+     * With the flat grid, this first moves all nics to their new cells, then
+     * finds the connections to change (in parallel, if numWorkerThreads is
+     * set), then changes them on the calling thread, ordered by cell and nic id.
+     * Note that isInRange() therefore needs to be thread safe.
+     */
+    void commitPositionUpdates();
+
+    /**
+     * @brief Notifies listener whenever a nic gets connected to or disconnected from the passed nic.
+     *
+     * Calls neighbourEntered() for the nics the passed nic is connected to right away, so the listener starts with the complete set.
+     * Not supported with connectOnSend, which keeps no connections.
+     * Listeners are not notified of the connections dropped when the passed nic itself is unregistered;
+     * they must be unsubscribed before they are deleted.
+     *
+     * @param nic the NIC module (previously registered with this ConnectionManager)
+     */
+    void subscribeNeighbourChanges(cModule* nic, NeighbourListener* listener);
+
+    /**
+     * @brief Stops notifying listener of changes of the connections of nic (which may already be unregistered).
+     */
+    void unsubscribeNeighbourChanges(cModule* nic, NeighbourListener* listener);
+
+    /**
+     * @brief Returns the ingates of all nics in range, after committing pending position updates.
+     *
+     * If connectOnSend is set, the nics are looked up on each call and the result is only valid until the next one.
+     */
+    const NicEntry::GateList& getGateList(int nicID);
+
+    /** @brief Returns the ingates of all nics connected to the nic (none if connectOnSend is set)*/
     const NicEntry::GateList& getGateList(int nicID) const;
 
     /** @brief Returns the ingate of the with id==targetID, or 0 if not in range*/
     const cGate* getOutGateTo(const NicEntry* nic, const NicEntry* targetNic) const;
+
+    /**
+     * @brief Returns the maximum interference distance of all nics.
+     */
+    double getMaxInterferenceDistance() const
+    {
+        return maxInterferenceDistance;
+    }
+
+    /**
+     * @brief Returns the worker threads of this connection manager (nullptr if numWorkerThreads is 0).
+     *
+     * Other modules may use them for parallel loops outside of commitPositionUpdates().
+     */
+    WorkerPool* getWorkerPool() const
+    {
+        return workerPool.get();
+    }
+
+    /**
+     * @brief Returns the aggregated interference of far field transmitters (nullptr if farFieldDistance is 0).
+     *
+     * Phy layers add their transmissions to it instead of sending AirFrames to nics in the far field, see FarFieldInterference.
+     */
+    FarFieldInterference* getFarFieldInterference() const
+    {
+        return farFieldInterference.get();
+    }
+
+    /**
+     * @brief Returns whether a registered nic (not belonging to host excludeHostId) is within the maximum interference distance of pos.
+     *
+     * Only searches the grid cells around pos, so the cost does not grow with the number of nics in the network.
+     * Nics with a move not yet applied by commitPositionUpdates() are checked one by one, so callers
+     * asking many times per step should commit pending moves first.
+     */
+    bool hasNicInRange(const Coord& pos, int excludeHostId = -1) const;
+
+    /**
+     * @brief Returns whether a and b are at most distance apart (on the torus, if useTorus is set).
+     */
+    bool isWithinDistance(const Coord& a, const Coord& b, double distance) const
+    {
+        return sqrDistance(a, b) <= distance * distance;
+    }
+
+    /**
+     * @brief Returns the squared distance of a and b (on the torus, if useTorus is set).
+     */
+    double sqrDistance(const Coord& a, const Coord& b) const
+    {
+        return useTorus ? a.sqrTorusDist(b, *playgroundSize) : a.sqrdist(b);
+    }
+
+    /**
+     * @brief Finds all registered nics within radius of pos, after committing pending position updates, sorted by nic id.
+     *
+     * Meant for applications looking for nearby nodes: only the grid cells the radius overlaps are scanned,
+     * so the cost does not grow with the number of nics in the network. NicEntry::nicPtr and NicEntry::hostId
+     * of the results identify the nic and host modules.
+     *
+     * @param nodes receives the nics (cleared first), valid until the nics are unregistered
+     */
+    void queryNodesInRadius(const Coord& pos, double radius, std::vector<const NicEntry*>& nodes);
+
+    /**
+     * @brief Finds the k registered nics closest to pos, after committing pending position updates, sorted by distance (then nic id).
+     *
+     * Searches radii growing from the size of a grid cell. Fewer than k nics are only returned if fewer are registered.
+     *
+     * @param nodes receives the nics (cleared first), valid until the nics are unregistered
+     */
+    void kNearest(const Coord& pos, size_t k, std::vector<const NicEntry*>& nodes);
+
+    /**
+     * @brief Returns the number of (directed) connections between registered nics (0 if connectOnSend is set).
+     */
+    size_t getNumConnections() const;
+
+private:
+    /** @brief Estimates the memory held by the nics, their connections and the grid, see MemoryAccounting. */
+    MemoryAccounting::Usage getMemoryUsage() const;
+
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
+    MemoryAccounting::Registration memoryRegistration; /**< reports getMemoryUsage() as subsystem "connectionManager" */
 };
 
 } // namespace veins
@@ -41,6 +41,11 @@ BaseConnectionManager* ChannelAccess::getConnectionManager(cModule* nic)
     if (cmName != "") {
         cModule* ccModule = veins::findModuleByPath(cmName.c_str());
 
+        // NICs keep direct pointers to the connection manager (and vice versa), which does not work across partitions of a parallel simulation
+        if (ccModule && ccModule->isPlaceholder()) {
+            throw cRuntimeError("Connection manager %s is in another partition than nic %s: all nics have to be in the partition of their connection manager", ccModule->getFullPath().c_str(), nic->getFullPath().c_str());
+        }
+
         return dynamic_cast<BaseConnectionManager*>(ccModule);
     }
     else {
@@ -80,32 +85,78 @@ void ChannelAccess::initialize(int stage)
     usePropagationDelay = par("usePropagationDelay");
 }
 
+void ChannelAccess::resetForReuse(int stage)
+{
+    BatteryAccess::resetForReuse(stage);
+
+    if (stage == 0) {
+        // the nic was unregistered when its host got recycled
+        isRegistered = false;
+        interferenceDistanceFactor = 1;
+    }
+}
+
 void ChannelAccess::sendToChannel(cPacket* msg)
 {
     EV_TRACE << "sendToChannel: sending to gates\n";
 
     const auto& gateList = cc->getGateList(getParentModule()->getId());
 
+    // transmissions with reduced reach leave out the connected nics beyond it
+    const bool reducedReach = interferenceDistanceFactor < 1;
+    const double reach = interferenceDistanceFactor * cc->getMaxInterferenceDistance();
+
+    receiverNics.clear();
+    receiverGates.clear();
     for (auto&& entry : gateList) {
-        const auto gate = entry.second;
-        const auto propagationDelay = calculatePropagationDelay(entry.first);
-
-        if (useSendDirect) {
-            if (gate->isVector()) {
-                for (int gateIndex = gate->getBaseId(); gateIndex < gate->getBaseId() + gate->size(); gateIndex++) {
-                    sendDirect(msg->dup(), propagationDelay, msg->getDuration(), gate->getOwnerModule(), gateIndex);
-                }
-            }
-            else {
-                sendDirect(msg->dup(), propagationDelay, msg->getDuration(), gate->getOwnerModule(), gate->getBaseId());
-            }
-        }
-        else {
-            sendDelayed(msg->dup(), propagationDelay, gate);
+        if (reducedReach && !cc->isWithinDistance(antennaPosition.getPositionAt(), entry.first->pos, reach)) continue;
+        if (!isReceiverReachable(msg, entry.first)) continue;
+        receiverNics.push_back(entry.first);
+        receiverGates.push_back(entry.second);
+    }
+
+    if (receiverNics.empty()) {
+        // no receiver at all, original message no longer needed
+        delete msg;
+        return;
+    }
+
+    // every reachable receiver but the last one gets a copy, the last one gets the original message.
+    // Copies are cheap: the encapsulated packet is shared (reference counted) among all of them
+    // and only duplicated by a receiver that decapsulates it, the spectrum of the signal is shared as well.
+    receiverMessages.clear();
+    for (size_t i = 0; i + 1 < receiverNics.size(); ++i) {
+        receiverMessages.push_back(msg->dup());
+    }
+    receiverMessages.push_back(msg);
+
+    prepareForReceivers(receiverMessages, receiverNics);
+
+    for (size_t i = 0; i < receiverNics.size(); ++i) {
+        sendToNic(receiverMessages[i], receiverNics[i], receiverGates[i], true);
+    }
+}
+
+bool ChannelAccess::hasConnectedNics()
+{
+    return !cc->getGateList(getParentModule()->getId()).empty();
+}
+
+void ChannelAccess::sendToNic(cPacket* msg, const NicEntry* nic, cGate* gate, bool sendOriginal)
+{
+    const auto propagationDelay = calculatePropagationDelay(nic);
+
+    if (useSendDirect) {
+        const simtime_t duration = msg->getDuration();
+        const int lastGateIndex = gate->getBaseId() + (gate->isVector() ? gate->size() : 1) - 1;
+        for (int gateIndex = gate->getBaseId(); gateIndex <= lastGateIndex; gateIndex++) {
+            cPacket* copy = (sendOriginal && gateIndex == lastGateIndex) ? msg : msg->dup();
+            sendDirect(copy, propagationDelay, duration, gate->getOwnerModule(), gateIndex);
         }
     }
-    // Original message no longer needed, copies have been sent to all possible receivers.
-    delete msg;
+    else {
+        sendDelayed(sendOriginal ? msg : msg->dup(), propagationDelay, gate);
+    }
 }
 
 simtime_t ChannelAccess::calculatePropagationDelay(const NicEntry* nic)
@@ -133,7 +184,7 @@ void ChannelAccess::receiveSignal(cComponent* source, simsignal_t signalID, cObj
         ChannelMobilityPtrType const mobility = check_and_cast<ChannelMobilityPtrType>(obj);
 
         auto heading = Heading::fromCoord(mobility->getCurrentOrientation());
-        antennaPosition = AntennaPosition(getId(), mobility->getPositionAt(simTime()) + antennaOffset.rotatedYaw(-heading.getRad()), mobility->getCurrentSpeed(), simTime());
+        antennaPosition = AntennaPosition(getId(), mobility->getPositionAt(simTime()) + antennaOffset.rotatedYaw(-heading.getRad()), mobility->getCurrentSpeed(), mobility->getCurrentAcceleration(), simTime());
         antennaHeading = Heading(heading.getRad() + antennaOffsetYaw);
 
         if (isRegistered) {
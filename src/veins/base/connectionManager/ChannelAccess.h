@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include "veins/veins.h"
@@ -90,6 +91,14 @@ protected:
     /** @brief Offset of antenna orientation (yaw, in rad) with respect to what a BaseMobility module will tell us */
     double antennaOffsetYaw = 0;
 
+    /** @brief Fraction of the connection manager's maximum interference distance the transmissions of this nic reach (see setInterferenceDistanceFactor()) */
+    double interferenceDistanceFactor = 1;
+
+    /** @brief Receivers of the message being sent by sendToChannel(), their gates, and their copies of the message (kept to reuse their memory) */
+    std::vector<const NicEntry*> receiverNics;
+    std::vector<cGate*> receiverGates;
+    std::vector<cPacket*> receiverMessages;
+
 protected:
     /**
      * @brief Calculates the propagation delay to the passed receiving nic.
@@ -107,6 +116,41 @@ protected:
      **/
     void sendToChannel(cPacket* msg);
 
+    /**
+     * @brief Returns whether sendToChannel() would currently consider any nic at all, i.e., whether this nic has connections.
+     *
+     * If the connection manager connects nics only on send, this searches the neighbourhood just like sendToChannel() does.
+     */
+    bool hasConnectedNics();
+
+    /**
+     * @brief Sends copies of the passed message to all gates of the passed nic connection.
+     *
+     * If sendOriginal is set, the last gate gets the message itself instead of a copy.
+     */
+    void sendToNic(cPacket* msg, const NicEntry* nic, cGate* gate, bool sendOriginal);
+
+    /**
+     * @brief Returns whether the passed message can have any effect at the passed receiving nic.
+     *
+     * Called by sendToChannel() for every connected nic; nics this returns false for
+     * do not get a copy of the message (and no event is scheduled for them).
+     * The default implementation considers every connected nic to be reachable.
+     */
+    virtual bool isReceiverReachable(cPacket* msg, const NicEntry* nic)
+    {
+        return true;
+    }
+
+    /**
+     * @brief Called by sendToChannel() with the copy of the message for each receiving nic before any of them is sent.
+     *
+     * The default implementation does nothing.
+     */
+    virtual void prepareForReceivers(const std::vector<cPacket*>& msgs, const std::vector<const NicEntry*>& nics)
+    {
+    }
+
 public:
     /**
      * @brief Returns a pointer to the ConnectionManager responsible for the
@@ -125,6 +169,9 @@ public:
      **/
     void initialize(int stage) override;
 
+    /** @brief Forgets the registration with the ConnectionManager, which is redone on the next mobility update.*/
+    void resetForReuse(int stage) override;
+
     /**
      * @brief Called by the signalling mechanism to inform of changes.
      *
@@ -145,6 +192,24 @@ public:
     {
         return antennaPosition;
     }
+
+    /**
+     * @brief Limits the reach of the following transmissions of this nic to the given fraction of the maximum interference distance.
+     *
+     * Connections are still kept for the maximum interference distance (this nic may receive from farther nics),
+     * but sendToChannel() leaves out connected nics beyond the reduced distance, e.g., while sending with reduced power.
+     *
+     * @param factor fraction of the maximum interference distance, clamped to [0, 1] (1: no reduction)
+     */
+    void setInterferenceDistanceFactor(double factor)
+    {
+        interferenceDistanceFactor = std::min(std::max(factor, 0.0), 1.0);
+    }
+
+    double getInterferenceDistanceFactor() const
+    {
+        return interferenceDistanceFactor;
+    }
 };
 
 } // namespace veins
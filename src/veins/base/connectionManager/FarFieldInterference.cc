@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/connectionManager/FarFieldInterference.h"
+
+#include <cmath>
+#include <functional>
+
+#include "veins/base/modules/BaseWorldUtility.h"
+
+using namespace veins;
+
+namespace {
+
+// cells are two-dimensional, so are distances to their centers
+double sqrDistance2D(const Coord& a, const Coord& b)
+{
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+size_t FarFieldInterference::SummaryKeyHash::operator()(const SummaryKey& key) const
+{
+    size_t hash = std::hash<int32_t>()(key.cellX);
+    hash = hash * 31 + std::hash<int32_t>()(key.cellY);
+    hash = hash * 31 + std::hash<double>()(key.frequency);
+    return hash;
+}
+
+FarFieldInterference::FarFieldInterference(double nearFieldDistance, double cellSize, simtime_t sliceDuration, simtime_t retention, double alpha)
+    : nearFieldDistance(nearFieldDistance)
+    , cellSize(cellSize)
+    , sliceDuration(SIMTIME_DBL(sliceDuration))
+    , retention(SIMTIME_DBL(retention))
+    , alpha(alpha)
+{
+    if (cellSize <= 0) throw cRuntimeError("FarFieldInterference: cellSize must be positive");
+    // receivers sharing a cell with a sender must get its AirFrames
+    if (nearFieldDistance < cellSize) throw cRuntimeError("FarFieldInterference: nearFieldDistance must be at least cellSize");
+    if (sliceDuration <= 0) throw cRuntimeError("FarFieldInterference: sliceDuration must be positive");
+    if (retention < 0) throw cRuntimeError("FarFieldInterference: retention must not be negative");
+}
+
+int32_t FarFieldInterference::getCell(double position) const
+{
+    return static_cast<int32_t>(std::floor(position / cellSize));
+}
+
+Coord FarFieldInterference::getCellCenter(int32_t cellX, int32_t cellY) const
+{
+    return Coord((cellX + 0.5) * cellSize, (cellY + 0.5) * cellSize);
+}
+
+bool FarFieldInterference::isFarField(const Coord& senderPos, const Coord& receiverPos) const
+{
+    const Coord center = getCellCenter(getCell(senderPos.x), getCell(senderPos.y));
+    return sqrDistance2D(center, receiverPos) > nearFieldDistance * nearFieldDistance;
+}
+
+void FarFieldInterference::add(const Coord& senderPos, double frequency, double power, simtime_t_cref start, simtime_t_cref end)
+{
+    const double startTime = SIMTIME_DBL(start);
+    const double endTime = SIMTIME_DBL(end);
+
+    // forget slices no receiver looks at any more
+    const int64_t firstKept = static_cast<int64_t>(std::floor((startTime - retention) / sliceDuration));
+    slices.erase(slices.begin(), slices.lower_bound(firstKept));
+
+    const SummaryKey key{getCell(senderPos.x), getCell(senderPos.y), frequency};
+    const int64_t firstSlice = static_cast<int64_t>(std::floor(startTime / sliceDuration));
+    const int64_t lastSlice = std::max(firstSlice, static_cast<int64_t>(std::ceil(endTime / sliceDuration)) - 1);
+    for (int64_t index = firstSlice; index <= lastSlice; ++index) {
+        const double sliceStart = index * sliceDuration;
+        const double overlap = std::min(endTime, sliceStart + sliceDuration) - std::max(startTime, sliceStart);
+        if (overlap <= 0) continue;
+        slices[index][key] += power * overlap / sliceDuration;
+    }
+    numTransmissions++;
+}
+
+double FarFieldInterference::getMaxPower(const Coord& receiverPos, double frequency, simtime_t_cref from, simtime_t_cref to, double maxDistance) const
+{
+    if (slices.empty()) return 0;
+
+    const double wavelength = BaseWorldUtility::speedOfLight() / frequency;
+    const double freeSpaceFactor = (wavelength * wavelength) / (16.0 * M_PI * M_PI);
+    const double nearFieldDistanceSquared = nearFieldDistance * nearFieldDistance;
+    const double maxDistanceSquared = maxDistance * maxDistance;
+
+    // a slice overlaps [from, to] if it starts before to (or contains to, if the interval is a single point in time)
+    const int64_t firstSlice = static_cast<int64_t>(std::floor(SIMTIME_DBL(from) / sliceDuration));
+    const int64_t lastSlice = std::max(firstSlice, static_cast<int64_t>(std::ceil(SIMTIME_DBL(to) / sliceDuration)) - 1);
+
+    double maxPower = 0;
+    for (auto slice = slices.lower_bound(firstSlice); slice != slices.end() && slice->first <= lastSlice; ++slice) {
+        double power = 0;
+        for (const auto& summary : slice->second) {
+            if (summary.first.frequency != frequency) continue;
+            const double sqrDistance = sqrDistance2D(getCellCenter(summary.first.cellX, summary.first.cellY), receiverPos);
+            if (sqrDistance <= nearFieldDistanceSquared || sqrDistance > maxDistanceSquared) continue;
+            power += summary.second * freeSpaceFactor * pow(sqrDistance, -alpha / 2);
+        }
+        maxPower = std::max(maxPower, power);
+    }
+    return maxPower;
+}
+
+size_t FarFieldInterference::getNumSummaries() const
+{
+    size_t numSummaries = 0;
+    for (const auto& slice : slices) {
+        numSummaries += slice.second.size();
+    }
+    return numSummaries;
+}
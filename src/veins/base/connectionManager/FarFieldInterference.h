@@ -0,0 +1,122 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/Coord.h"
+
+namespace veins {
+
+/**
+ * @brief Aggregates the interference of distant transmitters per grid cell and time slice.
+ *
+ * Receivers whose distance to the center of a sender's grid cell exceeds nearFieldDistance are in the far field of that sender:
+ * instead of an individual AirFrame, they only see the power of all transmitters of that cell, averaged over each time slice.
+ * This power is attenuated by free space path loss (with exponent alpha) from the cell center to the receiver.
+ * Transmissions are only summed with others on the same (center) frequency.
+ *
+ * Senders and receivers use the same criterion (see isFarField()), so every transmission reaches every receiver exactly once, either as an AirFrame or as part of a summary.
+ *
+ * @ingroup connectionManager
+ */
+class VEINS_API FarFieldInterference {
+public:
+    /**
+     * @param nearFieldDistance distance from the center of a sender's cell up to which receivers get individual AirFrames (in m, at least cellSize)
+     * @param cellSize side length of square grid cells transmitters are aggregated in (in m)
+     * @param sliceDuration length of the time slices transmissions are averaged over
+     * @param retention how long slices are kept after they ended (at least the longest time a receiver looks back)
+     * @param alpha path loss exponent used from cell centers to receivers
+     */
+    FarFieldInterference(double nearFieldDistance, double cellSize, simtime_t sliceDuration, simtime_t retention, double alpha);
+
+    /**
+     * @brief Returns whether a receiver at receiverPos is in the far field of a sender at senderPos.
+     */
+    bool isFarField(const Coord& senderPos, const Coord& receiverPos) const;
+
+    /**
+     * @brief Adds a transmission of the given power (in mW, at the given center frequency in Hz) from senderPos during [start, end).
+     *
+     * Also forgets about slices that ended more than retention before start.
+     */
+    void add(const Coord& senderPos, double frequency, double power, simtime_t_cref start, simtime_t_cref end);
+
+    /**
+     * @brief Returns the largest far field power (in mW) received at receiverPos on the given frequency in any slice overlapping [from, to].
+     *
+     * Only considers cells within maxDistance of receiverPos.
+     */
+    double getMaxPower(const Coord& receiverPos, double frequency, simtime_t_cref from, simtime_t_cref to, double maxDistance) const;
+
+    /**
+     * @brief Returns the number of transmissions added so far.
+     */
+    size_t getNumTransmissions() const
+    {
+        return numTransmissions;
+    }
+
+    /**
+     * @brief Returns the number of (cell, frequency) summaries currently kept over all slices.
+     */
+    size_t getNumSummaries() const;
+
+protected:
+    struct SummaryKey {
+        int32_t cellX;
+        int32_t cellY;
+        double frequency;
+
+        bool operator==(const SummaryKey& other) const
+        {
+            return cellX == other.cellX && cellY == other.cellY && frequency == other.frequency;
+        }
+    };
+
+    struct SummaryKeyHash {
+        size_t operator()(const SummaryKey& key) const;
+    };
+
+    /** @brief average power (in mW) of all transmissions of a cell on a frequency during a slice */
+    using Slice = std::unordered_map<SummaryKey, double, SummaryKeyHash>;
+
+    int32_t getCell(double position) const;
+    Coord getCellCenter(int32_t cellX, int32_t cellY) const;
+
+    const double nearFieldDistance;
+    const double cellSize;
+    const double sliceDuration;
+    const double retention;
+    const double alpha;
+
+    std::map<int64_t, Slice> slices; /**< by index (start time divided by sliceDuration) */
+    size_t numTransmissions = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,58 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Receives changes of the nics connected to a nic, see BaseConnectionManager::subscribeNeighbourChanges().
+ *
+ * Meant for applications that keep exact neighbour sets (e.g., ideal-knowledge baselines) without processing beacons.
+ * Neighbours are the nics within the maximum interference distance as maintained by the connection manager,
+ * i.e., they may be up to connectionUpdateSlack off and change only when its connections are updated.
+ *
+ * Methods are called from within the connection manager (in the context of whichever module moved a nic), so implementations
+ * that schedule or send messages must use Enter_Method_Silent() first, and must not move or (un)register nics.
+ * They may subscribe or unsubscribe listeners (including themselves): listeners subscribed meanwhile are notified from the
+ * next change on, listeners unsubscribed meanwhile are not notified anymore (so they may be deleted right away).
+ *
+ * @ingroup connectionManager
+ */
+class VEINS_API NeighbourListener {
+public:
+    virtual ~NeighbourListener() = default;
+
+    /**
+     * @brief Called when neighbourNic was connected to nic.
+     */
+    virtual void neighbourEntered(cModule* nic, cModule* neighbourNic) = 0;
+
+    /**
+     * @brief Called when neighbourNic was disconnected from nic (as it left its range or was unregistered).
+     */
+    virtual void neighbourLeft(cModule* nic, cModule* neighbourNic) = 0;
+};
+
+} // namespace veins
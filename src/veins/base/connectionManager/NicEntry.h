@@ -27,12 +27,15 @@
 
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "veins/veins.h"
 
 #include "veins/base/utils/Coord.h"
 #include "veins/base/utils/Heading.h"
+#include "veins/base/connectionManager/NeighbourListener.h"
 #include "veins/modules/utility/HasLogProxy.h"
 
 namespace veins {
@@ -48,18 +51,12 @@ class ChannelAccess;
  * @sa ConnectionManager
  */
 class VEINS_API NicEntry : public HasLogProxy {
-protected:
-    class VEINS_API NicEntryComparator {
-    public:
-        bool operator()(const NicEntry* nic1, const NicEntry* nic2) const
-        {
-            return nic1->nicId < nic2->nicId;
-        }
-    };
-
 public:
-    /** @brief Type for map from NicEntry pointer to a gate.*/
-    typedef std::map<const NicEntry*, cGate*, NicEntryComparator> GateList;
+    /** @brief Connected nic and the gate to send messages to it, see GateList */
+    typedef std::pair<const NicEntry*, cGate*> Connection;
+
+    /** @brief Connections to other nics, contiguous and sorted by nicId of the remote nic (for a deterministic order).*/
+    typedef std::vector<Connection> GateList;
 
     /** @brief module id of the nic for which information is stored*/
     int nicId;
@@ -73,22 +70,70 @@ public:
     /** @brief Geographic location of the nic*/
     Coord pos;
 
+    /** @brief Location of the nic when its connections were last checked*/
+    Coord lastCheckedPos;
+
+    /** @brief Is a position update of this nic waiting to be committed?*/
+    bool hasPendingMove = false;
+
+    /** @brief Location of the nic before its (first) uncommitted position update*/
+    Coord pendingOldPos;
+
     /** @brief Heading (angle) of the nic*/
     Heading heading;
 
     /** @brief Points to this nics ChannelAccess module */
     ChannelAccess* chAccess;
 
+    /** @brief Gate messages sent directly to this nic enter through (start of the path to its radioIn gate), nullptr until first needed*/
+    cGate* radioInGate = nullptr;
+
+    /** @brief Listeners notified of changes of the connections of this nic, see BaseConnectionManager::subscribeNeighbourChanges()*/
+    std::vector<NeighbourListener*> neighbourListeners;
+
+    /** @brief Number of notifications of neighbourListeners in progress; meanwhile, unsubscribed listeners are set to nullptr instead of being removed*/
+    int neighbourNotifications = 0;
+
 protected:
     /** @brief Outgoing connections of this nic
      *
-     * This map stores all connection for this nic to other nics
+     * This vector stores all connection for this nic to other nics
      *
-     * The first entry is the module id of the nic the connection is
+     * The first entry is the nic the connection is
      * going to and the second the gate to send the msg to
      **/
     GateList outConns;
 
+    /** @brief Returns the position of the connection to other in outConns, or where it would need to be inserted*/
+    GateList::iterator findConnection(const NicEntry* other)
+    {
+        return std::lower_bound(outConns.begin(), outConns.end(), other, [](const Connection& connection, const NicEntry* nic) { return connection.first->nicId < nic->nicId; });
+    }
+
+    GateList::const_iterator findConnection(const NicEntry* other) const
+    {
+        return std::lower_bound(outConns.begin(), outConns.end(), other, [](const Connection& connection, const NicEntry* nic) { return connection.first->nicId < nic->nicId; });
+    }
+
+    /** @brief Adds (or replaces) the connection to other*/
+    void addConnection(const NicEntry* other, cGate* gate)
+    {
+        auto connection = findConnection(other);
+        if (connection != outConns.end() && connection->first == other) {
+            connection->second = gate;
+        }
+        else {
+            outConns.emplace(connection, other, gate);
+        }
+    }
+
+    /** @brief Removes the connection to other, if any*/
+    void removeConnection(const NicEntry* other)
+    {
+        auto connection = findConnection(other);
+        if (connection != outConns.end() && connection->first == other) outConns.erase(connection);
+    }
+
 public:
     /**
      * @brief Constructor, initializes all members
@@ -112,6 +157,17 @@ public:
     /** @brief Disconnect two nics */
     virtual void disconnectFrom(NicEntry*) = 0;
 
+    /** @brief Returns the gate messages sent directly to this nic enter through, looking it up on first use*/
+    cGate* getRadioInGate()
+    {
+        if (!radioInGate) {
+            cGate* radioGate = nicPtr->gate("radioIn");
+            if (radioGate == nullptr) throw cRuntimeError("Nic has no radioIn gate!");
+            radioInGate = radioGate->getPathStartGate();
+        }
+        return radioInGate;
+    }
+
     /** @brief return the actual gateList*/
     const GateList& getGateList()
     {
@@ -119,9 +175,10 @@ public:
     }
 
     /** @brief Checks if this nic is connected to the "other" nic*/
-    bool isConnected(const NicEntry* other)
+    bool isConnected(const NicEntry* other) const
     {
-        return (outConns.find(other) != outConns.end());
+        auto connection = findConnection(other);
+        return connection != outConns.end() && connection->first == other;
     };
 
     /**
@@ -132,9 +189,10 @@ public:
      *
      * @param to pointer to the NicEntry to which the packet is about to be sent
      */
-    const cGate* getOutGateTo(const NicEntry* to)
+    const cGate* getOutGateTo(const NicEntry* to) const
     {
-        return outConns[to];
+        auto connection = findConnection(to);
+        return (connection != outConns.end() && connection->first == to) ? connection->second : nullptr;
     };
 };
 
@@ -41,7 +41,7 @@ void NicEntryDebug::connectTo(NicEntry* other)
 
     cGate* localoutgate = requestOutGate();
     localoutgate->connectTo(otherNic->requestInGate());
-    outConns[other] = localoutgate->getPathStartGate();
+    addConnection(other, localoutgate->getPathStartGate());
 }
 
 void NicEntryDebug::disconnectFrom(NicEntry* other)
@@ -51,7 +51,7 @@ void NicEntryDebug::disconnectFrom(NicEntry* other)
     NicEntryDebug* otherNic = (NicEntryDebug*) other;
 
     // search the connection in the outConns list
-    GateList::iterator p = outConns.find(other);
+    GateList::iterator p = findConnection(other);
     // no need to check whether entry is valid; is already check by ConnectionManager isConnected
     // get the hostGate
     // order is phyGate->nicGate->hostGate
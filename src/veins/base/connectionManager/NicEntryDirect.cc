@@ -37,14 +37,15 @@ void NicEntryDirect::connectTo(NicEntry* other)
 
     EV_TRACE << "connecting nic #" << nicId << " and #" << other->nicId << endl;
 
-    cGate* radioGate = nullptr;
-    if ((radioGate = otherPtr->gate("radioIn")) == nullptr) throw cRuntimeError("Nic has no radioIn gate!");
+    // sendDirect() cannot reach modules in other partitions of a parallel simulation
+    if (otherPtr->isPlaceholder()) throw cRuntimeError("Cannot connect nic #%d to nic #%d in another partition", nicId, other->nicId);
 
-    outConns[other] = radioGate->getPathStartGate();
+    // the gate is looked up once per nic, all connections to it share it
+    addConnection(other, other->getRadioInGate());
 }
 
 void NicEntryDirect::disconnectFrom(NicEntry* other)
 {
     EV_TRACE << "disconnecting nic #" << nicId << " and #" << other->nicId << endl;
-    outConns.erase(other);
+    removeConnection(other);
 }
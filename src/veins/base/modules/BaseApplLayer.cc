@@ -45,6 +45,14 @@ void BaseApplLayer::initialize(int stage)
     }
 }
 
+void BaseApplLayer::resetForReuse(int stage)
+{
+    BaseLayer::resetForReuse(stage);
+    if (stage == 0) {
+        headerLength = par("headerLength");
+    }
+}
+
 /**
  * Send message down to lower layer
  **/
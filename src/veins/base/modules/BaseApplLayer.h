@@ -81,6 +81,9 @@ public:
     /** @brief Initialization of the module and some variables*/
     void initialize(int) override;
 
+    /** @brief Resets the layer for reuse by another host, see BaseModule::resetForReuse()*/
+    void resetForReuse(int stage) override;
+
 protected:
     /**
      * @name Handle Messages
@@ -23,3 +23,34 @@
 //
 
 #include "veins/base/modules/BaseBattery.h"
+
+#include <algorithm>
+
+#include "veins/base/modules/BatteryAccess.h"
+
+using veins::BaseBattery;
+using veins::BatteryAccess;
+
+void BaseBattery::registerLazyDevice(BatteryAccess* device)
+{
+    if (std::find(lazyDevices.begin(), lazyDevices.end(), device) != lazyDevices.end()) return;
+    lazyDevices.push_back(device);
+}
+
+void BaseBattery::unregisterLazyDevice(BatteryAccess* device)
+{
+    lazyDevices.erase(std::remove(lazyDevices.begin(), lazyDevices.end(), device), lazyDevices.end());
+}
+
+void BaseBattery::integrateLazyDraws()
+{
+    for (auto device : lazyDevices) {
+        device->flushBatteryDraws();
+    }
+}
+
+void BaseBattery::finish()
+{
+    integrateLazyDraws();
+    BaseModule::finish();
+}
@@ -31,6 +31,8 @@
 
 namespace veins {
 
+class BatteryAccess;
+
 /**
  * @brief Defines the amount of power drawn by a device from
  * a power source.
@@ -159,6 +161,32 @@ public:
     /** @brief Current state of the battery. */
     virtual HostState::States getState() const = 0;
     /*@}*/
+
+    /**
+     * @brief Registers a device that draws from this battery lazily.
+     *
+     * What such a device consumed since its last flush is only drawn from
+     * this battery by integrateLazyDraws() (see BatteryAccess::flushBatteryDraws()).
+     * Registering a device again has no effect.
+     */
+    void registerLazyDevice(BatteryAccess* device);
+
+    /** @brief Stops flushing the draws of a device registered by registerLazyDevice() (if it is) */
+    void unregisterLazyDevice(BatteryAccess* device);
+
+protected:
+    /** @brief Devices drawing lazily from this battery */
+    std::vector<BatteryAccess*> lazyDevices;
+
+    /**
+     * @brief Draws the energy all lazy devices consumed until now.
+     *
+     * Battery implementations should call this before answering state-of-charge
+     * queries. Also called by finish().
+     */
+    void integrateLazyDraws();
+
+    void finish() override;
 };
 
 } // namespace veins
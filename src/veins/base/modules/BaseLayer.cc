@@ -74,6 +74,13 @@ void BaseLayer::initialize(int stage)
  **/
 void BaseLayer::handleMessage(cMessage* msg)
 {
+    if (isSentBeforeParking(msg)) {
+        // meant for the previous vehicle of a recycled host
+        if (!msg->isSelfMessage()) delete msg;
+        return;
+    }
+
+    IntraNicDispatcher::Activation activation(lowerDispatcher);
     if (msg->isSelfMessage()) {
         handleSelfMsg(msg);
     }
@@ -115,6 +122,10 @@ void BaseLayer::handleMessage(cMessage* msg)
 void BaseLayer::sendDown(cMessage* msg)
 {
     recordPacket(PassedMessage::OUTGOING, PassedMessage::LOWER_DATA, msg);
+    if (lowerDispatcher) {
+        lowerDispatcher->postDown(msg, false);
+        return;
+    }
     send(msg, lowerLayerOut);
 }
 
@@ -138,7 +149,9 @@ void BaseLayer::sendControlUp(cMessage* msg)
 void BaseLayer::sendControlDown(cMessage* msg)
 {
     recordPacket(PassedMessage::OUTGOING, PassedMessage::LOWER_CONTROL, msg);
-    if (gate(lowerControlOut)->isPathOK())
+    if (lowerDispatcher)
+        lowerDispatcher->postDown(msg, true);
+    else if (gate(lowerControlOut)->isPathOK())
         send(msg, lowerControlOut);
     else {
         EV << "BaseLayer: lowerControlOut is not connected; dropping message" << std::endl;
@@ -146,6 +159,20 @@ void BaseLayer::sendControlDown(cMessage* msg)
     }
 }
 
+void BaseLayer::receiveFromNic(cMessage* msg, bool control)
+{
+    Enter_Method_Silent();
+    take(msg);
+    if (control) {
+        recordPacket(PassedMessage::INCOMING, PassedMessage::LOWER_CONTROL, msg);
+        handleLowerControl(msg);
+    }
+    else {
+        recordPacket(PassedMessage::INCOMING, PassedMessage::LOWER_DATA, msg);
+        handleLowerMsg(msg);
+    }
+}
+
 void BaseLayer::recordPacket(PassedMessage::direction_t dir, PassedMessage::gates_t gate, const cMessage* msg)
 {
     if (passedMsg == nullptr) return;
@@ -160,6 +187,12 @@ void BaseLayer::finish()
 {
 }
 
+void BaseLayer::resetForReuse(int stage)
+{
+    BatteryAccess::resetForReuse(stage);
+    // gate ids and the statistics record of initialize() stay valid
+}
+
 BaseLayer::~BaseLayer()
 {
     if (passedMsg != nullptr) {
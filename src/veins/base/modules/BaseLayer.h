@@ -31,6 +31,7 @@
 
 #include "veins/base/modules/BatteryAccess.h"
 #include "veins/base/utils/PassedMessage.h"
+#include "veins/base/utils/IntraNicDispatcher.h"
 
 namespace veins {
 
@@ -45,7 +46,7 @@ using veins::BatteryAccess;
  * @ingroup baseModules
  * @author Andreas Koepke
  */
-class VEINS_API BaseLayer : public BatteryAccess {
+class VEINS_API BaseLayer : public BatteryAccess, public IntraNicDispatcher::Receiver {
 public:
     /** @brief SignalID for packets. */
     const static simsignal_t catPacketSignal;
@@ -71,6 +72,9 @@ protected:
      * in statistic recording mode.*/
     PassedMessage* passedMsg;
 
+    /** @brief Passes messages to and from the lower layer by direct calls instead of via gates, if not nullptr (see IntraNicDispatcher). */
+    IntraNicDispatcher* lowerDispatcher = nullptr;
+
 public:
     BaseLayer()
         : BatteryAccess()
@@ -94,6 +98,12 @@ public:
     /** @brief Called when the simulation has finished.*/
     void finish() override;
 
+    /** @brief Resets the layer for reuse by another host, see BaseModule::resetForReuse()*/
+    void resetForReuse(int stage) override;
+
+    /** @brief Called with a message passed by lowerDispatcher, handled as if it had arrived at lowerLayerIn (or lowerControlIn)*/
+    void receiveFromNic(cMessage* msg, bool control) override;
+
 protected:
     /**
      * @name Handle Messages
@@ -58,6 +58,11 @@ void BaseMacLayer::initialize(int stage)
 
         headerLength = par("headerLength");
     }
+    else if (stage == 1) {
+        // the phy decides whether to bypass the gates in between, see IntraNicDispatcher
+        lowerDispatcher = phy->getIntraNicDispatcher();
+        if (lowerDispatcher) lowerDispatcher->setUpper(this);
+    }
     if (myMacAddr == LAddress::L2NULL()) {
         // see if there is an addressing module available
         // otherwise use NIC modules id as MAC address
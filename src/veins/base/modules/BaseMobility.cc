@@ -55,8 +55,10 @@ BaseMobility::BaseMobility()
     , origDisplayWidth(0)
     , origDisplayHeight(0)
     , origIconSize(0)
+    , displayPosition(true)
     , hasStartPosition(false)
     , startPosition(0, 0, 0)
+    , stateHandle(MobilityStateStore::invalidHandle)
 {
 }
 
@@ -68,11 +70,18 @@ BaseMobility::BaseMobility(unsigned stacksize)
     , origDisplayWidth(0)
     , origDisplayHeight(0)
     , origIconSize(0)
+    , displayPosition(true)
     , hasStartPosition(false)
     , startPosition(0, 0, 0)
+    , stateHandle(MobilityStateStore::invalidHandle)
 {
 }
 
+BaseMobility::~BaseMobility()
+{
+    if (stateStore) stateStore->release(stateHandle);
+}
+
 void BaseMobility::initialize(int stage)
 {
     BaseModule::initialize(stage);
@@ -80,13 +89,23 @@ void BaseMobility::initialize(int stage)
         EV_TRACE << "initializing BaseMobility stage " << stage << endl;
 
         hasPar("scaleNodeByDepth") ? scaleNodeByDepth = par("scaleNodeByDepth").boolValue() : scaleNodeByDepth = true;
+        setStaticNode(hasPar("isStatic") ? par("isStatic").boolValue() : false);
 
         // get utility pointers (world and host)
         world = FindModule<BaseWorldUtility*>::findGlobalModule();
         if (world == nullptr) throw cRuntimeError("Could not find BaseWorldUtility module");
 
+        // a recycled host keeps its slot
+        if (!stateStore) {
+            stateStore = world->getMobilityStateStore();
+            stateHandle = stateStore->acquire(findHost()->getId());
+        }
+
         EV_TRACE << "initializing BaseUtility stage " << stage << endl; // for node position
 
+        analyticUpdateDistance = hasPar("analyticUpdateDistance") ? par("analyticUpdateDistance").doubleValue() : 0;
+        if (analyticUpdateDistance < 0) throw cRuntimeError("analyticUpdateDistance must not be negative");
+
         if (hasPar("updateInterval")) {
             updateInterval = par("updateInterval");
         }
@@ -178,7 +197,12 @@ void BaseMobility::initialize(int stage)
         // print new host position on the screen and update bb info
         updatePosition();
 
-        if (move.getSpeed() > 0 && updateInterval > 0) {
+        if (move.getSpeed() > 0 && analyticUpdateDistance > 0) {
+            EV_TRACE << "Host is moving, speed=" << move.getSpeed() << " analyticUpdateDistance=" << analyticUpdateDistance << endl;
+            moveMsg = new cMessage("move", MOVE_HOST);
+            scheduleAt(predictAnalyticUpdateTime(), moveMsg);
+        }
+        else if (move.getSpeed() > 0 && updateInterval > 0) {
             EV_TRACE << "Host is moving, speed=" << move.getSpeed() << " updateInterval=" << updateInterval << endl;
             moveMsg = new cMessage("move", MOVE_HOST);
             // host moves the first time after some random delay to avoid synchronized movements
@@ -232,6 +256,8 @@ const char* BaseMobility::iconSizeToTag(double size)
 void BaseMobility::handleMessage(cMessage* msg)
 {
     if (!msg->isSelfMessage()) throw cRuntimeError("mobility modules can only receive self messages");
+    // scheduled for the previous vehicle of a recycled host
+    if (isSentBeforeParking(msg)) return;
 
     if (msg->getKind() == MOVE_TO_BORDER) {
         handleBorderMsg(msg);
@@ -247,7 +273,7 @@ void BaseMobility::handleSelfMsg(cMessage* msg)
     updatePosition();
 
     if (!moveMsg->isScheduled() && move.getSpeed() > 0) {
-        scheduleAt(simTime() + updateInterval, msg);
+        scheduleAt(analyticUpdateDistance > 0 ? predictAnalyticUpdateTime() : simTime() + updateInterval, msg);
     }
     else {
         delete msg;
@@ -255,12 +281,27 @@ void BaseMobility::handleSelfMsg(cMessage* msg)
     }
 }
 
+simtime_t BaseMobility::predictAnalyticUpdateTime() const
+{
+    const double distance = analyticUpdateDistance * (1 + 1e-9);
+
+    // always make progress, even if rounded to the current time
+    simtime_t when = move.getStartTime() + move.getTravelTime(distance);
+    if (when <= simTime()) when = simTime() + SimTime().setRaw(1);
+    return when;
+}
+
 void BaseMobility::handleBorderMsg(cMessage* msg)
 {
     EV_TRACE << "start MOVE_TO_BORDER:" << move.info() << endl;
 
     BorderMsg* bMsg = static_cast<BorderMsg*>(msg);
 
+    if (analyticUpdateDistance > 0) {
+        // the host kept accelerating on its way to the border
+        move.setSpeed(move.getSpeedAt(simTime()));
+    }
+
     switch (bMsg->getPolicy()) {
     case REFLECT:
         move.setStart(bMsg->getStartPos());
@@ -298,10 +339,19 @@ void BaseMobility::updatePosition()
 {
     EV_DEBUG << "updatePosition: " << move.info() << endl;
 
-    // publish the the new move
-    emit(mobilityStateChangedSignal, this);
+    stateStore->set(stateHandle, move.getStartPos(), Heading::fromCoord(move.getDirection()), move.getSpeed(), move.getStartTime());
+
+    // publish the the new move (static nodes only if it changes anything)
+    if (!staticNode || !hasPublishedState || move.getStartPos() != publishedPosition || move.getOrientation() != publishedOrientation) {
+        if (staticNode) {
+            hasPublishedState = true;
+            publishedPosition = move.getStartPos();
+            publishedOrientation = move.getOrientation();
+        }
+        emit(mobilityStateChangedSignal, this);
+    }
 
-    if (hasGUI()) {
+    if (hasGUI() && displayPosition) {
         std::ostringstream osDisplayTag;
 #ifdef __APPLE__
         const int iPrecis = 0;
@@ -680,7 +730,13 @@ bool BaseMobility::handleIfOutside(BorderPolicy policy, Coord& stepTarget, Coord
     goToBorder(policy, wo, borderStep, borderStart);
 
     // calculate the time to reach the border
-    borderInterval = (borderStep.length()) / move.getSpeed();
+    if (analyticUpdateDistance > 0) {
+        // move starts now and may be accelerating, see makeMove()
+        borderInterval = move.getStartTime() + move.getTravelTime(borderStep.length()) - simTime();
+    }
+    else {
+        borderInterval = (borderStep.length()) / move.getSpeed();
+    }
 
     // calculate new start position
     // NOTE: for WRAP this is done in goToBorder
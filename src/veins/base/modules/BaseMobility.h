@@ -31,6 +31,7 @@
 #include "veins/base/modules/BatteryAccess.h"
 #include "veins/base/utils/Coord.h"
 #include "veins/base/utils/Move.h"
+#include "veins/base/utils/MobilityStateStore.h"
 #include "veins/base/modules/BaseWorldUtility.h"
 
 namespace veins {
@@ -121,6 +122,14 @@ protected:
     /** @brief Self message to trigger movement */
     cMessage* moveMsg;
 
+    /**
+     * @brief If positive, the host is only moved (and its position signalled) after it moved this far, instead of every updateInterval.
+     *
+     * Only supported by mobility models whose makeMove() continues the trajectory described by move
+     * (e.g., LinearMobility), so that getPositionAt() is exact in between. See predictAnalyticUpdateTime().
+     */
+    double analyticUpdateDistance = 0;
+
     /** @brief Enable depth dependent scaling of nodes when 3d and tkenv is
      * used. */
     bool scaleNodeByDepth;
@@ -138,12 +147,30 @@ protected:
     /** @brief The original size of the icon of the node.*/
     double origIconSize;
 
+    /** @brief Whether updatePosition() moves the host's icon (i.e., changes its display string) in GUI runs.*/
+    bool displayPosition;
+
     bool hasStartPosition;
     Coord startPosition;
 
+    /** @brief Store the state of this host is written to by updatePosition() (kept alive while this module exists) */
+    std::shared_ptr<MobilityStateStore> stateStore;
+
+    /** @brief Slot of this host in stateStore */
+    MobilityStateStore::Handle stateHandle;
+
+    /** @brief Whether this host stays where it is, see isStaticNode() */
+    bool staticNode = false;
+
+    /** @brief Whether mobilityStateChangedSignal was emitted for publishedPosition and publishedOrientation (only tracked while staticNode is set) */
+    bool hasPublishedState = false;
+    Coord publishedPosition;
+    Coord publishedOrientation;
+
 public:
     BaseMobility();
     BaseMobility(unsigned stacksize);
+    ~BaseMobility() override;
 
     /** @brief This modules should only receive self-messages
      *
@@ -188,11 +215,53 @@ public:
         return move.getDirection() * move.getSpeed();
     }
 
+    /** @brief Returns the current acceleration (along the direction of movement). */
+    virtual Coord getCurrentAcceleration() const
+    {
+        return move.getDirection() * move.getAcceleration();
+    }
+
     virtual Coord getCurrentDirection() const
     {
         return move.getDirection();
     }
 
+    /** @brief Returns the slot of this host in the store returned by getStateStore(), see MobilityStateStore */
+    MobilityStateStore::Handle getStateHandle() const
+    {
+        return stateHandle;
+    }
+
+    /** @brief Returns the store this host's state is kept in, as of its last updatePosition() */
+    const MobilityStateStore* getStateStore() const
+    {
+        return stateStore.get();
+    }
+
+    /**
+     * @brief Returns whether this host stays where it is (e.g., an RSU or a parked vehicle).
+     *
+     * Position updates of static hosts that do not change position or orientation are not signalled
+     * (see mobilityStateChangedSignal), so their nics are not re-checked by the connection manager.
+     */
+    bool isStaticNode() const
+    {
+        return staticNode;
+    }
+
+    /** @brief Marks this host as static (or moving again), see isStaticNode() */
+    void setStaticNode(bool isStatic)
+    {
+        staticNode = isStatic;
+        hasPublishedState = false;
+    }
+
+    /** @brief Stops (or resumes) moving the host's icon in GUI runs, e.g., if hosts are drawn by someone else */
+    void setDisplayPosition(bool display)
+    {
+        displayPosition = display;
+    }
+
     /** @brief Overrides start position if called before initialize() */
     virtual void setStartPosition(Coord pos)
     {
@@ -265,6 +334,14 @@ protected:
      */
     virtual void updatePosition();
 
+    /**
+     * @brief Returns when the host, following move, will be analyticUpdateDistance away from move's start position (or comes to a halt).
+     *
+     * The distance is overshot by a tiny fraction, so that rounding does not keep a connection manager
+     * whose connectionUpdateSlack equals analyticUpdateDistance from re-checking connections.
+     */
+    simtime_t predictAnalyticUpdateTime() const;
+
     /** @brief Returns the width of the playground */
     double playgroundSizeX() const
     {
@@ -76,6 +76,12 @@ protected:
     /** @brief Stores the category of the HostState*/
     const static simsignal_t catHostStateSignal;
 
+    /** @brief Time the host of this module was last parked for reuse (or -1), see isSentBeforeParking()*/
+    simtime_t parkedAt = -1;
+
+    /** @brief Stores if the host of this module is parked for reuse, i.e., finished and not yet reset by resetForReuse()*/
+    bool parkedForReuse = false;
+
 protected:
     /**
      * @brief Called whenever the hosts state changes.
@@ -137,6 +143,59 @@ public:
         return 2;
     }
 
+    /**
+     * @brief Whether this module can be reset for reuse by another host
+     *
+     * Modules that implement resetForReuse() return true here. A host is
+     * only recycled (see TraCIScenarioManager::maxRecycledModules) if all
+     * of its simple modules do. Subclasses of reusable modules that add
+     * state of their own must extend resetForReuse() or return false.
+     */
+    virtual bool isReusable() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Resets a finished module so its host can be bound to another vehicle
+     *
+     * Called in place of initialize(stage), for every init stage, when a
+     * recycled host is taken into use again. Parameters and gates are kept,
+     * and so is everything set up in initialize() that outlives finish(),
+     * like signal subscriptions. Self messages scheduled before the host
+     * was parked are ignored when they arrive (see isSentBeforeParking()),
+     * so they may still be scheduled, or already be back with their owner.
+     * Overrides must call the base class.
+     */
+    virtual void resetForReuse(int stage)
+    {
+        if (stage == 0) parkedForReuse = false;
+    }
+
+    /**
+     * @brief Marks the (finished) host of this module as parked for reuse
+     *
+     * Messages sent to the module until now are ignored from now on, see
+     * isSentBeforeParking(). The host must not be reset (see resetForReuse())
+     * before simulation time has advanced.
+     */
+    void parkForReuse()
+    {
+        parkedAt = simTime();
+        parkedForReuse = true;
+    }
+
+    /**
+     * @brief Returns whether msg was sent (or scheduled) before the host of this module was last parked for reuse
+     *
+     * Such messages belong to the previous vehicle of the host: non-self
+     * messages are to be deleted, self messages left to their owner.
+     */
+    bool isSentBeforeParking(const cMessage* msg) const
+    {
+        return parkedAt >= SIMTIME_ZERO && msg->getSendingTime() <= parkedAt;
+    }
+
     /**
      * @brief Function to get the logging name of the host
      *
@@ -27,20 +27,47 @@
 #include "veins/base/modules/BaseWorldUtility.h"
 #include "veins/base/utils/FindModule.h"
 #include "veins/base/connectionManager/BaseConnectionManager.h"
+#include "veins/base/phyLayer/PhyConfigCache.h"
+#include "veins/base/utils/Profiling.h"
+#include "veins/base/utils/MemoryAccounting.h"
 
 using namespace veins;
 
 Define_Module(veins::BaseWorldUtility);
 
+const simsignal_t BaseWorldUtility::traciTimestepBeginSignal = registerSignal("org_car2x_veins_modules_mobility_traciTimestepBegin");
+
 BaseWorldUtility::BaseWorldUtility()
     : isInitialized(false)
+    , phyConfigCache(std::make_shared<PhyConfigCache>())
+{
+}
+
+BaseWorldUtility::~BaseWorldUtility()
 {
+    if (recordMemoryUsage) getEnvir()->removeLifecycleListener(this);
+    cancelAndDelete(memoryReportTimer);
 }
 
 void BaseWorldUtility::initialize(int stage)
 {
     if (stage == 0) {
         initializeIfNecessary();
+
+        // count the time steps of any TraCI scenario manager (signals propagate up to the network)
+        getSimulation()->getSystemModule()->subscribe(traciTimestepBeginSignal, this);
+
+        recordMemoryUsage = hasPar("recordMemoryUsage") ? par("recordMemoryUsage").boolValue() : false;
+        memoryReportInterval = hasPar("memoryReportInterval") ? par("memoryReportInterval").doubleValue() : 0;
+        if (memoryReportInterval < 0) throw cRuntimeError("memoryReportInterval must not be negative");
+        if (recordMemoryUsage) {
+            // see lifecycleEvent()
+            getEnvir()->addLifecycleListener(this);
+        }
+        if (recordMemoryUsage && memoryReportInterval > 0) {
+            memoryReportTimer = new cMessage("memoryReport");
+            scheduleAt(simTime() + memoryReportInterval, memoryReportTimer);
+        }
     }
     else if (stage == 1) {
         // check if necessary modules are there
@@ -51,6 +78,57 @@ void BaseWorldUtility::initialize(int stage)
     }
 }
 
+void BaseWorldUtility::handleMessage(cMessage* msg)
+{
+    if (msg == memoryReportTimer) {
+        reportMemoryUsage();
+        scheduleAt(simTime() + memoryReportInterval, memoryReportTimer);
+        return;
+    }
+    throw cRuntimeError("BaseWorldUtility does not handle messages other than its own timers");
+}
+
+void BaseWorldUtility::reportMemoryUsage()
+{
+    size_t totalBytes = 0;
+    for (const auto& usage : MemoryAccounting::collect()) {
+        auto& vector = memoryVectors[usage.first];
+        if (!vector) vector.reset(new cOutVector(("memory." + usage.first + ".bytes").c_str()));
+        vector->record(usage.second.bytes);
+        totalBytes += usage.second.bytes;
+        EV_DEBUG << "memory used by " << usage.first << ": " << usage.second.bytes << " bytes in " << usage.second.objects << " objects" << endl;
+    }
+    EV_INFO << "memory used by all accounted subsystems: " << totalBytes << " bytes" << endl;
+}
+
+void BaseWorldUtility::recordMemoryScalars()
+{
+    for (const auto& usage : MemoryAccounting::collect()) {
+        recordScalar(("memory." + usage.first + ".bytes").c_str(), usage.second.bytes);
+        recordScalar(("memory." + usage.first + ".objects").c_str(), usage.second.objects);
+    }
+}
+
+void BaseWorldUtility::finish()
+{
+    ProfileCounter::recordScalars(this);
+    getSimulation()->getSystemModule()->unsubscribe(traciTimestepBeginSignal, this);
+}
+
+void BaseWorldUtility::lifecycleEvent(SimulationLifecycleEventType eventType, cObject* details)
+{
+    if (eventType == LF_PRE_NETWORK_FINISH) {
+        recordMemoryScalars();
+    }
+}
+
+void BaseWorldUtility::receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details)
+{
+    if (signalID == traciTimestepBeginSignal) {
+        timestepEpoch++;
+    }
+}
+
 void BaseWorldUtility::initializeIfNecessary()
 {
     if (isInitialized) return;
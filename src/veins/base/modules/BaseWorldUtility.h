@@ -26,18 +26,26 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string>
+
 #include "veins/veins.h"
 
 #include "veins/base/utils/Coord.h"
+#include "veins/base/utils/MobilityStateStore.h"
+#include "veins/base/utils/ModuleRegistry.h"
 
 namespace veins {
 
+class PhyConfigCache;
+
 /**
  * @brief Provides information and utility methods for the whole simulation.
  *
  * @ingroup baseModules
  */
-class VEINS_API BaseWorldUtility : public cSimpleModule {
+class VEINS_API BaseWorldUtility : public cSimpleModule, public cListener, public cISimulationLifecycleListener {
 protected:
     /**
      * @brief Size of the area the nodes are in (in meters)
@@ -60,6 +68,36 @@ protected:
     /** @brief Stores if members are already initialized. */
     bool isInitialized;
 
+    /** @brief Mobility state of all hosts, shared with (and kept alive by) their mobility modules. */
+    std::shared_ptr<MobilityStateStore> mobilityStateStore = std::make_shared<MobilityStateStore>();
+
+    /** @brief Parsed phy configuration and shared analogue models, shared with (and kept alive by) all phys. */
+    std::shared_ptr<PhyConfigCache> phyConfigCache;
+
+    /** @brief Number of TraCI time steps begun so far. */
+    uint64_t timestepEpoch = 0;
+
+    /** @brief The signal emitted by TraCI scenario managers at the begin of each time step (see TraCIScenarioManager::traciTimestepBeginSignal). */
+    static const simsignal_t traciTimestepBeginSignal;
+
+    /** @brief Stores if the memory usage of all subsystems (see MemoryAccounting) is recorded. */
+    bool recordMemoryUsage = false;
+
+    /** @brief Interval of memory usage reports during the simulation (0: only at its end). */
+    simtime_t memoryReportInterval;
+
+    /** @brief Timer for the next memory usage report. */
+    cMessage* memoryReportTimer = nullptr;
+
+    /** @brief Bytes held per subsystem over time, created by the first report including it. */
+    std::map<std::string, std::unique_ptr<cOutVector>> memoryVectors;
+
+    /** @brief Records (and logs) the current memory usage of all subsystems to memoryVectors. */
+    void reportMemoryUsage();
+
+    /** @brief Records the current memory usage of all subsystems as scalars of this module. */
+    void recordMemoryScalars();
+
 public:
     /** @brief Speed of light in meters per second. */
     static const double speedOfLight()
@@ -78,9 +116,25 @@ protected:
 
 public:
     BaseWorldUtility();
+    ~BaseWorldUtility() override;
 
     void initialize(int stage) override;
 
+    void handleMessage(cMessage* msg) override;
+
+    /** @brief Records the counters of all profiled scopes (see VEINS_PROFILE_SCOPE) as scalars of this module */
+    void finish() override;
+
+    /**
+     * @brief Records the memory usage of all subsystems (if enabled) before any module finishes.
+     *
+     * Modules like ObstacleControl and AnnotationManager release their data in their finish(), which may run before this module's.
+     */
+    void lifecycleEvent(SimulationLifecycleEventType eventType, cObject* details) override;
+
+    using cListener::receiveSignal;
+    void receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details) override;
+
     /**
      * @brief Returns the playgroundSize
      *
@@ -111,6 +165,28 @@ public:
         return use2DFlag;
     }
 
+    /** @brief Returns the store holding the mobility state of all hosts, as updated by their BaseMobility modules */
+    std::shared_ptr<MobilityStateStore> getMobilityStateStore()
+    {
+        return mobilityStateStore;
+    }
+
+    /** @brief Returns the cache of phy configuration common to all hosts */
+    std::shared_ptr<PhyConfigCache> getPhyConfigCache()
+    {
+        return phyConfigCache;
+    }
+
+    /**
+     * @brief Returns the number of TraCI time steps begun so far.
+     *
+     * Nodes moved by TraCI keep their positions (unless they are set to extrapolate them) as long as this number is unchanged.
+     */
+    uint64_t getTimestepEpoch() const
+    {
+        return timestepEpoch;
+    }
+
     /** @brief Returns an Id for an AirFrame, at the moment simply an incremented long-value */
     long getUniqueAirFrameId()
     {
@@ -124,6 +200,9 @@ public:
 
         return airFrameId++;
     }
+
+private:
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
 };
 
 } // namespace veins
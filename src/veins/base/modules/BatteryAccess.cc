@@ -31,6 +31,8 @@
 
 #include "veins/base/modules/BatteryAccess.h"
 
+#include <algorithm>
+
 #include "veins/base/utils/FindModule.h"
 
 using veins::BatteryAccess;
@@ -49,6 +51,12 @@ BatteryAccess::BatteryAccess(unsigned stacksize)
 
 void BatteryAccess::registerWithBattery(const std::string& name, int numAccounts)
 {
+    if (battery && lazyBatteryDraw) {
+        // registering again (e.g., after resetForReuse()): settle with the battery registered with so far
+        flushBatteryDraws();
+        battery->unregisterLazyDevice(this);
+    }
+
     battery = FindModule<BaseBattery*>::findSubModule(findHost());
 
     if (!battery) {
@@ -57,12 +65,26 @@ void BatteryAccess::registerWithBattery(const std::string& name, int numAccounts
     else {
         deviceID = battery->registerDevice(name, numAccounts);
     }
+
+    lazyBatteryDraw = hasPar("lazyBatteryDraw") ? par("lazyBatteryDraw").boolValue() : false;
+    batteryFlushInterval = hasPar("batteryFlushInterval") ? par("batteryFlushInterval").doubleValue() : 0;
+    if (lazyBatteryDraw) {
+        pendingDraws.assign(numAccounts, PendingDraw());
+        lastDrawChange = simTime();
+        lastBatteryFlush = simTime();
+        battery->registerLazyDevice(this);
+    }
 }
 
 void BatteryAccess::draw(DrawAmount& amount, int account)
 {
     if (!battery) return;
 
+    if (lazyBatteryDraw) {
+        drawLazily(amount, account);
+        return;
+    }
+
     battery->draw(deviceID, amount, account);
 }
 
@@ -71,7 +93,7 @@ void BatteryAccess::drawCurrent(double amount, int account)
     if (!battery) return;
 
     DrawAmount val(DrawAmount::CURRENT, amount);
-    battery->draw(deviceID, val, account);
+    draw(val, account);
 }
 
 void BatteryAccess::drawEnergy(double amount, int account)
@@ -79,5 +101,60 @@ void BatteryAccess::drawEnergy(double amount, int account)
     if (!battery) return;
 
     DrawAmount val(DrawAmount::ENERGY, amount);
-    battery->draw(deviceID, val, account);
+    draw(val, account);
+}
+
+void BatteryAccess::drawLazily(DrawAmount& amount, int account)
+{
+    ASSERT(account >= 0 && static_cast<size_t>(account) < pendingDraws.size());
+
+    const simtime_t now = simTime();
+    if (amount.getType() == DrawAmount::ENERGY) {
+        pendingDraws[account].energy += amount.getValue();
+    }
+    else {
+        pendingDraws[drawnCurrentAccount].charge += drawnCurrent * (now - lastDrawChange).dbl();
+        drawnCurrent = amount.getValue();
+        drawnCurrentAccount = account;
+        lastDrawChange = now;
+    }
+
+    if (batteryFlushInterval > 0 && now - lastBatteryFlush >= batteryFlushInterval) {
+        flushBatteryDraws();
+    }
+}
+
+void BatteryAccess::flushBatteryDraws()
+{
+    if (!battery || !lazyBatteryDraw) return;
+
+    const simtime_t now = simTime();
+    pendingDraws[drawnCurrentAccount].charge += drawnCurrent * (now - lastDrawChange).dbl();
+    lastDrawChange = now;
+    lastBatteryFlush = now;
+
+    // mAs times V gives mWs
+    const double voltage = battery->getVoltage();
+    for (size_t account = 0; account < pendingDraws.size(); account++) {
+        PendingDraw& pending = pendingDraws[account];
+        const double energy = pending.energy + pending.charge * voltage;
+        pending = PendingDraw();
+        if (energy == 0) continue;
+
+        DrawAmount val(DrawAmount::ENERGY, energy);
+        battery->draw(deviceID, val, account);
+    }
+}
+
+void BatteryAccess::resetForReuse(int stage)
+{
+    BaseModule::resetForReuse(stage);
+    if (stage == 0) {
+        // consumption of the previous host was drawn when the battery finished
+        std::fill(pendingDraws.begin(), pendingDraws.end(), PendingDraw());
+        drawnCurrent = 0;
+        drawnCurrentAccount = 0;
+        lastDrawChange = simTime();
+        lastBatteryFlush = simTime();
+    }
 }
@@ -54,6 +54,31 @@ protected:
     /** @brief This devices id for the battery module. */
     int deviceID;
 
+    /**
+     * @brief Whether draws are accounted for locally and only drawn from the battery by flushBatteryDraws().
+     *
+     * Set by the optional parameter lazyBatteryDraw when registering with the battery.
+     */
+    bool lazyBatteryDraw = false;
+
+    /** @brief If positive, the next draw after this much time since the last flush flushes (optional parameter batteryFlushInterval) */
+    simtime_t batteryFlushInterval;
+
+    /** @brief Consumption of one account of this device not yet drawn from the battery (for lazy draws) */
+    struct PendingDraw {
+        double charge = 0; ///< integrated current (mAs)
+        double energy = 0; ///< fixed energy draws (mWs)
+    };
+    std::vector<PendingDraw> pendingDraws;
+
+    /** @brief The current (mA) this device draws since lastDrawChange, and the account it is drawn for (for lazy draws) */
+    double drawnCurrent = 0;
+    int drawnCurrentAccount = 0;
+    simtime_t lastDrawChange;
+
+    /** @brief When flushBatteryDraws() was last called */
+    simtime_t lastBatteryFlush;
+
 protected:
     /**
      * @brief Registers this module as a device with the battery module.
@@ -86,9 +111,25 @@ protected:
      */
     void drawEnergy(double amount, int account);
 
+    /**
+     * @brief Records a draw in lazy mode: integrates the current drawn so far and remembers the new one.
+     */
+    void drawLazily(DrawAmount& amount, int account);
+
 public:
     BatteryAccess();
     BatteryAccess(unsigned stacksize);
+
+    /** @brief Forgets lazily accounted draws but stays registered with the battery (recycled along with the host), see BaseModule::resetForReuse() */
+    void resetForReuse(int stage) override;
+
+    /**
+     * @brief Draws everything consumed since the last flush from the battery (a no-op if not drawing lazily).
+     *
+     * Current drawn is integrated up to now and drawn as energy, one draw per account.
+     * Called by the battery whenever it needs an up-to-date state of charge, and at its finish().
+     */
+    void flushBatteryDraws();
 };
 
 } // namespace veins
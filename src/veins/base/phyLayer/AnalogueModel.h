@@ -31,12 +31,42 @@
 
 #include "veins/base/utils/AntennaPosition.h"
 #include "veins/base/utils/Coord.h"
+#include "veins/base/utils/LinkGeometry.h"
 #include "veins/modules/utility/HasLogProxy.h"
 
 namespace veins {
 
 class AirFrame;
+class AnalogueModel;
 class Signal;
+class Spectrum;
+
+/**
+ * @brief Attenuation of an analogue model, as a plain function for use in a CompiledChannelModel.
+ *
+ * A kernel computes the attenuation of a link without touching the signal; at most one of its functions is set.
+ * A kernel with neither function set means the model only supports AnalogueModel::filterSignal.
+ *
+ * @ingroup analogueModels
+ */
+struct VEINS_API AnalogueModelKernel {
+    /**
+     * Returns the attenuation of a link that is the same for all frequencies.
+     * signalMax is the maximum power level of the signal (in mW) before any model of the chain was applied.
+     */
+    double (*factor)(AnalogueModel& model, const LinkGeometry& link, double signalMax) = nullptr;
+
+    /**
+     * Multiplies the values in attenuation (one per frequency of spectrum) by the attenuation of a link at that frequency,
+     * for the frequencies in [from, to) (the filter window of the signal, see Signal::getFilterStart()).
+     */
+    void (*multiply)(AnalogueModel& model, const LinkGeometry& link, const Spectrum& spectrum, size_t from, size_t to, double* attenuation) = nullptr;
+
+    bool isEmpty() const
+    {
+        return !factor && !multiply;
+    }
+};
 
 /**
  * @brief Interface for the analogue models of the physical layer.
@@ -77,8 +107,79 @@ public:
     {
         return false;
     }
+
+    /**
+     * Returns the (relative) computational cost of filterSignal.
+     *
+     * Models used for thresholding are applied cheapest first, so expensive models
+     * need not be evaluated for signals that cheaper models already pushed below a threshold.
+     */
+    virtual double getEvaluationCost() const
+    {
+        return 1;
+    }
+
+    /**
+     * Returns the kernel of this model for evaluation as part of a CompiledChannelModel.
+     *
+     * The kernel must attenuate signals just like filterSignal does (up to rounding).
+     * The default (an empty kernel) means the model is always evaluated on its own, by filterSignal.
+     */
+    virtual AnalogueModelKernel getKernel()
+    {
+        return {};
+    }
+
+    /**
+     * Returns whether filterSignal may be called concurrently (for different signals) from worker threads.
+     *
+     * This requires filterSignal to leave the model and the simulation untouched (no caches, random numbers, messages, or signals);
+     * logging is only allowed through VEINS_LOG (not EV), which skips statements on worker threads.
+     */
+    virtual bool isThreadSafe() const
+    {
+        return false;
+    }
+
+    /**
+     * Called on the simulation thread before filterSignal is called concurrently from worker threads (if isThreadSafe()),
+     * e.g., to bring the shared state it reads up to date.
+     */
+    virtual void prepareConcurrentFiltering()
+    {
+    }
+
+    /**
+     * Returns whether one instance of this model may serve the phys of all hosts configured alike.
+     *
+     * This requires filterSignal to depend on nothing but the signal and the (global) configuration of the model: no per-host state, no random numbers drawn from the owner.
+     * Shared models are owned by the world utility module, see setOwner().
+     */
+    virtual bool isShareable() const
+    {
+        return false;
+    }
+
+    /**
+     * Returns whether filterSignal multiplies each power level of a signal by a factor that only depends on the frequency and the positions of the nodes.
+     *
+     * This requires the attenuation to be independent of the signal's power and timing, and to use no random numbers.
+     * It may then be evaluated once per link and reused for all signals sent while no node moves (see cacheLinkBudgets of BasePhyLayer).
+     */
+    virtual bool isDeterministic() const
+    {
+        return false;
+    }
+
+    /**
+     * Makes another component the owner of this model (and of its log output), e.g. one that outlives the host which created it.
+     */
+    void setOwner(cComponent* newOwner)
+    {
+        owner = newOwner;
+    }
 };
 
-using AnalogueModelList = std::vector<std::unique_ptr<AnalogueModel>>;
+using AnalogueModelList = std::vector<std::shared_ptr<AnalogueModel>>;
 
 } // namespace veins
@@ -29,3 +29,15 @@ double Antenna::getGain(Coord ownPos, Coord ownOrient, Coord otherPos)
     // as this base class represents an isotropic antenna, simply return 1.0
     return 1.0;
 }
+
+double Antenna::getGain(const LinkGeometry& link, const Coord& ownOrient, bool atSender)
+{
+    return atSender ? getGain(link.senderPos, ownOrient, link.receiverPos) : getGain(link.receiverPos, ownOrient, link.senderPos);
+}
+
+void Antenna::getGains(const Coord& ownPos, const Coord& ownOrient, const Coord* otherPositions, size_t count, double* gains)
+{
+    for (size_t i = 0; i < count; i++) {
+        gains[i] = getGain(ownPos, ownOrient, otherPositions[i]);
+    }
+}
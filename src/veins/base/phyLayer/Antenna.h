@@ -23,6 +23,7 @@
 #pragma once
 
 #include "veins/base/utils/Coord.h"
+#include "veins/base/utils/LinkGeometry.h"
 
 namespace veins {
 
@@ -62,6 +63,47 @@ public:
      */
     virtual double getGain(Coord ownPos, Coord ownOrient, Coord otherPos);
 
+    /**
+     * Calculates the antenna gain of the represented antenna towards the other end of a link.
+     *
+     * The default implementation calls getGain() with the positions of the link.
+     *
+     * @param link      - the geometry of the link
+     * @param ownOrient - the direction the antenna/the host is pointing in
+     * @param atSender  - whether this antenna is the link's sender (otherwise, it is its receiver)
+     *
+     * @return Returns the gain in this specific direction.
+     */
+    virtual double getGain(const LinkGeometry& link, const Coord& ownOrient, bool atSender);
+
+    /**
+     * Calculates the antenna gains towards many other antennas at once.
+     *
+     * The default implementation calls getGain() for each of them.
+     *
+     * @param ownPos         - states the position of this antenna
+     * @param ownOrient      - the direction the antenna/the host is pointing in
+     * @param otherPositions - the positions of the other antennas
+     * @param count          - number of entries of otherPositions
+     * @param gains          - receives the gain towards each of otherPositions
+     */
+    virtual void getGains(const Coord& ownPos, const Coord& ownOrient, const Coord* otherPositions, size_t count, double* gains);
+
+    /**
+     * Returns an upper bound of the antenna gain towards (or from) the direction los.
+     *
+     * Unlike getGain(), the bound also holds for directions a few degrees off los, so it stays valid
+     * while nodes move or turn a little. Used to cull receivers outside the radiation pattern.
+     * In the case of this class, a value of 1.0 is returned always.
+     *
+     * @param ownOrient - the direction the antenna/the host is pointing in
+     * @param los       - the line of sight from this antenna to the other one
+     */
+    virtual double getGainBound(const Coord& ownOrient, const Coord& los)
+    {
+        return 1.0;
+    }
+
     virtual double getLastAngle()
     {
         return -1.0;
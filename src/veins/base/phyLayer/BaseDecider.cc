@@ -84,7 +84,7 @@ simtime_t BaseDecider::processNewSignal(AirFrame* frame)
 
 simtime_t BaseDecider::processSignalEnd(AirFrame* frame)
 {
-    EV_INFO << "packet was received correctly, it is now handed to upper layer...\n";
+    VEINS_LOG_TRACE << "packet was received correctly, it is now handed to upper layer...\n";
     phy->sendUp(frame, new DeciderResult(true));
 
     // we have processed this AirFrame and we prepare to receive the next one
@@ -118,3 +118,8 @@ void BaseDecider::getChannelInfo(simtime_t_cref start, simtime_t_cref end, AirFr
 {
     phy->getChannelInfo(start, end, out);
 }
+
+void BaseDecider::getChannelInfoInBand(simtime_t_cref start, simtime_t_cref end, double freqLow, double freqHigh, AirFrameVector& out)
+{
+    phy->getChannelInfoInBand(start, end, freqLow, freqHigh, out);
+}
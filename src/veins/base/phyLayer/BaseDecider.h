@@ -197,6 +197,14 @@ protected:
      * @param out The output vector in which to put the AirFrames.
      */
     virtual void getChannelInfo(simtime_t_cref start, simtime_t_cref end, AirFrameVector& out);
+
+    /**
+     * @brief Collects the AirFrames on the channel during the passed interval,
+     * possibly leaving out those without power within [freqLow, freqHigh] (in Hz).
+     *
+     * Forwards to DeciderToPhyInterfaces "getChannelInfoInBand" method.
+     */
+    virtual void getChannelInfoInBand(simtime_t_cref start, simtime_t_cref end, double freqLow, double freqHigh, AirFrameVector& out);
 };
 
 } // namespace veins
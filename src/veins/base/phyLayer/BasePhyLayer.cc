@@ -23,7 +23,11 @@
 //
 
 #include "veins/base/phyLayer/BasePhyLayer.h"
+#include "veins/base/utils/Profiling.h"
+#include "veins/base/utils/Logging.h"
 
+#include <algorithm>
+#include <deque>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -89,6 +93,38 @@ void BasePhyLayer::initialize(int stage)
         minPowerLevel = par("minPowerLevel").doubleValue();
         minPowerLevel = FWMath::dBm2mW(minPowerLevel);
 
+        cullUnreachableReceivers = hasPar("cullUnreachableReceivers") ? par("cullUnreachableReceivers").boolValue() : false;
+        receiverCullingGain = pow(10, (hasPar("receiverCullingGain") ? par("receiverCullingGain").doubleValue() : 6) / 10);
+        receiverCullingAlpha = hasPar("receiverCullingAlpha") ? par("receiverCullingAlpha").doubleValue() : 2;
+        directionalCulling = hasPar("directionalCulling") ? par("directionalCulling").boolValue() : false;
+
+        cullIrrelevantAirFrames = hasPar("cullIrrelevantAirFrames") ? par("cullIrrelevantAirFrames").boolValue() : false;
+        if (cullIrrelevantAirFrames && noiseFloorValue <= 0) throw cRuntimeError("cullIrrelevantAirFrames requires a noise floor");
+        irrelevantAirFramePower = noiseFloorValue * pow(10, -(hasPar("irrelevantAirFrameMargin") ? par("irrelevantAirFrameMargin").doubleValue() : 20) / 10);
+
+        autoThresholdAnalogueModels = hasPar("autoThresholdAnalogueModels") ? par("autoThresholdAnalogueModels").boolValue() : false;
+        parallelReceptionFiltering = hasPar("parallelReceptionFiltering") ? par("parallelReceptionFiltering").boolValue() : false;
+        fuseAnalogueModels = hasPar("fuseAnalogueModels") ? par("fuseAnalogueModels").boolValue() : false;
+        batchReceptionFiltering = hasPar("batchReceptionFiltering") ? par("batchReceptionFiltering").boolValue() : false;
+        restrictFilterWindow = hasPar("restrictFilterWindow") ? par("restrictFilterWindow").boolValue() : false;
+        const int guardBins = hasPar("filterGuardBins") ? par("filterGuardBins").intValue() : 1;
+        if (guardBins < 0) throw cRuntimeError("filterGuardBins must not be negative");
+        filterGuardBins = guardBins;
+        partitionChannelInfo = hasPar("partitionChannelInfo") ? par("partitionChannelInfo").boolValue() : false;
+        channelInfo.setPartitionedByBand(partitionChannelInfo);
+        channelInfo.setCompactingInactive(hasPar("compactChannelInfo") ? par("compactChannelInfo").boolValue() : false);
+        memoryRegistration = MemoryAccounting::add("phy.channelInfo", [this]() {
+            MemoryAccounting::Usage usage;
+            usage.objects = channelInfo.getNumAirFrames();
+            usage.bytes = channelInfo.getBytesUsed();
+            return usage;
+        });
+        cacheLinkBudgets = hasPar("cacheLinkBudgets") ? par("cacheLinkBudgets").boolValue() : false;
+        if (batchReceptionFiltering && (!fuseAnalogueModels || cacheLinkBudgets)) throw cRuntimeError("batchReceptionFiltering requires fuseAnalogueModels and does not support cacheLinkBudgets");
+        skipUnreceivableTransmissions = hasPar("skipUnreceivableTransmissions") ? par("skipUnreceivableTransmissions").boolValue() : false;
+        directIntraNicDelivery = hasPar("directIntraNicDelivery") ? par("directIntraNicDelivery").boolValue() : false;
+        if (directIntraNicDelivery) intraNicDispatcher.setLower(this);
+
         recordStats = par("recordStats").boolValue();
 
         radio = initializeRadio();
@@ -102,7 +138,10 @@ void BasePhyLayer::initialize(int stage)
             throw cRuntimeError("minPowerLevel can't be smaller than the signal attenuation threshold (sat) in ConnectionManager. Please adjust your omnetpp.ini file accordingly.");
         }
 
-        initializeAnalogueModels(par("analogueModels").xmlValue());
+        phyConfigCache = world->getPhyConfigCache();
+        shareAnalogueModels = hasPar("shareAnalogueModels") ? par("shareAnalogueModels").boolValue() : false;
+
+        setUpAnalogueModels();
         initializeDecider(par("decider").xmlValue());
         initializeAntenna(par("antenna").xmlValue());
 
@@ -111,6 +150,55 @@ void BasePhyLayer::initialize(int stage)
     }
 }
 
+void BasePhyLayer::setUpAnalogueModels()
+{
+    initializeAnalogueModels(par("analogueModels").xmlValue());
+    if (fuseAnalogueModels) compiledAnalogueModels = CompiledChannelModel(analogueModels);
+    if (cacheLinkBudgets) {
+        for (const auto& analogueModel : analogueModels) {
+            (analogueModel->isDeterministic() ? analogueModelsDeterministic : analogueModelsPerFrame).push_back(analogueModel);
+        }
+        if (fuseAnalogueModels) {
+            compiledAnalogueModelsDeterministic = CompiledChannelModel(analogueModelsDeterministic);
+            compiledAnalogueModelsPerFrame = CompiledChannelModel(analogueModelsPerFrame);
+        }
+    }
+    auto isThreadSafe = [](const std::shared_ptr<AnalogueModel>& model) { return model->isThreadSafe(); };
+    analogueModelsThreadSafe = std::all_of(analogueModels.begin(), analogueModels.end(), isThreadSafe) && std::all_of(analogueModelsThresholding.begin(), analogueModelsThresholding.end(), isThreadSafe);
+}
+
+void BasePhyLayer::resetForReuse(int stage)
+{
+    ChannelAccess::resetForReuse(stage);
+
+    if (stage == 0) {
+        // the AirFrames of the previous vehicle, and the state of radio, decider and analogue models, are dropped; configuration and antenna are kept
+        deleteReceivedAirFrames();
+        channelInfo = ChannelInfo();
+        channelInfo.setPartitionedByBand(partitionChannelInfo);
+        channelInfo.setCompactingInactive(hasPar("compactChannelInfo") ? par("compactChannelInfo").boolValue() : false);
+        cancelEvent(txOverTimer);
+        cancelEvent(radioSwitchingOverTimer);
+        controlMessagePool.resetStatistics();
+        intraNicDispatcher.resetStatistics();
+        numReceiversCulledByAntennas = 0;
+        numIrrelevantAirFrames = 0;
+        numTransmissionsSkipped = 0;
+        cullingPowerBound = 0;
+        farFieldAdded = false;
+        linkBudgets.clear();
+        linkBudgetEpoch = 0;
+
+        radio = initializeRadio();
+        analogueModels.clear();
+        analogueModelsThresholding.clear();
+        analogueModelsDeterministic.clear();
+        analogueModelsPerFrame.clear();
+        setUpAnalogueModels();
+        initializeDecider(par("decider").xmlValue());
+    }
+}
+
 unique_ptr<Radio> BasePhyLayer::initializeRadio()
 {
     int initialRadioState = par("initialRadioState");
@@ -140,50 +228,30 @@ unique_ptr<Radio> BasePhyLayer::initializeRadio()
     return radio;
 }
 
-void BasePhyLayer::getParametersFromXML(cXMLElement* xmlData, ParameterMap& outputMap)
-{
-    cXMLElementList parameters = xmlData->getElementsByTagName("Parameter");
-
-    for (cXMLElementList::const_iterator it = parameters.begin(); it != parameters.end(); it++) {
-
-        const char* name = (*it)->getAttribute("name");
-        const char* type = (*it)->getAttribute("type");
-        const char* value = (*it)->getAttribute("value");
-        if (name == nullptr || type == nullptr || value == nullptr) throw cRuntimeError("Invalid parameter, could not find name, type or value");
-
-        std::string sType = type; // needed for easier comparision
-        std::string sValue = value; // needed for easier comparision
-
-        cMsgPar param(name);
-
-        // parse type of parameter and set value
-        if (sType == "bool") {
-            param.setBoolValue(sValue == "true" || sValue == "1");
-        }
-        else if (sType == "double") {
-            param.setDoubleValue(strtod(value, nullptr));
-        }
-        else if (sType == "string") {
-            param.setStringValue(value);
-        }
-        else if (sType == "long") {
-            param.setLongValue(strtol(value, nullptr, 0));
-        }
-        else {
-            throw cRuntimeError("Unknown parameter type: '%s'", sType.c_str());
-        }
-
-        // add parameter to output map
-        outputMap[name] = param;
-    }
-}
-
 void BasePhyLayer::finish()
 {
     // give decider the chance to do something
     if (decider != nullptr) {
         decider->finish();
     }
+
+    recordScalar("controlMessagesAllocated", controlMessagePool.getAllocations());
+    recordScalar("controlMessagesReused", controlMessagePool.getReuses());
+    if (cullIrrelevantAirFrames) {
+        recordScalar("airFramesIrrelevant", numIrrelevantAirFrames);
+    }
+    if (cullUnreachableReceivers && directionalCulling) {
+        recordScalar("receiversCulledByAntennas", numReceiversCulledByAntennas);
+    }
+    if (skipUnreceivableTransmissions) {
+        recordScalar("transmissionsSkipped", numTransmissionsSkipped);
+    }
+    if (directIntraNicDelivery) {
+        recordScalar("intraNicDirectDeliveries", intraNicDispatcher.getNumDelivered());
+    }
+    if (channelInfo.isCompactingInactive()) {
+        recordScalar("channelInfoCompactedBytes", channelInfo.getCompactedBytes(), "B");
+    }
 }
 
 // -----Decider initialization----------------------
@@ -196,7 +264,7 @@ void BasePhyLayer::initializeDecider(cXMLElement* xmlConfig)
         throw cRuntimeError("No decider configuration file specified.");
     }
 
-    cXMLElementList deciderList = xmlConfig->getElementsByTagName("Decider");
+    const auto& deciderList = phyConfigCache->getEntries(xmlConfig, "Decider");
 
     if (deciderList.empty()) {
         throw cRuntimeError("No decider configuration found in configuration file.");
@@ -206,16 +274,13 @@ void BasePhyLayer::initializeDecider(cXMLElement* xmlConfig)
         throw cRuntimeError("More than one decider configuration found in configuration file.");
     }
 
-    cXMLElement* deciderData = deciderList.front();
-
-    const char* name = deciderData->getAttribute("type");
+    const char* name = deciderList.front().element->getAttribute("type");
 
     if (name == nullptr) {
         throw cRuntimeError("Could not read type of decider from configuration file.");
     }
 
-    ParameterMap params;
-    getParametersFromXML(deciderData, params);
+    ParameterMap params = deciderList.front().params;
 
     decider = getDeciderFromName(name, params);
 
@@ -235,26 +300,29 @@ unique_ptr<Decider> BasePhyLayer::getDeciderFromName(std::string name, Parameter
 
 void BasePhyLayer::initializeAntenna(cXMLElement* xmlConfig)
 {
+    // AirFrames sent by a previous use of this module (see module recycling) may still refer to the old antenna
+    if (antenna) retireAntenna(std::move(antenna));
     antenna = nullptr;
 
     if (xmlConfig == nullptr) {
         throw cRuntimeError("No antenna configuration file specified.");
     }
 
-    cXMLElementList antennaList = xmlConfig->getElementsByTagName("Antenna");
+    const auto& antennaList = phyConfigCache->getEntries(xmlConfig, "Antenna");
 
     if (antennaList.empty()) {
         throw cRuntimeError("No antenna configuration found in configuration file.");
     }
 
-    cXMLElement* antennaData;
+    const PhyConfigCache::Entry* antennaEntry;
     if (antennaList.size() > 1) {
         int num = intuniform(0, antennaList.size() - 1);
-        antennaData = antennaList[num];
+        antennaEntry = &antennaList[num];
     }
     else {
-        antennaData = antennaList.front();
+        antennaEntry = &antennaList.front();
     }
+    cXMLElement* antennaData = antennaEntry->element;
 
     const char* name = antennaData->getAttribute("type");
 
@@ -262,8 +330,7 @@ void BasePhyLayer::initializeAntenna(cXMLElement* xmlConfig)
         throw cRuntimeError("Could not read type of antenna from configuration file.");
     }
 
-    ParameterMap params;
-    getParametersFromXML(antennaData, params);
+    ParameterMap params = antennaEntry->params;
 
     antenna = getAntennaFromName(name, params);
 
@@ -319,6 +386,14 @@ std::shared_ptr<Antenna> BasePhyLayer::initializeSampledAntenna1D(ParameterMap&
         std::copy(std::istream_iterator<double>(rotationStream), std::istream_iterator<double>(), std::back_inserter(rotationParams));
     }
 
+    if (values.empty()) {
+        throw cRuntimeError("BasePhyLayer::initializeSampledAntenna1D(): The samples of this antenna could not be read.");
+    }
+
+    // without random offsets, the antenna pattern is the same for all hosts
+    if (offsetType.empty()) {
+        return std::make_shared<SampledAntenna1D>(phyConfigCache->getSampledAntennaGainTable(values), rotationType, rotationParams, this->getRNG(0));
+    }
     return std::make_shared<SampledAntenna1D>(values, offsetType, offsetParams, rotationType, rotationParams, this->getRNG(0));
 }
 
@@ -331,33 +406,41 @@ void BasePhyLayer::initializeAnalogueModels(cXMLElement* xmlConfig)
         throw cRuntimeError("No analogue models configuration file specified.");
     }
 
-    cXMLElementList analogueModelList = xmlConfig->getElementsByTagName("AnalogueModel");
+    const auto& analogueModelList = phyConfigCache->getEntries(xmlConfig, "AnalogueModel");
 
     if (analogueModelList.empty()) {
         throw cRuntimeError("No analogue models configuration found in configuration file.");
     }
 
-    // iterate over all AnalogueModel-entries, get a new AnalogueModel instance and add
+    // iterate over all AnalogueModel-entries, get a new (or shared) AnalogueModel instance and add
     // it to analogueModels
-    for (auto&& analogueModelData : analogueModelList) {
-        const char* name = analogueModelData->getAttribute("type");
-        const char* thresholdingFlag = analogueModelData->getAttribute("thresholding");
+    for (const auto& analogueModelEntry : analogueModelList) {
+        const char* name = analogueModelEntry.element->getAttribute("type");
+        const char* thresholdingFlag = analogueModelEntry.element->getAttribute("thresholding");
 
         if (name == nullptr) {
             throw cRuntimeError("Could not read name of analogue model.");
         }
 
-        ParameterMap params;
-        getParametersFromXML(analogueModelData, params);
+        std::shared_ptr<AnalogueModel> newAnalogueModel = shareAnalogueModels ? phyConfigCache->getSharedAnalogueModel(analogueModelEntry, getNedTypeName()) : nullptr;
+        if (!newAnalogueModel) {
+            ParameterMap params = analogueModelEntry.params;
+            newAnalogueModel = getAnalogueModelFromName(name, params);
 
-        auto newAnalogueModel = getAnalogueModelFromName(name, params);
+            if (!newAnalogueModel) {
+                throw cRuntimeError("Could not find an analogue model with the name \"%s\".", name);
+            }
 
-        if (!newAnalogueModel) {
-            throw cRuntimeError("Could not find an analogue model with the name \"%s\".", name);
+            if (shareAnalogueModels && newAnalogueModel->isShareable()) {
+                // hosts come and go, the world utility stays
+                newAnalogueModel->setOwner(world);
+                phyConfigCache->addSharedAnalogueModel(analogueModelEntry, getNedTypeName(), newAnalogueModel);
+            }
         }
 
         // attach the new AnalogueModel to the AnalogueModelList
-        if (thresholdingFlag && std::string(thresholdingFlag) == "true") {
+        const bool autoThresholding = !thresholdingFlag && autoThresholdAnalogueModels && newAnalogueModel->neverIncreasesPower();
+        if (autoThresholding || (thresholdingFlag && std::string(thresholdingFlag) == "true")) {
             if (!newAnalogueModel->neverIncreasesPower()) {
                 throw cRuntimeError("Tried to instantiate analogue model \"%s\" with tresholding=true, but model does not support this.", name);
             }
@@ -369,12 +452,22 @@ void BasePhyLayer::initializeAnalogueModels(cXMLElement* xmlConfig)
 
         EV_TRACE << "AnalogueModel \"" << name << "\" loaded." << endl;
     }
+
+    // thresholding models can be applied in any order, so evaluate cheap ones first to bail out before expensive ones
+    std::stable_sort(analogueModelsThresholding.begin(), analogueModelsThresholding.end(), [](const std::shared_ptr<AnalogueModel>& a, const std::shared_ptr<AnalogueModel>& b) { return a->getEvaluationCost() < b->getEvaluationCost(); });
 }
 
 // --Message handling--------------------------------------
 
 void BasePhyLayer::handleMessage(cMessage* msg)
 {
+    if (isSentBeforeParking(msg)) {
+        // meant for the previous vehicle of a recycled host (AirFrames being received are deleted by resetForReuse())
+        if (!msg->isSelfMessage()) delete msg;
+        return;
+    }
+
+    IntraNicDispatcher::Activation activation(directIntraNicDelivery ? &intraNicDispatcher : nullptr);
 
     // self messages
     if (msg->isSelfMessage()) {
@@ -428,10 +521,7 @@ void BasePhyLayer::handleAirFrame(AirFrame* frame)
 
 void BasePhyLayer::handleAirFrameStartReceive(AirFrame* frame)
 {
-    EV_TRACE << "Received new AirFrame " << frame << " from channel." << endl;
-
-    channelInfo.addAirFrame(frame, simTime());
-    ASSERT(!channelInfo.isChannelEmpty());
+    VEINS_LOG_TRACE << "Received new AirFrame " << frame << " from channel." << endl;
 
     if (usePropagationDelay) {
         Signal& s = frame->getSignal();
@@ -440,7 +530,28 @@ void BasePhyLayer::handleAirFrameStartReceive(AirFrame* frame)
     }
     ASSERT(frame->getSignal().getReceptionStart() == simTime());
 
-    filterSignal(frame);
+    startReceiving(frame);
+}
+
+void BasePhyLayer::startReceiving(AirFrame* frame)
+{
+    // the signal might have been filtered for us already when it was sent, see prepareForReceivers()
+    if (!frame->getSignalFiltered()) {
+        filterSignal(frame);
+    }
+
+    // analogue models for thresholding only ever decrease the power, so the signal is an upper bound already
+    if (cullIrrelevantAirFrames && frame->getSignal().getMax() < irrelevantAirFramePower) {
+        VEINS_LOG_TRACE << "AirFrame " << frame->getId() << " is too weak to matter even as interference, dropping it." << endl;
+        numIrrelevantAirFrames++;
+        delete frame;
+        return;
+    }
+
+    if (!decider || decider->usesChannelInfo()) {
+        channelInfo.addAirFrame(frame, simTime());
+        ASSERT(!channelInfo.isChannelEmpty());
+    }
 
     if (decider && isKnownProtocolId(frame->getProtocolId())) {
         frame->setState(static_cast<int>(AirFrameState::receiving));
@@ -481,20 +592,31 @@ void BasePhyLayer::handleAirFrameReceiving(AirFrame* frame)
         nextHandleTime = signalEndTime;
         frame->setState(static_cast<int>(AirFrameState::end_receive));
 
+        // only start and end of the AirFrame are of interest, no intermediate state changes
+    }
+    else if (!decider->needsIntermediateProcessing() && nextHandleTime != signalEndTime) {
+        throw cRuntimeError("Decider needs no intermediate processing of AirFrames, but asked to be passed AirFrame %ld again at %.6f instead of at its end (%.6f)", frame->getId(), SIMTIME_DBL(nextHandleTime), SIMTIME_DBL(signalEndTime));
+
         // invalid point in time
     }
     else if (nextHandleTime < simTime() || nextHandleTime > signalEndTime) {
         throw cRuntimeError("Invalid next handle time returned by Decider. Expected a value between current simulation time (%.2f) and end of signal (%.2f) but got %.2f", SIMTIME_DBL(simTime()), SIMTIME_DBL(signalEndTime), SIMTIME_DBL(nextHandleTime));
     }
 
-    EV_TRACE << "Handed AirFrame with ID " << frame->getId() << " to Decider. Next handling in " << nextHandleTime - simTime() << "s." << endl;
+    VEINS_LOG_TRACE << "Handed AirFrame with ID " << frame->getId() << " to Decider. Next handling in " << nextHandleTime - simTime() << "s." << endl;
 
     sendSelfMessage(frame, nextHandleTime);
 }
 
 void BasePhyLayer::handleAirFrameEndReceive(AirFrame* frame)
 {
-    EV_TRACE << "End of Airframe with ID " << frame->getId() << "." << endl;
+    VEINS_LOG_TRACE << "End of Airframe with ID " << frame->getId() << "." << endl;
+
+    if (decider && !decider->usesChannelInfo()) {
+        // nobody else will look at this AirFrame again
+        delete frame;
+        return;
+    }
 
     simtime_t earliestInfoPoint = channelInfo.removeAirFrame(frame);
 
@@ -528,12 +650,26 @@ void BasePhyLayer::handleUpperMessage(cMessage* msg)
     // build the AirFrame to send
     ASSERT(dynamic_cast<cPacket*>(msg) != nullptr);
 
+    if (skipUnreceivableTransmissions && !hasConnectedNics()) {
+        // sendToChannel() would just delete the AirFrame, only end the transmission in time
+        cPacket* macPkt = static_cast<cPacket*>(msg);
+        const simtime_t duration = getTransmissionDuration(macPkt, macPkt->getControlInfo());
+        if (duration >= 0) {
+            // draw the id the AirFrame would have taken, so those of later AirFrames do not change
+            world->getUniqueAirFrameId();
+            numTransmissionsSkipped++;
+            delete macPkt;
+            sendSelfMessage(txOverTimer, simTime() + duration);
+            return;
+        }
+    }
+
     unique_ptr<AirFrame> frame = encapsMsg(static_cast<cPacket*>(msg));
 
     // Prepare a POA object and attach it to the created Airframe
     AntennaPosition pos = antennaPosition;
     Coord orient = antennaHeading.toCoord();
-    frame->setPoa({pos, orient, antenna});
+    frame->setPoa({pos, orient, antenna.get()});
 
     // make sure there is no self message of kind TX_OVER scheduled
     // and schedule the actual one
@@ -578,7 +714,7 @@ unique_ptr<AirFrame> BasePhyLayer::encapsMsg(cPacket* macPkt)
 
     // --- from here on, the AirFrame is the owner of the MacPacket ---
     macPkt = nullptr;
-    EV_TRACE << "AirFrame encapsulated, length: " << frame->getBitLength() << "\n";
+    VEINS_LOG_TRACE << "AirFrame encapsulated, length: " << frame->getBitLength() << "\n";
 
     return frame;
 }
@@ -596,7 +732,7 @@ void BasePhyLayer::handleSelfMessage(cMessage* msg)
     // transmission over
     case TX_OVER:
         ASSERT(msg == txOverTimer);
-        sendControlMsgToMac(new cMessage("Transmission over", TX_OVER));
+        sendControlMsgToMac(createControlMsg("Transmission over", TX_OVER));
         break;
 
     // radio switch over
@@ -619,20 +755,152 @@ void BasePhyLayer::handleSelfMessage(cMessage* msg)
 
 void BasePhyLayer::sendControlMessageUp(cMessage* msg)
 {
+    if (directIntraNicDelivery) {
+        intraNicDispatcher.postUp(msg, true);
+        return;
+    }
     send(msg, upperControlOut);
 }
 
 void BasePhyLayer::sendMacPktUp(cMessage* pkt)
 {
+    if (directIntraNicDelivery) {
+        intraNicDispatcher.postUp(pkt, false);
+        return;
+    }
     send(pkt, upperLayerOut);
 }
 
+IntraNicDispatcher* BasePhyLayer::getIntraNicDispatcher()
+{
+    return directIntraNicDelivery ? &intraNicDispatcher : nullptr;
+}
+
+void BasePhyLayer::receiveFromNic(cMessage* msg, bool control)
+{
+    Enter_Method_Silent();
+    take(msg);
+    if (control) {
+        handleUpperControlMessage(msg);
+    }
+    else {
+        handleUpperMessage(msg);
+    }
+}
+
 void BasePhyLayer::sendMessageDown(AirFrame* msg)
 {
+    if (cullUnreachableReceivers) {
+        // free space loss is lowest at the lowest frequency of the spectrum
+        const Signal& signal = msg->getSignal();
+        const double wavelength = BaseWorldUtility::speedOfLight() / signal.getSpectrum().freqAt(0);
+        cullingPowerBound = signal.getMax() * receiverCullingGain * (wavelength * wavelength) / (16.0 * M_PI * M_PI);
+    }
+    farFieldAdded = false;
 
     sendToChannel(msg);
 }
 
+bool BasePhyLayer::isReceiverReachable(cPacket* msg, const NicEntry* nic)
+{
+    const auto receiverPhy = dynamic_cast<BasePhyLayer*>(nic->chAccess);
+    if (!receiverPhy) return true;
+
+    if (FarFieldInterference* farField = cc->getFarFieldInterference()) {
+        if (farField->isFarField(antennaPosition.getPositionAt(), receiverPhy->antennaPosition.getPositionAt())) {
+            if (!farFieldAdded) {
+                const Signal& signal = static_cast<AirFrame*>(msg)->getSignal();
+                const simtime_t start = signal.getSendingStart();
+                farField->add(antennaPosition.getPositionAt(), signal.getSpectrum().freqAt(signal.getCenterFrequencyIndex()), signal.getAtCenterFrequency(), start, start + signal.getDuration());
+                farFieldAdded = true;
+            }
+            return false;
+        }
+    }
+
+    if (!cullUnreachableReceivers) return true;
+
+    const double sqrDistance = antennaPosition.getPositionAt().sqrdist(receiverPhy->antennaPosition.getPositionAt());
+    // analogue models do not attenuate within one meter
+    if (sqrDistance <= 1.0) return true;
+
+    const double maxReceivedPower = cullingPowerBound * pow(sqrDistance, -receiverCullingAlpha / 2);
+    if (maxReceivedPower < receiverPhy->getReceptionPowerThreshold()) return false;
+    if (!directionalCulling) return true;
+
+    // receiverCullingGain does not cover the antennas, bound their gains by the sectors they face each other in
+    const Coord los = receiverPhy->antennaPosition.getPositionAt() - antennaPosition.getPositionAt();
+    const Coord reverseLos = antennaPosition.getPositionAt() - receiverPhy->antennaPosition.getPositionAt();
+    const double antennaGainBound = antenna->getGainBound(antennaHeading.toCoord(), los) * receiverPhy->antenna->getGainBound(receiverPhy->antennaHeading.toCoord(), reverseLos);
+    if (maxReceivedPower * antennaGainBound < receiverPhy->getReceptionPowerThreshold()) {
+        numReceiversCulledByAntennas++;
+        return false;
+    }
+    return true;
+}
+
+double BasePhyLayer::getReceptionPowerThreshold() const
+{
+    return minPowerLevel;
+}
+
+void BasePhyLayer::prepareForReceivers(const std::vector<cPacket*>& msgs, const std::vector<const NicEntry*>& nics)
+{
+    VEINS_PROFILE_SCOPE("BasePhyLayer::prepareForReceivers");
+    if (!parallelReceptionFiltering && !batchReceptionFiltering) return;
+
+    // receivers sharing the analogue models of this phy are filtered in one batch, all others one by one
+    auto inBatch = [this](const BasePhyLayer* receiverPhy) { return batchReceptionFiltering && (receiverPhy->analogueModels == analogueModels); };
+
+    auto filter = [&msgs, &nics, &inBatch](size_t i) {
+        const auto receiverPhy = dynamic_cast<BasePhyLayer*>(nics[i]->chAccess);
+        if (!receiverPhy || !receiverPhy->analogueModelsThreadSafe || inBatch(receiverPhy)) return;
+
+        AirFrame* frame = static_cast<AirFrame*>(msgs[i]);
+        receiverPhy->applyReceptionFilters(frame, receiverPhy->antennaPosition, receiverPhy->antennaHeading.toCoord());
+        // also evaluate the thresholding models the receiver would evaluate first (this does not change the outcome, only where it is computed)
+        frame->getSignal().smallerAtCenterFrequency(receiverPhy->getReceptionPowerThreshold());
+        frame->setSignalFiltered(true);
+    };
+
+    if (parallelReceptionFiltering) {
+        if (WorkerPool* pool = cc->getWorkerPool()) {
+            for (const NicEntry* nic : nics) {
+                const auto receiverPhy = dynamic_cast<BasePhyLayer*>(nic->chAccess);
+                if (!receiverPhy || !receiverPhy->analogueModelsThreadSafe || inBatch(receiverPhy)) continue;
+                for (const auto& analogueModel : receiverPhy->analogueModels) analogueModel->prepareConcurrentFiltering();
+                for (const auto& analogueModel : receiverPhy->analogueModelsThresholding) analogueModel->prepareConcurrentFiltering();
+            }
+            pool->run(msgs.size(), filter);
+        }
+        else {
+            for (size_t i = 0; i < msgs.size(); ++i) filter(i);
+        }
+    }
+    if (!batchReceptionFiltering) return;
+
+    batchReceivers.clear();
+    batchSignals.clear();
+    batchLinks.clear();
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        const auto receiverPhy = dynamic_cast<BasePhyLayer*>(nics[i]->chAccess);
+        if (!receiverPhy || !receiverPhy->analogueModelsThreadSafe || !inBatch(receiverPhy)) continue;
+
+        AirFrame* frame = static_cast<AirFrame*>(msgs[i]);
+        receiverPhy->applyAntennaGains(frame, receiverPhy->antennaPosition, receiverPhy->antennaHeading.toCoord());
+        batchReceivers.push_back(i);
+        batchSignals.push_back(&frame->getSignal());
+        batchLinks.push_back(&frame->getSignal().getLinkGeometry());
+    }
+    compiledAnalogueModels.filterSignals(batchSignals.data(), batchLinks.data(), batchSignals.size());
+    for (size_t k = 0; k < batchReceivers.size(); ++k) {
+        const auto receiverPhy = static_cast<BasePhyLayer*>(nics[batchReceivers[k]]->chAccess);
+        AirFrame* frame = static_cast<AirFrame*>(msgs[batchReceivers[k]]);
+        frame->getSignal().smallerAtCenterFrequency(receiverPhy->getReceptionPowerThreshold());
+        frame->setSignalFiltered(true);
+    }
+}
+
 void BasePhyLayer::sendSelfMessage(cMessage* msg, simtime_t_cref time)
 {
     // TODO: maybe delete this method because it doesn't makes much sense,
@@ -643,44 +911,137 @@ void BasePhyLayer::sendSelfMessage(cMessage* msg, simtime_t_cref time)
 
 void BasePhyLayer::filterSignal(AirFrame* frame)
 {
+    VEINS_PROFILE_SCOPE("BasePhyLayer::filterSignal");
     ASSERT(dynamic_cast<ChannelAccess* const>(frame->getArrivalModule()) == this);
     ASSERT(dynamic_cast<ChannelAccess* const>(frame->getSenderModule()));
+
+    // filter with the position and orientation of the receiver (this module)
+    double gain = applyReceptionFilters(frame, antennaPosition, antennaHeading.toCoord());
+    VEINS_LOG_TRACE << "Combined antenna gain of sender and receiver: " << gain << endl;
+}
+
+double BasePhyLayer::applyReceptionFilters(AirFrame* frame, const AntennaPosition& receiverPosition, const Coord& receiverOrientation)
+{
+    const double gain = applyAntennaGains(frame, receiverPosition, receiverOrientation);
+    Signal& signal = frame->getSignal();
+    const LinkGeometry& link = signal.getLinkGeometry();
+
+    // apply all analouge models that are *not* suitable for thresholding now
+    if (cacheLinkBudgets) {
+        applyCachedAnalogueModels(frame, signal, link);
+    }
+    else if (fuseAnalogueModels) {
+        compiledAnalogueModels.filterSignal(&signal, link);
+    }
+    else {
+        for (auto& analogueModel : analogueModels) {
+            analogueModel->filterSignal(&signal);
+        }
+    }
+
+    return gain;
+}
+
+double BasePhyLayer::applyAntennaGains(AirFrame* frame, const AntennaPosition& receiverPosition, const Coord& receiverOrientation)
+{
     Signal& signal = frame->getSignal();
 
-    // Extract position and orientation of sender and receiver (this module) first
-    const AntennaPosition receiverPosition = antennaPosition;
-    const Coord receiverOrientation = antennaHeading.toCoord();
     // get POA from frame with the sender's position, orientation and antenna
     POA& senderPOA = frame->getPoa();
-    const AntennaPosition senderPosition = senderPOA.pos;
     const Coord senderOrientation = senderPOA.orientation;
 
     // add position information to signal
     signal.setSenderPoa(senderPOA);
-    signal.setReceiverPoa({receiverPosition, receiverOrientation, antenna});
+    signal.setReceiverPoa({receiverPosition, receiverOrientation, antenna.get()});
+    signal.setLinkIds(frame->getTreeId(), getId());
+    if (restrictFilterWindow) {
+        signal.restrictFilterWindow(filterGuardBins);
+    }
+
+    // compute the geometry of the link once, for the antennas and all analogue models
+    const LinkGeometry& link = signal.getLinkGeometry();
 
     // compute gains at sender and receiver antenna
-    double receiverGain = antenna->getGain(receiverPosition.getPositionAt(), receiverOrientation, senderPosition.getPositionAt());
-    double senderGain = senderPOA.antenna->getGain(senderPosition.getPositionAt(), senderOrientation, receiverPosition.getPositionAt());
+    double receiverGain = antenna->getGain(link, receiverOrientation, false);
+    double senderGain = senderPOA.antenna->getGain(link, senderOrientation, true);
 
     // add the resulting total gain to the attenuations list
-    EV_TRACE << "Sender's antenna gain: " << senderGain << endl;
-    EV_TRACE << "Own (receiver's) antenna gain: " << receiverGain << endl;
     signal *= receiverGain * senderGain;
 
     // go on with AnalogueModels
     // attach analogue models suitable for thresholding to signal (for later evaluation)
     signal.setAnalogueModelList(&analogueModelsThresholding);
 
-    // apply all analouge models that are *not* suitable for thresholding now
-    for (auto& analogueModel : analogueModels) {
-        analogueModel->filterSignal(&signal);
+    return receiverGain * senderGain;
+}
+
+void BasePhyLayer::applyCachedAnalogueModels(AirFrame* frame, Signal& signal, const LinkGeometry& link)
+{
+    // nodes moved by TraCI only change their positions with a new time step, so is (for all we know) anything else deterministic models depend on
+    const uint64_t epoch = world->getTimestepEpoch();
+    if (epoch != linkBudgetEpoch) {
+        linkBudgets.clear();
+        linkBudgetEpoch = epoch;
+    }
+
+    LinkBudget& budget = linkBudgets[frame->getSenderModuleId()];
+    const bool hit = !budget.attenuation.empty() && budget.spectrum == signal.getSpectrum() && budget.dataStart == signal.getDataStart() && budget.dataEnd == signal.getDataEnd() && budget.senderPos == link.senderPos && budget.receiverPos == link.receiverPos;
+    if (!hit) {
+        // filter a unit signal of the same shape to obtain the attenuation
+        Signal probe(signal);
+        probe = 1;
+        if (fuseAnalogueModels) {
+            compiledAnalogueModelsDeterministic.filterSignal(&probe, link);
+        }
+        else {
+            for (auto& analogueModel : analogueModelsDeterministic) {
+                analogueModel->filterSignal(&probe);
+            }
+        }
+        budget.senderPos = link.senderPos;
+        budget.receiverPos = link.receiverPos;
+        budget.spectrum = signal.getSpectrum();
+        budget.dataStart = signal.getDataStart();
+        budget.dataEnd = signal.getDataEnd();
+        budget.attenuation.assign(probe.getValues(), probe.getValues() + probe.getNumValues());
+    }
+
+    Signal::Value* values = signal.getValues();
+    for (size_t i = 0; i < budget.attenuation.size(); ++i) {
+        values[i] *= budget.attenuation[i];
+    }
+
+    if (fuseAnalogueModels) {
+        compiledAnalogueModelsPerFrame.filterSignal(&signal, link);
+    }
+    else {
+        for (auto& analogueModel : analogueModelsPerFrame) {
+            analogueModel->filterSignal(&signal);
+        }
     }
 }
 
 // --Destruction--------------------------------
 
 BasePhyLayer::~BasePhyLayer()
+{
+    deleteReceivedAirFrames();
+
+    // free timer messages
+    if (txOverTimer) {
+        cancelAndDelete(txOverTimer);
+        txOverTimer = nullptr;
+    }
+    if (radioSwitchingOverTimer) {
+        cancelAndDelete(radioSwitchingOverTimer);
+        radioSwitchingOverTimer = nullptr;
+    }
+
+    // AirFrames sent by this phy may still be on their way to receivers
+    if (antenna) retireAntenna(std::move(antenna));
+}
+
+void BasePhyLayer::deleteReceivedAirFrames()
 {
     // get AirFrames from ChannelInfo and delete
     // (although ChannelInfo normally owns the AirFrames it
@@ -691,16 +1052,24 @@ BasePhyLayer::~BasePhyLayer()
     for (AirFrameVector::iterator it = channel.begin(); it != channel.end(); ++it) {
         cancelAndDelete(*it);
     }
+}
 
-    // free timer messages
-    if (txOverTimer) {
-        cancelAndDelete(txOverTimer);
-        txOverTimer = nullptr;
+void BasePhyLayer::retireAntenna(std::shared_ptr<Antenna> antenna)
+{
+    static std::deque<std::pair<simtime_t, std::shared_ptr<Antenna>>> retiredAntennas;
+
+    cSimulation* simulation = cSimulation::getActiveSimulation();
+    if (!simulation) {
+        retiredAntennas.clear();
+        return;
     }
-    if (radioSwitchingOverTimer) {
-        cancelAndDelete(radioSwitchingOverTimer);
-        radioSwitchingOverTimer = nullptr;
+
+    // release antennas retired long enough ago (or during an earlier run, whose times lie in the future)
+    const simtime_t now = simulation->getSimTime();
+    while (!retiredAntennas.empty() && (retiredAntennas.front().first + 1 < now || retiredAntennas.front().first > now)) {
+        retiredAntennas.pop_front();
     }
+    retiredAntennas.emplace_back(now, std::move(antenna));
 }
 
 // --MacToPhyInterface implementation-----------------------
@@ -715,7 +1084,7 @@ int BasePhyLayer::getRadioState()
 void BasePhyLayer::finishRadioSwitching()
 {
     radio->endSwitch(simTime());
-    sendControlMsgToMac(new cMessage("Radio switching over", RADIO_SWITCHING_OVER));
+    sendControlMsgToMac(createControlMsg("Radio switching over", RADIO_SWITCHING_OVER));
 }
 
 simtime_t BasePhyLayer::setRadioState(int rs)
@@ -773,6 +1142,22 @@ void BasePhyLayer::getChannelInfo(simtime_t_cref from, simtime_t_cref to, AirFra
     channelInfo.getAirFrames(from, to, out);
 }
 
+void BasePhyLayer::getChannelInfoInBand(simtime_t_cref from, simtime_t_cref to, double freqLow, double freqHigh, AirFrameVector& out)
+{
+    if (!partitionChannelInfo) {
+        channelInfo.getAirFrames(from, to, out);
+        return;
+    }
+    channelInfo.getAirFrames(from, to, overallSpectrum.indexOf(freqLow), overallSpectrum.indexOf(freqHigh) + 1, out);
+}
+
+double BasePhyLayer::getFarFieldInterference(simtime_t_cref from, simtime_t_cref to, double frequency)
+{
+    const FarFieldInterference* farField = cc->getFarFieldInterference();
+    if (!farField) return 0;
+    return farField->getMaxPower(antennaPosition.getPositionAt(), frequency, from, to, cc->getMaxInterferenceDistance());
+}
+
 double BasePhyLayer::getNoiseFloorValue()
 {
     return noiseFloorValue;
@@ -783,10 +1168,22 @@ void BasePhyLayer::sendControlMsgToMac(cMessage* msg)
     sendControlMessageUp(msg);
 }
 
+cMessage* BasePhyLayer::createControlMsg(const char* name, short kind)
+{
+    return controlMessagePool.acquire(name, kind);
+}
+
+void BasePhyLayer::recycleControlMsg(cMessage* msg)
+{
+    Enter_Method_Silent();
+    take(msg);
+    controlMessagePool.release(msg);
+}
+
 void BasePhyLayer::sendUp(AirFrame* frame, DeciderResult* result)
 {
 
-    EV_TRACE << "Decapsulating MacPacket from Airframe with ID " << frame->getId() << " and sending it up to MAC." << endl;
+    VEINS_LOG_TRACE << "Decapsulating MacPacket from Airframe with ID " << frame->getId() << " and sending it up to MAC." << endl;
 
     cMessage* packet = frame->decapsulate();
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <memory>
@@ -36,6 +37,11 @@
 #include "veins/base/phyLayer/MacToPhyInterface.h"
 #include "veins/base/phyLayer/Antenna.h"
 #include "veins/base/phyLayer/ChannelInfo.h"
+#include "veins/base/phyLayer/CompiledChannelModel.h"
+#include "veins/base/phyLayer/PhyConfigCache.h"
+#include "veins/base/utils/IntraNicDispatcher.h"
+#include "veins/base/utils/MessagePool.h"
+#include "veins/base/utils/MemoryAccounting.h"
 
 namespace veins {
 
@@ -87,7 +93,7 @@ class Radio;
  * @ingroup baseModules
  */
 
-class VEINS_API BasePhyLayer : public ChannelAccess, public DeciderToPhyInterface, public MacToPhyInterface {
+class VEINS_API BasePhyLayer : public ChannelAccess, public DeciderToPhyInterface, public MacToPhyInterface, public IntraNicDispatcher::Receiver {
 
 protected:
     using ParameterMap = std::map<std::string, cMsgPar>; ///< Used at initialisation to pass the parameters to the AnalogueModel and Decider.
@@ -116,14 +122,42 @@ protected:
     int protocolId = PROTOCOL_ID_GENERIC; ///< The ID of the protocol this phy can transceive.
     double noiseFloorValue = 0; ///< Catch-all for all factors negatively impacting SINR (e.g., thermal noise, noise figure, ...)
     double minPowerLevel; ///< The minimum receive power needed to even attempt decoding a frame.
+    bool cullUnreachableReceivers; ///< Stores if AirFrames are only sent to nics that could possibly detect them.
+    double receiverCullingGain; ///< Upper bound of all gains (antennas, multipath, ...) over free space loss assumed for culling receivers.
+    double receiverCullingAlpha; ///< Lower bound of the path loss exponent assumed for culling receivers.
+    bool directionalCulling; ///< Stores if receivers are also culled by the gain bounds of both antennas (then excluded from receiverCullingGain).
+    long numReceiversCulledByAntennas = 0; ///< Number of receivers culled only because of the gain bounds of the antennas.
+    double cullingPowerBound = 0; ///< Upper bound of received power times distance^alpha of the AirFrame currently being sent.
+    bool cullIrrelevantAirFrames; ///< Stores if received AirFrames below irrelevantAirFramePower are dropped right after filtering.
+    double irrelevantAirFramePower; ///< Power (in mW) below which a received AirFrame is irrelevant, even as interference.
+    long numIrrelevantAirFrames = 0; ///< Number of received AirFrames dropped for being irrelevant.
+    bool farFieldAdded = false; ///< Stores if the AirFrame currently being sent was already added to the connection manager's far field interference.
+    bool autoThresholdAnalogueModels; ///< Stores if analogue models that never increase power are used for thresholding unless configured otherwise.
+    bool parallelReceptionFiltering; ///< Stores if signals are filtered for all their receivers on the connection manager's worker threads when they are sent.
+    bool fuseAnalogueModels; ///< Stores if analogueModels are applied by compiledAnalogueModels rather than one by one.
+    bool batchReceptionFiltering; ///< Stores if signals are filtered for all receivers sharing analogueModels in one batch when they are sent.
+    std::vector<size_t> batchReceivers; ///< Indices of the receivers filtered in the current batch (kept to reuse its storage).
+    std::vector<Signal*> batchSignals; ///< Signals of the current batch (kept to reuse its storage).
+    std::vector<const LinkGeometry*> batchLinks; ///< Links of the current batch (kept to reuse its storage).
+    bool restrictFilterWindow; ///< Stores if analogue models are only applied to the data frequency range of received signals (plus filterGuardBins).
+    size_t filterGuardBins; ///< Number of frequencies on either side of the data frequency range analogue models are still applied to.
+    bool partitionChannelInfo; ///< Stores if channelInfo is partitioned by band, so deciders only get the AirFrames overlapping with the band they ask for.
+    bool cacheLinkBudgets; ///< Stores if the attenuation of deterministic analogue models is cached per sender within a TraCI time step (see linkBudgets).
+    bool analogueModelsThreadSafe = false; ///< Stores if all analogue models (including those for thresholding) of this phy may filter signals on worker threads.
     bool recordStats; ///< Stores if tracking of statistics (esp. cOutvectors) is enabled.
     ChannelInfo channelInfo; ///< Channel info keeps track of received AirFrames and provides information about currently active AirFrames at the channel.
     std::unique_ptr<Radio> radio; ///< The state machine storing the current radio state (TX, RX, SLEEP).
+    MessagePool controlMessagePool; ///< Recycled control messages sent to (and handed back by) the mac.
+    bool skipUnreceivableTransmissions; ///< Stores if transmissions of a nic without any connections are not turned into AirFrames (see getTransmissionDuration()).
+    long numTransmissionsSkipped = 0; ///< Number of transmissions not turned into AirFrames for lack of connected nics.
+    bool directIntraNicDelivery; ///< Stores if messages to and from the mac are passed by intraNicDispatcher rather than sent via gates.
+    IntraNicDispatcher intraNicDispatcher; ///< Passes messages to and from the mac (used if directIntraNicDelivery is set).
 
     /**
      * Shared pointer to the Antenna used for this node.
      *
-     * Using a shared pointer ensures proper handling of a signal is possible, even after the sender has been destroyed.
+     * POAs only refer to it by a raw pointer. Once this phy layer is done with it, it is handed to retireAntenna(),
+     * so proper handling of a signal is still possible after the sender has been destroyed.
      */
     std::shared_ptr<Antenna> antenna;
 
@@ -139,9 +173,49 @@ protected:
      *
      * These models are not applied immediately, but only attached to the signal.
      * This enables lazy application of the models.
+     * They are ordered by ascending AnalogueModel::getEvaluationCost().
      */
     AnalogueModelList analogueModelsThresholding;
 
+    /**
+     * The analogueModels, compiled into one fused kernel (used if fuseAnalogueModels is set).
+     */
+    CompiledChannelModel compiledAnalogueModels;
+
+    /**
+     * The analogueModels that are deterministic (see AnalogueModel::isDeterministic()) and those that are not, in their original order (used if cacheLinkBudgets is set).
+     */
+    AnalogueModelList analogueModelsDeterministic;
+    AnalogueModelList analogueModelsPerFrame;
+
+    /**
+     * analogueModelsDeterministic and analogueModelsPerFrame, compiled into fused kernels (used if both cacheLinkBudgets and fuseAnalogueModels are set).
+     */
+    CompiledChannelModel compiledAnalogueModelsDeterministic;
+    CompiledChannelModel compiledAnalogueModelsPerFrame;
+
+    /**
+     * The combined attenuation of analogueModelsDeterministic for a link, along with what it was computed for.
+     */
+    struct LinkBudget {
+        Coord senderPos;
+        Coord receiverPos;
+        Spectrum spectrum;
+        size_t dataStart = 0;
+        size_t dataEnd = 0;
+        std::vector<Signal::Value> attenuation;
+    };
+
+    /**
+     * The link budgets of all senders heard in the current TraCI time step, by sender module id.
+     */
+    std::unordered_map<int, LinkBudget> linkBudgets;
+
+    /**
+     * The TraCI time step (see BaseWorldUtility::getTimestepEpoch()) linkBudgets were computed in.
+     */
+    uint64_t linkBudgetEpoch = 0;
+
     int upperLayerIn; ///< The id of the in-data gate from the Mac layer.
     int upperLayerOut; ///< The id of the out-data gate to the Mac layer.
     int upperControlOut; ///< The id of the out-control gate to the Mac layer.
@@ -152,17 +226,27 @@ protected:
 
     BaseWorldUtility* world = nullptr; ///< Pointer to the World Utility, to obtain some global information
 
+    std::shared_ptr<PhyConfigCache> phyConfigCache; ///< Parsed XML configuration and shared analogue models, common to all phys of the simulation.
+    bool shareAnalogueModels = false; ///< Stores if analogue models that support it (see AnalogueModel::isShareable()) are shared with all other phys of the same type and configuration.
+
 private:
-    /**
-     * Read the parameters of a XML element and stores them in the passed ParameterMap reference.
-     */
-    void getParametersFromXML(cXMLElement* xmlData, ParameterMap& outputMap);
+    MemoryAccounting::Registration memoryRegistration; ///< Reports the AirFrames held by channelInfo as subsystem "phy.channelInfo".
 
     /**
      * Initialize the AnalogueModels with the data from the passed XML-config data.
      */
     void initializeAnalogueModels(cXMLElement* xmlConfig);
 
+    /**
+     * Initialize the AnalogueModels (see initializeAnalogueModels()), along with the lists and kernels derived from them.
+     */
+    void setUpAnalogueModels();
+
+    /**
+     * Cancel and delete all AirFrames held by channelInfo.
+     */
+    void deleteReceivedAirFrames();
+
     /**
      * Initialize the Decider with the data from the passed XML-config data.
      */
@@ -271,6 +355,12 @@ protected:
      */
     virtual void handleAirFrameStartReceive(AirFrame* msg);
 
+    /**
+     * Filters an AirFrame for this receiver (unless done already) and starts receiving it from now on:
+     * adds it to the ChannelInfo and passes it to the Decider for the first time.
+     */
+    void startReceiving(AirFrame* frame);
+
     /**
      * Handle incoming AirFrames with the state AirFrameState::receiving.
      */
@@ -303,6 +393,36 @@ protected:
      */
     void sendMessageDown(AirFrame* pkt);
 
+    /**
+     * Checks if the AirFrame currently being sent could possibly be detected by the passed nic.
+     *
+     * Uses a conservative upper bound of the received power (free space loss with
+     * receiverCullingAlpha, increased by receiverCullingGain) and compares it to
+     * the reception power threshold of the receiving phy.
+     * If directionalCulling is set, the bound is further multiplied by the gain bounds
+     * of the sender's and receiver's antennas towards each other (see Antenna::getGainBound()).
+     */
+    bool isReceiverReachable(cPacket* msg, const NicEntry* nic) override;
+
+    /**
+     * If parallelReceptionFiltering is set, filters the signal of every receiver's copy of the AirFrame for that receiver.
+     *
+     * The receivers are processed on the connection manager's worker threads, each writing only to its own copy,
+     * so the results do not depend on the number of threads. Receivers whose analogue models are not all
+     * thread safe are left to filterSignal() upon reception.
+     *
+     * If batchReceptionFiltering is set, receivers sharing the analogue models of this phy (see shareAnalogueModels)
+     * are instead filtered in one batch, see CompiledChannelModel::filterSignals().
+     */
+    void prepareForReceivers(const std::vector<cPacket*>& msgs, const std::vector<const NicEntry*>& nics) override;
+
+    /**
+     * Returns the lowest received power (in mW) an AirFrame needs to have any effect on this phy.
+     *
+     * The default implementation returns minPowerLevel.
+     */
+    virtual double getReceptionPowerThreshold() const;
+
     /**
      * Schedule self message to passed point in time.
      */
@@ -328,6 +448,17 @@ protected:
      */
     virtual std::unique_ptr<AirFrame> encapsMsg(cPacket* msg);
 
+    /**
+     * Return the duration of the AirFrame encapsMsg() would create for the passed message from the upper layer and its control info,
+     * or a negative value if it cannot be told without creating the AirFrame.
+     *
+     * Used by skipUnreceivableTransmissions to end transmissions nobody could receive without building their AirFrame and Signal.
+     */
+    virtual simtime_t getTransmissionDuration(cPacket* macPkt, cObject* ctrlInfo) const
+    {
+        return -1;
+    }
+
     /**
      * Filter the passed AirFrame's Signal by every registered AnalogueModel.
      *
@@ -339,6 +470,30 @@ protected:
      */
     virtual void filterSignal(AirFrame* frame);
 
+    /**
+     * Applies the antenna gains and analogue models of this phy to the passed AirFrame's Signal, as received at the passed antenna position and orientation.
+     *
+     * Does not log or otherwise touch the simulation, so it can be called from worker threads (if analogueModelsThreadSafe).
+     *
+     * @return the combined gain of the sender's and receiver's antennas
+     */
+    double applyReceptionFilters(AirFrame* frame, const AntennaPosition& receiverPosition, const Coord& receiverOrientation);
+
+    /**
+     * The first part of applyReceptionFilters(): sets up the passed AirFrame's Signal for reception at the passed antenna position and orientation
+     * and applies the antenna gains, but none of the analogue models.
+     *
+     * @return the combined gain of the sender's and receiver's antennas
+     */
+    double applyAntennaGains(AirFrame* frame, const AntennaPosition& receiverPosition, const Coord& receiverOrientation);
+
+    /**
+     * Applies the analogue models to the passed AirFrame's Signal, taking the attenuation of deterministic models from linkBudgets (computing it on a miss).
+     *
+     * Called by applyReceptionFilters() if cacheLinkBudgets is set.
+     */
+    void applyCachedAnalogueModels(AirFrame* frame, Signal& signal, const LinkGeometry& link);
+
     /**
      * Called when the switching process of the Radio is finished.
      *
@@ -377,12 +532,23 @@ protected:
      */
     Spectrum overallSpectrum;
 
+    /**
+     * Keeps an antenna no longer used by its phy layer alive until no AirFrame sent with it can still arrive, as POAs do not own antennas.
+     *
+     * AirFrames are filtered with the sender's antenna no later than when they arrive at a receiver, i.e., at most a propagation delay after
+     * being sent. Antennas are therefore released once they have been retired for a generous bound of that (1 s of simulation time).
+     */
+    static void retireAntenna(std::shared_ptr<Antenna> antenna);
+
 public:
     ~BasePhyLayer() override;
 
     /** Call the deciders finish method. */
     void finish() override;
 
+    /** Drop all received AirFrames and start over with a new radio, decider, and analogue models, see BaseModule::resetForReuse(). */
+    void resetForReuse(int stage) override;
+
     // ---------MacToPhyInterface implementation-----------
     /**
      * @name MacToPhyInterface implementation
@@ -415,8 +581,17 @@ public:
     /** Return the number of channels available on this radio. */
     int getNbRadioChannels() override;
 
+    /** Take back a control message previously sent to the mac and keep it for reuse. */
+    void recycleControlMsg(cMessage* msg) override;
+
+    /** Return intraNicDispatcher if directIntraNicDelivery is set, nullptr otherwise. */
+    IntraNicDispatcher* getIntraNicDispatcher() override;
+
     /*@}*/
 
+    /** Handle a message the mac passed by intraNicDispatcher, as if it had arrived at upperLayerIn (or upperControlIn). */
+    void receiveFromNic(cMessage* msg, bool control) override;
+
     // ---------DeciderToPhyInterface implementation-----------
     /**
      * @name DeciderToPhyInterface implementation
@@ -429,6 +604,17 @@ public:
      */
     void getChannelInfo(simtime_t_cref from, simtime_t_cref to, AirFrameVector& out) override;
 
+    /**
+     * Fill the given AirFrameVector with the AirFrames that intersect with the given time interval,
+     * leaving out those of other bands if partitionChannelInfo is set.
+     */
+    void getChannelInfoInBand(simtime_t_cref from, simtime_t_cref to, double freqLow, double freqHigh, AirFrameVector& out) override;
+
+    /**
+     * Return the largest aggregated far field interference (in mW) at the given frequency during the given time interval.
+     */
+    double getFarFieldInterference(simtime_t_cref from, simtime_t_cref to, double frequency) override;
+
     /**
      * Return noise floor level (in mW).
      */
@@ -441,6 +627,11 @@ public:
      */
     void sendControlMsgToMac(cMessage* msg) override;
 
+    /**
+     * Return a control message for sendControlMsgToMac, recycled from controlMessagePool if possible.
+     */
+    cMessage* createControlMsg(const char* name, short kind) override;
+
     /**
      * Pass the given packet along with the result up to the mac.
      */
@@ -23,9 +23,11 @@
 //
 
 #include "veins/base/phyLayer/ChannelInfo.h"
-
+#include <algorithm>
 #include <iostream>
 
+#include "veins/base/utils/MemoryAccounting.h"
+
 using namespace veins;
 
 using veins::AirFrame;
@@ -44,36 +46,22 @@ void ChannelInfo::addAirFrame(AirFrame* frame, simtime_t_cref startTime)
     simtime_t_cref endTime = startTime + frame->getDuration();
 
     // add AirFrame to active AirFrames
-    activeAirFrames[endTime].push_back(AirFrameTimePair(startTime, frame));
+    const AirFrameEntry entry{startTime, endTime, frame, nextSequence++};
+    insertAirFrame(activeAirFrames, entry);
+    if (partitionedByBand) insertAirFrame(bands[bandOf(frame)].activeAirFrames, entry);
 
-    // add to start time map
+    // add to start time maps
     airFrameStarts[frame] = startTime;
+    airFrameStartTimes.insert(startTime);
 
     ASSERT(!isChannelEmpty());
 }
 
 simtime_t ChannelInfo::findEarliestInfoPoint()
 {
-    // TODO: check for a more efficient way to find out that earliest time-point
-
-    // make a variable for the earliest-start-time of all remaining AirFrames
-    simtime_t earliestStart = SIMTIME_ZERO;
-    AirFrameStartMap::const_iterator it = airFrameStarts.begin();
-
-    // if there is an entry for an AirFrame
-    if (it != airFrameStarts.end()) {
-        // store the start-time of the first entry as earliestStart so far
-        earliestStart = (*it).second;
-
-        // go through all other start-time-points
-        for (; it != airFrameStarts.end(); ++it) {
-            // and check if an earlier start-time was found,
-            // if so, replace earliestStart with it
-            if ((*it).second < earliestStart) earliestStart = (*it).second;
-        }
-    }
+    if (airFrameStartTimes.empty()) return SIMTIME_ZERO;
 
-    return earliestStart;
+    return *airFrameStartTimes.begin();
 }
 
 simtime_t ChannelInfo::removeAirFrame(AirFrame* frame)
@@ -81,13 +69,14 @@ simtime_t ChannelInfo::removeAirFrame(AirFrame* frame)
     ASSERT(airFrameStarts.count(frame) > 0);
 
     // get start of AirFrame
-    simtime_t_cref startTime = airFrameStarts[frame];
+    simtime_t startTime = airFrameStarts[frame];
 
     // calculate end time
-    simtime_t_cref endTime = startTime + frame->getDuration();
+    simtime_t endTime = startTime + frame->getDuration();
 
     // remove this AirFrame from active AirFrames
     deleteAirFrame(activeAirFrames, frame, startTime, endTime);
+    if (partitionedByBand) deleteAirFrame(bands[bandOf(frame)].activeAirFrames, frame, startTime, endTime);
 
     // add to inactive AirFrames
     addToInactives(frame, startTime, endTime);
@@ -106,37 +95,28 @@ simtime_t ChannelInfo::removeAirFrame(AirFrame* frame)
 
 void ChannelInfo::assertNoIntersections()
 {
-    for (AirFrameMatrix::iterator it1 = inactiveAirFrames.begin(); it1 != inactiveAirFrames.end(); ++it1) {
-        simtime_t_cref e0 = it1->first;
-        for (AirFrameTimeList::iterator it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
-            simtime_t_cref s0 = it2->first;
-
-            bool intersects = (recordStartTime > -1 && recordStartTime <= e0);
-
-            for (AirFrameMatrix::iterator it3 = activeAirFrames.begin(); it3 != activeAirFrames.end() && !intersects; ++it3) {
-                simtime_t_cref e1 = it3->first;
-                for (AirFrameTimeList::iterator it4 = it3->second.begin(); it4 != it3->second.end() && !intersects; ++it4) {
-                    simtime_t_cref s1 = it4->first;
+    for (auto&& inactive : inactiveAirFrames) {
+        bool intersects = (recordStartTime > -1 && recordStartTime <= inactive.endTime);
 
-                    if (e0 >= s1 && s0 <= e1) intersects = true;
-                }
-            }
-            ASSERT(intersects);
+        for (auto it = activeAirFrames.begin(); it != activeAirFrames.end() && !intersects; ++it) {
+            if (inactive.endTime >= it->startTime && inactive.startTime <= it->endTime) intersects = true;
         }
+        ASSERT(intersects);
     }
 }
 
-void ChannelInfo::deleteAirFrame(AirFrameMatrix& airFrames, AirFrame* frame, simtime_t_cref startTime, simtime_t_cref endTime)
+void ChannelInfo::insertAirFrame(AirFrameList& airFrames, const AirFrameEntry& entry)
 {
-    AirFrameMatrix::iterator listIt = airFrames.find(endTime);
-    AirFrameTimeList* list = &listIt->second;
+    // insert behind all AirFrames ending at the same time (or earlier)
+    auto it = std::upper_bound(airFrames.begin(), airFrames.end(), entry.endTime, [](simtime_t_cref time, const AirFrameEntry& other) { return time < other.endTime; });
+    airFrames.insert(it, entry);
+}
 
-    for (AirFrameTimeList::iterator it = list->begin(); it != list->end(); it++) {
-        if (it->second == frame) {
-            it = list->erase(it);
-            if (list->empty()) {
-                airFrames.erase(listIt);
-            }
+void ChannelInfo::deleteAirFrame(AirFrameList& airFrames, AirFrame* frame, simtime_t_cref startTime, simtime_t_cref endTime)
+{
+    for (auto it = firstEndingNotBefore(airFrames, endTime); it != airFrames.end() && it->endTime == endTime; ++it) {
+        if (it->frame == frame) {
+            airFrames.erase(it);
             return;
         }
     }
@@ -144,6 +124,27 @@ void ChannelInfo::deleteAirFrame(AirFrameMatrix& airFrames, AirFrame* frame, sim
     ASSERT(false);
 }
 
+void ChannelInfo::compactAirFrame(AirFrame* frame)
+{
+    if (frame->getEncapsulatedPacket()) {
+        cPacket* packet = frame->decapsulate();
+        compactedBytes += packet->getByteLength();
+        delete packet;
+    }
+    frame->setPoa(POA());
+}
+
+void ChannelInfo::discardAirFrame(AirFrame* frame)
+{
+    auto startIt = airFrameStarts.find(frame);
+    ASSERT(startIt != airFrameStarts.end());
+
+    airFrameStartTimes.erase(airFrameStartTimes.find(startIt->second));
+    airFrameStarts.erase(startIt);
+
+    delete frame;
+}
+
 bool ChannelInfo::canDiscardInterval(simtime_t_cref startTime, simtime_t_cref endTime)
 {
     ASSERT(recordStartTime >= 0 || recordStartTime == -1);
@@ -156,25 +157,20 @@ bool ChannelInfo::canDiscardInterval(simtime_t_cref startTime, simtime_t_cref en
 
 void ChannelInfo::checkAndCleanInterval(simtime_t_cref startTime, simtime_t_cref endTime)
 {
-
-    // get through inactive AirFrame which intersected with the passed interval
-    IntersectionIterator inactiveIntersectIt(&inactiveAirFrames, startTime, endTime);
-
-    AirFrame* inactiveIntersect = inactiveIntersectIt.next();
-    while (inactiveIntersect != nullptr) {
-        simtime_t_cref currentStart = airFrameStarts[inactiveIntersect];
-        simtime_t_cref currentEnd = currentStart + inactiveIntersect->getDuration();
-
-        if (canDiscardInterval(currentStart, currentEnd)) {
-            inactiveIntersectIt.eraseAirFrame();
-
-            airFrameStarts.erase(inactiveIntersect);
-
-            delete inactiveIntersect;
-            inactiveIntersect = nullptr;
+    // go through inactive AirFrames which intersect with the passed interval,
+    // compacting the list in place while discarding AirFrames no longer needed
+    auto first = inactiveAirFrames.begin() + (firstEndingNotBefore(inactiveAirFrames, startTime) - inactiveAirFrames.cbegin());
+    auto kept = first;
+    for (auto it = first; it != inactiveAirFrames.end(); ++it) {
+        if (it->startTime <= endTime && canDiscardInterval(it->startTime, it->endTime)) {
+            if (partitionedByBand) deleteAirFrame(bands[bandOf(it->frame)].inactiveAirFrames, it->frame, it->startTime, it->endTime);
+            discardAirFrame(it->frame);
+            continue;
         }
-        inactiveIntersect = inactiveIntersectIt.next();
+        if (kept != it) *kept = *it;
+        ++kept;
     }
+    inactiveAirFrames.erase(kept, inactiveAirFrames.end());
 }
 
 void ChannelInfo::addToInactives(AirFrame* frame, simtime_t_cref startTime, simtime_t_cref endTime)
@@ -184,29 +180,33 @@ void ChannelInfo::addToInactives(AirFrame* frame, simtime_t_cref startTime, simt
     checkAndCleanInterval(startTime, endTime);
 
     if (!canDiscardInterval(startTime, endTime)) {
-        inactiveAirFrames[endTime].push_back(AirFrameTimePair(startTime, frame));
+        if (compactingInactive) compactAirFrame(frame);
+        const AirFrameEntry entry{startTime, endTime, frame, nextSequence++};
+        insertAirFrame(inactiveAirFrames, entry);
+        if (partitionedByBand) insertAirFrame(bands[bandOf(frame)].inactiveAirFrames, entry);
     }
     else {
-        airFrameStarts.erase(frame);
-
-        delete frame;
+        discardAirFrame(frame);
     }
 }
 
-bool ChannelInfo::isIntersecting(const AirFrameMatrix& airFrames, simtime_t_cref from, simtime_t_cref to) const
+ChannelInfo::AirFrameList::const_iterator ChannelInfo::firstEndingNotBefore(const AirFrameList& airFrames, simtime_t_cref from)
 {
-    ConstIntersectionIterator it(&airFrames, from, to);
-    return (it.next() != nullptr);
+    return std::lower_bound(airFrames.begin(), airFrames.end(), from, [](const AirFrameEntry& entry, simtime_t_cref time) { return entry.endTime < time; });
 }
 
-void ChannelInfo::getIntersections(const AirFrameMatrix& airFrames, simtime_t_cref from, simtime_t_cref to, AirFrameVector& outVector) const
+bool ChannelInfo::isIntersecting(const AirFrameList& airFrames, simtime_t_cref from, simtime_t_cref to) const
 {
-    ConstIntersectionIterator it(&airFrames, from, to);
+    for (auto it = firstEndingNotBefore(airFrames, from); it != airFrames.end(); ++it) {
+        if (it->startTime <= to) return true;
+    }
+    return false;
+}
 
-    AirFrame* intersect = it.next();
-    while (intersect != nullptr) {
-        outVector.push_back(intersect);
-        intersect = it.next();
+void ChannelInfo::getIntersections(const AirFrameList& airFrames, simtime_t_cref from, simtime_t_cref to, AirFrameVector& outVector) const
+{
+    for (auto it = firstEndingNotBefore(airFrames, from); it != airFrames.end(); ++it) {
+        if (it->startTime <= to) outVector.push_back(it->frame);
     }
 }
 
@@ -218,3 +218,53 @@ void ChannelInfo::getAirFrames(simtime_t_cref from, simtime_t_cref to, AirFrameV
     // check for intersecting active AirFrames
     getIntersections(activeAirFrames, from, to, out);
 }
+
+void ChannelInfo::getAirFrames(simtime_t_cref from, simtime_t_cref to, size_t freqIndexLow, size_t freqIndexHigh, AirFrameVector& out) const
+{
+    if (!partitionedByBand) {
+        getAirFrames(from, to, out);
+        return;
+    }
+
+    getBandIntersections(&Band::inactiveAirFrames, from, to, freqIndexLow, freqIndexHigh, out);
+    getBandIntersections(&Band::activeAirFrames, from, to, freqIndexLow, freqIndexHigh, out);
+}
+
+void ChannelInfo::getBandIntersections(AirFrameList Band::*airFrames, simtime_t_cref from, simtime_t_cref to, size_t freqIndexLow, size_t freqIndexHigh, AirFrameVector& outVector) const
+{
+    std::vector<const AirFrameEntry*> intersections;
+    for (auto&& band : bands) {
+        if (band.first.first >= freqIndexHigh || band.first.second <= freqIndexLow) continue;
+        const AirFrameList& bandAirFrames = band.second.*airFrames;
+        for (auto it = firstEndingNotBefore(bandAirFrames, from); it != bandAirFrames.end(); ++it) {
+            if (it->startTime <= to) intersections.push_back(&*it);
+        }
+    }
+
+    // restore the order of the unpartitioned list: by end time, then by the order the AirFrames were added
+    std::sort(intersections.begin(), intersections.end(), [](const AirFrameEntry* a, const AirFrameEntry* b) { return a->endTime < b->endTime || (a->endTime == b->endTime && a->sequence < b->sequence); });
+    for (auto entry : intersections) {
+        outVector.push_back(entry->frame);
+    }
+}
+
+ChannelInfo::BandKey ChannelInfo::bandOf(AirFrame* frame)
+{
+    const Signal& signal = frame->getSignal();
+    return BandKey(signal.getDataStart(), signal.getDataEnd());
+}
+
+size_t ChannelInfo::getBytesUsed() const
+{
+    size_t bytes = MemoryAccounting::bytesOf(activeAirFrames) + MemoryAccounting::bytesOf(inactiveAirFrames);
+    for (auto&& band : bands) {
+        bytes += MemoryAccounting::bytesOf(band.second.activeAirFrames) + MemoryAccounting::bytesOf(band.second.inactiveAirFrames);
+    }
+    bytes += MemoryAccounting::bytesOfNodes(bands) + MemoryAccounting::bytesOfNodes(airFrameStarts) + airFrameStarts.bucket_count() * sizeof(void*) + MemoryAccounting::bytesOfNodes(airFrameStartTimes);
+    for (auto&& entry : airFrameStarts) {
+        // Signals keep up to 16 values inline, see Signal::values
+        const size_t numValues = entry.first->getConstSignal().getNumValues();
+        bytes += sizeof(AirFrame) + (numValues > 16 ? numValues * sizeof(double) : 0);
+    }
+    return bytes;
+}
@@ -25,6 +25,10 @@
 #pragma once
 
 #include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "veins/veins.h"
 
@@ -61,188 +65,52 @@ namespace veins {
  *          This also affects "getAirFrames" in the way that you may only ask for
  *          intervals which lie before the "current time" of ChannelInfo.
  *
+ * Optionally, ChannelInfo additionally partitions the AirFrames by the band
+ * (range of spectrum indices) their signal occupies, so that queries for a
+ * part of the spectrum only visit AirFrames of overlapping bands (see
+ * setPartitionedByBand()).
+ *
+ * Optionally, AirFrames that are over but kept for interference are
+ * compacted to what queries need: their payload and POA are deleted right
+ * away, only the AirFrame with its Signal (timing, spectrum and power
+ * values) is kept (see setCompactingInactive()).
+ *
  * @ingroup phyLayer
  */
 class VEINS_API ChannelInfo {
 
 protected:
-    /** @brief Type for a pair of an AirFrame and a simulation time.*/
-    typedef std::pair<simtime_t, AirFrame*> AirFrameTimePair;
-    /** @brief Type for a list of AirFrames and a simulation time.*/
-    using AirFrameTimeList = std::list<AirFrameTimePair>;
-    /**
-     * The AirFrames are stored in a Matrix with start- and end time as
-     * dimensions.
-     */
-    typedef std::map<simtime_t, AirFrameTimeList> AirFrameMatrix;
+    /** @brief An AirFrame together with the interval it occupies the channel.*/
+    struct AirFrameEntry {
+        simtime_t startTime;
+        simtime_t endTime;
+        AirFrame* frame;
+        uint64_t sequence; ///< Position in the order the entries were added, to restore the order of a list from its partitions.
+    };
 
     /**
-     * @brief Iterator for every intersection of a specific interval in a
-     * AirFrameMatrix.
+     * @brief Contiguous list of AirFrames, sorted by end time.
+     *
+     * AirFrames with the same end time are kept in the order they were added.
      *
      * A time interval A_start to A_end intersects with another interval B_start
      * to B_end iff the following two conditions are fulfilled:
      *
      *         1. A_end >= B_start.
-     *         2. A_start <= B_end and
+     *         2. A_start <= B_end
      *
-     * Or the defined by the
-     * opposite: The two intervals do not intersect iff A_end < B_start or
-     * A_start > B_end.
-     *
-     * To iterate over a two dimensional (end-time x start-time) container
-     * of AirFrames this class iterates over all AirFrame-lists whose end-time
-     * is bigger or equal than the interval start (intersect condition 1) and in
-     * each of these lists iterates over all entries but only stops at and
-     * returns entries which start-time is smaller or equal than the interval
-     * end (intersection condition 2).
-     *
-     * In template form to work as const- and non-const iterator.
-     */
-    template <class C, class ItMatrix, class ItList>
-    class VEINS_API BaseIntersectionIterator {
-    public:
-        /** @brief Pointer to the matrix holding the intervals.*/
-        C* intervals;
-
-        /** @brief Point in time to start iterating over intersections.*/
-        simtime_t from;
-
-        /** @brief Point in time to end iterating over intersections.*/
-        simtime_t to;
-
-        /** @brief Iterator over AirFrame end times.*/
-        ItMatrix endIt;
-
-        /** @brief Iterator over AirFrame start times.*/
-        ItList startIt;
-
-        /** @brief True if the we are already pointing to the next entry.*/
-        bool alreadyNext;
-
-    public:
-        /**
-         * @brief Creates an iterator for the specified interval at the
-         * specified AirFrameMatrix.
-         */
-        BaseIntersectionIterator(C* airFrames, simtime_t_cref from, simtime_t_cref to)
-            : intervals(airFrames)
-            , from(from)
-            , to(to)
-        {
-            // begin at the smallest end-time-entry fulfilling the intersection
-            // condition 1
-            endIt = intervals->lower_bound(from);
-
-            if (endIt != intervals->end()) {
-                startIt = endIt->second.begin();
-            }
-            // we are already pointing at the first unchecked interval
-            alreadyNext = true;
-        }
-
-        /**
-         * @brief Increases the iterator to the next intersecting AirFrame and
-         * returns a pointer to this AirFrame.
-         */
-        AirFrame* next()
-        {
-            if (endIt == intervals->end()) return nullptr;
-
-            // "alreadyNext" indicates that some previous iterator function has
-            // already increased the intern iterators to a yet unchecked values.
-            // This happens after initialization of the iterator and when an
-            // element is erased.
-            if (alreadyNext)
-                alreadyNext = false;
-            else
-                startIt++;
-
-            while (endIt != intervals->end()) {
-                // while there are entries left at the current end-time
-                while (startIt != endIt->second.end()) {
-                    // check if this entry fulfilles the intersection condition
-                    // 2 (condition 1 is already fulfilled in the constructor by
-                    // the start-value of the end-time-iterator)
-                    if (startIt->first <= to) {
-                        return startIt->second;
-                    }
-                    startIt++;
-                }
-
-                endIt++;
-                if (endIt == intervals->end()) return nullptr;
-
-                startIt = endIt->second.begin();
-            }
-
-            return nullptr;
-        }
-    };
-
-    /** @brief Type for a const-iterator over an AirFrame interval matrix.*/
-    typedef BaseIntersectionIterator<const AirFrameMatrix, AirFrameMatrix::const_iterator, AirFrameTimeList::const_iterator> ConstIntersectionIterator;
-
-    /**
-     * @brief Type for a iterator over an AirFrame interval matrix.
-     *
-     * Extends the const-version by an erase method.
-     */
-    class VEINS_API IntersectionIterator : public BaseIntersectionIterator<AirFrameMatrix, AirFrameMatrix::iterator, AirFrameTimeList::iterator> {
-    private:
-        /** @brief Type for shortcut to base class type.*/
-        typedef BaseIntersectionIterator<AirFrameMatrix, AirFrameMatrix::iterator, AirFrameTimeList::iterator> Base;
-
-    public:
-        /**
-         * @brief Creates an iterator for the specified interval at the
-         * specified AirFrameMatrix.
-         */
-        IntersectionIterator(AirFrameMatrix* airFrames, simtime_t_cref from, simtime_t_cref to)
-            : Base(airFrames, from, to)
-        {
-        }
-
-        /**
-         * @brief Erases the AirFrame the iterator currently points to from the
-         * AirFrameMatrix.
-         *
-         * After the erase the iterator points to an invalid value and "next()"
-         * should be called.
-         */
-        void eraseAirFrame()
-        {
-            ASSERT(endIt != intervals->end());
-            ASSERT(startIt != endIt->second.end());
-
-            // erase AirFrame from list
-            startIt = endIt->second.erase(startIt);
-
-            // check if we've deleted the last entry in the list
-            if (startIt == endIt->second.end()) {
-                // check if we deleted the only entry in the list
-                if (endIt->second.empty()) {
-                    intervals->erase(endIt++); // delete list from map
-                }
-                else {
-                    endIt++;
-                }
-
-                // increase to a valid value if we are not done
-                if (endIt != intervals->end()) {
-                    startIt = endIt->second.begin();
-                }
-            }
-            alreadyNext = true;
-        }
-    };
+     * So all AirFrames intersecting with an interval are found by a binary
+     * search for the first AirFrame fulfilling condition 1, followed by a
+     * linear scan checking condition 2.
+     */
+    using AirFrameList = std::vector<AirFrameEntry>;
 
     /**
      * @brief Stores the currently active AirFrames.
      *
      * This means every AirFrame which was added but not yet removed.
      */
-    AirFrameMatrix activeAirFrames;
+    AirFrameList activeAirFrames;
 
     /**
      * @brief Stores inactive AirFrames.
@@ -250,14 +118,41 @@ protected:
      * This means every AirFrame which has been already removed but still is
      * needed because it intersect with one or more active AirFrames.
      */
-    AirFrameMatrix inactiveAirFrames;
+    AirFrameList inactiveAirFrames;
+
+    /** @brief The active and inactive AirFrames whose signal occupies one band.*/
+    struct Band {
+        AirFrameList activeAirFrames;
+        AirFrameList inactiveAirFrames;
+    };
+
+    /** @brief Type for a band of the spectrum, given by its first and one past its last spectrum index.*/
+    using BandKey = std::pair<size_t, size_t>;
+
+    /** @brief Stores if AirFrames are partitioned into bands.*/
+    bool partitionedByBand = false;
+
+    /** @brief The AirFrames of activeAirFrames and inactiveAirFrames, partitioned by band (if partitionedByBand is set).*/
+    std::map<BandKey, Band> bands;
+
+    /** @brief Stores if AirFrames that are over are compacted when they are kept as inactive AirFrames.*/
+    bool compactingInactive = false;
+
+    /** @brief Number of bytes of payload deleted when compacting inactive AirFrames so far.*/
+    uint64_t compactedBytes = 0;
+
+    /** @brief Sequence number of the next AirFrameEntry to add.*/
+    uint64_t nextSequence = 0;
 
     /** @brief Type for a map of AirFrame pointers to their start time.*/
-    typedef std::map<AirFrame*, simtime_t> AirFrameStartMap;
+    using AirFrameStartMap = std::unordered_map<AirFrame*, simtime_t>;
 
     /** @brief Stores the start time of every AirFrame.*/
     AirFrameStartMap airFrameStarts;
 
+    /** @brief Stores the start times of all AirFrames (active and inactive), to find the earliest one quickly.*/
+    std::multiset<simtime_t> airFrameStartTimes;
+
     /** @brief Stores the point in history up to which we have some (but not
      * necessarily all) channel information stored.*/
     simtime_t earliestInfoPoint;
@@ -282,19 +177,38 @@ protected:
     void assertNoIntersections();
 
     /**
-     * @brief Returns every AirFrame of an AirFrameMatrix which intersect with a
+     * @brief Returns every AirFrame of an AirFrameList which intersect with a
      * given interval.
      *
      * The intersecting AirFrames are stored in the AirFrameVector reference
      * passed as parameter.
      */
-    void getIntersections(const AirFrameMatrix& airFrames, simtime_t_cref from, simtime_t_cref to, AirFrameVector& outVector) const;
+    void getIntersections(const AirFrameList& airFrames, simtime_t_cref from, simtime_t_cref to, AirFrameVector& outVector) const;
+
+    /**
+     * @brief Like getIntersections(), but for the list selected by airFrames of all bands overlapping with the
+     * spectrum indices [freqIndexLow, freqIndexHigh).
+     *
+     * The AirFrames are returned in the same order as getIntersections() on the unpartitioned list.
+     */
+    void getBandIntersections(AirFrameList Band::*airFrames, simtime_t_cref from, simtime_t_cref to, size_t freqIndexLow, size_t freqIndexHigh, AirFrameVector& outVector) const;
+
+    /**
+     * @brief Returns the band of the signal of the passed AirFrame.
+     */
+    static BandKey bandOf(AirFrame* a);
 
     /**
      * @brief Returns true if there is at least one AirFrame in the passed
-     * AirFrameMatrix which intersect with the given interval.
+     * AirFrameList which intersect with the given interval.
      */
-    bool isIntersecting(const AirFrameMatrix& airFrames, simtime_t_cref from, simtime_t_cref to) const;
+    bool isIntersecting(const AirFrameList& airFrames, simtime_t_cref from, simtime_t_cref to) const;
+
+    /**
+     * @brief Returns the first AirFrame of the passed AirFrameList which could
+     * intersect with an interval starting at the passed time (i.e., which does not end before).
+     */
+    static AirFrameList::const_iterator firstEndingNotBefore(const AirFrameList& airFrames, simtime_t_cref from);
 
     /**
      * @brief Moves a previously active AirFrame to the inactive AirFrames.
@@ -308,9 +222,26 @@ protected:
     void addToInactives(AirFrame* a, simtime_t_cref startTime, simtime_t_cref endTime);
 
     /**
-     * @brief Deletes an AirFrame from an AirFrameMatrix.
+     * @brief Inserts an AirFrame into an AirFrameList, keeping it sorted.
      */
-    void deleteAirFrame(AirFrameMatrix& airFrames, AirFrame* a, simtime_t_cref startTime, simtime_t_cref endTime);
+    void insertAirFrame(AirFrameList& airFrames, const AirFrameEntry& entry);
+
+    /**
+     * @brief Deletes everything of an AirFrame that is over which interference queries do not need: its encapsulated packet (unless already handed up) and its POA.
+     *
+     * The AirFrame itself (and thus its tree id and Signal) is kept, so it can still be told apart from and compared with other AirFrames.
+     */
+    void compactAirFrame(AirFrame* a);
+
+    /**
+     * @brief Deletes an AirFrame from an AirFrameList.
+     */
+    void deleteAirFrame(AirFrameList& airFrames, AirFrame* a, simtime_t_cref startTime, simtime_t_cref endTime);
+
+    /**
+     * @brief Forgets about an AirFrame that is neither active nor inactive anymore and deletes it.
+     */
+    void discardAirFrame(AirFrame* a);
 
     /**
      * @brief Returns the start time of the odlest AirFrame on the channel.
@@ -355,7 +286,7 @@ protected:
         if (inactiveAirFrames.empty()) return;
 
         // take last ended inactive airframe as end of interval
-        checkAndCleanInterval(start, inactiveAirFrames.rbegin()->first);
+        checkAndCleanInterval(start, inactiveAirFrames.back().endTime);
     }
 
 public:
@@ -401,6 +332,51 @@ public:
      */
     void getAirFrames(simtime_t_cref from, simtime_t_cref to, AirFrameVector& out) const;
 
+    /**
+     * @brief Like the above, but may leave out AirFrames whose signal has no
+     * power at the spectrum indices [freqIndexLow, freqIndexHigh).
+     *
+     * If the AirFrames are partitioned by band, only the AirFrames of bands
+     * overlapping with the given range are returned. Otherwise, this returns
+     * all AirFrames intersecting with the given time interval.
+     */
+    void getAirFrames(simtime_t_cref from, simtime_t_cref to, size_t freqIndexLow, size_t freqIndexHigh, AirFrameVector& out) const;
+
+    /**
+     * @brief Sets if AirFrames are partitioned by the band their signal occupies.
+     *
+     * May only be changed while the channel is empty.
+     */
+    void setPartitionedByBand(bool partitioned)
+    {
+        ASSERT(isChannelEmpty());
+        partitionedByBand = partitioned;
+    }
+
+    /**
+     * @brief Sets if AirFrames that are over are compacted (see compactAirFrame()) when they are kept as inactive AirFrames.
+     */
+    void setCompactingInactive(bool compacting)
+    {
+        compactingInactive = compacting;
+    }
+
+    /**
+     * @brief Returns if AirFrames that are over are compacted when they are kept as inactive AirFrames.
+     */
+    bool isCompactingInactive() const
+    {
+        return compactingInactive;
+    }
+
+    /**
+     * @brief Returns the number of bytes of payload deleted when compacting inactive AirFrames so far.
+     */
+    uint64_t getCompactedBytes() const
+    {
+        return compactedBytes;
+    }
+
     /**
      * @brief Returns the current time-point from that information concerning
      * AirFrames is needed to be stored.
@@ -462,6 +438,19 @@ public:
         return recordStartTime > -1;
     }
 
+    /**
+     * @brief Returns the number of (active and inactive) AirFrames currently stored.
+     */
+    size_t getNumAirFrames() const
+    {
+        return airFrameStarts.size();
+    }
+
+    /**
+     * @brief Estimates the bytes held by the stored AirFrames and the lists indexing them, see MemoryAccounting.
+     */
+    size_t getBytesUsed() const;
+
     /**
      * @brief Returns true if there are currently no active or inactive
      * AirFrames on the channel.
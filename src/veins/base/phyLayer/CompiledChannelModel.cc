@@ -0,0 +1,150 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/phyLayer/CompiledChannelModel.h"
+
+#include <algorithm>
+
+#include "veins/base/toolbox/Signal.h"
+
+using namespace veins;
+
+CompiledChannelModel::CompiledChannelModel(const AnalogueModelList& models)
+{
+    for (const auto& model : models) {
+        stages.push_back({model.get(), model->getKernel()});
+    }
+}
+
+void CompiledChannelModel::filterSignal(Signal* signal, const LinkGeometry& link)
+{
+    const Spectrum& spectrum = signal->getSpectrum();
+    const size_t numValues = signal->getNumValues();
+    // there is no power outside of the filter window
+    const size_t from = signal->getFilterStart();
+    const size_t to = signal->getFilterEnd();
+
+    size_t i = 0;
+    while (i < stages.size()) {
+        if (stages[i].kernel.isEmpty()) {
+            stages[i].model->filterSignal(signal);
+            ++i;
+            continue;
+        }
+
+        // evaluate the run of models with kernels starting here
+        const double signalMax = signal->getMax();
+        double factor = 1;
+        bool hasMultiply = false;
+        for (; i < stages.size() && !stages[i].kernel.isEmpty(); ++i) {
+            const AnalogueModelKernel& kernel = stages[i].kernel;
+            if (kernel.factor) {
+                factor *= kernel.factor(*stages[i].model, link, signalMax);
+            }
+            else {
+                if (!hasMultiply) attenuation.assign(numValues, 1.0);
+                hasMultiply = true;
+                kernel.multiply(*stages[i].model, link, spectrum, from, to, attenuation.data());
+            }
+        }
+
+        if (hasMultiply) {
+            Signal::Value* values = signal->getValues();
+            for (size_t j = from; j < to; ++j) {
+                values[j] *= attenuation[j] * factor;
+            }
+        }
+        else {
+            *signal *= factor;
+        }
+    }
+}
+
+void CompiledChannelModel::filterSignals(Signal* const* signals, const LinkGeometry* const* links, size_t count)
+{
+    if (count == 0) return;
+
+    const Spectrum& spectrum = signals[0]->getSpectrum();
+    const size_t numValues = signals[0]->getNumValues();
+    for (size_t r = 1; r < count; ++r) {
+        if (!(signals[r]->getSpectrum() == spectrum)) {
+            for (size_t k = 0; k < count; ++k) filterSignal(signals[k], *links[k]);
+            return;
+        }
+    }
+
+    size_t i = 0;
+    while (i < stages.size()) {
+        if (stages[i].kernel.isEmpty()) {
+            for (size_t r = 0; r < count; ++r) {
+                stages[i].model->filterSignal(signals[r]);
+            }
+            ++i;
+            continue;
+        }
+
+        // evaluate the run of models with kernels starting here, one model for all links at a time
+        size_t runEnd = i;
+        bool hasMultiply = false;
+        for (; runEnd < stages.size() && !stages[runEnd].kernel.isEmpty(); ++runEnd) {
+            if (!stages[runEnd].kernel.factor) hasMultiply = true;
+        }
+        batchFactors.assign(count, 1.0);
+        batchSignalMax.resize(count);
+        for (size_t r = 0; r < count; ++r) batchSignalMax[r] = signals[r]->getMax();
+        if (hasMultiply) batchAttenuation.assign(count * numValues, 1.0);
+
+        for (; i < runEnd; ++i) {
+            const AnalogueModelKernel& kernel = stages[i].kernel;
+            AnalogueModel& model = *stages[i].model;
+            if (kernel.factor) {
+                for (size_t r = 0; r < count; ++r) {
+                    batchFactors[r] *= kernel.factor(model, *links[r], batchSignalMax[r]);
+                }
+            }
+            else {
+                for (size_t r = 0; r < count; ++r) {
+                    kernel.multiply(model, *links[r], spectrum, signals[r]->getFilterStart(), signals[r]->getFilterEnd(), batchAttenuation.data() + r * numValues);
+                }
+            }
+        }
+
+        // multiply each signal once, like filterSignal()
+        for (size_t r = 0; r < count; ++r) {
+            if (hasMultiply) {
+                const double* signalAttenuation = batchAttenuation.data() + r * numValues;
+                Signal::Value* values = signals[r]->getValues();
+                for (size_t j = signals[r]->getFilterStart(); j < signals[r]->getFilterEnd(); ++j) {
+                    values[j] *= signalAttenuation[j] * batchFactors[r];
+                }
+            }
+            else {
+                *signals[r] *= batchFactors[r];
+            }
+        }
+    }
+}
+
+size_t CompiledChannelModel::getNumFusedModels() const
+{
+    return std::count_if(stages.begin(), stages.end(), [](const Stage& stage) { return !stage.kernel.isEmpty(); });
+}
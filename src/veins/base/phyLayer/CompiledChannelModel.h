@@ -0,0 +1,88 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/phyLayer/AnalogueModel.h"
+#include "veins/base/utils/LinkGeometry.h"
+
+namespace veins {
+
+/**
+ * @brief A list of analogue models, compiled for applying them to signals as one fused kernel.
+ *
+ * Runs of consecutive models that provide an AnalogueModelKernel are evaluated together:
+ * they share the geometry of the link, accumulate their attenuation in one vector (and one factor for frequency independent models),
+ * and the signal is multiplied only once per run.
+ * Models without a kernel are applied on their own, by AnalogueModel::filterSignal, in their place in the list.
+ *
+ * The result equals applying every model by AnalogueModel::filterSignal, up to rounding.
+ *
+ * @ingroup analogueModels
+ */
+class VEINS_API CompiledChannelModel {
+public:
+    CompiledChannelModel() = default;
+
+    /**
+     * Compiles models, in the order they are to be applied; they must outlive this instance.
+     */
+    explicit CompiledChannelModel(const AnalogueModelList& models);
+
+    /**
+     * Applies all models to signal, sent over link.
+     */
+    void filterSignal(Signal* signal, const LinkGeometry& link);
+
+    /**
+     * Applies all models to each of count signals, sent over the link of the same index.
+     *
+     * Evaluates each model for all links before the next one, with the links, factors and attenuation vectors
+     * of the batch laid out contiguously. The result equals calling filterSignal() for each signal (exactly, not only up to rounding),
+     * as long as the models without a kernel do not depend on the order they are applied to different signals in.
+     * All signals need to share one spectrum, otherwise they are filtered one by one.
+     */
+    void filterSignals(Signal* const* signals, const LinkGeometry* const* links, size_t count);
+
+    /**
+     * Returns the number of models evaluated by their kernel.
+     */
+    size_t getNumFusedModels() const;
+
+protected:
+    struct Stage {
+        AnalogueModel* model;
+        AnalogueModelKernel kernel;
+    };
+
+    std::vector<Stage> stages;
+    std::vector<double> attenuation; /**< attenuation per frequency of the current run of fused models (kept to reuse its storage) */
+    std::vector<double> batchAttenuation; /**< like attenuation, for each signal of a batch in turn (kept to reuse its storage) */
+    std::vector<double> batchFactors; /**< frequency independent attenuation of the current run of fused models, per signal of a batch */
+    std::vector<double> batchSignalMax; /**< maximum power level of each signal of a batch before the current run of fused models */
+};
+
+} // namespace veins
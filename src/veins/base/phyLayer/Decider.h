@@ -78,6 +78,9 @@ public:
  *
  * BasePhyLayer hands every receiving AirFrame several times to the
  * "processSignal()"-function and is returned a time point when to do so again.
+ * Deciders that only look at the start and end of AirFrames declare so by
+ * overriding needsIntermediateProcessing(), limiting every reception to
+ * one start and one end event.
  *
  * @ingroup decider
  */
@@ -108,6 +111,30 @@ public:
      */
     virtual simtime_t processSignal(AirFrame* frame);
 
+    /**
+     * @brief Returns whether processSignal() may ask to be passed an AirFrame
+     * again before its end.
+     *
+     * If false, processSignal() must return either notAgain or the end of the
+     * AirFrame, which BasePhyLayer enforces.
+     */
+    virtual bool needsIntermediateProcessing() const
+    {
+        return true;
+    }
+
+    /**
+     * @brief Returns whether this Decider looks at other AirFrames on the
+     * channel (see DeciderToPhyInterface::getChannelInfo()).
+     *
+     * If false, the phy does not keep AirFrames in its ChannelInfo, but
+     * deletes them at their end.
+     */
+    virtual bool usesChannelInfo() const
+    {
+        return true;
+    }
+
     /**
      * @brief Method to be called by an OMNeT-module during its own finish(),
      * to enable a decider to do some things.
@@ -72,6 +72,31 @@ public:
      */
     virtual void getChannelInfo(simtime_t_cref from, simtime_t_cref to, AirFrameVector& out) = 0;
 
+    /**
+     * @brief Like getChannelInfo(), but may leave out AirFrames whose signal
+     * has no power within the frequencies [freqLow, freqHigh] (in Hz).
+     *
+     * Both frequencies have to be part of the spectrum of the signals.
+     * By default, returns all AirFrames like getChannelInfo().
+     */
+    virtual void getChannelInfoInBand(simtime_t_cref from, simtime_t_cref to, double freqLow, double freqHigh, AirFrameVector& out)
+    {
+        getChannelInfo(from, to, out);
+    }
+
+    /**
+     * @brief Returns an upper bound of the interference (in mW) of far field transmitters
+     * on the given frequency during the passed time frame, which is not part of the AirFrames.
+     *
+     * No event marks when it changes, so deciders should only add it to the noise when evaluating a reception, not for busy/idle transitions.
+     *
+     * By default, there is no far field interference.
+     */
+    virtual double getFarFieldInterference(simtime_t_cref from, simtime_t_cref to, double frequency)
+    {
+        return 0;
+    }
+
     /**
      * @brief Returns a constant which defines the noise floor in
      * the passed time frame (in mW).
@@ -83,6 +108,11 @@ public:
      */
     virtual void sendControlMsgToMac(cMessage* msg) = 0;
 
+    /**
+     * @brief Returns a (possibly recycled) control message to be passed to sendControlMsgToMac
+     */
+    virtual cMessage* createControlMsg(const char* name, short kind) = 0;
+
     /**
      * @brief Called to send an AirFrame with DeciderResult to the MACLayer
      *
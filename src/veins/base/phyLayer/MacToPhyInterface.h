@@ -30,6 +30,8 @@
 
 namespace veins {
 
+class IntraNicDispatcher;
+
 /**
  * @brief Defines the methods provided by the phy to the mac layer.
  *
@@ -102,6 +104,23 @@ public:
 
     /** @brief Returns the number of channels available on this radio. */
     virtual int getNbRadioChannels() = 0;
+
+    /**
+     * @brief Hands a control message received from the phy back to it for reuse.
+     *
+     * The mac must not access the message after calling this method.
+     */
+    virtual void recycleControlMsg(cMessage* msg) = 0;
+
+    /**
+     * @brief Returns the dispatcher the mac is to exchange messages with the phy by, or nullptr if they are to be sent via gates.
+     *
+     * Only valid from initialization-stage 1 on, see IntraNicDispatcher.
+     */
+    virtual IntraNicDispatcher* getIntraNicDispatcher()
+    {
+        return nullptr;
+    }
 };
 
 } // namespace veins
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/phyLayer/PhyConfigCache.h"
+
+#include "veins/base/utils/SharedDataRegistry.h"
+
+using veins::AnalogueModel;
+using veins::PhyConfigCache;
+using veins::SampledAntenna1D;
+using veins::ShadowingField;
+using veins::SharedDataRegistry;
+
+const std::vector<PhyConfigCache::Entry>& PhyConfigCache::getEntries(cXMLElement* config, const std::string& tagName)
+{
+    auto key = std::make_pair(config, tagName);
+    auto found = entries.find(key);
+    if (found != entries.end()) return found->second;
+
+    std::vector<Entry>& result = entries[key];
+    for (cXMLElement* element : config->getElementsByTagName(tagName.c_str())) {
+        result.push_back({element, ParameterMap()});
+        parseParameters(element, result.back().params);
+    }
+    return result;
+}
+
+std::shared_ptr<AnalogueModel> PhyConfigCache::getSharedAnalogueModel(const Entry& entry, const std::string& phyType) const
+{
+    auto found = sharedAnalogueModels.find(std::make_pair(entry.element, phyType));
+    return found != sharedAnalogueModels.end() ? found->second : nullptr;
+}
+
+void PhyConfigCache::addSharedAnalogueModel(const Entry& entry, const std::string& phyType, std::shared_ptr<AnalogueModel> model)
+{
+    sharedAnalogueModels[std::make_pair(entry.element, phyType)] = std::move(model);
+}
+
+std::shared_ptr<const veins::SampledAntenna1D::GainTable> PhyConfigCache::getSampledAntennaGainTable(const std::vector<double>& samples)
+{
+    // the bit patterns of the samples identify the table
+    std::string key(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(double));
+    return SharedDataRegistry::getOrCreate<SampledAntenna1D::GainTable>(key, [&samples]() { return SampledAntenna1D::GainTable(samples); });
+}
+
+std::shared_ptr<const ShadowingField> PhyConfigCache::getShadowingField(const std::string& key, const std::function<ShadowingField()>& create)
+{
+    std::shared_ptr<const ShadowingField>& field = shadowingFields[key];
+    if (!field) field = std::make_shared<const ShadowingField>(create());
+    return field;
+}
+
+void PhyConfigCache::parseParameters(cXMLElement* xmlData, ParameterMap& outputMap)
+{
+    cXMLElementList parameters = xmlData->getElementsByTagName("Parameter");
+
+    for (cXMLElementList::const_iterator it = parameters.begin(); it != parameters.end(); it++) {
+
+        const char* name = (*it)->getAttribute("name");
+        const char* type = (*it)->getAttribute("type");
+        const char* value = (*it)->getAttribute("value");
+        if (name == nullptr || type == nullptr || value == nullptr) throw cRuntimeError("Invalid parameter, could not find name, type or value");
+
+        std::string sType = type; // needed for easier comparision
+        std::string sValue = value; // needed for easier comparision
+
+        cMsgPar param(name);
+
+        // parse type of parameter and set value
+        if (sType == "bool") {
+            param.setBoolValue(sValue == "true" || sValue == "1");
+        }
+        else if (sType == "double") {
+            param.setDoubleValue(strtod(value, nullptr));
+        }
+        else if (sType == "string") {
+            param.setStringValue(value);
+        }
+        else if (sType == "long") {
+            param.setLongValue(strtol(value, nullptr, 0));
+        }
+        else {
+            throw cRuntimeError("Unknown parameter type: '%s'", sType.c_str());
+        }
+
+        // add parameter to output map
+        outputMap[name] = param;
+    }
+}
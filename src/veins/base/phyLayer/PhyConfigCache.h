@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/phyLayer/AnalogueModel.h"
+#include "veins/modules/analogueModel/CorrelatedShadowing.h"
+#include "veins/modules/phy/SampledAntenna1D.h"
+
+namespace veins {
+
+/**
+ * @brief Per-simulation cache of the phy configuration that all hosts have in common.
+ *
+ * Parses each XML configuration of analogue models, deciders and antennas only once, no matter how many phys use it,
+ * and keeps the analogue model instances that can serve all phys of the same type (see AnalogueModel::isShareable()).
+ * Also interns the gain tables of sampled antennas, so hosts using the same samples share one table
+ * (process-wide, see SharedDataRegistry).
+ * Owned by BaseWorldUtility and kept alive by the phys using it.
+ *
+ * @ingroup phyLayer
+ */
+class VEINS_API PhyConfigCache {
+public:
+    using ParameterMap = std::map<std::string, cMsgPar>;
+
+    /**
+     * @brief A configuration element (e.g., an AnalogueModel) and its parsed parameters.
+     */
+    struct Entry {
+        cXMLElement* element;
+        ParameterMap params;
+    };
+
+    /**
+     * @brief Returns the entries of all elements named tagName below config, parsing them on first use.
+     */
+    const std::vector<Entry>& getEntries(cXMLElement* config, const std::string& tagName);
+
+    /**
+     * @brief Returns the analogue model a phy of type phyType created for entry and shared, or nullptr.
+     */
+    std::shared_ptr<AnalogueModel> getSharedAnalogueModel(const Entry& entry, const std::string& phyType) const;
+
+    void addSharedAnalogueModel(const Entry& entry, const std::string& phyType, std::shared_ptr<AnalogueModel> model);
+
+    /**
+     * @brief Returns the gain table for the given antenna samples, creating it on first use.
+     */
+    std::shared_ptr<const SampledAntenna1D::GainTable> getSampledAntennaGainTable(const std::vector<double>& samples);
+
+    /**
+     * @brief Returns the shadowing field stored under key (which captures everything it is built from), calling create() to build it on first use.
+     *
+     * Fields are kept for this simulation only, as their seeds are usually drawn anew for every run.
+     */
+    std::shared_ptr<const ShadowingField> getShadowingField(const std::string& key, const std::function<ShadowingField()>& create);
+
+    /**
+     * @brief Reads the Parameter children of xmlData into outputMap.
+     */
+    static void parseParameters(cXMLElement* xmlData, ParameterMap& outputMap);
+
+private:
+    std::map<std::pair<cXMLElement*, std::string>, std::vector<Entry>> entries; /**< by configuration and tag name */
+    std::map<std::pair<const cXMLElement*, std::string>, std::shared_ptr<AnalogueModel>> sharedAnalogueModels; /**< by configuration element and phy type */
+    std::map<std::string, std::shared_ptr<const ShadowingField>> shadowingFields; /**< by key */
+};
+
+} // namespace veins
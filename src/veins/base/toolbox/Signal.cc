@@ -22,18 +22,166 @@
 
 #include "veins/base/toolbox/Signal.h"
 
+#include <algorithm>
 #include <sstream>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "veins/base/phyLayer/AnalogueModel.h"
 
 namespace veins {
 
+namespace {
+
+/*
+ * Element-wise arithmetic kernels working on raw value arrays.
+ *
+ * With SSE2 (always available on x86-64) two doubles (or four floats) are processed per instruction,
+ * the remainder (and all values on other architectures) is processed one by one.
+ */
+struct Add {
+    static Signal::Value apply(Signal::Value lhs, Signal::Value rhs)
+    {
+        return lhs + rhs;
+    }
+#ifdef __SSE2__
+    static __m128d apply(__m128d lhs, __m128d rhs)
+    {
+        return _mm_add_pd(lhs, rhs);
+    }
+    static __m128 apply(__m128 lhs, __m128 rhs)
+    {
+        return _mm_add_ps(lhs, rhs);
+    }
+#endif
+};
+
+struct Subtract {
+    static Signal::Value apply(Signal::Value lhs, Signal::Value rhs)
+    {
+        return lhs - rhs;
+    }
+#ifdef __SSE2__
+    static __m128d apply(__m128d lhs, __m128d rhs)
+    {
+        return _mm_sub_pd(lhs, rhs);
+    }
+    static __m128 apply(__m128 lhs, __m128 rhs)
+    {
+        return _mm_sub_ps(lhs, rhs);
+    }
+#endif
+};
+
+struct Multiply {
+    static Signal::Value apply(Signal::Value lhs, Signal::Value rhs)
+    {
+        return lhs * rhs;
+    }
+#ifdef __SSE2__
+    static __m128d apply(__m128d lhs, __m128d rhs)
+    {
+        return _mm_mul_pd(lhs, rhs);
+    }
+    static __m128 apply(__m128 lhs, __m128 rhs)
+    {
+        return _mm_mul_ps(lhs, rhs);
+    }
+#endif
+};
+
+struct Divide {
+    static Signal::Value apply(Signal::Value lhs, Signal::Value rhs)
+    {
+        return lhs / rhs;
+    }
+#ifdef __SSE2__
+    static __m128d apply(__m128d lhs, __m128d rhs)
+    {
+        return _mm_div_pd(lhs, rhs);
+    }
+    static __m128 apply(__m128 lhs, __m128 rhs)
+    {
+        return _mm_div_ps(lhs, rhs);
+    }
+#endif
+};
+
+#ifdef __SSE2__
+// loads, stores and broadcasts of the vector type matching the value type
+inline __m128d load(const double* src)
+{
+    return _mm_loadu_pd(src);
+}
+inline __m128 load(const float* src)
+{
+    return _mm_loadu_ps(src);
+}
+inline void store(double* dst, __m128d values)
+{
+    _mm_storeu_pd(dst, values);
+}
+inline void store(float* dst, __m128 values)
+{
+    _mm_storeu_ps(dst, values);
+}
+inline __m128d broadcast(double value)
+{
+    return _mm_set1_pd(value);
+}
+inline __m128 broadcast(float value)
+{
+    return _mm_set1_ps(value);
+}
+
+// number of values per vector
+constexpr size_t lanes = sizeof(__m128d) / sizeof(Signal::Value);
+#endif
+
+// dst[i] = dst[i] op src[i] for all i in [0, n)
+template <typename Op>
+void applyKernel(Signal::Value* dst, const Signal::Value* src, size_t n)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + lanes <= n; i += lanes) {
+        store(dst + i, Op::apply(load(dst + i), load(src + i)));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = Op::apply(dst[i], src[i]);
+    }
+}
+
+// dst[i] = dst[i] op value for all i in [0, n)
+template <typename Op>
+void applyKernel(Signal::Value* dst, Signal::Value value, size_t n)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    const auto values = broadcast(value);
+    for (; i + lanes <= n; i += lanes) {
+        store(dst + i, Op::apply(load(dst + i), values));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = Op::apply(dst[i], value);
+    }
+}
+
+} // namespace
+
 Signal::Signal(const Signal& other)
     : spectrum(other.spectrum)
     , values(other.values)
     , numDataValues(other.numDataValues)
     , dataOffset(other.dataOffset)
     , centerFrequencyIndex(other.centerFrequencyIndex)
+    , filterWindowRestricted(other.filterWindowRestricted)
+    , filterStart(other.filterStart)
+    , filterEnd(other.filterEnd)
     , timingUsed(other.timingUsed)
     , sendingStart(other.sendingStart)
     , duration(other.duration)
@@ -42,6 +190,10 @@ Signal::Signal(const Signal& other)
     , numAnalogueModelsApplied(other.numAnalogueModelsApplied)
     , senderPoa(other.senderPoa)
     , receiverPoa(other.receiverPoa)
+    , linkGeometry(other.linkGeometry)
+    , linkGeometryTime(other.linkGeometryTime)
+    , transmissionId(other.transmissionId)
+    , receiverId(other.receiverId)
 {
 }
 
@@ -65,29 +217,29 @@ const Spectrum& Signal::getSpectrum() const
     return spectrum;
 }
 
-double& Signal::at(size_t index)
+Signal::Value& Signal::at(size_t index)
 {
     return values.at(index);
 }
 
-const double& Signal::at(size_t index) const
+const Signal::Value& Signal::at(size_t index) const
 {
     return values.at(index);
 }
 
-double& Signal::atFrequency(double frequency)
+Signal::Value& Signal::atFrequency(double frequency)
 {
     size_t index = spectrum.indexOf(frequency);
     return values.at(index);
 }
 
-const double& Signal::atFrequency(double frequency) const
+const Signal::Value& Signal::atFrequency(double frequency) const
 {
     size_t index = spectrum.indexOf(frequency);
     return values.at(index);
 }
 
-double* Signal::getValues()
+Signal::Value* Signal::getValues()
 {
     return values.data();
 }
@@ -102,12 +254,12 @@ double Signal::getMax() const
     return getMaxInRange(0, values.size());
 }
 
-double& Signal::dataAt(size_t index)
+Signal::Value& Signal::dataAt(size_t index)
 {
     return values.at(dataOffset + index);
 }
 
-const double& Signal::dataAt(size_t index) const
+const Signal::Value& Signal::dataAt(size_t index) const
 {
     return values.at(dataOffset + index);
 }
@@ -122,7 +274,7 @@ size_t Signal::getDataEnd() const
     return dataOffset + numDataValues;
 }
 
-double* Signal::getDataValues()
+Signal::Value* Signal::getDataValues()
 {
     return values.data() + dataOffset;
 }
@@ -162,6 +314,26 @@ void Signal::setDataNumValues(size_t num)
     numDataValues = num;
 }
 
+size_t Signal::getFilterStart() const
+{
+    return filterWindowRestricted ? filterStart : 0;
+}
+
+size_t Signal::getFilterEnd() const
+{
+    return filterWindowRestricted ? filterEnd : values.size();
+}
+
+void Signal::restrictFilterWindow(size_t guardBins)
+{
+    filterStart = getDataStart() - std::min(guardBins, getDataStart());
+    filterEnd = std::min(getDataEnd() + guardBins, values.size());
+    filterWindowRestricted = true;
+
+    std::fill(values.begin(), values.begin() + filterStart, 0);
+    std::fill(values.begin() + filterEnd, values.end(), 0);
+}
+
 size_t Signal::getCenterFrequencyIndex() const
 {
     return centerFrequencyIndex;
@@ -254,14 +426,41 @@ POA Signal::getReceiverPoa() const
     return receiverPoa;
 }
 
+const LinkGeometry& Signal::getLinkGeometry() const
+{
+    if (linkGeometryTime != simTime()) {
+        linkGeometry = LinkGeometry(senderPoa.pos.getPositionAt(), receiverPoa.pos.getPositionAt());
+        linkGeometryTime = simTime();
+    }
+    return linkGeometry;
+}
+
 void Signal::setSenderPoa(const POA& poa)
 {
     senderPoa = poa;
+    linkGeometryTime = -1;
 }
 
 void Signal::setReceiverPoa(const POA& poa)
 {
     receiverPoa = poa;
+    linkGeometryTime = -1;
+}
+
+long Signal::getTransmissionId() const
+{
+    return transmissionId;
+}
+
+int Signal::getReceiverId() const
+{
+    return receiverId;
+}
+
+void Signal::setLinkIds(long transmissionId, int receiverId)
+{
+    this->transmissionId = transmissionId;
+    this->receiverId = receiverId;
 }
 
 simtime_t_cref Signal::getSendingStart() const
@@ -329,12 +528,20 @@ Signal& Signal::operator=(const Signal& other)
 
     numDataValues = other.getNumDataValues();
 
+    filterWindowRestricted = other.filterWindowRestricted;
+    filterStart = other.filterStart;
+    filterEnd = other.filterEnd;
+
     values = other.values;
 
     analogueModelList = other.getAnalogueModelList();
     numAnalogueModelsApplied = other.getNumAnalogueModelsApplied();
     senderPoa = other.getSenderPoa();
     receiverPoa = other.getReceiverPoa();
+    linkGeometry = other.linkGeometry;
+    linkGeometryTime = other.linkGeometryTime;
+    transmissionId = other.transmissionId;
+    receiverId = other.receiverId;
 
     timingUsed = other.hasTiming();
     sendingStart = other.getSendingStart();
@@ -349,13 +556,13 @@ Signal& Signal::operator+=(const Signal& other)
     ASSERT(this->getSpectrum() == other.getSpectrum());
     ASSERT(!(this->timingUsed && other.timingUsed) || (this->sendingStart == other.sendingStart && this->duration == other.duration));
 
-    std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::plus<double>());
+    applyKernel<Add>(values.data(), other.values.data(), values.size());
     return *this;
 }
 
 Signal& Signal::operator+=(const double value)
 {
-    std::transform(values.begin(), values.end(), values.begin(), [value](double other) { return other + value; });
+    applyKernel<Add>(values.data(), value, values.size());
     return *this;
 }
 
@@ -364,13 +571,29 @@ Signal& Signal::operator-=(const Signal& other)
     ASSERT(this->getSpectrum() == other.getSpectrum());
     ASSERT(!(this->timingUsed && other.timingUsed) || (this->sendingStart == other.sendingStart && this->duration == other.duration));
 
-    std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::minus<double>());
+    applyKernel<Subtract>(values.data(), other.values.data(), values.size());
     return *this;
 }
 
+void Signal::addInRange(const Signal& other, size_t freqIndexLow, size_t freqIndexHigh)
+{
+    ASSERT(this->getSpectrum() == other.getSpectrum());
+    ASSERT(freqIndexLow <= freqIndexHigh && freqIndexHigh <= values.size());
+
+    applyKernel<Add>(values.data() + freqIndexLow, other.values.data() + freqIndexLow, freqIndexHigh - freqIndexLow);
+}
+
+void Signal::subtractInRange(const Signal& other, size_t freqIndexLow, size_t freqIndexHigh)
+{
+    ASSERT(this->getSpectrum() == other.getSpectrum());
+    ASSERT(freqIndexLow <= freqIndexHigh && freqIndexHigh <= values.size());
+
+    applyKernel<Subtract>(values.data() + freqIndexLow, other.values.data() + freqIndexLow, freqIndexHigh - freqIndexLow);
+}
+
 Signal& Signal::operator-=(const double value)
 {
-    std::transform(values.begin(), values.end(), values.begin(), [value](double other) { return other - value; });
+    applyKernel<Subtract>(values.data(), value, values.size());
     return *this;
 }
 
@@ -379,13 +602,16 @@ Signal& Signal::operator*=(const Signal& other)
     ASSERT(this->getSpectrum() == other.getSpectrum());
     ASSERT(!(this->timingUsed && other.timingUsed) || (this->sendingStart == other.sendingStart && this->duration == other.duration));
 
-    std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::multiplies<double>());
+    // there is no power outside of the filter window
+    const size_t first = getFilterStart();
+    applyKernel<Multiply>(values.data() + first, other.values.data() + first, getFilterEnd() - first);
     return *this;
 }
 
 Signal& Signal::operator*=(const double value)
 {
-    std::transform(values.begin(), values.end(), values.begin(), [value](double other) { return other * value; });
+    const size_t first = getFilterStart();
+    applyKernel<Multiply>(values.data() + first, value, getFilterEnd() - first);
     return *this;
 }
 
@@ -394,13 +620,13 @@ Signal& Signal::operator/=(const Signal& other)
     ASSERT(this->getSpectrum() == other.getSpectrum());
     ASSERT(!(this->timingUsed && other.timingUsed) || (this->sendingStart == other.sendingStart && this->duration == other.duration));
 
-    std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::divides<double>());
+    applyKernel<Divide>(values.data(), other.values.data(), values.size());
     return *this;
 }
 
 Signal& Signal::operator/=(const double value)
 {
-    std::transform(values.begin(), values.end(), values.begin(), [value](double other) { return other / value; });
+    applyKernel<Divide>(values.data(), value, values.size());
     return *this;
 }
 
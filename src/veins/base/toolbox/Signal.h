@@ -26,6 +26,8 @@
 
 #include "veins/base/utils/POA.h"
 #include "veins/base/utils/Coord.h"
+#include "veins/base/utils/LinkGeometry.h"
+#include "veins/base/utils/SmallVector.h"
 #include "veins/base/toolbox/Spectrum.h"
 #include "veins/base/phyLayer/AnalogueModel.h"
 
@@ -38,11 +40,24 @@ namespace veins {
  * The signal power is stored in milliwatt.
  * Signals can be combined arithmetically to, e.g., compute interference introduced by several overlapping signals.
  *
+ * Power levels are stored as double, or as float if Veins is configured with --enable-float-signals (defining VEINS_SIGNAL_FLOAT),
+ * which halves the memory (bandwidth) needed for wide spectra. Sums of several signals (e.g., interference in SignalUtils) are
+ * accumulated in double either way.
+ *
  * @see SignalUtils
  * @see Spectrum
  */
 class VEINS_API Signal {
 public:
+    /**
+     * Type of the stored power levels.
+     */
+#ifdef VEINS_SIGNAL_FLOAT
+    using Value = float;
+#else
+    using Value = double;
+#endif
+
     Signal() = default;
 
     /**
@@ -76,7 +91,7 @@ public:
      * @param index index of the power level to return
      * @return a reference to the power level
      */
-    double& at(size_t index);
+    Value& at(size_t index);
 
     /**
      * Get the power in milliwatt for the given frequency index.
@@ -84,7 +99,7 @@ public:
      * @param index index of the power level to return
      * @return a reference to the power level
      */
-    const double& at(size_t index) const;
+    const Value& at(size_t index) const;
 
     /**
      * Get the power in milliwatt for the given frequency.
@@ -92,7 +107,7 @@ public:
      * @param freq frequency of the power level to return
      * @return a reference to the power level
      */
-    double& atFrequency(double freq);
+    Value& atFrequency(double freq);
 
     /**
      * Get the power in milliwatt for the given frequency.
@@ -100,7 +115,7 @@ public:
      * @param freq frequency of the power level to return
      * @return a reference to the power level
      */
-    const double& atFrequency(double freq) const;
+    const Value& atFrequency(double freq) const;
 
     /**
      * Access the underlying power values directly.
@@ -108,7 +123,7 @@ public:
      * @see getNumValues()
      * @return A pointer to the individual values. The amount of valid entries is defined by getNumValues.
      */
-    double* getValues();
+    Value* getValues();
 
     /**
      * Returns the number of power values stored in this signal.
@@ -135,7 +150,7 @@ public:
      * @param index index of the power level to return
      * @return a reference to the power level
      */
-    double& dataAt(size_t index);
+    Value& dataAt(size_t index);
 
     /**
      * Get the power in milliwatt for the given data frequency index.
@@ -143,7 +158,7 @@ public:
      * @param index index of the power level to return
      * @return a reference to the power level
      */
-    const double& dataAt(size_t index) const;
+    const Value& dataAt(size_t index) const;
 
     /**
      * Get the absolute frequency index of the first data frequency.
@@ -160,7 +175,7 @@ public:
      *
      * @see getNumDataValues()
      */
-    double* getDataValues();
+    Value* getDataValues();
 
     /**
      * The number of values in the data frequency subrange.
@@ -210,6 +225,31 @@ public:
     void setDataNumValues(size_t num);
     ///@}
 
+    /**
+     * @name Filter window
+     *
+     * The frequency range analogue models (and multiplications of the signal) need to compute.
+     * All power levels outside of it are zero.
+     */
+    ///@{
+    /**
+     * Get the absolute index of the first frequency of the filter window (0 unless restricted).
+     */
+    size_t getFilterStart() const;
+
+    /**
+     * Get the absolute index of the first past-the-end frequency of the filter window (getNumValues() unless restricted).
+     */
+    size_t getFilterEnd() const;
+
+    /**
+     * Restrict the filter window to the data frequency range, widened by guardBins frequencies on either side.
+     *
+     * Power levels outside of the window are set to zero, so they can serve neither decoding nor carrier sensing.
+     */
+    void restrictFilterWindow(size_t guardBins);
+    ///@}
+
     /**
      * @name Center frequency access
      */
@@ -302,6 +342,13 @@ public:
      */
     POA getReceiverPoa() const;
 
+    /**
+     * Get the geometry of the link between this signal's sender and receiver POA, at the current simulation time.
+     *
+     * It is computed once per point in time and shared by everyone evaluating this signal (antennas, analogue models, ...).
+     */
+    const LinkGeometry& getLinkGeometry() const;
+
     /**
      * Set this signal's sender POA.
      *
@@ -315,6 +362,24 @@ public:
      * @param poa the new receiver POA
      */
     void setReceiverPoa(const POA& poa);
+
+    /**
+     * Get the id of the transmission this signal belongs to (the same for all receivers of one transmission), or -1 if unknown.
+     */
+    long getTransmissionId() const;
+
+    /**
+     * Get the id of the module receiving this signal, or -1 if unknown.
+     */
+    int getReceiverId() const;
+
+    /**
+     * Set the ids identifying the link this signal travels on, e.g., to key random draws by (see CounterRng).
+     *
+     * @param transmissionId id of the transmission (the same for all receivers of one transmission)
+     * @param receiverId id of the receiving module
+     */
+    void setLinkIds(long transmissionId, int receiverId);
     ///@}
 
     /**
@@ -463,6 +528,26 @@ public:
      * @param value power level to divide by in milliwatt
      */
     Signal& operator/=(const double value);
+
+    /**
+     * Increment the power levels by another signal's power levels, but only for the frequency indices [freqIndexLow, freqIndexHigh).
+     *
+     * Useful to only update the data interval of a signal, leaving all other power levels untouched.
+     *
+     * @param other the other signal
+     * @param freqIndexLow the first frequency index to update
+     * @param freqIndexHigh one past the last frequency index to update
+     */
+    void addInRange(const Signal& other, size_t freqIndexLow, size_t freqIndexHigh);
+
+    /**
+     * Decrement the power levels by another signal's power levels, but only for the frequency indices [freqIndexLow, freqIndexHigh).
+     *
+     * @param other the other signal
+     * @param freqIndexLow the first frequency index to update
+     * @param freqIndexHigh one past the last frequency index to update
+     */
+    void subtractInRange(const Signal& other, size_t freqIndexLow, size_t freqIndexHigh);
     ///@}
 
     /**
@@ -495,13 +580,23 @@ private:
 
     Spectrum spectrum;
 
-    std::vector<double> values;
+    /**
+     * @brief Power levels (in mW), one per frequency of the spectrum.
+     *
+     * Kept inline for spectra of up to 16 frequencies (enough for all channels of IEEE 802.11p),
+     * so copying such a Signal needs no heap allocation.
+     */
+    SmallVector<Value, 16> values;
 
     size_t numDataValues = 0;
     size_t dataOffset = 0;
 
     size_t centerFrequencyIndex = 0;
 
+    bool filterWindowRestricted = false;
+    size_t filterStart = 0;
+    size_t filterEnd = 0;
+
     bool timingUsed = false;
     /** @brief The start of the signal transmission at the sender module.*/
     simtime_t sendingStart = 0;
@@ -515,6 +610,11 @@ private:
 
     POA senderPoa;
     POA receiverPoa;
+
+    mutable LinkGeometry linkGeometry;
+    mutable simtime_t linkGeometryTime = -1; /**< simulation time linkGeometry was computed for (-1: not computed yet) */
+    long transmissionId = -1;
+    int receiverId = -1;
 };
 
 /**
@@ -24,62 +24,35 @@
 
 #include "veins/base/messages/AirFrame_m.h"
 
-#include <queue>
+#include <algorithm>
+#include <vector>
 
 namespace veins {
 namespace SignalUtils {
 
 namespace {
 
-template <typename T>
 struct greaterByReceptionEnd {
-    bool operator()(const T& lhs, const T& rhs) const
+    bool operator()(const Signal* lhs, const Signal* rhs) const
     {
-        return lhs.getReceptionEnd() > rhs.getReceptionEnd();
+        return lhs->getReceptionEnd() > rhs->getReceptionEnd();
     };
 };
 
-Signal getMaxInterference(simtime_t start, simtime_t end, AirFrame* const referenceFrame, AirFrameVector& interfererFrames)
-{
-    Spectrum spectrum = referenceFrame->getSignal().getSpectrum();
-    Signal maxInterference(spectrum);
-    Signal currentInterference(spectrum);
-    std::priority_queue<Signal, std::vector<Signal>, greaterByReceptionEnd<Signal>> signalEndings;
-    simtime_t currentTime = 0;
-
-    interfererFrames.sort([](const AirFrame* x, const AirFrame* y) { return x->getConstSignal().getReceptionStart() < y->getConstSignal().getReceptionStart(); });
-
-    for (auto& interfererFrame : interfererFrames) {
-        if (interfererFrame->getTreeId() == referenceFrame->getTreeId()) continue; // skip the signal we want to compare to
-        const Signal& signal = interfererFrame->getSignal();
-        if (signal.getReceptionEnd() <= start || signal.getReceptionStart() > end) continue; // skip signals outside our interval of interest
-        ASSERT(signal.getReceptionEnd() > start); // fail on signals ending before start of interval of interest (should be filtered out anyways)
-        ASSERT(signal.getReceptionStart() <= end); // fail on signal starting aftser the interval of interest
-        ASSERT(signal.getReceptionStart() >= currentTime); // assume frames are sorted by reception start time
-        ASSERT(signal.getSpectrum() == spectrum);
-        // fetch next signal and advance current time to its start
-        signalEndings.push(signal);
-        currentTime = signal.getReceptionStart();
-
-        // abort at end time
-        if (currentTime >= end) break;
-
-        // remove signals ending before the start of the current one
-        while (signalEndings.top().getReceptionEnd() <= currentTime) {
-            currentInterference -= signalEndings.top();
-            signalEndings.pop();
-        }
-
-        // add curent signal to current total interference
-        currentInterference += signal;
-
-        // update maximum observed interference
-        for (uint16_t spectrumIndex = signal.getDataStart(); spectrumIndex < signal.getDataEnd(); spectrumIndex++) {
-            maxInterference.at(spectrumIndex) = std::max(currentInterference.at(spectrumIndex), maxInterference.at(spectrumIndex));
-        }
-    }
+/**
+ * Containers used by evaluateReception(), kept across calls (per thread) so their storage gets reused.
+ */
+struct ReceptionScratch {
+    std::vector<const Signal*> interferers;
+    std::vector<double> maxInterference;
+    std::vector<double> currentInterference;
+    std::vector<const Signal*> signalEndings; ///< heap ordered by greaterByReceptionEnd, i.e., the earliest ending signal first
+};
 
-    return maxInterference;
+ReceptionScratch& getReceptionScratch()
+{
+    thread_local ReceptionScratch scratch;
+    return scratch;
 }
 
 double powerLevelSumAtFrequencyIndex(const std::vector<Signal*>& signals, size_t freqIndex)
@@ -135,6 +108,11 @@ bool VEINS_API isChannelPowerBelowThreshold(simtime_t now, AirFrameVector& inter
 }
 
 double VEINS_API getMinSINR(simtime_t start, simtime_t end, AirFrame* signalFrame, AirFrameVector& interfererFrames, double noise)
+{
+    return evaluateReception(start, end, signalFrame, interfererFrames, noise).minSinr;
+}
+
+ReceptionEvaluation VEINS_API evaluateReception(simtime_t start, simtime_t end, AirFrame* signalFrame, AirFrameVector& interfererFrames, double noise)
 {
     ASSERT(start >= signalFrame->getSignal().getReceptionStart());
     ASSERT(end <= signalFrame->getSignal().getReceptionEnd());
@@ -145,17 +123,83 @@ double VEINS_API getMinSINR(simtime_t start, simtime_t end, AirFrame* signalFram
         interfererFrame->getSignal().applyAllAnalogueModels();
     }
 
-    Signal& signal = signalFrame->getSignal();
-    Spectrum spectrum = signal.getSpectrum();
+    const Signal& signal = signalFrame->getSignal();
+    const size_t dataStart = signal.getDataStart();
+    const size_t dataEnd = signal.getDataEnd();
+    const size_t numDataValues = dataEnd - dataStart;
 
-    Signal interference = getMaxInterference(start, end, signalFrame, interfererFrames);
-    Signal sinr = signal / (interference + noise);
+    ReceptionScratch& scratch = getReceptionScratch();
+
+    // collect the interferers overlapping with the interval of interest, ordered by reception start
+    std::vector<const Signal*>& interferers = scratch.interferers;
+    interferers.clear();
+    for (auto& interfererFrame : interfererFrames) {
+        if (interfererFrame->getTreeId() == signalFrame->getTreeId()) continue; // skip the signal we want to compare to
+        const Signal& interferer = interfererFrame->getSignal();
+        if (interferer.getReceptionEnd() <= start || interferer.getReceptionStart() > end) continue; // skip signals outside our interval of interest
+        ASSERT(interferer.getSpectrum() == signal.getSpectrum());
+        interferers.push_back(&interferer);
+    }
+
+    // alone on the channel: the SINR is the SNR, no sweep needed (dividing by the same noise keeps the minimum where it is)
+    if (interferers.empty()) {
+        double minPower = INFINITY;
+        for (size_t i = 0; i < numDataValues; i++) {
+            minPower = std::min(minPower, signal.at(dataStart + i));
+        }
+        return ReceptionEvaluation{minPower / noise, minPower / noise};
+    }
+
+    std::stable_sort(interferers.begin(), interferers.end(), [](const Signal* x, const Signal* y) { return x->getReceptionStart() < y->getReceptionStart(); });
+
+    // sweep over the interferers, tracking the current and maximum interference within the data interval
+    std::vector<double>& maxInterference = scratch.maxInterference;
+    maxInterference.assign(numDataValues, 0);
+    std::vector<double>& currentInterference = scratch.currentInterference;
+    currentInterference.assign(numDataValues, 0);
+    std::vector<const Signal*>& signalEndings = scratch.signalEndings;
+    signalEndings.clear();
+    for (auto interferer : interferers) {
+        // fetch next signal and advance current time to its start
+        signalEndings.push_back(interferer);
+        std::push_heap(signalEndings.begin(), signalEndings.end(), greaterByReceptionEnd());
+        const simtime_t currentTime = interferer->getReceptionStart();
+
+        // abort at end time
+        if (currentTime >= end) break;
+
+        // remove signals ending before the start of the current one
+        while (signalEndings.front()->getReceptionEnd() <= currentTime) {
+            for (size_t i = 0; i < numDataValues; i++) {
+                currentInterference[i] -= signalEndings.front()->at(dataStart + i);
+            }
+            std::pop_heap(signalEndings.begin(), signalEndings.end(), greaterByReceptionEnd());
+            signalEndings.pop_back();
+        }
+
+        // add curent signal to current total interference
+        for (size_t i = 0; i < numDataValues; i++) {
+            currentInterference[i] += interferer->at(dataStart + i);
+        }
+
+        // update maximum observed interference
+        const size_t from = std::max(interferer->getDataStart(), dataStart);
+        const size_t to = std::min(interferer->getDataEnd(), dataEnd);
+        for (size_t spectrumIndex = from; spectrumIndex < to; spectrumIndex++) {
+            const size_t i = spectrumIndex - dataStart;
+            maxInterference[i] = std::max(currentInterference[i], maxInterference[i]);
+        }
+    }
 
-    double min_sinr = INFINITY;
-    for (uint16_t i = signal.getDataStart(); i < signal.getDataEnd(); i++) {
-        min_sinr = std::min(min_sinr, sinr.at(i));
+    ReceptionEvaluation result{INFINITY, INFINITY};
+    double minPower = INFINITY;
+    for (size_t i = 0; i < numDataValues; i++) {
+        const double power = signal.at(dataStart + i);
+        result.minSinr = std::min(result.minSinr, power / (maxInterference[i] + noise));
+        minPower = std::min(minPower, power);
     }
-    return min_sinr;
+    result.minSnr = minPower / noise;
+    return result;
 }
 
 } // namespace SignalUtils
@@ -65,5 +65,24 @@ bool VEINS_API isChannelPowerBelowThreshold(simtime_t now, AirFrameVector& inter
  */
 double VEINS_API getMinSINR(simtime_t start, simtime_t end, AirFrame* signalFrame, AirFrameVector& interfererFrames, double noise);
 
+/**
+ * @brief Result of evaluateReception()
+ */
+struct VEINS_API ReceptionEvaluation {
+    double minSinr; ///< minimal Signal to (Interference + Noise) Ratio at any data channel (same as getMinSINR())
+    double minSnr; ///< minimal Signal to Noise Ratio at any data channel
+};
+
+/**
+ * @brief return both the minimal SINR and SNR at any data channel of signalFrame's signal
+ *
+ * Computes the same minimal SINR as getMinSINR() (plus the SNR) in a single sweep over the interferers,
+ * without creating intermediate Signal objects. Only the data interval of signalFrame's signal is evaluated.
+ *
+ * This function ensures that all analogue models attached to the signal of each interfererFrame and the signalFrame are applied.
+ * Only considers the given interval between [start, end) and assumes time-independent noise that is the same for all channels.
+ */
+ReceptionEvaluation VEINS_API evaluateReception(simtime_t start, simtime_t end, AirFrame* signalFrame, AirFrameVector& interfererFrames, double noise);
+
 } // namespace SignalUtils
 } // namespace veins
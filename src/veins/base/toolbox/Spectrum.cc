@@ -23,6 +23,8 @@
 #include "veins/base/toolbox/Spectrum.h"
 
 #include <sstream>
+#include <set>
+#include <mutex>
 
 namespace veins {
 
@@ -34,35 +36,50 @@ Spectrum::Frequencies normalizeFrequencies(Spectrum::Frequencies freqs)
     return freqs;
 }
 
+const Spectrum::Frequencies* Spectrum::intern(Spectrum::Frequencies freqs)
+{
+    // nodes of a std::set are never relocated, so pointers to its elements stay valid
+    static std::set<Spectrum::Frequencies> internedFrequencies;
+    static std::mutex internedFrequenciesMutex;
+
+    std::lock_guard<std::mutex> lock(internedFrequenciesMutex);
+    return &*internedFrequencies.insert(std::move(freqs)).first;
+}
+
+Spectrum::Spectrum()
+    : frequencies(intern({}))
+{
+}
+
 Spectrum::Spectrum(Spectrum::Frequencies freqs)
-    : frequencies(normalizeFrequencies(freqs))
+    : frequencies(intern(normalizeFrequencies(std::move(freqs))))
 {
 }
 
 const double& Spectrum::operator[](size_t index) const
 {
-    return frequencies.at(index);
+    return frequencies->at(index);
 }
 
 size_t Spectrum::indexOf(double freq) const
 {
     // Binary search
-    auto it = std::lower_bound(frequencies.begin(), frequencies.end(), freq);
-    bool found = it != frequencies.end() && (*it) == freq;
+    auto it = std::lower_bound(frequencies->begin(), frequencies->end(), freq);
+    bool found = it != frequencies->end() && (*it) == freq;
 
     ASSERT(found == true);
 
-    return std::distance(frequencies.begin(), it);
+    return std::distance(frequencies->begin(), it);
 }
 
 double Spectrum::freqAt(size_t freqIndex) const
 {
-    return frequencies.at(freqIndex);
+    return frequencies->at(freqIndex);
 }
 
 size_t Spectrum::getNumFreqs() const
 {
-    return frequencies.size();
+    return frequencies->size();
 }
 
 bool operator==(const Spectrum& lhs, const Spectrum& rhs)
@@ -74,7 +91,7 @@ std::ostream& operator<<(std::ostream& os, const Spectrum& s)
 {
     os << "Spectrum(";
     std::ostringstream ss;
-    for (auto&& frequency : s.frequencies) {
+    for (auto&& frequency : *s.frequencies) {
         if (ss.tellp() != 0) {
             ss << ", ";
         }
@@ -40,7 +40,7 @@ public:
     using Frequency = double;
     using Frequencies = std::vector<Frequency>;
 
-    Spectrum() = default;
+    Spectrum();
     Spectrum(Frequencies freqs);
 
     const double& operator[](size_t index) const;
@@ -56,7 +56,20 @@ public:
     friend std::ostream& VEINS_API operator<<(std::ostream& os, const Spectrum& s);
 
 private:
-    Frequencies frequencies;
+    /**
+     * @brief Returns the one shared instance of the passed (sorted, deduplicated) frequency list.
+     *
+     * Interned lists are kept until the end of the program.
+     */
+    static const Frequencies* intern(Frequencies freqs);
+
+    /**
+     * @brief The (sorted, deduplicated) frequencies of this spectrum.
+     *
+     * All spectra with the same frequencies point to the same interned list,
+     * so copying a Spectrum is a pointer copy and comparing two spectra is a pointer compare.
+     */
+    const Frequencies* frequencies;
 };
 
 } // namespace veins
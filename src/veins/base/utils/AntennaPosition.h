@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "veins/veins.h"
 
 #include "veins/base/utils/Coord.h"
@@ -29,7 +31,7 @@
 namespace veins {
 
 /**
- * Stores the position of the host's antenna along with its speed, so that it can be linearly extrapolated.
+ * Stores the position of the host's antenna along with its speed (and, optionally, acceleration), so that it can be extrapolated.
  */
 class VEINS_API AntennaPosition {
 
@@ -38,6 +40,7 @@ public:
         : id(-1)
         , p()
         , v()
+        , a()
         , t()
         , undef(true)
     {
@@ -50,20 +53,40 @@ public:
         : id(id)
         , p(p)
         , v(v)
+        , a()
+        , t(t)
+        , undef(false)
+    {
+    }
+
+    /**
+     * Store a position p that changes by v for every second after t, with v changing by a for every second.
+     *
+     * Extrapolation stops where a decelerates the antenna to a halt.
+     */
+    AntennaPosition(int id, Coord p, Coord v, Coord a, simtime_t t)
+        : id(id)
+        , p(p)
+        , v(v)
+        , a(a)
         , t(t)
         , undef(false)
     {
     }
 
     /**
-     * Get the (linearly extrapolated) position at time t.
+     * Get the (extrapolated) position at time t.
      */
     Coord getPositionAt(simtime_t t = simTime()) const
     {
         ASSERT(t >= this->t);
         ASSERT(!undef);
-        auto dt = t - this->t;
-        return p + v * dt.dbl();
+        double dt = (t - this->t).dbl();
+        if (a == Coord::ZERO) return p + v * dt;
+        // stop where the velocity component along a reaches zero
+        double va = v * a;
+        if (va < 0) dt = std::min(dt, -va / a.squareLength());
+        return p + v * dt + a * (dt * dt / 2);
     }
 
     bool isSameAntenna(const AntennaPosition& o) const
@@ -77,6 +100,7 @@ protected:
     int id; /**< unique identifier of antenna returned by ChannelAccess::getId() */
     Coord p; /**< position for linear extrapolation */
     Coord v; /**< speed for linear extrapolation */
+    Coord a; /**< acceleration for extrapolation */
     simtime_t t; /**< time for linear extrapolation */
     bool undef; /**< true if created using default constructor */
 };
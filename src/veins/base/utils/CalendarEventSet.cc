@@ -0,0 +1,135 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/CalendarEventSet.h"
+
+#include <sstream>
+#include <vector>
+
+using veins::CalendarEventSet;
+
+Register_Class(CalendarEventSet);
+
+namespace {
+
+/*
+ * cEvent::isScheduled() tests the (private) position of the event in the future event set, which only cEventHeap
+ * is a friend to set. Explicit template instantiations may name private members, so this is how it is reached.
+ */
+int cEvent::*heapIndexMember();
+
+template <int cEvent::*member>
+struct HeapIndexAccess {
+    friend int cEvent::*heapIndexMember()
+    {
+        return member;
+    }
+};
+
+template struct HeapIndexAccess<&cEvent::heapIndex>;
+
+} // namespace
+
+int& CalendarEventSet::EventPosition::of(cEvent* event)
+{
+    return event->*heapIndexMember();
+}
+
+CalendarEventSet::CalendarEventSet(const char* name)
+    : cFutureEventSet(name)
+    , queue(1000000000) // 1ms at the default time scale (ps), adapted to the events once there are enough of them
+    , lastRemovedKey{0, 0, 0}
+{
+}
+
+CalendarEventSet::~CalendarEventSet()
+{
+    clear();
+}
+
+std::string CalendarEventSet::str() const
+{
+    std::stringstream ss;
+    ss << "length=" << queue.size() << " buckets=" << queue.getNumBuckets() << " width=" << SimTime::fromRaw(queue.getWidth());
+    return ss.str();
+}
+
+void CalendarEventSet::insert(cEvent* event)
+{
+    take(event);
+    queue.insert(event, queue.makeKey(event->getArrivalTime().raw(), event->getSchedulingPriority()));
+}
+
+cEvent* CalendarEventSet::peekFirst() const
+{
+    return queue.peekFirst();
+}
+
+cEvent* CalendarEventSet::removeFirst()
+{
+    cEvent* event = queue.removeFirst(&lastRemovedKey);
+    if (event) drop(event);
+    return event;
+}
+
+void CalendarEventSet::putBackFirst(cEvent* event)
+{
+    ASSERT(event->getArrivalTime().raw() == lastRemovedKey.time);
+    take(event);
+    queue.insert(event, lastRemovedKey);
+}
+
+cEvent* CalendarEventSet::remove(cEvent* event)
+{
+    cEvent* removed = queue.remove(event, event->getArrivalTime().raw());
+    if (removed) drop(removed);
+    return removed;
+}
+
+bool CalendarEventSet::isEmpty() const
+{
+    return queue.empty();
+}
+
+void CalendarEventSet::clear()
+{
+    std::vector<cEvent*> events;
+    events.reserve(queue.size());
+    queue.forEach([&events](cEvent* event) { events.push_back(event); });
+    queue.clear();
+    for (cEvent* event : events) dropAndDelete(event);
+}
+
+int CalendarEventSet::getLength() const
+{
+    return static_cast<int>(queue.size());
+}
+
+cEvent* CalendarEventSet::get(int k)
+{
+    if (k < 0) return nullptr;
+    return queue.at(static_cast<size_t>(k));
+}
+
+void CalendarEventSet::sort()
+{
+}
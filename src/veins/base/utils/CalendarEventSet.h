@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <string>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/CalendarQueue.h"
+
+namespace veins {
+
+/**
+ * @brief Future event set backed by a calendar queue (see CalendarQueue), in place of the binary heap of OMNeT++.
+ *
+ * Inserting events and removing the first one take constant time on average, also for large event populations
+ * and bursts of events at the same time (all receptions of a broadcast, all vehicles moved in one TraCI step,
+ * synchronized IEEE 1609.4 channel switches). Events are processed in the same order as with cEventHeap.
+ * Off by default. Enable by adding
+ *
+ *   futureeventset-class = "veins::CalendarEventSet"
+ *
+ * to the [General] section of the omnetpp.ini (or passing --futureeventset-class=veins::CalendarEventSet).
+ */
+class VEINS_API CalendarEventSet : public cFutureEventSet {
+public:
+    CalendarEventSet(const char* name = nullptr);
+    ~CalendarEventSet() override;
+
+    std::string str() const override;
+
+    void insert(cEvent* event) override;
+    cEvent* peekFirst() const override;
+    cEvent* removeFirst() override;
+    void putBackFirst(cEvent* event) override;
+    cEvent* remove(cEvent* event) override;
+    bool isEmpty() const override;
+    void clear() override;
+    int getLength() const override;
+
+    /**
+     * @brief Returns the k-th event, in no particular order.
+     */
+    cEvent* get(int k) override;
+
+    /**
+     * @brief Does nothing, as the order of get() is not defined.
+     */
+    void sort() override;
+
+private:
+    /**
+     * @brief Gives the queue the position field that cEvent reserves for the future event set.
+     */
+    struct EventPosition {
+        static int& of(cEvent* event);
+    };
+
+    using Queue = CalendarQueue<cEvent, EventPosition>;
+
+    mutable Queue queue;
+    Queue::Key lastRemovedKey; /**< key of the event last returned by removeFirst(), to put it back at the same place */
+};
+
+} // namespace veins
@@ -0,0 +1,328 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Priority queue of items ordered by an integer time, a priority, and insertion order (a calendar queue).
+ *
+ * Items are distributed over a ring of buckets ("days") by their time, each bucket being a binary heap (R. Brown,
+ * "Calendar Queues: A Fast O(1) Priority Queue Implementation for the Simulation Event Set Problem", CACM 31(10), 1988).
+ * The number of buckets follows the number of items (one to four per bucket), their width the spacing of the earliest
+ * items, so inserting and removing the first item take constant time on average. Bursts of items at the same time (e.g., all receptions
+ * of a broadcast) land in one bucket in insertion order, which appending to its heap keeps as is.
+ *
+ * Position::of(item) must return a reference to an int reserved for the queue: the position of the item in its
+ * bucket while queued, -1 otherwise. The time of a queued item must not change.
+ */
+template <typename T, typename Position>
+class VEINS_API CalendarQueue {
+public:
+    /**
+     * @brief Order of an item: by time, then priority, then sequence (the order of insertion).
+     */
+    struct Key {
+        int64_t time;
+        short priority;
+        uint64_t sequence;
+
+        bool operator<(const Key& other) const
+        {
+            if (time != other.time) return time < other.time;
+            if (priority != other.priority) return priority < other.priority;
+            return sequence < other.sequence;
+        }
+    };
+
+    /**
+     * @param initialWidth time covered by one bucket until enough items were queued to estimate it (must be positive)
+     */
+    explicit CalendarQueue(int64_t initialWidth)
+        : width(std::max<int64_t>(initialWidth, 1))
+        , buckets(minBuckets)
+    {
+    }
+
+    /** @brief Returns the key of the next item to be inserted at time with priority. */
+    Key makeKey(int64_t time, short priority)
+    {
+        return Key{time, priority, nextSequence++};
+    }
+
+    /** @brief Queues item, which must not be queued already. */
+    void insert(T* item, const Key& key)
+    {
+        ASSERT(Position::of(item) == -1);
+        ASSERT(key.time >= 0);
+        const int64_t day = key.time / width;
+        if (numItems == 0 || day < currentDay) currentDay = day;
+        const size_t bucket = bucketOf(key.time);
+        std::vector<Entry>& heap = buckets[bucket];
+        heap.push_back(Entry{key, item});
+        Position::of(item) = static_cast<int>(heap.size() - 1);
+        siftUp(heap, heap.size() - 1);
+        numItems++;
+        if (firstBucket != npos && key < buckets[firstBucket].front().key) firstBucket = bucket;
+        if (numItems > 4 * buckets.size()) resize(2 * buckets.size());
+    }
+
+    /** @brief Returns the first item (nullptr if empty), and its key if requested. */
+    T* peekFirst(Key* key = nullptr)
+    {
+        if (numItems == 0) return nullptr;
+        const Entry& first = buckets[findFirstBucket()].front();
+        if (key) *key = first.key;
+        return first.item;
+    }
+
+    /** @brief Removes and returns the first item (nullptr if empty), and its key if requested. */
+    T* removeFirst(Key* key = nullptr)
+    {
+        if (numItems == 0) return nullptr;
+        const size_t bucket = findFirstBucket();
+        if (key) *key = buckets[bucket].front().key;
+        return removeAt(bucket, 0);
+    }
+
+    /** @brief Removes item (queued at time), returns nullptr if it was not queued. */
+    T* remove(T* item, int64_t time)
+    {
+        const int position = Position::of(item);
+        if (position < 0) return nullptr;
+        const size_t bucket = bucketOf(time);
+        ASSERT(static_cast<size_t>(position) < buckets[bucket].size() && buckets[bucket][position].item == item);
+        return removeAt(bucket, position);
+    }
+
+    size_t size() const
+    {
+        return numItems;
+    }
+
+    bool empty() const
+    {
+        return numItems == 0;
+    }
+
+    /** @brief Returns the k-th item, in no particular order. */
+    T* at(size_t k) const
+    {
+        for (const auto& heap : buckets) {
+            if (k < heap.size()) return heap[k].item;
+            k -= heap.size();
+        }
+        return nullptr;
+    }
+
+    /** @brief Calls f(item) for all items, in no particular order. */
+    template <typename F>
+    void forEach(F f) const
+    {
+        for (const auto& heap : buckets) {
+            for (const Entry& entry : heap) f(entry.item);
+        }
+    }
+
+    /** @brief Removes all items (without deleting them). */
+    void clear()
+    {
+        for (auto& heap : buckets) {
+            for (const Entry& entry : heap) Position::of(entry.item) = -1;
+        }
+        buckets.assign(minBuckets, std::vector<Entry>());
+        numItems = 0;
+        firstBucket = npos;
+    }
+
+    /** @brief Returns the time covered by one bucket. */
+    int64_t getWidth() const
+    {
+        return width;
+    }
+
+    size_t getNumBuckets() const
+    {
+        return buckets.size();
+    }
+
+private:
+    struct Entry {
+        Key key;
+        T* item;
+    };
+
+    static constexpr size_t minBuckets = 16;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /** number of earliest items whose spacing determines the width of buckets */
+    static constexpr size_t widthSamples = 32;
+
+    size_t bucketOf(int64_t time) const
+    {
+        return static_cast<size_t>(time / width) & (buckets.size() - 1);
+    }
+
+    /** returns the bucket holding the first item, which must exist */
+    size_t findFirstBucket()
+    {
+        if (firstBucket != npos) return firstBucket;
+
+        // the first item is in the first day (from currentDay on) whose bucket starts with an item of that day
+        const size_t mask = buckets.size() - 1;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            const int64_t day = currentDay + static_cast<int64_t>(i);
+            const std::vector<Entry>& heap = buckets[static_cast<size_t>(day) & mask];
+            if (!heap.empty() && heap.front().key.time / width == day) {
+                currentDay = day;
+                firstBucket = static_cast<size_t>(day) & mask;
+                return firstBucket;
+            }
+        }
+
+        // no item within a year: the buckets are too narrow for the current items, search them all and adapt
+        size_t best = npos;
+        for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+            if (buckets[bucket].empty()) continue;
+            if (best == npos || buckets[bucket].front().key < buckets[best].front().key) best = bucket;
+        }
+        ASSERT(best != npos);
+        currentDay = buckets[best].front().key.time / width;
+        if (numDirectSearches++ >= buckets.size()) {
+            numDirectSearches = 0;
+            resize(buckets.size());
+            return findFirstBucket();
+        }
+        firstBucket = best;
+        return firstBucket;
+    }
+
+    T* removeAt(size_t bucket, size_t position)
+    {
+        std::vector<Entry>& heap = buckets[bucket];
+        T* item = heap[position].item;
+        Position::of(item) = -1;
+        if (position + 1 < heap.size()) {
+            place(heap, position, heap.back());
+            heap.pop_back();
+            siftDown(heap, position);
+            siftUp(heap, position);
+        }
+        else {
+            heap.pop_back();
+        }
+        numItems--;
+        if (bucket == firstBucket && (position == 0 || heap.empty())) firstBucket = npos;
+        if (buckets.size() > minBuckets && numItems < buckets.size()) resize(buckets.size() / 2);
+        return item;
+    }
+
+    void place(std::vector<Entry>& heap, size_t position, const Entry& entry)
+    {
+        heap[position] = entry;
+        Position::of(entry.item) = static_cast<int>(position);
+    }
+
+    void siftUp(std::vector<Entry>& heap, size_t position)
+    {
+        const Entry entry = heap[position];
+        while (position > 0) {
+            const size_t parent = (position - 1) / 2;
+            if (!(entry.key < heap[parent].key)) break;
+            place(heap, position, heap[parent]);
+            position = parent;
+        }
+        place(heap, position, entry);
+    }
+
+    void siftDown(std::vector<Entry>& heap, size_t position)
+    {
+        const Entry entry = heap[position];
+        while (true) {
+            size_t child = 2 * position + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && heap[child + 1].key < heap[child].key) child++;
+            if (!(heap[child].key < entry.key)) break;
+            place(heap, position, heap[child]);
+            position = child;
+        }
+        place(heap, position, entry);
+    }
+
+    /** redistributes all items over numBuckets buckets, re-estimating their width from the spacing of the earliest items */
+    void resize(size_t numBuckets)
+    {
+        std::vector<Entry> entries;
+        entries.reserve(numItems);
+        for (auto& heap : buckets) entries.insert(entries.end(), heap.begin(), heap.end());
+
+        // a bucket should hold about three of the earliest (distinct) times
+        if (entries.size() > 1) {
+            const size_t numSamples = std::min(widthSamples, entries.size());
+            std::nth_element(entries.begin(), entries.begin() + (numSamples - 1), entries.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+            int64_t first = entries.front().key.time;
+            int64_t last = first;
+            for (size_t i = 0; i < numSamples; ++i) {
+                first = std::min(first, entries[i].key.time);
+                last = std::max(last, entries[i].key.time);
+            }
+            if (last > first) width = std::max<int64_t>(3 * (last - first) / static_cast<int64_t>(numSamples - 1), 1);
+        }
+
+        buckets.assign(numBuckets, std::vector<Entry>());
+        numItems = 0;
+        firstBucket = npos;
+        for (const Entry& entry : entries) {
+            Position::of(entry.item) = -1;
+            const int64_t day = entry.key.time / width;
+            if (numItems == 0 || day < currentDay) currentDay = day;
+            std::vector<Entry>& heap = buckets[bucketOf(entry.key.time)];
+            heap.push_back(entry);
+            siftUp(heap, heap.size() - 1);
+            numItems++;
+        }
+    }
+
+    int64_t width; /**< time covered by one bucket */
+    std::vector<std::vector<Entry>> buckets; /**< a power of two number of heaps, bucket i holding the items of all days d with d % buckets.size() == i */
+    size_t numItems = 0;
+    int64_t currentDay = 0; /**< no item is earlier than this day (time / width) */
+    size_t firstBucket = npos; /**< bucket of the first item, if known */
+    size_t numDirectSearches = 0; /**< searches for the first item that had to look at all buckets since the last resize */
+    uint64_t nextSequence = 0;
+};
+
+template <typename T, typename Position>
+constexpr size_t CalendarQueue<T, Position>::minBuckets;
+template <typename T, typename Position>
+constexpr size_t CalendarQueue<T, Position>::npos;
+template <typename T, typename Position>
+constexpr size_t CalendarQueue<T, Position>::widthSamples;
+
+} // namespace veins
@@ -25,6 +25,10 @@
 
 #include "veins/base/utils/Coord.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace veins;
 
 const Coord Coord::ZERO = Coord(0.0, 0.0, 0.0);
@@ -58,3 +62,34 @@ double Coord::sqrTorusDist(const Coord& b, const Coord& size) const
     double zDist = dist(z, b.z, size.z);
     return xDist * xDist + yDist * yDist + zDist * zDist;
 }
+
+void veins::distancesSquared(const Coord& from, const Coord* to, size_t n, double* out) noexcept
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = from.sqrdist(to[i]);
+    }
+}
+
+void veins::distancesSquared(const Coord& from, const double* xs, const double* ys, const double* zs, size_t n, double* out) noexcept
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    // two coordinates per instruction, same operations (and order thereof) as Coord::sqrdist()
+    const __m128d fromX = _mm_set1_pd(from.x);
+    const __m128d fromY = _mm_set1_pd(from.y);
+    const __m128d fromZ = _mm_set1_pd(from.z);
+    for (; i + 2 <= n; i += 2) {
+        const __m128d dx = _mm_sub_pd(fromX, _mm_loadu_pd(xs + i));
+        const __m128d dy = _mm_sub_pd(fromY, _mm_loadu_pd(ys + i));
+        const __m128d dz = _mm_sub_pd(fromZ, _mm_loadu_pd(zs + i));
+        const __m128d sum = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+        _mm_storeu_pd(out + i, sum);
+    }
+#endif
+    for (; i < n; ++i) {
+        const double dx = from.x - xs[i];
+        const double dy = from.y - ys[i];
+        const double dz = from.z - zs[i];
+        out[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
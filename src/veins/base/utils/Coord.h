@@ -57,7 +57,7 @@ public:
     /*@}*/
 
 private:
-    void copy(const Coord& other)
+    void copy(const Coord& other) noexcept
     {
         x = other.x;
         y = other.y;
@@ -66,7 +66,7 @@ private:
 
 public:
     /** @brief Default constructor. */
-    Coord()
+    Coord() noexcept
         : x(0.0)
         , y(0.0)
         , z(0.0)
@@ -74,7 +74,7 @@ public:
     }
 
     /** @brief Initializes a coordinate. */
-    Coord(double x, double y, double z = 0.0)
+    Coord(double x, double y, double z = 0.0) noexcept
         : x(x)
         , y(y)
         , z(z)
@@ -82,7 +82,7 @@ public:
     }
 
     /** @brief Initializes coordinate from other coordinate. */
-    Coord(const Coord& other)
+    Coord(const Coord& other) noexcept
         : cObject(other)
     {
         copy(other);
@@ -100,27 +100,21 @@ public:
 #endif
 
     /** @brief Adds two coordinate vectors. */
-    friend Coord operator+(const Coord& a, const Coord& b)
+    friend Coord operator+(const Coord& a, const Coord& b) noexcept
     {
-        Coord tmp(a);
-        tmp += b;
-        return tmp;
+        return Coord(a.x + b.x, a.y + b.y, a.z + b.z);
     }
 
     /** @brief Subtracts two coordinate vectors. */
-    friend Coord operator-(const Coord& a, const Coord& b)
+    friend Coord operator-(const Coord& a, const Coord& b) noexcept
     {
-        Coord tmp(a);
-        tmp -= b;
-        return tmp;
+        return Coord(a.x - b.x, a.y - b.y, a.z - b.z);
     }
 
     /** @brief Multiplies a coordinate vector by a real number. */
-    friend Coord operator*(const Coord& a, double f)
+    friend Coord operator*(const Coord& a, double f) noexcept
     {
-        Coord tmp(a);
-        tmp *= f;
-        return tmp;
+        return Coord(a.x * f, a.y * f, a.z * f);
     }
 
     /**
@@ -130,7 +124,7 @@ public:
      * Takes two equal-length sequences of numbers (usually coordinate vectors) and returns a single number.
      * in Euclidean geometry: the dot product of the Cartesian coordinates of two vectors (i.e. inner product).
      */
-    friend double operator*(const Coord& a, const Coord& b)
+    friend double operator*(const Coord& a, const Coord& b) noexcept
     {
         return (a.x * b.x + a.y * b.y);
     }
@@ -141,23 +135,21 @@ public:
      * The 3D cross product will be perpendicular to that plane, and thus have 0 X & Y components
      * (thus the scalar returned is the Z value of the 3D cross product vector).
      */
-    double twoDimensionalCrossProduct(const Coord& a) const
+    double twoDimensionalCrossProduct(const Coord& a) const noexcept
     {
         return (x * a.y - y * a.x);
     }
 
     /** @brief Divides a coordinate vector by a real number. */
-    friend Coord operator/(const Coord& a, double f)
+    friend Coord operator/(const Coord& a, double f) noexcept
     {
-        Coord tmp(a);
-        tmp /= f;
-        return tmp;
+        return Coord(a.x / f, a.y / f, a.z / f);
     }
 
     /**
      * @brief Multiplies this coordinate vector by a real number.
      */
-    Coord& operator*=(double f)
+    Coord& operator*=(double f) noexcept
     {
         x *= f;
         y *= f;
@@ -168,7 +160,7 @@ public:
     /**
      * @brief Divides this coordinate vector by a real number.
      */
-    Coord& operator/=(double f)
+    Coord& operator/=(double f) noexcept
     {
         x /= f;
         y /= f;
@@ -179,7 +171,7 @@ public:
     /**
      * @brief Adds coordinate vector 'a' to this.
      */
-    Coord& operator+=(const Coord& a)
+    Coord& operator+=(const Coord& a) noexcept
     {
         x += a.x;
         y += a.y;
@@ -192,7 +184,7 @@ public:
      *
      * This operator can change the dimension of the coordinate.
      */
-    Coord& operator=(const Coord& other)
+    Coord& operator=(const Coord& other) noexcept
     {
         if (this == &other) return *this;
         cObject::operator=(other);
@@ -203,7 +195,7 @@ public:
     /**
      * @brief Subtracts coordinate vector 'a' from this.
      */
-    Coord& operator-=(const Coord& a)
+    Coord& operator-=(const Coord& a) noexcept
     {
         x -= a.x;
         y -= a.y;
@@ -218,7 +210,7 @@ public:
      * @see math::almost_equal
      *
      */
-    friend bool operator==(const Coord& a, const Coord& b)
+    friend bool operator==(const Coord& a, const Coord& b) noexcept
     {
         // FIXME: this implementation is not transitive
         return math::almost_equal(a.x, b.x) && math::almost_equal(a.y, b.y) && math::almost_equal(a.z, b.z);
@@ -229,7 +221,7 @@ public:
      *
      * Negation of the operator==.
      */
-    friend bool operator!=(const Coord& a, const Coord& b)
+    friend bool operator!=(const Coord& a, const Coord& b) noexcept
     {
         return !(a == b);
     }
@@ -237,19 +229,20 @@ public:
     /**
      * @brief Returns the distance to Coord 'a'.
      */
-    double distance(const Coord& a) const
+    double distance(const Coord& a) const noexcept
     {
-        Coord dist(*this - a);
-        return dist.length();
+        return sqrt(sqrdist(a));
     }
 
     /**
      * @brief Returns distance^2 to Coord 'a' (omits calling square root).
      */
-    double sqrdist(const Coord& a) const
+    double sqrdist(const Coord& a) const noexcept
     {
-        Coord dist(*this - a);
-        return dist.squareLength();
+        const double dx = x - a.x;
+        const double dy = y - a.y;
+        const double dz = z - a.z;
+        return dx * dx + dy * dy + dz * dz;
     }
 
     /**
@@ -260,7 +253,7 @@ public:
     /**
      * @brief Returns the square of the length of this Coords position vector.
      */
-    double squareLength() const
+    double squareLength() const noexcept
     {
         return x * x + y * y + z * z;
     }
@@ -268,7 +261,7 @@ public:
     /**
      * @brief Returns the length of this Coords position vector.
      */
-    double length() const
+    double length() const noexcept
     {
         return sqrt(squareLength());
     }
@@ -279,7 +272,7 @@ public:
      * @param lowerBound The upper bound of the rectangle.
      * @param upperBound The lower bound of the rectangle.
      */
-    bool isInBoundary(const Coord& lowerBound, const Coord& upperBound) const
+    bool isInBoundary(const Coord& lowerBound, const Coord& upperBound) const noexcept
     {
         return lowerBound.x <= x && x <= upperBound.x && lowerBound.y <= y && y <= upperBound.y && lowerBound.z <= z && z <= upperBound.z;
     }
@@ -287,7 +280,7 @@ public:
     /**
      * @brief Returns the minimal coordinates.
      */
-    Coord min(const Coord& a)
+    Coord min(const Coord& a) const noexcept
     {
         return Coord(this->x < a.x ? this->x : a.x, this->y < a.y ? this->y : a.y, this->z < a.z ? this->z : a.z);
     }
@@ -295,7 +288,7 @@ public:
     /**
      * @brief Returns the maximal coordinates.
      */
-    Coord max(const Coord& a)
+    Coord max(const Coord& a) const noexcept
     {
         return Coord(this->x > a.x ? this->x : a.x, this->y > a.y ? this->y : a.y, this->z > a.z ? this->z : a.z);
     }
@@ -307,15 +300,17 @@ public:
      *
      * @param rad: angle to rotate by (in rad)
      */
-    Coord rotatedYaw(double rad) const
+    Coord rotatedYaw(double rad) const noexcept
     {
-        return Coord(x * cos(rad) - y * sin(rad), x * sin(rad) + y * cos(rad), z);
+        const double c = cos(rad);
+        const double s = sin(rad);
+        return Coord(x * c - y * s, x * s + y * c, z);
     }
 
     /**
      * @brief Returns this coord when after inverting y axis
      */
-    Coord flippedY() const
+    Coord flippedY() const noexcept
     {
         return Coord(x, -y, z);
     }
@@ -323,12 +318,27 @@ public:
     /**
      * @brief Return a new coord with the z coordinate set to newZ
      */
-    Coord atZ(double newZ) const
+    Coord atZ(double newZ) const noexcept
     {
         return Coord(x, y, newZ);
     }
 };
 
+/**
+ * @brief Stores the squared distances from 'from' to each of the n coordinates in 'to' in 'out'.
+ *
+ * Equivalent to calling from.sqrdist() for each of them, meant for range checks against many hosts at once.
+ */
+VEINS_API void distancesSquared(const Coord& from, const Coord* to, size_t n, double* out) noexcept;
+
+/**
+ * @brief Stores the squared distances from 'from' to each of the n coordinates given by 'xs', 'ys', and 'zs' in 'out'.
+ *
+ * Like distancesSquared(const Coord&, const Coord*, size_t, double*), but for coordinates stored as separate arrays (e.g., in MobilityStateStore),
+ * which lets it process several coordinates per instruction.
+ */
+VEINS_API void distancesSquared(const Coord& from, const double* xs, const double* ys, const double* zs, size_t n, double* out) noexcept;
+
 inline std::ostream& operator<<(std::ostream& os, const Coord& coord)
 {
     return os << "(" << coord.x << "," << coord.y << "," << coord.z << ")";
@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/CounterRng.h"
+
+#include <cmath>
+
+using namespace veins;
+
+namespace {
+
+const uint32_t PHILOX_M0 = 0xD2511F53;
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+
+inline void philoxRound(CounterRng::Block& ctr, uint32_t key0, uint32_t key1)
+{
+    const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * ctr[0];
+    const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * ctr[2];
+    ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key0, static_cast<uint32_t>(p1), static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key1, static_cast<uint32_t>(p0)};
+}
+
+} // namespace
+
+CounterRng::Block CounterRng::philox(Block counter, uint32_t key0, uint32_t key1) noexcept
+{
+    for (int round = 0; round < 10; ++round) {
+        if (round > 0) {
+            key0 += PHILOX_W0;
+            key1 += PHILOX_W1;
+        }
+        philoxRound(counter, key0, key1);
+    }
+    return counter;
+}
+
+int CounterRng::intuniform(int a, int b)
+{
+    if (a > b) throw cRuntimeError("CounterRng::intuniform(): arguments must satisfy a<=b");
+
+    // multiply-and-reject (Lemire), which is unbiased and, unlike a modulo, needs no division in the common case
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(b) - a) + 1;
+    uint64_t product = static_cast<uint64_t>(nextUint32()) * range;
+    if (static_cast<uint32_t>(product) < range) {
+        const uint32_t threshold = static_cast<uint32_t>((UINT64_C(0x100000000) - range) % range);
+        while (static_cast<uint32_t>(product) < threshold) {
+            product = static_cast<uint64_t>(nextUint32()) * range;
+        }
+    }
+    return static_cast<int>(a + static_cast<int64_t>(product >> 32));
+}
+
+double CounterRng::normal(double mean, double stddev)
+{
+    // Box-Muller; 1 - dblrand() is in (0, 1], so the logarithm is finite
+    const double u1 = 1.0 - dblrand();
+    const double u2 = dblrand();
+    return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+double CounterRng::gamma_d(double alpha, double theta)
+{
+    if (alpha <= 0 || theta <= 0) throw cRuntimeError("CounterRng::gamma_d(): alpha and theta params must be positive (alpha=%g, theta=%g)", alpha, theta);
+
+    if (alpha < 1) {
+        // boost the shape above 1 and scale back down, see Marsaglia and Tsang
+        const double u = 1.0 - dblrand();
+        return gamma_d(alpha + 1, theta) * std::pow(u, 1.0 / alpha);
+    }
+
+    // G. Marsaglia, W. W. Tsang: "A Simple Method for Generating Gamma Variables", ACM TOMS 26(3), 2000
+    const double d = alpha - 1.0 / 3.0;
+    const double c = 1.0 / std::sqrt(9.0 * d);
+    while (true) {
+        double x;
+        double v;
+        do {
+            x = normal(0, 1);
+            v = 1.0 + c * x;
+        } while (v <= 0);
+        v = v * v * v;
+        const double u = 1.0 - dblrand();
+        if (std::log(u) < 0.5 * x * x + d - d * v + d * std::log(v)) return d * v * theta;
+    }
+}
@@ -0,0 +1,143 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Counter-based random numbers (Philox4x32-10), keyed by what they are drawn for instead of by when.
+ *
+ * A draw from a sequential RNG depends on all draws made from it before, so evaluating receptions in a different order
+ * (or on worker threads) changes their outcome. A CounterRng instead encrypts a counter made of a purpose, two ids
+ * (e.g., of a transmission and its receiver), and the index of the draw, so each stream yields the same numbers
+ * no matter how many other streams were drawn from in the meantime.
+ *
+ * A stream is cheap to construct; make one per (purpose, ids) wherever numbers are needed.
+ * It supports up to 2^32 blocks of four 32-bit numbers.
+ *
+ * @see J. K. Salmon, M. A. Moraes, R. O. Dror, D. E. Shaw: "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011.
+ *
+ * @ingroup baseUtils
+ * @ingroup utils
+ */
+class VEINS_API CounterRng {
+public:
+    /**
+     * @brief What numbers are drawn for; streams of different purposes are independent even for the same ids.
+     */
+    enum class Purpose : uint32_t {
+        fading = 1, ///< small-scale fading of a signal (ids: transmission, receiver)
+        backoff = 2, ///< backoff slots of a MAC (ids: module, channel)
+        sampling = 3, ///< whether to record a result (ids: e.g., transmission, receiver)
+        shadowing = 4, ///< samples of a shadowing field (ids: row of the field)
+        task = 5, ///< tasks run on the worker threads of a TaskScheduler (ids: run, task)
+    };
+
+    using Block = std::array<uint32_t, 4>;
+
+    /**
+     * Encrypts a counter with a key, returning four independent uniformly distributed 32-bit numbers.
+     */
+    static Block philox(Block counter, uint32_t key0, uint32_t key1) noexcept;
+
+    /**
+     * Draws a seed from a (sequential) RNG, e.g., a module RNG during initialization.
+     */
+    static uint64_t drawSeed(cRNG* rng)
+    {
+        const uint64_t hi = rng->intRand();
+        return (hi << 32) | rng->intRand();
+    }
+
+    /**
+     * Creates the stream for the given purpose and ids.
+     *
+     * @param seed of the stream, e.g., from drawSeed()
+     */
+    CounterRng(uint64_t seed, Purpose purpose, uint32_t id1, uint32_t id2 = 0) noexcept
+        : key0(static_cast<uint32_t>(seed))
+        , key1(static_cast<uint32_t>(seed >> 32))
+        , counter({0, static_cast<uint32_t>(purpose), id1, id2})
+    {
+    }
+
+    /**
+     * Returns a uniformly distributed 32-bit number.
+     */
+    uint32_t nextUint32() noexcept
+    {
+        if (used == block.size()) {
+            block = philox(counter, key0, key1);
+            ++counter[0];
+            used = 0;
+        }
+        return block[used++];
+    }
+
+    /**
+     * Returns a number drawn uniformly from [0, 1), with 53 bits of precision.
+     */
+    double dblrand() noexcept
+    {
+        const uint64_t hi = nextUint32() >> 5;
+        const uint64_t lo = nextUint32() >> 6;
+        return static_cast<double>((hi << 26) | lo) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * Returns an integer drawn uniformly from [a, b] (like cComponent::intuniform).
+     */
+    int intuniform(int a, int b);
+
+    /**
+     * Returns a number drawn from a normal distribution (like cComponent::normal).
+     */
+    double normal(double mean, double stddev);
+
+    /**
+     * Returns a number drawn from a gamma distribution with shape alpha and scale theta (like cComponent::gamma_d).
+     */
+    double gamma_d(double alpha, double theta);
+
+    /**
+     * Returns the number of blocks drawn so far.
+     */
+    uint32_t getNumBlocks() const noexcept
+    {
+        return counter[0];
+    }
+
+private:
+    uint32_t key0;
+    uint32_t key1;
+    Block counter; ///< index of the next block, purpose, id1, id2
+    Block block = {};
+    size_t used = 4; ///< number of values of block already returned
+};
+
+} // namespace veins
@@ -0,0 +1,133 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/EventBudget.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#include "veins/base/messages/AirFrame_m.h"
+
+using veins::EventBudget;
+
+Register_Class(EventBudget);
+
+namespace {
+
+const char* airFrameStateName(int state)
+{
+    // see BasePhyLayer::AirFrameState
+    switch (state) {
+    case 1:
+        return "start_receive";
+    case 2:
+        return "receiving";
+    case 3:
+        return "end_receive";
+    default:
+        return "unknown";
+    }
+}
+
+} // namespace
+
+EventBudget::EventBudget(const char* name)
+    : cEventHeap(name)
+{
+    getEnvir()->addLifecycleListener(this);
+}
+
+EventBudget::~EventBudget()
+{
+    getEnvir()->removeLifecycleListener(this);
+}
+
+EventBudget::Key EventBudget::getKey(cEvent* event)
+{
+    auto msg = dynamic_cast<cMessage*>(event);
+    if (!msg) return Key("-", event->getClassName(), event->getName());
+
+    cModule* module = msg->getArrivalModule();
+    std::string moduleType = module ? module->getNedTypeName() : "-";
+    if (auto frame = dynamic_cast<AirFrame*>(msg)) {
+        return Key(moduleType, msg->getClassName(), airFrameStateName(frame->getState()));
+    }
+    return Key(moduleType, msg->getClassName(), msg->getName());
+}
+
+void EventBudget::insert(cEvent* event)
+{
+    tallies[getKey(event)].scheduled++;
+    cEventHeap::insert(event);
+}
+
+cEvent* EventBudget::removeFirst()
+{
+    cEvent* event = cEventHeap::removeFirst();
+    if (event) tallies[getKey(event)].processed++;
+    return event;
+}
+
+cEvent* EventBudget::remove(cEvent* event)
+{
+    cEvent* removed = cEventHeap::remove(event);
+    if (removed) tallies[getKey(removed)].cancelled++;
+    return removed;
+}
+
+void EventBudget::putBackFirst(cEvent* event)
+{
+    // not processed after all, will be counted again when removed
+    tallies[getKey(event)].processed--;
+    cEventHeap::putBackFirst(event);
+}
+
+void EventBudget::lifecycleEvent(SimulationLifecycleEventType eventType, cObject* details)
+{
+    if (eventType == LF_PRE_NETWORK_FINISH) {
+        print(getEnvir()->getOStream());
+    }
+}
+
+void EventBudget::print(std::ostream& os) const
+{
+    std::vector<std::pair<Key, Tally>> sorted(tallies.begin(), tallies.end());
+    std::stable_sort(sorted.begin(), sorted.end(), [](const std::pair<Key, Tally>& a, const std::pair<Key, Tally>& b) { return a.second.processed > b.second.processed; });
+
+    uint64_t totalProcessed = 0;
+    for (const auto& entry : sorted) {
+        totalProcessed += entry.second.processed;
+    }
+
+    const std::ios_base::fmtflags flags = os.flags();
+    os << "Event budget (" << totalProcessed << " events processed):" << std::endl;
+    os << std::setw(12) << "processed" << std::setw(8) << "share" << std::setw(12) << "scheduled" << std::setw(12) << "cancelled"
+       << "  module type / message class / message kind" << std::endl;
+    for (const auto& entry : sorted) {
+        const Tally& tally = entry.second;
+        const double share = totalProcessed ? 100.0 * tally.processed / totalProcessed : 0;
+        os << std::setw(12) << tally.processed << std::setw(7) << std::fixed << std::setprecision(1) << share << "%" << std::setw(12) << tally.scheduled << std::setw(12) << tally.cancelled
+           << "  " << std::get<0>(entry.first) << " / " << std::get<1>(entry.first) << " / " << std::get<2>(entry.first) << std::endl;
+    }
+    os.flags(flags);
+}
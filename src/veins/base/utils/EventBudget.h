@@ -0,0 +1,92 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Future event set tallying scheduled, processed, and cancelled events by module type and message kind.
+ *
+ * Off by default. Enable by adding
+ *
+ *   futureeventset-class = "veins::EventBudget"
+ *
+ * to the [General] section of the omnetpp.ini.
+ * Events are keyed by the NED type of their arrival module, their message class, and their message name
+ * (for AirFrames: the state of the PHY's reception state machine instead, as the name is that of the encapsulated packet).
+ * Registers itself as a lifecycle listener and prints the tallies, sorted by number of processed events, just before the network is finished.
+ * Tallying costs a lookup per event, so do not enable it for performance measurements.
+ */
+class VEINS_API EventBudget : public cEventHeap, public cISimulationLifecycleListener {
+public:
+    /**
+     * @brief Tallies of one kind of event.
+     */
+    struct Tally {
+        uint64_t scheduled = 0;
+        uint64_t processed = 0;
+        uint64_t cancelled = 0;
+    };
+
+    /**
+     * @brief Module NED type, message class, and message kind (name or AirFrame state).
+     */
+    using Key = std::tuple<std::string, std::string, std::string>;
+
+    EventBudget(const char* name = nullptr);
+    ~EventBudget() override;
+
+    void insert(cEvent* event) override;
+    cEvent* removeFirst() override;
+    cEvent* remove(cEvent* event) override;
+    void putBackFirst(cEvent* event) override;
+
+    void lifecycleEvent(SimulationLifecycleEventType eventType, cObject* details) override;
+
+    const std::map<Key, Tally>& getTallies() const
+    {
+        return tallies;
+    }
+
+    /**
+     * @brief Prints the tallies, sorted by number of processed events.
+     */
+    void print(std::ostream& os) const;
+
+    /**
+     * @brief Returns the key an event is tallied under.
+     */
+    static Key getKey(cEvent* event);
+
+private:
+    std::map<Key, Tally> tallies;
+};
+
+} // namespace veins
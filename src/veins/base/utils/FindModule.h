@@ -24,8 +24,13 @@
 
 #pragma once
 
+#include <typeinfo>
+#include <typeindex>
+
 #include "veins/veins.h"
 
+#include "veins/base/utils/ModuleRegistry.h"
+
 namespace veins {
 
 /**
@@ -56,6 +61,23 @@ public:
         }
         return NULL;
     }
+    /**
+     * @brief Like findSubModule(), but remembers the result for the passed module.
+     *
+     * Meant for lookups within hosts, which are repeated by many of their modules (and again whenever a host is reused).
+     * The result must not be deleted before the passed module, see ModuleRegistry::getCachedSubModule().
+     */
+    static T findSubModuleCached(const cModule* const top)
+    {
+        const std::type_index type(typeid(T));
+        if (cModule* cached = ModuleRegistry::getCachedSubModule(top->getId(), type)) {
+            return dynamic_cast<T>(cached);
+        }
+        T found = findSubModule(top);
+        if (found != NULL) ModuleRegistry::cacheSubModule(top->getId(), type, const_cast<cModule*>(dynamic_cast<const cModule*>(found)));
+        return found;
+    }
+
     /**
      * @brief Returns a list of pointers to sub modules of the passed module with
      * the type of this template.
@@ -82,9 +104,14 @@ public:
      * template.
      *
      * Returns NULL if no module of this type could be found.
+     * Singleton modules registered with ModuleRegistry are found without searching the module tree.
      */
     static T findGlobalModule()
     {
+        for (cModule* const module : ModuleRegistry::getGlobalModules()) {
+            T dCastRet = dynamic_cast<T>(module);
+            if (dCastRet != NULL) return dCastRet;
+        }
         return findSubModule(getSimulation()->getSystemModule());
     }
 
@@ -142,7 +169,7 @@ public:
     T* const get(cModule* const from = nullptr)
     {
         if (!pModule) {
-            pModule = FindModule<T*>::findSubModule(FindModule<>::findHost(from != nullptr ? from : getSimulation()->getContextModule()));
+            pModule = FindModule<T*>::findSubModuleCached(FindModule<>::findHost(from != nullptr ? from : getSimulation()->getContextModule()));
         }
         return pModule;
     }
@@ -0,0 +1,135 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Hash map from 64 bit keys to values, using open addressing with linear probing.
+ *
+ * All entries live in one contiguous table (of a power of two size, at most half full),
+ * so a lookup usually touches a single cache line and no nodes are allocated per entry.
+ *
+ * Entries cannot be erased; references to values are invalidated by insertions that grow the table.
+ */
+template <typename Value>
+class VEINS_API FlatHashMap {
+public:
+    using Key = uint64_t;
+
+    explicit FlatHashMap(size_t initialCapacity = 16)
+    {
+        size_t capacity = 16;
+        while (capacity < 2 * initialCapacity) capacity *= 2;
+        slots.resize(capacity);
+    }
+
+    /** @brief Returns the value stored for key, or nullptr if there is none. */
+    const Value* find(Key key) const
+    {
+        for (size_t i = indexOf(key);; i = (i + 1) & mask()) {
+            const Slot& slot = slots[i];
+            if (!slot.used) return nullptr;
+            if (slot.key == key) return &slot.value;
+        }
+    }
+
+    Value* find(Key key)
+    {
+        return const_cast<Value*>(static_cast<const FlatHashMap*>(this)->find(key));
+    }
+
+    /** @brief Returns the value stored for key, inserting a default constructed one if there is none. */
+    Value& operator[](Key key)
+    {
+        if (2 * (numEntries + 1) > slots.size()) grow();
+        for (size_t i = indexOf(key);; i = (i + 1) & mask()) {
+            Slot& slot = slots[i];
+            if (!slot.used) {
+                slot.used = true;
+                slot.key = key;
+                numEntries++;
+                return slot.value;
+            }
+            if (slot.key == key) return slot.value;
+        }
+    }
+
+    size_t size() const
+    {
+        return numEntries;
+    }
+
+    size_t capacity() const
+    {
+        return slots.size();
+    }
+
+    /** @brief Returns the number of bytes held by the table (not by the values themselves) */
+    size_t bytesOfTable() const
+    {
+        return slots.capacity() * sizeof(Slot);
+    }
+
+private:
+    struct Slot {
+        Key key = 0;
+        bool used = false;
+        Value value;
+    };
+
+    size_t mask() const
+    {
+        return slots.size() - 1;
+    }
+
+    /** @brief Returns the preferred slot of key (mixing its bits, as packed keys differ in a few bits only). */
+    size_t indexOf(Key key) const
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<size_t>(key) & mask();
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old(slots.size() * 2);
+        std::swap(old, slots);
+        numEntries = 0;
+        for (auto& slot : old) {
+            if (slot.used) (*this)[slot.key] = std::move(slot.value);
+        }
+    }
+
+    std::vector<Slot> slots;
+    size_t numEntries = 0;
+};
+
+} // namespace veins
@@ -42,7 +42,7 @@ public:
     /**
      * Creates an undefined Heading.
      */
-    Heading()
+    constexpr Heading() noexcept
         : rad(std::numeric_limits<double>::quiet_NaN())
     {
     }
@@ -50,7 +50,7 @@ public:
     /**
      * Creates a new Heading from an angle (in rad, with 0 degrees being east and 90 degrees being north).
      */
-    explicit Heading(double rad)
+    constexpr explicit Heading(double rad) noexcept
         : rad(rad)
     {
     }
@@ -58,7 +58,7 @@ public:
     /**
      * Returns the angle (in rad, with 0 degrees being east and 90 degrees being north).
      */
-    double getRad() const
+    constexpr double getRad() const noexcept
     {
         return rad;
     }
@@ -66,16 +66,16 @@ public:
     /**
      * Test for nan.
      */
-    bool isNan() const
+    constexpr bool isNan() const noexcept
     {
-        return std::isnan(rad);
+        return rad != rad;
     }
 
     /**
      * @brief Returns Coord of a unit vector (with x pointing east and y pointing south).
      * @param length: length of vector (dimensionless)
      */
-    Coord toCoord(double length = 1) const
+    Coord toCoord(double length = 1) const noexcept
     {
         return Coord(cos(rad) * length, -sin(rad) * length);
     }
@@ -83,7 +83,7 @@ public:
     /**
      * @brief Converts Coord to heading (with x pointing east and y pointing south).
      */
-    static Heading fromCoord(Coord o)
+    static Heading fromCoord(const Coord& o) noexcept
     {
         return Heading(atan2(-o.y, o.x));
     }
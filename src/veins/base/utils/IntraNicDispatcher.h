@@ -0,0 +1,159 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Passes messages between the phy and the mac of one NIC by direct calls instead of zero delay sends.
+ *
+ * Every message a layer sends to the other would otherwise be an event in the future event set. Here it is queued instead
+ * and delivered as soon as the layer that sent it is done with what it is handling (see Activation), or right away if
+ * neither layer is handling anything (e.g., when called by another module). A layer is thus never re-entered by what it
+ * sends, and the messages exchanged in reaction to one event are handled in the order they were sent, just before the
+ * simulation moves on to the next event. Events of other modules at the same simulation time are no longer interleaved
+ * with this exchange, which is the only difference to sending the messages. Messages that are to arrive later (i.e., that
+ * a layer would send delayed) cannot be passed this way and still need to be sent via gates.
+ *
+ * @ingroup baseUtils
+ */
+class VEINS_API IntraNicDispatcher {
+public:
+    /**
+     * @brief A layer messages are delivered to.
+     */
+    class VEINS_API Receiver {
+    public:
+        virtual ~Receiver() = default;
+
+        /**
+         * @brief Handles a message of the other layer, taking ownership of it (control: whether it was sent as a control message).
+         */
+        virtual void receiveFromNic(cMessage* msg, bool control) = 0;
+    };
+
+    /**
+     * @brief Marks one of the layers as busy handling an event (or a call) while in scope, delivering queued messages when the outermost one ends.
+     */
+    class VEINS_API Activation {
+    public:
+        explicit Activation(IntraNicDispatcher* dispatcher)
+            : dispatcher(dispatcher)
+        {
+            if (dispatcher) dispatcher->depth++;
+        }
+        ~Activation()
+        {
+            if (dispatcher && --dispatcher->depth == 0) dispatcher->deliver();
+        }
+        Activation(const Activation&) = delete;
+        Activation& operator=(const Activation&) = delete;
+
+    private:
+        IntraNicDispatcher* dispatcher;
+    };
+
+    void setLower(Receiver* receiver)
+    {
+        lower = receiver;
+    }
+    void setUpper(Receiver* receiver)
+    {
+        upper = receiver;
+    }
+    bool isConnected() const
+    {
+        return lower && upper;
+    }
+
+    /**
+     * @brief Sends msg to the upper layer (the mac).
+     */
+    void postUp(cMessage* msg, bool control)
+    {
+        post(upper, msg, control);
+    }
+
+    /**
+     * @brief Sends msg to the lower layer (the phy).
+     */
+    void postDown(cMessage* msg, bool control)
+    {
+        post(lower, msg, control);
+    }
+
+    /**
+     * @brief Returns the number of messages delivered so far.
+     */
+    long getNumDelivered() const
+    {
+        return numDelivered;
+    }
+
+    /**
+     * @brief Restarts getNumDelivered() from zero.
+     */
+    void resetStatistics()
+    {
+        numDelivered = 0;
+    }
+
+private:
+    struct Posted {
+        Receiver* receiver;
+        cMessage* msg;
+        bool control;
+    };
+
+    void post(Receiver* receiver, cMessage* msg, bool control)
+    {
+        ASSERT(receiver);
+        queue.push_back({receiver, msg, control});
+        if (depth == 0) deliver();
+    }
+
+    void deliver()
+    {
+        // the receivers count as busy, so what they send is appended and delivered by this loop
+        depth++;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            Posted posted = queue[i];
+            numDelivered++;
+            posted.receiver->receiveFromNic(posted.msg, posted.control);
+        }
+        queue.clear();
+        depth--;
+    }
+
+    Receiver* lower = nullptr;
+    Receiver* upper = nullptr;
+    std::vector<Posted> queue; /**< messages not yet delivered (kept allocated) */
+    int depth = 0; /**< number of Activations (and deliveries) in progress */
+    long numDelivered = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/Coord.h"
+
+namespace veins {
+
+/**
+ * @brief Geometry of a link between a sender and a receiver, computed once and shared by everyone evaluating the link.
+ *
+ * Angles are only computed when first asked for.
+ *
+ * @ingroup utils
+ */
+class VEINS_API LinkGeometry {
+public:
+    LinkGeometry() = default;
+
+    LinkGeometry(const Coord& senderPos, const Coord& receiverPos)
+        : senderPos(senderPos)
+        , receiverPos(receiverPos)
+        , delta(receiverPos.x - senderPos.x, receiverPos.y - senderPos.y, receiverPos.z - senderPos.z)
+        , sqrDistance(receiverPos.sqrdist(senderPos))
+        , distance(std::sqrt(sqrDistance))
+        , distance2D(std::sqrt(delta.x * delta.x + delta.y * delta.y))
+        , direction(distance > 0 ? delta / distance : Coord())
+    {
+    }
+
+    /**
+     * Returns the azimuth of direction (in rad, with 0 being east and pi/2 being north, see Heading).
+     */
+    double getAzimuth() const
+    {
+        if (std::isnan(azimuth)) azimuth = std::atan2(-delta.y, delta.x);
+        return azimuth;
+    }
+
+    /**
+     * Returns the elevation of direction (in rad, positive if the receiver is above the sender).
+     */
+    double getElevation() const
+    {
+        if (std::isnan(elevation)) elevation = std::atan2(delta.z, distance2D);
+        return elevation;
+    }
+
+    Coord senderPos;
+    Coord receiverPos;
+    Coord delta; /**< receiverPos - senderPos */
+    double sqrDistance = 0; /**< squared (3D) distance between sender and receiver */
+    double distance = 0; /**< (3D) distance between sender and receiver */
+    double distance2D = 0; /**< distance between sender and receiver, ignoring their heights */
+    Coord direction; /**< unit vector from sender to receiver (zero if both are at the same position) */
+
+protected:
+    mutable double azimuth = std::numeric_limits<double>::quiet_NaN();
+    mutable double elevation = std::numeric_limits<double>::quiet_NaN();
+};
+
+} // namespace veins
@@ -0,0 +1,60 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins/veins.h"
+
+/**
+ * @file
+ * @brief Logging macros for hot paths of Veins, which can be compiled out independently of OMNeT++'s own COMPILETIME_LOGLEVEL.
+ *
+ * VEINS_LOG_TRACE and friends are used like EV_TRACE and friends (also from classes deriving from HasLogProxy).
+ * Their arguments are only evaluated if the statement is logged at all, so expensive ones (Coord::info(), FWMath::mW2dBm(), ...)
+ * cost nothing unless the log level is active.
+ * Statements below VEINS_COMPILETIME_LOGLEVEL are removed by the compiler altogether.
+ * It defaults to omnetpp::LOGLEVEL_INFO in release builds (NDEBUG), which removes debug and trace statements,
+ * and to omnetpp::LOGLEVEL_TRACE otherwise; use ./configure --compiletime-loglevel to change it.
+ * Statements on worker threads of a WorkerPool are skipped (arguments included), as OMNeT++'s logging is not thread safe.
+ */
+
+#ifndef VEINS_COMPILETIME_LOGLEVEL
+#ifdef NDEBUG
+#define VEINS_COMPILETIME_LOGLEVEL omnetpp::LOGLEVEL_INFO
+#else
+#define VEINS_COMPILETIME_LOGLEVEL omnetpp::LOGLEVEL_TRACE
+#endif
+#endif
+
+namespace veins {
+/** @brief Returns whether the calling thread is a worker thread of a WorkerPool (see WorkerPool.cc) */
+VEINS_API bool isWorkerThread();
+} // namespace veins
+
+// an expression of the same form as EV_LOG so it can be used wherever EV_LOG can (e.g., as the body of an unbraced if)
+#define VEINS_LOG(logLevel) \
+    ((void) 0, !((logLevel) >= VEINS_COMPILETIME_LOGLEVEL) || veins::isWorkerThread()) ? omnetpp::internal::cLogProxy::dummyStream : EV_LOG(logLevel, nullptr)
+
+#define VEINS_LOG_TRACE VEINS_LOG(omnetpp::LOGLEVEL_TRACE)
+#define VEINS_LOG_DEBUG VEINS_LOG(omnetpp::LOGLEVEL_DEBUG)
+#define VEINS_LOG_DETAIL VEINS_LOG(omnetpp::LOGLEVEL_DETAIL)
+#define VEINS_LOG_INFO VEINS_LOG(omnetpp::LOGLEVEL_INFO)
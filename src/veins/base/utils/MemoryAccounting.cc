@@ -0,0 +1,89 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/MemoryAccounting.h"
+
+#include <utility>
+
+using veins::MemoryAccounting;
+
+namespace {
+
+struct Entry {
+    const char* subsystem;
+    MemoryAccounting::Reporter reporter;
+};
+
+// reporters are registered, called, and removed by the simulation thread only
+std::map<uint64_t, Entry>& registry()
+{
+    static std::map<uint64_t, Entry> entries;
+    return entries;
+}
+
+uint64_t nextId = 1;
+
+} // namespace
+
+MemoryAccounting::Registration::Registration(Registration&& other)
+    : id(other.id)
+{
+    other.id = 0;
+}
+
+MemoryAccounting::Registration& MemoryAccounting::Registration::operator=(Registration&& other)
+{
+    if (this != &other) {
+        reset();
+        id = other.id;
+        other.id = 0;
+    }
+    return *this;
+}
+
+MemoryAccounting::Registration::~Registration()
+{
+    reset();
+}
+
+void MemoryAccounting::Registration::reset()
+{
+    if (id == 0) return;
+    registry().erase(id);
+    id = 0;
+}
+
+MemoryAccounting::Registration MemoryAccounting::add(const char* subsystem, Reporter reporter)
+{
+    const uint64_t id = nextId++;
+    registry().emplace(id, Entry{subsystem, std::move(reporter)});
+    return Registration(id);
+}
+
+std::map<std::string, MemoryAccounting::Usage> MemoryAccounting::collect()
+{
+    std::map<std::string, Usage> usage;
+    for (const auto& entry : registry()) {
+        usage[entry.second.subsystem] += entry.second.reporter();
+    }
+    return usage;
+}
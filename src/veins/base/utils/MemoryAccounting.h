@@ -0,0 +1,116 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Attributes the memory held by veins' main data structures to subsystems (e.g., "connectionManager" or "phy.channelInfo").
+ *
+ * Modules register a reporter per subsystem, which estimates the bytes and objects they currently hold (their containers and
+ * the objects in them, not the module itself). Reporters are only called when a report is collected, so bookkeeping costs
+ * nothing on the hot paths. Reports are recorded by BaseWorldUtility, see its memoryReportInterval parameter.
+ */
+class VEINS_API MemoryAccounting {
+public:
+    /**
+     * @brief Memory held by (a part of) a subsystem.
+     */
+    struct Usage {
+        size_t objects = 0;
+        size_t bytes = 0;
+
+        Usage& operator+=(const Usage& other)
+        {
+            objects += other.objects;
+            bytes += other.bytes;
+            return *this;
+        }
+    };
+
+    using Reporter = std::function<Usage()>;
+
+    /**
+     * @brief Keeps a reporter registered until destroyed (or reset).
+     */
+    class VEINS_API Registration {
+    public:
+        Registration() = default;
+        Registration(Registration&& other);
+        Registration& operator=(Registration&& other);
+        Registration(const Registration&) = delete;
+        Registration& operator=(const Registration&) = delete;
+        ~Registration();
+
+        void reset();
+
+    private:
+        friend class MemoryAccounting;
+        explicit Registration(uint64_t id)
+            : id(id)
+        {
+        }
+
+        uint64_t id = 0;
+    };
+
+    /**
+     * @brief Registers a reporter for the passed subsystem; all reporters of a subsystem are summed up.
+     *
+     * subsystem needs to outlive the registration (e.g., a string literal).
+     */
+    static Registration add(const char* subsystem, Reporter reporter);
+
+    /**
+     * @brief Calls all reporters and returns their usage, summed per subsystem.
+     */
+    static std::map<std::string, Usage> collect();
+
+    /**
+     * @brief Returns the (approximate) number of bytes held by a std::vector, i.e., its capacity.
+     */
+    template <typename T>
+    static size_t bytesOf(const T& vector)
+    {
+        return vector.capacity() * sizeof(typename T::value_type);
+    }
+
+    /**
+     * @brief Returns the (approximate) number of bytes held by a node based container (e.g., std::map), i.e., one allocation per element holding it and a few pointers.
+     */
+    template <typename T>
+    static size_t bytesOfNodes(const T& container)
+    {
+        return container.size() * (sizeof(typename T::value_type) + 4 * sizeof(void*));
+    }
+};
+
+} // namespace veins
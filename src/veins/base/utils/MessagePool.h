@@ -0,0 +1,140 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Free list of plain cMessage objects for short-lived control messages.
+ *
+ * Messages handed out by acquire() are either recycled from the free list or freshly allocated.
+ * Messages handed back by release() must be owned by the module that owns the pool (i.e., be taken first)
+ * and must not be scheduled; their control info is deleted before they are put back on the free list.
+ * At most maxFree messages are kept, surplus messages are deleted.
+ *
+ * Retaining a recycled message after passing it to release() is an error.
+ *
+ * A recycled message keeps the message id and tree id (see cMessage::getId() and cMessage::getTreeId())
+ * it got when it was allocated, as OMNeT++ only assigns them on construction. Consecutive uses of one message
+ * thus share ids (also in event logs), so pooled messages must not be told apart, or looked up, by their ids.
+ *
+ * @ingroup utils
+ */
+class VEINS_API MessagePool {
+public:
+    explicit MessagePool(size_t maxFree = 64)
+        : maxFree(maxFree)
+    {
+    }
+
+    MessagePool(const MessagePool&) = delete;
+    MessagePool& operator=(const MessagePool&) = delete;
+
+    ~MessagePool()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Returns a message with the given name and kind, reusing a released one if possible.
+     *
+     * Name, kind, scheduling priority, and context pointer are reset; ids are those of the earlier use (see above).
+     */
+    cMessage* acquire(const char* name, short kind)
+    {
+        if (freeMessages.empty()) {
+            allocations++;
+            return new cMessage(name, kind);
+        }
+        reuses++;
+        cMessage* msg = freeMessages.back();
+        freeMessages.pop_back();
+        msg->setName(name);
+        msg->setKind(kind);
+        msg->setSchedulingPriority(0);
+        msg->setContextPointer(nullptr);
+        return msg;
+    }
+
+    /**
+     * @brief Hands a message back to the pool (or deletes it if the pool is full).
+     */
+    void release(cMessage* msg)
+    {
+        ASSERT(msg && !msg->isScheduled());
+        delete msg->removeControlInfo();
+        if (freeMessages.size() >= maxFree) {
+            delete msg;
+            return;
+        }
+        freeMessages.push_back(msg);
+    }
+
+    /**
+     * @brief Deletes all messages currently held on the free list.
+     */
+    void clear()
+    {
+        for (auto msg : freeMessages) {
+            delete msg;
+        }
+        freeMessages.clear();
+    }
+
+    /** @brief Returns how many messages acquire() had to allocate. */
+    size_t getAllocations() const
+    {
+        return allocations;
+    }
+
+    /** @brief Returns how many messages acquire() recycled from the free list. */
+    size_t getReuses() const
+    {
+        return reuses;
+    }
+
+    /** @brief Restarts getAllocations() and getReuses() from zero. */
+    void resetStatistics()
+    {
+        allocations = 0;
+        reuses = 0;
+    }
+
+    /** @brief Returns the number of messages currently held on the free list. */
+    size_t getFreeCount() const
+    {
+        return freeMessages.size();
+    }
+
+private:
+    size_t maxFree;
+    std::vector<cMessage*> freeMessages;
+    size_t allocations = 0;
+    size_t reuses = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,183 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/Coord.h"
+#include "veins/base/utils/Heading.h"
+
+namespace veins {
+
+/**
+ * @brief Mobility state (position, heading, speed, and time of last update) of all hosts, stored as contiguous arrays.
+ *
+ * Each mobility module acquires a handle (an index into the arrays) once and writes its state whenever it moves;
+ * consumers holding the handle read the state without going through signals or per-module copies.
+ * Scans over all hosts (e.g., distance checks) can iterate the raw arrays directly, skipping slots whose host id is -1.
+ *
+ * Handles of released slots are reused.
+ *
+ * @see BaseWorldUtility::getMobilityStateStore()
+ *
+ * @ingroup utils
+ */
+class VEINS_API MobilityStateStore {
+public:
+    using Handle = size_t;
+    static constexpr Handle invalidHandle = static_cast<Handle>(-1);
+
+    MobilityStateStore() = default;
+    MobilityStateStore(const MobilityStateStore&) = delete;
+    MobilityStateStore& operator=(const MobilityStateStore&) = delete;
+
+    /**
+     * @brief Returns a handle to a fresh slot for the host with the given module id.
+     */
+    Handle acquire(int hostId)
+    {
+        Handle handle;
+        if (freeHandles.empty()) {
+            handle = hostIds.size();
+            xs.push_back(0);
+            ys.push_back(0);
+            zs.push_back(0);
+            headings.push_back(0);
+            speeds.push_back(0);
+            times.push_back(0);
+            hostIds.push_back(hostId);
+        }
+        else {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+            hostIds[handle] = hostId;
+            set(handle, Coord(), Heading(0), 0, 0);
+        }
+        return handle;
+    }
+
+    /**
+     * @brief Frees the slot of handle for reuse.
+     */
+    void release(Handle handle)
+    {
+        ASSERT(isValid(handle));
+        hostIds[handle] = -1;
+        freeHandles.push_back(handle);
+    }
+
+    /**
+     * @brief Stores the state of a host, as of time t.
+     */
+    void set(Handle handle, const Coord& position, Heading heading, double speed, simtime_t t)
+    {
+        ASSERT(isValid(handle));
+        xs[handle] = position.x;
+        ys[handle] = position.y;
+        zs[handle] = position.z;
+        headings[handle] = heading.getRad();
+        speeds[handle] = speed;
+        times[handle] = t.dbl();
+    }
+
+    bool isValid(Handle handle) const
+    {
+        return (handle < hostIds.size()) && (hostIds[handle] != -1);
+    }
+
+    Coord getPosition(Handle handle) const
+    {
+        return Coord(xs[handle], ys[handle], zs[handle]);
+    }
+
+    /**
+     * @brief Returns the position at time t, linearly extrapolated along heading and speed.
+     */
+    Coord getPositionAt(Handle handle, simtime_t t) const
+    {
+        double dt = t.dbl() - times[handle];
+        double distance = speeds[handle] * dt;
+        return Coord(xs[handle] + std::cos(headings[handle]) * distance, ys[handle] - std::sin(headings[handle]) * distance, zs[handle]);
+    }
+
+    Heading getHeading(Handle handle) const
+    {
+        return Heading(headings[handle]);
+    }
+
+    double getSpeed(Handle handle) const
+    {
+        return speeds[handle];
+    }
+
+    simtime_t getTime(Handle handle) const
+    {
+        return times[handle];
+    }
+
+    int getHostId(Handle handle) const
+    {
+        return hostIds[handle];
+    }
+
+    /**
+     * @brief Returns the number of slots (including released ones), i.e., the length of the arrays.
+     */
+    size_t size() const
+    {
+        return hostIds.size();
+    }
+
+    const double* getXs() const
+    {
+        return xs.data();
+    }
+    const double* getYs() const
+    {
+        return ys.data();
+    }
+    const double* getZs() const
+    {
+        return zs.data();
+    }
+    const int* getHostIds() const
+    {
+        return hostIds.data();
+    }
+
+protected:
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<double> zs;
+    std::vector<double> headings; /**< in rad, see Heading */
+    std::vector<double> speeds; /**< in m/s, along heading */
+    std::vector<double> times; /**< simulation time (in s) of the last update */
+    std::vector<int> hostIds; /**< module id of the host owning each slot (-1: slot is free) */
+    std::vector<Handle> freeHandles;
+};
+
+} // namespace veins
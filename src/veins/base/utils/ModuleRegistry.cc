@@ -0,0 +1,124 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/ModuleRegistry.h"
+
+#include <algorithm>
+
+using veins::ModuleRegistry;
+
+namespace {
+
+/**
+ * clears the lookup cache before a network is deleted (e.g., between runs of Cmdenv or when Qtenv rebuilds the network)
+ */
+class SubModuleCacheReset : public omnetpp::cISimulationLifecycleListener {
+public:
+    void ensureAdded()
+    {
+        if (added) return;
+        omnetpp::getEnvir()->addLifecycleListener(this);
+        added = true;
+    }
+
+    void lifecycleEvent(omnetpp::SimulationLifecycleEventType eventType, omnetpp::cObject* details) override
+    {
+        if (eventType == omnetpp::LF_PRE_NETWORK_DELETE) ModuleRegistry::forgetAllSubModules();
+    }
+
+    void listenerRemoved() override
+    {
+        added = false;
+    }
+
+private:
+    bool added = false;
+};
+
+SubModuleCacheReset subModuleCacheReset;
+
+} // namespace
+
+std::vector<omnetpp::cModule*>& ModuleRegistry::globalModules()
+{
+    static std::vector<cModule*> modules;
+    return modules;
+}
+
+std::map<int, std::map<std::type_index, omnetpp::cModule*>>& ModuleRegistry::subModuleCache()
+{
+    static std::map<int, std::map<std::type_index, cModule*>> cache;
+    return cache;
+}
+
+const std::vector<omnetpp::cModule*>& ModuleRegistry::getGlobalModules()
+{
+    return globalModules();
+}
+
+void ModuleRegistry::registerGlobalModule(cModule* module)
+{
+    globalModules().push_back(module);
+}
+
+void ModuleRegistry::unregisterGlobalModule(cModule* module)
+{
+    auto& modules = globalModules();
+    modules.erase(std::remove(modules.begin(), modules.end(), module), modules.end());
+
+    // lookups might have found the module
+    for (auto& top : subModuleCache()) {
+        for (auto entry = top.second.begin(); entry != top.second.end();) {
+            if (entry->second == module) {
+                entry = top.second.erase(entry);
+            }
+            else {
+                ++entry;
+            }
+        }
+    }
+}
+
+omnetpp::cModule* ModuleRegistry::getCachedSubModule(int topId, std::type_index type)
+{
+    const auto& cache = subModuleCache();
+    auto top = cache.find(topId);
+    if (top == cache.end()) return nullptr;
+    auto entry = top->second.find(type);
+    return entry != top->second.end() ? entry->second : nullptr;
+}
+
+void ModuleRegistry::cacheSubModule(int topId, std::type_index type, cModule* module)
+{
+    subModuleCacheReset.ensureAdded();
+    subModuleCache()[topId][type] = module;
+}
+
+void ModuleRegistry::forgetSubModules(int topId)
+{
+    subModuleCache().erase(topId);
+}
+
+void ModuleRegistry::forgetAllSubModules()
+{
+    subModuleCache().clear();
+}
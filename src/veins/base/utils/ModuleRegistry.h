@@ -0,0 +1,100 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <map>
+#include <typeindex>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Registry of singleton modules and cache of per-host module lookups, used by FindModule.
+ *
+ * Singleton modules (world utility, connection manager, obstacle controls, annotation manager, scenario manager)
+ * register themselves through a GlobalModuleRegistration member, so FindModule::findGlobalModule() does not need to search the module tree.
+ *
+ * @ingroup baseUtils
+ */
+class VEINS_API ModuleRegistry {
+public:
+    /**
+     * @brief Returns the registered singleton modules, in order of registration.
+     */
+    static const std::vector<cModule*>& getGlobalModules();
+
+    static void registerGlobalModule(cModule* module);
+    static void unregisterGlobalModule(cModule* module);
+
+    /**
+     * @brief Returns the cached result of looking up a submodule of type type below the module with id topId, or nullptr.
+     *
+     * Only valid as long as the submodule is not deleted on its own, which holds for the submodules of hosts.
+     */
+    static cModule* getCachedSubModule(int topId, std::type_index type);
+
+    static void cacheSubModule(int topId, std::type_index type, cModule* module);
+
+    /**
+     * @brief Forgets all lookups below the module with id topId, to be called when (parts of) it are deleted.
+     */
+    static void forgetSubModules(int topId);
+
+    /**
+     * @brief Forgets all lookups; done before the network is deleted, as the ids of its modules are reused by the next one.
+     */
+    static void forgetAllSubModules();
+
+private:
+    static std::vector<cModule*>& globalModules();
+    static std::map<int, std::map<std::type_index, cModule*>>& subModuleCache();
+};
+
+/**
+ * @brief Registers the module it is a member of with ModuleRegistry during its lifetime.
+ *
+ * Usage: add a member "GlobalModuleRegistration globalModuleRegistration{this};" to a singleton module.
+ */
+class VEINS_API GlobalModuleRegistration {
+public:
+    explicit GlobalModuleRegistration(cModule* module)
+        : module(module)
+    {
+        ModuleRegistry::registerGlobalModule(module);
+    }
+
+    ~GlobalModuleRegistration()
+    {
+        ModuleRegistry::unregisterGlobalModule(module);
+    }
+
+    GlobalModuleRegistration(const GlobalModuleRegistration&) = delete;
+    GlobalModuleRegistration& operator=(const GlobalModuleRegistration&) = delete;
+
+private:
+    cModule* const module;
+};
+
+} // namespace veins
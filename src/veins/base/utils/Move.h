@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 
 #include "veins/veins.h"
@@ -55,6 +56,8 @@ protected:
     Coord direction;
     /** @brief speed of the host in meters per second **/
     double speed;
+    /** @brief acceleration of the host along direction in meters per second squared **/
+    double acceleration;
 
 public:
     Move()
@@ -64,6 +67,7 @@ public:
         , orientation()
         , direction()
         , speed(0.0)
+        , acceleration(0.0)
     {
     }
     Move(const Move& mSrc)
@@ -73,6 +77,7 @@ public:
         , orientation(mSrc.orientation)
         , direction(mSrc.direction)
         , speed(mSrc.speed)
+        , acceleration(mSrc.acceleration)
     {
     }
 
@@ -92,6 +97,22 @@ public:
         this->speed = speed;
     }
 
+    /**
+     * @brief Returns the current acceleration along the direction of movement.
+     */
+    double getAcceleration() const
+    {
+        return acceleration;
+    }
+
+    /**
+     * @brief Sets the current acceleration along the direction of movement in meters per second squared.
+     */
+    void setAcceleration(double acceleration)
+    {
+        this->acceleration = acceleration;
+    }
+
     /**
      * @brief Returns the start position.
      */
@@ -191,15 +212,48 @@ public:
      * the startTime of the actual move pattern. So in this case one might obtain
      * an unintended result.
      *
+     * A decelerating host comes to a halt rather than reversing its direction.
      */
     virtual Coord getPositionAt(simtime_t_cref actualTime = simTime()) const
     {
+        if (acceleration != 0.0) {
+            double t = SIMTIME_DBL(actualTime - startTime);
+            if (acceleration < 0) t = std::min(t, std::max(speed, 0.0) / -acceleration);
+            return startPos + (direction * (speed * t + acceleration * t * t / 2));
+        }
+
         // if speed is very close to 0.0, the host is practically standing still
         if (math::almost_equal(speed, 0.0)) return startPos;
 
         // otherwise: actualPos = startPos + ( direction * v * t )
         return startPos + (direction * speed * SIMTIME_DBL(actualTime - startTime));
     }
+
+    /**
+     * @brief Returns the speed of the Move (Host) at the specified point in time, following its acceleration.
+     *
+     * Like getPositionAt(), a decelerating host comes to a halt rather than reversing its direction.
+     */
+    double getSpeedAt(simtime_t_cref actualTime = simTime()) const
+    {
+        return std::max(speed + acceleration * SIMTIME_DBL(actualTime - startTime), 0.0);
+    }
+
+    /**
+     * @brief Returns how long after startTime the Move (Host) will have travelled the passed distance (in meters) from startPos.
+     *
+     * If a decelerating host comes to a halt before, returns when it halts.
+     */
+    double getTravelTime(double distance) const
+    {
+        const double v = std::max(speed, 0.0);
+
+        // solve v * t + acceleration * t^2 / 2 = distance for the first t >= 0
+        const double discriminant = v * v + 2 * acceleration * distance;
+        if (acceleration < 0 && discriminant <= 0) return v / -acceleration;
+        return 2 * distance / (v + sqrt(discriminant));
+    }
+
     virtual const Coord& getStartPosition() const
     {
         if (lastPos.z != DBL_MAX) return lastPos;
@@ -222,7 +276,7 @@ public:
     {
         std::ostringstream ost;
         ost << " HostMove "
-            << " startPos: " << startPos.info() << " direction: " << direction.info() << " orientation: " << orientation.info() << " startTime: " << startTime << " speed: " << speed;
+            << " startPos: " << startPos.info() << " direction: " << direction.info() << " orientation: " << orientation.info() << " startTime: " << startTime << " speed: " << speed << " acceleration: " << acceleration;
         return ost.str();
     }
 };
@@ -51,15 +51,19 @@ public:
     Coord orientation;
 
     /**
-     * Shared pointer to the sender's antenna, which is necessary for
+     * Pointer to the sender's antenna, which is necessary for
      * the receiver to calculate the gain of the transmitting antenna.
-     * It is a shared pointer to ensure that the antenna still exists
-     * even if the sending node is already gone.
+     *
+     * Not owning, so that copying POAs (and thus Signals) does not
+     * touch any reference counts: the phy layer owning the antenna
+     * keeps it alive for as long as AirFrames sent with it may still
+     * be received, even if the sending node is already gone (see
+     * BasePhyLayer::retireAntenna()).
      */
-    std::shared_ptr<Antenna> antenna;
+    Antenna* antenna = nullptr;
 
     POA(){};
-    POA(AntennaPosition pos, Coord orientation, std::shared_ptr<Antenna> antenna)
+    POA(AntennaPosition pos, Coord orientation, Antenna* antenna)
         : pos(pos)
         , orientation(orientation)
         , antenna(antenna){};
@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/Profiling.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+using veins::ProfileCounter;
+
+namespace {
+
+std::mutex& registryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<ProfileCounter*>& registry()
+{
+    static std::vector<ProfileCounter*> counters;
+    return counters;
+}
+
+} // namespace
+
+ProfileCounter::ProfileCounter(const char* name)
+    : name(name)
+    , calls(0)
+    , nanoseconds(0)
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(this);
+}
+
+ProfileCounter::~ProfileCounter()
+{
+    // the registry outlives all counters, as it was constructed while the first one was
+    std::lock_guard<std::mutex> lock(registryMutex());
+    auto& counters = registry();
+    counters.erase(std::remove(counters.begin(), counters.end(), this), counters.end());
+}
+
+std::vector<ProfileCounter*> ProfileCounter::getAll()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    return registry();
+}
+
+void ProfileCounter::recordScalars(cComponent* component)
+{
+    for (ProfileCounter* counter : getAll()) {
+        if (counter->getCalls() == 0) continue;
+        std::string prefix = std::string("profile.") + counter->getName();
+        component->recordScalar((prefix + ".calls").c_str(), counter->getCalls());
+        component->recordScalar((prefix + ".time").c_str(), counter->getSeconds(), "s");
+        counter->reset();
+    }
+}
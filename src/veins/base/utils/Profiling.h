@@ -0,0 +1,141 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Call count and cumulative wall time of one profiled scope, see VEINS_PROFILE_SCOPE.
+ *
+ * Counters register themselves upon construction (until their destruction) and are shared by all modules (and threads) executing the scope.
+ */
+class VEINS_API ProfileCounter {
+public:
+    /**
+     * @brief Creates and registers a counter; name needs to outlive it (e.g., a string literal).
+     */
+    explicit ProfileCounter(const char* name);
+
+    /**
+     * @brief Deregisters the counter.
+     */
+    ~ProfileCounter();
+
+    ProfileCounter(const ProfileCounter&) = delete;
+    ProfileCounter& operator=(const ProfileCounter&) = delete;
+
+    const char* getName() const
+    {
+        return name;
+    }
+
+    uint64_t getCalls() const
+    {
+        return calls.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the cumulative wall time of all calls, in seconds.
+     */
+    double getSeconds() const
+    {
+        return nanoseconds.load(std::memory_order_relaxed) * 1e-9;
+    }
+
+    void add(std::chrono::steady_clock::duration duration)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        calls.store(0, std::memory_order_relaxed);
+        nanoseconds.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns all counters registered so far.
+     */
+    static std::vector<ProfileCounter*> getAll();
+
+    /**
+     * @brief Records the calls and times of all counters called at least once as scalars of the passed component, then resets them.
+     */
+    static void recordScalars(cComponent* component);
+
+private:
+    const char* name;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> nanoseconds;
+};
+
+/**
+ * @brief Adds the wall time between its construction and destruction to a ProfileCounter.
+ */
+class VEINS_API ProfileScope {
+public:
+    explicit ProfileScope(ProfileCounter& counter)
+        : counter(counter)
+        , start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ProfileScope()
+    {
+        counter.add(std::chrono::steady_clock::now() - start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileCounter& counter;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace veins
+
+#define VEINS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VEINS_PROFILE_CONCAT(a, b) VEINS_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Counts calls to (and the wall time spent in) the enclosing scope under the passed name.
+ *
+ * Only active if Veins is configured with --enable-profiling (defining VEINS_PROFILING), expands to nothing otherwise.
+ * Counters are exported as scalars by BaseWorldUtility::finish().
+ */
+#ifdef VEINS_PROFILING
+#define VEINS_PROFILE_SCOPE(name)                                                                                 \
+    static veins::ProfileCounter VEINS_PROFILE_CONCAT(veinsProfileCounter, __LINE__)(name);                       \
+    veins::ProfileScope VEINS_PROFILE_CONCAT(veinsProfileScope, __LINE__)(VEINS_PROFILE_CONCAT(veinsProfileCounter, __LINE__))
+#else
+#define VEINS_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
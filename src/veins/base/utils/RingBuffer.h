@@ -0,0 +1,158 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief FIFO queue stored in a contiguous circular buffer.
+ *
+ * A RingBuffer constructed with a capacity of 0 is unbounded and doubles its storage whenever it runs full.
+ * A bounded RingBuffer allocates its storage once on construction; pushing to a full bounded buffer is an error.
+ */
+template <typename T>
+class VEINS_API RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity = 0)
+        : bounded(capacity != 0)
+        , storage(capacity)
+    {
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    /** @brief Returns the maximum number of elements, or 0 if unbounded. */
+    size_t capacity() const
+    {
+        return bounded ? storage.size() : 0;
+    }
+
+    /** @brief Returns the number of bytes held by the storage of the elements. */
+    size_t bytesOfStorage() const
+    {
+        return storage.capacity() * sizeof(T);
+    }
+
+    bool full() const
+    {
+        return bounded && count == storage.size();
+    }
+
+    /** @brief Returns the i-th element, counting from the front. */
+    T& operator[](size_t i)
+    {
+        ASSERT(i < count);
+        return storage[wrap(head + i)];
+    }
+
+    const T& operator[](size_t i) const
+    {
+        ASSERT(i < count);
+        return storage[wrap(head + i)];
+    }
+
+    T& front()
+    {
+        return (*this)[0];
+    }
+
+    const T& front() const
+    {
+        return (*this)[0];
+    }
+
+    T& back()
+    {
+        return (*this)[count - 1];
+    }
+
+    const T& back() const
+    {
+        return (*this)[count - 1];
+    }
+
+    void push(const T& value)
+    {
+        if (count == storage.size()) {
+            ASSERT(!bounded);
+            grow();
+        }
+        storage[wrap(head + count)] = value;
+        count++;
+    }
+
+    void pop()
+    {
+        ASSERT(count > 0);
+        storage[head] = T();
+        head = wrap(head + 1);
+        count--;
+    }
+
+    /** @brief Removes the i-th element (counting from the front), keeping the order of all others. */
+    void erase(size_t i)
+    {
+        ASSERT(i < count);
+        for (size_t j = i; j + 1 < count; j++) {
+            storage[wrap(head + j)] = storage[wrap(head + j + 1)];
+        }
+        storage[wrap(head + count - 1)] = T();
+        count--;
+    }
+
+private:
+    size_t wrap(size_t index) const
+    {
+        return index >= storage.size() ? index - storage.size() : index;
+    }
+
+    void grow()
+    {
+        std::vector<T> larger(std::max<size_t>(2 * storage.size(), 4));
+        for (size_t i = 0; i < count; i++) {
+            larger[i] = storage[wrap(head + i)];
+        }
+        storage.swap(larger);
+        head = 0;
+    }
+
+    bool bounded;
+    std::vector<T> storage;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,49 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/SharedDataRegistry.h"
+
+using veins::SharedDataRegistry;
+
+SharedDataRegistry::Entries& SharedDataRegistry::entries()
+{
+    static Entries entries;
+    return entries;
+}
+
+std::mutex& SharedDataRegistry::mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+size_t SharedDataRegistry::size()
+{
+    std::lock_guard<std::mutex> lock(mutex());
+    return entries().size();
+}
+
+void SharedDataRegistry::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex());
+    entries().clear();
+}
@@ -0,0 +1,80 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Process-wide store of immutable data that every simulation run would otherwise build on its own.
+ *
+ * Data is identified by its type and a key that captures everything it is built from (e.g., the file it was read from).
+ * Entries are kept until clear() is called, so runs executed one after another by the same process
+ * (e.g., several runs given to Cmdenv) build them only once. Access is thread-safe.
+ *
+ * Only use this for data that is never modified after creation and does not refer to modules or other per-run state.
+ *
+ * @ingroup baseUtils
+ */
+class VEINS_API SharedDataRegistry {
+public:
+    /**
+     * @brief Returns the data of type T stored under key, calling create() (which returns a T) to build it on first use.
+     *
+     * Concurrent callers asking for data that is still being built wait for it, so create() must not use the registry itself.
+     */
+    template <typename T, typename Factory>
+    static std::shared_ptr<const T> getOrCreate(const std::string& key, Factory create)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        std::shared_ptr<const void>& entry = entries()[std::make_pair(std::type_index(typeid(T)), key)];
+        if (!entry) entry = std::make_shared<const T>(create());
+        return std::static_pointer_cast<const T>(entry);
+    }
+
+    /**
+     * @brief Returns the number of stored entries.
+     */
+    static size_t size();
+
+    /**
+     * @brief Forgets all entries (users keep the data they already hold).
+     */
+    static void clear();
+
+private:
+    using Entries = std::map<std::pair<std::type_index, std::string>, std::shared_ptr<const void>>;
+
+    static Entries& entries();
+    static std::mutex& mutex();
+};
+
+} // namespace veins
@@ -0,0 +1,119 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Immutable, reference-counted chunk of bytes carried by a frame (see BaseFrame1609_4::payload).
+ *
+ * The bytes are filled in once, when the chunk is created at the sender; copying a SharedPayload (as done by every dup()
+ * of a frame carrying it, e.g., for each receiver of a transmission) only copies a pointer and shares the bytes.
+ * Receivers get read-only access, so no copy can change what the others see.
+ * The reference count is atomic, so payloads may be shared across threads.
+ *
+ * The bytes do not count towards the length of the frame carrying them; senders add size() to its byte length themselves.
+ *
+ * @ingroup baseUtils
+ * @ingroup utils
+ */
+class VEINS_API SharedPayload {
+public:
+    /**
+     * @brief Creates an empty payload.
+     */
+    SharedPayload() = default;
+
+    /**
+     * @brief Creates a payload holding content, taking it over without copying.
+     */
+    explicit SharedPayload(std::vector<uint8_t>&& content)
+        : bytes(content.empty() ? nullptr : std::make_shared<const std::vector<uint8_t>>(std::move(content)))
+    {
+    }
+
+    /**
+     * @brief Creates a payload holding a copy of the size bytes at data.
+     */
+    SharedPayload(const void* data, size_t size)
+        : SharedPayload(std::vector<uint8_t>(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size))
+    {
+    }
+
+    /**
+     * @brief Returns the bytes (nullptr if empty).
+     */
+    const uint8_t* data() const
+    {
+        return bytes ? bytes->data() : nullptr;
+    }
+
+    size_t size() const
+    {
+        return bytes ? bytes->size() : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Returns whether this and other share the same bytes (rather than just holding equal ones).
+     */
+    bool sharesBytesWith(const SharedPayload& other) const
+    {
+        return bytes == other.bytes;
+    }
+
+    /**
+     * @brief Returns whether both hold the same bytes.
+     */
+    bool operator==(const SharedPayload& other) const
+    {
+        return sharesBytesWith(other) || (size() == other.size() && std::memcmp(data(), other.data(), size()) == 0);
+    }
+
+    bool operator!=(const SharedPayload& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<const std::vector<uint8_t>> bytes; ///< nullptr if empty
+};
+
+inline std::ostream& operator<<(std::ostream& os, const SharedPayload& payload)
+{
+    return os << payload.size() << " bytes";
+}
+
+} // namespace veins
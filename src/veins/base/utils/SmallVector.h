@@ -0,0 +1,193 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Fixed-size array of trivially copyable values that keeps up to N values inline.
+ *
+ * Only arrays with more than N values allocate memory on the heap, so copying
+ * small arrays is a plain memcpy without any allocation.
+ *
+ * The size is set on construction (or by assignment); there is no push_back.
+ */
+template <typename T, size_t N>
+class VEINS_API SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector only supports trivially copyable types");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    SmallVector(size_t count, const T& value)
+    {
+        allocate(count);
+        std::fill(begin(), end(), value);
+    }
+
+    SmallVector(const SmallVector& other)
+    {
+        assign(other);
+    }
+
+    SmallVector(SmallVector&& other) noexcept
+    {
+        take(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other) assign(other);
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept
+    {
+        if (this != &other) take(other);
+        return *this;
+    }
+
+    T& at(size_t index)
+    {
+        if (index >= count) throw std::out_of_range("SmallVector::at");
+        return data()[index];
+    }
+
+    const T& at(size_t index) const
+    {
+        if (index >= count) throw std::out_of_range("SmallVector::at");
+        return data()[index];
+    }
+
+    T& operator[](size_t index)
+    {
+        return data()[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data()[index];
+    }
+
+    T* data()
+    {
+        return heapValues ? heapValues.get() : inlineValues;
+    }
+
+    const T* data() const
+    {
+        return heapValues ? heapValues.get() : inlineValues;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Returns whether the values are stored inline (i.e., without heap allocation).
+     */
+    bool isInline() const
+    {
+        return !heapValues;
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + count;
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + count;
+    }
+
+private:
+    /** @brief Makes room for newCount values (keeping a sufficiently large heap buffer), leaves them uninitialized. */
+    void allocate(size_t newCount)
+    {
+        if (newCount <= N) {
+            heapValues.reset();
+            heapCapacity = 0;
+        }
+        else if (newCount > heapCapacity) {
+            heapValues.reset(new T[newCount]);
+            heapCapacity = newCount;
+        }
+        count = newCount;
+    }
+
+    void assign(const SmallVector& other)
+    {
+        allocate(other.count);
+        if (count > 0) std::memcpy(data(), other.data(), count * sizeof(T));
+    }
+
+    void take(SmallVector& other)
+    {
+        if (other.heapValues) {
+            heapValues = std::move(other.heapValues);
+            heapCapacity = other.heapCapacity;
+            count = other.count;
+        }
+        else {
+            assign(other);
+        }
+        other.heapCapacity = 0;
+        other.count = 0;
+    }
+
+    T inlineValues[N];
+    std::unique_ptr<T[]> heapValues;
+    size_t heapCapacity = 0;
+    size_t count = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,111 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Bounded lock-free FIFO queue for exactly one producer thread and one consumer thread.
+ *
+ * Elements are exchanged by swapping them with the slots of the queue: push() hands the producer what the consumer
+ * left in the slot, pop() hands the slot contents to the consumer in exchange for what it passes in.
+ * Element types owning heap storage (e.g., strings) thus keep circulating their storage between both threads.
+ *
+ * Neither end blocks: tryPush() fails while the queue is full, tryPop() while it is empty.
+ */
+template <typename T>
+class VEINS_API SpscQueue {
+public:
+    /**
+     * @brief Creates a queue holding up to capacity elements (at least 1).
+     */
+    explicit SpscQueue(size_t capacity)
+        : slots(std::max<size_t>(capacity, 1) + 1)
+        , head(0)
+        , tail(0)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const
+    {
+        return slots.size() - 1;
+    }
+
+    /**
+     * @brief Appends value, swapping it with the contents of a free slot (producer only).
+     *
+     * Returns false (leaving value unchanged) if the queue is full.
+     */
+    bool tryPush(T& value)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t next = wrap(t + 1);
+        if (next == head.load(std::memory_order_acquire)) return false;
+        std::swap(slots[t], value);
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the front element, swapping it into value (consumer only).
+     *
+     * Returns false (leaving value unchanged) if the queue is empty.
+     */
+    bool tryPop(T& value)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        std::swap(slots[h], value);
+        head.store(wrap(h + 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Returns whether the queue held no elements when checked (exact only on the consumer thread, while the producer is idle).
+     */
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    size_t wrap(size_t index) const
+    {
+        return index == slots.size() ? 0 : index;
+    }
+
+    std::vector<T> slots; ///< one more than the capacity, so a full queue can be told from an empty one
+    alignas(64) std::atomic<size_t> head; ///< next slot to pop, written by the consumer only
+    alignas(64) std::atomic<size_t> tail; ///< next slot to push, written by the producer only
+};
+
+} // namespace veins
@@ -0,0 +1,149 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/base/utils/WorkerPool.h"
+#include "veins/base/utils/Logging.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using veins::WorkerPool;
+
+namespace {
+// set on the threads started by a WorkerPool, so that VEINS_LOG can skip statements there
+thread_local bool workerThread = false;
+} // namespace
+
+bool veins::isWorkerThread()
+{
+    return workerThread;
+}
+
+WorkerPool::WorkerPool(size_t numThreads)
+    : nextTask(0)
+{
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(size_t numTasks, const std::function<void(size_t)>& task)
+{
+    if (numTasks == 0) return;
+
+    // not worth waking up anyone, or the worker threads are busy with another run
+    std::unique_lock<std::mutex> runLock(runMutex, std::defer_lock);
+    if (threads.empty() || numTasks == 1 || !runLock.try_lock()) {
+        for (size_t i = 0; i < numTasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        this->numTasks = numTasks;
+        nextTask = 0;
+        busyThreads = threads.size();
+        error = nullptr;
+        ++generation;
+    }
+    wakeup.notify_all();
+
+    work();
+
+    std::exception_ptr taskError;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return busyThreads == 0; });
+        currentTask = nullptr;
+        taskError = error;
+        error = nullptr;
+    }
+    if (taskError) std::rethrow_exception(taskError);
+}
+
+bool WorkerPool::setAffinity(const std::vector<int>& cpus)
+{
+    if (cpus.empty()) return true;
+#ifdef __linux__
+    bool pinned = true;
+    for (size_t i = 0; i < threads.size(); ++i) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[i % cpus.size()], &set);
+        if (pthread_setaffinity_np(threads[i].native_handle(), sizeof(set), &set) != 0) pinned = false;
+    }
+    return pinned;
+#else
+    return false;
+#endif
+}
+
+void WorkerPool::workerLoop()
+{
+    workerThread = true;
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait(lock, [this, seenGeneration] { return stopping || (generation != seenGeneration); });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        work();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyThreads == 0) done.notify_all();
+        }
+    }
+}
+
+void WorkerPool::work()
+{
+    for (size_t i = nextTask++; i < numTasks; i = nextTask++) {
+        try {
+            (*currentTask)(i);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+}
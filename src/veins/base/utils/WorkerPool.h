@@ -0,0 +1,109 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Fixed-size pool of worker threads running parallel loops.
+ *
+ * Tasks must not touch the simulation kernel (no logging, no messages,
+ * no signals); they are meant for pure computations whose results are
+ * written to per-task slots and applied afterwards on the simulation thread.
+ * VEINS_LOG statements are skipped on worker threads (see isWorkerThread()),
+ * so code shared with the simulation thread may use them.
+ *
+ * A pool without worker threads runs all tasks on the calling thread.
+ *
+ * A pool may be shared by several subsystems (see TaskScheduler): a call of
+ * run() while another one is in progress (from another thread, or from within
+ * a task) runs its tasks on its calling thread instead of waiting.
+ */
+class VEINS_API WorkerPool {
+public:
+    /**
+     * @brief Starts numThreads worker threads.
+     */
+    explicit WorkerPool(size_t numThreads);
+
+    /**
+     * @brief Stops and joins all worker threads.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Returns the number of worker threads (not counting the calling thread).
+     */
+    size_t getNumThreads() const
+    {
+        return threads.size();
+    }
+
+    /**
+     * @brief Runs task(i) for every i in [0, numTasks) and returns once all are done.
+     *
+     * The calling thread takes part in the work. If a task throws, the
+     * first exception is rethrown here after all tasks have finished.
+     */
+    void run(size_t numTasks, const std::function<void(size_t)>& task);
+
+    /**
+     * @brief Pins worker thread i to CPU cpus[i % cpus.size()].
+     *
+     * Returns false if this is not supported on this platform or a thread could not be pinned.
+     */
+    bool setAffinity(const std::vector<int>& cpus);
+
+private:
+    void workerLoop();
+    void work();
+
+    std::vector<std::thread> threads;
+    std::mutex runMutex; /**< held by the run() in progress */
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable done;
+
+    const std::function<void(size_t)>* currentTask = nullptr;
+    size_t numTasks = 0;
+    std::atomic<size_t> nextTask;
+    size_t busyThreads = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+};
+
+} // namespace veins
@@ -23,6 +23,7 @@
 //
 
 #include "veins/modules/analogueModel/BreakpointPathlossModel.h"
+#include "veins/base/utils/Profiling.h"
 
 #include "veins/base/messages/AirFrame_m.h"
 
@@ -31,19 +32,23 @@ using veins::AirFrame;
 
 void BreakpointPathlossModel::filterSignal(Signal* signal)
 {
-    auto senderPos = signal->getSenderPoa().pos.getPositionAt();
-    auto receiverPos = signal->getReceiverPoa().pos.getPositionAt();
+    VEINS_PROFILE_SCOPE("BreakpointPathlossModel::filterSignal");
+    const LinkGeometry& link = signal->getLinkGeometry();
 
     /** Calculate the distance factor */
-    double distance = useTorus ? receiverPos.sqrTorusDist(senderPos, playgroundSize) : receiverPos.sqrdist(senderPos);
-    distance = sqrt(distance);
-    EV_TRACE << "distance is: " << distance << endl;
+    double distance = useTorus ? sqrt(link.receiverPos.sqrTorusDist(link.senderPos, playgroundSize)) : link.distance;
+    VEINS_LOG_TRACE << "distance is: " << distance << endl;
 
     if (distance <= 1.0) {
         // attenuation is negligible
         return;
     }
 
+    *signal *= getAttenuation(distance);
+}
+
+double BreakpointPathlossModel::getAttenuation(double distance)
+{
     double attenuation = 1;
     // PL(d) = PL0 + 10 alpha log10 (d/d0)
     // 10 ^ { PL(d)/10 } = 10 ^{PL0 + 10 alpha log10 (d/d0)}/10
@@ -59,9 +64,23 @@ void BreakpointPathlossModel::filterSignal(Signal* signal)
         attenuation = attenuation * pow(distance / breakpointDistance, alpha2);
     }
     attenuation = 1 / attenuation;
-    EV_TRACE << "attenuation is: " << attenuation << endl;
+    VEINS_LOG_TRACE << "attenuation is: " << attenuation << endl;
 
-    pathlosses.record(10 * log10(attenuation)); // in dB
+    if (recordPathlosses) pathlosses.record(10 * log10(attenuation)); // in dB
+
+    return attenuation;
+}
 
-    *signal *= attenuation;
+AnalogueModelKernel BreakpointPathlossModel::getKernel()
+{
+    AnalogueModelKernel kernel;
+    // the link geometry does not know about tori
+    if (!useTorus) kernel.factor = &BreakpointPathlossModel::factorKernel;
+    return kernel;
+}
+
+double BreakpointPathlossModel::factorKernel(AnalogueModel& model, const LinkGeometry& link, double signalMax)
+{
+    if (link.distance <= 1.0) return 1;
+    return static_cast<BreakpointPathlossModel&>(model).getAttenuation(link.distance);
 }
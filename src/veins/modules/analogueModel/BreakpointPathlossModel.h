@@ -64,6 +64,9 @@ protected:
     /** @brief The size of the playground.*/
     const Coord& playgroundSize;
 
+    /** @brief Whether computed pathlosses are logged (to the vector of the phy that created the model). */
+    const bool recordPathlosses;
+
     /** logs computed pathlosses. */
     cOutVector pathlosses;
 
@@ -71,8 +74,10 @@ public:
     /**
      * @brief Initializes the analogue model. playgroundSize
      * need to be valid as long as this instance exists.
+     *
+     * Unless recordPathlosses is cleared, the model records each computed pathloss, so it serves only the phy that created it.
      */
-    BreakpointPathlossModel(cComponent* owner, double L01, double L02, double alpha1, double alpha2, double breakpointDistance, bool useTorus, const Coord& playgroundSize)
+    BreakpointPathlossModel(cComponent* owner, double L01, double L02, double alpha1, double alpha2, double breakpointDistance, bool useTorus, const Coord& playgroundSize, bool recordPathlosses = true)
         : AnalogueModel(owner)
         , PL01(L01)
         , PL02(L02)
@@ -81,6 +86,7 @@ public:
         , breakpointDistance(breakpointDistance)
         , useTorus(useTorus)
         , playgroundSize(playgroundSize)
+        , recordPathlosses(recordPathlosses)
     {
         PL01_real = pow(10, PL01 / 10);
         PL02_real = pow(10, PL02 / 10);
@@ -93,6 +99,20 @@ public:
      */
     void filterSignal(Signal*) override;
 
+    AnalogueModelKernel getKernel() override;
+
+    bool isShareable() const override
+    {
+        // a shared model would record the pathlosses of all phys into one vector
+        return !recordPathlosses;
+    }
+
+    bool isDeterministic() const override
+    {
+        // a cached link budget would skip the recording of pathlosses
+        return !recordPathlosses;
+    }
+
     virtual bool isActiveAtDestination()
     {
         return true;
@@ -102,6 +122,14 @@ public:
     {
         return false;
     }
+
+protected:
+    /**
+     * @brief Returns (and records) the attenuation at the given distance (in m), which must be larger than 1 m.
+     */
+    double getAttenuation(double distance);
+
+    static double factorKernel(AnalogueModel& model, const LinkGeometry& link, double signalMax);
 };
 
 } // namespace veins
@@ -0,0 +1,110 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/analogueModel/CorrelatedShadowing.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "veins/base/messages/AirFrame_m.h"
+#include "veins/base/utils/CounterRng.h"
+#include "veins/base/utils/Profiling.h"
+
+using namespace veins;
+
+ShadowingField::ShadowingField(const Coord& size, double resolution, double decorrelationDistance, uint64_t seed)
+    : resolution(resolution)
+    , decorrelationDistance(decorrelationDistance)
+    , numX(static_cast<size_t>(std::ceil(size.x / resolution)) + 1)
+    , numY(static_cast<size_t>(std::ceil(size.y / resolution)) + 1)
+{
+    ASSERT(resolution > 0 && decorrelationDistance > 0);
+    samples.resize(numX * numY);
+
+    // correlation of neighbouring samples, and the weight of new noise that keeps the variance at 1
+    const double a = std::exp(-resolution / decorrelationDistance);
+    const double b = std::sqrt(1 - a * a);
+
+    for (size_t y = 0; y < numY; ++y) {
+        CounterRng rng(seed, CounterRng::Purpose::shadowing, static_cast<uint32_t>(y));
+        float* row = &samples[y * numX];
+        double value = rng.normal(0, 1);
+        row[0] = static_cast<float>(value);
+        for (size_t x = 1; x < numX; ++x) {
+            value = a * value + b * rng.normal(0, 1);
+            row[x] = static_cast<float>(value);
+        }
+    }
+    // rows are independent, so filtering the columns correlates them just like the samples in a row
+    for (size_t y = 1; y < numY; ++y) {
+        const float* previous = &samples[(y - 1) * numX];
+        float* row = &samples[y * numX];
+        for (size_t x = 0; x < numX; ++x) {
+            row[x] = static_cast<float>(a * previous[x] + b * row[x]);
+        }
+    }
+}
+
+double ShadowingField::at(const Coord& pos) const
+{
+    const double fx = std::min(std::max(pos.x / resolution, 0.0), static_cast<double>(numX - 1));
+    const double fy = std::min(std::max(pos.y / resolution, 0.0), static_cast<double>(numY - 1));
+    const size_t x0 = std::min(static_cast<size_t>(fx), numX > 1 ? numX - 2 : 0);
+    const size_t y0 = std::min(static_cast<size_t>(fy), numY > 1 ? numY - 2 : 0);
+    const size_t x1 = std::min(x0 + 1, numX - 1);
+    const size_t y1 = std::min(y0 + 1, numY - 1);
+    const double tx = fx - x0;
+    const double ty = fy - y0;
+
+    const double top = (1 - tx) * samples[y0 * numX + x0] + tx * samples[y0 * numX + x1];
+    const double bottom = (1 - tx) * samples[y1 * numX + x0] + tx * samples[y1 * numX + x1];
+    return (1 - ty) * top + ty * bottom;
+}
+
+void CorrelatedShadowing::filterSignal(Signal* signal)
+{
+    VEINS_PROFILE_SCOPE("CorrelatedShadowing::filterSignal");
+    const LinkGeometry& link = signal->getLinkGeometry();
+    const double factor = getFactor(link.senderPos, link.receiverPos);
+    VEINS_LOG_TRACE << "shadowing factor is: " << factor << endl;
+    *signal *= factor;
+}
+
+double CorrelatedShadowing::getFactor(const Coord& senderPos, const Coord& receiverPos) const
+{
+    // the sum of the field at both ends has a variance of 2 (1 + correlation of the ends), scale it back to 1
+    const double correlation = std::exp(-(std::abs(receiverPos.x - senderPos.x) + std::abs(receiverPos.y - senderPos.y)) / field->getDecorrelationDistance());
+    const double value = (field->at(senderPos) + field->at(receiverPos)) / std::sqrt(2 * (1 + correlation));
+    return std::pow(10.0, sigma * value / 10.0);
+}
+
+AnalogueModelKernel CorrelatedShadowing::getKernel()
+{
+    AnalogueModelKernel kernel;
+    kernel.factor = &CorrelatedShadowing::factorKernel;
+    return kernel;
+}
+
+double CorrelatedShadowing::factorKernel(AnalogueModel& model, const LinkGeometry& link, double signalMax)
+{
+    return static_cast<CorrelatedShadowing&>(model).getFactor(link.senderPos, link.receiverPos);
+}
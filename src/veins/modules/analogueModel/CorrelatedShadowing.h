@@ -0,0 +1,148 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/phyLayer/AnalogueModel.h"
+
+namespace veins {
+
+/**
+ * @brief A spatially correlated, normally distributed random field (zero mean, unit variance) sampled on a regular grid over the playground.
+ *
+ * The samples follow the exponential autocorrelation of Gudmundson's shadowing model: two points dx and dy meters apart
+ * are correlated by exp(-(|dx| + |dy|) / decorrelationDistance). The field is built by filtering white noise with a
+ * first order autoregressive filter along each row, then along each column. Row noise is drawn from a CounterRng,
+ * so a field only depends on its size, resolution, decorrelation distance and seed.
+ *
+ * @see M. Gudmundson: "Correlation Model for Shadow Fading in Mobile Radio Systems", Electronics Letters, vol. 27, no. 23, 1991.
+ *
+ * @ingroup analogueModels
+ */
+class VEINS_API ShadowingField {
+public:
+    /**
+     * @param size of the area covered (from the origin), positions outside are clamped to it
+     * @param resolution distance between two samples (in m)
+     * @param decorrelationDistance distance at which the correlation dropped to 1/e (in m)
+     */
+    ShadowingField(const Coord& size, double resolution, double decorrelationDistance, uint64_t seed);
+
+    /**
+     * Returns the value of the field at pos (ignoring its height), interpolated bilinearly between the four nearest samples.
+     */
+    double at(const Coord& pos) const;
+
+    double getDecorrelationDistance() const
+    {
+        return decorrelationDistance;
+    }
+
+    size_t getNumSamples() const
+    {
+        return samples.size();
+    }
+
+protected:
+    double resolution;
+    double decorrelationDistance;
+    size_t numX; ///< number of samples per row
+    size_t numY; ///< number of rows
+    std::vector<float> samples; ///< row by row
+};
+
+/**
+ * @brief Log-normal shadowing that is consistent in space, looked up from a precomputed ShadowingField.
+ *
+ * The shadowing of a link combines the field at the sender and at the receiver, scaled so it is normally distributed
+ * with standard deviation sigma (in dB) for links of all lengths. It is thus the same in both directions, changes smoothly
+ * as nodes move, and costs two lookups per link. The optional seed selects the field; by default it is drawn from the RNG
+ * of the first phy using the model, and all phys of the simulation configured alike share that field.
+ * Shadowing may amplify signals, so receiverCullingGain of BasePhyLayer has to cover a few sigma if receivers are culled.
+ *
+ * An example config.xml for this AnalogueModel can be the following:
+ * @verbatim
+    <AnalogueModel type="CorrelatedShadowing">
+        <!-- standard deviation of the shadowing (in dB) -->
+        <parameter name="sigma" type="double" value="4"/>
+        <!-- distance at which the correlation dropped to 1/e (in m) -->
+        <parameter name="decorrelationDistance" type="double" value="20"/>
+        <!-- distance between two samples of the field (in m), if ommited a quarter of the decorrelation distance -->
+        <parameter name="resolution" type="double" value="5"/>
+    </AnalogueModel>
+   @endverbatim
+ *
+ * @ingroup analogueModels
+ */
+class VEINS_API CorrelatedShadowing : public AnalogueModel {
+public:
+    /**
+     * @param field to look up the shadowing in, shared by all models using it
+     * @param sigma standard deviation of the shadowing (in dB)
+     */
+    CorrelatedShadowing(cComponent* owner, std::shared_ptr<const ShadowingField> field, double sigma)
+        : AnalogueModel(owner)
+        , field(std::move(field))
+        , sigma(sigma)
+    {
+    }
+
+    void filterSignal(Signal* signal) override;
+
+    AnalogueModelKernel getKernel() override;
+
+    bool isThreadSafe() const override
+    {
+        return true;
+    }
+
+    bool isShareable() const override
+    {
+        return true;
+    }
+
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+    /**
+     * Returns the attenuation of the link between the given positions.
+     */
+    double getFactor(const Coord& senderPos, const Coord& receiverPos) const;
+
+protected:
+    static double factorKernel(AnalogueModel& model, const LinkGeometry& link, double signalMax);
+
+    std::shared_ptr<const ShadowingField> field;
+
+    /** @brief Standard deviation of the shadowing (in dB) */
+    double sigma;
+};
+
+} // namespace veins
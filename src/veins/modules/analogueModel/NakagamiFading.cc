@@ -22,6 +22,7 @@
 //
 
 #include "veins/modules/analogueModel/NakagamiFading.h"
+#include "veins/base/utils/Profiling.h"
 
 using namespace veins;
 
@@ -30,42 +31,64 @@ using namespace veins;
  */
 void NakagamiFading::filterSignal(Signal* signal)
 {
-    auto senderPos = signal->getSenderPoa().pos.getPositionAt();
-    auto receiverPos = signal->getReceiverPoa().pos.getPositionAt();
-
-    const double M_CLOSE = 1.5;
-    const double M_FAR = 0.75;
-    const double DIS_THRESHOLD = 80;
-
-    EV_TRACE << "Add NakagamiFading ..." << endl;
+    VEINS_PROFILE_SCOPE("NakagamiFading::filterSignal");
+    VEINS_LOG_TRACE << "Add NakagamiFading ..." << endl;
 
     // get average TX power
     // FIXME: really use average power (instead of max)
-    EV_TRACE << "Finding max TX power ..." << endl;
+    VEINS_LOG_TRACE << "Finding max TX power ..." << endl;
     double sendPower_mW = signal->getMax();
-    EV_TRACE << "TX power is " << FWMath::mW2dBm(sendPower_mW) << " dBm" << endl;
+    VEINS_LOG_TRACE << "TX power is " << FWMath::mW2dBm(sendPower_mW) << " dBm" << endl;
+
+    double factor;
+    if (useCounterRng) {
+        ASSERT(signal->getTransmissionId() != -1 && signal->getReceiverId() != -1);
+        CounterRng rng(counterRngSeed, CounterRng::Purpose::fading, static_cast<uint32_t>(signal->getTransmissionId()), static_cast<uint32_t>(signal->getReceiverId()));
+        factor = drawFactor(sendPower_mW, signal->getLinkGeometry().distance2D, &rng);
+    }
+    else {
+        factor = drawFactor(sendPower_mW, signal->getLinkGeometry().distance2D);
+    }
+
+    *signal *= factor;
+}
+
+double NakagamiFading::drawFactor(double sendPower_mW, double d, CounterRng* rng)
+{
+    const double M_CLOSE = 1.5;
+    const double M_FAR = 0.75;
+    const double DIS_THRESHOLD = 80;
 
     // get m value
     double m = this->m;
-    {
-        const Coord senderPos2D(senderPos.x, senderPos.y);
-        const Coord receiverPos2D(receiverPos.x, receiverPos.y);
-        double d = senderPos2D.distance(receiverPos2D);
-        if (!constM) {
-            m = (d < DIS_THRESHOLD) ? M_CLOSE : M_FAR;
-        }
+    if (!constM) {
+        m = (d < DIS_THRESHOLD) ? M_CLOSE : M_FAR;
     }
 
     // calculate average RX power
-    double recvPower_mW = (RNGCONTEXT gamma_d(m, sendPower_mW / 1000 / m)) * 1000.0;
+    double recvPower_mW = (rng ? rng->gamma_d(m, sendPower_mW / 1000 / m) : RNGCONTEXT gamma_d(m, sendPower_mW / 1000 / m)) * 1000.0;
     if (recvPower_mW > sendPower_mW) {
         recvPower_mW = sendPower_mW;
     }
-    EV_TRACE << "RX power is " << FWMath::mW2dBm(recvPower_mW) << " dBm" << endl;
+    VEINS_LOG_TRACE << "RX power is " << FWMath::mW2dBm(recvPower_mW) << " dBm" << endl;
 
     // infer average attenuation
     double factor = recvPower_mW / sendPower_mW;
-    EV_TRACE << "factor is: " << factor << " (i.e. " << FWMath::mW2dBm(factor) << " dB)" << endl;
+    VEINS_LOG_TRACE << "factor is: " << factor << " (i.e. " << FWMath::mW2dBm(factor) << " dB)" << endl;
 
-    *signal *= factor;
+    return factor;
+}
+
+AnalogueModelKernel NakagamiFading::getKernel()
+{
+    if (useCounterRng) return {};
+    AnalogueModelKernel kernel;
+    kernel.factor = &NakagamiFading::factorKernel;
+    return kernel;
+}
+
+double NakagamiFading::factorKernel(AnalogueModel& model, const LinkGeometry& link, double signalMax)
+{
+    // the factor does not depend on the scale of the power it is drawn for, so the power the chain started with serves just as well
+    return static_cast<NakagamiFading&>(model).drawFactor(signalMax, link.distance2D);
 }
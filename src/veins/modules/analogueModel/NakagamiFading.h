@@ -26,6 +26,7 @@
 #include "veins/base/phyLayer/AnalogueModel.h"
 #include "veins/base/modules/BaseWorldUtility.h"
 #include "veins/base/messages/AirFrame_m.h"
+#include "veins/base/utils/CounterRng.h"
 
 namespace veins {
 
@@ -45,10 +46,15 @@ namespace veins {
 class VEINS_API NakagamiFading : public AnalogueModel {
 
 public:
-    NakagamiFading(cComponent* owner, bool constM, double m)
+    /**
+     * @param useCounterRng whether to draw from a CounterRng keyed by transmission and receiver (seeded with counterRngSeed) instead of the module RNG
+     */
+    NakagamiFading(cComponent* owner, bool constM, double m, bool useCounterRng = false, uint64_t counterRngSeed = 0)
         : AnalogueModel(owner)
         , constM(constM)
         , m(m)
+        , useCounterRng(useCounterRng)
+        , counterRngSeed(counterRngSeed)
     {
     }
 
@@ -58,12 +64,37 @@ public:
 
     void filterSignal(Signal* signal) override;
 
+    /**
+     * There is no kernel when drawing from a CounterRng: the ids of the transmission and receiver to key it by are only known to filterSignal.
+     */
+    AnalogueModelKernel getKernel() override;
+
+    bool isThreadSafe() const override
+    {
+        return useCounterRng;
+    }
+
 protected:
+    /**
+     * @brief Draws the fading factor of a signal with the given (maximum) power (in mW), between antennas d meters apart (ignoring their heights).
+     *
+     * Draws from rng if given, else from the module RNG.
+     */
+    double drawFactor(double sendPower_mW, double d, CounterRng* rng = nullptr);
+
+    static double factorKernel(AnalogueModel& model, const LinkGeometry& link, double signalMax);
+
     /** @brief Whether to use a constant m or a m based on distance */
     bool constM;
 
     /** @brief The value of the coefficient m */
     double m;
+
+    /** @brief Whether to draw from a CounterRng instead of the module RNG, so results do not depend on the order signals are filtered in */
+    bool useCounterRng;
+
+    /** @brief Seed of the CounterRng streams */
+    uint64_t counterRngSeed;
 };
 
 } // namespace veins
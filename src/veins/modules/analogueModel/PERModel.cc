@@ -23,6 +23,7 @@
 //
 
 #include "veins/modules/analogueModel/PERModel.h"
+#include "veins/base/utils/Profiling.h"
 
 #include "veins/base/messages/AirFrame_m.h"
 
@@ -31,6 +32,7 @@ using veins::AirFrame;
 
 void PERModel::filterSignal(Signal* signal)
 {
+    VEINS_PROFILE_SCOPE("PERModel::filterSignal");
     auto senderPos = signal->getSenderPoa().pos.getPositionAt();
     auto receiverPos = signal->getReceiverPoa().pos.getPositionAt();
 
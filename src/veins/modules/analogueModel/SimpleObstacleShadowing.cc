@@ -21,6 +21,7 @@
 //
 
 #include "veins/modules/analogueModel/SimpleObstacleShadowing.h"
+#include "veins/base/utils/Profiling.h"
 
 using namespace veins;
 
@@ -37,12 +38,24 @@ SimpleObstacleShadowing::SimpleObstacleShadowing(cComponent* owner, ObstacleCont
 
 void SimpleObstacleShadowing::filterSignal(Signal* signal)
 {
-    auto senderPos = signal->getSenderPoa().pos.getPositionAt();
-    auto receiverPos = signal->getReceiverPoa().pos.getPositionAt();
-
-    double factor = obstacleControl.calculateAttenuation(senderPos, receiverPos);
-
-    EV_TRACE << "value is: " << factor << endl;
+    VEINS_PROFILE_SCOPE("SimpleObstacleShadowing::filterSignal");
+    const LinkGeometry& link = signal->getLinkGeometry();
+    double factor;
+    if (obstacleControl.isGeometryCommitted()) {
+        // leaves obstacleControl untouched, so this may run on worker threads
+        thread_local ObstacleControl::QueryScratch scratch(obstacleControl.getCacheCapacity());
+        factor = obstacleControl.queryAttenuation(link.senderPos, link.receiverPos, scratch);
+    }
+    else {
+        factor = obstacleControl.calculateAttenuation(link);
+    }
+
+    VEINS_LOG_TRACE << "value is: " << factor << endl;
 
     *signal *= factor;
 }
+
+void SimpleObstacleShadowing::prepareConcurrentFiltering()
+{
+    if (!obstacleControl.isGeometryCommitted()) obstacleControl.commitGeometry();
+}
@@ -78,6 +78,32 @@ public:
     {
         return true;
     }
+
+    double getEvaluationCost() const override
+    {
+        // requires intersecting the line of sight with all nearby obstacles
+        return 100;
+    }
+
+    bool isShareable() const override
+    {
+        return true;
+    }
+
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+    /**
+     * Once the geometry of obstacles is committed, filterSignal uses ObstacleControl::queryAttenuation() with a scratch of its thread.
+     */
+    bool isThreadSafe() const override
+    {
+        return true;
+    }
+
+    void prepareConcurrentFiltering() override;
 };
 
 } // namespace veins
@@ -23,6 +23,7 @@
 //
 
 #include "veins/modules/analogueModel/SimplePathlossModel.h"
+#include "veins/base/utils/Profiling.h"
 
 #include "veins/base/messages/AirFrame_m.h"
 
@@ -32,14 +33,20 @@ using veins::AirFrame;
 
 void SimplePathlossModel::filterSignal(Signal* signal)
 {
-    auto senderPos = signal->getSenderPoa().pos.getPositionAt();
-    auto receiverPos = signal->getReceiverPoa().pos.getPositionAt();
+    VEINS_PROFILE_SCOPE("SimplePathlossModel::filterSignal");
+    const LinkGeometry& link = signal->getLinkGeometry();
 
     /** Calculate the distance factor */
-    double sqrDistance = useTorus ? receiverPos.sqrTorusDist(senderPos, playgroundSize) : receiverPos.sqrdist(senderPos);
+    double sqrDistance = useTorus ? link.receiverPos.sqrTorusDist(link.senderPos, playgroundSize) : link.sqrDistance;
 
-    EV_TRACE << "sqrdistance is: " << sqrDistance << endl;
+    VEINS_LOG_TRACE << "sqrdistance is: " << sqrDistance << endl;
 
+    multiplyAttenuation(sqrDistance, signal->getSpectrum(), signal->getFilterStart(), signal->getFilterEnd(), signal->getValues());
+}
+
+template <typename T>
+void SimplePathlossModel::multiplyAttenuation(double sqrDistance, const Spectrum& spectrum, size_t from, size_t to, T* values) const
+{
     if (sqrDistance <= 1.0) {
         // attenuation is negligible
         return;
@@ -47,12 +54,23 @@ void SimplePathlossModel::filterSignal(Signal* signal)
 
     // the part of the attenuation only depending on the distance
     double distFactor = pow(sqrDistance, -pathLossAlphaHalf) / (16.0 * M_PI * M_PI);
-    EV_TRACE << "distance factor is: " << distFactor << endl;
+    VEINS_LOG_TRACE << "distance factor is: " << distFactor << endl;
 
-    Signal attenuation(signal->getSpectrum());
-    for (uint16_t i = 0; i < signal->getNumValues(); i++) {
-        double wavelength = BaseWorldUtility::speedOfLight() / signal->getSpectrum().freqAt(i);
-        attenuation.at(i) = (wavelength * wavelength) * distFactor;
+    for (size_t i = from; i < to; i++) {
+        double wavelength = BaseWorldUtility::speedOfLight() / spectrum.freqAt(i);
+        values[i] *= (wavelength * wavelength) * distFactor;
     }
-    *signal *= attenuation;
+}
+
+AnalogueModelKernel SimplePathlossModel::getKernel()
+{
+    AnalogueModelKernel kernel;
+    // the link geometry does not know about tori
+    if (!useTorus) kernel.multiply = &SimplePathlossModel::multiplyKernel;
+    return kernel;
+}
+
+void SimplePathlossModel::multiplyKernel(AnalogueModel& model, const LinkGeometry& link, const Spectrum& spectrum, size_t from, size_t to, double* attenuation)
+{
+    static_cast<SimplePathlossModel&>(model).multiplyAttenuation(link.sqrDistance, spectrum, from, to, attenuation);
 }
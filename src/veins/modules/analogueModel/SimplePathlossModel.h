@@ -95,6 +95,34 @@ public:
     {
         return true;
     }
+
+    bool isThreadSafe() const override
+    {
+        return true;
+    }
+
+    bool isShareable() const override
+    {
+        return true;
+    }
+
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+    AnalogueModelKernel getKernel() override;
+
+protected:
+    /**
+     * @brief Multiplies values (one per frequency of spectrum) by the path loss at the given squared distance, for the frequencies in [from, to).
+     *
+     * Takes the values of a Signal or the (double) attenuation buffer of a fused kernel.
+     */
+    template <typename T>
+    void multiplyAttenuation(double sqrDistance, const Spectrum& spectrum, size_t from, size_t to, T* values) const;
+
+    static void multiplyKernel(AnalogueModel& model, const LinkGeometry& link, const Spectrum& spectrum, size_t from, size_t to, double* attenuation);
 };
 
 } // namespace veins
@@ -21,43 +21,71 @@
 //
 
 #include "veins/modules/analogueModel/TwoRayInterferenceModel.h"
+#include "veins/base/utils/Profiling.h"
 #include "veins/base/messages/AirFrame_m.h"
 
 using namespace veins;
 
 void TwoRayInterferenceModel::filterSignal(Signal* signal)
 {
-    auto senderPos = signal->getSenderPoa().pos.getPositionAt();
-    auto receiverPos = signal->getReceiverPoa().pos.getPositionAt();
+    VEINS_PROFILE_SCOPE("TwoRayInterferenceModel::filterSignal");
+    const LinkGeometry& link = signal->getLinkGeometry();
 
-    const Coord senderPos2D(senderPos.x, senderPos.y);
-    const Coord receiverPos2D(receiverPos.x, receiverPos.y);
+    multiplyAttenuation(link.senderPos, link.receiverPos, link.distance2D, signal->getSpectrum(), signal->getFilterStart(), signal->getFilterEnd(), signal->getValues());
+}
 
+template <typename T>
+void TwoRayInterferenceModel::multiplyAttenuation(const Coord& senderPos, const Coord& receiverPos, double d, const Spectrum& spectrum, size_t from, size_t to, T* values)
+{
     ASSERT(senderPos.z > 0); // make sure send antenna is above ground
     ASSERT(receiverPos.z > 0); // make sure receive antenna is above ground
 
-    double d = senderPos2D.distance(receiverPos2D);
     double ht = senderPos.z, hr = receiverPos.z;
 
-    EV_TRACE << "(ht, hr) = (" << ht << ", " << hr << ")" << endl;
+    VEINS_LOG_TRACE << "(ht, hr) = (" << ht << ", " << hr << ")" << endl;
 
     double d_dir = sqrt(pow(d, 2) + pow((ht - hr), 2)); // direct distance
     double d_ref = sqrt(pow(d, 2) + pow((ht + hr), 2)); // distance via ground reflection
     double sin_theta = (ht + hr) / d_ref;
     double cos_theta = d / d_ref;
 
-    double gamma = (sin_theta - sqrt(epsilon_r - pow(cos_theta, 2))) / (sin_theta + sqrt(epsilon_r - pow(cos_theta, 2)));
+    const double sqrt_term = sqrt(epsilon_r - pow(cos_theta, 2));
+    const double gamma = (sin_theta - sqrt_term) / (sin_theta + sqrt_term);
+    const double delta_d = d_dir - d_ref;
+
+    const std::vector<double>& k = getWaveNumbers(spectrum);
+    for (size_t i = from; i < to; i++) {
+        // (4 pi d / lambda)^2 / |1 + gamma e^(j phi)|^2, with 4 pi d / lambda = 2 k d and |1 + gamma e^(j phi)|^2 = 1 + 2 gamma cos(phi) + gamma^2
+        const double phi = k[i] * delta_d;
+        const double kd = 2 * k[i] * d;
+        const double attenuation = (1 + 2 * gamma * cos(phi) + gamma * gamma) / (kd * kd);
+
+        VEINS_LOG_TRACE << "Add attenuation for (freq, phi, gamma, att) = (" << spectrum.freqAt(i) << ", " << phi << ", " << gamma << ", " << attenuation << ", " << FWMath::mW2dBm(attenuation) << ")" << endl;
+
+        values[i] *= attenuation;
+    }
+}
 
-    Signal attenuation(signal->getSpectrum());
-    for (uint16_t i = 0; i < signal->getNumValues(); i++) {
-        double freq = signal->getSpectrum().freqAt(i);
-        double lambda = BaseWorldUtility::speedOfLight() / freq;
-        double phi = (2 * M_PI / lambda * (d_dir - d_ref));
-        double att = pow(4 * M_PI * (d / lambda) * 1 / (sqrt((pow((1 + gamma * cos(phi)), 2) + pow(gamma, 2) * pow(sin(phi), 2)))), 2);
+AnalogueModelKernel TwoRayInterferenceModel::getKernel()
+{
+    AnalogueModelKernel kernel;
+    kernel.multiply = &TwoRayInterferenceModel::multiplyKernel;
+    return kernel;
+}
 
-        EV_TRACE << "Add attenuation for (freq, lambda, phi, gamma, att) = (" << freq << ", " << lambda << ", " << phi << ", " << gamma << ", " << (1 / att) << ", " << FWMath::mW2dBm(att) << ")" << endl;
+void TwoRayInterferenceModel::multiplyKernel(AnalogueModel& model, const LinkGeometry& link, const Spectrum& spectrum, size_t from, size_t to, double* attenuation)
+{
+    static_cast<TwoRayInterferenceModel&>(model).multiplyAttenuation(link.senderPos, link.receiverPos, link.distance2D, spectrum, from, to, attenuation);
+}
 
-        attenuation.at(i) = 1 / att;
+const std::vector<double>& TwoRayInterferenceModel::getWaveNumbers(const Spectrum& spectrum)
+{
+    if (!(spectrum == waveNumberSpectrum) || waveNumbers.size() != spectrum.getNumFreqs()) {
+        waveNumberSpectrum = spectrum;
+        waveNumbers.resize(spectrum.getNumFreqs());
+        for (size_t i = 0; i < waveNumbers.size(); i++) {
+            waveNumbers[i] = 2 * M_PI * spectrum.freqAt(i) / BaseWorldUtility::speedOfLight();
+        }
     }
-    *signal *= attenuation;
+    return waveNumbers;
 }
@@ -22,8 +22,11 @@
 
 #pragma once
 
+#include <vector>
+
 #include "veins/base/phyLayer/AnalogueModel.h"
 #include "veins/base/modules/BaseWorldUtility.h"
+#include "veins/base/toolbox/Spectrum.h"
 
 namespace veins {
 
@@ -57,9 +60,47 @@ public:
 
     void filterSignal(Signal* signal) override;
 
+    AnalogueModelKernel getKernel() override;
+
+    bool isShareable() const override
+    {
+        // the wave number cache only depends on the spectrum
+        return true;
+    }
+
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+protected:
+    /**
+     * @brief Multiplies values (one per frequency of spectrum) by the attenuation between antennas at the given positions, d meters apart (ignoring their heights),
+     * for the frequencies in [from, to).
+     *
+     * Takes the values of a Signal or the (double) attenuation buffer of a fused kernel.
+     */
+    template <typename T>
+    void multiplyAttenuation(const Coord& senderPos, const Coord& receiverPos, double d, const Spectrum& spectrum, size_t from, size_t to, T* values);
+
+    static void multiplyKernel(AnalogueModel& model, const LinkGeometry& link, const Spectrum& spectrum, size_t from, size_t to, double* attenuation);
+
+    /**
+     * @brief returns the wave number (2 pi / lambda) of each frequency of the given spectrum
+     *
+     * The values only depend on the spectrum, so they are computed once and reused for all following signals on the same spectrum.
+     */
+    const std::vector<double>& getWaveNumbers(const Spectrum& spectrum);
+
 protected:
     /** @brief stores the dielectric constant used for calculation */
     double epsilon_r;
+
+    /** @brief spectrum the cached waveNumbers belong to */
+    Spectrum waveNumberSpectrum;
+
+    /** @brief wave number of each frequency of waveNumberSpectrum */
+    std::vector<double> waveNumbers;
 };
 
 } // namespace veins
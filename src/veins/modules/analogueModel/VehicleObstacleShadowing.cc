@@ -21,41 +21,107 @@
 //
 
 #include "veins/modules/analogueModel/VehicleObstacleShadowing.h"
+#include "veins/base/utils/Profiling.h"
+
+#include <algorithm>
+#include <limits>
 
 using namespace veins;
 
+namespace {
+
+/**
+ * Buffers used by VehicleObstacleShadowing::filterSignal(), kept across calls (per thread) so their storage gets reused.
+ */
+struct FilterScratch {
+    VehicleObstacleControl::QueryScratch query;
+    std::vector<std::pair<double, double>> potentialObstacles; ///< (distance, height) of sender, potential obstacles, and receiver
+    std::vector<size_t> majorObstacles;
+    std::vector<double> attenuationDB; ///< attenuation (in dB) of each frequency
+    std::vector<std::pair<double, size_t>> obstacleSignificance;
+};
+
+FilterScratch& getFilterScratch()
+{
+    thread_local FilterScratch scratch;
+    return scratch;
+}
+
+} // namespace
+
 VehicleObstacleShadowing::VehicleObstacleShadowing(cComponent* owner, VehicleObstacleControl& vehicleObstacleControl, bool useTorus, const Coord& playgroundSize)
     : AnalogueModel(owner)
     , vehicleObstacleControl(vehicleObstacleControl)
     , useTorus(useTorus)
     , playgroundSize(playgroundSize)
+    , queryConcurrently(!getEnvir()->isGUI())
 {
     if (useTorus) throw cRuntimeError("VehicleObstacleShadowing does not work on torus-shaped playgrounds");
 }
 
+void VehicleObstacleShadowing::setApproximation(size_t maxObstacles, double sensitivity)
+{
+    if (sensitivity < 0) throw cRuntimeError("VehicleObstacleShadowing: sensitivity must not be negative");
+    approximate = true;
+    this->maxObstacles = maxObstacles;
+    this->sensitivity = sensitivity;
+}
+
 void VehicleObstacleShadowing::filterSignal(Signal* signal)
 {
-    auto senderPos = signal->getSenderPoa().pos.getPositionAt();
-    auto receiverPos = signal->getReceiverPoa().pos.getPositionAt();
+    VEINS_PROFILE_SCOPE("VehicleObstacleShadowing::filterSignal");
+    const LinkGeometry& link = signal->getLinkGeometry();
 
-    auto potentialObstacles = vehicleObstacleControl.getPotentialObstacles(signal->getSenderPoa().pos, signal->getReceiverPoa().pos, *signal);
+    // all buffers are kept per thread, so no allocations are needed once they have grown large enough
+    FilterScratch& scratch = getFilterScratch();
+    std::vector<std::pair<double, double>>& potentialObstacles = scratch.potentialObstacles;
+    if (queryConcurrently && vehicleObstacleControl.isGeometryCommitted()) {
+        vehicleObstacleControl.queryPotentialObstacles(signal->getSenderPoa().pos, signal->getReceiverPoa().pos, link, *signal, potentialObstacles, scratch.query);
+    }
+    else {
+        vehicleObstacleControl.getPotentialObstacles(signal->getSenderPoa().pos, signal->getReceiverPoa().pos, link, *signal, potentialObstacles);
+    }
 
     if (potentialObstacles.size() < 1) return;
 
-    double senderHeight = senderPos.z;
-    double receiverHeight = receiverPos.z;
+    double senderHeight = link.senderPos.z;
+    double receiverHeight = link.receiverPos.z;
     potentialObstacles.insert(potentialObstacles.begin(), std::make_pair(0, senderHeight));
-    potentialObstacles.emplace_back(senderPos.distance(receiverPos), receiverHeight);
+    potentialObstacles.emplace_back(link.distance, receiverHeight);
 
-    auto attenuationDB = VehicleObstacleControl::getVehicleAttenuationDZ(potentialObstacles, Signal(signal->getSpectrum()));
+    const size_t numValues = signal->getNumValues();
+    // there is no power outside of the filter window
+    const size_t from = signal->getFilterStart();
+    const size_t to = signal->getFilterEnd();
+    Signal::Value* values = signal->getValues();
+    double maxAttenuation_dB = std::numeric_limits<double>::infinity();
+    if (approximate) {
+        // the lowest frequency has the widest Fresnel zone
+        const double lambda = BaseWorldUtility::speedOfLight() / signal->getSpectrum().freqAt(from);
+        VehicleObstacleControl::pruneVehicleObstacles(potentialObstacles, lambda, maxObstacles, scratch.obstacleSignificance);
+        if (potentialObstacles.size() < 3) return;
+        if (sensitivity > 0) {
+            const double maxPower = *std::max_element(values + from, values + to);
+            maxAttenuation_dB = (maxPower > 0) ? 10 * log10(maxPower / sensitivity) : 0;
+        }
+    }
 
-    EV_TRACE << "t=" << simTime() << ": Attenuation by vehicles is " << attenuationDB << std::endl;
+    std::vector<double>& attenuationDB = scratch.attenuationDB;
+    attenuationDB.resize(numValues);
+    if (!VehicleObstacleControl::computeVehicleAttenuationDZ(potentialObstacles, signal->getSpectrum(), from, to, attenuationDB.data(), scratch.majorObstacles, maxAttenuation_dB)) {
+        VEINS_LOG_TRACE << "Vehicles attenuate signal below sensitivity, dropping it" << std::endl;
+        std::fill(values, values + numValues, 0);
+        return;
+    }
 
     // convert from "dB loss" to a multiplicative factor
-    Signal attenuation(attenuationDB.getSpectrum());
-    for (uint16_t i = 0; i < attenuation.getNumValues(); i++) {
-        attenuation.at(i) = pow(10.0, -attenuationDB.at(i) / 10.0);
+    for (size_t i = from; i < to; i++) {
+        VEINS_LOG_TRACE << "Attenuation by vehicles at " << signal->getSpectrum().freqAt(i) << " Hz is " << attenuationDB[i] << " dB" << std::endl;
+        values[i] *= pow(10.0, -attenuationDB[i] / 10.0);
     }
+}
 
-    *signal *= attenuation;
+void VehicleObstacleShadowing::prepareConcurrentFiltering()
+{
+    if (!vehicleObstacleControl.isGeometryCommitted()) vehicleObstacleControl.commitGeometry();
 }
@@ -32,6 +32,8 @@ using veins::AirFrame;
 using veins::VehicleObstacleControl;
 
 #include <cstdlib>
+#include <utility>
+#include <vector>
 
 namespace veins {
 
@@ -52,6 +54,18 @@ protected:
     /** @brief The size of the playground.*/
     const Coord& playgroundSize;
 
+    /** @brief whether filterSignal may query vehicleObstacleControl from worker threads, i.e., whether it does not draw annotations (only done with a GUI) */
+    const bool queryConcurrently;
+
+    /** @brief whether only the most significant obstacles are considered, see VehicleObstacleControl::pruneVehicleObstacles */
+    bool approximate = false;
+
+    /** @brief number of obstacles considered at most when approximating (0: no limit) */
+    size_t maxObstacles = 0;
+
+    /** @brief power (in mW) below which approximated signals are dropped early (0: never) */
+    double sensitivity = 0;
+
 public:
     /**
      * @brief Initializes the analogue model. myMove and playgroundSize
@@ -67,6 +81,14 @@ public:
      */
     VehicleObstacleShadowing(cComponent* owner, VehicleObstacleControl& vehicleObstacleControl, bool useTorus, const Coord& playgroundSize);
 
+    /**
+     * @brief Only consider the obstacles intruding into the first Fresnel zone, at most maxObstacles of them (0: no limit),
+     * and drop a signal as soon as the terms of the model computed so far attenuate it below sensitivity (in mW, 0: never).
+     *
+     * To be called before the model is shared: with a sensitivity, it is no longer shareable.
+     */
+    void setApproximation(size_t maxObstacles, double sensitivity);
+
     /**
      * @brief Filters a specified Signal by adding an attenuation
      * over time to the Signal.
@@ -77,6 +99,33 @@ public:
     {
         return true;
     }
+
+    double getEvaluationCost() const override
+    {
+        // requires intersecting the line of sight with all nearby obstacles
+        return 100;
+    }
+
+    bool isShareable() const override
+    {
+        // the sensitivity is the reception power threshold of the phy that created the model, which other phys configured alike need not share
+        return sensitivity == 0;
+    }
+
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+    /**
+     * Once the hosts' geometry is committed, filterSignal uses VehicleObstacleControl::queryPotentialObstacles() with scratch buffers of its thread.
+     */
+    bool isThreadSafe() const override
+    {
+        return queryConcurrently;
+    }
+
+    void prepareConcurrentFiltering() override;
 };
 
 } // namespace veins
@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/application/ieee80211p/BeaconScheduler.h"
+
+#include <algorithm>
+
+using namespace veins;
+
+Define_Module(veins::BeaconScheduler);
+
+BeaconScheduler::BeaconScheduler()
+    : slotEvt(nullptr)
+{
+}
+
+BeaconScheduler::~BeaconScheduler()
+{
+    cancelAndDelete(slotEvt);
+}
+
+void BeaconScheduler::initialize()
+{
+    slotLength = par("slotLength");
+    if (slotLength <= 0) throw cRuntimeError("slotLength must be positive");
+    slotEvt = new cMessage("beacon slot");
+}
+
+void BeaconScheduler::schedule(cModule* client, int kind, simtime_t due, uint64_t ticket)
+{
+    Enter_Method_Silent();
+    ASSERT(dynamic_cast<Client*>(client));
+    if (due < simTime()) throw cRuntimeError("Cannot schedule an event of %s in the past", client->getFullPath().c_str());
+
+    slots[due.raw() / slotLength.raw()].push_back({client->getId(), kind, due, ticket});
+    rescheduleSlotEvt();
+}
+
+simtime_t BeaconScheduler::getSlotStart(int64_t slot) const
+{
+    return SimTime().setRaw(slot * slotLength.raw());
+}
+
+void BeaconScheduler::rescheduleSlotEvt()
+{
+    if (slots.empty()) {
+        cancelEvent(slotEvt);
+        return;
+    }
+
+    // events might be scheduled for the slot that has begun already
+    const simtime_t next = std::max(simTime(), getSlotStart(slots.begin()->first));
+    if (slotEvt->isScheduled()) {
+        if (slotEvt->getArrivalTime() == next) return;
+        cancelEvent(slotEvt);
+    }
+    scheduleAt(next, slotEvt);
+}
+
+void BeaconScheduler::handleMessage(cMessage* msg)
+{
+    ASSERT(msg == slotEvt);
+
+    while (!slots.empty() && getSlotStart(slots.begin()->first) <= simTime()) {
+        // clients will schedule their next events while we iterate
+        std::vector<Entry> entries = std::move(slots.begin()->second);
+        slots.erase(slots.begin());
+
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.due < b.due; });
+        for (const Entry& entry : entries) {
+            // clients deleted in the meantime are skipped
+            auto client = dynamic_cast<Client*>(getSimulation()->getModule(entry.clientId));
+            if (client) client->handleScheduledEvent(entry.kind, entry.due, entry.ticket);
+        }
+    }
+
+    rescheduleSlotEvt();
+}
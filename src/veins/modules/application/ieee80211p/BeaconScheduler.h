@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Central scheduler for periodic transmissions of many modules, firing one event per time slot.
+ *
+ * Clients register events with an opaque ticket and are called back, in order of their due time, once the slot containing the due time begins.
+ * Clients are referenced by module id, so their deletion needs no unregistering; to cancel an event, a client simply ignores callbacks with outdated tickets.
+ *
+ * See the NED file for details.
+ */
+class VEINS_API BeaconScheduler : public cSimpleModule {
+public:
+    /**
+     * @brief Interface of modules having their events scheduled by BeaconScheduler.
+     */
+    class VEINS_API Client {
+    public:
+        virtual ~Client()
+        {
+        }
+
+        /**
+         * @brief Called (in the context of the BeaconScheduler) at the beginning of the slot containing due.
+         *
+         * @param kind the kind passed to BeaconScheduler::schedule()
+         * @param due the time the event was scheduled for, at or after the current simulation time
+         * @param ticket the ticket passed to BeaconScheduler::schedule()
+         */
+        virtual void handleScheduledEvent(int kind, simtime_t due, uint64_t ticket) = 0;
+    };
+
+    BeaconScheduler();
+    ~BeaconScheduler() override;
+
+    void initialize() override;
+    void handleMessage(cMessage* msg) override;
+
+    /**
+     * @brief Schedules a callback of client for the slot containing due (which must not be in the past).
+     */
+    void schedule(cModule* client, int kind, simtime_t due, uint64_t ticket);
+
+    simtime_t getSlotLength() const
+    {
+        return slotLength;
+    }
+
+protected:
+    struct Entry {
+        int clientId;
+        int kind;
+        simtime_t due;
+        uint64_t ticket;
+    };
+
+    /**
+     * @brief Makes sure slotEvt is scheduled for the earliest non-empty slot.
+     */
+    void rescheduleSlotEvt();
+
+    simtime_t getSlotStart(int64_t slot) const;
+
+    simtime_t slotLength; /**< length of one time slot */
+    cMessage* slotEvt; /**< the one event marking the beginning of the next non-empty slot */
+    std::map<int64_t, std::vector<Entry>> slots; /**< scheduled events, by index of their slot */
+};
+
+} // namespace veins
@@ -31,7 +31,7 @@ void DemoBaseApplLayer::initialize(int stage)
     if (stage == 0) {
 
         // initialize pointers to other modules
-        if (FindModule<TraCIMobility*>::findSubModule(getParentModule())) {
+        if (FindModule<TraCIMobility*>::findSubModuleCached(getParentModule())) {
             mobility = TraCIMobilityAccess().get(getParentModule());
             traci = mobility->getCommandInterface();
             traciVehicle = mobility->getVehicleCommandInterface();
@@ -45,12 +45,15 @@ void DemoBaseApplLayer::initialize(int stage)
         annotations = AnnotationManagerAccess().getIfExists();
         ASSERT(annotations);
 
-        mac = FindModule<DemoBaseApplLayerToMac1609_4Interface*>::findSubModule(getParentModule());
+        mac = FindModule<DemoBaseApplLayerToMac1609_4Interface*>::findSubModuleCached(getParentModule());
         ASSERT(mac);
 
+        beaconScheduler = FindModule<BeaconScheduler*>::findGlobalModule();
+
         // read parameters
         headerLength = par("headerLength");
         sendBeacons = par("sendBeacons").boolValue();
+        compactBeacons = par("compactBeacons").boolValue();
         beaconLengthBits = par("beaconLengthBits");
         beaconUserPriority = par("beaconUserPriority");
         beaconInterval = par("beaconInterval");
@@ -76,35 +79,87 @@ void DemoBaseApplLayer::initialize(int stage)
         receivedBSMs = 0;
         receivedWSAs = 0;
         receivedWSMs = 0;
+
+        messageHandlers.clear();
+        registerMessageHandler(BSM_TYPE, [this](BaseFrame1609_4* wsm) {
+            ASSERT(dynamic_cast<DemoSafetyMessage*>(wsm));
+            receivedBSMs++;
+            onBSM(static_cast<DemoSafetyMessage*>(wsm));
+        });
+        registerMessageHandler(WSA_TYPE, [this](BaseFrame1609_4* wsm) {
+            ASSERT(dynamic_cast<DemoServiceAdvertisment*>(wsm));
+            receivedWSAs++;
+            onWSA(static_cast<DemoServiceAdvertisment*>(wsm));
+        });
+        registerMessageHandler(COMPACT_BSM_TYPE, [this](BaseFrame1609_4* wsm) {
+            ASSERT(dynamic_cast<CompactSafetyMessage*>(wsm));
+            receivedBSMs++;
+            onCompactBSM(static_cast<CompactSafetyMessage*>(wsm));
+        });
     }
     else if (stage == 1) {
+        startChannelAccess();
+    }
+}
 
-        // store MAC address for quick access
-        myId = mac->getMACAddress();
+void DemoBaseApplLayer::resetForReuse(int stage)
+{
+    BaseApplLayer::resetForReuse(stage);
+    if (stage == 0) {
+        // the vehicle command interface of the previous vehicle is gone
+        if (mobility) {
+            traci = mobility->getCommandInterface();
+            traciVehicle = mobility->getVehicleCommandInterface();
+        }
 
-        // simulate asynchronous channel access
+        // events of the previous vehicle still in the BeaconScheduler are ignored by their outdated tickets
+        cancelPeriodicEvent(sendBeaconEvt);
+        cancelPeriodicEvent(sendWSAEvt);
+        appTasks.reset();
 
-        if (dataOnSch == true && !mac->isChannelSwitchingActive()) {
-            dataOnSch = false;
-            EV_ERROR << "App wants to send data on SCH but MAC doesn't use any SCH. Sending all data on CCH" << std::endl;
-        }
-        simtime_t firstBeacon = simTime();
+        dataOnSch = par("dataOnSch").boolValue();
+        currentOfferedServiceId = -1;
+        isParked = false;
 
-        if (par("avoidBeaconSynchronization").boolValue() == true) {
+        generatedBSMs = 0;
+        generatedWSAs = 0;
+        generatedWSMs = 0;
+        receivedBSMs = 0;
+        receivedWSAs = 0;
+        receivedWSMs = 0;
+    }
+    else if (stage == 1) {
+        startChannelAccess();
+    }
+}
 
-            simtime_t randomOffset = dblrand() * beaconInterval;
-            firstBeacon = simTime() + randomOffset;
+void DemoBaseApplLayer::startChannelAccess()
+{
+    // store MAC address for quick access
+    myId = mac->getMACAddress();
 
-            if (mac->isChannelSwitchingActive() == true) {
-                if (beaconInterval.raw() % (mac->getSwitchingInterval().raw() * 2)) {
-                    EV_ERROR << "The beacon interval (" << beaconInterval << ") is smaller than or not a multiple of  one synchronization interval (" << 2 * mac->getSwitchingInterval() << "). This means that beacons are generated during SCH intervals" << std::endl;
-                }
-                firstBeacon = computeAsynchronousSendingTime(beaconInterval, ChannelType::control);
-            }
+    // simulate asynchronous channel access
+
+    if (dataOnSch == true && !mac->isChannelSwitchingActive()) {
+        dataOnSch = false;
+        EV_ERROR << "App wants to send data on SCH but MAC doesn't use any SCH. Sending all data on CCH" << std::endl;
+    }
+    simtime_t firstBeacon = simTime();
+
+    if (par("avoidBeaconSynchronization").boolValue() == true) {
+
+        simtime_t randomOffset = dblrand() * beaconInterval;
+        firstBeacon = simTime() + randomOffset;
 
-            if (sendBeacons) {
-                scheduleAt(firstBeacon, sendBeaconEvt);
+        if (mac->isChannelSwitchingActive() == true) {
+            if (beaconInterval.raw() % (mac->getSwitchingInterval().raw() * 2)) {
+                EV_ERROR << "The beacon interval (" << beaconInterval << ") is smaller than or not a multiple of  one synchronization interval (" << 2 * mac->getSwitchingInterval() << "). This means that beacons are generated during SCH intervals" << std::endl;
             }
+            firstBeacon = computeAsynchronousSendingTime(beaconInterval, ChannelType::control);
+        }
+
+        if (sendBeacons) {
+            schedulePeriodicEvent(sendBeaconEvt, firstBeacon);
         }
     }
 }
@@ -151,6 +206,77 @@ simtime_t DemoBaseApplLayer::computeAsynchronousSendingTime(simtime_t interval,
     return firstEvent;
 }
 
+void DemoBaseApplLayer::sendBeacon(simtime_t at)
+{
+    BaseFrame1609_4* bsm = compactBeacons ? static_cast<BaseFrame1609_4*>(new CompactSafetyMessage()) : new DemoSafetyMessage();
+    populateWSM(bsm);
+    if (at > simTime()) {
+        sendDelayedDown(bsm, at - simTime());
+    }
+    else {
+        sendDown(bsm);
+    }
+    // congestion control in the mac may ask for fewer beacons
+    schedulePeriodicEvent(sendBeaconEvt, at + std::max(beaconInterval, mac->getDccMinPacketInterval()));
+}
+
+void DemoBaseApplLayer::sendWSA(simtime_t at)
+{
+    DemoServiceAdvertisment* wsa = new DemoServiceAdvertisment();
+    populateWSM(wsa);
+    if (at > simTime()) {
+        sendDelayedDown(wsa, at - simTime());
+    }
+    else {
+        sendDown(wsa);
+    }
+    schedulePeriodicEvent(sendWSAEvt, at + wsaInterval);
+}
+
+void DemoBaseApplLayer::schedulePeriodicEvent(cMessage* evt, simtime_t at)
+{
+    if (!beaconScheduler) {
+        scheduleAt(at, evt);
+        return;
+    }
+    uint64_t& ticket = (evt == sendBeaconEvt) ? beaconTicket : wsaTicket;
+    ticket = ++lastTicket;
+    beaconScheduler->schedule(this, evt->getKind(), at, ticket);
+}
+
+void DemoBaseApplLayer::cancelPeriodicEvent(cMessage* evt)
+{
+    // events scheduled via the BeaconScheduler are ignored once their ticket is outdated
+    ((evt == sendBeaconEvt) ? beaconTicket : wsaTicket) = 0;
+    cancelEvent(evt);
+}
+
+bool DemoBaseApplLayer::isPeriodicEventScheduled(cMessage* evt) const
+{
+    return evt->isScheduled() || ((evt == sendBeaconEvt) ? beaconTicket : wsaTicket) != 0;
+}
+
+void DemoBaseApplLayer::handleScheduledEvent(int kind, simtime_t due, uint64_t ticket)
+{
+    Enter_Method_Silent();
+    // the host was parked before its periodic events were due
+    if (parkedForReuse) return;
+    switch (kind) {
+    case SEND_BEACON_EVT:
+        if (ticket != beaconTicket) return;
+        beaconTicket = 0;
+        sendBeacon(due);
+        break;
+    case SEND_WSA_EVT:
+        if (ticket != wsaTicket) return;
+        wsaTicket = 0;
+        sendWSA(due);
+        break;
+    default:
+        throw cRuntimeError("Unknown kind of scheduled event: %d", kind);
+    }
+}
+
 void DemoBaseApplLayer::populateWSM(BaseFrame1609_4* wsm, LAddress::L2Type rcvId, int serial)
 {
     wsm->setRecipientAddress(rcvId);
@@ -164,6 +290,14 @@ void DemoBaseApplLayer::populateWSM(BaseFrame1609_4* wsm, LAddress::L2Type rcvId
         bsm->addBitLength(beaconLengthBits);
         wsm->setUserPriority(beaconUserPriority);
     }
+    else if (CompactSafetyMessage* bsm = dynamic_cast<CompactSafetyMessage*>(wsm)) {
+        bsm->setSenderPos(curPosition);
+        bsm->setSenderSpeed(curSpeed);
+        bsm->setPsid(-1);
+        bsm->setChannelNumber(static_cast<int>(Channel::cch));
+        bsm->addBitLength(beaconLengthBits);
+        wsm->setUserPriority(beaconUserPriority);
+    }
     else if (DemoServiceAdvertisment* wsa = dynamic_cast<DemoServiceAdvertisment*>(wsm)) {
         wsa->setChannelNumber(static_cast<int>(Channel::cch));
         wsa->setTargetChannel(static_cast<int>(currentServiceChannel));
@@ -209,37 +343,49 @@ void DemoBaseApplLayer::handleLowerMsg(cMessage* msg)
     BaseFrame1609_4* wsm = dynamic_cast<BaseFrame1609_4*>(msg);
     ASSERT(wsm);
 
-    if (DemoSafetyMessage* bsm = dynamic_cast<DemoSafetyMessage*>(wsm)) {
-        receivedBSMs++;
-        onBSM(bsm);
-    }
-    else if (DemoServiceAdvertisment* wsa = dynamic_cast<DemoServiceAdvertisment*>(wsm)) {
-        receivedWSAs++;
-        onWSA(wsa);
+    int messageType = wsm->getMessageType();
+    if ((messageType >= 0) && (static_cast<size_t>(messageType) < messageHandlers.size()) && messageHandlers[messageType]) {
+        messageHandlers[messageType](wsm);
     }
     else {
         receivedWSMs++;
         onWSM(wsm);
     }
+    // resume the tasks waiting for a frame of this type
+    if (appTasks.hasWaiters(messageType)) appTasks.notify(messageType, wsm);
 
     delete (msg);
 }
 
+void DemoBaseApplLayer::onCompactBSM(CompactSafetyMessage* bsm)
+{
+    // applications that only know DemoSafetyMessage get an equivalent one
+    DemoSafetyMessage equivalent;
+    static_cast<BaseFrame1609_4&>(equivalent) = *bsm;
+    equivalent.setMessageType(BSM_TYPE);
+    equivalent.setSenderPos(bsm->getSenderPos());
+    equivalent.setSenderSpeed(bsm->getSenderSpeed());
+    onBSM(&equivalent);
+}
+
+void DemoBaseApplLayer::registerMessageHandler(int messageType, MessageHandler handler)
+{
+    if (messageType < 0) throw cRuntimeError("Message type must not be negative");
+    if (static_cast<size_t>(messageType) >= messageHandlers.size()) messageHandlers.resize(messageType + 1);
+    messageHandlers[messageType] = std::move(handler);
+}
+
 void DemoBaseApplLayer::handleSelfMsg(cMessage* msg)
 {
+    if (appTasks.handleMessage(msg)) return;
+
     switch (msg->getKind()) {
     case SEND_BEACON_EVT: {
-        DemoSafetyMessage* bsm = new DemoSafetyMessage();
-        populateWSM(bsm);
-        sendDown(bsm);
-        scheduleAt(simTime() + beaconInterval, sendBeaconEvt);
+        sendBeacon(simTime());
         break;
     }
     case SEND_WSA_EVT: {
-        DemoServiceAdvertisment* wsa = new DemoServiceAdvertisment();
-        populateWSM(wsa);
-        sendDown(wsa);
-        scheduleAt(simTime() + wsaInterval, sendWSAEvt);
+        sendWSA(simTime());
         break;
     }
     default: {
@@ -259,6 +405,8 @@ void DemoBaseApplLayer::finish()
 
     recordScalar("generatedWSAs", generatedWSAs);
     recordScalar("receivedWSAs", receivedWSAs);
+
+    if (appTasks.getNumResumes() > 0) recordScalar("appTaskResumes", appTasks.getNumResumes());
 }
 
 DemoBaseApplLayer::~DemoBaseApplLayer()
@@ -270,7 +418,7 @@ DemoBaseApplLayer::~DemoBaseApplLayer()
 
 void DemoBaseApplLayer::startService(Channel channel, int serviceId, std::string serviceDescription)
 {
-    if (sendWSAEvt->isScheduled()) {
+    if (isPeriodicEventScheduled(sendWSAEvt)) {
         throw cRuntimeError("Starting service although another service was already started");
     }
 
@@ -280,12 +428,12 @@ void DemoBaseApplLayer::startService(Channel channel, int serviceId, std::string
     currentServiceDescription = serviceDescription;
 
     simtime_t wsaTime = computeAsynchronousSendingTime(wsaInterval, ChannelType::control);
-    scheduleAt(wsaTime, sendWSAEvt);
+    schedulePeriodicEvent(sendWSAEvt, wsaTime);
 }
 
 void DemoBaseApplLayer::stopService()
 {
-    cancelEvent(sendWSAEvt);
+    cancelPeriodicEvent(sendWSAEvt);
     currentOfferedServiceId = -1;
 }
 
@@ -303,7 +451,7 @@ void DemoBaseApplLayer::sendDelayedDown(cMessage* msg, simtime_t delay)
 
 void DemoBaseApplLayer::checkAndTrackPacket(cMessage* msg)
 {
-    if (dynamic_cast<DemoSafetyMessage*>(msg)) {
+    if (dynamic_cast<DemoSafetyMessage*>(msg) || dynamic_cast<CompactSafetyMessage*>(msg)) {
         EV_TRACE << "sending down a BSM" << std::endl;
         generatedBSMs++;
     }
@@ -22,17 +22,22 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
+#include <vector>
 
 #include "veins/base/modules/BaseApplLayer.h"
 #include "veins/modules/utility/Consts80211p.h"
 #include "veins/modules/messages/BaseFrame1609_4_m.h"
 #include "veins/modules/messages/DemoServiceAdvertisement_m.h"
 #include "veins/modules/messages/DemoSafetyMessage_m.h"
+#include "veins/modules/messages/CompactSafetyMessage.h"
 #include "veins/base/connectionManager/ChannelAccess.h"
 #include "veins/modules/mac/ieee80211p/DemoBaseApplLayerToMac1609_4Interface.h"
 #include "veins/modules/mobility/traci/TraCIMobility.h"
 #include "veins/modules/mobility/traci/TraCICommandInterface.h"
+#include "veins/modules/application/ieee80211p/BeaconScheduler.h"
+#include "veins/modules/utility/AppTask.h"
 
 namespace veins {
 
@@ -55,24 +60,56 @@ using veins::TraCIMobilityAccess;
  * @see PhyLayer80211p
  * @see Decider80211p
  */
-class VEINS_API DemoBaseApplLayer : public BaseApplLayer {
+class VEINS_API DemoBaseApplLayer : public BaseApplLayer, public BeaconScheduler::Client {
 
 public:
     ~DemoBaseApplLayer() override;
     void initialize(int stage) override;
     void finish() override;
 
+    bool isReusable() const override
+    {
+        return true;
+    }
+
+    /** @brief Cancels beacons, WSAs, and tasks of the previous vehicle and starts beaconing anew, see BaseModule::resetForReuse() */
+    void resetForReuse(int stage) override;
+
     void receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details) override;
 
+    /** @brief generates the beacon or WSA scheduled via the BeaconScheduler */
+    void handleScheduledEvent(int kind, simtime_t due, uint64_t ticket) override;
+
     enum DemoApplMessageKinds {
         SEND_BEACON_EVT,
         SEND_WSA_EVT
     };
 
+    /** @brief compact type IDs of received frames (see BaseFrame1609_4::messageType), custom messages should use IDs from FIRST_CUSTOM_MESSAGE_TYPE on */
+    enum DemoMessageTypes {
+        WSM_TYPE = 0,
+        BSM_TYPE = 1,
+        WSA_TYPE = 2,
+        COMPACT_BSM_TYPE = CompactSafetyMessage::messageTypeId,
+        FIRST_CUSTOM_MESSAGE_TYPE = 16
+    };
+
+    /** @brief handler of a received frame of a registered message type */
+    using MessageHandler = std::function<void(BaseFrame1609_4*)>;
+
 protected:
-    /** @brief handle messages from below and calls the onWSM, onBSM, and onWSA functions accordingly */
+    /** @brief handle messages from below and calls the handler registered for their message type (by default, onBSM and onWSA) or onWSM */
     void handleLowerMsg(cMessage* msg) override;
 
+    /**
+     * @brief makes handleLowerMsg() pass received frames of the given message type to handler (instead of onWSM)
+     *
+     * Dispatch is a table lookup, so registering handlers for many message types does not slow down receptions.
+     * The handler can rely on frames being of the type that sets this message type, so it can static_cast them.
+     * Registering a handler for a type that already has one replaces it.
+     */
+    void registerMessageHandler(int messageType, MessageHandler handler);
+
     /** @brief handle self messages */
     void handleSelfMsg(cMessage* msg) override;
 
@@ -85,6 +122,9 @@ protected:
     /** @brief this function is called upon receiving a DemoSafetyMessage, also referred to as a beacon  */
     virtual void onBSM(DemoSafetyMessage* bsm){};
 
+    /** @brief this function is called upon receiving a CompactSafetyMessage; by default, it passes an equivalent DemoSafetyMessage to onBSM */
+    virtual void onCompactBSM(CompactSafetyMessage* bsm);
+
     /** @brief this function is called upon receiving a DemoServiceAdvertisement */
     virtual void onWSA(DemoServiceAdvertisment* wsa){};
 
@@ -112,6 +152,21 @@ protected:
      */
     virtual simtime_t computeAsynchronousSendingTime(simtime_t interval, ChannelType chantype);
 
+    /** @brief generates a beacon handed to the MAC at the given time (now or, via the BeaconScheduler, later) and schedules the next one */
+    virtual void sendBeacon(simtime_t at);
+
+    /** @brief generates a WSA handed to the MAC at the given time (now or, via the BeaconScheduler, later) and schedules the next one */
+    virtual void sendWSA(simtime_t at);
+
+    /** @brief schedules sendBeaconEvt or sendWSAEvt at the given time, through the BeaconScheduler if there is one */
+    void schedulePeriodicEvent(cMessage* evt, simtime_t at);
+
+    /** @brief cancels sendBeaconEvt or sendWSAEvt */
+    void cancelPeriodicEvent(cMessage* evt);
+
+    /** @brief whether sendBeaconEvt or sendWSAEvt is scheduled */
+    bool isPeriodicEventScheduled(cMessage* evt) const;
+
     /**
      * @brief overloaded for error handling and stats recording purposes
      *
@@ -134,6 +189,9 @@ protected:
      */
     virtual void checkAndTrackPacket(cMessage* msg);
 
+    /** @brief stage 1 of initialize() and resetForReuse(): stores the MAC address and schedules the first beacon */
+    void startChannelAccess();
+
 protected:
     /* pointers ill be set when used with TraCIMobility */
     TraCIMobility* mobility;
@@ -151,6 +209,7 @@ protected:
     uint32_t beaconUserPriority;
     simtime_t beaconInterval;
     bool sendBeacons;
+    bool compactBeacons;
 
     /* WSM (data) settings */
     uint32_t dataLengthBits;
@@ -177,9 +236,21 @@ protected:
     uint32_t receivedWSAs;
     uint32_t receivedBSMs;
 
+    /* handlers of received frames, indexed by message type (empty: onWSM) */
+    std::vector<MessageHandler> messageHandlers;
+
     /* messages for periodic events such as beacon and WSA transmissions */
     cMessage* sendBeaconEvt;
     cMessage* sendWSAEvt;
+
+    /* central scheduler of periodic events (nullptr if every node schedules its own) */
+    BeaconScheduler* beaconScheduler;
+    uint64_t lastTicket = 0; ///< last ticket handed to the BeaconScheduler
+    uint64_t beaconTicket = 0; ///< ticket of the scheduled beacon (0: none scheduled)
+    uint64_t wsaTicket = 0; ///< ticket of the scheduled WSA (0: none scheduled)
+
+    /* resumable tasks of the application, awaiting timeouts or received frames (by message type) */
+    AppTaskScheduler appTasks{this};
 };
 
 } // namespace veins
@@ -38,6 +38,24 @@ void TraCIDemo11p::initialize(int stage)
     }
 }
 
+void TraCIDemo11p::resetForReuse(int stage)
+{
+    DemoBaseApplLayer::resetForReuse(stage);
+    if (stage == 0) {
+        cancelAndDelete(scheduledUpdate);
+        scheduledUpdate = nullptr;
+        findHost()->getDisplayString().setTagArg("i", 1, "");
+        sentMessage = false;
+        lastDroveAt = simTime();
+        currentSubscribedServiceId = -1;
+    }
+}
+
+TraCIDemo11p::~TraCIDemo11p()
+{
+    cancelAndDelete(scheduledUpdate);
+}
+
 void TraCIDemo11p::onWSA(DemoServiceAdvertisment* wsa)
 {
     if (currentSubscribedServiceId == -1) {
@@ -56,13 +74,14 @@ void TraCIDemo11p::onWSM(BaseFrame1609_4* frame)
 
     findHost()->getDisplayString().setTagArg("i", 1, "green");
 
-    if (mobility->getRoadId()[0] != ':') traciVehicle->changeRoute(wsm->getDemoData(), 9999);
+    if (mobility->getRoadId()[0] != ':') traciVehicle->queueChangeRoute(wsm->getDemoData(), 9999);
     if (!sentMessage) {
         sentMessage = true;
         // repeat the received traffic update once in 2 seconds plus some random delay
         wsm->setSenderAddress(myId);
         wsm->setSerial(3);
-        scheduleAt(simTime() + 2 + uniform(0.01, 0.2), wsm->dup());
+        scheduledUpdate = wsm->dup();
+        scheduleAt(simTime() + 2 + uniform(0.01, 0.2), scheduledUpdate);
     }
 }
 
@@ -77,6 +96,7 @@ void TraCIDemo11p::handleSelfMsg(cMessage* msg)
             // stop service advertisements
             stopService();
             delete (wsm);
+            scheduledUpdate = nullptr;
         }
         else {
             scheduleAt(simTime() + 1, wsm);
@@ -105,7 +125,8 @@ void TraCIDemo11p::handlePositionUpdate(cObject* obj)
             if (dataOnSch) {
                 startService(Channel::sch2, 42, "Traffic Information Service");
                 // started service and server advertising, schedule message to self to send later
-                scheduleAt(computeAsynchronousSendingTime(1, ChannelType::service), wsm);
+                scheduledUpdate = wsm;
+                scheduleAt(computeAsynchronousSendingTime(1, ChannelType::service), scheduledUpdate);
             }
             else {
                 // send right away on CCH, because channel switching is disabled
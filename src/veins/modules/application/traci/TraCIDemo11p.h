@@ -42,12 +42,17 @@ namespace veins {
 
 class VEINS_API TraCIDemo11p : public DemoBaseApplLayer {
 public:
+    ~TraCIDemo11p() override;
     void initialize(int stage) override;
 
+    /** @brief Also drops the traffic update of the previous vehicle, see DemoBaseApplLayer::resetForReuse() */
+    void resetForReuse(int stage) override;
+
 protected:
     simtime_t lastDroveAt;
     bool sentMessage;
     int currentSubscribedServiceId;
+    cMessage* scheduledUpdate = nullptr; ///< traffic update scheduled to be sent (again) on the SCH, if any
 
 protected:
     void onWSM(BaseFrame1609_4* wsm) override;
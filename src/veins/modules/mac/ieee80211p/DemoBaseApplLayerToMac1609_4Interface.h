@@ -45,6 +45,16 @@ public:
 
     virtual void changeServiceChannel(Channel channelNumber) = 0;
 
+    /**
+     * @brief Returns the channel busy ratio of the last complete measurement interval.
+     */
+    virtual double getChannelBusyRatio() = 0;
+
+    /**
+     * @brief Returns the shortest interval between packets allowed by congestion control (0 if unrestricted).
+     */
+    virtual simtime_t getDccMinPacketInterval() = 0;
+
     virtual ~DemoBaseApplLayerToMac1609_4Interface(){};
 
     /**
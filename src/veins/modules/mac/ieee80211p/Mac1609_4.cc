@@ -26,8 +26,10 @@
 
 #include "veins/modules/phy/DeciderResult80211.h"
 #include "veins/base/phyLayer/PhyToMacControlInfo.h"
+#include "veins/base/utils/FWMath.h"
 #include "veins/modules/messages/PhyControlMessage_m.h"
 #include "veins/modules/messages/AckTimeOutMessage_m.h"
+#include "veins/modules/messages/AggregateFrame1609_4.h"
 
 using namespace veins;
 
@@ -40,124 +42,213 @@ const simsignal_t Mac1609_4::sigCollision = registerSignal("org_car2x_veins_modu
 const simsignal_t Mac1609_4::sigSentPacket = registerSignal("org_car2x_veins_modules_mac_sigSentPacket");
 const simsignal_t Mac1609_4::sigSentAck = registerSignal("org_car2x_veins_modules_mac_sigSentAck");
 const simsignal_t Mac1609_4::sigRetriesExceeded = registerSignal("org_car2x_veins_modules_mac_sigRetriesExceeded");
+const simsignal_t Mac1609_4::sigQueueDrop = registerSignal("org_car2x_veins_modules_mac_sigQueueDrop");
+const simsignal_t Mac1609_4::sigQueueOccupancy = registerSignal("org_car2x_veins_modules_mac_sigQueueOccupancy");
 
 void Mac1609_4::initialize(int stage)
 {
     BaseMacLayer::initialize(stage);
     if (stage == 0) {
+        initializeMacState();
+    }
+}
 
-        phy11p = FindModule<Mac80211pToPhy11pInterface*>::findSubModule(getParentModule());
-        ASSERT(phy11p);
-
-        // this is required to circumvent double precision issues with constants from CONST80211p.h
-        ASSERT(simTime().getScaleExp() == -12);
-
-        txPower = par("txPower").doubleValue();
-        int bitrate = par("bitrate");
-        setParametersForBitrate(bitrate);
+void Mac1609_4::resetForReuse(int stage)
+{
+    BaseMacLayer::resetForReuse(stage);
+    if (stage == 0) {
+        // drop everything left by the previous vehicle, then start over (parameters are read again, but stay the same)
+        deleteTimers();
+        myEDCA.clear();
+        lastWSM = nullptr;
+        lastMac.reset();
+        dcc.reset();
+        lastDccInterval = 0;
+        handledUnicastToApp.clear();
+        initializeMacState();
+    }
+}
 
-        // unicast parameters
-        dot11RTSThreshold = par("dot11RTSThreshold");
-        dot11ShortRetryLimit = par("dot11ShortRetryLimit");
-        dot11LongRetryLimit = par("dot11LongRetryLimit");
-        ackLength = par("ackLength");
-        useAcks = par("useAcks").boolValue();
-        frameErrorRate = par("frameErrorRate").doubleValue();
-        ackErrorRate = par("ackErrorRate").doubleValue();
-        rxStartIndication = false;
-        ignoreChannelState = false;
-        waitUntilAckRXorTimeout = false;
-        stopIgnoreChannelStateMsg = new cMessage("ChannelStateMsg");
-
-        myId = getParentModule()->getParentModule()->getFullPath();
-        // create two edca systems
-
-        myEDCA[ChannelType::control] = make_unique<EDCA>(this, ChannelType::control, par("queueSize"));
-        myEDCA[ChannelType::control]->myId = myId;
-        myEDCA[ChannelType::control]->myId.append(" CCH");
-        myEDCA[ChannelType::control]->createQueue(2, (((CWMIN_11P + 1) / 4) - 1), (((CWMIN_11P + 1) / 2) - 1), AC_VO);
-        myEDCA[ChannelType::control]->createQueue(3, (((CWMIN_11P + 1) / 2) - 1), CWMIN_11P, AC_VI);
-        myEDCA[ChannelType::control]->createQueue(6, CWMIN_11P, CWMAX_11P, AC_BE);
-        myEDCA[ChannelType::control]->createQueue(9, CWMIN_11P, CWMAX_11P, AC_BK);
-
-        myEDCA[ChannelType::service] = make_unique<EDCA>(this, ChannelType::service, par("queueSize"));
-        myEDCA[ChannelType::service]->myId = myId;
-        myEDCA[ChannelType::service]->myId.append(" SCH");
-        myEDCA[ChannelType::service]->createQueue(2, (((CWMIN_11P + 1) / 4) - 1), (((CWMIN_11P + 1) / 2) - 1), AC_VO);
-        myEDCA[ChannelType::service]->createQueue(3, (((CWMIN_11P + 1) / 2) - 1), CWMIN_11P, AC_VI);
-        myEDCA[ChannelType::service]->createQueue(6, CWMIN_11P, CWMAX_11P, AC_BE);
-        myEDCA[ChannelType::service]->createQueue(9, CWMIN_11P, CWMAX_11P, AC_BK);
-
-        useSCH = par("useServiceChannel").boolValue();
-        if (useSCH) {
-            if (useAcks) throw cRuntimeError("Unicast model does not support channel switching");
-            // set the initial service channel
-            int serviceChannel = par("serviceChannel");
-            switch (serviceChannel) {
-            case 1:
-                mySCH = Channel::sch1;
-                break;
-            case 2:
-                mySCH = Channel::sch2;
-                break;
-            case 3:
-                mySCH = Channel::sch3;
-                break;
-            case 4:
-                mySCH = Channel::sch4;
-                break;
-            default:
-                throw cRuntimeError("Service Channel must be between 1 and 4");
-                break;
+void Mac1609_4::initializeMacState()
+{
+    phy11p = FindModule<Mac80211pToPhy11pInterface*>::findSubModule(getParentModule());
+    ASSERT(phy11p);
+
+    // this is required to circumvent double precision issues with constants from CONST80211p.h
+    ASSERT(simTime().getScaleExp() == -12);
+
+    txPower = par("txPower").doubleValue();
+    scaleInterferenceDistance = hasPar("scaleInterferenceDistance") ? par("scaleInterferenceDistance").boolValue() : false;
+    if (scaleInterferenceDistance) {
+        phyChannelAccess = dynamic_cast<ChannelAccess*>(phy11p);
+        if (!phyChannelAccess) throw cRuntimeError("scaleInterferenceDistance requires the phy to be a ChannelAccess");
+        const double referenceTxPower = hasPar("interferenceDistanceTxPower") ? par("interferenceDistanceTxPower").doubleValue() : -1;
+        interferenceDistanceTxPower = (referenceTxPower > 0) ? referenceTxPower : txPower;
+        interferenceDistanceAlpha = hasPar("interferenceDistanceAlpha") ? par("interferenceDistanceAlpha").doubleValue() : 2;
+    }
+    int bitrate = par("bitrate");
+    setParametersForBitrate(bitrate);
+
+    // unicast parameters
+    dot11RTSThreshold = par("dot11RTSThreshold");
+    dot11ShortRetryLimit = par("dot11ShortRetryLimit");
+    dot11LongRetryLimit = par("dot11LongRetryLimit");
+    ackLength = par("ackLength");
+    useAcks = par("useAcks").boolValue();
+    frameErrorRate = par("frameErrorRate").doubleValue();
+    ackErrorRate = par("ackErrorRate").doubleValue();
+    rxStartIndication = false;
+    ignoreChannelState = false;
+    waitUntilAckRXorTimeout = false;
+    stopIgnoreChannelStateMsg = new cMessage("ChannelStateMsg");
+    ackTimeOut = new AckTimeOutMessage("AckTimeOut");
+
+    channelBusyRatio = ChannelBusyRatio(par("cbrInterval"), simTime());
+    if (par("useDcc").boolValue()) {
+        std::vector<double> cbrThresholds = cStringTokenizer(par("dccCbrThresholds").stringValue()).asDoubleVector();
+        std::vector<double> txPowers_dBm = cStringTokenizer(par("dccTxPowers").stringValue()).asDoubleVector();
+        std::vector<double> packetIntervals = cStringTokenizer(par("dccPacketIntervals").stringValue()).asDoubleVector();
+        if (txPowers_dBm.size() != cbrThresholds.size() + 1 || packetIntervals.size() != cbrThresholds.size() + 1) {
+            throw cRuntimeError("dccTxPowers and dccPacketIntervals need exactly one entry more than dccCbrThresholds");
+        }
+        std::vector<ReactiveDcc::State> states;
+        for (size_t i = 0; i < txPowers_dBm.size(); i++) {
+            double minCbr = (i == 0) ? 0 : cbrThresholds[i - 1];
+            if (i > 0 && minCbr <= states.back().minCbr) {
+                throw cRuntimeError("dccCbrThresholds must be positive and increasing");
             }
+            states.push_back({minCbr, FWMath::dBm2mW(txPowers_dBm[i]), packetIntervals[i]});
         }
+        dcc = make_unique<ReactiveDcc>(std::move(states));
+    }
+
+    myId = getParentModule()->getParentModule()->getFullPath();
 
-        headerLength = par("headerLength");
+    QueueDropPolicy queueDropPolicy;
+    std::string queueDropPolicyName = par("queueDropPolicy").stdstringValue();
+    if (queueDropPolicyName == "tail") {
+        queueDropPolicy = QueueDropPolicy::tail;
+    }
+    else if (queueDropPolicyName == "head") {
+        queueDropPolicy = QueueDropPolicy::head;
+    }
+    else if (queueDropPolicyName == "age") {
+        queueDropPolicy = QueueDropPolicy::age;
+    }
+    else {
+        throw cRuntimeError("Unknown queueDropPolicy \"%s\" (must be \"tail\", \"head\", or \"age\")", queueDropPolicyName.c_str());
+    }
+    simtime_t queueMaxAge = par("queueMaxAge");
+    if (queueDropPolicy == QueueDropPolicy::age && queueMaxAge <= 0) {
+        throw cRuntimeError("queueDropPolicy \"age\" requires a positive queueMaxAge");
+    }
+    bool aggregateFrames = par("aggregateFrames").boolValue();
+    simtime_t aggregationWindow = par("aggregationWindow");
+    int64_t aggregationMaxLength = par("aggregationMaxLength");
 
-        nextMacEvent = new cMessage("next Mac Event");
+    useSCH = par("useServiceChannel").boolValue();
+    if (useSCH) {
+        if (useAcks) throw cRuntimeError("Unicast model does not support channel switching");
+        // set the initial service channel
+        int serviceChannel = par("serviceChannel");
+        switch (serviceChannel) {
+        case 1:
+            mySCH = Channel::sch1;
+            break;
+        case 2:
+            mySCH = Channel::sch2;
+            break;
+        case 3:
+            mySCH = Channel::sch3;
+            break;
+        case 4:
+            mySCH = Channel::sch4;
+            break;
+        default:
+            throw cRuntimeError("Service Channel must be between 1 and 4");
+            break;
+        }
+    }
 
-        if (useSCH) {
-            uint64_t currenTime = simTime().raw();
-            uint64_t switchingTime = SWITCHING_INTERVAL_11P.raw();
-            double timeToNextSwitch = (double) (switchingTime - (currenTime % switchingTime)) / simTime().getScale();
-            if ((currenTime / switchingTime) % 2 == 0) {
-                setActiveChannel(ChannelType::control);
-            }
-            else {
-                setActiveChannel(ChannelType::service);
+    // create one edca system per channel in use, so nodes that never leave the CCH do not carry an idle SCH one
+    std::vector<ChannelType> channelTypes = {ChannelType::control};
+    if (useSCH) channelTypes.push_back(ChannelType::service);
+    bool useCounterRng = par("useCounterRng").boolValue();
+    uint64_t counterRngSeed = useCounterRng ? CounterRng::drawSeed(getRNG(0)) : 0;
+    for (auto channelType : channelTypes) {
+        auto edca = make_unique<EDCA>(this, channelType, par("queueSize"));
+        if (useCounterRng) edca->backoffRng = make_unique<CounterRng>(counterRngSeed, CounterRng::Purpose::backoff, getId(), static_cast<uint32_t>(channelType));
+        edca->myId = myId;
+        edca->myId.append(channelType == ChannelType::control ? " CCH" : " SCH");
+        edca->dropPolicy = queueDropPolicy;
+        edca->maxQueueAge = queueMaxAge;
+        edca->aggregateFrames = aggregateFrames;
+        edca->aggregationWindow = aggregationWindow;
+        edca->aggregationMaxLength = aggregationMaxLength;
+        edca->createQueue(2, (((CWMIN_11P + 1) / 4) - 1), (((CWMIN_11P + 1) / 2) - 1), AC_VO);
+        edca->createQueue(3, (((CWMIN_11P + 1) / 2) - 1), CWMIN_11P, AC_VI);
+        edca->createQueue(6, CWMIN_11P, CWMAX_11P, AC_BE);
+        edca->createQueue(9, CWMIN_11P, CWMAX_11P, AC_BK);
+        myEDCA[channelType] = std::move(edca);
+    }
+    memoryRegistration = MemoryAccounting::add("mac.queues", [this]() {
+        MemoryAccounting::Usage usage;
+        for (auto& edca : myEDCA) {
+            for (auto& edcaQueue : edca.second->myQueues) {
+                // frames are counted as BaseFrame1609_4, the (usually small) surplus of subclasses is not
+                usage.objects += edcaQueue.queue.size();
+                usage.bytes += edcaQueue.queue.bytesOfStorage() + edcaQueue.queue.size() * sizeof(BaseFrame1609_4);
             }
+        }
+        return usage;
+    });
 
-            // channel switching active
-            nextChannelSwitch = new cMessage("Channel Switch");
-            // add a little bit of offset between all vehicles, but no more than syncOffset
-            simtime_t offset = dblrand() * par("syncOffset").doubleValue();
-            scheduleAt(simTime() + offset + timeToNextSwitch, nextChannelSwitch);
+    headerLength = par("headerLength");
+
+    nextMacEvent = new cMessage("next Mac Event");
+
+    if (useSCH) {
+        uint64_t currenTime = simTime().raw();
+        uint64_t switchingTime = SWITCHING_INTERVAL_11P.raw();
+        double timeToNextSwitch = (double) (switchingTime - (currenTime % switchingTime)) / simTime().getScale();
+        if ((currenTime / switchingTime) % 2 == 0) {
+            setActiveChannel(ChannelType::control);
         }
         else {
-            // no channel switching
-            nextChannelSwitch = nullptr;
-            setActiveChannel(ChannelType::control);
+            setActiveChannel(ChannelType::service);
         }
 
-        // stats
-        statsReceivedPackets = 0;
-        statsReceivedBroadcasts = 0;
-        statsSentPackets = 0;
-        statsSentAcks = 0;
-        statsRetriesExceeded = 0;
-        statsTXRXLostPackets = 0;
-        statsSNIRLostPackets = 0;
-        statsDroppedPackets = 0;
-        statsNumTooLittleTime = 0;
-        statsNumInternalContention = 0;
-        statsNumBackoff = 0;
-        statsSlotsBackoff = 0;
-        statsTotalBusyTime = 0;
-
-        idleChannel = true;
-        lastBusy = simTime();
-        channelIdle(true);
+        // channel switching active
+        nextChannelSwitch = new cMessage("Channel Switch");
+        // add a little bit of offset between all vehicles, but no more than syncOffset
+        simtime_t offset = dblrand() * par("syncOffset").doubleValue();
+        scheduleAt(simTime() + offset + timeToNextSwitch, nextChannelSwitch);
     }
+    else {
+        // no channel switching
+        nextChannelSwitch = nullptr;
+        setActiveChannel(ChannelType::control);
+    }
+
+    // stats
+    statsReceivedPackets = 0;
+    statsReceivedBroadcasts = 0;
+    statsSentPackets = 0;
+    statsSentAcks = 0;
+    statsRetriesExceeded = 0;
+    statsTXRXLostPackets = 0;
+    statsSNIRLostPackets = 0;
+    statsDroppedPackets = 0;
+    statsNumTooLittleTime = 0;
+    statsNumInternalContention = 0;
+    statsNumBackoff = 0;
+    statsSlotsBackoff = 0;
+    statsNumAggregated = 0;
+    statsTotalBusyTime = 0;
+
+    idleChannel = true;
+    lastBusy = simTime();
+    channelIdle(true);
 }
 
 void Mac1609_4::handleSelfMsg(cMessage* msg)
@@ -167,8 +258,8 @@ void Mac1609_4::handleSelfMsg(cMessage* msg)
         return;
     }
 
-    if (AckTimeOutMessage* ackTimeOutMsg = dynamic_cast<AckTimeOutMessage*>(msg)) {
-        handleAckTimeOut(ackTimeOutMsg);
+    if (msg == ackTimeOut) {
+        handleAckTimeOut();
         return;
     }
 
@@ -179,14 +270,14 @@ void Mac1609_4::handleSelfMsg(cMessage* msg)
 
         switch (activeChannel) {
         case ChannelType::control:
-            EV_TRACE << "CCH --> SCH" << std::endl;
+            VEINS_LOG_TRACE << "CCH --> SCH" << std::endl;
             channelBusySelf(false);
             setActiveChannel(ChannelType::service);
             channelIdle(true);
             phy11p->changeListeningChannel(mySCH);
             break;
         case ChannelType::service:
-            EV_TRACE << "SCH --> CCH" << std::endl;
+            VEINS_LOG_TRACE << "SCH --> CCH" << std::endl;
             channelBusySelf(false);
             setActiveChannel(ChannelType::control);
             channelIdle(true);
@@ -204,8 +295,9 @@ void Mac1609_4::handleSelfMsg(cMessage* msg)
 
         lastAC = mapUserPriority(pktToSend->getUserPriority());
         lastWSM = pktToSend;
+        myEDCA[activeChannel]->myQueues[lastAC].frontInTransmission = true;
 
-        EV_TRACE << "MacEvent received. Trying to send packet with priority" << lastAC << std::endl;
+        VEINS_LOG_TRACE << "MacEvent received. Trying to send packet with priority" << lastAC << std::endl;
 
         // send the packet
         Mac80211Pkt* mac = new Mac80211Pkt(pktToSend->getName(), pktToSend->getKind());
@@ -236,16 +328,20 @@ void Mac1609_4::handleSelfMsg(cMessage* msg)
         else {
             txPower_mW = txPower;
         }
+        if (dcc) {
+            updateDcc();
+            txPower_mW = std::min(txPower_mW, dcc->getState().maxTxPower_mW);
+        }
 
         simtime_t sendingDuration = RADIODELAY_11P + phy11p->getFrameDuration(mac->getBitLength(), usedMcs);
-        EV_TRACE << "Sending duration will be" << sendingDuration << std::endl;
+        VEINS_LOG_TRACE << "Sending duration will be" << sendingDuration << std::endl;
         if ((!useSCH) || (timeLeftInSlot() > sendingDuration)) {
-            if (useSCH) EV_TRACE << " Time in this slot left: " << timeLeftInSlot() << std::endl;
+            if (useSCH) VEINS_LOG_TRACE << " Time in this slot left: " << timeLeftInSlot() << std::endl;
 
             Channel channelNr = (activeChannel == ChannelType::control) ? Channel::cch : mySCH;
             double freq = IEEE80211ChannelFrequencies.at(channelNr);
 
-            EV_TRACE << "Sending a Packet. Frequency " << freq << " Priority" << lastAC << std::endl;
+            VEINS_LOG_TRACE << "Sending a Packet. Frequency " << freq << " Priority" << lastAC << std::endl;
             sendFrame(mac, RADIODELAY_11P, channelNr, usedMcs, txPower_mW);
 
             // schedule ack timeout for unicast packets
@@ -254,15 +350,15 @@ void Mac1609_4::handleSelfMsg(cMessage* msg)
                 // PHY-RXSTART.indication should be received within ackWaitTime
                 // sifs + slot + rx_delay: see 802.11-2012 9.3.2.8 (32us + 13us + 49us = 94us)
                 simtime_t ackWaitTime(94, SIMTIME_US);
-                // update id in the retransmit timer
-                myEDCA[activeChannel]->myQueues[lastAC].ackTimeOut->setWsmId(pktToSend->getTreeId());
                 simtime_t timeOut = sendingDuration + ackWaitTime;
-                scheduleAt(simTime() + timeOut, myEDCA[activeChannel]->myQueues[lastAC].ackTimeOut);
+                myEDCA[activeChannel]->myQueues[lastAC].ackDeadline = simTime() + timeOut;
+                rescheduleAckTimeOut();
             }
         }
         else { // not enough time left now
-            EV_TRACE << "Too little Time left. This packet cannot be send in this slot." << std::endl;
+            VEINS_LOG_TRACE << "Too little Time left. This packet cannot be send in this slot." << std::endl;
             statsNumTooLittleTime++;
+            myEDCA[activeChannel]->myQueues[lastAC].frontInTransmission = false;
             // revoke TXOP
             myEDCA[activeChannel]->revokeTxOPs();
             delete mac;
@@ -284,7 +380,7 @@ void Mac1609_4::handleUpperMsg(cMessage* msg)
 
     t_access_category ac = mapUserPriority(thisMsg->getUserPriority());
 
-    EV_TRACE << "Received a message from upper layer for channel " << thisMsg->getChannelNumber() << " Access Category (Priority):  " << ac << std::endl;
+    VEINS_LOG_TRACE << "Received a message from upper layer for channel " << thisMsg->getChannelNumber() << " Access Category (Priority):  " << ac << std::endl;
 
     ChannelType chan;
 
@@ -292,7 +388,9 @@ void Mac1609_4::handleUpperMsg(cMessage* msg)
         chan = ChannelType::control;
     }
     else {
-        ASSERT(useSCH);
+        if (!useSCH) {
+            throw cRuntimeError("Received a frame for a service channel, but useServiceChannel is disabled");
+        }
         thisMsg->setChannelNumber(static_cast<int>(mySCH));
         chan = ChannelType::service;
     }
@@ -301,18 +399,23 @@ void Mac1609_4::handleUpperMsg(cMessage* msg)
 
     // packet was dropped in Mac
     if (num == -1) {
-        statsDroppedPackets++;
+        return;
+    }
+
+    // packet was appended to an already queued aggregate, so no times need to be reevaluated
+    if (num == 0) {
+        VEINS_LOG_TRACE << "aggregated packet into a frame already queued in EDCA " << static_cast<int>(chan) << std::endl;
         return;
     }
 
     // if this packet is not at the front of a new queue we dont have to reevaluate times
-    EV_TRACE << "sorted packet into queue of EDCA " << static_cast<int>(chan) << " this packet is now at position: " << num << std::endl;
+    VEINS_LOG_TRACE << "sorted packet into queue of EDCA " << static_cast<int>(chan) << " this packet is now at position: " << num << std::endl;
 
     if (chan == activeChannel) {
-        EV_TRACE << "this packet is for the currently active channel" << std::endl;
+        VEINS_LOG_TRACE << "this packet is for the currently active channel" << std::endl;
     }
     else {
-        EV_TRACE << "this packet is NOT for the currently active channel" << std::endl;
+        VEINS_LOG_TRACE << "this packet is NOT for the currently active channel" << std::endl;
     }
 
     if (num == 1 && idleChannel == true && chan == activeChannel) {
@@ -325,10 +428,10 @@ void Mac1609_4::handleUpperMsg(cMessage* msg)
                     cancelEvent(nextMacEvent);
                 }
                 scheduleAt(nextEvent, nextMacEvent);
-                EV_TRACE << "Updated nextMacEvent:" << nextMacEvent->getArrivalTime().raw() << std::endl;
+                VEINS_LOG_TRACE << "Updated nextMacEvent:" << nextMacEvent->getArrivalTime().raw() << std::endl;
             }
             else {
-                EV_TRACE << "Too little time in this interval. Will not schedule nextMacEvent" << std::endl;
+                VEINS_LOG_TRACE << "Too little time in this interval. Will not schedule nextMacEvent" << std::endl;
                 // it is possible that this queue has an txop. we have to revoke it
                 myEDCA[activeChannel]->revokeTxOPs();
                 statsNumTooLittleTime++;
@@ -356,10 +459,11 @@ void Mac1609_4::handleLowerControl(cMessage* msg)
         phy11p->notifyMacAboutRxStart(false);
         rxStartIndication = false;
         handleRetransmit(lastAC);
+        rescheduleAckTimeOut();
     }
     else if (msg->getKind() == MacToPhyInterface::TX_OVER) {
 
-        EV_TRACE << "Successfully transmitted a packet on " << lastAC << std::endl;
+        VEINS_LOG_TRACE << "Successfully transmitted a packet on " << lastAC << std::endl;
 
         phy->setRadioState(Radio::RX);
 
@@ -392,18 +496,18 @@ void Mac1609_4::handleLowerControl(cMessage* msg)
     }
     else if (msg->getKind() == Decider80211p::BITERROR || msg->getKind() == Decider80211p::COLLISION) {
         statsSNIRLostPackets++;
-        EV_TRACE << "A packet was not received due to biterrors" << std::endl;
+        VEINS_LOG_TRACE << "A packet was not received due to biterrors" << std::endl;
     }
     else if (msg->getKind() == Decider80211p::RECWHILESEND) {
         statsTXRXLostPackets++;
-        EV_TRACE << "A packet was not received because we were sending while receiving" << std::endl;
+        VEINS_LOG_TRACE << "A packet was not received because we were sending while receiving" << std::endl;
     }
     else if (msg->getKind() == MacToPhyInterface::RADIO_SWITCHING_OVER) {
-        EV_TRACE << "Phylayer said radio switching is done" << std::endl;
+        VEINS_LOG_TRACE << "Phylayer said radio switching is done" << std::endl;
     }
     else if (msg->getKind() == BaseDecider::PACKET_DROPPED) {
         phy->setRadioState(Radio::RX);
-        EV_TRACE << "Phylayer said packet was dropped" << std::endl;
+        VEINS_LOG_TRACE << "Phylayer said packet was dropped" << std::endl;
     }
     else {
         EV_WARN << "Invalid control message type (type=NOTHING) : name=" << msg->getName() << " modulesrc=" << msg->getSenderModule()->getFullPath() << "." << std::endl;
@@ -414,7 +518,23 @@ void Mac1609_4::handleLowerControl(cMessage* msg)
         emit(sigCollision, true);
     }
 
-    delete msg;
+    phy->recycleControlMsg(msg);
+}
+
+void Mac1609_4::dropFrame(BaseFrame1609_4* frame)
+{
+    statsDroppedPackets++;
+    emit(sigQueueDrop, frame);
+    delete frame;
+}
+
+void Mac1609_4::emitQueueOccupancy()
+{
+    size_t numQueued = 0;
+    for (auto&& p : myEDCA) {
+        numQueued += p.second->getNumQueued();
+    }
+    emit(sigQueueOccupancy, static_cast<long>(numQueued));
 }
 
 void Mac1609_4::setActiveChannel(ChannelType state)
@@ -429,6 +549,7 @@ void Mac1609_4::finish()
         statsNumInternalContention += p.second->statsNumInternalContention;
         statsNumBackoff += p.second->statsNumBackoff;
         statsSlotsBackoff += p.second->statsSlotsBackoff;
+        statsNumAggregated += p.second->statsNumAggregated;
     }
 
     recordScalar("ReceivedUnicastPackets", statsReceivedPackets);
@@ -440,6 +561,7 @@ void Mac1609_4::finish()
     recordScalar("RXTXLostPackets", statsTXRXLostPackets);
     recordScalar("TotalLostPackets", statsSNIRLostPackets + statsTXRXLostPackets);
     recordScalar("DroppedPacketsInMac", statsDroppedPackets);
+    recordScalar("AggregatedPackets", statsNumAggregated);
     recordScalar("TooLittleTime", statsNumTooLittleTime);
     recordScalar("TimesIntoBackoff", statsNumBackoff);
     recordScalar("SlotsBackoff", statsSlotsBackoff);
@@ -448,6 +570,11 @@ void Mac1609_4::finish()
 }
 
 Mac1609_4::~Mac1609_4()
+{
+    deleteTimers();
+}
+
+void Mac1609_4::deleteTimers()
 {
     if (nextMacEvent) {
         cancelAndDelete(nextMacEvent);
@@ -463,7 +590,12 @@ Mac1609_4::~Mac1609_4()
         cancelAndDelete(stopIgnoreChannelStateMsg);
         stopIgnoreChannelStateMsg = nullptr;
     }
-};
+
+    if (ackTimeOut) {
+        cancelAndDelete(ackTimeOut);
+        ackTimeOut = nullptr;
+    }
+}
 
 void Mac1609_4::sendFrame(Mac80211Pkt* frame, simtime_t delay, Channel channelNr, MCS mcs, double txPower_mW)
 {
@@ -474,7 +606,13 @@ void Mac1609_4::sendFrame(Mac80211Pkt* frame, simtime_t delay, Channel channelNr
     attachControlInfo(frame, channelNr, mcs, txPower_mW);
     check_and_cast<MacToPhyControlInfo11p*>(frame->getControlInfo());
 
+    if (scaleInterferenceDistance) {
+        // free space loss grows with distance^alpha, so reducing the power by a factor reduces the reach by its alpha-th root
+        phyChannelAccess->setInterferenceDistanceFactor(pow(txPower_mW / interferenceDistanceTxPower, 1 / interferenceDistanceAlpha));
+    }
+
     lastMac.reset(frame->dup());
+    // sent via the gate even with a lowerDispatcher, which cannot delay a message until the radio has switched
     sendDelayed(frame, delay, lowerLayerOut);
 
     if (dynamic_cast<Mac80211Ack*>(frame)) {
@@ -558,7 +696,27 @@ void Mac1609_4::handleBroadcast(Mac80211Pkt* macPkt, DeciderResult80211* res)
     auto ctrlInfo = new PhyToMacControlInfo(res);
     ctrlInfo->setSourceAddress(macPkt->getSrcAddr());
     wsm->setControlInfo(ctrlInfo);
-    sendUp(wsm.release());
+    sendUpDeaggregated(wsm.release());
+}
+
+void Mac1609_4::sendUpDeaggregated(BaseFrame1609_4* wsm)
+{
+    auto aggregateFrame = dynamic_cast<AggregateFrame1609_4*>(wsm);
+    if (!aggregateFrame) {
+        sendUp(wsm);
+        return;
+    }
+
+    // every frame carried by the aggregate gets its own copy of the reception information
+    auto ctrlInfo = check_and_cast<PhyToMacControlInfo*>(aggregateFrame->getControlInfo());
+    auto res = check_and_cast<DeciderResult80211*>(ctrlInfo->getDeciderResult());
+    for (auto frame : aggregateFrame->releaseFrames()) {
+        auto frameCtrlInfo = new PhyToMacControlInfo(new DeciderResult80211(*res));
+        frameCtrlInfo->setSourceAddress(ctrlInfo->getSourceAddress());
+        frame->setControlInfo(frameCtrlInfo);
+        sendUp(frame);
+    }
+    delete aggregateFrame;
 }
 
 void Mac1609_4::handleLowerMsg(cMessage* msg)
@@ -571,7 +729,7 @@ void Mac1609_4::handleLowerMsg(cMessage* msg)
 
     long dest = macPkt->getDestAddr();
 
-    EV_TRACE << "Received frame name= " << macPkt->getName() << ", myState= src=" << macPkt->getSrcAddr() << " dst=" << macPkt->getDestAddr() << " myAddr=" << myMacAddr << std::endl;
+    VEINS_LOG_TRACE << "Received frame name= " << macPkt->getName() << ", myState= src=" << macPkt->getSrcAddr() << " dst=" << macPkt->getDestAddr() << " myAddr=" << myMacAddr << std::endl;
 
     bool frameReceived = true;
     if (dblrand() < frameErrorRate) frameReceived = false;
@@ -582,7 +740,7 @@ void Mac1609_4::handleLowerMsg(cMessage* msg)
             if (dblrand() >= ackErrorRate)
                 handleAck(ack);
             else
-                EV_TRACE << "Artificially dropping ACK";
+                VEINS_LOG_TRACE << "Artificially dropping ACK";
             delete res;
         }
         else {
@@ -595,7 +753,7 @@ void Mac1609_4::handleLowerMsg(cMessage* msg)
             }
             else {
                 delete res;
-                EV_TRACE << "Artificially dropping frame";
+                VEINS_LOG_TRACE << "Artificially dropping frame";
             }
         }
     }
@@ -605,11 +763,11 @@ void Mac1609_4::handleLowerMsg(cMessage* msg)
         }
         else {
             delete res;
-            EV_TRACE << "Artificially dropping frame";
+            VEINS_LOG_TRACE << "Artificially dropping frame";
         }
     }
     else {
-        EV_TRACE << "Packet not for me" << std::endl;
+        VEINS_LOG_TRACE << "Packet not for me" << std::endl;
         delete res;
     }
     delete macPkt;
@@ -620,28 +778,141 @@ void Mac1609_4::handleLowerMsg(cMessage* msg)
         phy11p->notifyMacAboutRxStart(false);
         rxStartIndication = false;
         handleRetransmit(lastAC);
+        rescheduleAckTimeOut();
     }
 }
 
 int Mac1609_4::EDCA::queuePacket(t_access_category ac, BaseFrame1609_4* msg)
 {
+    if (aggregate(ac, msg)) {
+        return 0;
+    }
+
+    auto& edcaQueue = myQueues[ac];
+    // the frame at the front must stay in place while it is on the air or waiting for its ACK
+    size_t firstDroppable = (edcaQueue.frontInTransmission || edcaQueue.waitForAck) ? 1 : 0;
+
+    if (dropPolicy == QueueDropPolicy::age) {
+        // frames received from the upper layer carry the time they arrived at the mac
+        simtime_t oldestAllowed = simTime() - maxQueueAge;
+        for (size_t i = firstDroppable; i < edcaQueue.queue.size();) {
+            if (getEnqueueTime(edcaQueue.queue[i]) < oldestAllowed) {
+                dropQueued(ac, i);
+            }
+            else {
+                i++;
+            }
+        }
+    }
+
+    if (edcaQueue.queue.full()) {
+        if (dropPolicy == QueueDropPolicy::head && firstDroppable < edcaQueue.queue.size()) {
+            dropQueued(ac, firstDroppable);
+        }
+        else {
+            static_cast<Mac1609_4*>(owner)->dropFrame(msg);
+            return -1;
+        }
+    }
+    edcaQueue.queue.push(msg);
+    static_cast<Mac1609_4*>(owner)->emitQueueOccupancy();
+    return edcaQueue.queue.size();
+}
+
+BaseFrame1609_4* Mac1609_4::EDCA::dequeue(t_access_category ac)
+{
+    auto& edcaQueue = myQueues[ac];
+    ASSERT(!edcaQueue.queue.empty());
+    BaseFrame1609_4* frame = edcaQueue.queue.front();
+    edcaQueue.queue.pop();
+    edcaQueue.frontInTransmission = false;
+    static_cast<Mac1609_4*>(owner)->emitQueueOccupancy();
+    return frame;
+}
+
+void Mac1609_4::EDCA::dropQueued(t_access_category ac, size_t i)
+{
+    auto& edcaQueue = myQueues[ac];
+    ASSERT(i > 0 || !(edcaQueue.frontInTransmission || edcaQueue.waitForAck));
+    BaseFrame1609_4* frame = edcaQueue.queue[i];
+    edcaQueue.queue.erase(i);
+    if (i == 0) {
+        // retry counters belong to the frame at the front
+        edcaQueue.ssrc = 0;
+        edcaQueue.slrc = 0;
+    }
+    static_cast<Mac1609_4*>(owner)->dropFrame(frame);
+    static_cast<Mac1609_4*>(owner)->emitQueueOccupancy();
+}
+
+bool Mac1609_4::EDCA::aggregate(t_access_category ac, BaseFrame1609_4* msg)
+{
+    auto& edcaQueue = myQueues[ac];
+    if (!aggregateFrames || edcaQueue.queue.empty()) return false;
+    // the frame at the front cannot grow while it is on the air or waiting for its ACK
+    if (edcaQueue.queue.size() == 1 && (edcaQueue.frontInTransmission || edcaQueue.waitForAck)) return false;
+
+    BaseFrame1609_4*& tail = edcaQueue.queue.back();
+    if (tail->getRecipientAddress() != msg->getRecipientAddress()) return false;
+    if (simTime() - getEnqueueTime(tail) > aggregationWindow) return false;
+
+    auto aggregateFrame = dynamic_cast<AggregateFrame1609_4*>(tail);
+    int64_t aggregateLength = aggregateFrame ? tail->getBitLength() : tail->getBitLength() + AMSDU_SUBFRAME_HEADER_LENGTH;
+    if (aggregateLength + msg->getBitLength() + AMSDU_SUBFRAME_HEADER_LENGTH > aggregationMaxLength) return false;
+
+    // frames requesting a specific MCS or tx power can only be combined with frames requesting the same
+    auto tailControl = dynamic_cast<PhyControlMessage*>(tail->getControlInfo());
+    auto msgControl = dynamic_cast<PhyControlMessage*>(msg->getControlInfo());
+    if (tail->getControlInfo() && !tailControl) return false;
+    if (msg->getControlInfo() && !msgControl) return false;
+    if ((tailControl == nullptr) != (msgControl == nullptr)) return false;
+    if (tailControl && (tailControl->getMcs() != msgControl->getMcs() || tailControl->getTxPower_mW() != msgControl->getTxPower_mW())) return false;
+
+    if (!aggregateFrame) {
+        aggregateFrame = new AggregateFrame1609_4("AggregateFrame1609_4");
+        aggregateFrame->setChannelNumber(tail->getChannelNumber());
+        aggregateFrame->setUserPriority(tail->getUserPriority());
+        aggregateFrame->setPsid(tail->getPsid());
+        aggregateFrame->setRecipientAddress(tail->getRecipientAddress());
+        if (tailControl) aggregateFrame->setControlInfo(tail->removeControlInfo());
+        aggregateFrame->appendFrame(tail);
+        tail = aggregateFrame;
+        statsNumAggregated++;
+    }
+    delete msg->removeControlInfo();
+    aggregateFrame->appendFrame(msg);
+    statsNumAggregated++;
+
+    VEINS_LOG_TRACE << "Aggregated frame into queue " << ac << ", aggregate now carries " << aggregateFrame->getNumFrames() << " frames" << std::endl;
+    return true;
+}
+
+simtime_t Mac1609_4::EDCA::getEnqueueTime(const BaseFrame1609_4* frame)
+{
+    // aggregates are created in the mac, so they never arrived on a gate themselves
+    if (auto aggregateFrame = dynamic_cast<const AggregateFrame1609_4*>(frame)) {
+        return aggregateFrame->getFrame(0)->getArrivalTime();
+    }
+    return frame->getArrivalTime();
+}
 
-    if (maxQueueSize && myQueues[ac].queue.size() >= maxQueueSize) {
-        delete msg;
-        return -1;
+size_t Mac1609_4::EDCA::getNumQueued() const
+{
+    size_t numQueued = 0;
+    for (auto& edcaQueue : myQueues) {
+        numQueued += edcaQueue.queue.size();
     }
-    myQueues[ac].queue.push(msg);
-    return myQueues[ac].queue.size();
+    return numQueued;
 }
 
 void Mac1609_4::EDCA::createQueue(int aifsn, int cwMin, int cwMax, t_access_category ac)
 {
 
-    if (myQueues.find(ac) != myQueues.end()) {
+    if (myQueues[ac].configured) {
         throw cRuntimeError("You can only add one queue per Access Category per EDCA subsystem");
     }
 
-    EDCAQueue newQueue(aifsn, cwMin, cwMax, ac);
+    EDCAQueue newQueue(aifsn, cwMin, cwMax, maxQueueSize);
     myQueues[ac] = newQueue;
 }
 
@@ -680,29 +951,31 @@ BaseFrame1609_4* Mac1609_4::EDCA::initiateTransmit(simtime_t lastIdle)
 
     simtime_t idleTime = simTime() - lastIdle;
 
-    EV_TRACE << "Initiating transmit at " << simTime() << ". I've been idle since " << idleTime << std::endl;
+    VEINS_LOG_TRACE << "Initiating transmit at " << simTime() << ". I've been idle since " << idleTime << std::endl;
 
     // As t_access_category is sorted by priority, we iterate back to front.
     // This realizes the behavior documented in IEEE Std 802.11-2012 Section 9.2.4.2; that is, "data frames from the higher priority AC" win an internal collision.
     // The phrase "EDCAF of higher UP" of IEEE Std 802.11-2012 Section 9.19.2.3 is assumed to be meaningless.
-    for (auto iter = myQueues.rbegin(); iter != myQueues.rend(); iter++) {
-        if (iter->second.queue.size() != 0 && !iter->second.waitForAck) {
-            if (idleTime >= iter->second.aifsn * SLOTLENGTH_11P + SIFS_11P && iter->second.txOP == true) {
+    for (size_t i = myQueues.size(); i-- > 0;) {
+        auto& edcaQueue = myQueues[i];
+        if (!edcaQueue.configured) continue;
+        if (edcaQueue.queue.size() != 0 && !edcaQueue.waitForAck) {
+            if (idleTime >= edcaQueue.aifsn * SLOTLENGTH_11P + SIFS_11P && edcaQueue.txOP == true) {
 
-                EV_TRACE << "Queue " << iter->first << " is ready to send!" << std::endl;
+                VEINS_LOG_TRACE << "Queue " << i << " is ready to send!" << std::endl;
 
-                iter->second.txOP = false;
+                edcaQueue.txOP = false;
                 // this queue is ready to send
                 if (pktToSend == nullptr) {
-                    pktToSend = iter->second.queue.front();
+                    pktToSend = edcaQueue.queue.front();
                 }
                 else {
                     // there was already another packet ready. we have to go increase cw and go into backoff. It's called internal contention and its wonderful
 
                     statsNumInternalContention++;
-                    iter->second.cwCur = std::min(iter->second.cwMax, (iter->second.cwCur + 1) * 2 - 1);
-                    iter->second.currentBackoff = owner->intuniform(0, iter->second.cwCur);
-                    EV_TRACE << "Internal contention for queue " << iter->first << " : " << iter->second.currentBackoff << ". Increase cwCur to " << iter->second.cwCur << std::endl;
+                    edcaQueue.cwCur = std::min(edcaQueue.cwMax, (edcaQueue.cwCur + 1) * 2 - 1);
+                    edcaQueue.currentBackoff = drawBackoff(edcaQueue.cwCur);
+                    VEINS_LOG_TRACE << "Internal contention for queue " << i << " : " << edcaQueue.currentBackoff << ". Increase cwCur to " << edcaQueue.cwCur << std::endl;
                 }
             }
         }
@@ -717,7 +990,7 @@ BaseFrame1609_4* Mac1609_4::EDCA::initiateTransmit(simtime_t lastIdle)
 simtime_t Mac1609_4::EDCA::startContent(simtime_t idleSince, bool guardActive)
 {
 
-    EV_TRACE << "Restarting contention." << std::endl;
+    VEINS_LOG_TRACE << "Restarting contention." << std::endl;
 
     simtime_t nextEvent = -1;
 
@@ -726,20 +999,19 @@ simtime_t Mac1609_4::EDCA::startContent(simtime_t idleSince, bool guardActive)
 
     lastStart = idleSince;
 
-    EV_TRACE << "Channel is already idle for:" << idleTime << " since " << idleSince << std::endl;
+    VEINS_LOG_TRACE << "Channel is already idle for:" << idleTime << " since " << idleSince << std::endl;
 
     // this returns the nearest possible event in this EDCA subsystem after a busy channel
 
-    for (auto&& p : myQueues) {
-        auto& accessCategory = p.first;
-        auto& edcaQueue = p.second;
-        if (edcaQueue.queue.size() != 0 && !edcaQueue.waitForAck) {
+    for (size_t accessCategory = 0; accessCategory < myQueues.size(); accessCategory++) {
+        auto& edcaQueue = myQueues[accessCategory];
+        if (edcaQueue.configured && edcaQueue.queue.size() != 0 && !edcaQueue.waitForAck) {
 
             /* 1609_4 says that when attempting to send (backoff == 0) when guard is active, a random backoff is invoked */
 
             if (guardActive == true && edcaQueue.currentBackoff == 0) {
                 // cw is not increased
-                edcaQueue.currentBackoff = owner->intuniform(0, edcaQueue.cwCur);
+                edcaQueue.currentBackoff = drawBackoff(edcaQueue.cwCur);
                 statsNumBackoff++;
             }
 
@@ -748,17 +1020,17 @@ simtime_t Mac1609_4::EDCA::startContent(simtime_t idleSince, bool guardActive)
             // the next possible time to send can be in the past if the channel was idle for a long time, meaning we COULD have sent earlier if we had a packet
             simtime_t possibleNextEvent = DIFS + edcaQueue.currentBackoff * SLOTLENGTH_11P;
 
-            EV_TRACE << "Waiting Time for Queue " << accessCategory << ":" << possibleNextEvent << "=" << edcaQueue.aifsn << " * " << SLOTLENGTH_11P << " + " << SIFS_11P << "+" << edcaQueue.currentBackoff << "*" << SLOTLENGTH_11P << "; Idle time: " << idleTime << std::endl;
+            VEINS_LOG_TRACE << "Waiting Time for Queue " << accessCategory << ":" << possibleNextEvent << "=" << edcaQueue.aifsn << " * " << SLOTLENGTH_11P << " + " << SIFS_11P << "+" << edcaQueue.currentBackoff << "*" << SLOTLENGTH_11P << "; Idle time: " << idleTime << std::endl;
 
             if (idleTime > possibleNextEvent) {
-                EV_TRACE << "Could have already send if we had it earlier" << std::endl;
+                VEINS_LOG_TRACE << "Could have already send if we had it earlier" << std::endl;
                 // we could have already sent. round up to next boundary
                 simtime_t base = idleSince + DIFS;
                 possibleNextEvent = simTime() - simtime_t().setRaw((simTime() - base).raw() % SLOTLENGTH_11P.raw()) + SLOTLENGTH_11P;
             }
             else {
                 // we are gonna send in the future
-                EV_TRACE << "Sending in the future" << std::endl;
+                VEINS_LOG_TRACE << "Sending in the future" << std::endl;
                 possibleNextEvent = idleSince + possibleNextEvent;
             }
             nextEvent == -1 ? nextEvent = possibleNextEvent : nextEvent = std::min(nextEvent, possibleNextEvent);
@@ -771,26 +1043,25 @@ void Mac1609_4::EDCA::stopContent(bool allowBackoff, bool generateTxOp)
 {
     // update all Queues
 
-    EV_TRACE << "Stopping Contention at " << simTime().raw() << std::endl;
+    VEINS_LOG_TRACE << "Stopping Contention at " << simTime().raw() << std::endl;
 
     simtime_t passedTime = simTime() - lastStart;
 
-    EV_TRACE << "Channel was idle for " << passedTime << std::endl;
+    VEINS_LOG_TRACE << "Channel was idle for " << passedTime << std::endl;
 
     lastStart = -1; // indicate that there was no last start
 
-    for (auto&& p : myQueues) {
-        auto& accessCategory = p.first;
-        auto& edcaQueue = p.second;
-        if ((edcaQueue.currentBackoff != 0 || edcaQueue.queue.size() != 0) && !edcaQueue.waitForAck) {
+    for (size_t accessCategory = 0; accessCategory < myQueues.size(); accessCategory++) {
+        auto& edcaQueue = myQueues[accessCategory];
+        if (edcaQueue.configured && (edcaQueue.currentBackoff != 0 || edcaQueue.queue.size() != 0) && !edcaQueue.waitForAck) {
             // check how many slots we already waited until the chan became busy
 
             int64_t oldBackoff = edcaQueue.currentBackoff;
 
-            std::string info;
+            const char* info = "";
             if (passedTime < edcaQueue.aifsn * SLOTLENGTH_11P + SIFS_11P) {
                 // we didnt even make it one DIFS :(
-                info.append(" No DIFS");
+                info = " No DIFS";
             }
             else {
                 // decrease the backoff by one because we made it longer than one DIFS
@@ -799,36 +1070,42 @@ void Mac1609_4::EDCA::stopContent(bool allowBackoff, bool generateTxOp)
                 // check how many slots we waited after the first DIFS
                 int64_t passedSlots = (int64_t) ((passedTime - SimTime(edcaQueue.aifsn * SLOTLENGTH_11P + SIFS_11P)) / SLOTLENGTH_11P);
 
-                EV_TRACE << "Passed slots after DIFS: " << passedSlots << std::endl;
+                VEINS_LOG_TRACE << "Passed slots after DIFS: " << passedSlots << std::endl;
 
                 if (edcaQueue.queue.size() == 0) {
                     // this can be below 0 because of post transmit backoff -> backoff on empty queues will not generate macevents,
                     // we dont want to generate a txOP for empty queues
                     edcaQueue.currentBackoff -= std::min(edcaQueue.currentBackoff, passedSlots);
-                    info.append(" PostCommit Over");
+                    info = " PostCommit Over";
                 }
                 else {
                     edcaQueue.currentBackoff -= passedSlots;
                     if (edcaQueue.currentBackoff <= -1) {
                         if (generateTxOp) {
                             edcaQueue.txOP = true;
-                            info.append(" TXOP");
+                            info = " TXOP";
                         }
                         // else: this packet couldnt be sent because there was too little time. we could have generated a txop, but the channel switched
                         edcaQueue.currentBackoff = 0;
                     }
                 }
             }
-            EV_TRACE << "Updating backoff for Queue " << accessCategory << ": " << oldBackoff << " -> " << edcaQueue.currentBackoff << info << std::endl;
+            VEINS_LOG_TRACE << "Updating backoff for Queue " << accessCategory << ": " << oldBackoff << " -> " << edcaQueue.currentBackoff << info << std::endl;
         }
     }
 }
+int64_t Mac1609_4::EDCA::drawBackoff(int cw)
+{
+    if (backoffRng) return backoffRng->intuniform(0, cw);
+    return owner->intuniform(0, cw);
+}
+
 void Mac1609_4::EDCA::backoff(t_access_category ac)
 {
-    myQueues[ac].currentBackoff = owner->intuniform(0, myQueues[ac].cwCur);
+    myQueues[ac].currentBackoff = drawBackoff(myQueues[ac].cwCur);
     statsSlotsBackoff += myQueues[ac].currentBackoff;
     statsNumBackoff++;
-    EV_TRACE << "Going into Backoff because channel was busy when new packet arrived from upperLayer" << std::endl;
+    VEINS_LOG_TRACE << "Going into Backoff because channel was busy when new packet arrived from upperLayer" << std::endl;
 }
 
 void Mac1609_4::EDCA::postTransmit(t_access_category ac, BaseFrame1609_4* wsm, bool useAcks)
@@ -838,19 +1115,19 @@ void Mac1609_4::EDCA::postTransmit(t_access_category ac, BaseFrame1609_4* wsm, b
         // mac->waitUntilAckRXorTimeout = true; // set in handleselfmsg()
         // Head of line blocking, wait until ack timeout
         myQueues[ac].waitForAck = true;
+        myQueues[ac].frontInTransmission = false;
         myQueues[ac].waitOnUnicastID = wsm->getTreeId();
         ((Mac1609_4*) owner)->phy11p->notifyMacAboutRxStart(true);
     }
     else {
         myQueues[ac].waitForAck = false;
-        delete myQueues[ac].queue.front();
-        myQueues[ac].queue.pop();
+        delete dequeue(ac);
         myQueues[ac].cwCur = myQueues[ac].cwMin;
         // post transmit backoff
-        myQueues[ac].currentBackoff = owner->intuniform(0, myQueues[ac].cwCur);
+        myQueues[ac].currentBackoff = drawBackoff(myQueues[ac].cwCur);
         statsSlotsBackoff += myQueues[ac].currentBackoff;
         statsNumBackoff++;
-        EV_TRACE << "Queue " << ac << " will go into post-transmit backoff for " << myQueues[ac].currentBackoff << " slots" << std::endl;
+        VEINS_LOG_TRACE << "Queue " << ac << " will go into post-transmit backoff for " << myQueues[ac].currentBackoff << " slots" << std::endl;
     }
 }
 
@@ -865,21 +1142,9 @@ Mac1609_4::EDCA::EDCA(cSimpleModule* owner, ChannelType channelType, int maxQueu
 {
 }
 
-Mac1609_4::EDCA::~EDCA()
-{
-    for (auto& q : myQueues) {
-        auto& ackTimeout = q.second.ackTimeOut;
-        if (ackTimeout) {
-            owner->cancelAndDelete(ackTimeout);
-            ackTimeout = nullptr;
-        }
-    }
-}
-
 void Mac1609_4::EDCA::revokeTxOPs()
 {
-    for (auto&& p : myQueues) {
-        auto& edcaQueue = p.second;
+    for (auto& edcaQueue : myQueues) {
         if (edcaQueue.txOP == true) {
             edcaQueue.txOP = false;
             edcaQueue.currentBackoff = 0;
@@ -895,7 +1160,7 @@ void Mac1609_4::channelBusySelf(bool generateTxOp)
 
     if (!idleChannel) return;
     idleChannel = false;
-    EV_TRACE << "Channel turned busy: Switch or Self-Send" << std::endl;
+    VEINS_LOG_TRACE << "Channel turned busy: Switch or Self-Send" << std::endl;
 
     lastBusy = simTime();
 
@@ -908,6 +1173,7 @@ void Mac1609_4::channelBusySelf(bool generateTxOp)
     }
     myEDCA[activeChannel]->stopContent(false, generateTxOp);
 
+    channelBusyRatio.setBusy(simTime(), true);
     emit(sigChannelBusy, true);
 }
 
@@ -918,7 +1184,7 @@ void Mac1609_4::channelBusy()
 
     // the channel turned busy because someone else is sending
     idleChannel = false;
-    EV_TRACE << "Channel turned busy: External sender" << std::endl;
+    VEINS_LOG_TRACE << "Channel turned busy: External sender" << std::endl;
     lastBusy = simTime();
 
     // channel turned busy
@@ -930,13 +1196,14 @@ void Mac1609_4::channelBusy()
     }
     myEDCA[activeChannel]->stopContent(true, false);
 
+    channelBusyRatio.setBusy(simTime(), true);
     emit(sigChannelBusy, true);
 }
 
 void Mac1609_4::channelIdle(bool afterSwitch)
 {
 
-    EV_TRACE << "Channel turned idle: Switch: " << afterSwitch << std::endl;
+    VEINS_LOG_TRACE << "Channel turned idle: Switch: " << afterSwitch << std::endl;
     if (waitUntilAckRXorTimeout) {
         return;
     }
@@ -969,18 +1236,19 @@ void Mac1609_4::channelIdle(bool afterSwitch)
     if (nextEvent != -1) {
         if ((!useSCH) || (nextEvent < nextChannelSwitch->getArrivalTime())) {
             scheduleAt(nextEvent, nextMacEvent);
-            EV_TRACE << "next Event is at " << nextMacEvent->getArrivalTime().raw() << std::endl;
+            VEINS_LOG_TRACE << "next Event is at " << nextMacEvent->getArrivalTime().raw() << std::endl;
         }
         else {
-            EV_TRACE << "Too little time in this interval. will not schedule macEvent" << std::endl;
+            VEINS_LOG_TRACE << "Too little time in this interval. will not schedule macEvent" << std::endl;
             statsNumTooLittleTime++;
             myEDCA[activeChannel]->revokeTxOPs();
         }
     }
     else {
-        EV_TRACE << "I don't have any new events in this EDCA sub system" << std::endl;
+        VEINS_LOG_TRACE << "I don't have any new events in this EDCA sub system" << std::endl;
     }
 
+    channelBusyRatio.setBusy(simTime(), false);
     emit(sigChannelBusy, false);
 }
 
@@ -1002,6 +1270,31 @@ simtime_t Mac1609_4::getSwitchingInterval()
     return SWITCHING_INTERVAL_11P;
 }
 
+double Mac1609_4::getChannelBusyRatio()
+{
+    Enter_Method_Silent();
+    return channelBusyRatio.getLastRatio(simTime());
+}
+
+simtime_t Mac1609_4::getDccMinPacketInterval()
+{
+    Enter_Method_Silent();
+    if (!dcc) return 0;
+    updateDcc();
+    return dcc->getState().minPacketInterval;
+}
+
+void Mac1609_4::updateDcc()
+{
+    long numIntervals = channelBusyRatio.getNumIntervals(simTime());
+    if (numIntervals == lastDccInterval) return;
+    lastDccInterval = numIntervals;
+    double cbr = channelBusyRatio.getLastRatio(simTime());
+    if (dcc->update(cbr)) {
+        VEINS_LOG_TRACE << "DCC moved to state " << dcc->getStateIndex() << " at CBR " << cbr << ": max tx power " << dcc->getState().maxTxPower_mW << " mW, min packet interval " << dcc->getState().minPacketInterval << std::endl;
+    }
+}
+
 bool Mac1609_4::isCurrentChannelCCH()
 {
     return (activeChannel == ChannelType::control);
@@ -1024,13 +1317,13 @@ void Mac1609_4::sendAck(LAddress::L2Type recpAddress, unsigned long wsmId)
     mac->setBitLength(ackLength);
 
     simtime_t sendingDuration = RADIODELAY_11P + phy11p->getFrameDuration(mac->getBitLength(), mcs);
-    EV_TRACE << "Ack sending duration will be " << sendingDuration << std::endl;
+    VEINS_LOG_TRACE << "Ack sending duration will be " << sendingDuration << std::endl;
 
     // TODO: check ack procedure when channel switching is allowed
     // double freq = (activeChannel == ChannelType::control) ? IEEE80211ChannelFrequencies.at(Channel::cch) : IEEE80211ChannelFrequencies.at(mySCH);
     double freq = IEEE80211ChannelFrequencies.at(Channel::cch);
 
-    EV_TRACE << "Sending an ack. Frequency " << freq << " at time : " << simTime() + SIFS_11P << std::endl;
+    VEINS_LOG_TRACE << "Sending an ack. Frequency " << freq << " at time : " << simTime() + SIFS_11P << std::endl;
     sendFrame(mac, SIFS_11P, Channel::cch, mcs, txPower);
     scheduleAt(simTime() + SIFS_11P, stopIgnoreChannelStateMsg);
 }
@@ -1043,9 +1336,9 @@ void Mac1609_4::handleUnicast(LAddress::L2Type srcAddr, unique_ptr<BaseFrame1609
 
     if (handledUnicastToApp.find(wsm->getTreeId()) == handledUnicastToApp.end()) {
         handledUnicastToApp.insert(wsm->getTreeId());
-        EV_TRACE << "Received a data packet addressed to me." << std::endl;
+        VEINS_LOG_TRACE << "Received a data packet addressed to me." << std::endl;
         statsReceivedPackets++;
-        sendUp(wsm.release());
+        sendUpDeaggregated(wsm.release());
     }
 }
 
@@ -1057,22 +1350,18 @@ void Mac1609_4::handleAck(const Mac80211Ack* ack)
 
     ChannelType chan = ChannelType::control;
     bool queueUnblocked = false;
-    for (auto&& p : myEDCA[chan]->myQueues) {
-        auto& accessCategory = p.first;
-        auto& edcaQueue = p.second;
-        if (edcaQueue.queue.size() > 0 && edcaQueue.waitForAck && (edcaQueue.waitOnUnicastID == ack->getMessageId())) {
-            BaseFrame1609_4* wsm = edcaQueue.queue.front();
-            edcaQueue.queue.pop();
-            delete wsm;
+    for (size_t i = 0; i < myEDCA[chan]->myQueues.size(); i++) {
+        auto accessCategory = static_cast<t_access_category>(i);
+        auto& edcaQueue = myEDCA[chan]->myQueues[i];
+        if (edcaQueue.configured && edcaQueue.queue.size() > 0 && edcaQueue.waitForAck && (edcaQueue.waitOnUnicastID == ack->getMessageId())) {
+            delete myEDCA[chan]->dequeue(accessCategory);
             myEDCA[chan]->myQueues[accessCategory].cwCur = myEDCA[chan]->myQueues[accessCategory].cwMin;
             myEDCA[chan]->backoff(accessCategory);
             edcaQueue.ssrc = 0;
             edcaQueue.slrc = 0;
             edcaQueue.waitForAck = false;
             edcaQueue.waitOnUnicastID = -1;
-            if (myEDCA[chan]->myQueues[accessCategory].ackTimeOut->isScheduled()) {
-                cancelEvent(myEDCA[chan]->myQueues[accessCategory].ackTimeOut);
-            }
+            edcaQueue.ackDeadline = -1;
             queueUnblocked = true;
         }
     }
@@ -1082,34 +1371,60 @@ void Mac1609_4::handleAck(const Mac80211Ack* ack)
     else {
         waitUntilAckRXorTimeout = false;
     }
+    rescheduleAckTimeOut();
 }
 
-void Mac1609_4::handleAckTimeOut(AckTimeOutMessage* ackTimeOutMsg)
+void Mac1609_4::rescheduleAckTimeOut()
 {
-    if (rxStartIndication) {
-        // Rx is already in process. Wait for it to complete.
-        // In case it is not an ack, we will retransmit
-        // This assigning might be redundant as it was set already in handleSelfMsg but no harm in reassigning here.
-        lastAC = (t_access_category) (ackTimeOutMsg->getKind());
-        return;
+    // ACKs are only used on the CCH
+    simtime_t nextDeadline = -1;
+    for (const auto& edcaQueue : myEDCA[ChannelType::control]->myQueues) {
+        if (edcaQueue.ackDeadline < 0) continue;
+        if (nextDeadline < 0 || edcaQueue.ackDeadline < nextDeadline) nextDeadline = edcaQueue.ackDeadline;
+    }
+    if (nextDeadline < 0) return;
+    if (ackTimeOut->isScheduled()) {
+        // a timer armed for an earlier (possibly already cleared) deadline is left alone, handleAckTimeOut() ignores early wakeups
+        if (ackTimeOut->getArrivalTime() <= nextDeadline) return;
+        cancelEvent(ackTimeOut);
+    }
+    scheduleAt(nextDeadline, ackTimeOut);
+}
+
+void Mac1609_4::handleAckTimeOut()
+{
+    // ACKs are only used on the CCH
+    auto& edca = myEDCA[ChannelType::control];
+    for (size_t i = 0; i < edca->myQueues.size(); i++) {
+        auto ac = static_cast<t_access_category>(i);
+        auto& edcaQueue = edca->myQueues[i];
+        if (edcaQueue.ackDeadline < 0 || edcaQueue.ackDeadline > simTime()) continue;
+        edcaQueue.ackDeadline = -1;
+
+        if (rxStartIndication) {
+            // Rx is already in process. Wait for it to complete.
+            // In case it is not an ack, we will retransmit
+            // This assigning might be redundant as it was set already in handleSelfMsg but no harm in reassigning here.
+            lastAC = ac;
+            continue;
+        }
+        // We did not start receiving any packet.
+        // stop receiving notification for rx start as we will retransmit
+        phy11p->notifyMacAboutRxStart(false);
+        // back off and try retransmission again
+        handleRetransmit(ac);
+        // Phy was requested not to send channel idle status on TX_OVER
+        // So request the channel status now. For the case when we receive ACK, decider updates channel status itself after ACK RX
+        phy11p->requestChannelStatusIfIdle();
     }
-    // We did not start receiving any packet.
-    // stop receiving notification for rx start as we will retransmit
-    phy11p->notifyMacAboutRxStart(false);
-    // back off and try retransmission again
-    handleRetransmit((t_access_category) (ackTimeOutMsg->getKind()));
-    // Phy was requested not to send channel idle status on TX_OVER
-    // So request the channel status now. For the case when we receive ACK, decider updates channel status itself after ACK RX
-    phy11p->requestChannelStatusIfIdle();
+    rescheduleAckTimeOut();
 }
 
 void Mac1609_4::handleRetransmit(t_access_category ac)
 {
-    // cancel the acktime out
-    if (myEDCA[ChannelType::control]->myQueues[ac].ackTimeOut->isScheduled()) {
-        // This case is possible if we received PHY_RX_END_WITH_SUCCESS or FAILURE even before ack timeout
-        cancelEvent(myEDCA[ChannelType::control]->myQueues[ac].ackTimeOut);
-    }
+    // forget the ack deadline
+    // It might not have passed yet if we received PHY_RX_END_WITH_SUCCESS or FAILURE even before ack timeout, callers then re-arm the ack timer
+    myEDCA[ChannelType::control]->myQueues[ac].ackDeadline = -1;
     if (myEDCA[ChannelType::control]->myQueues[ac].queue.size() == 0) {
         throw cRuntimeError("Trying retransmission on empty queue...");
     }
@@ -1145,7 +1460,7 @@ void Mac1609_4::handleRetransmit(t_access_category ac)
     }
     else {
         // enough tries!
-        myEDCA[ChannelType::control]->myQueues[ac].queue.pop();
+        myEDCA[ChannelType::control]->dequeue(ac);
         if (myEDCA[ChannelType::control]->myQueues[ac].queue.size() > 0) {
             // start contention only if there are more packets in the queue
             contend = true;
@@ -1170,8 +1485,9 @@ void Mac1609_4::handleRetransmit(t_access_category ac)
     }
 }
 
-Mac1609_4::EDCA::EDCAQueue::EDCAQueue(int aifsn, int cwMin, int cwMax, t_access_category ac)
-    : aifsn(aifsn)
+Mac1609_4::EDCA::EDCAQueue::EDCAQueue(int aifsn, int cwMin, int cwMax, size_t capacity)
+    : queue(capacity)
+    , aifsn(aifsn)
     , cwMin(cwMin)
     , cwMax(cwMax)
     , cwCur(cwMin)
@@ -1181,9 +1497,8 @@ Mac1609_4::EDCA::EDCAQueue::EDCAQueue(int aifsn, int cwMin, int cwMax, t_access_
     , slrc(0)
     , waitForAck(false)
     , waitOnUnicastID(-1)
-    , ackTimeOut(new AckTimeOutMessage("AckTimeOut"))
+    , configured(true)
 {
-    ackTimeOut->setKind(ac);
 }
 
 Mac1609_4::EDCA::EDCAQueue::~EDCAQueue()
@@ -1192,5 +1507,4 @@ Mac1609_4::EDCA::EDCAQueue::~EDCAQueue()
         delete queue.front();
         queue.pop();
     }
-    // ackTimeOut needs to be deleted in EDCA
 }
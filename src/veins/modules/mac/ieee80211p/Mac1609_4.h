@@ -22,15 +22,20 @@
 
 #pragma once
 
-#include <queue>
+#include <array>
 #include <memory>
 #include <stdint.h>
 
 #include "veins/veins.h"
 
 #include "veins/base/modules/BaseLayer.h"
+#include "veins/base/utils/CounterRng.h"
+#include "veins/base/utils/MemoryAccounting.h"
+#include "veins/base/utils/RingBuffer.h"
 #include "veins/modules/phy/PhyLayer80211p.h"
 #include "veins/modules/mac/ieee80211p/DemoBaseApplLayerToMac1609_4Interface.h"
+#include "veins/modules/mac/ieee80211p/ReactiveDcc.h"
+#include "veins/modules/utility/ChannelBusyRatio.h"
 #include "veins/modules/utility/Consts80211p.h"
 #include "veins/modules/utility/MacToPhyControlInfo11p.h"
 #include "veins/base/utils/FindModule.h"
@@ -78,6 +83,10 @@ public:
     static const simsignal_t sigSentAck;
     // tell to anybody which is interested when a failed unicast transmission occurred
     static const simsignal_t sigRetriesExceeded;
+    // tell to anybody which is interested when a frame was dropped from (or not admitted to) an EDCA queue
+    static const simsignal_t sigQueueDrop;
+    // tell to anybody which is interested how many frames are waiting in all EDCA queues
+    static const simsignal_t sigQueueOccupancy;
 
     // Access categories in increasing order of priority (see IEEE Std 802.11-2012, Table 9-1)
     enum t_access_category {
@@ -87,11 +96,18 @@ public:
         AC_VO = 3
     };
 
+    // Which frame to drop when an EDCA queue is full
+    enum class QueueDropPolicy {
+        tail, ///< drop the newly arriving frame
+        head, ///< drop the oldest frame that is not currently being transmitted
+        age ///< like tail, but first drop all frames that have been queued for longer than the maximum age
+    };
+
     class VEINS_API EDCA : HasLogProxy {
     public:
         class VEINS_API EDCAQueue {
         public:
-            std::queue<BaseFrame1609_4*> queue;
+            RingBuffer<BaseFrame1609_4*> queue;
             int aifsn; // number of aifs slots for this queue
             int cwMin; // minimum contention window
             int cwMax; // maximum contention size
@@ -102,17 +118,18 @@ public:
             int slrc; // station long retry count
             bool waitForAck; // true if the queue is waiting for an acknowledgment for unicast
             unsigned long waitOnUnicastID; // unique id of unicast on which station is waiting
-            AckTimeOutMessage* ackTimeOut; // timer for retransmission on receiving no ACK
+            simtime_t ackDeadline = -1; // time by which reception of the ACK must have started (or -1 if no ACK is outstanding)
+            bool configured = false; // true if this queue was set up by createQueue
+            bool frontInTransmission = false; // true while the frame at the front of the queue is on the air
 
             EDCAQueue()
             {
             }
-            EDCAQueue(int aifsn, int cwMin, int cwMax, t_access_category ac);
+            EDCAQueue(int aifsn, int cwMin, int cwMax, size_t capacity = 0);
             ~EDCAQueue();
         };
 
         EDCA(cSimpleModule* owner, ChannelType channelType, int maxQueueLength = 0);
-        ~EDCA();
 
         void createQueue(int aifsn, int cwMin, int cwMax, t_access_category);
         int queuePacket(t_access_category AC, BaseFrame1609_4* cmsg);
@@ -122,15 +139,41 @@ public:
         void postTransmit(t_access_category, BaseFrame1609_4* wsm, bool useAcks);
         void revokeTxOPs();
 
+        /** @brief remove and return the frame at the front of the queue of the given access category */
+        BaseFrame1609_4* dequeue(t_access_category ac);
+
+        /** @brief drop the i-th frame in the queue of the given access category */
+        void dropQueued(t_access_category ac, size_t i);
+
+        /** @brief return the number of frames in all queues */
+        size_t getNumQueued() const;
+
+        /** @brief try to append the frame to the aggregate at the tail of the queue of the given access category (taking ownership if successful) */
+        bool aggregate(t_access_category ac, BaseFrame1609_4* msg);
+
+        /** @brief return the time a queued frame (or the first frame of a queued aggregate) arrived at the mac */
+        static simtime_t getEnqueueTime(const BaseFrame1609_4* frame);
+
         /** @brief return the next packet to send, send all lower Queues into backoff */
         BaseFrame1609_4* initiateTransmit(simtime_t idleSince);
 
+        /** @brief draw a number of backoff slots from [0, cw] */
+        int64_t drawBackoff(int cw);
+
     public:
         cSimpleModule* owner;
-        std::map<t_access_category, EDCAQueue> myQueues;
+        /** @brief queues of this EDCA subsystem, indexed by access category (in increasing order of priority) */
+        std::array<EDCAQueue, 4> myQueues;
         uint32_t maxQueueSize;
+        QueueDropPolicy dropPolicy = QueueDropPolicy::tail;
+        simtime_t maxQueueAge; // maximum time a frame may wait in a queue (only used by QueueDropPolicy::age)
+        bool aggregateFrames = false; // whether to coalesce frames to the same recipient into an AggregateFrame1609_4
+        simtime_t aggregationWindow; // maximum time since the first frame of an aggregate was queued for another frame to join it
+        int64_t aggregationMaxLength = 0; // maximum length (in bits) of an aggregate
+        long statsNumAggregated = 0; // number of frames that were appended to an aggregate
         simtime_t lastStart; // when we started the last contention;
         ChannelType channelType;
+        std::unique_ptr<CounterRng> backoffRng; // stream to draw backoffs from (if null: the module RNG)
 
         /** @brief Stats */
         long statsNumInternalContention;
@@ -149,6 +192,14 @@ public:
     }
     ~Mac1609_4() override;
 
+    bool isReusable() const override
+    {
+        return true;
+    }
+
+    /** @brief Empties the queues and restarts channel access and statistics, see BaseModule::resetForReuse()*/
+    void resetForReuse(int stage) override;
+
     /**
      * @brief return true if alternate access is enabled
      */
@@ -160,6 +211,10 @@ public:
 
     void changeServiceChannel(Channel channelNumber) override;
 
+    double getChannelBusyRatio() override;
+
+    simtime_t getDccMinPacketInterval() override;
+
     /**
      * @brief Change the default tx power the NIC card is using
      *
@@ -189,6 +244,12 @@ protected:
     /** @brief Initialization of the module and some variables.*/
     void initialize(int) override;
 
+    /** @brief Sets up queues, timers and statistics (stage 0 of initialize(), repeated by resetForReuse()).*/
+    void initializeMacState();
+
+    /** @brief Cancels and deletes all self messages.*/
+    void deleteTimers();
+
     /** @brief Delete all dynamically allocated objects of the module.*/
     void finish() override;
 
@@ -234,9 +295,27 @@ protected:
     void sendAck(LAddress::L2Type recpAddress, unsigned long wsmId);
     void handleUnicast(LAddress::L2Type srcAddr, std::unique_ptr<BaseFrame1609_4> wsm);
     void handleAck(const Mac80211Ack* ack);
-    void handleAckTimeOut(AckTimeOutMessage* ackTimeOutMsg);
+    void handleAckTimeOut();
+    /**
+     * @brief makes sure ackTimeOut fires no later than the earliest outstanding ACK deadline of any queue
+     *
+     * The timer is never cancelled when deadlines are cleared (e.g., by a received ACK), it then fires early and handleAckTimeOut() re-arms it.
+     */
+    void rescheduleAckTimeOut();
     void handleRetransmit(t_access_category ac);
 
+    /** @brief account for, signal and delete a frame that was dropped from (or not admitted to) an EDCA queue */
+    void dropFrame(BaseFrame1609_4* frame);
+
+    /** @brief emit the number of frames currently waiting in all EDCA queues */
+    void emitQueueOccupancy();
+
+    /** @brief send a received frame to the upper layer, splitting up an AggregateFrame1609_4 into the frames it carries */
+    void sendUpDeaggregated(BaseFrame1609_4* wsm);
+
+    /** @brief feed the channel busy ratio of a newly completed measurement interval (if any) to the DCC controller */
+    void updateDcc();
+
     const LAddress::L2Type& getMACAddress() override
     {
         ASSERT(myMacAddr != LAddress::L2NULL());
@@ -273,6 +352,9 @@ protected:
 
     std::map<ChannelType, std::unique_ptr<EDCA>> myEDCA;
 
+    /** @brief reports the frames queued in myEDCA as subsystem "mac.queues" */
+    MemoryAccounting::Registration memoryRegistration;
+
     bool idleChannel;
 
     /** @brief stats */
@@ -288,11 +370,21 @@ protected:
     long statsNumInternalContention;
     long statsNumBackoff;
     long statsSlotsBackoff;
+    long statsNumAggregated;
     simtime_t statsTotalBusyTime;
 
     /** @brief The power (in mW) to transmit with.*/
     double txPower;
 
+    /** @brief Scale the reach of transmissions in the connection manager with their tx power?*/
+    bool scaleInterferenceDistance;
+
+    /** @brief The tx power (in mW) the maximum interference distance of the connection manager corresponds to.*/
+    double interferenceDistanceTxPower;
+
+    /** @brief Lower bound of the path loss exponent, for scaling the interference distance with the tx power.*/
+    double interferenceDistanceAlpha;
+
     MCS mcs; ///< Modulation and coding scheme to use unless explicitly specified.
 
     /** @brief Id for debug messages */
@@ -315,9 +407,22 @@ protected:
 
     // Dont start contention immediately after finishing unicast TX. Wait until ack timeout/ ack Rx
     bool waitUntilAckRXorTimeout;
+
+    /** @brief channel busy ratio, updated on every busy/idle edge */
+    ChannelBusyRatio channelBusyRatio;
+
+    /** @brief reactive congestion control (or nullptr if disabled) */
+    std::unique_ptr<ReactiveDcc> dcc;
+    long lastDccInterval = 0;
+
+    // Single timer checking the ACK deadlines of all EDCA queues. It is not cancelled when an ACK arrives in time, but ignored when it fires.
+    AckTimeOutMessage* ackTimeOut = nullptr;
     std::set<unsigned long> handledUnicastToApp;
 
     Mac80211pToPhy11pInterface* phy11p;
+
+    /** @brief The phy as ChannelAccess, to limit the reach of transmissions (nullptr unless scaleInterferenceDistance is set).*/
+    ChannelAccess* phyChannelAccess = nullptr;
 };
 
 } // namespace veins
@@ -0,0 +1,83 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Reactive decentralized congestion control (DCC) in the style of ETSI TS 102 687.
+ *
+ * The controller maps the channel busy ratio to one of a sequence of states of increasing restrictiveness (e.g., relaxed, active 1..n, restrictive).
+ * Each state limits the transmit power and the minimum interval between packets (T_off).
+ *
+ * @see Mac1609_4
+ */
+class VEINS_API ReactiveDcc {
+public:
+    struct State {
+        double minCbr; ///< smallest CBR for which this state is used
+        double maxTxPower_mW; ///< highest transmit power allowed in this state
+        simtime_t minPacketInterval; ///< shortest interval between packets allowed in this state
+    };
+
+    /**
+     * @brief Creates a controller for the given states, which must be sorted by increasing minCbr, starting at a minCbr of 0.
+     */
+    explicit ReactiveDcc(std::vector<State> states)
+        : states(std::move(states))
+    {
+        ASSERT(!this->states.empty() && this->states.front().minCbr == 0);
+    }
+
+    /** @brief Moves to the state for the given CBR and returns whether the state changed. */
+    bool update(double cbr)
+    {
+        size_t newIndex = 0;
+        while (newIndex + 1 < states.size() && cbr >= states[newIndex + 1].minCbr) {
+            newIndex++;
+        }
+        bool changed = newIndex != index;
+        index = newIndex;
+        return changed;
+    }
+
+    const State& getState() const
+    {
+        return states[index];
+    }
+
+    size_t getStateIndex() const
+    {
+        return index;
+    }
+
+private:
+    std::vector<State> states;
+    size_t index = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,90 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/messages/AggregateFrame1609_4.h"
+
+#include "veins/modules/utility/Consts80211p.h"
+
+using namespace veins;
+
+Register_Class(AggregateFrame1609_4);
+
+AggregateFrame1609_4::AggregateFrame1609_4(const char* name, short kind)
+    : BaseFrame1609_4(name, kind)
+{
+}
+
+AggregateFrame1609_4::AggregateFrame1609_4(const AggregateFrame1609_4& other)
+    : BaseFrame1609_4(other)
+{
+    copy(other);
+}
+
+AggregateFrame1609_4& AggregateFrame1609_4::operator=(const AggregateFrame1609_4& other)
+{
+    if (this == &other) return *this;
+    BaseFrame1609_4::operator=(other);
+    clearFrames();
+    copy(other);
+    return *this;
+}
+
+AggregateFrame1609_4::~AggregateFrame1609_4()
+{
+    clearFrames();
+}
+
+void AggregateFrame1609_4::appendFrame(BaseFrame1609_4* frame)
+{
+    take(frame);
+    frames.push_back(frame);
+    addBitLength(frame->getBitLength() + AMSDU_SUBFRAME_HEADER_LENGTH);
+}
+
+std::vector<BaseFrame1609_4*> AggregateFrame1609_4::releaseFrames()
+{
+    std::vector<BaseFrame1609_4*> released;
+    released.swap(frames);
+    for (auto frame : released) {
+        drop(frame);
+        addBitLength(-(frame->getBitLength() + AMSDU_SUBFRAME_HEADER_LENGTH));
+    }
+    return released;
+}
+
+void AggregateFrame1609_4::copy(const AggregateFrame1609_4& other)
+{
+    // the bit length was already copied along with the base class
+    for (auto frame : other.frames) {
+        BaseFrame1609_4* copied = frame->dup();
+        take(copied);
+        frames.push_back(copied);
+    }
+}
+
+void AggregateFrame1609_4::clearFrames()
+{
+    for (auto frame : frames) {
+        dropAndDelete(frame);
+    }
+    frames.clear();
+}
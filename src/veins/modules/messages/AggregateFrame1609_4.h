@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/modules/messages/BaseFrame1609_4_m.h"
+
+namespace veins {
+
+/**
+ * @brief A-MSDU-like container carrying several BaseFrame1609_4 to the same recipient in one transmission.
+ *
+ * The container owns the frames it carries.
+ * Its bit length is the sum of the lengths of all carried frames plus one AMSDU_SUBFRAME_HEADER_LENGTH per frame.
+ *
+ * @see Mac1609_4
+ */
+class VEINS_API AggregateFrame1609_4 : public BaseFrame1609_4 {
+public:
+    AggregateFrame1609_4(const char* name = "AggregateFrame1609_4", short kind = 0);
+    AggregateFrame1609_4(const AggregateFrame1609_4& other);
+    AggregateFrame1609_4& operator=(const AggregateFrame1609_4& other);
+    ~AggregateFrame1609_4() override;
+
+    AggregateFrame1609_4* dup() const override
+    {
+        return new AggregateFrame1609_4(*this);
+    }
+
+    /** @brief Appends a frame, taking ownership of it. */
+    void appendFrame(BaseFrame1609_4* frame);
+
+    size_t getNumFrames() const
+    {
+        return frames.size();
+    }
+
+    const BaseFrame1609_4* getFrame(size_t i) const
+    {
+        return frames.at(i);
+    }
+
+    /** @brief Removes all carried frames (in the order they were appended) and passes their ownership to the caller. */
+    std::vector<BaseFrame1609_4*> releaseFrames();
+
+private:
+    void copy(const AggregateFrame1609_4& other);
+    void clearFrames();
+
+    std::vector<BaseFrame1609_4*> frames;
+};
+
+} // namespace veins
@@ -0,0 +1,50 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/messages/CompactSafetyMessage.h"
+
+using namespace veins;
+
+Register_Class(CompactSafetyMessage);
+
+const int CompactSafetyMessage::messageTypeId;
+
+CompactSafetyMessage::CompactSafetyMessage(const char* name, short kind)
+    : BaseFrame1609_4(name, kind)
+    , payload()
+{
+    setMessageType(messageTypeId);
+}
+
+void CompactSafetyMessage::setSenderPos(const Coord& pos)
+{
+    payload.senderPos[0] = static_cast<float>(pos.x);
+    payload.senderPos[1] = static_cast<float>(pos.y);
+    payload.senderPos[2] = static_cast<float>(pos.z);
+}
+
+void CompactSafetyMessage::setSenderSpeed(const Coord& speed)
+{
+    payload.senderSpeed[0] = static_cast<float>(speed.x);
+    payload.senderSpeed[1] = static_cast<float>(speed.y);
+    payload.senderSpeed[2] = static_cast<float>(speed.z);
+}
@@ -0,0 +1,96 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <type_traits>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/Coord.h"
+#include "veins/modules/messages/BaseFrame1609_4_m.h"
+
+namespace veins {
+
+/**
+ * @brief Fields of a CompactSafetyMessage, stored with fixed width and without any pointers.
+ */
+struct VEINS_API CompactSafetyPayload {
+    float senderPos[3]; ///< position of the sender (x, y, z) in m
+    float senderSpeed[3]; ///< velocity of the sender (x, y, z) in m/s
+};
+
+static_assert(std::is_trivially_copyable<CompactSafetyPayload>::value, "CompactSafetyPayload must stay trivially copyable");
+
+/**
+ * @brief Beacon carrying the same information as a DemoSafetyMessage in a compact, trivially copyable payload.
+ *
+ * Meant for scenarios where beacons dominate the traffic: every receiver decapsulates its own copy of a beacon,
+ * which here amounts to a copy of the (unnamed) frame and of a CompactSafetyPayload.
+ * Positions and speeds are stored in single precision.
+ * The accessors mirror those of DemoSafetyMessage, so code handling either of them reads the same.
+ *
+ * @see DemoBaseApplLayer::onCompactBSM
+ */
+class VEINS_API CompactSafetyMessage : public BaseFrame1609_4 {
+public:
+    /** @brief message type of CompactSafetyMessage frames, see DemoBaseApplLayer::DemoMessageTypes */
+    static const int messageTypeId = 3;
+
+    CompactSafetyMessage(const char* name = nullptr, short kind = 0);
+    CompactSafetyMessage(const CompactSafetyMessage& other) = default;
+    CompactSafetyMessage& operator=(const CompactSafetyMessage& other) = default;
+
+    CompactSafetyMessage* dup() const override
+    {
+        return new CompactSafetyMessage(*this);
+    }
+
+    Coord getSenderPos() const
+    {
+        return Coord(payload.senderPos[0], payload.senderPos[1], payload.senderPos[2]);
+    }
+
+    void setSenderPos(const Coord& pos);
+
+    Coord getSenderSpeed() const
+    {
+        return Coord(payload.senderSpeed[0], payload.senderSpeed[1], payload.senderSpeed[2]);
+    }
+
+    void setSenderSpeed(const Coord& speed);
+
+    const CompactSafetyPayload& getPayload() const
+    {
+        return payload;
+    }
+
+    void setPayload(const CompactSafetyPayload& payload)
+    {
+        this->payload = payload;
+    }
+
+private:
+    CompactSafetyPayload payload;
+};
+
+} // namespace veins
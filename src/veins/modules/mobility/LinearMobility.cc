@@ -41,6 +41,12 @@ void LinearMobility::initialize(int stage)
         acceleration = par("acceleration");
         angle = par("angle");
         angle = fmod(angle, 360);
+
+        if (analyticUpdateDistance > 0) {
+            // move describes the whole trajectory, see makeAnalyticMove()
+            move.setDirectionByVector(Coord(cos(M_PI * angle / 180), sin(M_PI * angle / 180)));
+            move.setAcceleration(acceleration);
+        }
     }
     else if (stage == 1) {
         stepTarget = move.getStartPos();
@@ -61,6 +67,11 @@ void LinearMobility::makeMove()
 {
     EV_TRACE << "start makeMove " << move.info() << endl;
 
+    if (analyticUpdateDistance > 0) {
+        makeAnalyticMove();
+        return;
+    }
+
     move.setStart(stepTarget, simTime());
 
     stepTarget.x = (move.getStartPos().x + move.getSpeed() * cos(M_PI * angle / 180) * SIMTIME_DBL(updateInterval));
@@ -75,3 +86,22 @@ void LinearMobility::makeMove()
 
     fixIfHostGetsOutside();
 }
+
+void LinearMobility::makeAnalyticMove()
+{
+    const simtime_t now = simTime();
+
+    // continue from where the trajectory got the host by now
+    double speed = move.getSpeedAt(now);
+    if (speed < 1e-9) speed = 0; // came to a halt
+    move.setStart(move.getPositionAt(now), now);
+    move.setSpeed(speed);
+
+    if (speed == 0) return;
+
+    stepTarget = move.getPositionAt(predictAnalyticUpdateTime());
+
+    EV_TRACE << "new stepTarget: " << stepTarget.info() << endl;
+
+    fixIfHostGetsOutside();
+}
@@ -55,6 +55,13 @@ protected:
     /** @brief Move the host*/
     void makeMove() override;
 
+    /**
+     * @brief Moves the host along its analytic trajectory (see BaseMobility::analyticUpdateDistance).
+     *
+     * Speed and acceleration are exact rather than applied in steps of updateInterval.
+     */
+    void makeAnalyticMove();
+
     void fixIfHostGetsOutside() override;
 };
 
@@ -0,0 +1,172 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/mobility/traci/LaneIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace veins;
+
+LaneIndex::LaneIndex(std::vector<SumoNetwork::Lane> lanes, double cellSize)
+    : lanes(std::move(lanes))
+    , cellSize(cellSize)
+{
+    ASSERT(cellSize > 0);
+
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = minX;
+    double maxX = -minX;
+    double maxY = -minX;
+    for (size_t l = 0; l < this->lanes.size(); ++l) {
+        const auto& shape = this->lanes[l].shape;
+        double offset = 0;
+        for (size_t i = 0; i < shape.size(); ++i) {
+            minX = std::min(minX, shape[i].x);
+            minY = std::min(minY, shape[i].y);
+            maxX = std::max(maxX, shape[i].x);
+            maxY = std::max(maxY, shape[i].y);
+            if (i == 0) continue;
+            segments.push_back({l, shape[i - 1], shape[i], offset});
+            offset += std::hypot(shape[i].x - shape[i - 1].x, shape[i].y - shape[i - 1].y);
+        }
+        const double length = this->lanes[l].length;
+        lengthScales.push_back((length > 0 && offset > 0) ? length / offset : 1);
+    }
+    if (segments.empty()) return;
+
+    origin = TraCICoord(minX, minY);
+    numCellsX = static_cast<size_t>((maxX - minX) / cellSize) + 1;
+    numCellsY = static_cast<size_t>((maxY - minY) / cellSize) + 1;
+
+    // every segment goes into all cells its bounding box overlaps, counted first so cells can be stored back to back
+    auto cellRange = [this](const Segment& s, size_t& x0, size_t& x1, size_t& y0, size_t& y1) {
+        x0 = static_cast<size_t>((std::min(s.from.x, s.to.x) - origin.x) / this->cellSize);
+        x1 = static_cast<size_t>((std::max(s.from.x, s.to.x) - origin.x) / this->cellSize);
+        y0 = static_cast<size_t>((std::min(s.from.y, s.to.y) - origin.y) / this->cellSize);
+        y1 = static_cast<size_t>((std::max(s.from.y, s.to.y) - origin.y) / this->cellSize);
+    };
+    cellStart.assign(numCellsX * numCellsY + 1, 0);
+    size_t x0, x1, y0, y1;
+    for (const Segment& s : segments) {
+        cellRange(s, x0, x1, y0, y1);
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) ++cellStart[y * numCellsX + x + 1];
+        }
+    }
+    for (size_t i = 1; i < cellStart.size(); ++i) cellStart[i] += cellStart[i - 1];
+    cellSegments.resize(cellStart.back());
+    std::vector<size_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        cellRange(segments[i], x0, x1, y0, y1);
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) cellSegments[fill[y * numCellsX + x]++] = i;
+        }
+    }
+}
+
+template <typename Visit>
+void LaneIndex::forEachSegmentNear(const TraCICoord& position, double maxDistance, Visit visit) const
+{
+    if (segments.empty()) return;
+    auto cellOf = [this](double v, double o, size_t numCells) {
+        const double c = std::floor((v - o) / cellSize);
+        return static_cast<size_t>(std::min(std::max(c, 0.0), static_cast<double>(numCells - 1)));
+    };
+    // positions beyond the grid only reach its border cells
+    if (position.x + maxDistance < origin.x || position.y + maxDistance < origin.y) return;
+    if (position.x - maxDistance > origin.x + numCellsX * cellSize || position.y - maxDistance > origin.y + numCellsY * cellSize) return;
+    const size_t x0 = cellOf(position.x - maxDistance, origin.x, numCellsX);
+    const size_t x1 = cellOf(position.x + maxDistance, origin.x, numCellsX);
+    const size_t y0 = cellOf(position.y - maxDistance, origin.y, numCellsY);
+    const size_t y1 = cellOf(position.y + maxDistance, origin.y, numCellsY);
+    for (size_t y = y0; y <= y1; ++y) {
+        for (size_t x = x0; x <= x1; ++x) {
+            const size_t cell = y * numCellsX + x;
+            for (size_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) visit(segments[cellSegments[i]]);
+        }
+    }
+}
+
+LaneIndex::Match LaneIndex::matchSegment(const Segment& segment, const TraCICoord& position) const
+{
+    const double dx = segment.to.x - segment.from.x;
+    const double dy = segment.to.y - segment.from.y;
+    const double sqrLength = dx * dx + dy * dy;
+    const double px = position.x - segment.from.x;
+    const double py = position.y - segment.from.y;
+    const double t = sqrLength > 0 ? std::min(std::max((px * dx + py * dy) / sqrLength, 0.0), 1.0) : 0;
+
+    Match m;
+    m.lane = &lanes[segment.lane];
+    m.point = TraCICoord(segment.from.x + t * dx, segment.from.y + t * dy);
+    m.distance = std::hypot(position.x - m.point.x, position.y - m.point.y);
+    // network coordinates have y pointing north, so a positive cross product means left of the driving direction
+    const double cross = dx * py - dy * px;
+    m.lateralOffset = cross >= 0 ? m.distance : -m.distance;
+    m.lanePosition = (segment.offset + t * std::sqrt(sqrLength)) * lengthScales[segment.lane];
+    return m;
+}
+
+LaneIndex::Match LaneIndex::match(const TraCICoord& position, double maxDistance) const
+{
+    Match best;
+    size_t bestLane = std::numeric_limits<size_t>::max();
+    forEachSegmentNear(position, maxDistance, [&](const Segment& segment) {
+        Match m = matchSegment(segment, position);
+        if (m.distance > maxDistance) return;
+        if (!best || m.distance < best.distance || (m.distance == best.distance && segment.lane < bestLane)) {
+            best = m;
+            bestLane = segment.lane;
+        }
+    });
+    return best;
+}
+
+std::vector<LaneIndex::Match> LaneIndex::matchAll(const TraCICoord& position, double maxDistance) const
+{
+    std::vector<Match> matches; // nearest point per lane, in order of first encounter
+    std::vector<size_t> matchLanes;
+    forEachSegmentNear(position, maxDistance, [&](const Segment& segment) {
+        Match m = matchSegment(segment, position);
+        if (m.distance > maxDistance) return;
+        auto found = std::find(matchLanes.begin(), matchLanes.end(), segment.lane);
+        if (found == matchLanes.end()) {
+            matches.push_back(m);
+            matchLanes.push_back(segment.lane);
+        }
+        else if (m.distance < matches[found - matchLanes.begin()].distance) {
+            matches[found - matchLanes.begin()] = m;
+        }
+    });
+    std::vector<size_t> order(matches.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (matches[a].distance != matches[b].distance) return matches[a].distance < matches[b].distance;
+        return matchLanes[a] < matchLanes[b];
+    });
+    std::vector<Match> sorted;
+    sorted.reserve(order.size());
+    for (size_t i : order) sorted.push_back(matches[i]);
+    return sorted;
+}
@@ -0,0 +1,115 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/modules/mobility/traci/SumoNetwork.h"
+
+namespace veins {
+
+/**
+ * Spatial index of lane center lines, for matching positions to lanes without a round trip to the TraCI server.
+ *
+ * Answers what Vehicle::getLaneId(), getLanePosition() and Lane::getShape() would be asked for, for any position
+ * (e.g., one reported in a received beacon). The segments of all lane shapes are kept in a uniform grid,
+ * so a match only looks at the segments close to the position. Coordinates are network coordinates, like in SumoNetwork.
+ */
+class VEINS_API LaneIndex {
+public:
+    /**
+     * The point of a lane's center line nearest to a position.
+     */
+    struct Match {
+        const SumoNetwork::Lane* lane = nullptr; /**< nullptr if no lane was within reach */
+        double lanePosition = 0; /**< distance of the point from the start of the lane, scaled to the lane's length (like TraCI's lane position) */
+        double lateralOffset = 0; /**< distance of the position from the center line, positive if left of it (in driving direction) */
+        double distance = 0; /**< distance of the position from the center line */
+        TraCICoord point; /**< nearest point of the center line */
+
+        explicit operator bool() const
+        {
+            return lane != nullptr;
+        }
+    };
+
+    /**
+     * Indexes the given lanes (e.g., those of a SumoNetwork) in a grid of cells cellSize meters wide.
+     */
+    explicit LaneIndex(std::vector<SumoNetwork::Lane> lanes, double cellSize = 25);
+
+    /**
+     * Returns the lane nearest to position, if its center line is at most maxDistance away (ties go to the lane indexed first).
+     */
+    Match match(const TraCICoord& position, double maxDistance) const;
+
+    /**
+     * Returns the nearest point of every lane whose center line is at most maxDistance away from position, nearest first.
+     *
+     * Lets callers pick among overlapping lanes, e.g., by the heading of a vehicle.
+     */
+    std::vector<Match> matchAll(const TraCICoord& position, double maxDistance) const;
+
+    const std::vector<SumoNetwork::Lane>& getLanes() const
+    {
+        return lanes;
+    }
+
+    size_t getNumSegments() const
+    {
+        return segments.size();
+    }
+
+protected:
+    struct Segment {
+        size_t lane; /**< index in lanes */
+        TraCICoord from;
+        TraCICoord to;
+        double offset; /**< length of the lane's shape before from */
+    };
+
+    /**
+     * Calls visit(segment) for all segments in the cells within maxDistance of position (segments may be visited more than once).
+     */
+    template <typename Visit>
+    void forEachSegmentNear(const TraCICoord& position, double maxDistance, Visit visit) const;
+
+    /**
+     * Returns the point of segment nearest to position.
+     */
+    Match matchSegment(const Segment& segment, const TraCICoord& position) const;
+
+    std::vector<SumoNetwork::Lane> lanes;
+    std::vector<double> lengthScales; /**< lane length divided by the length of its shape, per lane */
+    std::vector<Segment> segments;
+    double cellSize;
+    TraCICoord origin; /**< lower left corner of the grid */
+    size_t numCellsX = 0;
+    size_t numCellsY = 0;
+    std::vector<size_t> cellStart; /**< segments of cell i are cellSegments[cellStart[i]] to cellSegments[cellStart[i + 1] - 1] */
+    std::vector<size_t> cellSegments; /**< indices in segments, cell by cell */
+};
+
+} // namespace veins
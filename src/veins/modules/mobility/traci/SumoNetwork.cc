@@ -0,0 +1,101 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <cstdlib>
+#include <sstream>
+
+#include "veins/modules/mobility/traci/SumoNetwork.h"
+
+namespace veins {
+
+namespace {
+
+std::string requireAttribute(const cXMLElement* e, const char* name)
+{
+    const char* value = e->getAttribute(name);
+    if (!value) throw cRuntimeError("<%s> element in SUMO network file lacks attribute \"%s\" at %s", e->getTagName(), name, e->getSourceLocation());
+    return value;
+}
+
+double doubleAttribute(const cXMLElement* e, const char* name, double defaultValue)
+{
+    const char* value = e->getAttribute(name);
+    return value ? std::strtod(value, nullptr) : defaultValue;
+}
+
+} // namespace
+
+constexpr double SumoNetwork::defaultLaneWidth;
+
+SumoNetwork::SumoNetwork(const cXMLElement* net)
+{
+    ASSERT(net);
+
+    for (const cXMLElement* edge : net->getChildrenByTagName("edge")) {
+        Edge e;
+        e.id = requireAttribute(edge, "id");
+        const char* name = edge->getAttribute("name");
+        e.name = name ? name : "";
+        const char* type = edge->getAttribute("type");
+        e.type = type ? type : "";
+        const char* function = edge->getAttribute("function");
+        e.function = function ? function : "";
+        for (const cXMLElement* lane : edge->getChildrenByTagName("lane")) {
+            Lane l;
+            l.id = requireAttribute(lane, "id");
+            l.edgeId = e.id;
+            l.length = doubleAttribute(lane, "length", 0);
+            l.width = doubleAttribute(lane, "width", defaultLaneWidth);
+            l.shape = parseShape(requireAttribute(lane, "shape"));
+            lanes.push_back(std::move(l));
+        }
+        edges.push_back(std::move(e));
+    }
+
+    for (const cXMLElement* junction : net->getChildrenByTagName("junction")) {
+        Junction j;
+        j.id = requireAttribute(junction, "id");
+        j.position = TraCICoord(doubleAttribute(junction, "x", 0), doubleAttribute(junction, "y", 0));
+        const char* shape = junction->getAttribute("shape");
+        if (shape) j.shape = parseShape(shape);
+        junctions.push_back(std::move(j));
+    }
+}
+
+std::vector<TraCICoord> SumoNetwork::parseShape(const std::string& shape)
+{
+    std::vector<TraCICoord> points;
+    std::istringstream shapeStream(shape);
+    std::string point;
+    while (shapeStream >> point) {
+        // points may carry a third (z) component, which is ignored
+        char* end = nullptr;
+        double x = std::strtod(point.c_str(), &end);
+        if (*end != ',') throw cRuntimeError("Parsing shape \"%s\" of SUMO network file failed", shape.c_str());
+        double y = std::strtod(end + 1, &end);
+        if (*end != '\0' && *end != ',') throw cRuntimeError("Parsing shape \"%s\" of SUMO network file failed", shape.c_str());
+        points.push_back(TraCICoord(x, y));
+    }
+    return points;
+}
+
+} // namespace veins
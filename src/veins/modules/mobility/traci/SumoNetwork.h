@@ -0,0 +1,93 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/modules/mobility/traci/TraCICoord.h"
+
+namespace veins {
+
+/**
+ * Static road network geometry, read directly from a SUMO network file (.net.xml).
+ *
+ * Lets static network queries be answered without a round trip to the TraCI server,
+ * see TraCICommandInterface::prewarmStaticQueryCache(). Coordinates are network
+ * coordinates, i.e., the same TraCI uses.
+ */
+class VEINS_API SumoNetwork {
+public:
+    struct Lane {
+        std::string id;
+        std::string edgeId;
+        double length;
+        double width;
+        std::vector<TraCICoord> shape;
+    };
+    struct Edge {
+        std::string id;
+        std::string name;
+        std::string type; /**< edge type, e.g., highway.primary (empty if not given) */
+        std::string function; /**< edge function, e.g., internal (empty for normal edges) */
+    };
+    struct Junction {
+        std::string id;
+        TraCICoord position;
+        std::vector<TraCICoord> shape;
+    };
+
+    /**
+     * Reads edges, lanes and junctions from the root (net) element of a SUMO network file.
+     */
+    explicit SumoNetwork(const cXMLElement* net);
+
+    const std::vector<Edge>& getEdges() const
+    {
+        return edges;
+    }
+    const std::vector<Lane>& getLanes() const
+    {
+        return lanes;
+    }
+    const std::vector<Junction>& getJunctions() const
+    {
+        return junctions;
+    }
+
+    /**
+     * Parses a shape attribute, given as x,y pairs separated by spaces.
+     */
+    static std::vector<TraCICoord> parseShape(const std::string& shape);
+
+    static constexpr double defaultLaneWidth = 3.2; /**< lane width SUMO assumes if the network file does not give one */
+
+private:
+    std::vector<Edge> edges;
+    std::vector<Lane> lanes;
+    std::vector<Junction> junctions;
+};
+
+} // namespace veins
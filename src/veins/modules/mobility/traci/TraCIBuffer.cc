@@ -26,6 +26,7 @@
 
 #include <iomanip>
 #include <sstream>
+#include <utility>
 
 using namespace veins::TraCIConstants;
 
@@ -40,7 +41,7 @@ TraCIBuffer::TraCIBuffer()
 }
 
 TraCIBuffer::TraCIBuffer(std::string buf)
-    : buf(buf)
+    : buf(std::move(buf))
 {
     buf_index = 0;
 }
@@ -52,7 +53,18 @@ bool TraCIBuffer::eof() const
 
 void TraCIBuffer::set(std::string buf)
 {
-    this->buf = buf;
+    this->buf = std::move(buf);
+    buf_index = 0;
+}
+
+void TraCIBuffer::rewind()
+{
+    buf_index = 0;
+}
+
+void TraCIBuffer::swap(std::string& other)
+{
+    buf.swap(other);
     buf_index = 0;
 }
 
@@ -95,7 +107,7 @@ void TraCIBuffer::write(std::string inv)
 {
     uint32_t length = inv.length();
     write<uint32_t>(length);
-    for (size_t i = 0; i < length; ++i) write<char>(inv[i]);
+    buf.append(inv);
 }
 
 template <>
@@ -108,17 +120,68 @@ void TraCIBuffer::write(std::list<std::string> inv)
     }
 }
 
+void TraCIBuffer::readInto(std::string& out)
+{
+    uint32_t length = read<uint32_t>();
+    if (buf.length() - buf_index < length) throw cRuntimeError("Attempted to read past end of byte buffer");
+
+    out.assign(buf, buf_index, length);
+    buf_index += length;
+}
+
 template <>
 std::string TraCIBuffer::read()
 {
     uint32_t length = read<uint32_t>();
-    if (length == 0) return std::string();
-    char obuf[length + 1];
+    if (buf.length() - buf_index < length) throw cRuntimeError("Attempted to read past end of byte buffer");
+
+    std::string obuf(buf, buf_index, length);
+    buf_index += length;
+    return obuf;
+}
+
+template <>
+std::list<std::string> TraCIBuffer::read()
+{
+    uint32_t count = read<uint32_t>();
+
+    std::list<std::string> result;
+    for (uint32_t i = 0; i < count; ++i) {
+        result.emplace_back(read<std::string>());
+    }
+    return result;
+}
+
+std::string TraCIBuffer::readCommand()
+{
+    size_t start = buf_index;
+    uint32_t cmdLength = read<uint8_t>();
+    if (cmdLength == 0) cmdLength = read<uint32_t>();
+    if (cmdLength < buf_index - start || buf.length() - start < cmdLength) throw cRuntimeError("Attempted to read past end of byte buffer");
+
+    buf_index = start + cmdLength;
+    return buf.substr(start, cmdLength);
+}
+
+void TraCIBuffer::readCommand(TraCIBuffer& out)
+{
+    size_t start = buf_index;
+    uint32_t cmdLength = read<uint8_t>();
+    if (cmdLength == 0) cmdLength = read<uint32_t>();
+    if (cmdLength < buf_index - start || buf.length() - start < cmdLength) throw cRuntimeError("Attempted to read past end of byte buffer");
 
-    for (size_t i = 0; i < length; ++i) read<char>(obuf[i]);
-    obuf[length] = 0;
+    buf_index = start + cmdLength;
+    out.buf.assign(buf, start, cmdLength);
+    out.buf_index = 0;
+}
 
-    return std::string(obuf, length);
+void TraCIBuffer::skipStrings(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t length = read<uint32_t>();
+        if (buf.length() - buf_index < length) throw cRuntimeError("Attempted to read past end of byte buffer");
+        buf_index += length;
+    }
 }
 
 template <>
@@ -176,9 +239,7 @@ simtime_t TraCIBuffer::read()
 
 bool VEINS_API isBigEndian()
 {
-    short a = 0x0102;
-    unsigned char* p_a = reinterpret_cast<unsigned char*>(&a);
-    return (p_a[0] == 0x01);
+    return hostIsBigEndian;
 }
 
 } // namespace veins
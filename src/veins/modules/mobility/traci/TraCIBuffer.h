@@ -23,6 +23,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
 #include <string>
 
 #include "veins/veins.h"
@@ -33,8 +36,69 @@ namespace veins {
 
 struct TraCICoord;
 
+/**
+ * byte order of the host, as reported by the compiler (TraCI itself uses network byte order)
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+constexpr bool hostIsBigEndian = (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__);
+#else
+constexpr bool hostIsBigEndian = false;
+#endif
+
 bool VEINS_API isBigEndian();
 
+namespace TraCIByteOrder {
+
+template <size_t N>
+struct UintOfSize;
+template <>
+struct UintOfSize<1> {
+    using type = uint8_t;
+};
+template <>
+struct UintOfSize<2> {
+    using type = uint16_t;
+};
+template <>
+struct UintOfSize<4> {
+    using type = uint32_t;
+};
+template <>
+struct UintOfSize<8> {
+    using type = uint64_t;
+};
+
+constexpr uint8_t byteswap(uint8_t v)
+{
+    return v;
+}
+
+constexpr uint16_t byteswap(uint16_t v)
+{
+    return static_cast<uint16_t>((v >> 8) | (v << 8));
+}
+
+constexpr uint32_t byteswap(uint32_t v)
+{
+    return ((v & 0x000000FFu) << 24) | ((v & 0x0000FF00u) << 8) | ((v & 0x00FF0000u) >> 8) | ((v & 0xFF000000u) >> 24);
+}
+
+constexpr uint64_t byteswap(uint64_t v)
+{
+    return (static_cast<uint64_t>(byteswap(static_cast<uint32_t>(v))) << 32) | byteswap(static_cast<uint32_t>(v >> 32));
+}
+
+/**
+ * converts between host and TraCI (network) byte order; the conversion is its own inverse
+ */
+template <typename U>
+constexpr U toNetwork(U v)
+{
+    return hostIsBigEndian ? v : byteswap(v);
+}
+
+} // namespace TraCIByteOrder
+
 /**
  * Byte-buffer that stores values in TraCI byte-order
  */
@@ -46,56 +110,58 @@ public:
     template <typename T>
     T read()
     {
-        T buf_to_return;
-        unsigned char* p_buf_to_return = reinterpret_cast<unsigned char*>(&buf_to_return);
+        using Raw = typename TraCIByteOrder::UintOfSize<sizeof(T)>::type;
 
-        if (isBigEndian()) {
-            for (size_t i = 0; i < sizeof(buf_to_return); ++i) {
-                if (eof()) throw cRuntimeError("Attempted to read past end of byte buffer");
-                p_buf_to_return[i] = buf[buf_index++];
-            }
-        }
-        else {
-            for (size_t i = 0; i < sizeof(buf_to_return); ++i) {
-                if (eof()) throw cRuntimeError("Attempted to read past end of byte buffer");
-                p_buf_to_return[sizeof(buf_to_return) - 1 - i] = buf[buf_index++];
-            }
-        }
+        if (buf.length() - buf_index < sizeof(T)) throw cRuntimeError("Attempted to read past end of byte buffer");
+        Raw raw;
+        std::memcpy(&raw, buf.data() + buf_index, sizeof(T));
+        buf_index += sizeof(T);
+        raw = TraCIByteOrder::toNetwork(raw);
 
+        T buf_to_return;
+        std::memcpy(&buf_to_return, &raw, sizeof(T));
         return buf_to_return;
     }
 
     template <typename T>
     void write(T inv)
     {
-        unsigned char* p_buf_to_send = reinterpret_cast<unsigned char*>(&inv);
+        using Raw = typename TraCIByteOrder::UintOfSize<sizeof(T)>::type;
 
-        if (isBigEndian()) {
-            for (size_t i = 0; i < sizeof(inv); ++i) {
-                buf += p_buf_to_send[i];
-            }
-        }
-        else {
-            for (size_t i = 0; i < sizeof(inv); ++i) {
-                buf += p_buf_to_send[sizeof(inv) - 1 - i];
-            }
+        Raw raw;
+        std::memcpy(&raw, &inv, sizeof(T));
+        raw = TraCIByteOrder::toNetwork(raw);
+        buf.append(reinterpret_cast<const char*>(&raw), sizeof(T));
+    }
+
+    /**
+     * @brief
+     * read count consecutive values of the same type, checking the buffer bounds only once
+     */
+    template <typename T>
+    void readArray(T* out, size_t count)
+    {
+        using Raw = typename TraCIByteOrder::UintOfSize<sizeof(T)>::type;
+
+        if ((buf.length() - buf_index) / sizeof(T) < count) throw cRuntimeError("Attempted to read past end of byte buffer");
+        const char* p = buf.data() + buf_index;
+        for (size_t i = 0; i < count; ++i) {
+            Raw raw;
+            std::memcpy(&raw, p + i * sizeof(T), sizeof(T));
+            raw = TraCIByteOrder::toNetwork(raw);
+            std::memcpy(out + i, &raw, sizeof(T));
         }
+        buf_index += count * sizeof(T);
     }
 
     void readBuffer(unsigned char* buffer, size_t size)
     {
-        if (isBigEndian()) {
-            for (size_t i = 0; i < size; ++i) {
-                if (eof()) throw cRuntimeError("Attempted to read past end of byte buffer");
-                buffer[i] = buf[buf_index++];
-            }
-        }
-        else {
-            for (size_t i = 0; i < size; ++i) {
-                if (eof()) throw cRuntimeError("Attempted to read past end of byte buffer");
-                buffer[size - 1 - i] = buf[buf_index++];
-            }
+        if (buf.length() - buf_index < size) throw cRuntimeError("Attempted to read past end of byte buffer");
+        const char* p = buf.data() + buf_index;
+        for (size_t i = 0; i < size; ++i) {
+            buffer[hostIsBigEndian ? i : size - 1 - i] = p[i];
         }
+        buf_index += size;
     }
 
     template <typename T>
@@ -112,6 +178,18 @@ public:
         return *this;
     }
 
+    /**
+     * @brief
+     * read a string into out, reusing its storage (so reading into the same string again and again does not allocate)
+     */
+    void readInto(std::string& out);
+
+    TraCIBuffer& operator>>(std::string& out)
+    {
+        readInto(out);
+        return *this;
+    }
+
     template <typename T>
     TraCIBuffer& operator<<(const T& inv)
     {
@@ -161,8 +239,28 @@ public:
         write(inv);
     }
 
+    /**
+     * @brief
+     * read one length-prefixed command, returning it including its length field
+     */
+    std::string readCommand();
+
+    /**
+     * @brief
+     * read one length-prefixed command into out (rewound to its start), reusing the storage of out
+     */
+    void readCommand(TraCIBuffer& out);
+
+    /**
+     * @brief
+     * skip count consecutive strings without copying them out of the buffer
+     */
+    void skipStrings(uint32_t count);
+
     bool eof() const;
     void set(std::string buf);
+    void rewind(); /**< continue reading from the start of the buffer */
+    void swap(std::string& other); /**< exchange the contents of the buffer with other, continuing reading from the start */
     void clear();
     std::string str() const;
     std::string hexStr() const;
@@ -192,6 +290,8 @@ void TraCIBuffer::write(TraCICoord inv);
 template <>
 std::string VEINS_API TraCIBuffer::read();
 template <>
+std::list<std::string> VEINS_API TraCIBuffer::read();
+template <>
 TraCICoord TraCIBuffer::read();
 template <>
 void TraCIBuffer::write(simtime_t o);
@@ -20,8 +20,12 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //
 
+#include <array>
 #include <cstdint>
+#include <iterator>
+#include <memory>
 #include <stdlib.h>
+#include <vector>
 
 #include "veins/modules/mobility/traci/TraCIBuffer.h"
 #include "veins/modules/mobility/traci/TraCIColor.h"
@@ -55,6 +59,11 @@ TraCICommandInterface::TraCICommandInterface(cComponent* owner, TraCIConnection&
 {
 }
 
+TraCICommandInterface::~TraCICommandInterface()
+{
+    if (cachingStepQueries) connection.setCommandObserver(nullptr);
+}
+
 bool TraCICommandInterface::isIgnoringGuiCommands()
 {
     return ignoreGuiCommands;
@@ -143,11 +152,16 @@ void TraCICommandInterface::Vehicle::setSpeedMode(int32_t bitset)
 }
 
 void TraCICommandInterface::Vehicle::setSpeed(double speed)
+{
+    queueSetSpeed(speed);
+    traci->flushQueries();
+}
+
+void TraCICommandInterface::Vehicle::queueSetSpeed(double speed, CommandCallback onResult)
 {
     uint8_t variableId = VAR_SPEED;
     uint8_t variableType = TYPE_DOUBLE;
-    TraCIBuffer buf = traci->connection.query(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << speed);
-    ASSERT(buf.eof());
+    traci->queueCommand(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << speed, std::move(onResult));
 }
 
 void TraCICommandInterface::Vehicle::setMaxSpeed(double speed)
@@ -233,6 +247,15 @@ void TraCICommandInterface::Vehicle::setParking()
     throw cRuntimeError("TraCICommandInterface::Vehicle::setParking is non-functional as of SUMO 1.0.0");
 }
 
+void TraCICommandInterface::Vehicle::remove()
+{
+    uint8_t variableId = REMOVE;
+    uint8_t variableType = TYPE_BYTE;
+    uint8_t reason = REMOVE_VAPORIZED;
+    TraCIBuffer buf = traci->connection.query(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << reason);
+    ASSERT(buf.eof());
+}
+
 std::list<std::string> TraCICommandInterface::getVehicleTypeIds()
 {
     return genericGetStringList(CMD_GET_VEHICLETYPE_VARIABLE, "", ID_LIST, RESPONSE_GET_VEHICLETYPE_VARIABLE);
@@ -246,6 +269,7 @@ double TraCICommandInterface::getVehicleTypeMaxSpeed(std::string typeId)
 void TraCICommandInterface::setVehicleTypeMaxSpeed(std::string typeId, double maxSpeed)
 {
     genericSetDouble(CMD_SET_VEHICLETYPE_VARIABLE, typeId, VAR_MAXSPEED, maxSpeed);
+    invalidateStaticQueries(CMD_GET_VEHICLETYPE_VARIABLE, typeId);
 }
 
 std::list<std::string> TraCICommandInterface::getRouteIds()
@@ -254,6 +278,12 @@ std::list<std::string> TraCICommandInterface::getRouteIds()
 }
 
 void TraCICommandInterface::addRoute(std::string routeId, const std::list<std::string>& edges)
+{
+    queueAddRoute(routeId, edges);
+    connection.flushQueries();
+}
+
+void TraCICommandInterface::queueAddRoute(std::string routeId, const std::list<std::string>& edges, CommandCallback onResult)
 {
     TraCIBuffer p;
     p << static_cast<uint8_t>(ADD);
@@ -264,8 +294,13 @@ void TraCICommandInterface::addRoute(std::string routeId, const std::list<std::s
         p << edge;
     }
 
-    TraCIBuffer buf = connection.query(CMD_SET_ROUTE_VARIABLE, p);
-    ASSERT(buf.eof());
+    queueCommand(CMD_SET_ROUTE_VARIABLE, p, std::move(onResult));
+    invalidateStaticQueries(CMD_GET_ROUTE_VARIABLE, "");
+}
+
+std::list<std::string> TraCICommandInterface::getVehicleIds()
+{
+    return genericGetStringList(CMD_GET_VEHICLE_VARIABLE, "", ID_LIST, RESPONSE_GET_VEHICLE_VARIABLE);
 }
 
 std::list<std::string> TraCICommandInterface::getRoadIds()
@@ -327,6 +362,11 @@ std::list<std::string> TraCICommandInterface::Vehicle::getPlannedRoadIds()
     return traci->genericGetStringList(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_EDGES, RESPONSE_GET_VEHICLE_VARIABLE);
 }
 
+void TraCICommandInterface::Vehicle::getPlannedRoadIds(std::vector<std::string>& roadIds)
+{
+    traci->genericGetStringVector(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_EDGES, RESPONSE_GET_VEHICLE_VARIABLE, roadIds);
+}
+
 std::string TraCICommandInterface::Vehicle::getRouteId()
 {
     return traci->genericGetString(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_ROUTE_ID, RESPONSE_GET_VEHICLE_VARIABLE);
@@ -339,6 +379,29 @@ std::list<std::string> TraCICommandInterface::Route::getRoadIds()
 
 void TraCICommandInterface::Vehicle::changeRoute(std::string roadId, simtime_t travelTime)
 {
+    queueChangeRoute(roadId, travelTime);
+    traci->flushQueries();
+}
+
+void TraCICommandInterface::Vehicle::queueChangeRoute(std::string roadId, simtime_t travelTime, CommandCallback onResult)
+{
+    // both commands go out in the same message; report the first failure (if any) once the second response has been received
+    auto firstError = std::make_shared<std::pair<bool, std::string>>(true, "");
+    CommandCallback onTravelTimeResult = nullptr;
+    CommandCallback onRerouteResult = nullptr;
+    if (onResult) {
+        onTravelTimeResult = [firstError](bool success, const std::string& message) {
+            *firstError = {success, message};
+        };
+        onRerouteResult = [firstError, onResult](bool success, const std::string& message) {
+            if (!firstError->first) {
+                onResult(false, firstError->second);
+                return;
+            }
+            onResult(success, message);
+        };
+    }
+
     if (travelTime >= 0) {
         uint8_t variableId = VAR_EDGE_TRAVELTIME;
         uint8_t variableType = TYPE_COMPOUND;
@@ -347,8 +410,7 @@ void TraCICommandInterface::Vehicle::changeRoute(std::string roadId, simtime_t t
         std::string edgeId = roadId;
         uint8_t newTimeT = TYPE_DOUBLE; // has always been seconds as double
         double newTime = travelTime.dbl();
-        TraCIBuffer buf = connection->query(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << count << edgeIdT << edgeId << newTimeT << newTime);
-        ASSERT(buf.eof());
+        traci->queueCommand(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << count << edgeIdT << edgeId << newTimeT << newTime, onTravelTimeResult);
     }
     else {
         uint8_t variableId = VAR_EDGE_TRAVELTIME;
@@ -356,15 +418,13 @@ void TraCICommandInterface::Vehicle::changeRoute(std::string roadId, simtime_t t
         int32_t count = 1;
         uint8_t edgeIdT = TYPE_STRING;
         std::string edgeId = roadId;
-        TraCIBuffer buf = connection->query(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << count << edgeIdT << edgeId);
-        ASSERT(buf.eof());
+        traci->queueCommand(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << count << edgeIdT << edgeId, onTravelTimeResult);
     }
     {
         uint8_t variableId = CMD_REROUTE_TRAVELTIME;
         uint8_t variableType = TYPE_COMPOUND;
         int32_t count = 0;
-        TraCIBuffer buf = connection->query(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << count);
-        ASSERT(buf.eof());
+        traci->queueCommand(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << nodeId << variableType << count, onRerouteResult);
     }
 }
 
@@ -408,6 +468,28 @@ double TraCICommandInterface::Vehicle::getAcceleration()
     return traci->genericGetDouble(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_ACCELERATION, RESPONSE_GET_VEHICLE_VARIABLE);
 }
 
+void TraCICommandInterface::Vehicle::queueGetSpeed(std::function<void(double)> onResult)
+{
+    traci->queueGenericGetDouble(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_SPEED, RESPONSE_GET_VEHICLE_VARIABLE, std::move(onResult));
+}
+
+void TraCICommandInterface::Vehicle::queueGetTypeId(std::function<void(std::string)> onResult)
+{
+    traci->queueGenericGetString(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_TYPE, RESPONSE_GET_VEHICLE_VARIABLE, std::move(onResult));
+}
+
+void TraCICommandInterface::Vehicle::queueGetDimensions(std::function<void(double length, double height, double width)> onResult)
+{
+    // responses are handled in the order the queries were queued, so the last one has all values
+    auto dimensions = std::make_shared<std::array<double, 3>>();
+    traci->queueGenericGetDouble(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_LENGTH, RESPONSE_GET_VEHICLE_VARIABLE, [dimensions](double length) { (*dimensions)[0] = length; });
+    traci->queueGenericGetDouble(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_HEIGHT, RESPONSE_GET_VEHICLE_VARIABLE, [dimensions](double height) { (*dimensions)[1] = height; });
+    traci->queueGenericGetDouble(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_WIDTH, RESPONSE_GET_VEHICLE_VARIABLE, [dimensions, onResult](double width) {
+        (*dimensions)[2] = width;
+        if (onResult) onResult((*dimensions)[0], (*dimensions)[1], (*dimensions)[2]);
+    });
+}
+
 double TraCICommandInterface::Vehicle::getDistanceTravelled()
 {
     return traci->genericGetDouble(CMD_GET_VEHICLE_VARIABLE, nodeId, VAR_DISTANCE, RESPONSE_GET_VEHICLE_VARIABLE);
@@ -926,14 +1008,24 @@ simtime_t TraCICommandInterface::Trafficlight::getAssumedNextSwitchTime() const
 
 void TraCICommandInterface::Trafficlight::setState(std::string state)
 {
-    TraCIBuffer buf = connection->query(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_RED_YELLOW_GREEN_STATE) << trafficLightId << static_cast<uint8_t>(TYPE_STRING) << state);
-    ASSERT(buf.eof());
+    queueSetState(state);
+    traci->flushQueries();
+}
+
+void TraCICommandInterface::Trafficlight::queueSetState(std::string state, CommandCallback onResult)
+{
+    traci->queueCommand(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_RED_YELLOW_GREEN_STATE) << trafficLightId << static_cast<uint8_t>(TYPE_STRING) << state, std::move(onResult));
 }
 
 void TraCICommandInterface::Trafficlight::setPhaseDuration(simtime_t duration)
 {
-    TraCIBuffer buf = connection->query(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_PHASE_DURATION) << trafficLightId << static_cast<uint8_t>(traci->getTimeType()) << duration);
-    ASSERT(buf.eof());
+    queueSetPhaseDuration(duration);
+    traci->flushQueries();
+}
+
+void TraCICommandInterface::Trafficlight::queueSetPhaseDuration(simtime_t duration, CommandCallback onResult)
+{
+    traci->queueCommand(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_PHASE_DURATION) << trafficLightId << static_cast<uint8_t>(traci->getTimeType()) << duration, std::move(onResult));
 }
 
 void TraCICommandInterface::Trafficlight::setProgramDefinition(TraCITrafficLightProgram::Logic logic, int32_t logicNr)
@@ -1035,14 +1127,24 @@ void TraCICommandInterface::Trafficlight::setProgramDefinition(TraCITrafficLight
 
 void TraCICommandInterface::Trafficlight::setProgram(std::string program)
 {
-    TraCIBuffer buf = connection->query(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_PROGRAM) << trafficLightId << static_cast<uint8_t>(TYPE_STRING) << program);
-    ASSERT(buf.eof());
+    queueSetProgram(program);
+    traci->flushQueries();
+}
+
+void TraCICommandInterface::Trafficlight::queueSetProgram(std::string program, CommandCallback onResult)
+{
+    traci->queueCommand(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_PROGRAM) << trafficLightId << static_cast<uint8_t>(TYPE_STRING) << program, std::move(onResult));
 }
 
 void TraCICommandInterface::Trafficlight::setPhaseIndex(int32_t index)
 {
-    TraCIBuffer buf = connection->query(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_PHASE_INDEX) << trafficLightId << static_cast<uint8_t>(TYPE_INTEGER) << index);
-    ASSERT(buf.eof());
+    queueSetPhaseIndex(index);
+    traci->flushQueries();
+}
+
+void TraCICommandInterface::Trafficlight::queueSetPhaseIndex(int32_t index, CommandCallback onResult)
+{
+    traci->queueCommand(CMD_SET_TL_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(TL_PHASE_INDEX) << trafficLightId << static_cast<uint8_t>(TYPE_INTEGER) << index, std::move(onResult));
 }
 
 std::list<std::string> TraCICommandInterface::getPolygonIds()
@@ -1126,6 +1228,12 @@ void TraCICommandInterface::Polygon::setShape(const std::list<Coord>& points)
 }
 
 void TraCICommandInterface::addPolygon(std::string polyId, std::string polyType, const TraCIColor& color, bool filled, int32_t layer, const std::list<Coord>& points)
+{
+    queueAddPolygon(polyId, polyType, color, filled, layer, points);
+    connection.flushQueries();
+}
+
+void TraCICommandInterface::queueAddPolygon(std::string polyId, std::string polyType, const TraCIColor& color, bool filled, int32_t layer, const std::list<Coord>& points, CommandCallback onResult)
 {
     TraCIBuffer p;
 
@@ -1142,19 +1250,23 @@ void TraCICommandInterface::addPolygon(std::string polyId, std::string polyType,
         p << static_cast<double>(pos.x) << static_cast<double>(pos.y);
     }
 
-    TraCIBuffer buf = connection.query(CMD_SET_POLYGON_VARIABLE, p);
-    ASSERT(buf.eof());
+    queueCommand(CMD_SET_POLYGON_VARIABLE, p, std::move(onResult));
 }
 
 void TraCICommandInterface::Polygon::remove(int32_t layer)
+{
+    queueRemove(layer);
+    connection->flushQueries();
+}
+
+void TraCICommandInterface::Polygon::queueRemove(int32_t layer, CommandCallback onResult)
 {
     TraCIBuffer p;
 
     p << static_cast<uint8_t>(REMOVE) << polyId;
     p << static_cast<uint8_t>(TYPE_INTEGER) << layer;
 
-    TraCIBuffer buf = connection->query(CMD_SET_POLYGON_VARIABLE, p);
-    ASSERT(buf.eof());
+    traci->queueCommand(CMD_SET_POLYGON_VARIABLE, p, std::move(onResult));
 }
 
 std::list<std::string> TraCICommandInterface::getPoiIds()
@@ -1162,7 +1274,13 @@ std::list<std::string> TraCICommandInterface::getPoiIds()
     return genericGetStringList(CMD_GET_POI_VARIABLE, "", ID_LIST, RESPONSE_GET_POI_VARIABLE);
 }
 
-void TraCICommandInterface::addPoi(std::string poiId, std::string poiType, const TraCIColor& color, int32_t layer, const Coord& pos_, std::string imgFile, double width, double height, double angle, std::string icon)
+void TraCICommandInterface::addPoi(std::string poiId, std::string poiType, const TraCIColor& color, int32_t layer, const Coord& pos, std::string imgFile, double width, double height, double angle, std::string icon)
+{
+    queueAddPoi(poiId, poiType, color, layer, pos, imgFile, width, height, angle, icon);
+    connection.flushQueries();
+}
+
+void TraCICommandInterface::queueAddPoi(std::string poiId, std::string poiType, const TraCIColor& color, int32_t layer, const Coord& pos_, std::string imgFile, double width, double height, double angle, std::string icon, CommandCallback onResult)
 {
     TraCIBuffer p;
 
@@ -1183,8 +1301,7 @@ void TraCICommandInterface::addPoi(std::string poiId, std::string poiType, const
     p << static_cast<uint8_t>(TYPE_DOUBLE) << angle;
     p << static_cast<uint8_t>(TYPE_STRING) << icon;
 
-    TraCIBuffer buf = connection.query(CMD_SET_POI_VARIABLE, p);
-    ASSERT(buf.eof());
+    queueCommand(CMD_SET_POI_VARIABLE, p, std::move(onResult));
 }
 
 Coord TraCICommandInterface::Poi::getPosition()
@@ -1193,14 +1310,19 @@ Coord TraCICommandInterface::Poi::getPosition()
 }
 
 void TraCICommandInterface::Poi::remove(int32_t layer)
+{
+    queueRemove(layer);
+    connection->flushQueries();
+}
+
+void TraCICommandInterface::Poi::queueRemove(int32_t layer, CommandCallback onResult)
 {
     TraCIBuffer p;
 
     p << static_cast<uint8_t>(REMOVE) << poiId;
     p << static_cast<uint8_t>(TYPE_INTEGER) << layer;
 
-    TraCIBuffer buf = connection->query(CMD_SET_POI_VARIABLE, p);
-    ASSERT(buf.eof());
+    traci->queueCommand(CMD_SET_POI_VARIABLE, p, std::move(onResult));
 }
 
 std::list<std::string> TraCICommandInterface::getLaneIds()
@@ -1211,9 +1333,7 @@ std::list<std::string> TraCICommandInterface::getLaneIds()
 std::list<TraCICommandInterface::Lane::Link> TraCICommandInterface::Lane::getLinks()
 {
     uint8_t variableId = LANE_LINKS;
-    TraCIBuffer buf;
-    buf << variableId << laneId;
-    TraCIBuffer obuf = connection->query(CMD_GET_LANE_VARIABLE, buf);
+    TraCIBuffer obuf = traci->queryVariable(CMD_GET_LANE_VARIABLE, laneId, variableId, nullptr);
 
     uint8_t cmdLength;
     obuf >> cmdLength;
@@ -1279,6 +1399,11 @@ std::list<Coord> TraCICommandInterface::Lane::getShape()
     return traci->genericGetCoordList(CMD_GET_LANE_VARIABLE, laneId, VAR_SHAPE, RESPONSE_GET_LANE_VARIABLE);
 }
 
+void TraCICommandInterface::Lane::getShape(std::vector<Coord>& shape)
+{
+    traci->genericGetCoordVector(CMD_GET_LANE_VARIABLE, laneId, VAR_SHAPE, RESPONSE_GET_LANE_VARIABLE, shape);
+}
+
 std::string TraCICommandInterface::Lane::getRoadId()
 {
     return traci->genericGetString(CMD_GET_LANE_VARIABLE, laneId, LANE_EDGE_ID, RESPONSE_GET_LANE_VARIABLE);
@@ -1312,6 +1437,7 @@ void TraCICommandInterface::Lane::setDisallowed(std::list<std::string> disallowe
     buf << variableId << laneId << variableType << disallowedClasses;
     TraCIBuffer obuf = connection->query(CMD_SET_LANE_VARIABLE, buf);
     ASSERT(obuf.eof());
+    traci->invalidateStaticQueries(CMD_GET_LANE_VARIABLE, laneId);
 }
 
 std::list<std::string> TraCICommandInterface::Lane::getAllowed() const
@@ -1331,6 +1457,11 @@ std::list<std::string> TraCICommandInterface::Lane::getChangePermissions(int8_t
     return traci->genericGetStringList(CMD_GET_LANE_VARIABLE, laneId, LANE_CHANGES, RESPONSE_GET_LANE_VARIABLE, nullptr, &buf2);
 }
 
+std::list<std::string> TraCICommandInterface::getInductionLoopIds()
+{
+    return genericGetStringList(CMD_GET_INDUCTIONLOOP_VARIABLE, "", ID_LIST, RESPONSE_GET_INDUCTIONLOOP_VARIABLE);
+}
+
 std::list<std::string> TraCICommandInterface::getLaneAreaDetectorIds()
 {
     return genericGetStringList(CMD_GET_LANEAREA_VARIABLE, "", ID_LIST, RESPONSE_GET_LANEAREA_VARIABLE);
@@ -1356,20 +1487,280 @@ std::list<Coord> TraCICommandInterface::Junction::getShape()
     return traci->genericGetCoordList(CMD_GET_JUNCTION_VARIABLE, junctionId, VAR_SHAPE, RESPONSE_GET_JUNCTION_VARIABLE);
 }
 
-bool TraCICommandInterface::addVehicle(std::string vehicleId, std::string vehicleTypeId, std::string routeId, simtime_t emitTime_st, double emitPosition, double emitSpeed, int8_t emitLane)
+TraCIBuffer TraCICommandInterface::makeAddVehicleRequest(std::string vehicleId, std::string vehicleTypeId, std::string routeId, simtime_t emitTime_st, double emitPosition, double emitSpeed, int8_t emitLane)
 {
-    TraCIConnection::Result result;
-
     uint8_t variableId = ADD;
     uint8_t variableType = TYPE_COMPOUND;
     int32_t count = 6;
     int32_t emitTime = (emitTime_st < 0) ? round(emitTime_st.dbl()) : (floor(emitTime_st.dbl() * 1000));
-    TraCIBuffer buf = connection.query(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer() << variableId << vehicleId << variableType << count << (uint8_t) TYPE_STRING << vehicleTypeId << (uint8_t) TYPE_STRING << routeId << (uint8_t) TYPE_INTEGER << emitTime << (uint8_t) TYPE_DOUBLE << emitPosition << (uint8_t) TYPE_DOUBLE << emitSpeed << (uint8_t) TYPE_BYTE << emitLane, &result);
+    return TraCIBuffer() << variableId << vehicleId << variableType << count << (uint8_t) TYPE_STRING << vehicleTypeId << (uint8_t) TYPE_STRING << routeId << (uint8_t) TYPE_INTEGER << emitTime << (uint8_t) TYPE_DOUBLE << emitPosition << (uint8_t) TYPE_DOUBLE << emitSpeed << (uint8_t) TYPE_BYTE << emitLane;
+}
+
+bool TraCICommandInterface::addVehicle(std::string vehicleId, std::string vehicleTypeId, std::string routeId, simtime_t emitTime_st, double emitPosition, double emitSpeed, int8_t emitLane)
+{
+    TraCIConnection::Result result;
+
+    TraCIBuffer buf = connection.query(CMD_SET_VEHICLE_VARIABLE, makeAddVehicleRequest(vehicleId, vehicleTypeId, routeId, emitTime_st, emitPosition, emitSpeed, emitLane), &result);
     ASSERT(buf.eof());
 
     return result.success;
 }
 
+void TraCICommandInterface::queueAddVehicle(std::function<void(bool)> onResult, std::string vehicleId, std::string vehicleTypeId, std::string routeId, simtime_t emitTime_st, double emitPosition, double emitSpeed, int8_t emitLane)
+{
+    connection.queueQuery(CMD_SET_VEHICLE_VARIABLE, makeAddVehicleRequest(vehicleId, vehicleTypeId, routeId, emitTime_st, emitPosition, emitSpeed, emitLane), 0, [onResult](const TraCIConnection::Result& result, TraCIBuffer& buf) {
+        ASSERT(buf.eof());
+        if (onResult) onResult(result.success);
+    });
+}
+
+void TraCICommandInterface::queueAddVehicles(const std::vector<VehicleAddition>& vehicles, std::function<void(const std::vector<bool>&)> onResults)
+{
+    if (vehicles.empty()) {
+        if (onResults) onResults({});
+        return;
+    }
+
+    // responses arrive in order, so the last one completes the batch
+    auto results = std::make_shared<std::vector<bool>>(vehicles.size(), false);
+    for (size_t i = 0; i < vehicles.size(); ++i) {
+        const VehicleAddition& v = vehicles[i];
+        connection.queueQuery(CMD_SET_VEHICLE_VARIABLE, makeAddVehicleRequest(v.vehicleId, v.vehicleTypeId, v.routeId, v.emitTime_st, v.emitPosition, v.emitSpeed, v.emitLane), 0, [results, i, onResults](const TraCIConnection::Result& result, TraCIBuffer& buf) {
+            ASSERT(buf.eof());
+            (*results)[i] = result.success;
+            if (onResults && (i == results->size() - 1)) onResults(*results);
+        });
+    }
+}
+
+std::vector<bool> TraCICommandInterface::addVehicles(const std::vector<VehicleAddition>& vehicles)
+{
+    std::vector<bool> results;
+    queueAddVehicles(vehicles, [&results](const std::vector<bool>& r) {
+        results = r;
+    });
+    connection.flushQueries();
+    return results;
+}
+
+void TraCICommandInterface::flushQueries()
+{
+    connection.flushQueries();
+}
+
+void TraCICommandInterface::getVehicleDoubles(const std::vector<std::string>& vehicleIds, const std::vector<uint8_t>& variableIds, std::vector<double>& results)
+{
+    results.resize(vehicleIds.size() * variableIds.size());
+    double* row = results.data();
+    for (const auto& vehicleId : vehicleIds) {
+        for (auto variableId : variableIds) {
+            queueGenericGetDouble(CMD_GET_VEHICLE_VARIABLE, vehicleId, variableId, RESPONSE_GET_VEHICLE_VARIABLE, [row](double value) { *row = value; });
+            ++row;
+        }
+    }
+    connection.flushQueries();
+}
+
+void TraCICommandInterface::getVehicleStrings(const std::vector<std::string>& vehicleIds, const std::vector<uint8_t>& variableIds, std::vector<std::string>& results)
+{
+    results.resize(vehicleIds.size() * variableIds.size());
+    std::string* row = results.data();
+    for (const auto& vehicleId : vehicleIds) {
+        for (auto variableId : variableIds) {
+            queueGenericGetString(CMD_GET_VEHICLE_VARIABLE, vehicleId, variableId, RESPONSE_GET_VEHICLE_VARIABLE, [row](std::string value) { *row = std::move(value); });
+            ++row;
+        }
+    }
+    connection.flushQueries();
+}
+
+void TraCICommandInterface::setStaticQueryCaching(bool enable)
+{
+    cachingStaticQueries = enable;
+    if (!enable) staticQueryCache.clear();
+}
+
+void TraCICommandInterface::setStepQueryCaching(bool enable)
+{
+    cachingStepQueries = enable;
+    stepQueryCache.clear();
+    if (enable) {
+        connection.setCommandObserver([this](uint8_t commandId, const TraCIBuffer& buf) { invalidateStepQueries(commandId, buf); });
+    }
+    else {
+        connection.setCommandObserver(nullptr);
+    }
+}
+
+void TraCICommandInterface::prewarmStaticQueryCache()
+{
+    if (!cachingStaticQueries) return;
+
+    auto queue = [this](uint8_t commandId, const std::string& objectId, uint8_t variableId) {
+        StaticQueryKey key(commandId, objectId, variableId);
+        if (staticQueryCache.count(key)) return;
+        connection.queueQuery(commandId, TraCIBuffer() << variableId << objectId, 1, [this, key](const TraCIConnection::Result& result, TraCIBuffer& buf) {
+            // failed queries are left for the regular path (and its error handling)
+            if (result.success) staticQueryCache[key] = buf.str();
+        });
+    };
+
+    queue(CMD_GET_LANE_VARIABLE, "", ID_LIST);
+    queue(CMD_GET_EDGE_VARIABLE, "", ID_LIST);
+    queue(CMD_GET_JUNCTION_VARIABLE, "", ID_LIST);
+    connection.flushQueries();
+
+    for (const auto& laneId : getLaneIds()) {
+        queue(CMD_GET_LANE_VARIABLE, laneId, VAR_SHAPE);
+        queue(CMD_GET_LANE_VARIABLE, laneId, LANE_EDGE_ID);
+        queue(CMD_GET_LANE_VARIABLE, laneId, VAR_LENGTH);
+        queue(CMD_GET_LANE_VARIABLE, laneId, VAR_WIDTH);
+    }
+    for (const auto& junctionId : getJunctionIds()) {
+        queue(CMD_GET_JUNCTION_VARIABLE, junctionId, VAR_POSITION);
+        queue(CMD_GET_JUNCTION_VARIABLE, junctionId, VAR_SHAPE);
+    }
+    EV_DEBUG << "Prewarming static query cache with " << connection.getNumQueuedQueries() << " queries" << endl;
+    connection.flushQueries();
+}
+
+void TraCICommandInterface::prewarmStaticQueryCache(const SumoNetwork& network)
+{
+    if (!cachingStaticQueries) return;
+
+    // store the responses the TraCI server would send
+    auto store = [this](uint8_t commandId, uint8_t responseId, const std::string& objectId, uint8_t variableId, const TraCIBuffer& value) {
+        TraCIBuffer header = TraCIBuffer() << variableId << objectId;
+        staticQueryCache[StaticQueryKey(commandId, objectId, variableId)] = makeTraCICommand(responseId, TraCIBuffer(header.str() + value.str()));
+    };
+    auto shape = [](const std::vector<TraCICoord>& points) {
+        TraCIBuffer buf;
+        buf << static_cast<uint8_t>(TYPE_POLYGON);
+        buf.writeByteOrFull<uint32_t>(points.size());
+        for (const auto& point : points) {
+            buf << point.x << point.y;
+        }
+        return buf;
+    };
+
+    std::list<std::string> laneIds;
+    for (const auto& lane : network.getLanes()) {
+        laneIds.push_back(lane.id);
+        store(CMD_GET_LANE_VARIABLE, RESPONSE_GET_LANE_VARIABLE, lane.id, VAR_SHAPE, shape(lane.shape));
+        store(CMD_GET_LANE_VARIABLE, RESPONSE_GET_LANE_VARIABLE, lane.id, LANE_EDGE_ID, TraCIBuffer() << static_cast<uint8_t>(TYPE_STRING) << lane.edgeId);
+        store(CMD_GET_LANE_VARIABLE, RESPONSE_GET_LANE_VARIABLE, lane.id, VAR_LENGTH, TraCIBuffer() << static_cast<uint8_t>(TYPE_DOUBLE) << lane.length);
+        store(CMD_GET_LANE_VARIABLE, RESPONSE_GET_LANE_VARIABLE, lane.id, VAR_WIDTH, TraCIBuffer() << static_cast<uint8_t>(TYPE_DOUBLE) << lane.width);
+    }
+    store(CMD_GET_LANE_VARIABLE, RESPONSE_GET_LANE_VARIABLE, "", ID_LIST, TraCIBuffer() << static_cast<uint8_t>(TYPE_STRINGLIST) << laneIds);
+
+    std::list<std::string> edgeIds;
+    for (const auto& edge : network.getEdges()) {
+        edgeIds.push_back(edge.id);
+        store(CMD_GET_EDGE_VARIABLE, RESPONSE_GET_EDGE_VARIABLE, edge.id, VAR_NAME, TraCIBuffer() << static_cast<uint8_t>(TYPE_STRING) << edge.name);
+    }
+    store(CMD_GET_EDGE_VARIABLE, RESPONSE_GET_EDGE_VARIABLE, "", ID_LIST, TraCIBuffer() << static_cast<uint8_t>(TYPE_STRINGLIST) << edgeIds);
+
+    std::list<std::string> junctionIds;
+    for (const auto& junction : network.getJunctions()) {
+        junctionIds.push_back(junction.id);
+        store(CMD_GET_JUNCTION_VARIABLE, RESPONSE_GET_JUNCTION_VARIABLE, junction.id, VAR_POSITION, TraCIBuffer() << static_cast<uint8_t>(POSITION_2D) << junction.position.x << junction.position.y);
+        store(CMD_GET_JUNCTION_VARIABLE, RESPONSE_GET_JUNCTION_VARIABLE, junction.id, VAR_SHAPE, shape(junction.shape));
+    }
+    store(CMD_GET_JUNCTION_VARIABLE, RESPONSE_GET_JUNCTION_VARIABLE, "", ID_LIST, TraCIBuffer() << static_cast<uint8_t>(TYPE_STRINGLIST) << junctionIds);
+
+    EV_DEBUG << "Prewarmed static query cache from SUMO network file with " << laneIds.size() << " lanes, " << edgeIds.size() << " edges and " << junctionIds.size() << " junctions" << endl;
+}
+
+bool TraCICommandInterface::isStaticQuery(uint8_t commandId, uint8_t variableId)
+{
+    switch (commandId) {
+    case CMD_GET_LANE_VARIABLE:
+        return (variableId == ID_LIST) || (variableId == VAR_SHAPE) || (variableId == LANE_EDGE_ID) || (variableId == VAR_LENGTH) || (variableId == VAR_WIDTH) || (variableId == LANE_LINKS);
+    case CMD_GET_EDGE_VARIABLE:
+        return (variableId == ID_LIST) || (variableId == VAR_NAME);
+    case CMD_GET_JUNCTION_VARIABLE:
+        return (variableId == ID_LIST) || (variableId == VAR_POSITION) || (variableId == VAR_SHAPE);
+    case CMD_GET_ROUTE_VARIABLE:
+        return (variableId == ID_LIST) || (variableId == VAR_EDGES);
+    case CMD_GET_VEHICLETYPE_VARIABLE:
+        return (variableId == VAR_MAXSPEED) || (variableId == VAR_VEHICLECLASS) || (variableId == VAR_SHAPECLASS);
+    default:
+        return false;
+    }
+}
+
+TraCIBuffer TraCICommandInterface::queryVariable(uint8_t commandId, const std::string& objectId, uint8_t variableId, TraCIConnection::Result* result)
+{
+    const bool isStatic = cachingStaticQueries && isStaticQuery(commandId, variableId);
+    if (!isStatic && !cachingStepQueries) {
+        return connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    }
+
+    std::map<StaticQueryKey, std::string>& cache = isStatic ? staticQueryCache : stepQueryCache;
+    StaticQueryKey key(commandId, objectId, variableId);
+    auto cached = cache.find(key);
+    if (cached != cache.end()) {
+        if (result) {
+            result->success = true;
+            result->not_impl = false;
+            result->message = "";
+        }
+        return TraCIBuffer(cached->second);
+    }
+
+    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    if ((result != nullptr) && (!result->success)) return buf;
+    std::string response = buf.readCommand();
+    ASSERT(buf.eof());
+    cache[key] = response;
+    return TraCIBuffer(response);
+}
+
+void TraCICommandInterface::invalidateStaticQueries(uint8_t commandId, const std::string& objectId)
+{
+    auto first = staticQueryCache.lower_bound(StaticQueryKey(commandId, objectId, 0));
+    auto last = staticQueryCache.upper_bound(StaticQueryKey(commandId, objectId, UINT8_MAX));
+    staticQueryCache.erase(first, last);
+}
+
+void TraCICommandInterface::invalidateStepQueries(uint8_t commandId, const TraCIBuffer& buf)
+{
+    if (stepQueryCache.empty()) return;
+
+    switch (commandId) {
+    case CMD_SET_VEHICLE_VARIABLE:
+    case CMD_SET_LANE_VARIABLE:
+    case CMD_SET_EDGE_VARIABLE:
+    case CMD_SET_ROUTE_VARIABLE:
+    case CMD_SET_POI_VARIABLE:
+    case CMD_SET_POLYGON_VARIABLE:
+    case CMD_SET_JUNCTION_VARIABLE:
+    case CMD_SET_TL_VARIABLE:
+    case CMD_SET_PERSON_VARIABLE:
+    case CMD_SET_GUI_VARIABLE: {
+        // set commands start with the variable and the object they change, which is queried by the matching get command
+        TraCIBuffer params(buf.str());
+        params.read<uint8_t>();
+        std::string objectId = params.read<std::string>();
+        uint8_t getCommandId = commandId - (CMD_SET_VEHICLE_VARIABLE - CMD_GET_VEHICLE_VARIABLE);
+        auto first = stepQueryCache.lower_bound(StaticQueryKey(getCommandId, objectId, 0));
+        auto last = stepQueryCache.upper_bound(StaticQueryKey(getCommandId, objectId, UINT8_MAX));
+        stepQueryCache.erase(first, last);
+        return;
+    }
+    default:
+        break;
+    }
+
+    // variable gets and subscriptions change nothing
+    const bool isGet = (commandId >= CMD_GET_INDUCTIONLOOP_VARIABLE) && (commandId <= CMD_GET_PERSON_VARIABLE);
+    const bool isSubscription = ((commandId >= CMD_SUBSCRIBE_INDUCTIONLOOP_CONTEXT) && (commandId <= CMD_SUBSCRIBE_PERSON_CONTEXT)) || ((commandId >= CMD_SUBSCRIBE_INDUCTIONLOOP_VARIABLE) && (commandId <= CMD_SUBSCRIBE_PERSON_VARIABLE));
+    if (isGet || isSubscription) return;
+
+    // simulation steps and everything else (changes of vehicle types or of the simulation, loading a state, ...) may change anything
+    stepQueryCache.clear();
+}
+
 bool TraCICommandInterface::Vehicle::changeVehicleRoute(const std::list<std::string>& edges)
 {
     if (getRoadId().find(':') != std::string::npos) return false;
@@ -1481,6 +1872,22 @@ void TraCICommandInterface::setOrder(int32_t order)
     ASSERT(buf.eof());
 }
 
+void TraCICommandInterface::saveState(const std::string& fileName)
+{
+    uint8_t variableId = CMD_SAVE_SIMSTATE;
+    uint8_t variableType = TYPE_STRING;
+    TraCIBuffer buf = connection.query(CMD_SET_SIM_VARIABLE, TraCIBuffer() << variableId << std::string("") << variableType << fileName);
+    ASSERT(buf.eof());
+}
+
+void TraCICommandInterface::loadState(const std::string& fileName)
+{
+    uint8_t variableId = CMD_LOAD_SIMSTATE;
+    uint8_t variableType = TYPE_STRING;
+    TraCIBuffer buf = connection.query(CMD_SET_SIM_VARIABLE, TraCIBuffer() << variableId << std::string("") << variableType << fileName);
+    ASSERT(buf.eof());
+}
+
 std::tuple<std::string, double, uint8_t> TraCICommandInterface::getRoadMapPos(const Coord& coord)
 {
     TraCIBuffer request;
@@ -1605,9 +2012,16 @@ void TraCICommandInterface::GuiView::setBoundary(Coord p1_, Coord p2_)
 }
 
 void TraCICommandInterface::GuiView::takeScreenshot(std::string filename, int32_t width, int32_t height)
+{
+    queueTakeScreenshot(filename, width, height);
+    traci->flushQueries();
+}
+
+void TraCICommandInterface::GuiView::queueTakeScreenshot(std::string filename, int32_t width, int32_t height, CommandCallback onResult)
 {
     if (traci->ignoreGuiCommands) {
         EV_DEBUG << "Ignoring TraCI GUI command (as instructed by ignoreGuiCommands)" << std::endl;
+        if (onResult) onResult(true, "");
         return;
     }
     if (filename == "") {
@@ -1633,13 +2047,11 @@ void TraCICommandInterface::GuiView::takeScreenshot(std::string filename, int32_
         uint8_t filenameType = TYPE_STRING;
         uint8_t widthType = TYPE_INTEGER;
         uint8_t heightType = TYPE_INTEGER;
-        TraCIBuffer buf = connection->query(CMD_SET_GUI_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(VAR_SCREENSHOT) << viewId << variableType << count << filenameType << filename << widthType << width << heightType << height);
-        ASSERT(buf.eof());
+        traci->queueCommand(CMD_SET_GUI_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(VAR_SCREENSHOT) << viewId << variableType << count << filenameType << filename << widthType << width << heightType << height, std::move(onResult));
     }
     else if (apiVersion == 15 || apiVersion == 16 || apiVersion == 17) {
         uint8_t filenameType = TYPE_STRING;
-        TraCIBuffer buf = connection->query(CMD_SET_GUI_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(VAR_SCREENSHOT) << viewId << filenameType << filename);
-        ASSERT(buf.eof());
+        traci->queueCommand(CMD_SET_GUI_VARIABLE, TraCIBuffer() << static_cast<uint8_t>(VAR_SCREENSHOT) << viewId << filenameType << filename, std::move(onResult));
     }
     else {
         throw cRuntimeError("Invalid API version used, check your code.");
@@ -1658,15 +2070,29 @@ void TraCICommandInterface::GuiView::trackVehicle(std::string vehicleId)
 
 std::string TraCICommandInterface::genericGetString(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result)
 {
-    uint8_t resultTypeId = TYPE_STRING;
-    std::string res;
-
-    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    TraCIBuffer buf = queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
-        return res;
+        return std::string();
     }
 
+    return readGenericString(buf, objectId, variableId, responseId);
+}
+
+void TraCICommandInterface::queueGenericGetString(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::function<void(std::string)> onResult)
+{
+    connection.queueQuery(commandId, TraCIBuffer() << variableId << objectId, 1, [objectId, variableId, responseId, onResult](const TraCIConnection::Result& result, TraCIBuffer& buf) {
+        if (!result.success) throw cRuntimeError("TraCI server reported error querying variable 0x%2x of \"%s\" (\"%s\").", variableId, objectId.c_str(), result.message.c_str());
+        std::string res = readGenericString(buf, objectId, variableId, responseId);
+        if (onResult) onResult(std::move(res));
+    });
+}
+
+std::string TraCICommandInterface::readGenericString(TraCIBuffer& buf, const std::string& objectId, uint8_t variableId, uint8_t responseId)
+{
+    uint8_t resultTypeId = TYPE_STRING;
+    std::string res;
+
     uint8_t cmdLength;
     buf >> cmdLength;
     if (cmdLength == 0) {
@@ -1699,7 +2125,7 @@ Coord TraCICommandInterface::genericGetCoord(uint8_t commandId, std::string obje
     double x;
     double y;
 
-    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    TraCIBuffer buf = queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
         return Coord();
@@ -1733,16 +2159,29 @@ Coord TraCICommandInterface::genericGetCoord(uint8_t commandId, std::string obje
 
 double TraCICommandInterface::genericGetDouble(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result)
 {
-
-    uint8_t resultTypeId = TYPE_DOUBLE;
-    double res;
-
-    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    TraCIBuffer buf = queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
         return 0;
     }
 
+    return readGenericDouble(buf, objectId, variableId, responseId);
+}
+
+void TraCICommandInterface::queueGenericGetDouble(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::function<void(double)> onResult)
+{
+    connection.queueQuery(commandId, TraCIBuffer() << variableId << objectId, 1, [objectId, variableId, responseId, onResult](const TraCIConnection::Result& result, TraCIBuffer& buf) {
+        if (!result.success) throw cRuntimeError("TraCI server reported error querying variable 0x%2x of \"%s\" (\"%s\").", variableId, objectId.c_str(), result.message.c_str());
+        double res = readGenericDouble(buf, objectId, variableId, responseId);
+        if (onResult) onResult(res);
+    });
+}
+
+double TraCICommandInterface::readGenericDouble(TraCIBuffer& buf, const std::string& objectId, uint8_t variableId, uint8_t responseId)
+{
+    uint8_t resultTypeId = TYPE_DOUBLE;
+    double res;
+
     uint8_t cmdLength;
     buf >> cmdLength;
     if (cmdLength == 0) {
@@ -1768,6 +2207,18 @@ double TraCICommandInterface::genericGetDouble(uint8_t commandId, std::string ob
     return res;
 }
 
+void TraCICommandInterface::queueCommand(uint8_t commandId, const TraCIBuffer& buf, CommandCallback onResult)
+{
+    if (!onResult) {
+        connection.queueQuery(commandId, buf, 0);
+        return;
+    }
+    connection.queueQuery(commandId, buf, 0, [onResult](const TraCIConnection::Result& result, TraCIBuffer& response) {
+        ASSERT(response.eof());
+        onResult(result.success, result.message);
+    });
+}
+
 void TraCICommandInterface::genericSetDouble(uint8_t commandId, std::string objectId, uint8_t variableId, double value)
 {
     uint8_t variableType = TYPE_DOUBLE;
@@ -1780,7 +2231,7 @@ simtime_t TraCICommandInterface::genericGetTime(uint8_t commandId, std::string o
     uint8_t resultTypeId = getTimeType();
     simtime_t res;
 
-    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    TraCIBuffer buf = queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
         return res;
@@ -1817,7 +2268,7 @@ uint8_t TraCICommandInterface::genericGetUnsignedByte(uint8_t commandId, std::st
     uint8_t resultTypeId = TYPE_UBYTE;
     int8_t res;
 
-    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    TraCIBuffer buf = queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
         return 0;
@@ -1854,7 +2305,7 @@ int32_t TraCICommandInterface::genericGetInt(uint8_t commandId, std::string obje
     uint8_t resultTypeId = TYPE_INTEGER;
     int32_t res;
 
-    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    TraCIBuffer buf = queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
         return 0;
@@ -1886,9 +2337,16 @@ int32_t TraCICommandInterface::genericGetInt(uint8_t commandId, std::string obje
 }
 
 std::list<std::string> TraCICommandInterface::genericGetStringList(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result, const TraCIBuffer* buf3)
+{
+    std::vector<std::string> res;
+    genericGetStringVector(commandId, objectId, variableId, responseId, res, result, buf3);
+    return std::list<std::string>(std::make_move_iterator(res.begin()), std::make_move_iterator(res.end()));
+}
+
+void TraCICommandInterface::genericGetStringVector(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::vector<std::string>& res, TraCIConnection::Result* result, const TraCIBuffer* buf3)
 {
     uint8_t resultTypeId = TYPE_STRINGLIST;
-    std::list<std::string> res;
+    res.clear();
 
     TraCIBuffer buf2 = TraCIBuffer() << variableId << objectId;
 
@@ -1898,10 +2356,10 @@ std::list<std::string> TraCICommandInterface::genericGetStringList(uint8_t comma
         buf2 = TraCIBuffer(buf2_str + buf3_str);
     }
 
-    TraCIBuffer buf = connection.query(commandId, buf2, result);
+    TraCIBuffer buf = buf3 ? connection.query(commandId, buf2, result) : queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
-        return res;
+        return;
     }
 
     uint8_t cmdLength;
@@ -1924,27 +2382,31 @@ std::list<std::string> TraCICommandInterface::genericGetStringList(uint8_t comma
     ASSERT(resType_r == resultTypeId);
     uint32_t count;
     buf >> count;
-    for (uint32_t i = 0; i < count; i++) {
-        std::string id;
-        buf >> id;
-        res.push_back(id);
+    res.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        res.emplace_back(buf.read<std::string>());
     }
 
     ASSERT(buf.eof());
-
-    return res;
 }
 
 std::list<Coord> TraCICommandInterface::genericGetCoordList(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result)
+{
+    std::vector<Coord> res;
+    genericGetCoordVector(commandId, objectId, variableId, responseId, res, result);
+    return std::list<Coord>(res.begin(), res.end());
+}
+
+void TraCICommandInterface::genericGetCoordVector(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::vector<Coord>& res, TraCIConnection::Result* result)
 {
 
     uint8_t resultTypeId = TYPE_POLYGON;
-    std::list<Coord> res;
+    res.clear();
 
-    TraCIBuffer buf = connection.query(commandId, TraCIBuffer() << variableId << objectId, result);
+    TraCIBuffer buf = queryVariable(commandId, objectId, variableId, result);
 
     if ((result != nullptr) && (!result->success)) {
-        return res;
+        return;
     }
 
     uint8_t cmdLength;
@@ -1966,17 +2428,12 @@ std::list<Coord> TraCICommandInterface::genericGetCoordList(uint8_t commandId, s
     buf >> resType_r;
     ASSERT(resType_r == resultTypeId);
     uint32_t count = buf.readByteOrFull<uint32_t>();
-    for (uint32_t i = 0; i < count; i++) {
-        double x;
-        buf >> x;
-        double y;
-        buf >> y;
-        res.push_back(connection.traci2omnet(TraCICoord(x, y)));
-    }
+    std::vector<double> xy(2 * count);
+    buf.readArray(xy.data(), xy.size());
+    res.resize(count);
+    connection.traci2omnet(xy.data(), count, res.data());
 
     ASSERT(buf.eof());
-
-    return res;
 }
 
 std::string TraCICommandInterface::Vehicle::getVType()
@@ -22,14 +22,19 @@
 
 #pragma once
 
+#include <functional>
 #include <list>
+#include <map>
 #include <string>
+#include <tuple>
+#include <vector>
 #include <stdint.h>
 
 #include "veins/modules/mobility/traci/TraCIColor.h"
 #include "veins/base/utils/Coord.h"
 #include "veins/modules/mobility/traci/TraCICoord.h"
 #include "veins/modules/mobility/traci/TraCIConnection.h"
+#include "veins/modules/mobility/traci/SumoNetwork.h"
 #include "veins/modules/world/traci/trafficLight/TraCITrafficLightProgram.h"
 #include "veins/modules/utility/HasLogProxy.h"
 
@@ -38,6 +43,15 @@ namespace veins {
 class VEINS_API TraCICommandInterface : public HasLogProxy {
 public:
     TraCICommandInterface(cComponent* owner, TraCIConnection& c, bool ignoreGuiCommands);
+    ~TraCICommandInterface();
+
+    /**
+     * @brief Called with the outcome of a queued command (and, if it failed, the message of the TraCI server).
+     *
+     * Queued commands are sent along with the next TraCI query (typically the next simulation step), so callers do not wait for the
+     * TraCI server. If no callback is given, a failed command raises an error once its response has been received.
+     */
+    using CommandCallback = std::function<void(bool success, const std::string& message)>;
     bool isIgnoringGuiCommands();
 
     enum DepartTime {
@@ -72,6 +86,8 @@ public:
     void setApiVersion(uint32_t apiVersion);
     std::pair<double, double> getLonLat(const Coord&);
     void setOrder(int32_t order);
+    void saveState(const std::string& fileName); /**< has the TraCI server save the complete simulation state (e.g., vehicles and their routes) to fileName */
+    void loadState(const std::string& fileName); /**< has the TraCI server replace its simulation state with the one saved to fileName, including the simulation time */
 
     unsigned getApiVersion() const
     {
@@ -140,6 +156,107 @@ public:
      * @return Success indication
      */
     bool addVehicle(std::string vehicleId, std::string vehicleTypeId, std::string routeId, simtime_t emitTime_st = 0, double emitPosition = DEPART_POSITION_BASE, double emitSpeed = DEPART_SPEED_MAX, int8_t emitLane = DEPART_LANE_BEST);
+
+    /**
+     * @brief Queues adding a vehicle to the simulation, see addVehicle().
+     *
+     * The command is sent along with the next TraCI query (typically the next simulation step), saving a round trip.
+     *
+     * @param onResult Called with the success indication once the response has been received. May be empty.
+     */
+    void queueAddVehicle(std::function<void(bool)> onResult, std::string vehicleId, std::string vehicleTypeId, std::string routeId, simtime_t emitTime_st = 0, double emitPosition = DEPART_POSITION_BASE, double emitSpeed = DEPART_SPEED_MAX, int8_t emitLane = DEPART_LANE_BEST);
+
+    /**
+     * @brief Parameters of one vehicle to add, see addVehicle().
+     */
+    struct VehicleAddition {
+        std::string vehicleId;
+        std::string vehicleTypeId;
+        std::string routeId;
+        simtime_t emitTime_st = 0;
+        double emitPosition = DEPART_POSITION_BASE;
+        double emitSpeed = DEPART_SPEED_MAX;
+        int8_t emitLane = DEPART_LANE_BEST;
+    };
+
+    /**
+     * @brief Queues adding many vehicles to the simulation, see queueAddVehicle().
+     *
+     * All commands go out in the same TraCI message.
+     *
+     * @param onResults Called once all responses have been received, with the success indication of each vehicle (in order). May be empty.
+     */
+    void queueAddVehicles(const std::vector<VehicleAddition>& vehicles, std::function<void(const std::vector<bool>&)> onResults);
+
+    /**
+     * @brief Adds many vehicles to the simulation in a single round trip, see addVehicle().
+     *
+     * @return Success indication of each vehicle, in order
+     */
+    std::vector<bool> addVehicles(const std::vector<VehicleAddition>& vehicles);
+
+    /**
+     * @brief Sends all queued commands in a single TraCI message, see TraCIConnection::queueQuery().
+     */
+    void flushQueries();
+
+    /**
+     * @brief Queries double-valued variables (e.g., VAR_SPEED, VAR_ANGLE) of many vehicles in a single round trip.
+     *
+     * Fills results with one row of variableIds.size() values per vehicle, in the order of vehicleIds.
+     * The capacity of results is kept, so passing the same buffer again avoids reallocating it.
+     */
+    void getVehicleDoubles(const std::vector<std::string>& vehicleIds, const std::vector<uint8_t>& variableIds, std::vector<double>& results);
+
+    /**
+     * @brief Queries string-valued variables (e.g., VAR_ROAD_ID, VAR_LANE_ID, VAR_ROUTE_ID) of many vehicles in a single round trip, see getVehicleDoubles().
+     */
+    void getVehicleStrings(const std::vector<std::string>& vehicleIds, const std::vector<uint8_t>& variableIds, std::vector<std::string>& results);
+
+    /**
+     * @brief Enables or disables (and clears) the cache for queries of static network data.
+     *
+     * When enabled, queries that return data that does not change during a run (e.g., lane and junction shapes,
+     * lane and route ids, edge names or vehicle classes of vehicle types) are only sent to the TraCI server once.
+     * Commands of this interface that change such data (e.g., Lane::setDisallowed()) invalidate the affected entries.
+     */
+    void setStaticQueryCaching(bool enable);
+
+    /**
+     * @brief Returns whether queries of static network data are cached, see setStaticQueryCaching().
+     */
+    bool isCachingStaticQueries() const
+    {
+        return cachingStaticQueries;
+    }
+
+    /**
+     * @brief Enables or disables (and clears) the cache for queries of dynamic data within one simulation step.
+     *
+     * When enabled, repeated queries of the same variable of the same object (e.g., Vehicle::getLaneId() or Vehicle::getRouteId())
+     * are only sent to the TraCI server once per simulation step. The cache is cleared whenever a simulation step (or any other command
+     * that is not a variable get, set or subscription command) is sent; a set command only drops the cached responses of its object
+     * (and of all objects, for vehicle types and the simulation).
+     */
+    void setStepQueryCaching(bool enable);
+
+    /**
+     * @brief Returns whether queries of dynamic data are cached within one simulation step, see setStepQueryCaching().
+     */
+    bool isCachingStepQueries() const
+    {
+        return cachingStepQueries;
+    }
+
+    /**
+     * @brief Fills the static query cache with the ids, shapes and sizes of all lanes, edges and junctions, fetched in a single round trip.
+     */
+    void prewarmStaticQueryCache();
+
+    /**
+     * @brief Fills the static query cache with the ids, shapes and sizes of all lanes, edges and junctions of a SUMO network file, without any round trip.
+     */
+    void prewarmStaticQueryCache(const SumoNetwork& network);
     class VEINS_API Vehicle {
     public:
         Vehicle(TraCICommandInterface* traci, std::string nodeId)
@@ -151,19 +268,35 @@ public:
 
         void setSpeedMode(int32_t bitset);
         void setSpeed(double speed);
+        /**
+         * @brief Queues setSpeed(), see CommandCallback.
+         */
+        void queueSetSpeed(double speed, CommandCallback onResult = nullptr);
         void setMaxSpeed(double speed);
         TraCIColor getColor();
         void setColor(const TraCIColor& color);
         void slowDown(double speed, simtime_t time);
         void newRoute(std::string roadId);
         void setParking();
+        /**
+         * @brief Removes the vehicle from the simulation (reported as arrived in the next time step).
+         */
+        void remove();
         std::string getRoadId();
         std::string getLaneId();
         double getMaxSpeed();
         double getLanePosition();
         std::list<std::string> getPlannedRoadIds();
+        /**
+         * @brief Like getPlannedRoadIds(), but fills a caller-owned buffer.
+         */
+        void getPlannedRoadIds(std::vector<std::string>& roadIds);
         std::string getRouteId();
         void changeRoute(std::string roadId, simtime_t travelTime);
+        /**
+         * @brief Queues changeRoute(), see CommandCallback.
+         */
+        void queueChangeRoute(std::string roadId, simtime_t travelTime, CommandCallback onResult = nullptr);
         void stopAt(std::string roadId, double pos, uint8_t laneid, double radius, simtime_t waittime);
         int32_t getLaneIndex();
         std::string getTypeId();
@@ -173,6 +306,19 @@ public:
         double getHeight();
         double getAccel();
         double getDeccel();
+
+        /**
+         * @brief Queues a query of the vehicle's speed, calling onResult with the value once the response has been received.
+         */
+        void queueGetSpeed(std::function<void(double)> onResult);
+        /**
+         * @brief Queues a query of the vehicle's length, height and width, calling onResult with all three once the responses have been received.
+         */
+        void queueGetDimensions(std::function<void(double length, double height, double width)> onResult);
+        /**
+         * @brief Queues a query of the vehicle's type, calling onResult with it once the response has been received.
+         */
+        void queueGetTypeId(std::function<void(std::string)> onResult);
         double getSpeed();
         double getAngle();
         double getAcceleration();
@@ -304,6 +450,7 @@ public:
     {
         return Vehicle(this, nodeId);
     }
+    std::list<std::string> getVehicleIds();
 
     // Road methods
     std::list<std::string> getRoadIds();
@@ -354,6 +501,10 @@ public:
 
         std::list<Link> getLinks();
         std::list<Coord> getShape();
+        /**
+         * @brief Like getShape(), but fills a caller-owned buffer.
+         */
+        void getShape(std::vector<Coord>& shape);
         std::string getRoadId();
         double getLength();
         double getMaxSpeed();
@@ -411,6 +562,10 @@ public:
         void setPhaseIndex(int32_t index); /**< set/switch to different phase within the program  */
         void setState(std::string state);
         void setPhaseDuration(simtime_t duration); /**< set remaining duration of current phase */
+        void queueSetProgram(std::string program, CommandCallback onResult = nullptr); /**< queues setProgram(), see CommandCallback */
+        void queueSetPhaseIndex(int32_t index, CommandCallback onResult = nullptr); /**< queues setPhaseIndex(), see CommandCallback */
+        void queueSetState(std::string state, CommandCallback onResult = nullptr); /**< queues setState(), see CommandCallback */
+        void queueSetPhaseDuration(simtime_t duration, CommandCallback onResult = nullptr); /**< queues setPhaseDuration(), see CommandCallback */
         void setProgramDefinition(TraCITrafficLightProgram::Logic program, int32_t programNr);
 
     protected:
@@ -423,6 +578,9 @@ public:
         return Trafficlight(this, trafficLightId);
     }
 
+    // InductionLoop methods
+    std::list<std::string> getInductionLoopIds();
+
     // LaneAreaDetector methods
     std::list<std::string> getLaneAreaDetectorIds();
     class VEINS_API LaneAreaDetector {
@@ -449,6 +607,7 @@ public:
     // Polygon methods
     std::list<std::string> getPolygonIds();
     void addPolygon(std::string polyId, std::string polyType, const TraCIColor& color, bool filled, int32_t layer, const std::list<Coord>& points);
+    void queueAddPolygon(std::string polyId, std::string polyType, const TraCIColor& color, bool filled, int32_t layer, const std::list<Coord>& points, CommandCallback onResult = nullptr); /**< queues addPolygon(), see CommandCallback */
     class VEINS_API Polygon {
     public:
         Polygon(TraCICommandInterface* traci, std::string polyId)
@@ -465,6 +624,7 @@ public:
         double getLineWidth();
         void setShape(const std::list<Coord>& points);
         void remove(int32_t layer);
+        void queueRemove(int32_t layer, CommandCallback onResult = nullptr); /**< queues remove(), see CommandCallback */
 
     protected:
         TraCICommandInterface* traci;
@@ -479,6 +639,7 @@ public:
     // Poi methods
     std::list<std::string> getPoiIds();
     void addPoi(std::string poiId, std::string poiType, const TraCIColor& color, int32_t layer, const Coord& pos, std::string imgFile = "", double width = 1, double height = 1, double angle = 0, std::string icon = "");
+    void queueAddPoi(std::string poiId, std::string poiType, const TraCIColor& color, int32_t layer, const Coord& pos, std::string imgFile = "", double width = 1, double height = 1, double angle = 0, std::string icon = "", CommandCallback onResult = nullptr); /**< queues addPoi(), see CommandCallback */
     class VEINS_API Poi {
     public:
         Poi(TraCICommandInterface* traci, std::string poiId)
@@ -490,6 +651,7 @@ public:
 
         Coord getPosition();
         void remove(int32_t layer);
+        void queueRemove(int32_t layer, CommandCallback onResult = nullptr); /**< queues remove(), see CommandCallback */
 
     protected:
         TraCICommandInterface* traci;
@@ -528,6 +690,7 @@ public:
     // Route methods
     std::list<std::string> getRouteIds();
     void addRoute(std::string routeId, const std::list<std::string>& edges);
+    void queueAddRoute(std::string routeId, const std::list<std::string>& edges, CommandCallback onResult = nullptr); /**< queues addRoute(), see CommandCallback */
     class VEINS_API Route {
     public:
         Route(TraCICommandInterface* traci, std::string routeId)
@@ -594,6 +757,7 @@ public:
         void setZoom(double zoom);
         void setBoundary(Coord p1, Coord p2);
         void takeScreenshot(std::string filename = "", int32_t width = -1, int32_t height = -1);
+        void queueTakeScreenshot(std::string filename = "", int32_t width = -1, int32_t height = -1, CommandCallback onResult = nullptr); /**< queues takeScreenshot(), see CommandCallback */
 
         /**
          * Track the vehicle identified by vehicleId in the Sumo GUI.
@@ -623,15 +787,37 @@ private:
     static const std::map<uint32_t, VersionConfig> versionConfigs;
     VersionConfig versionConfig;
 
+    using StaticQueryKey = std::tuple<uint8_t, std::string, uint8_t>; /**< command id, object id, variable id */
+    bool cachingStaticQueries = false;
+    std::map<StaticQueryKey, std::string> staticQueryCache; /**< response commands of static queries, see setStaticQueryCaching() */
+    bool cachingStepQueries = false;
+    std::map<StaticQueryKey, std::string> stepQueryCache; /**< response commands of all other queries in the current simulation step, see setStepQueryCaching() */
+
+    /**
+     * @brief Queries a variable, answering static queries from the cache if enabled. Returns the response command.
+     */
+    TraCIBuffer queryVariable(uint8_t commandId, const std::string& objectId, uint8_t variableId, TraCIConnection::Result* result);
+    static bool isStaticQuery(uint8_t commandId, uint8_t variableId);
+    void invalidateStaticQueries(uint8_t commandId, const std::string& objectId);
+    void invalidateStepQueries(uint8_t commandId, const TraCIBuffer& buf); /**< drops the step query cache entries a command may change, see setStepQueryCaching() */
+
     std::string genericGetString(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr);
+    void queueGenericGetString(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::function<void(std::string)> onResult);
+    static std::string readGenericString(TraCIBuffer& buf, const std::string& objectId, uint8_t variableId, uint8_t responseId);
     Coord genericGetCoord(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr);
     double genericGetDouble(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr);
+    void queueGenericGetDouble(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::function<void(double)> onResult);
+    static double readGenericDouble(TraCIBuffer& buf, const std::string& objectId, uint8_t variableId, uint8_t responseId);
+    TraCIBuffer makeAddVehicleRequest(std::string vehicleId, std::string vehicleTypeId, std::string routeId, simtime_t emitTime_st, double emitPosition, double emitSpeed, int8_t emitLane);
     void genericSetDouble(uint8_t commandId, std::string objectId, uint8_t variableId, double value);
+    void queueCommand(uint8_t commandId, const TraCIBuffer& buf, CommandCallback onResult); /**< queues a command without response commands, see CommandCallback */
     simtime_t genericGetTime(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr);
     uint8_t genericGetUnsignedByte(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr);
     int32_t genericGetInt(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr);
     std::list<std::string> genericGetStringList(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr, const TraCIBuffer* buf2 = nullptr);
     std::list<Coord> genericGetCoordList(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, TraCIConnection::Result* result = nullptr);
+    void genericGetStringVector(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::vector<std::string>& res, TraCIConnection::Result* result = nullptr, const TraCIBuffer* buf2 = nullptr); /**< like genericGetStringList(), but fills res */
+    void genericGetCoordVector(uint8_t commandId, std::string objectId, uint8_t variableId, uint8_t responseId, std::vector<Coord>& res, TraCIConnection::Result* result = nullptr); /**< like genericGetCoordList(), but fills res */
 };
 
 } // namespace veins
@@ -28,12 +28,24 @@
 #include <netinet/tcp.h>
 #include <netdb.h>
 #include <arpa/inet.h>
+#include <sys/un.h>
 #endif
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
 #include <functional>
+#include <mutex>
+#include <thread>
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
 
 #include "veins/modules/mobility/traci/TraCIConnection.h"
+#include "veins/base/utils/Profiling.h"
+#include "veins/base/utils/SpscQueue.h"
 #include "veins/modules/mobility/traci/TraCIConstants.h"
 
 using namespace veins::TraCIConstants;
@@ -54,6 +66,64 @@ struct traci2omnet_functor : public unary_function<TraCICoord, Coord> {
     const TraCIConnection& owner;
 };
 
+namespace {
+
+/**
+ * greeting exchanged with bin/veins_traci_proxy before switching to compressed framing
+ */
+const char compressionGreeting[] = "VTZ1";
+
+/**
+ * commands of a streamed response the I/O thread may receive ahead of the simulation thread
+ */
+const size_t streamQueueCapacity = 1024;
+
+} // namespace
+
+struct TraCIConnection::Compression {
+#ifdef WITH_ZLIB
+    z_stream deflater; /**< compresses what is sent */
+    z_stream inflater; /**< decompresses what is received */
+    std::string deflated; /**< scratch buffer of the frame being sent */
+    std::string compressedFrame; /**< scratch buffer of the frame being received */
+    std::string inflated; /**< decompressed bytes not yet returned by receiveStream() */
+    size_t inflatedPos = 0;
+
+    Compression()
+    {
+        memset(&deflater, 0, sizeof(deflater));
+        memset(&inflater, 0, sizeof(inflater));
+        // speed over ratio: a step of a large scenario is several MB
+        if (deflateInit(&deflater, Z_BEST_SPEED) != Z_OK) throw cRuntimeError("Could not initialize TraCI compression");
+        if (inflateInit(&inflater) != Z_OK) throw cRuntimeError("Could not initialize TraCI decompression");
+    }
+    ~Compression()
+    {
+        deflateEnd(&deflater);
+        inflateEnd(&inflater);
+    }
+#endif
+};
+
+struct TraCIConnection::Stream {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeup; /**< wakes up the I/O thread for a request (or to stop) */
+    bool requested = false;
+    std::atomic<bool> stopping{false}; /**< set by the destructor; also read by the I/O thread while it waits for room in the queue */
+    uint32_t requestedCount = 0; /**< commands the I/O thread is to receive */
+    uint32_t requestedLength = 0; /**< bytes they take up */
+    std::atomic<bool> receiving{false}; /**< whether the I/O thread is receiving (cleared once it is done, after setting error if it failed) */
+    std::exception_ptr error;
+    SpscQueue<std::string> commands{streamQueueCapacity}; /**< commands received by the I/O thread, not yet taken by the simulation thread */
+    std::vector<std::string> received; /**< commands taken from the queue by finishStreamedResponse(), not yet handed out */
+    size_t receivedPos = 0;
+    std::string spare; /**< storage traded for the commands taken from the queue */
+    uint32_t remaining = 0; /**< commands not yet handed out by nextStreamedCommand() */
+    bool fromBuffer = false; /**< whether the response was received as a whole (into buffered) before it was to be streamed */
+    TraCIBuffer buffered;
+};
+
 SOCKET socket(void* ptr)
 {
     ASSERT(ptr);
@@ -83,12 +153,61 @@ TraCIConnection::TraCIConnection(cComponent* owner, void* ptr)
 
 TraCIConnection::~TraCIConnection()
 {
+    if (stream) {
+        {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            stream->stopping.store(true, std::memory_order_release);
+        }
+        // unblock an I/O thread still waiting for the rest of a streamed response (2: both directions, SHUT_RDWR or SD_BOTH)
+        if (stream->receiving.load()) ::shutdown(socket(socketPtr), 2);
+        stream->wakeup.notify_one();
+        stream->thread.join();
+        stream.reset();
+    }
+    compression.reset();
     if (socketPtr) {
         closesocket(socket(socketPtr));
         delete static_cast<SOCKET*>(socketPtr);
     }
 }
 
+namespace {
+
+/**
+ * connects a new stream socket to address, retrying for a few seconds while the server starts up
+ */
+SOCKET* connectSocket(int family, const sockaddr* address, size_t addressLength)
+{
+    EV_STATICCONTEXT;
+
+    SOCKET* socketPtr = new SOCKET();
+    for (int tries = 1; tries <= 10; ++tries) {
+        *socketPtr = ::socket(family, SOCK_STREAM, 0);
+        if (*socketPtr == INVALID_SOCKET) throw cRuntimeError("Could not create socket to connect to TraCI server");
+        if (::connect(*socketPtr, address, addressLength) >= 0) break;
+        closesocket(socket(socketPtr));
+
+        std::stringstream ss;
+        ss << "Could not connect to TraCI server; error message: " << sock_errno() << ": " << strerror(sock_errno());
+        std::string msg = ss.str();
+
+        int sleepDuration = tries * .25 + 1;
+
+        if (tries >= 10) {
+            throw cRuntimeError("%s", msg.c_str());
+        }
+        else if (tries == 3) {
+            EV_WARN << msg << " -- Will retry in " << sleepDuration << " second(s)." << std::endl;
+        }
+
+        sleep(sleepDuration);
+    }
+
+    return socketPtr;
+}
+
+} // namespace
+
 TraCIConnection* TraCIConnection::connect(cComponent* owner, const char* host, int port)
 {
     EV_STATICCONTEXT;
@@ -96,6 +215,29 @@ TraCIConnection* TraCIConnection::connect(cComponent* owner, const char* host, i
 
     if (initsocketlibonce() != 0) throw cRuntimeError("Could not init socketlib");
 
+    const std::string zlibPrefix = "zlib:";
+    if (std::string(host).compare(0, zlibPrefix.size(), zlibPrefix) == 0) {
+        std::string proxyHost = std::string(host).substr(zlibPrefix.size());
+        std::unique_ptr<TraCIConnection> connection(connect(owner, proxyHost.c_str(), port));
+        connection->enableCompression();
+        return connection.release();
+    }
+
+    const std::string unixPrefix = "unix:";
+    if (std::string(host).compare(0, unixPrefix.size(), unixPrefix) == 0) {
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32) || defined(__CYGWIN__) || defined(_WIN64)
+        throw cRuntimeError("Unix domain sockets are not supported on this platform: %s", host);
+#else
+        std::string path = std::string(host).substr(unixPrefix.size());
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) throw cRuntimeError("Invalid TraCI server socket path: %s", path.c_str());
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        return new TraCIConnection(owner, connectSocket(AF_UNIX, (sockaddr*) &address, sizeof(address)));
+#endif
+    }
+
     in_addr addr;
     struct hostent* host_ent;
     struct in_addr saddr;
@@ -119,28 +261,7 @@ TraCIConnection* TraCIConnection::connect(cComponent* owner, const char* host, i
     address.sin_port = htons(port);
     address.sin_addr.s_addr = addr.s_addr;
 
-    SOCKET* socketPtr = new SOCKET();
-    for (int tries = 1; tries <= 10; ++tries) {
-        *socketPtr = ::socket(AF_INET, SOCK_STREAM, 0);
-        if (*socketPtr == INVALID_SOCKET) throw cRuntimeError("Could not create socket to connect to TraCI server");
-        if (::connect(*socketPtr, address_p, sizeof(address)) >= 0) break;
-        closesocket(socket(socketPtr));
-
-        std::stringstream ss;
-        ss << "Could not connect to TraCI server; error message: " << sock_errno() << ": " << strerror(sock_errno());
-        std::string msg = ss.str();
-
-        int sleepDuration = tries * .25 + 1;
-
-        if (tries >= 10) {
-            throw cRuntimeError("%s", msg.c_str());
-        }
-        else if (tries == 3) {
-            EV_WARN << msg << " -- Will retry in " << sleepDuration << " second(s)." << std::endl;
-        }
-
-        sleep(sleepDuration);
-    }
+    SOCKET* socketPtr = connectSocket(AF_INET, address_p, sizeof(address));
 
     {
         int x = 1;
@@ -150,28 +271,350 @@ TraCIConnection* TraCIConnection::connect(cComponent* owner, const char* host, i
     return new TraCIConnection(owner, socketPtr);
 }
 
+namespace {
+
+void checkStatus(uint8_t resultCode, uint8_t commandId, const std::string& description)
+{
+    if (resultCode == RTYPE_NOTIMPLEMENTED) throw cRuntimeError("TraCI server reported command 0x%2x not implemented (\"%s\"). Might need newer version.", commandId, description.c_str());
+    if (resultCode != RTYPE_OK) throw cRuntimeError("TraCI server reported status %d executing command 0x%2x (\"%s\").", (int) resultCode, commandId, description.c_str());
+}
+
+} // namespace
+
 TraCIBuffer TraCIConnection::query(uint8_t commandId, const TraCIBuffer& buf, Result* result)
 {
-    sendMessage(makeTraCICommand(commandId, buf));
+    VEINS_PROFILE_SCOPE("TraCIConnection::query");
+    checkWritable(commandId);
+    if (commandObserver) commandObserver(commandId, buf);
+    TraCIBuffer obuf = sendQueued(makeTraCICommand(commandId, buf));
 
-    TraCIBuffer obuf(receiveMessage());
-    uint8_t cmdLength;
-    obuf >> cmdLength;
-    uint8_t commandResp;
-    obuf >> commandResp;
-    ASSERT(commandResp == commandId);
-    uint8_t resultCode;
-    obuf >> resultCode;
     std::string description;
-    obuf >> description;
+    uint8_t resultCode = readStatus(obuf, commandId, description);
     if (result != nullptr) {
         result->success = (resultCode == RTYPE_OK);
         result->not_impl = (resultCode == RTYPE_NOTIMPLEMENTED);
         result->message = description;
     }
     else {
-        if (resultCode == RTYPE_NOTIMPLEMENTED) throw cRuntimeError("TraCI server reported command 0x%2x not implemented (\"%s\"). Might need newer version.", commandId, description.c_str());
-        if (resultCode != RTYPE_OK) throw cRuntimeError("TraCI server reported status %d executing command 0x%2x (\"%s\").", (int) resultCode, commandId, description.c_str());
+        checkStatus(resultCode, commandId, description);
+    }
+    return obuf;
+}
+
+void TraCIConnection::queueQuery(uint8_t commandId, const TraCIBuffer& buf, size_t numResponses, ResponseHandler handler)
+{
+    checkWritable(commandId);
+    if (commandObserver) commandObserver(commandId, buf);
+    queuedCommands += makeTraCICommand(commandId, buf);
+    queuedQueries.push_back({commandId, numResponses, std::move(handler)});
+}
+
+void TraCIConnection::flushQueries()
+{
+    if (queuedQueries.empty()) return;
+
+    TraCIBuffer obuf = sendQueued(std::string());
+    ASSERT(obuf.eof());
+}
+
+size_t TraCIConnection::getNumQueuedQueries() const
+{
+    return queuedQueries.size();
+}
+
+void TraCIConnection::sendPending(uint8_t commandId, const TraCIBuffer& buf)
+{
+    if (pending) throw cRuntimeError("Cannot send TraCI command %d while command %d still awaits its response", commandId, pendingCommandId);
+    checkWritable(commandId);
+    flushQueries();
+
+    if (commandObserver) commandObserver(commandId, buf);
+    sendMessage(makeTraCICommand(commandId, buf));
+    pending = true;
+    pendingReceived = false;
+    pendingCommandId = commandId;
+}
+
+TraCIBuffer TraCIConnection::receivePending()
+{
+    if (!pending) throw cRuntimeError("No TraCI command awaits its response");
+
+    TraCIBuffer obuf(pendingReceived ? pendingResponse : receiveMessage());
+    pending = false;
+    pendingReceived = false;
+    pendingResponse.clear();
+
+    std::string description;
+    uint8_t resultCode = readStatus(obuf, pendingCommandId, description);
+    checkStatus(resultCode, pendingCommandId, description);
+    return obuf;
+}
+
+uint32_t TraCIConnection::receivePendingStreamed()
+{
+    if (!pending) throw cRuntimeError("No TraCI command awaits its response");
+
+    if (!stream) {
+        stream.reset(new Stream());
+        stream->thread = std::thread([this]() {
+            Stream& s = *stream;
+            std::unique_lock<std::mutex> lock(s.mutex);
+            while (true) {
+                s.wakeup.wait(lock, [&s]() { return s.requested || s.stopping; });
+                if (s.stopping) return;
+                s.requested = false;
+                uint32_t count = s.requestedCount;
+                uint32_t length = s.requestedLength;
+                lock.unlock();
+                try {
+                    receiveStreamedCommands(count, length);
+                }
+                catch (...) {
+                    s.error = std::current_exception();
+                }
+                s.receiving.store(false, std::memory_order_release);
+                lock.lock();
+            }
+        });
+    }
+    Stream& s = *stream;
+    if (s.remaining > 0) throw cRuntimeError("Cannot receive a streamed TraCI response while %u commands of the last one have not been handed out", s.remaining);
+    s.received.clear();
+    s.receivedPos = 0;
+    pending = false;
+
+    if (pendingReceived) {
+        // another query interrupted the pending command, so its response is here already
+        pendingReceived = false;
+        s.buffered.swap(pendingResponse);
+        pendingResponse.clear();
+        s.fromBuffer = true;
+        std::string description;
+        uint8_t resultCode = readStatus(s.buffered, pendingCommandId, description);
+        checkStatus(resultCode, pendingCommandId, description);
+        uint32_t count;
+        s.buffered >> count;
+        s.remaining = count;
+        return count;
+    }
+    s.fromBuffer = false;
+
+    // receive the head of the message (its length, the status response and the count) right here
+    if (!socketPtr) throw cRuntimeError("Not connected to TraCI server");
+    char buf2[sizeof(uint32_t)];
+    receiveStream(buf2, sizeof(uint32_t));
+    uint32_t msgLength;
+    TraCIBuffer(std::string(buf2, sizeof(uint32_t))) >> msgLength;
+    messageBytes += msgLength;
+
+    char statusLength;
+    receiveStream(&statusLength, 1);
+    std::string status(static_cast<uint8_t>(statusLength), '\0');
+    if (status.empty() || sizeof(uint32_t) + status.size() > msgLength) throw cRuntimeError("Malformed status response in TraCI message");
+    status[0] = statusLength;
+    receiveStream(&status[1], status.size() - 1);
+    uint32_t length = msgLength - sizeof(uint32_t) - status.size();
+
+    TraCIBuffer obuf;
+    obuf.swap(status);
+    std::string description;
+    uint8_t resultCode = readStatus(obuf, pendingCommandId, description);
+    if (resultCode != RTYPE_OK) {
+        std::string rest(length, '\0');
+        receiveStream(&rest[0], length);
+        checkStatus(resultCode, pendingCommandId, description);
+    }
+
+    if (length < sizeof(uint32_t)) throw cRuntimeError("TraCI response to command %d holds no count", pendingCommandId);
+    receiveStream(buf2, sizeof(uint32_t));
+    uint32_t count;
+    TraCIBuffer(std::string(buf2, sizeof(uint32_t))) >> count;
+    length -= sizeof(uint32_t);
+    s.remaining = count;
+
+    // leave the rest to the I/O thread
+    if (count > 0 || length > 0) {
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.requestedCount = count;
+            s.requestedLength = length;
+            s.requested = true;
+            s.receiving.store(true);
+        }
+        s.wakeup.notify_one();
+    }
+    return count;
+}
+
+bool TraCIConnection::nextStreamedCommand(TraCIBuffer& out)
+{
+    if (!stream || stream->remaining == 0) return false;
+    Stream& s = *stream;
+
+    if (s.fromBuffer) {
+        s.buffered.readCommand(out);
+    }
+    else if (s.receivedPos < s.received.size()) {
+        out.swap(s.received[s.receivedPos++]);
+    }
+    else {
+        while (!s.commands.tryPop(s.spare)) {
+            if (s.receiving.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+                continue;
+            }
+            // the I/O thread is done: take what it pushed last, or report why it stopped short
+            if (s.commands.tryPop(s.spare)) break;
+            finishStreamedResponse();
+            throw cRuntimeError("Streamed TraCI response ended %u commands short", s.remaining);
+        }
+        out.swap(s.spare);
+    }
+
+    // once all commands are out, the connection is free for the next message
+    if (--s.remaining == 0 && !s.fromBuffer) finishStreamedResponse();
+    return true;
+}
+
+void TraCIConnection::receiveStreamedCommands(uint32_t count, uint32_t length)
+{
+    std::string command;
+    for (uint32_t i = 0; i < count; ++i) {
+        char head[1 + sizeof(uint32_t)];
+        size_t headLength = 1;
+        receiveStream(head, headLength);
+        uint32_t cmdLength = static_cast<uint8_t>(head[0]);
+        if (cmdLength == 0) {
+            receiveStream(head + 1, sizeof(uint32_t));
+            headLength += sizeof(uint32_t);
+            TraCIBuffer(std::string(head + 1, sizeof(uint32_t))) >> cmdLength;
+        }
+        if (cmdLength < headLength || cmdLength > length) throw cRuntimeError("Malformed command in streamed TraCI response");
+
+        // reuses the storage of a command the simulation thread is done with
+        command.resize(cmdLength);
+        memcpy(&command[0], head, headLength);
+        receiveStream(&command[headLength], cmdLength - headLength);
+        length -= cmdLength;
+        while (!stream->commands.tryPush(command)) {
+            // nobody will take commands from a full queue once the connection is being destroyed
+            if (stream->stopping.load(std::memory_order_acquire)) return;
+            std::this_thread::yield();
+        }
+    }
+    if (length != 0) throw cRuntimeError("Streamed TraCI response holds %u bytes beyond its %u commands", length, count);
+}
+
+void TraCIConnection::finishStreamedResponse()
+{
+    if (!stream) return;
+    Stream& s = *stream;
+
+    while (s.receiving.load(std::memory_order_acquire) || !s.commands.empty()) {
+        std::string command;
+        if (s.commands.tryPop(command)) {
+            s.received.push_back(std::move(command));
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    if (s.error) {
+        std::exception_ptr error = s.error;
+        s.error = nullptr;
+        s.remaining = 0;
+        std::rethrow_exception(error);
+    }
+}
+
+bool TraCIConnection::hasPending() const
+{
+    return pending;
+}
+
+void TraCIConnection::setReadOnly(bool readOnly)
+{
+    this->readOnly = readOnly;
+}
+
+bool TraCIConnection::isWriteCommand(uint8_t commandId)
+{
+    // all set commands share the range of CMD_SET_TL_VARIABLE ... CMD_SET_PERSON_VARIABLE (0xc2 ... 0xce), plus reserved ids up to 0xcf
+    return commandId == CMD_LOAD || commandId == CMD_SETORDER || (commandId >= 0xc0 && commandId <= 0xcf);
+}
+
+void TraCIConnection::checkWritable(uint8_t commandId) const
+{
+    if (readOnly && isWriteCommand(commandId)) throw cRuntimeError("TraCI command 0x%x would change the state of the TraCI server, but the connection is read-only", commandId);
+}
+
+void TraCIConnection::setPendingInterruptedHandler(std::function<void()> handler)
+{
+    pendingInterruptedHandler = std::move(handler);
+}
+
+void TraCIConnection::setCommandObserver(CommandObserver observer)
+{
+    commandObserver = std::move(observer);
+}
+
+void TraCIConnection::interruptPending()
+{
+    if (!pending || pendingReceived) return;
+
+    EV_TRACE << "Receiving response to pending TraCI command " << static_cast<int>(pendingCommandId) << " ahead of another query" << endl;
+    pendingResponse = receiveMessage();
+    pendingReceived = true;
+    if (pendingInterruptedHandler) pendingInterruptedHandler();
+}
+
+uint8_t TraCIConnection::readStatus(TraCIBuffer& buf, uint8_t commandId, std::string& description) const
+{
+    uint8_t cmdLength;
+    buf >> cmdLength;
+    uint8_t commandResp;
+    buf >> commandResp;
+    ASSERT(commandResp == commandId);
+    uint8_t resultCode;
+    buf >> resultCode;
+    buf >> description;
+    return resultCode;
+}
+
+TraCIBuffer TraCIConnection::sendQueued(const std::string& trailingCommand)
+{
+    // take ownership of the batch first, so handlers can queue (or query) again
+    interruptPending();
+
+    std::vector<QueuedQuery> batch;
+    batch.swap(queuedQueries);
+    std::string commands;
+    commands.swap(queuedCommands);
+
+    if (!batch.empty()) EV_TRACE << "Sending " << batch.size() << " queued TraCI commands" << endl;
+    sendMessage(commands + trailingCommand);
+
+    TraCIBuffer obuf(receiveMessage());
+    for (auto& queued : batch) {
+        std::string description;
+        uint8_t resultCode = readStatus(obuf, queued.commandId, description);
+        std::string responses;
+        if (resultCode == RTYPE_OK) {
+            for (size_t i = 0; i < queued.numResponses; ++i) {
+                responses += obuf.readCommand();
+            }
+        }
+        if (queued.handler) {
+            Result result;
+            result.success = (resultCode == RTYPE_OK);
+            result.not_impl = (resultCode == RTYPE_NOTIMPLEMENTED);
+            result.message = description;
+            TraCIBuffer response(responses);
+            queued.handler(result, response);
+        }
+        else {
+            checkStatus(resultCode, queued.commandId, description);
+        }
     }
     return obuf;
 }
@@ -179,88 +622,169 @@ TraCIBuffer TraCIConnection::query(uint8_t commandId, const TraCIBuffer& buf, Re
 std::string TraCIConnection::receiveMessage()
 {
     if (!socketPtr) throw cRuntimeError("Not connected to TraCI server");
+    finishStreamedResponse();
 
     uint32_t msgLength;
     {
         char buf2[sizeof(uint32_t)];
-        uint32_t bytesRead = 0;
-        while (bytesRead < sizeof(uint32_t)) {
-            int receivedBytes = ::recv(socket(socketPtr), reinterpret_cast<char*>(&buf2) + bytesRead, sizeof(uint32_t) - bytesRead, 0);
-            if (receivedBytes > 0) {
-                bytesRead += receivedBytes;
-            }
-            else if (receivedBytes == 0) {
-                throw cRuntimeError("Connection to TraCI server closed unexpectedly. Check your server's log");
-            }
-            else {
-                if (sock_errno() == EINTR) continue;
-                if (sock_errno() == EAGAIN) continue;
-                throw cRuntimeError("Connection to TraCI server lost. Check your server's log. Error message: %d: %s", sock_errno(), strerror(sock_errno()));
-            }
-        }
+        receiveStream(buf2, sizeof(uint32_t));
         TraCIBuffer(std::string(buf2, sizeof(uint32_t))) >> msgLength;
     }
 
+    // receive straight into the string handed to the caller (and, typically, moved into a TraCIBuffer)
     uint32_t bufLength = msgLength - sizeof(msgLength);
-    char buf[bufLength];
-    {
-        EV_TRACE << "Reading TraCI message of " << bufLength << " bytes" << endl;
-        uint32_t bytesRead = 0;
-        while (bytesRead < bufLength) {
-            int receivedBytes = ::recv(socket(socketPtr), reinterpret_cast<char*>(&buf) + bytesRead, bufLength - bytesRead, 0);
-            if (receivedBytes > 0) {
-                bytesRead += receivedBytes;
-            }
-            else if (receivedBytes == 0) {
-                throw cRuntimeError("Connection to TraCI server closed unexpectedly. Check your server's log");
-            }
-            else {
-                if (sock_errno() == EINTR) continue;
-                if (sock_errno() == EAGAIN) continue;
-                throw cRuntimeError("Connection to TraCI server lost. Check your server's log. Error message: %d: %s", sock_errno(), strerror(sock_errno()));
-            }
-        }
-    }
-    return std::string(buf, bufLength);
+    std::string buf(bufLength, '\0');
+    EV_TRACE << "Reading TraCI message of " << bufLength << " bytes" << endl;
+    receiveStream(&buf[0], bufLength);
+    messageBytes += msgLength;
+    return buf;
 }
 
 void TraCIConnection::sendMessage(std::string buf)
 {
     if (!socketPtr) throw cRuntimeError("Not connected to TraCI server");
+    finishStreamedResponse();
 
-    {
-        uint32_t msgLength = sizeof(uint32_t) + buf.length();
-        TraCIBuffer buf2 = TraCIBuffer();
-        buf2 << msgLength;
-        uint32_t bytesWritten = 0;
-        while (bytesWritten < sizeof(uint32_t)) {
-            ssize_t sentBytes = ::send(socket(socketPtr), buf2.str().c_str() + bytesWritten, sizeof(uint32_t) - bytesWritten, 0);
-            if (sentBytes > 0) {
-                bytesWritten += sentBytes;
-            }
-            else {
-                if (sock_errno() == EINTR) continue;
-                if (sock_errno() == EAGAIN) continue;
-                throw cRuntimeError("Connection to TraCI server lost. Check your server's log. Error message: %d: %s", sock_errno(), strerror(sock_errno()));
-            }
+    uint32_t msgLength = sizeof(uint32_t) + buf.length();
+    TraCIBuffer buf2 = TraCIBuffer();
+    buf2 << msgLength;
+    sendStream(buf2.str().c_str(), sizeof(uint32_t), false);
+
+    EV_TRACE << "Writing TraCI message of " << buf.length() << " bytes" << endl;
+    sendStream(buf.c_str(), buf.length(), true);
+    messageBytes += msgLength;
+}
+
+void TraCIConnection::getTrafficStats(uint64_t& messageBytes, uint64_t& wireBytes) const
+{
+    messageBytes = this->messageBytes;
+    wireBytes = this->wireBytes;
+}
+
+void TraCIConnection::enableCompression()
+{
+#ifdef WITH_ZLIB
+    socketSend(compressionGreeting, sizeof(compressionGreeting) - 1);
+    char reply[sizeof(compressionGreeting) - 1];
+    socketReceive(reply, sizeof(reply));
+    if (memcmp(reply, compressionGreeting, sizeof(reply)) != 0) throw cRuntimeError("TraCI server did not accept compressed framing. Is it a bin/veins_traci_proxy?");
+    compression.reset(new Compression());
+    EV_INFO << "Using compressed TraCI framing" << endl;
+#else
+    throw cRuntimeError("Compressed TraCI connections need Veins to be configured --with-zlib");
+#endif
+}
+
+void TraCIConnection::sendStream(const char* data, size_t length, bool flush)
+{
+    if (!compression) {
+        socketSend(data, length);
+        return;
+    }
+#ifdef WITH_ZLIB
+    // compressed frame: 4 byte length of the compressed data, followed by the data (a flushed part of the deflate stream)
+    z_stream& z = compression->deflater;
+    std::string& deflated = compression->deflated;
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    z.avail_in = length;
+    do {
+        // deflated keeps what was compressed since the last flush
+        size_t used = deflated.size();
+        deflated.resize(used + std::max<size_t>(length / 2, 4096) + 64);
+        z.next_out = reinterpret_cast<Bytef*>(&deflated[used]);
+        z.avail_out = deflated.size() - used;
+        int status = deflate(&z, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+        if (status != Z_OK && status != Z_BUF_ERROR) throw cRuntimeError("TraCI compression failed: %d", status);
+        deflated.resize(deflated.size() - z.avail_out);
+    } while (z.avail_in > 0 || (flush && z.avail_out == 0));
+    if (!flush) return;
+
+    TraCIBuffer frameLength;
+    frameLength << static_cast<uint32_t>(deflated.size());
+    socketSend(frameLength.str().c_str(), sizeof(uint32_t));
+    socketSend(deflated.data(), deflated.size());
+    deflated.clear();
+#endif
+}
+
+void TraCIConnection::receiveStream(char* data, size_t length)
+{
+    if (!compression) {
+        socketReceive(data, length);
+        return;
+    }
+#ifdef WITH_ZLIB
+    std::string& inflated = compression->inflated;
+    while (length > 0) {
+        if (compression->inflatedPos == inflated.size()) {
+            inflated.clear();
+            compression->inflatedPos = 0;
+
+            char buf2[sizeof(uint32_t)];
+            socketReceive(buf2, sizeof(uint32_t));
+            uint32_t frameLength;
+            TraCIBuffer(std::string(buf2, sizeof(uint32_t))) >> frameLength;
+            std::string& frame = compression->compressedFrame;
+            frame.resize(frameLength);
+            socketReceive(&frame[0], frameLength);
+
+            z_stream& z = compression->inflater;
+            z.next_in = reinterpret_cast<Bytef*>(&frame[0]);
+            z.avail_in = frameLength;
+            do {
+                size_t used = inflated.size();
+                inflated.resize(used + std::max<size_t>(4 * frameLength, 4096));
+                z.next_out = reinterpret_cast<Bytef*>(&inflated[used]);
+                z.avail_out = inflated.size() - used;
+                int status = inflate(&z, Z_SYNC_FLUSH);
+                if (status != Z_OK && status != Z_BUF_ERROR) throw cRuntimeError("TraCI decompression failed: %d", status);
+                inflated.resize(inflated.size() - z.avail_out);
+            } while (z.avail_in > 0 || z.avail_out == 0);
         }
+        size_t chunk = std::min(length, inflated.size() - compression->inflatedPos);
+        memcpy(data, inflated.data() + compression->inflatedPos, chunk);
+        compression->inflatedPos += chunk;
+        data += chunk;
+        length -= chunk;
     }
+#endif
+}
 
-    {
-        EV_TRACE << "Writing TraCI message of " << buf.length() << " bytes" << endl;
-        uint32_t bytesWritten = 0;
-        while (bytesWritten < buf.length()) {
-            ssize_t sentBytes = ::send(socket(socketPtr), buf.c_str() + bytesWritten, buf.length() - bytesWritten, 0);
-            if (sentBytes > 0) {
-                bytesWritten += sentBytes;
-            }
-            else {
-                if (sock_errno() == EINTR) continue;
-                if (sock_errno() == EAGAIN) continue;
-                throw cRuntimeError("Connection to TraCI server lost. Check your server's log. Error message: %d: %s", sock_errno(), strerror(sock_errno()));
-            }
+void TraCIConnection::socketSend(const char* data, size_t length)
+{
+    size_t bytesWritten = 0;
+    while (bytesWritten < length) {
+        ssize_t sentBytes = ::send(socket(socketPtr), data + bytesWritten, length - bytesWritten, 0);
+        if (sentBytes > 0) {
+            bytesWritten += sentBytes;
+        }
+        else {
+            if (sock_errno() == EINTR) continue;
+            if (sock_errno() == EAGAIN) continue;
+            throw cRuntimeError("Connection to TraCI server lost. Check your server's log. Error message: %d: %s", sock_errno(), strerror(sock_errno()));
         }
     }
+    wireBytes += length;
+}
+
+void TraCIConnection::socketReceive(char* data, size_t length)
+{
+    size_t bytesRead = 0;
+    while (bytesRead < length) {
+        int receivedBytes = ::recv(socket(socketPtr), data + bytesRead, length - bytesRead, 0);
+        if (receivedBytes > 0) {
+            bytesRead += receivedBytes;
+        }
+        else if (receivedBytes == 0) {
+            throw cRuntimeError("Connection to TraCI server closed unexpectedly. Check your server's log");
+        }
+        else {
+            if (sock_errno() == EINTR) continue;
+            if (sock_errno() == EAGAIN) continue;
+            throw cRuntimeError("Connection to TraCI server lost. Check your server's log. Error message: %d: %s", sock_errno(), strerror(sock_errno()));
+        }
+    }
+    wireBytes += length;
 }
 
 std::string makeTraCICommand(uint8_t commandId, const TraCIBuffer& buf)
@@ -290,6 +814,12 @@ std::list<Coord> TraCIConnection::traci2omnet(const std::list<TraCICoord>& list)
     return coordinateTransformation->traci2omnet(list);
 }
 
+void TraCIConnection::traci2omnet(const double* xy, size_t count, Coord* result) const
+{
+    ASSERT(coordinateTransformation.get());
+    coordinateTransformation->traci2omnet(xy, count, result);
+}
+
 TraCICoord TraCIConnection::omnet2traci(Coord coord) const
 {
     ASSERT(coordinateTransformation.get());
@@ -302,6 +832,12 @@ std::list<TraCICoord> TraCIConnection::omnet2traci(const std::list<Coord>& list)
     return coordinateTransformation->omnet2traci(list);
 }
 
+void TraCIConnection::omnet2traci(const Coord* coords, size_t count, TraCICoord* result) const
+{
+    ASSERT(coordinateTransformation.get());
+    coordinateTransformation->omnet2traci(coords, count, result);
+}
+
 Heading TraCIConnection::traci2omnetHeading(double heading) const
 {
     ASSERT(coordinateTransformation.get());
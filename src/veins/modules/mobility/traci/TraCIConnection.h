@@ -23,7 +23,10 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "veins/modules/mobility/traci/TraCIBuffer.h"
 #include "veins/modules/mobility/traci/TraCICoord.h"
@@ -46,6 +49,22 @@ public:
         std::string message;
     };
 
+    /**
+     * called with the status and the response commands of a queued query.
+     */
+    using ResponseHandler = std::function<void(const Result& result, TraCIBuffer& response)>;
+
+    /**
+     * called with each command (and its parameters) before it is sent or queued, e.g., to drop cached responses it may change.
+     */
+    using CommandObserver = std::function<void(uint8_t commandId, const TraCIBuffer& buf)>;
+
+    /**
+     * connects to a TraCI server, either via TCP or, if host is given as "unix:<path>", via the Unix domain socket at path (port is ignored then).
+     *
+     * If host is prefixed with "zlib:" (e.g., "zlib:mobility01"), the connection is to a bin/veins_traci_proxy in front of the TraCI server
+     * and all messages are exchanged deflate-compressed, see enableCompression(). This needs Veins to be configured --with-zlib.
+     */
     static TraCIConnection* connect(cComponent* owner, const char* host, int port);
     void setNetbounds(TraCICoord netbounds1, TraCICoord netbounds2, int margin);
     ~TraCIConnection();
@@ -58,6 +77,89 @@ public:
      */
     TraCIBuffer query(uint8_t commandId, const TraCIBuffer& buf = TraCIBuffer(), Result* result = nullptr);
 
+    /**
+     * queues a command to be sent, together with all other queued commands, in a single TraCI message.
+     *
+     * Queued commands are sent by the next call to flushQueries() or, ahead of its own command, by the next call to query().
+     * Their responses are handed to the handlers in the order the commands were queued, before query() or flushQueries() returns.
+     * Only commands whose response consists of a status and a fixed number of response commands can be queued
+     * (e.g., variable get and set commands, but not simulation steps).
+     *
+     * @param commandId: command to send
+     * @param buf: additional parameters to send
+     * @param numResponses: number of response commands that follow a successful status response (0 for set commands, 1 for get commands)
+     * @param handler: called with the status and the response commands (if set to nullptr, any return value other than RTYPE_OK will trigger an exception).
+     */
+    void queueQuery(uint8_t commandId, const TraCIBuffer& buf, size_t numResponses, ResponseHandler handler = nullptr);
+
+    /**
+     * sends all queued commands in a single TraCI message and dispatches their responses.
+     */
+    void flushQueries();
+
+    /**
+     * returns the number of commands waiting to be sent
+     */
+    size_t getNumQueuedQueries() const;
+
+    /**
+     * sends a single command via TraCI without waiting for its response, which is to be collected by receivePending().
+     *
+     * Only one command can be pending at a time. Any query before receivePending() (or the destructor) first receives and keeps
+     * the pending response, then calls the handler set via setPendingInterruptedHandler(): the server will have executed the
+     * pending command before that query, not after it.
+     * @param commandId: command to send
+     * @param buf: additional parameters to send
+     */
+    void sendPending(uint8_t commandId, const TraCIBuffer& buf = TraCIBuffer());
+
+    /**
+     * receives (or returns the kept) response to the command sent by sendPending(), checks status response, returns additional responses.
+     */
+    TraCIBuffer receivePending();
+
+    /**
+     * like receivePending(), for responses made of a count followed by as many commands (e.g., simulation steps), but returning
+     * as soon as the count has arrived: a dedicated I/O thread receives the remainder, splitting it into its commands as their bytes
+     * arrive, which nextStreamedCommand() hands out as soon as each is complete. Checks status response, returns the count.
+     *
+     * Any other message exchanged before all commands have been handed out first waits for the I/O thread to receive the rest.
+     */
+    uint32_t receivePendingStreamed();
+
+    /**
+     * moves the next command of the response received by receivePendingStreamed() into out (rewound to its start), waiting for it to arrive
+     * @return false once all commands have been handed out
+     */
+    bool nextStreamedCommand(TraCIBuffer& out);
+
+    /**
+     * returns whether a command sent by sendPending() still awaits receivePending()
+     */
+    bool hasPending() const;
+
+    /**
+     * sets the handler called when a query has to be sent while a command sent by sendPending() is outstanding
+     */
+    void setPendingInterruptedHandler(std::function<void()> handler);
+
+    /**
+     * sets the observer called with each command sent by query(), queueQuery() or sendPending() (nullptr: none)
+     */
+    void setCommandObserver(CommandObserver observer);
+
+    /**
+     * sets whether commands that change the state of the TraCI server (loading, setting the client order, setting variables) are refused with an error
+     *
+     * Meant for clients that only watch a simulation other clients see as well, e.g., replications sharing one SUMO via sumo-launchd.
+     */
+    void setReadOnly(bool readOnly);
+
+    /**
+     * returns whether the command with the passed id changes the state of the TraCI server, i.e., would be refused by a read-only connection
+     */
+    static bool isWriteCommand(uint8_t commandId);
+
     /**
      * sends a message via TraCI (after adding the header)
      */
@@ -68,6 +170,11 @@ public:
      */
     std::string receiveMessage();
 
+    /**
+     * returns the number of bytes of TraCI messages sent and received so far, and of what went over the wire for them (identical unless compressed)
+     */
+    void getTrafficStats(uint64_t& messageBytes, uint64_t& wireBytes) const;
+
     /**
      * convert TraCI heading to OMNeT++ heading (in rad)
      */
@@ -83,18 +190,96 @@ public:
      */
     Coord traci2omnet(TraCICoord coord) const;
     std::list<Coord> traci2omnet(const std::list<TraCICoord>&) const;
+    void traci2omnet(const double* xy, size_t count, Coord* result) const; /**< converts count interleaved x, y pairs into result, see TraCICoordinateTransformation */
 
     /**
      * convert OMNeT++ coordinates to TraCI coordinates
      */
     TraCICoord omnet2traci(Coord coord) const;
     std::list<TraCICoord> omnet2traci(const std::list<Coord>&) const;
+    void omnet2traci(const Coord* coords, size_t count, TraCICoord* result) const; /**< converts count coordinates into result, see TraCICoordinateTransformation */
 
 private:
+    struct QueuedQuery {
+        uint8_t commandId;
+        size_t numResponses;
+        ResponseHandler handler;
+    };
+
+    struct Compression;
+    struct Stream;
+
     TraCIConnection(cComponent* owner, void* ptr);
 
+    /**
+     * switches to the compressed framing of bin/veins_traci_proxy: after exchanging a short greeting, messages of both directions
+     * are sent as frames of a single (per direction) deflate stream, each flushed so it decodes to whole TraCI messages.
+     * Keeping the stream across messages lets vehicle IDs and values repeated from recent messages compress to back-references.
+     */
+    void enableCompression();
+
+    /**
+     * sends length bytes of the TraCI byte stream, compressing them if enabled (flush: whether the receiver must be able to decode them right away)
+     */
+    void sendStream(const char* data, size_t length, bool flush);
+
+    /**
+     * receives length bytes of the TraCI byte stream, decompressing them if enabled
+     */
+    void receiveStream(char* data, size_t length);
+
+    /**
+     * sends or receives exactly length bytes via the socket
+     */
+    void socketSend(const char* data, size_t length);
+    void socketReceive(char* data, size_t length);
+
+    /**
+     * reads a status response to commandId from buf, returning its result code
+     */
+    uint8_t readStatus(TraCIBuffer& buf, uint8_t commandId, std::string& description) const;
+
+    /**
+     * throws if the connection is read-only and the command with the passed id would change the state of the TraCI server
+     */
+    void checkWritable(uint8_t commandId) const;
+
+    /**
+     * sends the queued commands followed by (an optional) trailing command and dispatches the responses of the queued commands
+     * @return the remainder of the response message, starting at the status response of the trailing command
+     */
+    TraCIBuffer sendQueued(const std::string& trailingCommand);
+
+    /**
+     * receives the response to a command sent by sendPending(), if not done already, so another message can be exchanged
+     */
+    void interruptPending();
+
+    /**
+     * receives the commands of messageLength bytes of a streamed response, handing them to the consumer (runs on the I/O thread)
+     */
+    void receiveStreamedCommands(uint32_t count, uint32_t messageLength);
+
+    /**
+     * waits for the I/O thread to receive the rest of a streamed response (keeping its commands for nextStreamedCommand()), so another message can be exchanged
+     */
+    void finishStreamedResponse();
+
     void* socketPtr;
+    bool pending = false; /**< whether a command sent by sendPending() awaits receivePending() */
+    bool pendingReceived = false; /**< whether the response to the pending command has been received into pendingResponse */
+    uint8_t pendingCommandId = 0;
+    std::string pendingResponse;
+    std::function<void()> pendingInterruptedHandler;
+    CommandObserver commandObserver;
+    bool readOnly = false; /**< whether commands changing the state of the TraCI server are refused, see setReadOnly() */
+    std::string queuedCommands;
+    std::vector<QueuedQuery> queuedQueries;
     std::unique_ptr<TraCICoordinateTransformation> coordinateTransformation;
+    std::unique_ptr<Compression> compression; /**< nullptr: messages are exchanged uncompressed */
+    std::unique_ptr<Stream> stream; /**< I/O thread receiving streamed responses (nullptr: not started yet) */
+    uint64_t messageBytes = 0; /**< bytes of TraCI messages sent and received */
+    std::atomic<uint64_t> wireBytes{0}; /**< bytes sent and received via the socket (also by the I/O thread) */
 };
 
 /**
@@ -89,6 +89,7 @@ const uint8_t CMD_REROUTE_TO_PARKING = 0xc2;
 const uint8_t CMD_REROUTE_TRAVELTIME = 0x90;
 const uint8_t CMD_RESUME = 0x19;
 const uint8_t CMD_SAVE_SIMSTATE = 0x95;
+const uint8_t CMD_LOAD_SIMSTATE = 0x96;
 const uint8_t CMD_SETORDER = 0x03;
 const uint8_t CMD_SET_EDGE_VARIABLE = 0xca;
 const uint8_t CMD_SET_GUI_VARIABLE = 0xcc;
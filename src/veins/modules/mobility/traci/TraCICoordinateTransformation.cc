@@ -52,6 +52,19 @@ TraCICoordList TraCICoordinateTransformation::omnet2traci(const OmnetCoordList&
     return result;
 }
 
+void TraCICoordinateTransformation::omnet2traci(const OmnetCoord* coords, size_t count, TraCICoord* result) const
+{
+    // same arithmetic as the single conversion (so results are identical), with the members hoisted out of the loop
+    const double left = topleft.x;
+    const double top = topleft.y;
+    const double height = dimensions.y;
+    const double m = margin;
+    for (size_t i = 0; i < count; ++i) {
+        result[i].x = coords[i].x + left - m;
+        result[i].y = height - (coords[i].y - top) + m;
+    }
+}
+
 TraCIHeading TraCICoordinateTransformation::omnet2traciHeading(OmnetHeading o) const
 {
     // convert to degrees
@@ -85,6 +98,39 @@ OmnetCoordList TraCICoordinateTransformation::traci2omnet(const TraCICoordList&
     return result;
 }
 
+void TraCICoordinateTransformation::traci2omnet(const TraCICoord* coords, size_t count, OmnetCoord* result) const
+{
+    const double left = topleft.x;
+    const double top = topleft.y;
+    const double height = dimensions.y;
+    const double m = margin;
+    for (size_t i = 0; i < count; ++i) {
+        result[i].x = coords[i].x - left + m;
+        result[i].y = height - (coords[i].y - top) + m;
+        result[i].z = 0;
+    }
+}
+
+void TraCICoordinateTransformation::traci2omnet(const double* xy, size_t count, OmnetCoord* result) const
+{
+    const double left = topleft.x;
+    const double top = topleft.y;
+    const double height = dimensions.y;
+    const double m = margin;
+    for (size_t i = 0; i < count; ++i) {
+        result[i].x = xy[2 * i] - left + m;
+        result[i].y = height - (xy[2 * i + 1] - top) + m;
+        result[i].z = 0;
+    }
+}
+
+void TraCICoordinateTransformation::traci2omnetHeading(const TraCIHeading* headings, size_t count, OmnetHeading* result) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = traci2omnetHeading(headings[i]);
+    }
+}
+
 OmnetHeading TraCICoordinateTransformation::traci2omnetHeading(TraCIHeading o) const
 {
     // rotate angle
@@ -26,6 +26,7 @@
 #include "veins/base/utils/Coord.h"
 #include "veins/base/utils/Heading.h"
 
+#include <cstddef>
 #include <list>
 
 namespace veins {
@@ -49,6 +50,18 @@ public:
     OmnetCoord traci2omnet(const TraCICoord& coord) const;
     OmnetCoordList traci2omnet(const TraCICoordList& coords) const;
     OmnetHeading traci2omnetHeading(TraCIHeading heading) const; /**<  OMNeT++'s heading interpretation: 0 is east, pi/2 is north */
+
+    /**
+     * @name Batch conversions
+     *
+     * Convert count values into a contiguous output array (which must not overlap the input) in one loop.
+     */
+    ///@{
+    void omnet2traci(const OmnetCoord* coords, size_t count, TraCICoord* result) const;
+    void traci2omnet(const TraCICoord* coords, size_t count, OmnetCoord* result) const;
+    void traci2omnet(const double* xy, size_t count, OmnetCoord* result) const; /**< for count interleaved x, y pairs, as in TraCI polygons */
+    void traci2omnetHeading(const TraCIHeading* headings, size_t count, OmnetHeading* result) const;
+    ///@}
 private:
     TraCICoord dimensions;
     TraCICoord topleft;
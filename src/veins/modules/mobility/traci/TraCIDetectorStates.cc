@@ -0,0 +1,135 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/mobility/traci/TraCIDetectorStates.h"
+
+#include "veins/modules/mobility/traci/TraCIBuffer.h"
+#include "veins/modules/mobility/traci/TraCIConstants.h"
+
+using namespace veins::TraCIConstants;
+
+namespace veins {
+
+namespace {
+
+template <typename T>
+bool assign(T& value, T newValue)
+{
+    if (value == newValue) return false;
+    value = newValue;
+    return true;
+}
+
+} // namespace
+
+const std::vector<uint8_t>& TraCIDetectorStates::getSubscribedVariables(Kind kind)
+{
+    static const std::vector<uint8_t> laneAreaVariables = {LAST_STEP_VEHICLE_NUMBER, LAST_STEP_VEHICLE_HALTING_NUMBER, LAST_STEP_MEAN_SPEED, LAST_STEP_OCCUPANCY, JAM_LENGTH_METERS};
+    static const std::vector<uint8_t> inductionLoopVariables = {LAST_STEP_VEHICLE_NUMBER, LAST_STEP_MEAN_SPEED, LAST_STEP_OCCUPANCY, LAST_STEP_TIME_SINCE_DETECTION};
+    return (kind == Kind::LANE_AREA) ? laneAreaVariables : inductionLoopVariables;
+}
+
+size_t TraCIDetectorStates::add(const std::string& detectorId, Kind kind)
+{
+    auto i = indices.find(detectorId);
+    if (i != indices.end()) return i->second;
+
+    size_t index = states.size();
+    states.emplace_back();
+    states.back().kind = kind;
+    ids.push_back(detectorId);
+    indices[detectorId] = index;
+    return index;
+}
+
+bool TraCIDetectorStates::update(const std::string& detectorId, TraCIBuffer& buf)
+{
+    auto i = indices.find(detectorId);
+    if (i == indices.end()) throw cRuntimeError("Received subscription result for unknown detector %s", detectorId.c_str());
+    State& state = states[i->second];
+
+    bool changed = false;
+    uint8_t variableNumber_resp;
+    buf >> variableNumber_resp;
+    for (uint8_t j = 0; j < variableNumber_resp; ++j) {
+        uint8_t response_type;
+        buf >> response_type;
+        uint8_t isokay;
+        buf >> isokay;
+        if (isokay != RTYPE_OK) {
+            std::string description = buf.readTypeChecked<std::string>(TYPE_STRING);
+            throw cRuntimeError("TraCI server reported error subscribing to variable 0x%2x of detector %s (\"%s\").", response_type, detectorId.c_str(), description.c_str());
+        }
+        switch (response_type) {
+        case LAST_STEP_VEHICLE_NUMBER:
+            changed |= assign(state.vehicleNumber, buf.readTypeChecked<int32_t>(TYPE_INTEGER));
+            break;
+
+        case LAST_STEP_VEHICLE_HALTING_NUMBER:
+            changed |= assign(state.haltingNumber, buf.readTypeChecked<int32_t>(TYPE_INTEGER));
+            break;
+
+        case LAST_STEP_MEAN_SPEED:
+            changed |= assign(state.meanSpeed, buf.readTypeChecked<double>(TYPE_DOUBLE));
+            break;
+
+        case LAST_STEP_OCCUPANCY:
+            changed |= assign(state.occupancy, buf.readTypeChecked<double>(TYPE_DOUBLE));
+            break;
+
+        case JAM_LENGTH_METERS:
+            changed |= assign(state.jamLength, buf.readTypeChecked<double>(TYPE_DOUBLE));
+            break;
+
+        case LAST_STEP_TIME_SINCE_DETECTION:
+            // counts up while nothing is detected, so it does not count as a change
+            state.timeSinceDetection = buf.readTypeChecked<double>(TYPE_DOUBLE);
+            break;
+
+        default:
+            throw cRuntimeError("Received unhandled detector subscription result; type: 0x%02x", response_type);
+            break;
+        }
+    }
+    return changed;
+}
+
+int TraCIDetectorStates::indexOf(const std::string& detectorId) const
+{
+    auto i = indices.find(detectorId);
+    return (i == indices.end()) ? -1 : static_cast<int>(i->second);
+}
+
+const TraCIDetectorStates::State* TraCIDetectorStates::find(const std::string& detectorId) const
+{
+    auto i = indices.find(detectorId);
+    return (i == indices.end()) ? nullptr : &states[i->second];
+}
+
+void TraCIDetectorStates::clear()
+{
+    states.clear();
+    ids.clear();
+    indices.clear();
+}
+
+} // namespace veins
@@ -0,0 +1,106 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+class TraCIBuffer;
+
+/**
+ * Latest values of the lane area detectors (E2) and induction loops (E1) subscribed to via TraCI.
+ *
+ * States are kept in a flat table indexed by the order in which detectors were added, so they can be read every step without any
+ * queries to the TraCI server. Values not reported by a detector (e.g., the jam length of an induction loop) stay at their defaults.
+ */
+class VEINS_API TraCIDetectorStates {
+public:
+    enum class Kind : uint8_t {
+        LANE_AREA,
+        INDUCTION_LOOP,
+    };
+
+    struct State {
+        Kind kind = Kind::LANE_AREA;
+        int32_t vehicleNumber = 0; /**< vehicles on (E2) or over (E1) the detector in the last step */
+        int32_t haltingNumber = 0; /**< halting vehicles in the last step (E2 only) */
+        double meanSpeed = -1; /**< mean speed of vehicles in the last step (in m/s, -1: no vehicles) */
+        double occupancy = 0; /**< percentage of time (E1) or length (E2) occupied in the last step */
+        double jamLength = 0; /**< length of the jam in the last step (in m, E2 only) */
+        double timeSinceDetection = 0; /**< time since the last vehicle was detected (in s, E1 only) */
+    };
+
+    /**
+     * returns the variables to subscribe to for detectors of this kind
+     */
+    static const std::vector<uint8_t>& getSubscribedVariables(Kind kind);
+
+    /**
+     * adds a detector (if not known yet) and returns its index
+     */
+    size_t add(const std::string& detectorId, Kind kind);
+
+    /**
+     * decodes a subscription result for a known detector and returns whether any of its values changed
+     */
+    bool update(const std::string& detectorId, TraCIBuffer& buf);
+
+    /**
+     * returns the index of a detector, or -1 if it is not known
+     */
+    int indexOf(const std::string& detectorId) const;
+
+    /**
+     * returns the state of a detector, or nullptr if it is not known
+     */
+    const State* find(const std::string& detectorId) const;
+
+    const State& get(size_t index) const
+    {
+        return states[index];
+    }
+
+    const std::string& getId(size_t index) const
+    {
+        return ids[index];
+    }
+
+    size_t size() const
+    {
+        return states.size();
+    }
+
+    void clear();
+
+protected:
+    std::vector<State> states;
+    std::vector<std::string> ids;
+    std::unordered_map<std::string, size_t> indices;
+};
+
+} // namespace veins
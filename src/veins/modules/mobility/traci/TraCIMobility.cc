@@ -74,6 +74,9 @@ void TraCIMobility::initialize(int stage)
 
         hostPositionOffset = par("hostPositionOffset");
         setHostSpeed = par("setHostSpeed");
+        setHostAcceleration = par("setHostAcceleration");
+        if (setHostAcceleration && !setHostSpeed) throw cRuntimeError("setHostAcceleration requires setHostSpeed");
+        recordVectors = par("recordVectors");
         accidentCount = par("accidentCount");
 
         currentPosXVec.setName("posx");
@@ -97,6 +100,7 @@ void TraCIMobility::initialize(int stage)
         if (this->setHostSpeed) {
             move.setSpeed(speed);
         }
+        move.setAcceleration(0);
 
         isParking = false;
 
@@ -128,10 +132,39 @@ void TraCIMobility::finish()
 
     cancelAndDelete(startAccidentMsg);
     cancelAndDelete(stopAccidentMsg);
+    startAccidentMsg = nullptr;
+    stopAccidentMsg = nullptr;
 
     isPreInitialized = false;
 }
 
+void TraCIMobility::resetForReuse(int stage)
+{
+    BaseMobility::resetForReuse(stage);
+
+    if (stage == 0) {
+        // preInitialize() has already set up position, speed and heading for the new vehicle
+        ASSERT(isPreInitialized);
+        isPreInitialized = false;
+
+        accidentCount = par("accidentCount");
+        statistics.initialize();
+
+        isParking = false;
+        setStaticNode(false);
+        manager = nullptr;
+        commandInterface = nullptr;
+        last_speed = -1;
+
+        if (accidentCount > 0) {
+            simtime_t accidentStart = par("accidentStart");
+            startAccidentMsg = new cMessage("scheduledAccident");
+            stopAccidentMsg = new cMessage("scheduledAccidentResolved");
+            scheduleAt(simTime() + accidentStart, startAccidentMsg);
+        }
+    }
+}
+
 void TraCIMobility::handleSelfMsg(cMessage* msg)
 {
     if (msg == startAccidentMsg) {
@@ -151,6 +184,11 @@ void TraCIMobility::handleSelfMsg(cMessage* msg)
 
 void TraCIMobility::preInitialize(std::string external_id, const Coord& position, std::string road_id, double speed, Heading heading)
 {
+    if (vehicleCommandInterface && this->external_id != external_id) {
+        // of the previous vehicle of a recycled host; dropped here as other modules may look it up before resetForReuse() runs
+        delete vehicleCommandInterface;
+        vehicleCommandInterface = nullptr;
+    }
     this->external_id = external_id;
     this->lastUpdate = 0;
     this->roadPosition = position;
@@ -196,10 +234,61 @@ void TraCIMobility::changePosition()
     nextPos.z = move.getStartPosition().z;
 
     // keep statistics (for current step)
-    currentPosXVec.record(nextPos.x);
-    currentPosYVec.record(nextPos.y);
+    if (recordVectors) {
+        currentPosXVec.record(nextPos.x);
+        currentPosYVec.record(nextPos.y);
+    }
+
+    const double acceleration = advanceStatistics(nextPos);
+
+    // Update display string to show node is getting updates (only to be seen in a GUI)
+    if (hasGUI() && displayPosition) {
+        auto hostMod = getParentModule();
+        if (std::string(hostMod->getDisplayString().getTagArg("veins", 0)) == ". ") {
+            hostMod->getDisplayString().setTagArg("veins", 0, " .");
+        }
+        else {
+            hostMod->getDisplayString().setTagArg("veins", 0, ". ");
+        }
+    }
+
+    move.setStart(Coord(nextPos.x, nextPos.y, move.getStartPosition().z)); // keep z position
+    move.setDirectionByVector(heading.toCoord());
+    move.setOrientationByVector(heading.toCoord());
+    if (this->setHostSpeed) {
+        move.setSpeed(speed);
+    }
+    if (this->setHostAcceleration) {
+        move.setAcceleration(acceleration);
+    }
+    fixIfHostGetsOutside();
+    updatePosition();
+}
+
+bool TraCIMobility::isUnchangedState(const Coord& position, const std::string& road_id, double speed, Heading heading, VehicleSignalSet signals) const
+{
+    if (isPreInitialized || (lastUpdate == simTime())) return false;
+    if (setHostAcceleration && (move.getAcceleration() != 0)) return false;
+    // compare exactly, anything else would drift from the updates that were skipped
+    return (position.x == roadPosition.x) && (position.y == roadPosition.y) && (position.z == roadPosition.z) && (speed == this->speed) && (heading.getRad() == this->heading.getRad()) && (signals == this->signals) && (road_id == this->road_id);
+}
+
+void TraCIMobility::keepState()
+{
+    ASSERT(lastUpdate != simTime());
+
+    const Coord pos = move.getStartPosition();
+    if (recordVectors) {
+        currentPosXVec.record(pos.x);
+        currentPosYVec.record(pos.y);
+    }
+    advanceStatistics(pos);
+}
 
+double TraCIMobility::advanceStatistics(const Coord& nextPos)
+{
     // keep statistics (relative to last step)
+    double acceleration = 0;
     if (statistics.startTime != simTime()) {
         simtime_t updateInterval = simTime() - this->lastUpdate;
 
@@ -209,12 +298,14 @@ void TraCIMobility::changePosition()
         if (speed != -1) {
             statistics.minSpeed = std::min(statistics.minSpeed, speed);
             statistics.maxSpeed = std::max(statistics.maxSpeed, speed);
-            currentSpeedVec.record(speed);
+            if (recordVectors) currentSpeedVec.record(speed);
             if (last_speed != -1) {
-                double acceleration = (speed - last_speed) / updateInterval;
+                acceleration = (speed - last_speed) / updateInterval;
                 double co2emission = calculateCO2emission(speed, acceleration);
-                currentAccelerationVec.record(acceleration);
-                currentCO2EmissionVec.record(co2emission);
+                if (recordVectors) {
+                    currentAccelerationVec.record(acceleration);
+                    currentCO2EmissionVec.record(co2emission);
+                }
                 statistics.totalCO2Emission += co2emission * updateInterval.dbl();
             }
             last_speed = speed;
@@ -225,30 +316,15 @@ void TraCIMobility::changePosition()
         }
     }
     this->lastUpdate = simTime();
-
-    // Update display string to show node is getting updates
-    auto hostMod = getParentModule();
-    if (std::string(hostMod->getDisplayString().getTagArg("veins", 0)) == ". ") {
-        hostMod->getDisplayString().setTagArg("veins", 0, " .");
-    }
-    else {
-        hostMod->getDisplayString().setTagArg("veins", 0, ". ");
-    }
-
-    move.setStart(Coord(nextPos.x, nextPos.y, move.getStartPosition().z)); // keep z position
-    move.setDirectionByVector(heading.toCoord());
-    move.setOrientationByVector(heading.toCoord());
-    if (this->setHostSpeed) {
-        move.setSpeed(speed);
-    }
-    fixIfHostGetsOutside();
-    updatePosition();
+    return acceleration;
 }
 
 void TraCIMobility::changeParkingState(bool newState)
 {
     Enter_Method_Silent();
     isParking = newState;
+    // parked vehicles are still reported every step, but do not move
+    setStaticNode(isParking);
     emit(parkingStateChangedSignal, this);
 }
 
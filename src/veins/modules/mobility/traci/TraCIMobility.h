@@ -91,11 +91,26 @@ public:
     }
     void initialize(int) override;
     void finish() override;
+    bool isReusable() const override
+    {
+        return true;
+    }
+    void resetForReuse(int stage) override;
 
     void handleSelfMsg(cMessage* msg) override;
     virtual void preInitialize(std::string external_id, const Coord& position, std::string road_id = "", double speed = -1, Heading heading = Heading::nan);
     virtual void nextPosition(const Coord& position, std::string road_id = "", double speed = -1, Heading heading = Heading::nan, VehicleSignalSet signals = {VehicleSignal::undefined});
     virtual void changePosition();
+    /**
+     * Returns whether nextPosition() with the passed state would only advance the time of the last update,
+     * i.e., the state equals the one applied last and the host is not accelerating.
+     */
+    bool isUnchangedState(const Coord& position, const std::string& road_id, double speed, Heading heading, VehicleSignalSet signals) const;
+    /**
+     * Advances the statistics to the current time, like nextPosition() with the state applied last,
+     * but without moving the host (so no signals are emitted). See isUnchangedState().
+     */
+    void keepState();
     virtual void changeParkingState(bool);
     virtual void collisionOccurred(bool newState);
     virtual void setExternalId(std::string external_id)
@@ -115,6 +130,13 @@ public:
     {
         return isParking;
     }
+    /**
+     * Returns the time of the last position update received via nextPosition()
+     */
+    simtime_t getLastUpdate() const
+    {
+        return lastUpdate;
+    }
     virtual std::string getRoadId() const
     {
         if (road_id == "") throw cRuntimeError("TraCIMobility::getRoadId called with no road_id set yet");
@@ -173,11 +195,20 @@ protected:
 
     Statistics statistics; /**< everything statistics-related */
 
+    /**
+     * Accounts the time since the last update in the statistics (moving to nextPos) and sets the time of the last update.
+     *
+     * @return the acceleration since the last update
+     */
+    double advanceStatistics(const Coord& nextPos);
+
     bool isPreInitialized; /**< true if preInitialize() has been called immediately before initialize() */
 
     std::string external_id; /**< updated by setExternalId() */
     double hostPositionOffset; /**< front offset for the antenna on this car */
     bool setHostSpeed; /**< whether to update the speed of the host (along with its position)  */
+    bool setHostAcceleration; /**< whether to update the acceleration of the host (along with its position and speed) */
+    bool recordVectors; /**< whether to record per-update vectors of position, speed, acceleration, and CO2 emission */
 
     simtime_t lastUpdate; /**< updated by nextPosition() */
     Coord roadPosition; /**< position of front bumper, updated by nextPosition() */
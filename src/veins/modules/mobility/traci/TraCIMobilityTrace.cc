@@ -0,0 +1,273 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/mobility/traci/TraCIMobilityTrace.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using veins::TraCIMobilityTraceReader;
+using veins::TraCIMobilityTraceStep;
+using veins::TraCIMobilityTraceVehicle;
+using veins::TraCIMobilityTraceWriter;
+
+namespace {
+
+const char traceMagic[8] = {'V', 'E', 'I', 'N', 'S', 'M', 'T', 'R'};
+const uint32_t traceVersion = 1;
+
+const char tagStep = 'S';
+const char tagString = 'N';
+const char tagDeparted = 'D';
+const char tagVehicle = 'V';
+const char tagArrived = 'A';
+
+void writeUnsigned(std::ostream& os, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i) {
+        os.put(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+void writeUint32(std::ostream& os, uint32_t value)
+{
+    writeUnsigned(os, value, 4);
+}
+
+void writeInt32(std::ostream& os, int32_t value)
+{
+    writeUnsigned(os, static_cast<uint32_t>(value), 4);
+}
+
+void writeFloat(std::ostream& os, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeUnsigned(os, bits, 4);
+}
+
+void writeDouble(std::ostream& os, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeUnsigned(os, bits, 8);
+}
+
+uint64_t readUnsigned(std::istream& is, size_t bytes, const std::string& fileName)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        int c = is.get();
+        if (c == std::char_traits<char>::eof()) throw cRuntimeError("Mobility trace \"%s\" ends in the middle of a record", fileName.c_str());
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(c)) << (8 * i);
+    }
+    return value;
+}
+
+uint32_t readUint32(std::istream& is, const std::string& fileName)
+{
+    return static_cast<uint32_t>(readUnsigned(is, 4, fileName));
+}
+
+int32_t readInt32(std::istream& is, const std::string& fileName)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(readUnsigned(is, 4, fileName)));
+}
+
+float readFloat(std::istream& is, const std::string& fileName)
+{
+    uint32_t bits = static_cast<uint32_t>(readUnsigned(is, 4, fileName));
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+double readDouble(std::istream& is, const std::string& fileName)
+{
+    uint64_t bits = readUnsigned(is, 8, fileName);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int64_t toCentimeters(double meters)
+{
+    return static_cast<int64_t>(std::llround(meters * 100));
+}
+
+} // namespace
+
+TraCIMobilityTraceWriter::TraCIMobilityTraceWriter(const std::string& fileName, const TraCICoord& topleft, const TraCICoord& bottomright)
+    : os(fileName, std::ios::binary | std::ios::trunc)
+{
+    if (!os) throw cRuntimeError("Cannot open mobility trace \"%s\" for writing", fileName.c_str());
+
+    os.write(traceMagic, sizeof(traceMagic));
+    writeUint32(os, traceVersion);
+    writeDouble(os, topleft.x);
+    writeDouble(os, topleft.y);
+    writeDouble(os, bottomright.x);
+    writeDouble(os, bottomright.y);
+}
+
+void TraCIMobilityTraceWriter::beginStep(double time)
+{
+    os.put(tagStep);
+    writeDouble(os, time);
+}
+
+bool TraCIMobilityTraceWriter::hasVehicle(const std::string& id) const
+{
+    auto i = strings.find(id);
+    return (i != strings.end()) && (lastPositions.find(i->second) != lastPositions.end());
+}
+
+void TraCIMobilityTraceWriter::addVehicle(const TraCIMobilityTraceVehicle& vehicle)
+{
+    uint32_t id = intern(vehicle.id);
+    uint32_t edge = intern(vehicle.edge);
+
+    auto last = lastPositions.find(id);
+    bool departed = (last == lastPositions.end());
+    uint32_t type = departed ? intern(vehicle.typeId) : 0;
+    std::pair<int64_t, int64_t> from = departed ? std::make_pair(int64_t(0), int64_t(0)) : last->second;
+    std::pair<int64_t, int64_t> to(toCentimeters(vehicle.position.x), toCentimeters(vehicle.position.y));
+    int64_t dx = to.first - from.first;
+    int64_t dy = to.second - from.second;
+    if ((dx < std::numeric_limits<int32_t>::min()) || (dx > std::numeric_limits<int32_t>::max()) || (dy < std::numeric_limits<int32_t>::min()) || (dy > std::numeric_limits<int32_t>::max())) {
+        throw cRuntimeError("Position (%.2f, %.2f) of vehicle \"%s\" cannot be written to mobility trace", vehicle.position.x, vehicle.position.y, vehicle.id.c_str());
+    }
+    lastPositions[id] = to;
+
+    os.put(departed ? tagDeparted : tagVehicle);
+    writeUint32(os, id);
+    if (departed) writeUint32(os, type);
+    writeUint32(os, edge);
+    writeInt32(os, static_cast<int32_t>(dx));
+    writeInt32(os, static_cast<int32_t>(dy));
+    writeFloat(os, vehicle.speed);
+    writeFloat(os, vehicle.angle);
+    writeInt32(os, vehicle.signals);
+    writeFloat(os, vehicle.length);
+    writeFloat(os, vehicle.height);
+    writeFloat(os, vehicle.width);
+}
+
+void TraCIMobilityTraceWriter::addArrival(const std::string& id)
+{
+    uint32_t index = intern(id);
+    lastPositions.erase(index);
+
+    os.put(tagArrived);
+    writeUint32(os, index);
+}
+
+uint32_t TraCIMobilityTraceWriter::intern(const std::string& s)
+{
+    auto i = strings.find(s);
+    if (i != strings.end()) return i->second;
+
+    uint32_t index = strings.size();
+    strings[s] = index;
+
+    os.put(tagString);
+    writeUint32(os, s.size());
+    os.write(s.data(), s.size());
+    return index;
+}
+
+TraCIMobilityTraceReader::TraCIMobilityTraceReader(const std::string& fileName)
+    : is(fileName, std::ios::binary)
+    , fileName(fileName)
+{
+    if (!is) throw cRuntimeError("Cannot open mobility trace \"%s\"", fileName.c_str());
+
+    char magic[sizeof(traceMagic)];
+    if (!is.read(magic, sizeof(magic)) || (std::memcmp(magic, traceMagic, sizeof(magic)) != 0)) throw cRuntimeError("\"%s\" is not a mobility trace", fileName.c_str());
+    uint32_t version = readUint32(is, fileName);
+    if (version != traceVersion) throw cRuntimeError("Mobility trace \"%s\" has unsupported version %u", fileName.c_str(), version);
+    topleft.x = readDouble(is, fileName);
+    topleft.y = readDouble(is, fileName);
+    bottomright.x = readDouble(is, fileName);
+    bottomright.y = readDouble(is, fileName);
+}
+
+bool TraCIMobilityTraceReader::readStep(TraCIMobilityTraceStep& step)
+{
+    step.vehicles.clear();
+    step.arrived.clear();
+
+    int tag = is.get();
+    if (tag == std::char_traits<char>::eof()) return false;
+    if (tag != tagStep) throw cRuntimeError("Mobility trace \"%s\" contains a record outside of a step", fileName.c_str());
+    step.time = readDouble(is, fileName);
+
+    auto lookup = [this](uint32_t index) -> const std::string& {
+        if (index >= strings.size()) throw cRuntimeError("Mobility trace \"%s\" references undefined string %u", fileName.c_str(), index);
+        return strings[index];
+    };
+
+    while ((is.peek() != std::char_traits<char>::eof()) && (is.peek() != tagStep)) {
+        tag = is.get();
+        if (tag == tagString) {
+            uint32_t length = readUint32(is, fileName);
+            std::string s(length, '\0');
+            if (!is.read(&s[0], length)) throw cRuntimeError("Mobility trace \"%s\" ends in the middle of a record", fileName.c_str());
+            strings.push_back(std::move(s));
+        }
+        else if ((tag == tagDeparted) || (tag == tagVehicle)) {
+            uint32_t id = readUint32(is, fileName);
+            if (tag == tagDeparted) {
+                vehicleTypes[id] = readUint32(is, fileName);
+                lastPositions[id] = std::make_pair(int64_t(0), int64_t(0));
+            }
+            auto last = lastPositions.find(id);
+            if (last == lastPositions.end()) throw cRuntimeError("Mobility trace \"%s\" updates vehicle \"%s\" before its first record", fileName.c_str(), lookup(id).c_str());
+
+            TraCIMobilityTraceVehicle vehicle;
+            vehicle.id = lookup(id);
+            vehicle.typeId = lookup(vehicleTypes[id]);
+            vehicle.edge = lookup(readUint32(is, fileName));
+            last->second.first += readInt32(is, fileName);
+            last->second.second += readInt32(is, fileName);
+            vehicle.position = TraCICoord(last->second.first / 100.0, last->second.second / 100.0);
+            vehicle.speed = readFloat(is, fileName);
+            vehicle.angle = readFloat(is, fileName);
+            vehicle.signals = readInt32(is, fileName);
+            vehicle.length = readFloat(is, fileName);
+            vehicle.height = readFloat(is, fileName);
+            vehicle.width = readFloat(is, fileName);
+            step.vehicles.push_back(std::move(vehicle));
+        }
+        else if (tag == tagArrived) {
+            uint32_t id = readUint32(is, fileName);
+            lastPositions.erase(id);
+            vehicleTypes.erase(id);
+            step.arrived.push_back(lookup(id));
+        }
+        else {
+            throw cRuntimeError("Mobility trace \"%s\" contains unknown record type %d", fileName.c_str(), tag);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/modules/mobility/traci/TraCICoord.h"
+
+namespace veins {
+
+/**
+ * State of one vehicle at one step of a mobility trace, in TraCI coordinates.
+ */
+struct VEINS_API TraCIMobilityTraceVehicle {
+    std::string id;
+    std::string typeId; /**< SUMO vehicle type; the writer only needs it for the first record of a vehicle */
+    TraCICoord position;
+    std::string edge;
+    double speed = 0;
+    double angle = 0; /**< TraCI heading */
+    int32_t signals = 0;
+    double length = 0;
+    double height = 0;
+    double width = 0;
+};
+
+/**
+ * All vehicle updates and arrivals of one step of a mobility trace.
+ */
+struct VEINS_API TraCIMobilityTraceStep {
+    double time = 0;
+    std::vector<TraCIMobilityTraceVehicle> vehicles;
+    std::vector<std::string> arrived;
+};
+
+/**
+ * Writes the vehicle subscription results of a TraCI run to a compact binary mobility trace.
+ *
+ * The trace is a sequence of little-endian records, each starting with a tag byte:
+ * - 'S' begins a step (its time as a double),
+ * - 'N' defines the next string of the string table (vehicle ids, types, and edges are only written once, then referenced by index),
+ * - 'D' and 'V' are the first and all following updates of a vehicle ('D' adds its type);
+ *   positions are in centimeters, relative to the previous position of the vehicle,
+ * - 'A' marks a vehicle as arrived.
+ *
+ * @see TraCIMobilityTraceReader
+ */
+class VEINS_API TraCIMobilityTraceWriter {
+public:
+    TraCIMobilityTraceWriter(const std::string& fileName, const TraCICoord& topleft, const TraCICoord& bottomright);
+
+    void beginStep(double time);
+    bool hasVehicle(const std::string& id) const; /**< whether the vehicle has been written before (and has not arrived since), so its type need not be given */
+    void addVehicle(const TraCIMobilityTraceVehicle& vehicle);
+    void addArrival(const std::string& id);
+
+private:
+    uint32_t intern(const std::string& s); /**< returns the string table index of s, writing it to the trace if new */
+
+    std::ofstream os;
+    std::unordered_map<std::string, uint32_t> strings;
+    std::unordered_map<uint32_t, std::pair<int64_t, int64_t>> lastPositions; /**< by vehicle id index, in centimeters */
+};
+
+/**
+ * Reads a mobility trace written by TraCIMobilityTraceWriter, one step at a time.
+ */
+class VEINS_API TraCIMobilityTraceReader {
+public:
+    explicit TraCIMobilityTraceReader(const std::string& fileName);
+
+    const TraCICoord& getTopLeft() const
+    {
+        return topleft;
+    }
+    const TraCICoord& getBottomRight() const
+    {
+        return bottomright;
+    }
+
+    /**
+     * reads the next step into step
+     * @return false if the end of the trace has been reached
+     */
+    bool readStep(TraCIMobilityTraceStep& step);
+
+private:
+    std::ifstream is;
+    std::string fileName;
+    TraCICoord topleft;
+    TraCICoord bottomright;
+    std::vector<std::string> strings;
+    std::unordered_map<uint32_t, std::pair<int64_t, int64_t>> lastPositions; /**< by vehicle id index, in centimeters */
+    std::unordered_map<uint32_t, uint32_t> vehicleTypes; /**< string table index of each vehicle's type, by vehicle id index */
+};
+
+} // namespace veins
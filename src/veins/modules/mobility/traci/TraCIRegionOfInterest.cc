@@ -21,6 +21,8 @@
 //
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 
 #include "veins/veins.h"
@@ -29,6 +31,26 @@
 
 namespace veins {
 
+namespace {
+
+bool insidePolygon(const std::vector<TraCICoord>& polygon, const TraCICoord& pos)
+{
+    // crossing number test
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const TraCICoord& a = polygon[i];
+        const TraCICoord& b = polygon[j];
+        if ((a.y > pos.y) != (b.y > pos.y) && pos.x < (b.x - a.x) * (pos.y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+} // namespace
+
+constexpr size_t TraCIRegionOfInterest::noPolygon;
+
 TraCIRegionOfInterest::TraCIRegionOfInterest()
 {
 }
@@ -66,33 +88,135 @@ void TraCIRegionOfInterest::addRectangles(const std::string& rects)
             throw cRuntimeError("Parsing ROI rectangle failed");
         }
         roiRects.push_back(std::pair<TraCICoord, TraCICoord>(TraCICoord(x1, y1), TraCICoord(x2, y2)));
+        shapes.push_back({TraCICoord(x1, y1), TraCICoord(x2, y2), noPolygon});
     }
+    buildGrid();
+}
+
+void TraCIRegionOfInterest::addPolygons(const std::string& polygons)
+{
+    std::istringstream polygonsStream(polygons);
+    std::string polygon;
+    while (std::getline(polygonsStream, polygon, ' ')) {
+        if (polygon.empty()) continue;
+        std::istringstream polygonStream(polygon);
+        std::vector<TraCICoord> points;
+        while (true) {
+            double x;
+            char c1;
+            double y;
+            polygonStream >> x >> c1 >> y;
+            if (polygonStream.fail() || c1 != ',') {
+                throw cRuntimeError("Parsing ROI polygon failed");
+            }
+            points.push_back(TraCICoord(x, y));
+            char c2;
+            if (!(polygonStream >> c2)) break;
+            if (c2 != '-') {
+                throw cRuntimeError("Parsing ROI polygon failed");
+            }
+        }
+        if (points.size() < 3) {
+            throw cRuntimeError("ROI polygon needs at least three points");
+        }
+        Shape shape = {points.front(), points.front(), roiPolygons.size()};
+        for (const auto& point : points) {
+            shape.min.x = std::min(shape.min.x, point.x);
+            shape.min.y = std::min(shape.min.y, point.y);
+            shape.max.x = std::max(shape.max.x, point.x);
+            shape.max.y = std::max(shape.max.y, point.y);
+        }
+        roiPolygons.push_back(std::move(points));
+        shapes.push_back(shape);
+    }
+    buildGrid();
 }
 
 void TraCIRegionOfInterest::clear()
 {
     roiRoads.clear();
     roiRects.clear();
+    roiPolygons.clear();
+    shapes.clear();
+    buildGrid();
 }
 
-bool TraCIRegionOfInterest::onAnyRectangle(const TraCICoord& position) const
+void TraCIRegionOfInterest::buildGrid()
 {
-    struct RectangleTest {
-        RectangleTest(const TraCICoord& position_)
-            : position(position_)
-        {
-        }
+    gridCells.clear();
+    numCols = 0;
+    numRows = 0;
+    if (shapes.empty()) return;
+
+    TraCICoord gridMax = shapes.front().max;
+    gridMin = shapes.front().min;
+    for (const auto& shape : shapes) {
+        gridMin.x = std::min(gridMin.x, shape.min.x);
+        gridMin.y = std::min(gridMin.y, shape.min.y);
+        gridMax.x = std::max(gridMax.x, shape.max.x);
+        gridMax.y = std::max(gridMax.y, shape.max.y);
+    }
 
-        bool operator()(const std::pair<TraCICoord, TraCICoord>& rect) const
-        {
-            return (position.x >= rect.first.x && position.y >= rect.first.y) && (position.x <= rect.second.x && position.y <= rect.second.y);
-        }
+    // about one shape per cell for evenly spread shapes, in as many cells as there are shapes
+    const size_t gridDim = std::min<size_t>(256, static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(shapes.size())))));
+    numCols = gridDim;
+    numRows = gridDim;
+    cellWidth = std::max((gridMax.x - gridMin.x) / numCols, std::numeric_limits<double>::min());
+    cellHeight = std::max((gridMax.y - gridMin.y) / numRows, std::numeric_limits<double>::min());
+    gridCells.resize(numCols * numRows);
 
-        const TraCICoord& position;
+    auto col = [this](double x) {
+        return std::min(numCols - 1, static_cast<size_t>(std::max(0.0, (x - gridMin.x) / cellWidth)));
     };
+    auto row = [this](double y) {
+        return std::min(numRows - 1, static_cast<size_t>(std::max(0.0, (y - gridMin.y) / cellHeight)));
+    };
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        for (size_t r = row(shapes[i].min.y); r <= row(shapes[i].max.y); ++r) {
+            for (size_t c = col(shapes[i].min.x); c <= col(shapes[i].max.x); ++c) {
+                gridCells[r * numCols + c].push_back(i);
+            }
+        }
+    }
+}
+
+bool TraCIRegionOfInterest::onShape(const Shape& shape, const TraCICoord& position) const
+{
+    if (!((position.x >= shape.min.x && position.y >= shape.min.y) && (position.x <= shape.max.x && position.y <= shape.max.y))) return false;
+    if (shape.polygon == noPolygon) return true;
+    return insidePolygon(roiPolygons[shape.polygon], position);
+}
 
-    std::list<std::pair<TraCICoord, TraCICoord>>::const_iterator found = std::find_if(roiRects.begin(), roiRects.end(), RectangleTest(position));
-    return found != roiRects.end();
+const std::vector<size_t>* TraCIRegionOfInterest::findCell(const TraCICoord& position) const
+{
+    if (gridCells.empty()) return nullptr;
+    double c = std::floor((position.x - gridMin.x) / cellWidth);
+    double r = std::floor((position.y - gridMin.y) / cellHeight);
+    if (!(c >= 0 && r >= 0 && c <= numCols && r <= numRows)) return nullptr;
+    // positions on the upper grid border belong to the last cell
+    size_t col = std::min(numCols - 1, static_cast<size_t>(c));
+    size_t row = std::min(numRows - 1, static_cast<size_t>(r));
+    return &gridCells[row * numCols + col];
+}
+
+bool TraCIRegionOfInterest::onAnyShape(const TraCICoord& position) const
+{
+    const std::vector<size_t>* cell = findCell(position);
+    if (!cell) return false;
+    for (size_t i : *cell) {
+        if (onShape(shapes[i], position)) return true;
+    }
+    return false;
+}
+
+bool TraCIRegionOfInterest::onAnyRectangle(const TraCICoord& position) const
+{
+    const std::vector<size_t>* cell = findCell(position);
+    if (!cell) return false;
+    for (size_t i : *cell) {
+        if (shapes[i].polygon == noPolygon && onShape(shapes[i], position)) return true;
+    }
+    return false;
 }
 
 bool TraCIRegionOfInterest::partOfRoads(const std::string& road) const
@@ -102,7 +226,7 @@ bool TraCIRegionOfInterest::partOfRoads(const std::string& road) const
 
 bool TraCIRegionOfInterest::hasConstraints() const
 {
-    return !roiRoads.empty() || !roiRects.empty();
+    return !roiRoads.empty() || !roiRects.empty() || !roiPolygons.empty();
 }
 
 const std::list<std::pair<TraCICoord, TraCICoord>>& TraCIRegionOfInterest::getRectangles() const
@@ -110,4 +234,14 @@ const std::list<std::pair<TraCICoord, TraCICoord>>& TraCIRegionOfInterest::getRe
     return roiRects;
 }
 
+const std::vector<std::vector<TraCICoord>>& TraCIRegionOfInterest::getPolygons() const
+{
+    return roiPolygons;
+}
+
+const std::unordered_set<std::string>& TraCIRegionOfInterest::getRoads() const
+{
+    return roiRoads;
+}
+
 } // namespace veins
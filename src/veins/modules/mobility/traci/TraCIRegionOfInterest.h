@@ -23,9 +23,10 @@
 #pragma once
 
 #include <list>
-#include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "veins/modules/mobility/traci/TraCICoord.h"
 
@@ -34,6 +35,9 @@ namespace veins {
 /**
  * Can return whether a given position lies within the simulation's region of interest.
  * Modules are destroyed and re-created as managed vehicles leave and re-enter the ROI
+ *
+ * Rectangles and polygons are kept in a uniform grid spanning their bounding boxes,
+ * so a position is only tested against the shapes overlapping its grid cell.
  */
 class VEINS_API TraCIRegionOfInterest {
 public:
@@ -57,6 +61,12 @@ public:
      */
     void addRectangles(const std::string& rects);
 
+    /**
+     * Add polygons to constraints
+     * @param polygons given as x1,y1-x2,y2-x3,y3[-...] point lists separated by spaces
+     */
+    void addPolygons(const std::string& polygons);
+
     /**
      * Remove all constraints
      */
@@ -69,6 +79,13 @@ public:
      */
     bool onAnyRectangle(const TraCICoord& pos) const;
 
+    /**
+     * Check if position lies on any ROI rectangle or polygon
+     * @param pos Position to check
+     * @return true if on any rectangle or polygon
+     */
+    bool onAnyShape(const TraCICoord& pos) const;
+
     /**
      * Check if a given road is part of interest roads
      * @param road_id
@@ -84,9 +101,47 @@ public:
 
     const std::list<std::pair<TraCICoord, TraCICoord>>& getRectangles() const;
 
+    const std::vector<std::vector<TraCICoord>>& getPolygons() const;
+
+    const std::unordered_set<std::string>& getRoads() const;
+
 private:
-    std::set<std::string> roiRoads; /**< which roads (e.g. "hwy1 hwy2") are considered to consitute the region of interest, if not empty */
+    /**
+     * bounding box of a rectangle or polygon in the grid
+     */
+    struct Shape {
+        TraCICoord min;
+        TraCICoord max;
+        size_t polygon; /**< index into roiPolygons, or noPolygon for rectangles (which equal their bounding box) */
+    };
+    static constexpr size_t noPolygon = static_cast<size_t>(-1);
+
+    /**
+     * Rebuild the grid after shapes were added
+     */
+    void buildGrid();
+
+    /**
+     * Return the grid cell containing position, or nullptr if it is outside the grid
+     */
+    const std::vector<size_t>* findCell(const TraCICoord& pos) const;
+
+    /**
+     * Check if position lies on the given shape
+     */
+    bool onShape(const Shape& shape, const TraCICoord& pos) const;
+
+    std::unordered_set<std::string> roiRoads; /**< which roads (e.g. "hwy1 hwy2") are considered to consitute the region of interest, if not empty */
     std::list<std::pair<TraCICoord, TraCICoord>> roiRects; /**< which rectangles (e.g. "0,0-10,10 20,20-30,30) are considered to consitute the region of interest, if not empty */
+    std::vector<std::vector<TraCICoord>> roiPolygons; /**< which polygons (e.g. "0,0-10,0-5,10") are considered to consitute the region of interest, if not empty */
+
+    std::vector<Shape> shapes; /**< all rectangles and polygons */
+    std::vector<std::vector<size_t>> gridCells; /**< flattened matrix of numCols * numRows cells, each holding the indices of the shapes overlapping it */
+    TraCICoord gridMin; /**< lower left corner of the grid */
+    double cellWidth = 0;
+    double cellHeight = 0;
+    size_t numCols = 0;
+    size_t numRows = 0;
 };
 
 } // namespace veins
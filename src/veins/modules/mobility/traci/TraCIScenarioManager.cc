@@ -24,21 +24,30 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <iterator>
 #include <cstdlib>
+#include <limits>
 
 #include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+#include "veins/base/utils/Profiling.h"
+#include "veins/base/utils/SharedDataRegistry.h"
 #include "veins/base/connectionManager/ChannelAccess.h"
 #include "veins/modules/mobility/traci/TraCICommandInterface.h"
 #include "veins/modules/mobility/traci/TraCIConstants.h"
 #include "veins/modules/mobility/traci/TraCIMobility.h"
 #include "veins/modules/obstacle/ObstacleControl.h"
+#include "veins/modules/utility/TaskScheduler.h"
 #include "veins/modules/world/traci/trafficLight/TraCITrafficLightInterface.h"
 
 using namespace veins::TraCIConstants;
 
 using veins::AnnotationManagerAccess;
+using veins::Coord;
+using veins::Heading;
+using veins::SharedDataRegistry;
+using veins::MemoryAccounting;
 using veins::TraCIBuffer;
 using veins::TraCICoord;
 using veins::TraCIScenarioManager;
@@ -55,8 +64,58 @@ const simsignal_t TraCIScenarioManager::traciTrafficLightPreInitSignal = registe
 const simsignal_t TraCIScenarioManager::traciTrafficLightAddedSignal = registerSignal("org_car2x_veins_modules_mobility_traciTrafficLightAdded");
 const simsignal_t TraCIScenarioManager::traciTrafficLightRemovedSignal = registerSignal("org_car2x_veins_modules_mobility_traciTrafficLightRemoved");
 const simsignal_t TraCIScenarioManager::traciTrafficLightUpdatedSignal = registerSignal("org_car2x_veins_modules_mobility_traciTrafficLightUpdated");
+const simsignal_t TraCIScenarioManager::traciDetectorUpdatedSignal = registerSignal("org_car2x_veins_modules_mobility_traciDetectorUpdated");
 const simsignal_t TraCIScenarioManager::traciTimestepBeginSignal = registerSignal("org_car2x_veins_modules_mobility_traciTimestepBegin");
 const simsignal_t TraCIScenarioManager::traciTimestepEndSignal = registerSignal("org_car2x_veins_modules_mobility_traciTimestepEnd");
+const simsignal_t TraCIScenarioManager::traciStepWaitTimeSignal = registerSignal("org_car2x_veins_modules_mobility_traciStepWaitTime");
+const simsignal_t TraCIScenarioManager::traciStepDecodeTimeSignal = registerSignal("org_car2x_veins_modules_mobility_traciStepDecodeTime");
+const simsignal_t TraCIScenarioManager::traciStepModuleTimeSignal = registerSignal("org_car2x_veins_modules_mobility_traciStepModuleTime");
+const simsignal_t TraCIScenarioManager::traciStepNetworkTimeSignal = registerSignal("org_car2x_veins_modules_mobility_traciStepNetworkTime");
+const simsignal_t TraCIScenarioManager::traciStepSlackSignal = registerSignal("org_car2x_veins_modules_mobility_traciStepSlack");
+
+namespace {
+
+/**
+ * adds the wall time of its scope to a duration (nothing, if none is given)
+ */
+class WallTimeAccumulator {
+public:
+    explicit WallTimeAccumulator(std::chrono::steady_clock::duration* total)
+        : total(total)
+        , start(total ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+    {
+    }
+
+    ~WallTimeAccumulator()
+    {
+        if (total) *total += std::chrono::steady_clock::now() - start;
+    }
+
+private:
+    std::chrono::steady_clock::duration* total;
+    std::chrono::steady_clock::time_point start;
+};
+
+double seconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+/**
+ * records the median, 90th and 99th percentile and maximum of samples (in no particular order) as scalars prefixed with name
+ */
+void recordPercentiles(cComponent* component, const std::string& name, std::vector<double>& samples)
+{
+    if (samples.empty()) return;
+    for (auto percentile : {50, 90, 99}) {
+        auto nth = samples.begin() + (samples.size() - 1) * percentile / 100;
+        std::nth_element(samples.begin(), nth, samples.end());
+        component->recordScalar((name + "P" + std::to_string(percentile)).c_str(), *nth);
+    }
+    component->recordScalar((name + "Max").c_str(), *std::max_element(samples.begin(), samples.end()));
+}
+
+} // namespace
 
 TraCIScenarioManager::TraCIScenarioManager()
     : connection(nullptr)
@@ -70,6 +129,7 @@ TraCIScenarioManager::TraCIScenarioManager()
 TraCIScenarioManager::~TraCIScenarioManager()
 {
     if (connection) {
+        connection->setPendingInterruptedHandler(nullptr);
         TraCIBuffer buf = connection->query(CMD_CLOSE, TraCIBuffer());
     }
     if (connectAndStartTrigger) {
@@ -249,6 +309,8 @@ void TraCIScenarioManager::initialize(int stage)
         return;
     }
 
+    memoryRegistration = MemoryAccounting::add("traci", [this]() { return getMemoryUsage(); });
+
     trafficLightModuleType = par("trafficLightModuleType").stdstringValue();
     trafficLightModuleName = par("trafficLightModuleName").stdstringValue();
     trafficLightModuleDisplayString = par("trafficLightModuleDisplayString").stdstringValue();
@@ -256,6 +318,14 @@ void TraCIScenarioManager::initialize(int stage)
     std::istringstream filterstream(par("trafficLightFilter").stdstringValue());
     std::copy(std::istream_iterator<std::string>(filterstream), std::istream_iterator<std::string>(), std::back_inserter(trafficLightModuleIds));
 
+    subscribeDetectors = hasPar("subscribeDetectors") ? par("subscribeDetectors").boolValue() : false;
+    detectorIds.clear();
+    if (hasPar("detectorFilter")) {
+        std::istringstream detectorFilterStream(par("detectorFilter").stdstringValue());
+        std::copy(std::istream_iterator<std::string>(detectorFilterStream), std::istream_iterator<std::string>(), std::back_inserter(detectorIds));
+    }
+    detectorStates.clear();
+
     connectAt = par("connectAt");
     firstStepAt = par("firstStepAt");
     updateInterval = par("updateInterval");
@@ -264,7 +334,33 @@ void TraCIScenarioManager::initialize(int stage)
     penetrationRate = par("penetrationRate").doubleValue();
     ignoreGuiCommands = par("ignoreGuiCommands");
     order = par("order");
+    readOnly = par("readOnly");
     ignoreUnknownSubscriptionResults = par("ignoreUnknownSubscriptionResults");
+    useContextSubscription = par("useContextSubscription");
+    useRoiContextSubscription = par("roiContextSubscription");
+    roiContextMargin = par("roiContextMargin");
+    if (useRoiContextSubscription && !useContextSubscription) throw cRuntimeError("roiContextSubscription requires useContextSubscription");
+    if (roiContextMargin < 0) throw cRuntimeError("roiContextMargin must not be negative");
+    subscribeVehicleDimensions = par("subscribeVehicleDimensions");
+    subscribeVehicleSignals = par("subscribeVehicleSignals");
+    subscribeVehicleRoadId = par("subscribeVehicleRoadId");
+    vehicleVariables = {VAR_POSITION, VAR_SPEED, VAR_ANGLE};
+    if (subscribeVehicleRoadId) vehicleVariables.push_back(VAR_ROAD_ID);
+    if (subscribeVehicleSignals) vehicleVariables.push_back(VAR_SIGNALS);
+    if (subscribeVehicleDimensions) {
+        vehicleVariables.push_back(VAR_LENGTH);
+        vehicleVariables.push_back(VAR_HEIGHT);
+        vehicleVariables.push_back(VAR_WIDTH);
+    }
+    vehicleDimensions.clear();
+    int numDecoderThreads = par("numDecoderThreads");
+    if (numDecoderThreads < -1) throw cRuntimeError("numDecoderThreads must not be less than -1");
+    if (numDecoderThreads == -1) {
+        decoderPool = TaskScheduler::getSharedPool(this);
+    }
+    if (numDecoderThreads > 0) {
+        decoderPool = std::make_shared<WorkerPool>(numDecoderThreads);
+    }
     host = par("host").stdstringValue();
     port = getPortNumber();
     if (port == -1) {
@@ -277,8 +373,83 @@ void TraCIScenarioManager::initialize(int stage)
     roi.clear();
     roi.addRoads(par("roiRoads"));
     roi.addRectangles(par("roiRects"));
+    roi.addPolygons(par("roiPolygons"));
+    if (!roi.hasConstraints()) useRoiContextSubscription = false;
+    roiContextVehicles.clear();
+
+    coarseUpdateInterval = par("coarseUpdateInterval");
+    if (coarseUpdateInterval < 0) throw cRuntimeError("coarseUpdateInterval must not be negative");
+    configuredCoarseUpdateInterval = coarseUpdateInterval;
+    skipUnchangedUpdates = par("skipUnchangedUpdates").boolValue();
+    batchArrivals = par("batchArrivals").boolValue();
+    pendingArrivals.clear();
+    numUnchangedUpdates = 0;
+    fineMobilityRegion.clear();
+    fineMobilityRegion.addRoads(par("fineMobilityRoads"));
+    fineMobilityRegion.addRectangles(par("fineMobilityRects"));
+    if (!subscribeVehicleRoadId && (!roi.getRoads().empty() || !fineMobilityRegion.getRoads().empty())) throw cRuntimeError("roiRoads and fineMobilityRoads require subscribeVehicleRoadId");
+
+    useDormantHosts = par("useDormantHosts");
+    dormantHostTimeout = par("dormantHostTimeout");
+    connectionManager = nullptr;
+    if (useDormantHosts) {
+        connectionManager = dynamic_cast<BaseConnectionManager*>(findModuleByPath(par("connectionManagerName").stringValue()));
+        if (!connectionManager) throw cRuntimeError("useDormantHosts requires a connection manager at \"%s\"", par("connectionManagerName").stringValue());
+    }
+    dormantHosts.clear();
+    isolatedHosts.clear();
+
+    pipelineSteps = par("pipelineSteps");
+    streamStepResponses = par("streamStepResponses");
+
+    saveStateFile = par("saveStateFile").stringValue();
+    saveStateAt = par("saveStateAt");
+    stateSaved = false;
+    if (readOnly && (order != -1 || !saveStateFile.empty() || !par("loadStateFile").stdstringValue().empty())) {
+        throw cRuntimeError("readOnly does not allow to set order, saveStateFile or loadStateFile, as these change the state of the TraCI server");
+    }
+
+    maxRecycledModules = par("maxRecycledModules");
+    if (maxRecycledModules < 0) throw cRuntimeError("maxRecycledModules must not be negative");
+    recycledModules.clear();
+    reusableModuleTypes.clear();
+    prebuildModules = par("prebuildModules");
+    if (prebuildModules < 0) throw cRuntimeError("prebuildModules must not be negative");
+    prebuiltModules.clear();
+    expectedDepartures.clear();
+    expectedDepartureIndex.clear();
+    numModulesPrebuilt = 0;
+    numPrebuiltModulesBound = 0;
+    moduleTemplates.clear();
+
+    // read the network file now, the TraCI server only needs to be asked for what it does not contain
+    sumoNetwork.reset();
+    laneIndex.reset();
+    cXMLElement* sumoNetworkFile = par("sumoNetworkFile").xmlValue();
+    if (sumoNetworkFile && (sumoNetworkFile->getChildrenByTagName("edge").size() + sumoNetworkFile->getChildrenByTagName("junction").size() > 0)) {
+        sumoNetwork = SharedDataRegistry::getOrCreate<SumoNetwork>(sumoNetworkFile->getSourceLocation(), [sumoNetworkFile]() { return SumoNetwork(sumoNetworkFile); });
+        const SumoNetwork* network = sumoNetwork.get();
+        laneIndex = SharedDataRegistry::getOrCreate<LaneIndex>(sumoNetworkFile->getSourceLocation(), [network]() { return LaneIndex(network->getLanes()); });
+    }
 
     areaSum = 0;
+    traciStepWallTime = std::chrono::steady_clock::duration::zero();
+    recordStepTimes = par("recordStepTimes");
+    realTimeMonitoring = par("realTimeMonitoring");
+    realTimeFactor = par("realTimeFactor");
+    if (realTimeFactor <= 0) throw cRuntimeError("realTimeFactor must be positive");
+    behindScheduleCoarseUpdateInterval = par("behindScheduleCoarseUpdateInterval");
+    if (behindScheduleCoarseUpdateInterval < 0) throw cRuntimeError("behindScheduleCoarseUpdateInterval must not be negative");
+    behindSchedule = false;
+    hasRealTimeStart = false;
+    deadlineMisses = 0;
+    worstSlack = std::numeric_limits<double>::infinity();
+    stepModuleTime = std::chrono::steady_clock::duration::zero();
+    hasLastStepWallEnd = false;
+    stepWaitTimes.clear();
+    stepDecodeTimes.clear();
+    stepModuleTimes.clear();
+    stepNetworkTimes.clear();
     nextNodeVectorIndex = 0;
     hosts.clear();
     subscribedVehicles.clear();
@@ -290,6 +461,13 @@ void TraCIScenarioManager::initialize(int stage)
 
     world = FindModule<BaseWorldUtility*>::findGlobalModule();
 
+    vehicleLayer.reset();
+    if (par("useVehicleLayer").boolValue() && hasGUI()) {
+        if (!world) throw cRuntimeError("useVehicleLayer requires a BaseWorldUtility module");
+        std::string colorStr = par("vehicleLayerColor").stdstringValue();
+        vehicleLayer.reset(new TraCIVehicleLayer(getParentModule()->getCanvas(), cFigure::Color(colorStr.c_str()), world->getMobilityStateStore()));
+    }
+
     vehicleObstacleControl = FindModule<VehicleObstacleControl*>::findGlobalModule();
 
     ASSERT(firstStepAt > connectAt);
@@ -303,6 +481,7 @@ void TraCIScenarioManager::initialize(int stage)
 
 void TraCIScenarioManager::init_traci()
 {
+    connection->setReadOnly(readOnly);
     auto* commandInterface = getCommandInterface();
     {
         auto apiVersion = commandInterface->getVersion();
@@ -319,37 +498,40 @@ void TraCIScenarioManager::init_traci()
         if (world != nullptr && ((connection->traci2omnet(networkBoundaries.second).x > world->getPgs()->x) || (connection->traci2omnet(networkBoundaries.first).y > world->getPgs()->y))) {
             EV_WARN << "WARNING: Playground size (" << world->getPgs()->x << ", " << world->getPgs()->y << ") might be too small for vehicle at network bounds (" << connection->traci2omnet(networkBoundaries.second).x << ", " << connection->traci2omnet(networkBoundaries.first).y << ")" << endl;
         }
+        startTraceRecording(networkBoundaries.first, networkBoundaries.second);
     }
 
-    {
-        // subscribe to list of departed and arrived vehicles, as well as simulation time
-        simtime_t beginTime = 0;
-        simtime_t endTime = SimTime::getMaxTime();
-        std::string objectId = "";
-        std::list<uint8_t> variables;
-        variables.push_back(VAR_DEPARTED_VEHICLES_IDS);
-        variables.push_back(VAR_ARRIVED_VEHICLES_IDS);
-        variables.push_back(commandInterface->getTimeStepCmd());
-        if (commandInterface->getApiVersion() >= 18) {
-            variables.push_back(VAR_COLLIDING_VEHICLES_IDS);
-        }
-        variables.push_back(VAR_TELEPORT_STARTING_VEHICLES_IDS);
-        variables.push_back(VAR_TELEPORT_ENDING_VEHICLES_IDS);
-        variables.push_back(VAR_PARKING_STARTING_VEHICLES_IDS);
-        variables.push_back(VAR_PARKING_ENDING_VEHICLES_IDS);
-        uint8_t variableNumber = variables.size();
-        TraCIBuffer buf1 = TraCIBuffer();
-        buf1 << beginTime << endTime << objectId << variableNumber;
-        for (auto variable : variables) {
-            buf1 << variable;
-        }
-        TraCIBuffer buf = connection->query(CMD_SUBSCRIBE_SIM_VARIABLE, buf1);
-
-        processSubcriptionResult(buf);
-        ASSERT(buf.eof());
+    if (sumoNetwork) {
+        commandInterface->setStaticQueryCaching(true);
+        commandInterface->prewarmStaticQueryCache(*sumoNetwork);
+    }
+    else if (par("cacheStaticQueries").boolValue()) {
+        commandInterface->setStaticQueryCaching(true);
+        commandInterface->prewarmStaticQueryCache();
+    }
+    if (par("cacheStepQueries").boolValue()) commandInterface->setStepQueryCaching(true);
+
+    std::string loadStateFile = par("loadStateFile").stringValue();
+    if (!loadStateFile.empty()) {
+        // warm start: vehicles of the loaded state never depart, so count them now (their modules are added via the vehicle subscriptions below)
+        commandInterface->loadState(loadStateFile);
+        size_t count = commandInterface->getVehicleIds().size();
+        EV_DEBUG << "Loaded simulation state \"" << loadStateFile << "\" with " << count << " vehicles" << endl;
+        activeVehicleCount += count;
+        drivingVehicleCount += count;
     }
 
-    {
+    subscribeToSimVariables(*connection, *commandInterface);
+
+    if (useRoiContextSubscription) {
+        // receive the variables of all vehicles near the region of interest at once
+        subscribeToRoiContexts(*connection, *commandInterface);
+    }
+    else if (useContextSubscription) {
+        // receive the variables of all vehicles at once
+        subscribeToVehicleContext(*connection);
+    }
+    else {
         // subscribe to list of vehicle ids
         simtime_t beginTime = 0;
         simtime_t endTime = SimTime::getMaxTime();
@@ -415,6 +597,14 @@ void TraCIScenarioManager::init_traci()
             subscribeToTrafficLightVariables(tlId); // subscribe after module is in trafficLights
             cnt++;
         }
+        // send all traffic light subscriptions in one batch
+        connection->flushQueries();
+    }
+
+    if (subscribeDetectors) {
+        subscribeToDetectors();
+        // send all detector subscriptions in one batch
+        connection->flushQueries();
     }
 
     std::vector<ObstacleControl*> obstaclesModules = FindModule<ObstacleControl*>::findSubModules(getSimulation()->getSystemModule());
@@ -473,18 +663,109 @@ void TraCIScenarioManager::init_traci()
         double area = ab * ad;
         areaSum += area;
     }
+    for (const auto& polygon : roi.getPolygons()) {
+        std::list<Coord> pol;
+        for (const auto& point : polygon) {
+            pol.push_back(connection->traci2omnet(point));
+        }
+
+        // draw polygon for region of interest
+        if (annotations) {
+            annotations->drawPolygon(pol, "black");
+        }
+
+        // calculate region area (shoelace formula)
+        double twiceArea = 0;
+        for (auto i = pol.begin(), j = std::prev(pol.end()); i != pol.end(); j = i++) {
+            twiceArea += (j->x + i->x) * (j->y - i->y);
+        }
+        areaSum += std::fabs(twiceArea) / 2;
+    }
 }
 
 void TraCIScenarioManager::preNetworkFinish()
 {
-    while (hosts.begin() != hosts.end()) {
-        deleteManagedModule(hosts.begin()->first);
+    // delete in a fixed (lexicographic) order, independent of the hash table layout
+    std::vector<std::string> nodeIds;
+    nodeIds.reserve(hosts.size());
+    for (const auto& host : hosts) {
+        nodeIds.push_back(host.first);
+    }
+    std::sort(nodeIds.begin(), nodeIds.end());
+    for (const auto& nodeId : nodeIds) {
+        deleteManagedModule(nodeId);
+    }
+
+    // recycled hosts have already been finished
+    for (auto& pool : recycledModules) {
+        for (const auto& recycled : pool.second) {
+            ModuleRegistry::forgetSubModules(recycled.first->getId());
+            recycled.first->deleteModule();
+        }
+    }
+    // prebuilt hosts have never been initialized
+    for (auto& pool : prebuiltModules) {
+        for (cModule* mod : pool.second) {
+            ModuleRegistry::forgetSubModules(mod->getId());
+            mod->deleteModule();
+        }
     }
+    moduleTemplates.clear();
+    recycledModules.clear();
+    prebuiltModules.clear();
+    expectedDepartures.clear();
+    expectedDepartureIndex.clear();
 }
 
 void TraCIScenarioManager::finish()
 {
     recordScalar("roiArea", areaSum);
+    recordScalar("traciStepWallTime", std::chrono::duration<double>(traciStepWallTime).count());
+    if (connection) {
+        uint64_t messageBytes;
+        uint64_t wireBytes;
+        connection->getTrafficStats(messageBytes, wireBytes);
+        recordScalar("traciMessageBytes", messageBytes);
+        recordScalar("traciWireBytes", wireBytes);
+    }
+    if (skipUnchangedUpdates) {
+        recordScalar("unchangedVehicleUpdates", numUnchangedUpdates);
+    }
+    if (prebuildModules > 0) {
+        recordScalar("modulesPrebuilt", numModulesPrebuilt);
+        recordScalar("prebuiltModulesBound", numPrebuiltModulesBound);
+    }
+    if (realTimeMonitoring) {
+        recordScalar("deadlineMisses", deadlineMisses);
+        if (hasRealTimeStart) recordScalar("worstStepSlack", worstSlack);
+    }
+    if (recordStepTimes) {
+        recordPercentiles(this, "traciStepWaitTime", stepWaitTimes);
+        recordPercentiles(this, "traciStepDecodeTime", stepDecodeTimes);
+        recordPercentiles(this, "traciStepModuleTime", stepModuleTimes);
+        recordPercentiles(this, "traciStepNetworkTime", stepNetworkTimes);
+    }
+    traceWriter.reset();
+}
+
+MemoryAccounting::Usage TraCIScenarioManager::getMemoryUsage() const
+{
+    // the (mostly short) SUMO ids are assumed to be stored inline, so only their table entries are counted
+    MemoryAccounting::Usage usage;
+    usage.objects = hosts.size() + dormantHosts.size() + trafficLights.size();
+    usage.bytes += MemoryAccounting::bytesOfNodes(hosts) + MemoryAccounting::bytesOfNodes(unEquippedHosts) + MemoryAccounting::bytesOfNodes(subscribedVehicles) + MemoryAccounting::bytesOfNodes(trafficLights);
+    usage.bytes += MemoryAccounting::bytesOfNodes(dormantHosts) + MemoryAccounting::bytesOfNodes(isolatedHosts) + MemoryAccounting::bytesOfNodes(vehicleDimensions) + MemoryAccounting::bytesOfNodes(roiContextVehicles);
+    usage.bytes += MemoryAccounting::bytesOfNodes(vehicleObstacles) + MemoryAccounting::bytesOfNodes(recycledModules);
+    for (const auto& recycled : recycledModules) usage.bytes += MemoryAccounting::bytesOf(recycled.second);
+    usage.bytes += MemoryAccounting::bytesOf(stepWaitTimes) + MemoryAccounting::bytesOf(stepDecodeTimes) + MemoryAccounting::bytesOf(stepModuleTimes) + MemoryAccounting::bytesOf(stepNetworkTimes);
+    usage.bytes += MemoryAccounting::bytesOf(stepScratch.results) + MemoryAccounting::bytesOf(stepScratch.vehicleResults) + MemoryAccounting::bytesOf(stepScratch.vehicleResultIndex) + MemoryAccounting::bytesOf(stepScratch.vehicleResultOrigin) + MemoryAccounting::bytesOf(stepScratch.sortedIds);
+    return usage;
+}
+
+veins::LaneIndex::Match TraCIScenarioManager::matchToLane(const Coord& position, double maxDistance) const
+{
+    if (!laneIndex) throw cRuntimeError("Matching positions to lanes needs a sumoNetworkFile");
+    return laneIndex->match(connection->omnet2traci(position), maxDistance);
 }
 
 void TraCIScenarioManager::handleMessage(cMessage* msg)
@@ -501,6 +782,10 @@ void TraCIScenarioManager::handleSelfMsg(cMessage* msg)
     if (msg == connectAndStartTrigger) {
         connection.reset(TraCIConnection::connect(this, host.c_str(), port));
         commandIfc.reset(new TraCICommandInterface(this, *connection, ignoreGuiCommands));
+        connection->setPendingInterruptedHandler([this]() {
+            EV_WARN << "TraCI command sent while the next simulation step was already requested, reverting to lockstep stepping" << endl;
+            pipelineSteps = false;
+        });
         init_traci();
         return;
     }
@@ -517,6 +802,17 @@ void TraCIScenarioManager::preInitializeModule(cModule* mod, const std::string&
     auto mobilityModules = getSubmodulesOfType<TraCIMobility>(mod);
     for (auto mm : mobilityModules) {
         mm->preInitialize(nodeId, position, road_id, speed, heading);
+        if (vehicleLayer) mm->setDisplayPosition(false);
+    }
+
+    if (vehicleLayer) {
+        // the host is drawn by the vehicle layer instead, shrink its icon to an (invisible) dot
+        cDisplayString& disp = mod->getDisplayString();
+        disp.removeTag("i");
+        disp.removeTag("is");
+        disp.setTagArg("b", 0, "1");
+        disp.setTagArg("b", 1, "1");
+        disp.setTagArg("b", 5, "0");
     }
 }
 
@@ -529,9 +825,50 @@ void TraCIScenarioManager::updateModulePosition(cModule* mod, const Coord& p, co
     }
 }
 
+bool TraCIScenarioManager::keepUnchangedModuleState(cModule* mod, const Coord& p, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals)
+{
+    auto mobilityModules = getSubmodulesOfType<TraCIMobility>(mod);
+    if (mobilityModules.empty()) return false;
+    for (auto mm : mobilityModules) {
+        if (!mm->isUnchangedState(p, edge, speed, heading, signals)) return false;
+    }
+
+    // only the statistics of the modules need to advance, the host does not move
+    for (auto mm : mobilityModules) {
+        mm->keepState();
+    }
+    numUnchangedUpdates++;
+    return true;
+}
+
+void TraCIScenarioManager::commitModuleUpdates()
+{
+}
+
+bool TraCIScenarioManager::isCoarseUpdatePending(cModule* mod, const TraCICoord& position, const std::string& edge, double speed) const
+{
+    if (coarseUpdateInterval <= 0) return false;
+
+    auto mobilityModules = getSubmodulesOfType<TraCIMobility>(mod);
+    if (mobilityModules.empty()) return false;
+    const TraCIMobility* mm = mobilityModules.front();
+    if (simTime() - mm->getLastUpdate() >= coarseUpdateInterval) return false;
+
+    // a vehicle that just stopped still gets this update, so its module knows it is standing still
+    bool standingStill = mm->getParkingState() || ((speed == 0) && (mm->getSpeed() == 0));
+    bool inFineRegion = !fineMobilityRegion.hasConstraints() || fineMobilityRegion.onAnyShape(position) || fineMobilityRegion.partOfRoads(edge);
+    return standingStill || !inFineRegion;
+}
+
 // name: host;Car;i=vehicle.gif
 void TraCIScenarioManager::addModule(std::string nodeId, std::string type, std::string name, std::string displayString, const Coord& position, std::string road_id, double speed, Heading heading, VehicleSignalSet signals, double length, double height, double width)
 {
+    addModule(nodeId, makeModuleTemplate(type, name, displayString), position, road_id, speed, heading, signals, length, height, width);
+}
+
+void TraCIScenarioManager::addModule(const std::string& nodeId, const ModuleTemplate& moduleTemplate, const Coord& position, const std::string& road_id, double speed, Heading heading, VehicleSignalSet signals, double length, double height, double width)
+{
+    WallTimeAccumulator moduleTime(recordStepTimes ? &stepModuleTime : nullptr);
 
     if (hosts.find(nodeId) != hosts.end()) throw cRuntimeError("tried adding duplicate module");
 
@@ -543,35 +880,181 @@ void TraCIScenarioManager::addModule(std::string nodeId, std::string type, std::
         return;
     }
 
+    auto& pool = *moduleTemplate.recycledModules;
+    std::deque<cModule*>& prebuilt = *moduleTemplate.prebuiltModules;
+    // hosts parked just now may still have messages of their previous vehicle on the way, which are told apart by their sending time
+    auto recycled = std::find_if(pool.rbegin(), pool.rend(), [](const std::pair<cModule*, simtime_t>& parked) { return parked.second < simTime(); });
+    if (recycled != pool.rend()) {
+        // bind the vehicle to a recycled host instead of building a new one
+        cModule* mod = recycled->first;
+        pool.erase(std::next(recycled).base());
+        if (moduleTemplate.hasDisplayString) {
+            mod->getDisplayString() = moduleTemplate.displayString;
+        }
+
+        preInitializeModule(mod, nodeId, position, road_id, speed, heading, signals);
+
+        emit(traciModulePreInitSignal, mod);
+
+        resetRecycledModule(mod);
+        hosts[nodeId] = mod;
+        postInitializeModule(mod, length, height, width);
+        return;
+    }
+
+    cModule* mod;
+    if (!prebuilt.empty()) {
+        // bind the vehicle to the oldest host built ahead of time, which took the module vector index the vehicle would have taken
+        mod = prebuilt.front();
+        prebuilt.pop_front();
+        numPrebuiltModulesBound++;
+    }
+    else {
+        mod = buildModule(moduleTemplate);
+    }
+    mod->scheduleStart(simTime() + updateInterval);
+
+    preInitializeModule(mod, nodeId, position, road_id, speed, heading, signals);
+
+    emit(traciModulePreInitSignal, mod);
+
+    mod->callInitialize();
+    hosts[nodeId] = mod;
+    postInitializeModule(mod, length, height, width);
+}
+
+cModule* TraCIScenarioManager::buildModule(const ModuleTemplate& moduleTemplate)
+{
     int32_t nodeVectorIndex = nextNodeVectorIndex++;
 
     cModule* parentmod = getParentModule();
     if (!parentmod) throw cRuntimeError("Parent Module not found");
 
-    cModuleType* nodeType = cModuleType::get(type.c_str());
-    if (!nodeType) throw cRuntimeError("Module Type \"%s\" not found", type.c_str());
-
+    const char* name = moduleTemplate.name.c_str();
 #if OMNETPP_BUILDNUM >= 1525
-    parentmod->setSubmoduleVectorSize(name.c_str(), nodeVectorIndex + 1);
-    cModule* mod = nodeType->create(name.c_str(), parentmod, nodeVectorIndex);
+    parentmod->setSubmoduleVectorSize(name, nodeVectorIndex + 1);
+    cModule* mod = moduleTemplate.type->create(name, parentmod, nodeVectorIndex);
 #else
     // TODO: this trashes the vectsize member of the cModule, although nobody seems to use it
-    cModule* mod = nodeType->create(name.c_str(), parentmod, nodeVectorIndex, nodeVectorIndex);
+    cModule* mod = moduleTemplate.type->create(name, parentmod, nodeVectorIndex, nodeVectorIndex);
 #endif
     mod->finalizeParameters();
-    if (displayString.length() > 0) {
-        mod->getDisplayString().parse(displayString.c_str());
+    if (moduleTemplate.hasDisplayString) {
+        mod->getDisplayString() = moduleTemplate.displayString;
     }
     mod->buildInside();
-    mod->scheduleStart(simTime() + updateInterval);
+    return mod;
+}
 
-    preInitializeModule(mod, nodeId, position, road_id, speed, heading, signals);
+void TraCIScenarioManager::noteLoadedVehicle(const std::string& nodeId)
+{
+    if (expectedDepartureIndex.count(nodeId)) return;
+    expectedDepartures.emplace_back(nodeId, nullptr);
+    auto entry = std::prev(expectedDepartures.end());
+    expectedDepartureIndex[nodeId] = entry;
+
+    // only look up the type of the vehicle if the type mappings depend on it
+    bool typeIndependent = true;
+    for (const TypeMapping* mapping : {&moduleType, &moduleName, &moduleDisplayString}) {
+        for (const auto& i : *mapping) typeIndependent = typeIndependent && (i.first == "*");
+    }
+    if (typeIndependent) {
+        entry->second = &getModuleTemplate("*");
+        return;
+    }
+    commandIfc->vehicle(nodeId).queueGetTypeId([this, nodeId](std::string typeId) {
+        auto i = expectedDepartureIndex.find(nodeId);
+        if (i != expectedDepartureIndex.end()) i->second->second = &getModuleTemplate(typeId);
+    });
+}
 
-    emit(traciModulePreInitSignal, mod);
+void TraCIScenarioManager::noteDepartedVehicle(const std::string& nodeId)
+{
+    auto i = expectedDepartureIndex.find(nodeId);
+    if (i == expectedDepartureIndex.end()) return;
+    expectedDepartures.erase(i->second);
+    expectedDepartureIndex.erase(i);
+}
 
-    mod->callInitialize();
-    hosts[nodeId] = mod;
+void TraCIScenarioManager::prebuildExpectedModules()
+{
+    WallTimeAccumulator moduleTime(recordStepTimes ? &stepModuleTime : nullptr);
+
+    // hosts needed per module template by the next departures (in order of the first one needing it), less those available already
+    std::vector<std::pair<const ModuleTemplate*, int>> missing;
+    int considered = 0;
+    for (auto i = expectedDepartures.begin(); i != expectedDepartures.end() && considered < prebuildModules; ++i, ++considered) {
+        if (!i->second || !i->second->type) continue;
+        auto known = std::find_if(missing.begin(), missing.end(), [i](const std::pair<const ModuleTemplate*, int>& m) { return m.first == i->second; });
+        if (known != missing.end()) {
+            known->second++;
+        }
+        else {
+            missing.emplace_back(i->second, 1);
+        }
+    }
+    for (auto& i : missing) {
+        const ModuleTemplate& moduleTemplate = *i.first;
+        for (int n = i.second - static_cast<int>(moduleTemplate.recycledModules->size() + moduleTemplate.prebuiltModules->size()); n > 0; --n) {
+            moduleTemplate.prebuiltModules->push_back(buildModule(moduleTemplate));
+            numModulesPrebuilt++;
+        }
+    }
+}
+
+TraCIScenarioManager::ModuleTemplate TraCIScenarioManager::makeModuleTemplate(const std::string& type, const std::string& name, const std::string& displayString)
+{
+    ModuleTemplate moduleTemplate;
+    moduleTemplate.type = cModuleType::get(type.c_str());
+    if (!moduleTemplate.type) throw cRuntimeError("Module Type \"%s\" not found", type.c_str());
+    moduleTemplate.name = name;
+    moduleTemplate.hasDisplayString = displayString.length() > 0;
+    if (moduleTemplate.hasDisplayString) {
+        moduleTemplate.displayString.parse(displayString.c_str());
+    }
+    // same key as used by deleteManagedModule(); entries of std::map stay put until it is cleared, which also clears moduleTemplates
+    moduleTemplate.recycledModules = &recycledModules[std::make_pair(std::string(moduleTemplate.type->getFullName()), name)];
+    moduleTemplate.prebuiltModules = &prebuiltModules[std::make_pair(std::string(moduleTemplate.type->getFullName()), name)];
+    return moduleTemplate;
+}
+
+const TraCIScenarioManager::ModuleTemplate& TraCIScenarioManager::getModuleTemplate(const std::string& vType)
+{
+    auto cached = moduleTemplates.find(vType);
+    if (cached != moduleTemplates.end()) return cached->second;
+
+    TypeMapping::iterator iType, iName, iDisplayString;
+
+    iType = moduleType.find(vType);
+    if (iType == moduleType.end()) {
+        iType = moduleType.find("*");
+        if (iType == moduleType.end()) throw cRuntimeError("cannot find a module type for vehicle type \"%s\"", vType.c_str());
+    }
+    // search for module name
+    iName = moduleName.find(vType);
+    if (iName == moduleName.end()) {
+        iName = moduleName.find(std::string("*"));
+        if (iName == moduleName.end()) throw cRuntimeError("cannot find a module name for vehicle type \"%s\"", vType.c_str());
+    }
+    std::string mDisplayString;
+    if (moduleDisplayString.size() != 0) {
+        iDisplayString = moduleDisplayString.find(vType);
+        if (iDisplayString == moduleDisplayString.end()) {
+            iDisplayString = moduleDisplayString.find("*");
+            if (iDisplayString == moduleDisplayString.end()) throw cRuntimeError("cannot find a module display string for vehicle type \"%s\"", vType.c_str());
+        }
+        mDisplayString = iDisplayString->second;
+    }
 
+    ModuleTemplate moduleTemplate;
+    if (iType->second != "0") {
+        moduleTemplate = makeModuleTemplate(iType->second, iName->second, mDisplayString);
+    }
+    return moduleTemplates.emplace(vType, std::move(moduleTemplate)).first->second;
+}
+
+void TraCIScenarioManager::postInitializeModule(cModule* mod, double length, double height, double width)
+{
     // post-initialize TraCIMobility
     auto mobilityModules = getSubmodulesOfType<TraCIMobility>(mod);
     for (auto mm : mobilityModules) {
@@ -590,13 +1073,20 @@ void TraCIScenarioManager::addModule(std::string nodeId, std::string type, std::
         vehicleObstacles[mm] = vo;
     }
 
+    if (vehicleLayer) {
+        for (auto mm : mobilityModules) {
+            vehicleLayer->add(mm->getStateHandle(), length, width);
+        }
+    }
+
     emit(traciModuleAddedSignal, mod);
 }
 
 cModule* TraCIScenarioManager::getManagedModule(std::string nodeId)
 {
-    if (hosts.find(nodeId) == hosts.end()) return nullptr;
-    return hosts[nodeId];
+    auto host = hosts.find(nodeId);
+    if (host == hosts.end()) return nullptr;
+    return host->second;
 }
 
 bool TraCIScenarioManager::isModuleUnequipped(std::string nodeId)
@@ -607,6 +1097,7 @@ bool TraCIScenarioManager::isModuleUnequipped(std::string nodeId)
 
 void TraCIScenarioManager::deleteManagedModule(std::string nodeId)
 {
+    WallTimeAccumulator moduleTime(recordStepTimes ? &stepModuleTime : nullptr);
     cModule* mod = getManagedModule(nodeId);
     if (!mod) throw cRuntimeError("no vehicle with Id \"%s\" found", nodeId.c_str());
 
@@ -618,6 +1109,49 @@ void TraCIScenarioManager::deleteManagedModule(std::string nodeId)
         auto connectionManager = ChannelAccess::getConnectionManager(nic);
         connectionManager->unregisterNic(nic);
     }
+    detachManagedModule(mod);
+    disposeManagedModule(nodeId, mod);
+}
+
+void TraCIScenarioManager::deleteManagedModules(const std::vector<std::string>& nodeIds)
+{
+    WallTimeAccumulator moduleTime(recordStepTimes ? &stepModuleTime : nullptr);
+
+    // detach all modules first, so every connection manager unregisters their nics in one pass
+    std::vector<cModule*> mods;
+    std::vector<std::pair<BaseConnectionManager*, std::vector<cModule*>>> nicsByManager;
+    for (const std::string& nodeId : nodeIds) {
+        cModule* mod = getManagedModule(nodeId);
+        if (!mod) throw cRuntimeError("no vehicle with Id \"%s\" found", nodeId.c_str());
+        emit(traciModuleRemovedSignal, mod);
+
+        for (auto ca : getSubmodulesOfType<ChannelAccess>(mod, true)) {
+            cModule* nic = ca->getParentModule();
+            BaseConnectionManager* connectionManager = ChannelAccess::getConnectionManager(nic);
+            auto entry = std::find_if(nicsByManager.begin(), nicsByManager.end(), [connectionManager](const std::pair<BaseConnectionManager*, std::vector<cModule*>>& e) { return e.first == connectionManager; });
+            if (entry == nicsByManager.end()) entry = nicsByManager.emplace(nicsByManager.end(), connectionManager, std::vector<cModule*>());
+            entry->second.push_back(nic);
+        }
+        detachManagedModule(mod);
+        mods.push_back(mod);
+    }
+    for (auto& entry : nicsByManager) {
+        entry.first->unregisterNics(entry.second);
+    }
+    for (size_t i = 0; i < mods.size(); ++i) {
+        disposeManagedModule(nodeIds[i], mods[i]);
+    }
+}
+
+void TraCIScenarioManager::deletePendingArrivals()
+{
+    if (pendingArrivals.empty()) return;
+    deleteManagedModules(pendingArrivals);
+    pendingArrivals.clear();
+}
+
+void TraCIScenarioManager::detachManagedModule(cModule* mod)
+{
     if (vehicleObstacleControl) {
         for (cModule::SubmoduleIterator iter(mod); !iter.end(); iter++) {
             cModule* submod = *iter;
@@ -628,12 +1162,76 @@ void TraCIScenarioManager::deleteManagedModule(std::string nodeId)
             vehicleObstacleControl->erase(vo->second);
         }
     }
+    if (vehicleLayer) {
+        for (auto mm : getSubmodulesOfType<TraCIMobility>(mod)) {
+            vehicleLayer->remove(mm->getStateHandle());
+        }
+    }
+}
 
+void TraCIScenarioManager::disposeManagedModule(const std::string& nodeId, cModule* mod)
+{
     hosts.erase(nodeId);
+    isolatedHosts.erase(nodeId);
     mod->callFinish();
+
+    if (maxRecycledModules > 0 && isReusableModule(mod)) {
+        auto& pool = recycledModules[std::make_pair(std::string(mod->getModuleType()->getFullName()), std::string(mod->getName()))];
+        if (pool.size() < static_cast<size_t>(maxRecycledModules)) {
+            recycleModule(mod);
+            pool.emplace_back(mod, simTime());
+            return;
+        }
+    }
+    ModuleRegistry::forgetSubModules(mod->getId());
     mod->deleteModule();
 }
 
+bool TraCIScenarioManager::isReusableModule(cModule* mod)
+{
+    std::string type = mod->getModuleType()->getFullName();
+    auto cached = reusableModuleTypes.find(type);
+    if (cached != reusableModuleTypes.end()) return cached->second;
+
+    bool reusable = true;
+    std::vector<cModule*> pending = {mod};
+    while (reusable && !pending.empty()) {
+        cModule* current = pending.back();
+        pending.pop_back();
+        if (current->isSimple()) {
+            BaseModule* baseModule = dynamic_cast<BaseModule*>(current);
+            reusable = baseModule && baseModule->isReusable();
+        }
+        for (cModule::SubmoduleIterator iter(current); !iter.end(); iter++) {
+            pending.push_back(*iter);
+        }
+    }
+    reusableModuleTypes[type] = reusable;
+    return reusable;
+}
+
+void TraCIScenarioManager::recycleModule(cModule* mod)
+{
+    // a parked host must not see any further events: its modules ignore everything sent to them up to now when it arrives
+    for (auto module : getSubmodulesOfType<BaseModule>(mod, true)) {
+        module->parkForReuse();
+    }
+}
+
+void TraCIScenarioManager::resetRecycledModule(cModule* mod)
+{
+    auto modules = getSubmodulesOfType<BaseModule>(mod, true);
+    int numStages = 0;
+    for (auto module : modules) {
+        numStages = std::max(numStages, module->numInitStages());
+    }
+    for (int stage = 0; stage < numStages; ++stage) {
+        for (auto module : modules) {
+            if (stage < module->numInitStages()) module->resetForReuse(stage);
+        }
+    }
+}
+
 void TraCIScenarioManager::executeOneTimestep()
 {
 
@@ -644,19 +1242,80 @@ void TraCIScenarioManager::executeOneTimestep()
     emit(traciTimestepBeginSignal, targetTime);
 
     if (isConnected()) {
-        TraCIBuffer buf = connection->query(CMD_SIMSTEP2, TraCIBuffer() << targetTime);
+        const auto stepWallStart = std::chrono::steady_clock::now();
+        if (recordStepTimes && hasLastStepWallEnd) {
+            double networkTime = seconds(stepWallStart - lastStepWallEnd);
+            stepNetworkTimes.push_back(networkTime);
+            emit(traciStepNetworkTimeSignal, networkTime);
+        }
+
+        if (prebuildModules > 0) {
+            // build hosts for the next departures while the TraCI server computes the step
+            if (!connection->hasPending()) connection->sendPending(CMD_SIMSTEP2, TraCIBuffer() << targetTime);
+            prebuildExpectedModules();
+        }
 
+        // the step might have been requested ahead (and might even have been received already, if another query interrupted pipelining)
+        TraCIBuffer buf;
         uint32_t count;
-        buf >> count;
+        if (streamStepResponses) {
+            if (!connection->hasPending()) connection->sendPending(CMD_SIMSTEP2, TraCIBuffer() << targetTime);
+            count = connection->receivePendingStreamed();
+        }
+        else {
+            buf = connection->hasPending() ? connection->receivePending() : connection->query(CMD_SIMSTEP2, TraCIBuffer() << targetTime);
+            buf >> count;
+        }
+        const auto stepWallReceived = std::chrono::steady_clock::now();
+        stepModuleTime = std::chrono::steady_clock::duration::zero();
+        if (traceWriter) traceWriter->beginStep(targetTime.dbl());
+
         EV_DEBUG << "Getting " << count << " subscription results" << endl;
-        for (uint32_t i = 0; i < count; ++i) {
-            processSubcriptionResult(buf);
+        if (streamStepResponses) {
+            processStreamedSubscriptionResults();
+        }
+        else {
+            processSubscriptionResults(count, buf);
+        }
+        commitModuleUpdates();
+        updateDormantHosts();
+        // redrawing all hosts is the first thing to go when behind schedule
+        if (vehicleLayer && !behindSchedule) vehicleLayer->update();
+
+        if (!saveStateFile.empty() && !stateSaved && (targetTime >= saveStateAt)) {
+            EV_DEBUG << "Saving simulation state to \"" << saveStateFile << "\"" << endl;
+            commandIfc->saveState(saveStateFile);
+            stateSaved = true;
+        }
+
+        const auto stepWallEnd = std::chrono::steady_clock::now();
+        traciStepWallTime += stepWallEnd - stepWallStart;
+        if (recordStepTimes) {
+            double waitTime = seconds(stepWallReceived - stepWallStart);
+            double moduleTime = seconds(stepModuleTime);
+            double decodeTime = seconds(stepWallEnd - stepWallReceived) - moduleTime;
+            stepWaitTimes.push_back(waitTime);
+            stepDecodeTimes.push_back(decodeTime);
+            stepModuleTimes.push_back(moduleTime);
+            emit(traciStepWaitTimeSignal, waitTime);
+            emit(traciStepDecodeTimeSignal, decodeTime);
+            emit(traciStepModuleTimeSignal, moduleTime);
         }
+        if (realTimeMonitoring) updateRealTimeSchedule(targetTime, stepWallEnd);
     }
 
     emit(traciTimestepEndSignal, targetTime);
 
-    if (!autoShutdownTriggered) scheduleAt(simTime() + updateInterval, executeOneTimestepTrigger);
+    if (!autoShutdownTriggered) {
+        scheduleAt(simTime() + updateInterval, executeOneTimestepTrigger);
+        // let the TraCI server compute the next step while we process this one
+        if (pipelineSteps && isConnected()) connection->sendPending(CMD_SIMSTEP2, TraCIBuffer() << simTime() + updateInterval);
+    }
+
+    if (recordStepTimes && isConnected()) {
+        lastStepWallEnd = std::chrono::steady_clock::now();
+        hasLastStepWallEnd = true;
+    }
 }
 
 void TraCIScenarioManager::subscribeToVehicleVariables(std::string vehicleId)
@@ -665,15 +1324,7 @@ void TraCIScenarioManager::subscribeToVehicleVariables(std::string vehicleId)
     simtime_t beginTime = 0;
     simtime_t endTime = SimTime::getMaxTime();
     std::string objectId = vehicleId;
-    std::list<uint8_t> variables;
-    variables.push_back(VAR_POSITION);
-    variables.push_back(VAR_ROAD_ID);
-    variables.push_back(VAR_SPEED);
-    variables.push_back(VAR_ANGLE);
-    variables.push_back(VAR_SIGNALS);
-    variables.push_back(VAR_LENGTH);
-    variables.push_back(VAR_HEIGHT);
-    variables.push_back(VAR_WIDTH);
+    const std::vector<uint8_t>& variables = vehicleVariables;
     uint8_t variableNumber = variables.size();
 
     TraCIBuffer buf1;
@@ -686,6 +1337,92 @@ void TraCIScenarioManager::subscribeToVehicleVariables(std::string vehicleId)
     ASSERT(buf.eof());
 }
 
+void TraCIScenarioManager::subscribeToSimVariables(TraCIConnection& traciConnection, TraCICommandInterface& commandInterface)
+{
+    // subscribe to list of departed and arrived vehicles, as well as simulation time
+    simtime_t beginTime = 0;
+    simtime_t endTime = SimTime::getMaxTime();
+    std::string objectId = "";
+    std::list<uint8_t> variables;
+    // vehicles loaded and departed within the same step must be noted as loaded first
+    if (prebuildModules > 0) variables.push_back(VAR_LOADED_VEHICLES_IDS);
+    variables.push_back(VAR_DEPARTED_VEHICLES_IDS);
+    variables.push_back(VAR_ARRIVED_VEHICLES_IDS);
+    variables.push_back(commandInterface.getTimeStepCmd());
+    if (commandInterface.getApiVersion() >= 18) {
+        variables.push_back(VAR_COLLIDING_VEHICLES_IDS);
+    }
+    variables.push_back(VAR_TELEPORT_STARTING_VEHICLES_IDS);
+    variables.push_back(VAR_TELEPORT_ENDING_VEHICLES_IDS);
+    variables.push_back(VAR_PARKING_STARTING_VEHICLES_IDS);
+    variables.push_back(VAR_PARKING_ENDING_VEHICLES_IDS);
+    uint8_t variableNumber = variables.size();
+    TraCIBuffer buf1 = TraCIBuffer();
+    buf1 << beginTime << endTime << objectId << variableNumber;
+    for (auto variable : variables) {
+        buf1 << variable;
+    }
+    TraCIBuffer buf = traciConnection.query(CMD_SUBSCRIBE_SIM_VARIABLE, buf1);
+
+    processSubcriptionResult(buf);
+    ASSERT(buf.eof());
+}
+
+void TraCIScenarioManager::subscribeToVehicleContext(TraCIConnection& traciConnection, uint8_t commandId, const std::string& objectId, double range)
+{
+    // by default, a simulation context subscription covers all vehicles in the network, regardless of range
+    simtime_t beginTime = 0;
+    simtime_t endTime = SimTime::getMaxTime();
+    uint8_t contextDomain = CMD_GET_VEHICLE_VARIABLE;
+    const std::vector<uint8_t>& variables = vehicleVariables;
+    uint8_t variableNumber = variables.size();
+
+    TraCIBuffer buf1;
+    buf1 << beginTime << endTime << objectId << contextDomain << range << variableNumber;
+    for (auto variable : variables) {
+        buf1 << variable;
+    }
+    TraCIBuffer buf = traciConnection.query(commandId, buf1);
+    processSubcriptionResult(buf);
+    ASSERT(buf.eof());
+}
+
+void TraCIScenarioManager::subscribeToRoiContexts(TraCIConnection& traciConnection, TraCICommandInterface& commandInterface)
+{
+    // SUMO has no polygon filter for context subscriptions, so each shape gets an invisible POI whose context circle covers it; exact ROI checks stay with applyVehicleState
+    std::vector<std::pair<TraCICoord, TraCICoord>> boxes(roi.getRectangles().begin(), roi.getRectangles().end());
+    for (const auto& polygon : roi.getPolygons()) {
+        TraCICoord min = polygon.front();
+        TraCICoord max = polygon.front();
+        for (const auto& point : polygon) {
+            min.x = std::min(min.x, point.x);
+            min.y = std::min(min.y, point.y);
+            max.x = std::max(max.x, point.x);
+            max.y = std::max(max.y, point.y);
+        }
+        boxes.emplace_back(min, max);
+    }
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const TraCICoord& min = boxes[i].first;
+        const TraCICoord& max = boxes[i].second;
+        TraCICoord center((min.x + max.x) / 2, (min.y + max.y) / 2);
+        double radius = std::sqrt((max.x - min.x) * (max.x - min.x) + (max.y - min.y) * (max.y - min.y)) / 2;
+        std::string poiId = "veins.roi." + std::to_string(i);
+        commandInterface.addPoi(poiId, "veins.roi", TraCIColor(0, 0, 0, 0), 0, traciConnection.traci2omnet(center));
+        subscribeToVehicleContext(traciConnection, CMD_SUBSCRIBE_POI_CONTEXT, poiId, radius + roiContextMargin);
+    }
+
+    // vehicles on a road are within any range of it (in lexicographic order, as this determines the order modules get created in)
+    std::vector<std::string> roads(roi.getRoads().begin(), roi.getRoads().end());
+    std::sort(roads.begin(), roads.end());
+    for (const auto& road : roads) {
+        subscribeToVehicleContext(traciConnection, CMD_SUBSCRIBE_EDGE_CONTEXT, road, roiContextMargin);
+    }
+
+    // the responses above reported the vehicles of the current step, the first step must not take them for duplicates
+    roiContextVehicles.clear();
+}
+
 void TraCIScenarioManager::unsubscribeFromVehicleVariables(std::string vehicleId)
 {
     // subscribe to some attributes of the vehicle
@@ -709,9 +1446,12 @@ void TraCIScenarioManager::subscribeToTrafficLightVariables(std::string tlId)
     uint8_t variable3 = TL_NEXT_SWITCH;
     uint8_t variable4 = TL_RED_YELLOW_GREEN_STATE;
 
-    TraCIBuffer buf = connection->query(CMD_SUBSCRIBE_TL_VARIABLE, TraCIBuffer() << beginTime << endTime << objectId << variableNumber << variable1 << variable2 << variable3 << variable4);
-    processSubcriptionResult(buf);
-    ASSERT(buf.eof());
+    // queued, so that subscriptions to many traffic lights share one round trip
+    connection->queueQuery(CMD_SUBSCRIBE_TL_VARIABLE, TraCIBuffer() << beginTime << endTime << objectId << variableNumber << variable1 << variable2 << variable3 << variable4, 1, [this, tlId](const TraCIConnection::Result& result, TraCIBuffer& buf) {
+        if (!result.success) throw cRuntimeError("Subscribing to traffic light %s failed: %s", tlId.c_str(), result.message.c_str());
+        processSubcriptionResult(buf);
+        ASSERT(buf.eof());
+    });
 }
 
 void TraCIScenarioManager::unsubscribeFromTrafficLightVariables(std::string tlId)
@@ -728,7 +1468,7 @@ void TraCIScenarioManager::unsubscribeFromTrafficLightVariables(std::string tlId
     ASSERT(buf.eof());
 }
 
-void TraCIScenarioManager::processTrafficLightSubscription(std::string objectId, TraCIBuffer& buf)
+void TraCIScenarioManager::processTrafficLightSubscription(const std::string& objectId, TraCIBuffer& buf)
 {
     cModule* tlIfSubmodule = trafficLights[objectId]->getSubmodule("tlInterface");
     TraCITrafficLightInterface* tlIfModule = dynamic_cast<TraCITrafficLightInterface*>(tlIfSubmodule);
@@ -775,13 +1515,59 @@ void TraCIScenarioManager::processTrafficLightSubscription(std::string objectId,
         }
     }
 
-    emit(traciTrafficLightUpdatedSignal, trafficLights[objectId]);
+    tlIfModule->setInitialStateReceived();
+
+    // only notify listeners if the subscription actually changed something
+    if (tlIfModule->resetChanged()) {
+        emit(traciTrafficLightUpdatedSignal, trafficLights[objectId]);
+    }
+}
+
+void TraCIScenarioManager::subscribeToDetectors()
+{
+    auto isSelected = [this](const std::string& detectorId) {
+        return detectorIds.empty() || (std::find(detectorIds.begin(), detectorIds.end(), detectorId) != detectorIds.end());
+    };
+    for (const std::string& detectorId : commandIfc->getLaneAreaDetectorIds()) {
+        if (isSelected(detectorId)) subscribeToDetectorVariables(detectorId, TraCIDetectorStates::Kind::LANE_AREA);
+    }
+    for (const std::string& detectorId : commandIfc->getInductionLoopIds()) {
+        if (isSelected(detectorId)) subscribeToDetectorVariables(detectorId, TraCIDetectorStates::Kind::INDUCTION_LOOP);
+    }
+}
+
+void TraCIScenarioManager::subscribeToDetectorVariables(const std::string& detectorId, TraCIDetectorStates::Kind kind)
+{
+    detectorStates.add(detectorId, kind);
+
+    simtime_t beginTime = 0;
+    simtime_t endTime = SimTime::getMaxTime();
+    const std::vector<uint8_t>& variables = TraCIDetectorStates::getSubscribedVariables(kind);
+    TraCIBuffer buf;
+    buf << beginTime << endTime << detectorId << static_cast<uint8_t>(variables.size());
+    for (uint8_t variable : variables) buf << variable;
+
+    uint8_t commandId = (kind == TraCIDetectorStates::Kind::LANE_AREA) ? CMD_SUBSCRIBE_LANEAREA_VARIABLE : CMD_SUBSCRIBE_INDUCTIONLOOP_VARIABLE;
+    connection->queueQuery(commandId, buf, 1, [this, detectorId](const TraCIConnection::Result& result, TraCIBuffer& buf) {
+        if (!result.success) throw cRuntimeError("Subscribing to detector %s failed: %s", detectorId.c_str(), result.message.c_str());
+        processSubcriptionResult(buf);
+        ASSERT(buf.eof());
+    });
+}
+
+void TraCIScenarioManager::processDetectorSubscription(const std::string& objectId, TraCIBuffer& buf)
+{
+    // only notify listeners if the subscription actually changed something
+    if (detectorStates.update(objectId, buf)) {
+        emit(traciDetectorUpdatedSignal, static_cast<long>(detectorStates.indexOf(objectId)));
+    }
 }
 
-void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuffer& buf)
+void TraCIScenarioManager::processSimSubscription(const std::string& objectId, TraCIBuffer& buf)
 {
     uint8_t variableNumber_resp;
     buf >> variableNumber_resp;
+    std::string idstring; // reused for all ids, keeping its storage
     for (uint8_t j = 0; j < variableNumber_resp; ++j) {
         uint8_t variable1_resp;
         buf >> variable1_resp;
@@ -804,15 +1590,32 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             uint32_t count;
             buf >> count;
             EV_DEBUG << "TraCI reports " << count << " departed vehicles." << endl;
-            for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
-                buf >> idstring;
-                // adding modules is handled on the fly when entering/leaving the ROI
+            // adding modules is handled on the fly when entering/leaving the ROI
+            if (prebuildModules > 0) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    buf >> idstring;
+                    noteDepartedVehicle(idstring);
+                }
+            }
+            else {
+                buf.skipStrings(count);
             }
 
             activeVehicleCount += count;
             drivingVehicleCount += count;
         }
+        else if (variable1_resp == VAR_LOADED_VEHICLES_IDS) {
+            uint8_t varType;
+            buf >> varType;
+            ASSERT(varType == TYPE_STRINGLIST);
+            uint32_t count;
+            buf >> count;
+            EV_DEBUG << "TraCI reports " << count << " loaded vehicles." << endl;
+            for (uint32_t i = 0; i < count; ++i) {
+                buf >> idstring;
+                noteLoadedVehicle(idstring);
+            }
+        }
         else if (variable1_resp == VAR_ARRIVED_VEHICLES_IDS) {
             uint8_t varType;
             buf >> varType;
@@ -820,27 +1623,16 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             uint32_t count;
             buf >> count;
             EV_DEBUG << "TraCI reports " << count << " arrived vehicles." << endl;
+            uint32_t arrived = 0;
             for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
                 buf >> idstring;
-
-                if (subscribedVehicles.find(idstring) != subscribedVehicles.end()) {
-                    subscribedVehicles.erase(idstring);
-                    // no unsubscription via TraCI possible/necessary as of SUMO 1.0.0 (the vehicle has arrived)
-                }
-
-                // check if this object has been deleted already (e.g. because it was outside the ROI)
-                cModule* mod = getManagedModule(idstring);
-                if (mod) deleteManagedModule(idstring);
-
-                if (unEquippedHosts.find(idstring) != unEquippedHosts.end()) {
-                    unEquippedHosts.erase(idstring);
-                }
+                if (removeArrivedVehicle(idstring)) arrived++;
             }
+            deletePendingArrivals();
 
-            if ((count > 0) && (count >= activeVehicleCount) && autoShutdown) autoShutdownTriggered = true;
-            activeVehicleCount -= count;
-            drivingVehicleCount -= count;
+            if ((arrived > 0) && (arrived >= activeVehicleCount) && autoShutdown) autoShutdownTriggered = true;
+            activeVehicleCount -= arrived;
+            drivingVehicleCount -= arrived;
         }
         else if (variable1_resp == VAR_TELEPORT_STARTING_VEHICLES_IDS) {
             uint8_t varType;
@@ -850,7 +1642,6 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             buf >> count;
             EV_DEBUG << "TraCI reports " << count << " vehicles starting to teleport." << endl;
             for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
                 buf >> idstring;
 
                 // check if this object has been deleted already (e.g. because it was outside the ROI)
@@ -860,6 +1651,7 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
                 if (unEquippedHosts.find(idstring) != unEquippedHosts.end()) {
                     unEquippedHosts.erase(idstring);
                 }
+                dormantHosts.erase(idstring);
             }
 
             activeVehicleCount -= count;
@@ -873,7 +1665,6 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             buf >> count;
             EV_DEBUG << "TraCI reports " << count << " vehicles ending teleport." << endl;
             for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
                 buf >> idstring;
                 // adding modules is handled on the fly when entering/leaving the ROI
             }
@@ -889,7 +1680,6 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             buf >> count;
             EV_DEBUG << "TraCI reports " << count << " vehicles starting to park." << endl;
             for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
                 buf >> idstring;
 
                 cModule* mod = getManagedModule(idstring);
@@ -910,7 +1700,6 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             buf >> count;
             EV_DEBUG << "TraCI reports " << count << " vehicles ending to park." << endl;
             for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
                 buf >> idstring;
 
                 cModule* mod = getManagedModule(idstring);
@@ -940,7 +1729,6 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             buf >> count;
             EV_DEBUG << "TraCI reports " << count << " collided vehicles." << endl;
             for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
                 buf >> idstring;
                 cModule* mod = getManagedModule(idstring);
                 if (mod) {
@@ -957,22 +1745,244 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
     }
 }
 
-void TraCIScenarioManager::processVehicleSubscription(std::string objectId, TraCIBuffer& buf)
+void TraCIScenarioManager::instantiateHost(const std::string& nodeId, const Coord& position, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals, double length, double height, double width)
+{
+    const ModuleTemplate& moduleTemplate = getModuleTemplate(getVehicleTypeId(nodeId));
+
+    if (moduleTemplate.type) {
+        addModule(nodeId, moduleTemplate, position, edge, speed, heading, signals, length, height, width);
+        EV_DEBUG << "Added vehicle #" << nodeId << endl;
+    }
+}
+
+std::string TraCIScenarioManager::getVehicleTypeId(const std::string& nodeId)
+{
+    return commandIfc->vehicle(nodeId).getTypeId();
+}
+
+Coord TraCIScenarioManager::traci2omnet(const TraCICoord& coord) const
+{
+    return connection->traci2omnet(coord);
+}
+
+Heading TraCIScenarioManager::traci2omnetHeading(double heading) const
+{
+    return connection->traci2omnetHeading(heading);
+}
+
+bool TraCIScenarioManager::removeArrivedVehicle(const std::string& nodeId)
+{
+    if (traceWriter) traceWriter->addArrival(nodeId);
+
+    if (subscribedVehicles.find(nodeId) != subscribedVehicles.end()) {
+        subscribedVehicles.erase(nodeId);
+        // no unsubscription via TraCI possible/necessary as of SUMO 1.0.0 (the vehicle has arrived)
+    }
+
+    // check if this object has been deleted already (e.g. because it was outside the ROI)
+    cModule* mod = getManagedModule(nodeId);
+    if (mod) {
+        if (batchArrivals) {
+            pendingArrivals.push_back(nodeId);
+        }
+        else {
+            deleteManagedModule(nodeId);
+        }
+    }
+
+    if (unEquippedHosts.find(nodeId) != unEquippedHosts.end()) {
+        unEquippedHosts.erase(nodeId);
+    }
+    dormantHosts.erase(nodeId);
+    vehicleDimensions.erase(nodeId);
+    return true;
+}
+
+void TraCIScenarioManager::startTraceRecording(const TraCICoord& topleft, const TraCICoord& bottomright)
+{
+    std::string recordTraceFile = par("recordTraceFile").stringValue();
+    if (recordTraceFile.empty()) return;
+    traceWriter.reset(new TraCIMobilityTraceWriter(recordTraceFile, topleft, bottomright));
+}
+
+void TraCIScenarioManager::updateDormantHosts()
+{
+    if (!useDormantHosts) return;
+
+    // file the moves of this step under their new grid cells before searching them
+    connectionManager->commitPositionUpdates();
+
+    const double range = connectionManager->getMaxInterferenceDistance();
+    const double range2 = range * range;
+
+    // dormant hosts are partners of each other, so bucket them into cells of the interference distance
+    auto cellOf = [range](const Coord& c) {
+        return std::make_pair(static_cast<int64_t>(std::floor(c.x / range)), static_cast<int64_t>(std::floor(c.y / range)));
+    };
+    auto cellKey = [](std::pair<int64_t, int64_t> cell) {
+        return static_cast<uint64_t>(cell.first) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(cell.second);
+    };
+    std::unordered_map<uint64_t, std::vector<const Coord*>> cells;
+    for (const auto& dormant : dormantHosts) {
+        cells[cellKey(cellOf(dormant.second.position))].push_back(&dormant.second.position);
+    }
+    auto hasDormantPartner = [&](const Coord& pos) {
+        auto cell = cellOf(pos);
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            for (int64_t dy = -1; dy <= 1; ++dy) {
+                auto bucket = cells.find(cellKey({cell.first + dx, cell.second + dy}));
+                if (bucket == cells.end()) continue;
+                for (const Coord* other : bucket->second) {
+                    if ((other != &pos) && (other->sqrdist(pos) <= range2)) return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::string> wakeUp;
+    for (const auto& dormant : dormantHosts) {
+        if (connectionManager->hasNicInRange(dormant.second.position) || hasDormantPartner(dormant.second.position)) {
+            wakeUp.push_back(dormant.first);
+        }
+    }
+
+    // retire hosts that have been without partner for too long (checked before waking up others, which are not isolated)
+    if (dormantHostTimeout >= 0) {
+        std::vector<std::string> retire;
+        for (const auto& host : hosts) {
+            auto mobilityModules = getSubmodulesOfType<TraCIMobility>(host.second);
+            if (mobilityModules.empty()) continue;
+            Coord pos = mobilityModules.front()->getPositionAt(simTime());
+            if (connectionManager->hasNicInRange(pos, host.second->getId()) || hasDormantPartner(pos)) {
+                isolatedHosts.erase(host.first);
+                continue;
+            }
+            auto isolated = isolatedHosts.emplace(host.first, simTime()).first;
+            if (simTime() - isolated->second >= dormantHostTimeout) retire.push_back(host.first);
+        }
+        std::sort(retire.begin(), retire.end());
+        for (const auto& nodeId : retire) {
+            EV_DEBUG << "Vehicle #" << nodeId << " has no communication partner, becoming dormant" << endl;
+            deleteManagedModule(nodeId); // its record is re-created from the next subscription result
+        }
+    }
+
+    // instantiate in a fixed order, as this determines module indices
+    std::sort(wakeUp.begin(), wakeUp.end());
+    for (const auto& nodeId : wakeUp) {
+        DormantHost host = dormantHosts[nodeId];
+        dormantHosts.erase(nodeId);
+        instantiateHost(nodeId, host.position, host.edge, host.speed, host.heading, host.signals, host.length, host.height, host.width);
+    }
+}
+
+void TraCIScenarioManager::processVehicleContextSubscription(const std::string& objectId, TraCIBuffer& buf)
+{
+    uint8_t contextDomain;
+    buf >> contextDomain;
+    ASSERT(contextDomain == CMD_GET_VEHICLE_VARIABLE);
+    uint8_t variableNumber_resp;
+    buf >> variableNumber_resp;
+    uint32_t count;
+    buf >> count;
+    EV_DEBUG << "TraCI reports context subscription results for " << count << " vehicles." << endl;
+    std::string vehicleId; // reused for all vehicles, keeping its storage
+    for (uint32_t i = 0; i < count; ++i) {
+        buf >> vehicleId;
+        if (useRoiContextSubscription && !roiContextVehicles.insert(vehicleId).second) {
+            // already reported by the context of an overlapping shape or road
+            VehicleSubscriptionResult duplicate;
+            decodeVehicleVariables(variableNumber_resp, buf, duplicate);
+            continue;
+        }
+        processVehicleVariables(vehicleId, variableNumber_resp, buf);
+    }
+}
+
+void TraCIScenarioManager::removeVehiclesOutsideRoiContexts()
+{
+    std::vector<std::string> gone;
+    for (const auto& host : hosts) {
+        if (roiContextVehicles.find(host.first) == roiContextVehicles.end()) gone.push_back(host.first);
+    }
+    for (const auto& vehicleId : unEquippedHosts) {
+        if (roiContextVehicles.find(vehicleId) == roiContextVehicles.end()) gone.push_back(vehicleId);
+    }
+    for (const auto& host : dormantHosts) {
+        if (roiContextVehicles.find(host.first) == roiContextVehicles.end()) gone.push_back(host.first);
+    }
+    std::sort(gone.begin(), gone.end());
+    for (const auto& vehicleId : gone) {
+        leaveRegionOfInterest(vehicleId);
+    }
+    roiContextVehicles.clear();
+}
+
+void TraCIScenarioManager::leaveRegionOfInterest(const std::string& objectId)
 {
-    bool isSubscribed = (subscribedVehicles.find(objectId) != subscribedVehicles.end());
-    double px;
-    double py;
-    std::string edge;
-    double speed;
-    double angle_traci;
-    int signals;
-    double length;
-    double height;
-    double width;
-    int numRead = 0;
+    if (getManagedModule(objectId)) {
+        deleteManagedModule(objectId);
+        EV_DEBUG << "Vehicle #" << objectId << " left region of interest" << endl;
+    }
+    else if (unEquippedHosts.find(objectId) != unEquippedHosts.end()) {
+        unEquippedHosts.erase(objectId);
+        EV_DEBUG << "Vehicle (unequipped) # " << objectId << " left region of interest" << endl;
+    }
+    dormantHosts.erase(objectId);
+}
 
+void TraCIScenarioManager::processVehicleSubscription(const std::string& objectId, TraCIBuffer& buf)
+{
     uint8_t variableNumber_resp;
     buf >> variableNumber_resp;
+    processVehicleVariables(objectId, variableNumber_resp, buf);
+}
+
+void TraCIScenarioManager::processVehicleVariables(const std::string& objectId, uint8_t variableNumber_resp, TraCIBuffer& buf)
+{
+    // applying a result can subscribe to new vehicles, which decodes (and applies) their first results before returning
+    if (vehicleResultPoolDepth == vehicleResultPool.size()) vehicleResultPool.emplace_back();
+    VehicleSubscriptionResult& result = vehicleResultPool[vehicleResultPoolDepth++];
+    result.reset();
+    result.objectId = objectId;
+    decodeVehicleVariables(variableNumber_resp, buf, result);
+    try {
+        applyVehicleSubscription(result);
+    }
+    catch (...) {
+        vehicleResultPoolDepth--;
+        throw;
+    }
+    vehicleResultPoolDepth--;
+}
+
+void TraCIScenarioManager::VehicleSubscriptionResult::reset()
+{
+    objectId.clear();
+    px = 0;
+    py = 0;
+    edge.clear();
+    speed = 0;
+    angle_traci = 0;
+    signals = 0;
+    length = 0;
+    height = 0;
+    width = 0;
+    numRead = 0;
+    hasIdList = false;
+    idList.clear();
+    errorStatus = TraCIConstants::RTYPE_OK;
+    errorVariable = 0;
+    errorMessage.clear();
+    hasIgnoredVariable = false;
+    ignoredVariable = 0;
+    ignoredVariableType = 0;
+    decodeError.clear();
+}
+
+void TraCIScenarioManager::decodeVehicleVariables(uint8_t variableNumber_resp, TraCIBuffer& buf, VehicleSubscriptionResult& result) const
+{
     for (uint8_t j = 0; j < variableNumber_resp; ++j) {
         uint8_t variable1_resp;
         buf >> variable1_resp;
@@ -984,9 +1994,10 @@ void TraCIScenarioManager::processVehicleSubscription(std::string objectId, TraC
             ASSERT(varType == TYPE_STRING);
             std::string errormsg;
             buf >> errormsg;
-            if (isSubscribed) {
-                if (isokay == RTYPE_NOTIMPLEMENTED) throw cRuntimeError("TraCI server reported subscribing to vehicle variable 0x%2x not implemented (\"%s\"). Might need newer version.", variable1_resp, errormsg.c_str());
-                throw cRuntimeError("TraCI server reported error subscribing to vehicle variable 0x%2x (\"%s\").", variable1_resp, errormsg.c_str());
+            if (result.errorStatus == RTYPE_OK) {
+                result.errorStatus = isokay;
+                result.errorVariable = variable1_resp;
+                result.errorMessage = errormsg;
             }
         }
         else if (variable1_resp == ID_LIST) {
@@ -995,95 +2006,76 @@ void TraCIScenarioManager::processVehicleSubscription(std::string objectId, TraC
             ASSERT(varType == TYPE_STRINGLIST);
             uint32_t count;
             buf >> count;
-            EV_DEBUG << "TraCI reports " << count << " active vehicles." << endl;
-            ASSERT(count == activeVehicleCount);
-            std::set<std::string> drivingVehicles;
+            result.hasIdList = true;
+            result.idList.resize(count);
             for (uint32_t i = 0; i < count; ++i) {
-                std::string idstring;
-                buf >> idstring;
-                drivingVehicles.insert(idstring);
-            }
-
-            // check for vehicles that need subscribing to
-            std::set<std::string> needSubscribe;
-            std::set_difference(drivingVehicles.begin(), drivingVehicles.end(), subscribedVehicles.begin(), subscribedVehicles.end(), std::inserter(needSubscribe, needSubscribe.begin()));
-            for (std::set<std::string>::const_iterator i = needSubscribe.begin(); i != needSubscribe.end(); ++i) {
-                subscribedVehicles.insert(*i);
-                subscribeToVehicleVariables(*i);
-            }
-
-            // check for vehicles that need unsubscribing from
-            std::set<std::string> needUnsubscribe;
-            std::set_difference(subscribedVehicles.begin(), subscribedVehicles.end(), drivingVehicles.begin(), drivingVehicles.end(), std::inserter(needUnsubscribe, needUnsubscribe.begin()));
-            for (std::set<std::string>::const_iterator i = needUnsubscribe.begin(); i != needUnsubscribe.end(); ++i) {
-                subscribedVehicles.erase(*i);
-                unsubscribeFromVehicleVariables(*i);
+                buf.readInto(result.idList[i]);
             }
         }
         else if (variable1_resp == VAR_POSITION) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == POSITION_2D);
-            buf >> px;
-            buf >> py;
-            numRead++;
+            buf >> result.px;
+            buf >> result.py;
+            result.numRead++;
         }
         else if (variable1_resp == VAR_ROAD_ID) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == TYPE_STRING);
-            buf >> edge;
-            numRead++;
+            buf >> result.edge;
+            result.numRead++;
         }
         else if (variable1_resp == VAR_SPEED) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == TYPE_DOUBLE);
-            buf >> speed;
-            numRead++;
+            buf >> result.speed;
+            result.numRead++;
         }
         else if (variable1_resp == VAR_ANGLE) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == TYPE_DOUBLE);
-            buf >> angle_traci;
-            numRead++;
+            buf >> result.angle_traci;
+            result.numRead++;
         }
         else if (variable1_resp == VAR_SIGNALS) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == TYPE_INTEGER);
-            buf >> signals;
-            numRead++;
+            buf >> result.signals;
+            result.numRead++;
         }
         else if (variable1_resp == VAR_LENGTH) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == TYPE_DOUBLE);
-            buf >> length;
-            numRead++;
+            buf >> result.length;
+            result.numRead++;
         }
         else if (variable1_resp == VAR_HEIGHT) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == TYPE_DOUBLE);
-            buf >> height;
-            numRead++;
+            buf >> result.height;
+            result.numRead++;
         }
         else if (variable1_resp == VAR_WIDTH) {
             uint8_t varType;
             buf >> varType;
             ASSERT(varType == TYPE_DOUBLE);
-            buf >> width;
-            numRead++;
+            buf >> result.width;
+            result.numRead++;
         }
         else if (ignoreUnknownSubscriptionResults) {
-            static bool haveWarned = false;
             uint8_t varType;
             buf >> varType;
-            if (!haveWarned) {
-                EV_WARN << "Warning: Got a variable that I don't care about (variable " << variable1_resp << ", type " << varType << "). Trying my best to ignore it. This warning will not be repeated." << std::endl;
-                haveWarned = true;
+            if (!result.hasIgnoredVariable) {
+                result.hasIgnoredVariable = true;
+                result.ignoredVariable = variable1_resp;
+                result.ignoredVariableType = varType;
             }
             if (varType == TYPE_STRING) {
                 std::string foo;
@@ -1107,11 +2099,68 @@ void TraCIScenarioManager::processVehicleSubscription(std::string objectId, TraC
                 buf >> z;
             }
             else {
-                throw cRuntimeError("Received unhandled (and non-ignorable) vehicle subscription result");
+                result.decodeError = "Received unhandled (and non-ignorable) vehicle subscription result";
+                return;
             }
         }
         else {
-            throw cRuntimeError("Received unhandled vehicle subscription result");
+            result.decodeError = "Received unhandled vehicle subscription result";
+            return;
+        }
+    }
+}
+
+void TraCIScenarioManager::applyVehicleSubscription(const VehicleSubscriptionResult& result)
+{
+    const std::string& objectId = result.objectId;
+    bool isSubscribed = useContextSubscription || (subscribedVehicles.find(objectId) != subscribedVehicles.end());
+
+    if (result.hasIgnoredVariable) {
+        static bool haveWarned = false;
+        if (!haveWarned) {
+            EV_WARN << "Warning: Got a variable that I don't care about (variable " << result.ignoredVariable << ", type " << result.ignoredVariableType << "). Trying my best to ignore it. This warning will not be repeated." << std::endl;
+            haveWarned = true;
+        }
+    }
+    if (!result.decodeError.empty()) {
+        throw cRuntimeError("%s", result.decodeError.c_str());
+    }
+    if ((result.errorStatus != RTYPE_OK) && isSubscribed) {
+        if (result.errorStatus == RTYPE_NOTIMPLEMENTED) throw cRuntimeError("TraCI server reported subscribing to vehicle variable 0x%2x not implemented (\"%s\"). Might need newer version.", result.errorVariable, result.errorMessage.c_str());
+        throw cRuntimeError("TraCI server reported error subscribing to vehicle variable 0x%2x (\"%s\").", result.errorVariable, result.errorMessage.c_str());
+    }
+
+    if (result.hasIdList) {
+        uint32_t count = result.idList.size();
+        EV_DEBUG << "TraCI reports " << count << " active vehicles." << endl;
+        ASSERT(count == activeVehicleCount);
+        // a sorted list of pointers to the ids is enough to look them up (and needs no allocations once it has grown)
+        std::vector<const std::string*>& drivingVehicles = stepScratch.sortedIds;
+        drivingVehicles.clear();
+        for (const auto& vehicleId : result.idList) drivingVehicles.push_back(&vehicleId);
+        auto lessById = [](const std::string* a, const std::string* b) { return *a < *b; };
+        std::sort(drivingVehicles.begin(), drivingVehicles.end(), lessById);
+        drivingVehicles.erase(std::unique(drivingVehicles.begin(), drivingVehicles.end(), [](const std::string* a, const std::string* b) { return *a == *b; }), drivingVehicles.end());
+
+        // check for vehicles that need subscribing to (in lexicographic order, as this determines the order modules get created in)
+        std::vector<std::string> needSubscribe;
+        for (const std::string* vehicleId : drivingVehicles) {
+            if (subscribedVehicles.find(*vehicleId) == subscribedVehicles.end()) needSubscribe.push_back(*vehicleId);
+        }
+        for (const auto& vehicleId : needSubscribe) {
+            subscribedVehicles.insert(vehicleId);
+            subscribeToVehicleVariables(vehicleId);
+        }
+
+        // check for vehicles that need unsubscribing from
+        std::vector<std::string> needUnsubscribe;
+        for (const auto& vehicleId : subscribedVehicles) {
+            if (!std::binary_search(drivingVehicles.begin(), drivingVehicles.end(), &vehicleId, lessById)) needUnsubscribe.push_back(vehicleId);
+        }
+        std::sort(needUnsubscribe.begin(), needUnsubscribe.end());
+        for (const auto& vehicleId : needUnsubscribe) {
+            subscribedVehicles.erase(vehicleId);
+            unsubscribeFromVehicleVariables(vehicleId);
         }
     }
 
@@ -1119,26 +2168,63 @@ void TraCIScenarioManager::processVehicleSubscription(std::string objectId, TraC
     if (!isSubscribed) return;
 
     // make sure we got updates for all attributes
-    if (numRead != 8) return;
+    if (result.numRead != static_cast<int>(vehicleVariables.size())) return;
+
+    if (subscribeVehicleDimensions) {
+        applyVehicleState(objectId, TraCICoord(result.px, result.py), result.edge, result.speed, result.angle_traci, result.signals, result.length, result.height, result.width);
+        return;
+    }
+    const VehicleDimensions& dimensions = getVehicleDimensions(objectId);
+    applyVehicleState(objectId, TraCICoord(result.px, result.py), result.edge, result.speed, result.angle_traci, result.signals, dimensions.length, dimensions.height, dimensions.width);
+}
+
+const TraCIScenarioManager::VehicleDimensions& TraCIScenarioManager::getVehicleDimensions(const std::string& vehicleId)
+{
+    auto found = vehicleDimensions.find(vehicleId);
+    if (found != vehicleDimensions.end()) return found->second;
+
+    // dimensions do not change while a vehicle is driving, so query them once, in a single round trip
+    VehicleDimensions& dimensions = vehicleDimensions[vehicleId];
+    commandIfc->vehicle(vehicleId).queueGetDimensions([&dimensions](double length, double height, double width) {
+        dimensions.length = length;
+        dimensions.height = height;
+        dimensions.width = width;
+    });
+    connection->flushQueries();
+    return dimensions;
+}
+
+void TraCIScenarioManager::applyVehicleState(const std::string& objectId, const TraCICoord& position, const std::string& edge, double speed, double angle_traci, int signals, double length, double height, double width)
+{
+    if (traceWriter) {
+        TraCIMobilityTraceVehicle vehicle;
+        vehicle.id = objectId;
+        if (!traceWriter->hasVehicle(objectId)) vehicle.typeId = getVehicleTypeId(objectId);
+        vehicle.position = position;
+        vehicle.edge = edge;
+        vehicle.speed = speed;
+        vehicle.angle = angle_traci;
+        vehicle.signals = signals;
+        vehicle.length = length;
+        vehicle.height = height;
+        vehicle.width = width;
+        traceWriter->addVehicle(vehicle);
+    }
+
+    const double px = position.x;
+    const double py = position.y;
 
-    Coord p = connection->traci2omnet(TraCICoord(px, py));
+    Coord p = traci2omnet(position);
     if ((p.x < 0) || (p.y < 0)) throw cRuntimeError("received bad node position (%.2f, %.2f), translated to (%.2f, %.2f)", px, py, p.x, p.y);
 
-    Heading heading = connection->traci2omnetHeading(angle_traci);
+    Heading heading = traci2omnetHeading(angle_traci);
 
     cModule* mod = getManagedModule(objectId);
 
     // is it in the ROI?
-    bool inRoi = !roi.hasConstraints() ? true : (roi.onAnyRectangle(TraCICoord(px, py)) || roi.partOfRoads(edge));
+    bool inRoi = !roi.hasConstraints() ? true : (roi.onAnyShape(position) || roi.partOfRoads(edge));
     if (!inRoi) {
-        if (mod) {
-            deleteManagedModule(objectId);
-            EV_DEBUG << "Vehicle #" << objectId << " left region of interest" << endl;
-        }
-        else if (unEquippedHosts.find(objectId) != unEquippedHosts.end()) {
-            unEquippedHosts.erase(objectId);
-            EV_DEBUG << "Vehicle (unequipped) # " << objectId << " left region of interest" << endl;
-        }
+        leaveRegionOfInterest(objectId);
         return;
     }
 
@@ -1147,52 +2233,139 @@ void TraCIScenarioManager::processVehicleSubscription(std::string objectId, TraC
     }
 
     if (!mod) {
-        // no such module - need to create
-        std::string vType = commandIfc->vehicle(objectId).getTypeId();
-        std::string mType, mName, mDisplayString;
-        TypeMapping::iterator iType, iName, iDisplayString;
-
-        TypeMapping::iterator i;
-        iType = moduleType.find(vType);
-        if (iType == moduleType.end()) {
-            iType = moduleType.find("*");
-            if (iType == moduleType.end()) throw cRuntimeError("cannot find a module type for vehicle type \"%s\"", vType.c_str());
-        }
-        mType = iType->second;
-        // search for module name
-        iName = moduleName.find(vType);
-        if (iName == moduleName.end()) {
-            iName = moduleName.find(std::string("*"));
-            if (iName == moduleName.end()) throw cRuntimeError("cannot find a module name for vehicle type \"%s\"", vType.c_str());
-        }
-        mName = iName->second;
-        if (moduleDisplayString.size() != 0) {
-            iDisplayString = moduleDisplayString.find(vType);
-            if (iDisplayString == moduleDisplayString.end()) {
-                iDisplayString = moduleDisplayString.find("*");
-                if (iDisplayString == moduleDisplayString.end()) throw cRuntimeError("cannot find a module display string for vehicle type \"%s\"", vType.c_str());
-            }
-            mDisplayString = iDisplayString->second;
-        }
-        else {
-            mDisplayString = "";
-        }
-
-        if (mType != "0") {
-            addModule(objectId, mType, mName, mDisplayString, p, edge, speed, heading, VehicleSignalSet(signals), length, height, width);
-            EV_DEBUG << "Added vehicle #" << objectId << endl;
+        // no such module - need to create (or, for dormant hosts, to remember where it would be)
+        if (useDormantHosts) {
+            dormantHosts[objectId] = {p, edge, speed, heading, VehicleSignalSet(signals), length, height, width};
+            return;
         }
+        instantiateHost(objectId, p, edge, speed, heading, VehicleSignalSet(signals), length, height, width);
     }
     else {
-        // module existed - update position
+        // module existed - update position (unless it is only updated coarsely and the next update is not yet due)
+        if (isCoarseUpdatePending(mod, position, edge, speed)) return;
+        if (skipUnchangedUpdates && keepUnchangedModuleState(mod, p, edge, speed, heading, VehicleSignalSet(signals))) return;
         EV_DEBUG << "module " << objectId << " moving to " << p.x << "," << p.y << endl;
         updateModulePosition(mod, p, edge, speed, heading, VehicleSignalSet(signals));
         emit(traciModuleUpdatedSignal, mod);
     }
 }
 
+void TraCIScenarioManager::updateRealTimeSchedule(simtime_t stepTime, std::chrono::steady_clock::time_point stepWallEnd)
+{
+    if (!hasRealTimeStart) {
+        realTimeStart = stepWallEnd;
+        realTimeStartSimTime = stepTime;
+        hasRealTimeStart = true;
+        return;
+    }
+
+    // the next step is due in real time once its simulation time has passed on the wall clock
+    auto nextStepDue = realTimeStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>((stepTime + updateInterval - realTimeStartSimTime).dbl() / realTimeFactor));
+    double slack = std::chrono::duration<double>(nextStepDue - stepWallEnd).count();
+    worstSlack = std::min(worstSlack, slack);
+    emit(traciStepSlackSignal, slack);
+
+    if (slack < 0) {
+        deadlineMisses++;
+        if (!behindSchedule) {
+            EV_WARN << "Step at t=" << stepTime << " finished " << -slack << "s after the next step was due, reducing non-critical work" << endl;
+            behindSchedule = true;
+            if (behindScheduleCoarseUpdateInterval > 0) coarseUpdateInterval = behindScheduleCoarseUpdateInterval;
+        }
+    }
+    else if (behindSchedule && (slack >= updateInterval.dbl() / realTimeFactor / 2)) {
+        // caught up with some margin to spare: back to full fidelity
+        EV_INFO << "Back on schedule at t=" << stepTime << endl;
+        behindSchedule = false;
+        coarseUpdateInterval = configuredCoarseUpdateInterval;
+    }
+}
+
+void TraCIScenarioManager::processSubscriptionResults(uint32_t count, TraCIBuffer& buf)
+{
+    // phase one: split the message into its subscription results and decode vehicle variables, touching no modules
+    // (all containers are reused from the last step, keeping their storage)
+    StepDecodeScratch& scratch = stepScratch;
+    std::vector<TraCIBuffer>& results = scratch.results;
+    std::vector<size_t>& vehicleResultIndex = scratch.vehicleResultIndex;
+    std::vector<size_t>& vehicleResultOrigin = scratch.vehicleResultOrigin;
+    std::vector<uint8_t>& vehicleVariableNumbers = scratch.vehicleVariableNumbers;
+    std::vector<VehicleSubscriptionResult>& vehicleResults = scratch.vehicleResults;
+    scratch.numResults = 0;
+    scratch.numVehicleResults = 0;
+    vehicleResultIndex.clear();
+    vehicleResultOrigin.clear();
+    vehicleVariableNumbers.clear();
+    if (results.size() < count) results.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        TraCIBuffer& result = results[scratch.numResults++];
+        buf.readCommand(result);
+        uint8_t cmdLength_resp;
+        result >> cmdLength_resp;
+        uint32_t cmdLengthExt_resp;
+        result >> cmdLengthExt_resp;
+        uint8_t commandId_resp;
+        result >> commandId_resp;
+        std::string& objectId_resp = scratch.objectId;
+        result >> objectId_resp;
+
+        // results for individual vehicles have no side effects until applied, so they can be decoded independently
+        if ((commandId_resp == RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE) && !objectId_resp.empty()) {
+            uint8_t variableNumber_resp;
+            result >> variableNumber_resp;
+            vehicleResultIndex.push_back(scratch.numVehicleResults);
+            vehicleResultOrigin.push_back(i);
+            vehicleVariableNumbers.push_back(variableNumber_resp);
+            if (vehicleResults.size() == scratch.numVehicleResults) vehicleResults.emplace_back();
+            VehicleSubscriptionResult& vehicleResult = vehicleResults[scratch.numVehicleResults++];
+            vehicleResult.reset();
+            vehicleResult.objectId = objectId_resp;
+        }
+        else {
+            vehicleResultIndex.push_back(std::string::npos);
+            result.rewind();
+        }
+    }
+
+    auto decode = [&](size_t i) {
+        decodeVehicleVariables(vehicleVariableNumbers[i], results[vehicleResultOrigin[i]], vehicleResults[i]);
+    };
+    if (decoderPool) {
+        decoderPool->run(scratch.numVehicleResults, decode);
+    }
+    else {
+        for (size_t i = 0; i < scratch.numVehicleResults; ++i) decode(i);
+    }
+
+    // phase two: apply all results to modules, in the order they were received
+    for (uint32_t i = 0; i < count; ++i) {
+        if (vehicleResultIndex[i] != std::string::npos) {
+            applyVehicleSubscription(vehicleResults[vehicleResultIndex[i]]);
+        }
+        else {
+            processSubcriptionResult(results[i]);
+        }
+    }
+
+    // vehicles that drove out of every ROI context are no longer reported at all
+    if (useRoiContextSubscription) removeVehiclesOutsideRoiContexts();
+}
+
+void TraCIScenarioManager::processStreamedSubscriptionResults()
+{
+    // results are applied in the order they were received, any query they issue first waits for the rest of the step
+    TraCIBuffer& result = stepScratch.streamedResult;
+    while (connection->nextStreamedCommand(result)) {
+        processSubcriptionResult(result);
+    }
+
+    // vehicles that drove out of every ROI context are no longer reported at all
+    if (useRoiContextSubscription) removeVehiclesOutsideRoiContexts();
+}
+
 void TraCIScenarioManager::processSubcriptionResult(TraCIBuffer& buf)
 {
+    VEINS_PROFILE_SCOPE("TraCIScenarioManager::processSubcriptionResult");
     uint8_t cmdLength_resp;
     buf >> cmdLength_resp;
     uint32_t cmdLengthExt_resp;
@@ -1205,12 +2378,18 @@ void TraCIScenarioManager::processSubcriptionResult(TraCIBuffer& buf)
     if (commandId_resp == RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE) {
         processVehicleSubscription(objectId_resp, buf);
     }
+    else if ((commandId_resp == RESPONSE_SUBSCRIBE_SIM_CONTEXT) || (commandId_resp == RESPONSE_SUBSCRIBE_POI_CONTEXT) || (commandId_resp == RESPONSE_SUBSCRIBE_EDGE_CONTEXT)) {
+        processVehicleContextSubscription(objectId_resp, buf);
+    }
     else if (commandId_resp == RESPONSE_SUBSCRIBE_SIM_VARIABLE) {
         processSimSubscription(objectId_resp, buf);
     }
     else if (commandId_resp == RESPONSE_SUBSCRIBE_TL_VARIABLE) {
         processTrafficLightSubscription(objectId_resp, buf);
     }
+    else if ((commandId_resp == RESPONSE_SUBSCRIBE_LANEAREA_VARIABLE) || (commandId_resp == RESPONSE_SUBSCRIBE_INDUCTIONLOOP_VARIABLE)) {
+        processDetectorSubscription(objectId_resp, buf);
+    }
     else {
         throw cRuntimeError("Received unhandled subscription result");
     }
@@ -22,10 +22,15 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
+#include <limits>
 #include <list>
 #include <queue>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "veins/veins.h"
 
@@ -33,6 +38,7 @@
 #include "veins/base/modules/BaseWorldUtility.h"
 #include "veins/base/connectionManager/BaseConnectionManager.h"
 #include "veins/base/utils/FindModule.h"
+#include "veins/base/utils/WorkerPool.h"
 #include "veins/modules/obstacle/ObstacleControl.h"
 #include "veins/modules/obstacle/VehicleObstacleControl.h"
 #include "veins/modules/mobility/traci/TraCIBuffer.h"
@@ -41,6 +47,13 @@
 #include "veins/modules/mobility/traci/TraCICoord.h"
 #include "veins/modules/mobility/traci/VehicleSignal.h"
 #include "veins/modules/mobility/traci/TraCIRegionOfInterest.h"
+#include "veins/modules/mobility/traci/TraCIDetectorStates.h"
+#include "veins/modules/mobility/traci/SumoNetwork.h"
+#include "veins/modules/mobility/traci/LaneIndex.h"
+#include "veins/modules/mobility/traci/TraCIMobilityTrace.h"
+#include "veins/modules/mobility/traci/TraCIVehicleLayer.h"
+#include "veins/base/utils/ModuleRegistry.h"
+#include "veins/base/utils/MemoryAccounting.h"
 
 namespace veins {
 
@@ -75,8 +88,14 @@ public:
     static const simsignal_t traciTrafficLightAddedSignal;
     static const simsignal_t traciTrafficLightRemovedSignal;
     static const simsignal_t traciTrafficLightUpdatedSignal;
+    static const simsignal_t traciDetectorUpdatedSignal; /**< index (in getDetectorStates()) of a subscribed detector whose values changed in this step */
     static const simsignal_t traciTimestepBeginSignal;
     static const simsignal_t traciTimestepEndSignal;
+    static const simsignal_t traciStepWaitTimeSignal; /**< wall time spent waiting for the TraCI server to deliver a step, see recordStepTimes */
+    static const simsignal_t traciStepDecodeTimeSignal; /**< wall time spent decoding and applying the results of a step, not counting traciStepModuleTimeSignal */
+    static const simsignal_t traciStepModuleTimeSignal; /**< wall time spent creating and deleting host modules during a step */
+    static const simsignal_t traciStepNetworkTimeSignal; /**< wall time spent processing other events between two steps */
+    static const simsignal_t traciStepSlackSignal; /**< wall time left after a step until the next one is due in real time (negative: deadline missed), see realTimeMonitoring */
 
     TraCIScenarioManager();
     ~TraCIScenarioManager() override;
@@ -95,6 +114,14 @@ public:
         return static_cast<bool>(connection);
     }
 
+    /**
+     * returns whether commands that would change the state of the TraCI server are refused (e.g., as it is shared with other simulations)
+     */
+    bool isReadOnly() const
+    {
+        return readOnly;
+    }
+
     TraCICommandInterface* getCommandInterface() const
     {
         return commandIfc.get();
@@ -105,12 +132,49 @@ public:
         return connection.get();
     }
 
+    /**
+     * return network geometry read from sumoNetworkFile, or nullptr if none was given
+     */
+    const SumoNetwork* getSumoNetwork() const
+    {
+        return sumoNetwork.get();
+    }
+
+    /**
+     * return the index of the lanes of sumoNetworkFile, or nullptr if none was given
+     */
+    const LaneIndex* getLaneIndex() const
+    {
+        return laneIndex.get();
+    }
+
+    /**
+     * return the lane nearest to the given (OMNeT++) position within maxDistance, looked up in the lane index instead of asking the TraCI server
+     */
+    LaneIndex::Match matchToLane(const Coord& position, double maxDistance) const;
+
+    /**
+     * return the wall-clock time spent waiting for and processing simulation steps of the TraCI server so far
+     */
+    std::chrono::steady_clock::duration getTraciStepWallTime() const
+    {
+        return traciStepWallTime;
+    }
+
+    /**
+     * return the latest values of the detectors subscribed to, see subscribeDetectors
+     */
+    const TraCIDetectorStates& getDetectorStates() const
+    {
+        return detectorStates;
+    }
+
     bool getAutoShutdownTriggered()
     {
         return autoShutdownTriggered;
     }
 
-    const std::map<std::string, cModule*>& getManagedHosts()
+    const std::unordered_map<std::string, cModule*>& getManagedHosts()
     {
         return hosts;
     }
@@ -135,6 +199,18 @@ protected:
     TypeMapping moduleType; /**< module type to be used in the simulation for each managed vehicle */
     TypeMapping moduleName; /**< module name to be used in the simulation for each managed vehicle */
     TypeMapping moduleDisplayString; /**< module displayString to be used in the simulation for each managed vehicle */
+    /**
+     * @brief What hosts of one SUMO vehicle type are built from, resolved from the type mappings at first use.
+     */
+    struct ModuleTemplate {
+        cModuleType* type = nullptr; /**< module type to instantiate, nullptr if vehicles of this type are not to be instantiated (module type "0") */
+        std::string name; /**< module name (of the module vector) */
+        bool hasDisplayString = false; /**< whether displayString is to be applied */
+        cDisplayString displayString; /**< parsed module display string */
+        std::vector<std::pair<cModule*, simtime_t>>* recycledModules = nullptr; /**< pool of finished hosts of this module type and name, see recycledModules */
+        std::deque<cModule*>* prebuiltModules = nullptr; /**< hosts of this module type and name built ahead of departures, see prebuiltModules */
+    };
+    std::unordered_map<std::string, ModuleTemplate> moduleTemplates; /**< ModuleTemplate by SUMO vehicle type, see getModuleTemplate() */
     std::string host;
     int port;
 
@@ -142,24 +218,109 @@ protected:
     std::string trafficLightModuleName; /**< module name to be used in the simulation for each managed traffic light */
     std::string trafficLightModuleDisplayString; /**< module displayString to be used in the simulation for each managed vehicle */
     std::vector<std::string> trafficLightModuleIds; /**< list of traffic light module ids that is subscribed to (whitelist) */
+    bool subscribeDetectors; /**< whether the values of lane area detectors and induction loops are received via subscriptions, see getDetectorStates() */
+    std::vector<std::string> detectorIds; /**< list of detector ids that is subscribed to (whitelist) */
+    TraCIDetectorStates detectorStates; /**< latest values of all detectors subscribed to */
 
     bool autoShutdown; /**< Shutdown module as soon as no more vehicles are in the simulation */
     double penetrationRate;
     bool ignoreGuiCommands; /**< whether to ignore all TraCI commands that only make sense when the server has a graphical user interface */
     int order; // specific position in the multi-client execution order of the TraCI server to request upon connecting (-1: do not request a position)
+    bool readOnly; /**< whether commands that would change the state of the TraCI server are refused, see TraCIConnection::setReadOnly() */
     bool ignoreUnknownSubscriptionResults; // whether to (try and) ignore any subscription result we did not request (but another client might have)
+    bool useContextSubscription; /**< whether vehicle variables are received via a single simulation context subscription instead of per-vehicle subscriptions */
+    bool useRoiContextSubscription; /**< whether the context subscriptions only cover the region of interest (plus roiContextMargin), so SUMO does not report vehicles anywhere else */
+    bool subscribeVehicleDimensions; /**< whether length, height and width of each vehicle are part of its subscription (false: queried once, see getVehicleDimensions()) */
+    bool subscribeVehicleSignals; /**< whether the signals of each vehicle are part of its subscription (false: vehicles never signal) */
+    bool subscribeVehicleRoadId; /**< whether the road of each vehicle is part of its subscription (false: vehicles report no road) */
+    std::vector<uint8_t> vehicleVariables; /**< variables subscribed to for each vehicle; decodeVehicleVariables() has to receive all of them */
+
+    /**
+     * static dimensions of a vehicle, see subscribeVehicleDimensions
+     */
+    struct VehicleDimensions {
+        double length = 0;
+        double height = 0;
+        double width = 0;
+    };
+    std::unordered_map<std::string, VehicleDimensions> vehicleDimensions; /**< dimensions of vehicles queried so far, by SUMO id */
+    double roiContextMargin; /**< distance around the region of interest within which vehicles are still reported, see useRoiContextSubscription */
+    std::unordered_set<std::string> roiContextVehicles; /**< vehicles reported by any ROI context subscription in the current step */
+    std::shared_ptr<const SumoNetwork> sumoNetwork; /**< network geometry read from sumoNetworkFile (nullptr if none was given), shared by all runs of this process (see SharedDataRegistry) */
+    std::shared_ptr<const LaneIndex> laneIndex; /**< index of the lanes of sumoNetwork (nullptr if none was given), shared like it */
+    std::unique_ptr<TraCIMobilityTraceWriter> traceWriter; /**< records vehicle updates to recordTraceFile (nullptr if none was given) */
+    std::shared_ptr<WorkerPool> decoderPool; /**< worker threads for decoding vehicle subscription results (nullptr: decode on the simulation thread) */
     TraCIRegionOfInterest roi; /**< Can return whether a given position lies within the simulation's region of interest. Modules are destroyed and re-created as managed vehicles leave and re-enter the ROI */
+    simtime_t coarseUpdateInterval; /**< interval at which vehicles outside fineMobilityRegion, or standing still, get mobility updates (0: every step) */
+    TraCIRegionOfInterest fineMobilityRegion; /**< region in which vehicles get mobility updates at every step */
+    simtime_t configuredCoarseUpdateInterval; /**< coarseUpdateInterval as configured, restored once back on schedule */
+    bool skipUnchangedUpdates; /**< whether vehicles reporting the state applied last get no module update (and no signals), see keepUnchangedModuleState() */
+    uint64_t numUnchangedUpdates; /**< number of module updates skipped for an unchanged vehicle state */
+    bool batchArrivals; /**< whether the modules of vehicles arrived in a step are deleted together, see deleteManagedModules() */
+    std::vector<std::string> pendingArrivals; /**< arrived vehicles whose modules are still to be deleted (if batchArrivals is set) */
+
+    bool realTimeMonitoring; /**< whether each step is checked against a real-time schedule, see updateRealTimeSchedule() */
+    double realTimeFactor; /**< simulated seconds per wall second of the real-time schedule */
+    simtime_t behindScheduleCoarseUpdateInterval; /**< coarseUpdateInterval to use while behind schedule (0: keep the configured one) */
+    bool behindSchedule; /**< whether the last step missed its deadline (and the schedule has not been caught up with since) */
+    bool hasRealTimeStart;
+    std::chrono::steady_clock::time_point realTimeStart; /**< wall time of the first step */
+    simtime_t realTimeStartSimTime; /**< simulation time of the first step */
+    uint64_t deadlineMisses; /**< number of steps that finished after the next one was due */
+    double worstSlack; /**< smallest slack of any step, in seconds */
+
+    /**
+     * equipped vehicle whose module has not been instantiated yet, see useDormantHosts
+     */
+    struct DormantHost {
+        Coord position;
+        std::string edge;
+        double speed;
+        Heading heading;
+        VehicleSignalSet signals;
+        double length;
+        double height;
+        double width;
+    };
+    bool useDormantHosts; /**< whether equipped vehicles stay dormant until they have a communication partner */
+    simtime_t dormantHostTimeout; /**< time without communication partner after which a host becomes dormant again (-1: never) */
+    BaseConnectionManager* connectionManager; /**< consulted for nics near dormant hosts (nullptr unless useDormantHosts) */
+    std::unordered_map<std::string, DormantHost> dormantHosts; /**< dormant vehicles, by SUMO id */
+    std::unordered_map<std::string, simtime_t> isolatedHosts; /**< instantiated hosts without communication partner, and since when */
+    std::string saveStateFile; /**< file to save the simulation state to (empty: never) */
+    simtime_t saveStateAt; /**< when to save the simulation state */
+    bool stateSaved; /**< whether the simulation state has been saved already */
+    bool streamStepResponses; /**< whether the subscription results of a step are applied while the I/O thread of the connection still receives the rest */
+    bool pipelineSteps; /**< whether the next simulation step is requested right after the current one has been received (reverts to false on any other TraCI command) */
+    int maxRecycledModules; /**< maximum number of finished hosts kept for reuse, per module type and name */
+    std::map<std::pair<std::string, std::string>, std::vector<std::pair<cModule*, simtime_t>>> recycledModules; /**< finished hosts kept for reuse (with the time they were parked), by module type and name */
+    std::unordered_map<std::string, bool> reusableModuleTypes; /**< caches isReusableModule() by module type */
+    int prebuildModules; /**< number of vehicles expected to depart next that hosts are built for ahead of time, see prebuildExpectedModules() (0: never) */
+    std::map<std::pair<std::string, std::string>, std::deque<cModule*>> prebuiltModules; /**< hosts built (but not initialized) ahead of departures, by module type and name, oldest (lowest index) first */
+    std::list<std::pair<std::string, const ModuleTemplate*>> expectedDepartures; /**< vehicles loaded by the TraCI server that have not departed yet, in order of loading, with their module template (nullptr while their type is not known yet) */
+    std::unordered_map<std::string, decltype(expectedDepartures)::iterator> expectedDepartureIndex; /**< entries of expectedDepartures by vehicle id */
+    long numModulesPrebuilt; /**< number of hosts built ahead of departures */
+    long numPrebuiltModulesBound; /**< number of hosts built ahead of departures that were bound to a departing vehicle */
     double areaSum;
+    std::chrono::steady_clock::duration traciStepWallTime; /**< wall-clock time spent waiting for and processing simulation steps of the TraCI server */
+    bool recordStepTimes; /**< whether the wall time of each step is broken down into phases, emitted as signals and summarized in finish() */
+    std::chrono::steady_clock::duration stepModuleTime; /**< wall time spent creating and deleting host modules in the current step (only tracked if recordStepTimes) */
+    std::chrono::steady_clock::time_point lastStepWallEnd; /**< when the previous step was done (only tracked if recordStepTimes) */
+    bool hasLastStepWallEnd;
+    std::vector<double> stepWaitTimes; /**< samples of traciStepWaitTimeSignal, in seconds */
+    std::vector<double> stepDecodeTimes; /**< samples of traciStepDecodeTimeSignal, in seconds */
+    std::vector<double> stepModuleTimes; /**< samples of traciStepModuleTimeSignal, in seconds */
+    std::vector<double> stepNetworkTimes; /**< samples of traciStepNetworkTimeSignal, in seconds */
 
     AnnotationManager* annotations;
     std::unique_ptr<TraCIConnection> connection;
     std::unique_ptr<TraCICommandInterface> commandIfc;
 
     size_t nextNodeVectorIndex; /**< next OMNeT++ module vector index to use */
-    std::map<std::string, cModule*> hosts; /**< vector of all hosts managed by us */
-    std::set<std::string> unEquippedHosts;
-    std::set<std::string> subscribedVehicles; /**< all vehicles we have already subscribed to */
-    std::map<std::string, cModule*> trafficLights; /**< vector of all traffic lights managed by us */
+    std::unordered_map<std::string, cModule*> hosts; /**< vector of all hosts managed by us */
+    std::unordered_set<std::string> unEquippedHosts;
+    std::unordered_set<std::string> subscribedVehicles; /**< all vehicles we have already subscribed to */
+    std::unordered_map<std::string, cModule*> trafficLights; /**< vector of all traffic lights managed by us */
     uint32_t activeVehicleCount; /**< number of vehicles, be it parking or driving **/
     uint32_t parkingVehicleCount; /**< number of parking vehicles, derived from parking start/end events */
     uint32_t drivingVehicleCount; /**< number of driving, as reported by sumo */
@@ -169,29 +330,121 @@ protected:
 
     BaseWorldUtility* world;
     std::map<const BaseMobility*, const MobileHostObstacle*> vehicleObstacles;
+    std::unique_ptr<TraCIVehicleLayer> vehicleLayer; /**< draws all hosts at once (nullptr unless useVehicleLayer in a GUI run) */
     VehicleObstacleControl* vehicleObstacleControl;
 
-    void executeOneTimestep(); /**< read and execute all commands for the next timestep */
+    virtual void executeOneTimestep(); /**< read and execute all commands for the next timestep */
 
     virtual void init_traci();
 
     virtual void preInitializeModule(cModule* mod, const std::string& nodeId, const Coord& position, const std::string& road_id, double speed, Heading heading, VehicleSignalSet signals);
     virtual void updateModulePosition(cModule* mod, const Coord& p, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals);
+    virtual void commitModuleUpdates(); /**< called once per time step after all its subscription results were applied, for subclasses that defer (and batch) work of updateModulePosition */
+    bool isCoarseUpdatePending(cModule* mod, const TraCICoord& position, const std::string& edge, double speed) const; /**< returns true if this step's mobility update of mod can be skipped, see coarseUpdateInterval */
+    bool keepUnchangedModuleState(cModule* mod, const Coord& p, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals); /**< if the passed state is the one applied to all TraCIMobility modules of mod last, only advances their statistics and returns true, see skipUnchangedUpdates */
+    void postInitializeModule(cModule* mod, double length, double height, double width); /**< finishes adding a host, after its modules have been initialized */
     void addModule(std::string nodeId, std::string type, std::string name, std::string displayString, const Coord& position, std::string road_id = "", double speed = -1, Heading heading = Heading::nan, VehicleSignalSet signals = {VehicleSignal::undefined}, double length = 0, double height = 0, double width = 0);
+    void addModule(const std::string& nodeId, const ModuleTemplate& moduleTemplate, const Coord& position, const std::string& road_id, double speed, Heading heading, VehicleSignalSet signals, double length, double height, double width); /**< like above, for a module type, name and display string resolved already */
+    ModuleTemplate makeModuleTemplate(const std::string& type, const std::string& name, const std::string& displayString); /**< resolves module type and display string, throws if the module type does not exist */
+    const ModuleTemplate& getModuleTemplate(const std::string& vType); /**< returns the ModuleTemplate of a SUMO vehicle type as per the type mappings, resolving it at first use */
     cModule* getManagedModule(std::string nodeId); /**< returns a pointer to the managed module named moduleName, or 0 if no module can be found */
     void deleteManagedModule(std::string nodeId);
+    void deleteManagedModules(const std::vector<std::string>& nodeIds); /**< like deleteManagedModule() for each, but unregisters the nics of all modules in one pass per connection manager */
+    void detachManagedModule(cModule* mod); /**< removes the vehicle obstacles and layer entries of a module that is about to be deleted */
+    void disposeManagedModule(const std::string& nodeId, cModule* mod); /**< forgets and finishes a detached module, then recycles or deletes it */
+    bool isReusableModule(cModule* mod); /**< returns true if all simple modules of mod support BaseModule::resetForReuse() */
+    void recycleModule(cModule* mod); /**< parks a finished host for reuse, so its modules ignore events meant for its previous vehicle */
+    void resetRecycledModule(cModule* mod); /**< runs the reset lifecycle of a recycled host, in place of callInitialize() */
+    cModule* buildModule(const ModuleTemplate& moduleTemplate); /**< creates a host (at the next module vector index) and builds its submodules, without initializing it */
+    void noteLoadedVehicle(const std::string& nodeId); /**< adds a vehicle loaded by the TraCI server to expectedDepartures, queueing a query of its type if the type mappings depend on it */
+    void noteDepartedVehicle(const std::string& nodeId); /**< removes a departed vehicle from expectedDepartures */
+    void prebuildExpectedModules(); /**< builds hosts for the next prebuildModules expected departures that neither recycled nor prebuilt hosts are left for */
+    void instantiateHost(const std::string& nodeId, const Coord& position, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals, double length, double height, double width); /**< creates the module for a vehicle as per the type mappings */
+    virtual std::string getVehicleTypeId(const std::string& nodeId); /**< returns the SUMO vehicle type of a vehicle, as used to look up the type mappings */
+    virtual Coord traci2omnet(const TraCICoord& coord) const; /**< converts TraCI coordinates of the simulated network to OMNeT++ coordinates */
+    virtual Heading traci2omnetHeading(double heading) const; /**< converts a TraCI heading of the simulated network to an OMNeT++ heading */
+    virtual void applyVehicleState(const std::string& objectId, const TraCICoord& position, const std::string& edge, double speed, double angle_traci, int signals, double length, double height, double width); /**< creates, updates, or deletes the module of a vehicle as per its latest state (and the ROI) */
+    virtual bool removeArrivedVehicle(const std::string& nodeId); /**< forgets a vehicle that has left the simulation, deleting its module (or queueing it for deletePendingArrivals(), if batchArrivals is set); returns false if the vehicle lives on, so it does not count as arrived */
+    void deletePendingArrivals(); /**< deletes the modules of the arrived vehicles queued by removeArrivedVehicle(), to be called once all arrivals of a step are processed */
+    void startTraceRecording(const TraCICoord& topleft, const TraCICoord& bottomright); /**< starts recording to recordTraceFile, if set */
+    void updateDormantHosts(); /**< instantiates dormant hosts that got a communication partner and retires isolated ones */
+    void updateRealTimeSchedule(simtime_t stepTime, std::chrono::steady_clock::time_point stepWallEnd); /**< computes the slack of a step, switching to (or back from) reduced work when behind schedule */
 
     bool isModuleUnequipped(std::string nodeId); /**< returns true if this vehicle is Unequipped */
 
     void subscribeToVehicleVariables(std::string vehicleId);
     void unsubscribeFromVehicleVariables(std::string vehicleId);
-    void processSimSubscription(std::string objectId, TraCIBuffer& buf);
-    void processVehicleSubscription(std::string objectId, TraCIBuffer& buf);
+    void processSimSubscription(const std::string& objectId, TraCIBuffer& buf);
+    void processVehicleSubscription(const std::string& objectId, TraCIBuffer& buf);
+    /**
+     * vehicle variables decoded from one subscription result, before they are applied to the vehicle's module
+     */
+    struct VehicleSubscriptionResult {
+        std::string objectId;
+        double px = 0;
+        double py = 0;
+        std::string edge;
+        double speed = 0;
+        double angle_traci = 0;
+        int signals = 0;
+        double length = 0;
+        double height = 0;
+        double width = 0;
+        int numRead = 0; /**< number of the above variables received */
+        bool hasIdList = false;
+        std::vector<std::string> idList;
+        uint8_t errorStatus = TraCIConstants::RTYPE_OK; /**< status of the first variable that could not be subscribed to */
+        uint8_t errorVariable = 0;
+        std::string errorMessage;
+        bool hasIgnoredVariable = false;
+        uint8_t ignoredVariable = 0;
+        uint8_t ignoredVariableType = 0;
+        std::string decodeError; /**< set if the result could not be decoded */
+
+        void reset(); /**< returns to the initial state, keeping the storage of all strings for reuse */
+    };
+
+    /**
+     * Containers used while decoding a simulation step, kept across steps so their storage gets reused.
+     * Once they grew to the size of a step, decoding further steps does next to no heap allocations.
+     */
+    struct StepDecodeScratch {
+        std::vector<TraCIBuffer> results; /**< the subscription results of the step (first numResults are in use) */
+        size_t numResults = 0;
+        std::vector<size_t> vehicleResultIndex; /**< for each result, index of its decoded vehicle variables (npos: process as a whole) */
+        std::vector<size_t> vehicleResultOrigin; /**< for each set of decoded vehicle variables, index of its result */
+        std::vector<uint8_t> vehicleVariableNumbers;
+        std::vector<VehicleSubscriptionResult> vehicleResults; /**< first numVehicleResults are in use */
+        size_t numVehicleResults = 0;
+        std::string objectId;
+        std::vector<const std::string*> sortedIds; /**< the ids of the vehicle id list subscription, sorted */
+        TraCIBuffer streamedResult; /**< the subscription result of a streamed step being applied */
+    };
+    StepDecodeScratch stepScratch;
+    std::deque<VehicleSubscriptionResult> vehicleResultPool; /**< results decoded on their own (reentrantly, e.g. while subscribing to a vehicle), by depth */
+    size_t vehicleResultPoolDepth = 0;
+
+    void processVehicleVariables(const std::string& objectId, uint8_t variableNumber_resp, TraCIBuffer& buf);
+    void decodeVehicleVariables(uint8_t variableNumber_resp, TraCIBuffer& buf, VehicleSubscriptionResult& result) const; /**< pure parsing, safe to call from worker threads */
+    void applyVehicleSubscription(const VehicleSubscriptionResult& result);
+    const VehicleDimensions& getVehicleDimensions(const std::string& vehicleId); /**< returns the dimensions of a vehicle, querying them if it is seen for the first time */
+    void processSubscriptionResults(uint32_t count, TraCIBuffer& buf); /**< decodes count subscription results (optionally in parallel), then applies them */
+    void processStreamedSubscriptionResults(); /**< applies the subscription results of a step streamed by the connection, each as soon as it has arrived */
+    void subscribeToSimVariables(TraCIConnection& traciConnection, TraCICommandInterface& commandInterface); /**< subscribes to the vehicles departing, arriving, etc. and to the time step */
+    void subscribeToVehicleContext(TraCIConnection& traciConnection, uint8_t commandId = TraCIConstants::CMD_SUBSCRIBE_SIM_CONTEXT, const std::string& objectId = "", double range = std::numeric_limits<double>::max()); /**< subscribes to the variables of all vehicles within range of the given object (default: all vehicles in the network) */
+    void subscribeToRoiContexts(TraCIConnection& traciConnection, TraCICommandInterface& commandInterface); /**< subscribes to the vehicles near each shape and road of the region of interest, see useRoiContextSubscription */
+    void processVehicleContextSubscription(const std::string& objectId, TraCIBuffer& buf);
+    void removeVehiclesOutsideRoiContexts(); /**< treats managed vehicles no ROI context subscription reported this step as having left the region of interest */
+    void leaveRegionOfInterest(const std::string& objectId);
     void processSubcriptionResult(TraCIBuffer& buf);
 
-    void subscribeToTrafficLightVariables(std::string tlId);
+    void subscribeToTrafficLightVariables(std::string tlId); /**< queues the subscription; sent by the next query or flushQueries() */
     void unsubscribeFromTrafficLightVariables(std::string tlId);
-    void processTrafficLightSubscription(std::string objectId, TraCIBuffer& buf);
+    void processTrafficLightSubscription(const std::string& objectId, TraCIBuffer& buf);
+
+    void subscribeToDetectors(); /**< adds all (whitelisted) detectors to detectorStates and queues their subscriptions */
+    void subscribeToDetectorVariables(const std::string& detectorId, TraCIDetectorStates::Kind kind); /**< queues the subscription; sent by the next query or flushQueries() */
+    void processDetectorSubscription(const std::string& objectId, TraCIBuffer& buf);
     /**
      * parses the vector of module types in ini file
      *
@@ -208,6 +461,15 @@ protected:
 
     void lifecycleEvent(SimulationLifecycleEventType eventType, cObject* details) override;
     void listenerRemoved() override;
+
+private:
+    /**
+     * estimates the memory held by the tables of hosts, vehicles and subscriptions and the decoding scratch space, see MemoryAccounting
+     */
+    MemoryAccounting::Usage getMemoryUsage() const;
+
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
+    MemoryAccounting::Registration memoryRegistration; /**< reports getMemoryUsage() as subsystem "traci" */
 };
 
 class VEINS_API TraCIScenarioManagerAccess {
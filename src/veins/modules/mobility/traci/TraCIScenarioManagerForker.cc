@@ -28,6 +28,7 @@
 #include <netinet/tcp.h>
 #include <netdb.h>
 #include <arpa/inet.h>
+#include <unistd.h>
 #endif
 
 #include <sstream>
@@ -104,6 +105,19 @@ void TraCIScenarioManagerForker::startServer()
     commandLine = replace(commandLine, "$seed", seed);
     commandLine = replace(commandLine, "$port", port);
 
+    // prefer a Unix domain socket over loopback TCP if the command line can make use of one
+    if (commandLine.find("$socket") != std::string::npos) {
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32) || defined(__CYGWIN__) || defined(_WIN64)
+        throw cRuntimeError("$socket (Unix domain socket) is not supported on this platform");
+#else
+        std::ostringstream socketPath;
+        socketPath << "/tmp/veins-traci-" << getpid() << "-" << getId() << ".sock";
+        unlink(socketPath.str().c_str());
+        commandLine = replace(commandLine, "$socket", socketPath.str());
+        host = "unix:" + socketPath.str();
+#endif
+    }
+
     server = new TraCILauncher(commandLine);
 }
 
@@ -24,6 +24,7 @@
 #include "veins/modules/mobility/traci/TraCICommandInterface.h"
 #include "veins/modules/mobility/traci/TraCIConstants.h"
 
+#include <cctype>
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -33,6 +34,7 @@ namespace veins {
 namespace TraCIConstants {
 
 const uint8_t CMD_FILE_SEND = 0x75;
+const uint8_t CMD_LAUNCHD_METRICS = 0x76;
 
 } // namespace TraCIConstants
 
@@ -77,14 +79,65 @@ void TraCIScenarioManagerLaunchd::initialize(int stage)
         seed_node->setAttribute("value", ss.str().c_str());
         launchConfig->appendChild(seed_node);
     }
+    cXMLElementList reuse_nodes = launchConfig->getElementsByTagName("reuse");
+    if (reuse_nodes.size() == 0 && par("reuseServer").boolValue()) {
+        // ask a pooling sumo-launchd to hand us a warm SUMO instance and to keep it for the next run
+        cXMLElement* reuse_node = new cXMLElement("reuse", __FILE__, launchConfig);
+        reuse_node->setAttribute("value", "true");
+        launchConfig->appendChild(reuse_node);
+    }
+    std::string sharedSession = par("sharedSession").stdstringValue();
+    if (!sharedSession.empty() && launchConfig->getElementsByTagName("share").size() == 0) {
+        // replications sharing one SUMO must agree on its seed, the current repetition will not do
+        if (seed_nodes.size() == 0 && par("seed").intValue() == -1) throw cRuntimeError("sharedSession requires the seed to be set, either by the seed parameter or in the launch configuration");
+        int clients = par("sharedSessionClients");
+        if (clients < 1) throw cRuntimeError("sharedSession requires sharedSessionClients to be at least 1");
+        cXMLElement* share_node = new cXMLElement("share", __FILE__, launchConfig);
+        share_node->setAttribute("id", sharedSession.c_str());
+        share_node->setAttribute("clients", std::to_string(clients).c_str());
+        launchConfig->appendChild(share_node);
+    }
+    if (!sharedSession.empty()) par("readOnly").setBoolValue(true);
     TraCIScenarioManager::initialize(stage);
 }
 
 void TraCIScenarioManagerLaunchd::finish()
 {
+    if (isConnected() && par("recordLaunchdMetrics").boolValue()) recordLaunchdMetrics();
     TraCIScenarioManager::finish();
 }
 
+void TraCIScenarioManagerLaunchd::recordLaunchdMetrics()
+{
+    TraCIConnection::Result result;
+    TraCIBuffer buf = getConnection()->query(CMD_LAUNCHD_METRICS, TraCIBuffer(), &result);
+    if (!result.success) {
+        EV_WARN << "sumo-launchd did not report session metrics (it might be too old): " << result.message << std::endl;
+        return;
+    }
+
+    uint8_t cmdLength;
+    buf >> cmdLength;
+    if (cmdLength == 0) {
+        uint32_t cmdLengthExt;
+        buf >> cmdLengthExt;
+    }
+    uint8_t commandResp;
+    buf >> commandResp;
+    ASSERT(commandResp == CMD_LAUNCHD_METRICS);
+    int32_t count;
+    buf >> count;
+    for (int32_t i = 0; i < count; ++i) {
+        std::string name;
+        buf >> name;
+        double value;
+        buf >> value;
+        if (!name.empty()) name[0] = toupper(name[0]);
+        recordScalar(("launchd" + name).c_str(), value);
+    }
+    ASSERT(buf.eof());
+}
+
 void TraCIScenarioManagerLaunchd::init_traci()
 {
     {
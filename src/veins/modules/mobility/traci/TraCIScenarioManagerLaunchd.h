@@ -56,6 +56,11 @@ protected:
     int seed; /**< seed value to set in launch configuration, if missing (-1: current run number) */
 
     void init_traci() override;
+
+    /**
+     * Asks sumo-launchd for the metrics of this session (slot wait, launch latency, step time distribution, ...) and records each as a scalar named "launchd<Name>".
+     */
+    void recordLaunchdMetrics();
 };
 
 class VEINS_API TraCIScenarioManagerLaunchdAccess {
@@ -0,0 +1,226 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <sstream>
+
+#include "veins/modules/mobility/traci/TraCIScenarioManagerLibsumo.h"
+
+#ifdef WITH_LIBSUMO
+#include <libsumo/libsumo.h>
+#endif
+
+using veins::Coord;
+using veins::Heading;
+using veins::TraCICoord;
+using veins::TraCIScenarioManagerLibsumo;
+
+Define_Module(veins::TraCIScenarioManagerLibsumo);
+
+namespace {
+
+template <typename T>
+inline std::string replace(std::string haystack, std::string needle, T newValue)
+{
+    size_t i = haystack.find(needle, 0);
+    if (i == std::string::npos) return haystack;
+    std::ostringstream os;
+    os << newValue;
+    haystack.replace(i, needle.length(), os.str());
+    return haystack;
+}
+
+} // namespace
+
+TraCIScenarioManagerLibsumo::~TraCIScenarioManagerLibsumo()
+{
+    closeSumo();
+}
+
+void TraCIScenarioManagerLibsumo::initialize(int stage)
+{
+    if (stage == 1) {
+#ifndef WITH_LIBSUMO
+        throw cRuntimeError("TraCIScenarioManagerLibsumo requires Veins to be configured --with-libsumo");
+#endif
+        commandLine = par("commandLine").stringValue();
+        configFile = par("configFile").stringValue();
+        seed = par("seed");
+    }
+    TraCIScenarioManager::initialize(stage);
+}
+
+void TraCIScenarioManagerLibsumo::finish()
+{
+    TraCIScenarioManager::finish();
+    closeSumo();
+}
+
+void TraCIScenarioManagerLibsumo::handleSelfMsg(cMessage* msg)
+{
+    if (msg == connectAndStartTrigger) {
+        startSumo();
+        return;
+    }
+    TraCIScenarioManager::handleSelfMsg(msg);
+}
+
+#ifdef WITH_LIBSUMO
+
+void TraCIScenarioManagerLibsumo::startSumo()
+{
+    // autoset seed, if requested
+    if (seed == -1) {
+        const char* seed_s = cSimulation::getActiveSimulation()->getEnvir()->getConfigEx()->getVariable(CFGVAR_RUNNUMBER);
+        seed = atoi(seed_s);
+    }
+
+    // assemble command line arguments
+    commandLine = replace(commandLine, "$configFile", configFile);
+    commandLine = replace(commandLine, "$seed", seed);
+    std::vector<std::string> args;
+    std::istringstream is(commandLine);
+    for (std::string arg; is >> arg;) args.push_back(arg);
+
+    EV_DEBUG << "Loading SUMO in-process with arguments \"" << commandLine << "\"" << endl;
+    libsumo::Simulation::load(args);
+    sumoLoaded = true;
+
+    auto boundary = libsumo::Simulation::getNetBoundary().value;
+    if (boundary.size() != 2) throw cRuntimeError("libsumo reported a network boundary of %d points (expected 2)", static_cast<int>(boundary.size()));
+    TraCICoord topleft(boundary[0].x, boundary[0].y);
+    TraCICoord bottomright(boundary[1].x, boundary[1].y);
+    coordinateTransformation.reset(new TraCICoordinateTransformation(topleft, bottomright, par("margin").intValue()));
+    startTraceRecording(topleft, bottomright);
+
+    activeVehicleCount = 0;
+    drivingVehicleCount = 0;
+    autoShutdownTriggered = false;
+
+    traciInitialized = true;
+    emit(traciInitializedSignal, true);
+
+    // the first timestep was already scheduled (at firstStepAt) by TraCIScenarioManager::initialize()
+    ASSERT(executeOneTimestepTrigger->isScheduled());
+}
+
+void TraCIScenarioManagerLibsumo::closeSumo()
+{
+    if (!sumoLoaded) return;
+    sumoLoaded = false;
+    libsumo::Simulation::close();
+}
+
+void TraCIScenarioManagerLibsumo::executeOneTimestep()
+{
+    EV_DEBUG << "Triggering libsumo simulation advance to t=" << simTime() << endl;
+
+    simtime_t targetTime = simTime();
+
+    emit(traciTimestepBeginSignal, targetTime);
+
+    libsumo::Simulation::step(targetTime.dbl());
+    if (traceWriter) traceWriter->beginStep(targetTime.dbl());
+
+    std::vector<std::string> departed = libsumo::Simulation::getDepartedIDList();
+    libsumoVehicles.insert(departed.begin(), departed.end());
+    activeVehicleCount += departed.size();
+    drivingVehicleCount += departed.size();
+
+    std::vector<std::string> arrived = libsumo::Simulation::getArrivedIDList();
+    for (const auto& nodeId : arrived) {
+        libsumoVehicles.erase(nodeId);
+        removeArrivedVehicle(nodeId);
+    }
+    deletePendingArrivals();
+    uint32_t count = arrived.size();
+    if ((count > 0) && (count >= activeVehicleCount) && autoShutdown) autoShutdownTriggered = true;
+    activeVehicleCount -= count;
+    drivingVehicleCount -= count;
+
+    for (const auto& nodeId : libsumoVehicles) {
+        updateVehicle(nodeId);
+    }
+    commitModuleUpdates();
+    updateDormantHosts();
+
+    emit(traciTimestepEndSignal, targetTime);
+
+    if (!autoShutdownTriggered) scheduleAt(simTime() + updateInterval, executeOneTimestepTrigger);
+}
+
+std::string TraCIScenarioManagerLibsumo::getVehicleTypeId(const std::string& nodeId)
+{
+    return libsumo::Vehicle::getTypeID(nodeId);
+}
+
+Coord TraCIScenarioManagerLibsumo::traci2omnet(const TraCICoord& coord) const
+{
+    return coordinateTransformation->traci2omnet(coord);
+}
+
+Heading TraCIScenarioManagerLibsumo::traci2omnetHeading(double heading) const
+{
+    return coordinateTransformation->traci2omnetHeading(heading);
+}
+
+void TraCIScenarioManagerLibsumo::updateVehicle(const std::string& nodeId)
+{
+    libsumo::TraCIPosition pos = libsumo::Vehicle::getPosition(nodeId);
+    applyVehicleState(nodeId, TraCICoord(pos.x, pos.y), libsumo::Vehicle::getRoadID(nodeId), libsumo::Vehicle::getSpeed(nodeId), libsumo::Vehicle::getAngle(nodeId), libsumo::Vehicle::getSignals(nodeId), libsumo::Vehicle::getLength(nodeId), libsumo::Vehicle::getHeight(nodeId), libsumo::Vehicle::getWidth(nodeId));
+}
+
+#else // WITH_LIBSUMO
+
+void TraCIScenarioManagerLibsumo::startSumo()
+{
+    throw cRuntimeError("TraCIScenarioManagerLibsumo requires Veins to be configured --with-libsumo");
+}
+
+void TraCIScenarioManagerLibsumo::closeSumo()
+{
+}
+
+void TraCIScenarioManagerLibsumo::executeOneTimestep()
+{
+    throw cRuntimeError("TraCIScenarioManagerLibsumo requires Veins to be configured --with-libsumo");
+}
+
+std::string TraCIScenarioManagerLibsumo::getVehicleTypeId(const std::string& nodeId)
+{
+    throw cRuntimeError("TraCIScenarioManagerLibsumo requires Veins to be configured --with-libsumo");
+}
+
+Coord TraCIScenarioManagerLibsumo::traci2omnet(const TraCICoord& coord) const
+{
+    throw cRuntimeError("TraCIScenarioManagerLibsumo requires Veins to be configured --with-libsumo");
+}
+
+Heading TraCIScenarioManagerLibsumo::traci2omnetHeading(double heading) const
+{
+    throw cRuntimeError("TraCIScenarioManagerLibsumo requires Veins to be configured --with-libsumo");
+}
+
+void TraCIScenarioManagerLibsumo::updateVehicle(const std::string& nodeId)
+{
+}
+
+#endif // WITH_LIBSUMO
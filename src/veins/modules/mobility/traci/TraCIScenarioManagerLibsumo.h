@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <set>
+
+#include "veins/veins.h"
+
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+#include "veins/modules/mobility/traci/TraCICoordinateTransformation.h"
+
+namespace veins {
+
+/**
+ * @brief
+ *
+ * Extends the TraCIScenarioManager to run SUMO in-process via libsumo instead of talking to a TraCI server over a socket.
+ *
+ * Vehicle state is read directly from libsumo every timestep, saving the (de)serialization and socket round trips of TraCI.
+ * Only the functionality needed to drive TraCIMobility is provided: there is no TraCIConnection, so getCommandInterface() returns nullptr
+ * and modules relying on it (e.g., applications changing routes or speeds) are not supported by this manager.
+ *
+ * Requires Veins to be configured with --with-libsumo=SUMO_HOME; otherwise, using this module is an error.
+ *
+ * @see TraCIScenarioManager
+ * @see TraCIScenarioManagerForker
+ *
+ */
+class VEINS_API TraCIScenarioManagerLibsumo : virtual public TraCIScenarioManager {
+public:
+    ~TraCIScenarioManagerLibsumo() override;
+    void initialize(int stage) override;
+    void finish() override;
+
+protected:
+    std::string commandLine; /**< command line for running SUMO (substituting $configFile and $seed), split at whitespace */
+    std::string configFile; /**< substitution for $configFile parameter */
+    int seed; /**< substitution for $seed parameter (-1: current run number) */
+
+    bool sumoLoaded = false; /**< whether libsumo has a simulation loaded that needs closing */
+    std::unique_ptr<TraCICoordinateTransformation> coordinateTransformation; /**< transformation for the loaded network */
+    std::set<std::string> libsumoVehicles; /**< vehicles currently in the SUMO simulation, ordered for deterministic module creation */
+
+    void handleSelfMsg(cMessage* msg) override;
+    void executeOneTimestep() override;
+    std::string getVehicleTypeId(const std::string& nodeId) override;
+    Coord traci2omnet(const TraCICoord& coord) const override;
+    Heading traci2omnetHeading(double heading) const override;
+
+    virtual void startSumo(); /**< loads the simulation into libsumo and sets up the coordinate transformation */
+    virtual void closeSumo(); /**< closes the simulation loaded into libsumo, if any */
+    void updateVehicle(const std::string& nodeId); /**< reads the state of a vehicle from libsumo and applies it to its module */
+};
+
+class VEINS_API TraCIScenarioManagerLibsumoAccess {
+public:
+    TraCIScenarioManagerLibsumo* get()
+    {
+        return FindModule<TraCIScenarioManagerLibsumo*>::findGlobalModule();
+    };
+};
+
+} // namespace veins
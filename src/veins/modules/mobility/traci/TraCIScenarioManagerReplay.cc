@@ -0,0 +1,127 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/mobility/traci/TraCIScenarioManagerReplay.h"
+
+using veins::Coord;
+using veins::Heading;
+using veins::TraCICoord;
+using veins::TraCIScenarioManagerReplay;
+
+Define_Module(veins::TraCIScenarioManagerReplay);
+
+void TraCIScenarioManagerReplay::initialize(int stage)
+{
+    if (stage == 1) {
+        traceFile = par("traceFile").stringValue();
+    }
+    TraCIScenarioManager::initialize(stage);
+}
+
+void TraCIScenarioManagerReplay::finish()
+{
+    TraCIScenarioManager::finish();
+    reader.reset();
+}
+
+void TraCIScenarioManagerReplay::handleSelfMsg(cMessage* msg)
+{
+    if (msg == connectAndStartTrigger) {
+        openTrace();
+        return;
+    }
+    TraCIScenarioManager::handleSelfMsg(msg);
+}
+
+void TraCIScenarioManagerReplay::openTrace()
+{
+    EV_DEBUG << "Playing back mobility trace \"" << traceFile << "\"" << endl;
+    reader.reset(new TraCIMobilityTraceReader(traceFile));
+    haveNextStep = reader->readStep(nextStep);
+    coordinateTransformation.reset(new TraCICoordinateTransformation(reader->getTopLeft(), reader->getBottomRight(), par("margin").intValue()));
+    vehicleTypes.clear();
+
+    activeVehicleCount = 0;
+    drivingVehicleCount = 0;
+    autoShutdownTriggered = false;
+
+    traciInitialized = true;
+    emit(traciInitializedSignal, true);
+}
+
+void TraCIScenarioManagerReplay::executeOneTimestep()
+{
+    EV_DEBUG << "Playing back mobility trace up to t=" << simTime() << endl;
+
+    simtime_t targetTime = simTime();
+
+    emit(traciTimestepBeginSignal, targetTime);
+
+    if (reader) {
+        while (haveNextStep && (nextStep.time <= targetTime.dbl())) {
+            playStep(nextStep);
+            haveNextStep = reader->readStep(nextStep);
+        }
+        commitModuleUpdates();
+        updateDormantHosts();
+        if (!haveNextStep && autoShutdown) autoShutdownTriggered = true;
+    }
+
+    emit(traciTimestepEndSignal, targetTime);
+
+    if (!autoShutdownTriggered) scheduleAt(simTime() + updateInterval, executeOneTimestepTrigger);
+}
+
+void TraCIScenarioManagerReplay::playStep(const TraCIMobilityTraceStep& step)
+{
+    for (const auto& nodeId : step.arrived) {
+        if (vehicleTypes.erase(nodeId) == 0) continue;
+        removeArrivedVehicle(nodeId);
+        activeVehicleCount -= 1;
+        drivingVehicleCount -= 1;
+    }
+    deletePendingArrivals();
+    for (const auto& vehicle : step.vehicles) {
+        if (vehicleTypes.emplace(vehicle.id, vehicle.typeId).second) {
+            activeVehicleCount += 1;
+            drivingVehicleCount += 1;
+        }
+        applyVehicleState(vehicle.id, vehicle.position, vehicle.edge, vehicle.speed, vehicle.angle, vehicle.signals, vehicle.length, vehicle.height, vehicle.width);
+    }
+}
+
+std::string TraCIScenarioManagerReplay::getVehicleTypeId(const std::string& nodeId)
+{
+    auto i = vehicleTypes.find(nodeId);
+    if (i == vehicleTypes.end()) throw cRuntimeError("Mobility trace \"%s\" has no type for vehicle \"%s\"", traceFile.c_str(), nodeId.c_str());
+    return i->second;
+}
+
+Coord TraCIScenarioManagerReplay::traci2omnet(const TraCICoord& coord) const
+{
+    return coordinateTransformation->traci2omnet(coord);
+}
+
+Heading TraCIScenarioManagerReplay::traci2omnetHeading(double heading) const
+{
+    return coordinateTransformation->traci2omnetHeading(heading);
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <unordered_set>
+
+#include "veins/veins.h"
+
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+#include "veins/modules/mobility/traci/TraCICoordinateTransformation.h"
+#include "veins/modules/mobility/traci/TraCIMobilityTrace.h"
+
+namespace veins {
+
+/**
+ * @brief
+ *
+ * Extends the TraCIScenarioManager to play back a mobility trace recorded via its recordTraceFile parameter, without running SUMO.
+ *
+ * Every step of the trace is applied at the time it was recorded, exactly like the subscription results it was recorded from
+ * (including the region of interest, dormant hosts, and coarse updates, which are applied again on playback).
+ * There is no TraCI connection, so getCommandInterface() returns nullptr and modules relying on it are not supported.
+ *
+ * @see TraCIScenarioManager
+ * @see TraCIMobilityTraceReader
+ *
+ */
+class VEINS_API TraCIScenarioManagerReplay : virtual public TraCIScenarioManager {
+public:
+    void initialize(int stage) override;
+    void finish() override;
+
+protected:
+    std::string traceFile; /**< mobility trace to play back */
+
+    std::unique_ptr<TraCIMobilityTraceReader> reader;
+    TraCIMobilityTraceStep nextStep; /**< next step of the trace not yet played back */
+    bool haveNextStep = false;
+    std::unique_ptr<TraCICoordinateTransformation> coordinateTransformation; /**< transformation for the recorded network */
+    std::unordered_map<std::string, std::string> vehicleTypes; /**< type of each vehicle in the simulation, as recorded */
+
+    void handleSelfMsg(cMessage* msg) override;
+    void executeOneTimestep() override;
+    std::string getVehicleTypeId(const std::string& nodeId) override;
+    Coord traci2omnet(const TraCICoord& coord) const override;
+    Heading traci2omnetHeading(double heading) const override;
+
+    virtual void openTrace(); /**< opens the trace and sets up the coordinate transformation */
+    void playStep(const TraCIMobilityTraceStep& step); /**< applies the arrivals and vehicle updates of a step */
+};
+
+class VEINS_API TraCIScenarioManagerReplayAccess {
+public:
+    TraCIScenarioManagerReplay* get()
+    {
+        return FindModule<TraCIScenarioManagerReplay*>::findGlobalModule();
+    };
+};
+
+} // namespace veins
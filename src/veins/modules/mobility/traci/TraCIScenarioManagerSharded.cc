@@ -0,0 +1,260 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+#include "veins/modules/mobility/traci/TraCIScenarioManagerSharded.h"
+#include "veins/modules/mobility/traci/TraCIConstants.h"
+
+using namespace veins::TraCIConstants;
+
+using veins::TraCICommandInterface;
+using veins::TraCICoord;
+using veins::TraCIScenarioManagerSharded;
+
+Define_Module(veins::TraCIScenarioManagerSharded);
+
+TraCIScenarioManagerSharded::~TraCIScenarioManagerSharded()
+{
+    // shard 0 is closed by the base class
+    for (auto& shard : shards) {
+        if (shard.ownConnection) TraCIBuffer buf = shard.ownConnection->query(CMD_CLOSE, TraCIBuffer());
+    }
+}
+
+void TraCIScenarioManagerSharded::initialize(int stage)
+{
+    TraCIScenarioManager::initialize(stage);
+    if (stage != 1) {
+        return;
+    }
+
+    if (!useContextSubscription) throw cRuntimeError("TraCIScenarioManagerSharded requires useContextSubscription");
+    if (useRoiContextSubscription) throw cRuntimeError("TraCIScenarioManagerSharded does not support roiContextSubscription");
+    if (prebuildModules > 0) throw cRuntimeError("TraCIScenarioManagerSharded does not support prebuildModules");
+
+    shardServers.clear();
+    std::istringstream serverStream(par("shardServers").stdstringValue());
+    for (std::istream_iterator<std::string> i(serverStream); i != std::istream_iterator<std::string>(); ++i) {
+        size_t colon = i->rfind(':');
+        if (colon == std::string::npos) throw cRuntimeError("Cannot parse shard server \"%s\": expected host:port", i->c_str());
+        shardServers.emplace_back(i->substr(0, colon), std::stoi(i->substr(colon + 1)));
+    }
+
+    shardBorders.clear();
+    std::istringstream borderStream(par("shardBorders").stdstringValue());
+    std::copy(std::istream_iterator<double>(borderStream), std::istream_iterator<double>(), std::back_inserter(shardBorders));
+    if (shardBorders.size() != shardServers.size()) throw cRuntimeError("%d shard servers need %d shard borders, got %d", static_cast<int>(shardServers.size()), static_cast<int>(shardServers.size()), static_cast<int>(shardBorders.size()));
+    if (!std::is_sorted(shardBorders.begin(), shardBorders.end())) throw cRuntimeError("shardBorders must be ascending");
+
+    handoverMargin = par("handoverMargin");
+}
+
+void TraCIScenarioManagerSharded::finish()
+{
+    recordScalar("shardHandovers", handoverCount);
+    TraCIScenarioManager::finish();
+}
+
+TraCICommandInterface* TraCIScenarioManagerSharded::getShardCommandInterface(const std::string& nodeId) const
+{
+    auto i = vehicleShards.find(nodeId);
+    if (i == vehicleShards.end() || shards.empty()) return getCommandInterface();
+    return shards[i->second.shard].commandInterface;
+}
+
+void TraCIScenarioManagerSharded::init_traci()
+{
+    shards.clear();
+    shards.resize(1 + shardServers.size());
+    shards[0].connection = connection.get();
+    shards[0].commandInterface = commandIfc.get();
+    for (size_t i = 1; i < shards.size(); ++i) {
+        Shard& shard = shards[i];
+        shard.ownConnection.reset(TraCIConnection::connect(this, shardServers[i - 1].first.c_str(), shardServers[i - 1].second));
+        shard.ownCommandInterface.reset(new TraCICommandInterface(this, *shard.ownConnection, ignoreGuiCommands));
+        shard.connection = shard.ownConnection.get();
+        shard.commandInterface = shard.ownCommandInterface.get();
+    }
+
+    // shard 0 (including traffic lights and obstacles); all shards load the same network, so its coordinate transformation applies to all
+    currentShard = 0;
+    TraCIScenarioManager::init_traci();
+
+    for (size_t i = 1; i < shards.size(); ++i) {
+        Shard& shard = shards[i];
+        auto apiVersion = shard.commandInterface->getVersion();
+        EV_DEBUG << "TraCI server of shard " << i << " \"" << apiVersion.second << "\" reports API version " << apiVersion.first << endl;
+        shard.commandInterface->setApiVersion(apiVersion.first);
+        if (order != -1) {
+            shard.commandInterface->setOrder(order);
+        }
+
+        currentShard = i;
+        subscribeToSimVariables(*shard.connection, *shard.commandInterface);
+        subscribeToVehicleContext(*shard.connection);
+    }
+    currentShard = 0;
+}
+
+void TraCIScenarioManagerSharded::executeOneTimestep()
+{
+    EV_DEBUG << "Triggering TraCI servers of " << shards.size() << " shards to advance to t=" << simTime() << endl;
+
+    simtime_t targetTime = simTime();
+
+    emit(traciTimestepBeginSignal, targetTime);
+
+    if (isConnected()) {
+        // let all shards compute the step concurrently, then collect their results in order
+        for (auto& shard : shards) {
+            if (!shard.connection->hasPending()) shard.connection->sendPending(CMD_SIMSTEP2, TraCIBuffer() << targetTime);
+        }
+        if (traceWriter) traceWriter->beginStep(targetTime.dbl());
+        for (size_t i = 0; i < shards.size(); ++i) {
+            currentShard = i;
+            TraCIBuffer buf = shards[i].connection->receivePending();
+            uint32_t count;
+            buf >> count;
+            EV_DEBUG << "Getting " << count << " subscription results from shard " << i << endl;
+            processSubscriptionResults(count, buf);
+        }
+        currentShard = 0;
+        commitModuleUpdates();
+
+        // handovers were counted as departures by their new shards (and not as arrivals by their old ones), so the count is only exact once all shards are in
+        if (departedHandovers > 0) {
+            activeVehicleCount -= departedHandovers;
+            drivingVehicleCount -= departedHandovers;
+            departedHandovers = 0;
+            if ((activeVehicleCount == 0) && autoShutdown) autoShutdownTriggered = true;
+        }
+
+        handOverVehicles();
+        updateDormantHosts();
+
+        if (!saveStateFile.empty() && !stateSaved && (targetTime >= saveStateAt)) {
+            EV_WARN << "Saving the simulation state is only supported for shard 0" << endl;
+            commandIfc->saveState(saveStateFile);
+            stateSaved = true;
+        }
+    }
+
+    emit(traciTimestepEndSignal, targetTime);
+
+    if (!autoShutdownTriggered) {
+        scheduleAt(simTime() + updateInterval, executeOneTimestepTrigger);
+        if (pipelineSteps && isConnected()) {
+            for (auto& shard : shards) {
+                shard.connection->sendPending(CMD_SIMSTEP2, TraCIBuffer() << simTime() + updateInterval);
+            }
+        }
+    }
+}
+
+std::string TraCIScenarioManagerSharded::getVehicleTypeId(const std::string& nodeId)
+{
+    return getShardCommandInterface(nodeId)->vehicle(nodeId).getTypeId();
+}
+
+void TraCIScenarioManagerSharded::applyVehicleState(const std::string& objectId, const TraCICoord& position, const std::string& edge, double speed, double angle_traci, int signals, double length, double height, double width)
+{
+    ShardedVehicle& vehicle = vehicleShards[objectId];
+    // the first report of a handed over vehicle by its new shard comes with its departure there, which the vehicle count already includes
+    if ((currentShard == vehicle.shard) && departingHandovers.erase(objectId)) departedHandovers++;
+    vehicle.shard = currentShard;
+    vehicle.position = position;
+    TraCIScenarioManager::applyVehicleState(objectId, position, edge, speed, angle_traci, signals, length, height, width);
+}
+
+bool TraCIScenarioManagerSharded::removeArrivedVehicle(const std::string& nodeId)
+{
+    // a vehicle removed from its old shard for a handover is reported as arrived there; it lives on in the new shard
+    if (handedOverVehicles.erase(nodeId)) {
+        return false;
+    }
+    vehicleShards.erase(nodeId);
+    // (one that arrives before being reported by its new shard has departed there all the same)
+    if (departingHandovers.erase(nodeId)) departedHandovers++;
+    return TraCIScenarioManager::removeArrivedVehicle(nodeId);
+}
+
+size_t TraCIScenarioManagerSharded::getShardAt(const TraCICoord& position) const
+{
+    return std::upper_bound(shardBorders.begin(), shardBorders.end(), position.x) - shardBorders.begin();
+}
+
+void TraCIScenarioManagerSharded::handOverVehicles()
+{
+    std::vector<std::pair<std::string, size_t>> handovers;
+    for (const auto& entry : vehicleShards) {
+        size_t from = entry.second.shard;
+        size_t to = getShardAt(entry.second.position);
+        if (to == from) continue;
+        if (handedOverVehicles.count(entry.first)) continue;
+        // only hand over vehicles well past the border of their shard
+        if (to > from && entry.second.position.x < shardBorders[from] + handoverMargin) continue;
+        if (to < from && entry.second.position.x >= shardBorders[from - 1] - handoverMargin) continue;
+        handovers.emplace_back(entry.first, to);
+    }
+    // hand over in a deterministic order
+    std::sort(handovers.begin(), handovers.end());
+    for (const auto& handover : handovers) {
+        handOverVehicle(handover.first, vehicleShards[handover.first].shard, handover.second);
+    }
+}
+
+void TraCIScenarioManagerSharded::handOverVehicle(const std::string& nodeId, size_t from, size_t to)
+{
+    EV_DEBUG << "Handing over vehicle " << nodeId << " from shard " << from << " to shard " << to << endl;
+
+    auto source = shards[from].commandInterface->vehicle(nodeId);
+    std::string typeId = source.getTypeId();
+    std::string roadId = source.getRoadId();
+    double lanePosition = source.getLanePosition();
+    double speed = source.getSpeed();
+    int32_t laneIndex = source.getLaneIndex();
+
+    // route from the current edge onward
+    std::list<std::string> route = source.getPlannedRoadIds();
+    auto current = std::find(route.begin(), route.end(), roadId);
+    if (current == route.end()) {
+        // e.g., on an internal edge of a junction: wait until the vehicle is back on a regular edge
+        EV_DEBUG << "Vehicle " << nodeId << " is not on an edge of its route, postponing handover" << endl;
+        return;
+    }
+    route.erase(route.begin(), current);
+
+    source.remove();
+    handedOverVehicles.insert(nodeId);
+    departingHandovers.insert(nodeId);
+
+    std::string routeId = "veins_handover_" + std::to_string(handoverCount++);
+    TraCICommandInterface* target = shards[to].commandInterface;
+    target->addRoute(routeId, route);
+    if (!target->addVehicle(nodeId, typeId, routeId, simTime(), lanePosition, speed, laneIndex)) {
+        throw cRuntimeError("Could not hand over vehicle %s to shard %d", nodeId.c_str(), static_cast<int>(to));
+    }
+    vehicleShards[nodeId].shard = to;
+}
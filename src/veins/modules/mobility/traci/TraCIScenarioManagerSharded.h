@@ -0,0 +1,116 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+#include "veins/modules/mobility/traci/TraCICommandInterface.h"
+
+namespace veins {
+
+/**
+ * @brief
+ *
+ * Extends the TraCIScenarioManager to split the road network into spatial shards, each simulated by its own SUMO instance.
+ *
+ * Shard 0 is the TraCI server the base class connects to (or launches); the other shards are TraCI servers listed in shardServers.
+ * All instances load the same network; the network is split into vertical strips at the x coordinates in shardBorders.
+ * Every timestep is requested from all shards before any result is read, so the SUMO instances compute it concurrently.
+ * Their subscription results are merged into the single table of managed hosts.
+ *
+ * A vehicle that drives past a border (by more than handoverMargin) is handed over: it is removed from its shard and
+ * inserted into the neighboring one with the remainder of its route, keeping its module.
+ *
+ * Requires useContextSubscription. Traffic lights and the command interface returned by getCommandInterface() are those of shard 0;
+ * use getShardCommandInterface() to reach the shard a vehicle is currently driving in.
+ *
+ * @see TraCIScenarioManager
+ *
+ */
+class VEINS_API TraCIScenarioManagerSharded : virtual public TraCIScenarioManager {
+public:
+    ~TraCIScenarioManagerSharded() override;
+    void initialize(int stage) override;
+
+    /**
+     * returns the command interface of the shard simulating the given vehicle (that of shard 0 if the vehicle is unknown)
+     */
+    TraCICommandInterface* getShardCommandInterface(const std::string& nodeId) const;
+
+protected:
+    /**
+     * connection to one SUMO instance
+     */
+    struct Shard {
+        std::unique_ptr<TraCIConnection> ownConnection; /**< connection owned by this manager (nullptr for shard 0, owned by the base class) */
+        std::unique_ptr<TraCICommandInterface> ownCommandInterface; /**< command interface owned by this manager (nullptr for shard 0) */
+        TraCIConnection* connection = nullptr;
+        TraCICommandInterface* commandInterface = nullptr;
+    };
+
+    /**
+     * shard a vehicle was last reported by, and where
+     */
+    struct ShardedVehicle {
+        size_t shard;
+        TraCICoord position;
+    };
+
+    std::vector<std::pair<std::string, int>> shardServers; /**< host and port of the TraCI servers of shards 1..n */
+    std::vector<double> shardBorders; /**< ascending x coordinates (in TraCI coordinates) separating shard i from shard i+1 */
+    double handoverMargin; /**< distance a vehicle needs to be past a border before it is handed over */
+    std::vector<Shard> shards;
+    size_t currentShard = 0; /**< shard whose results are currently being processed */
+    std::unordered_map<std::string, ShardedVehicle> vehicleShards; /**< shard of every vehicle reported by any shard */
+    std::unordered_set<std::string> handedOverVehicles; /**< vehicles removed from one shard for a handover whose arrival is still to be reported */
+    std::unordered_set<std::string> departingHandovers; /**< vehicles added to another shard for a handover that it has not reported yet */
+    uint32_t departedHandovers = 0; /**< handed over vehicles reported by their new shard in this step, counted as departures there */
+    size_t handoverCount = 0;
+
+    void init_traci() override;
+    void executeOneTimestep() override;
+    void finish() override;
+    std::string getVehicleTypeId(const std::string& nodeId) override;
+    void applyVehicleState(const std::string& objectId, const TraCICoord& position, const std::string& edge, double speed, double angle_traci, int signals, double length, double height, double width) override;
+    bool removeArrivedVehicle(const std::string& nodeId) override;
+
+    size_t getShardAt(const TraCICoord& position) const; /**< returns the shard covering the given position */
+    virtual void handOverVehicles(); /**< hands over all vehicles that drove past the border of their shard */
+    virtual void handOverVehicle(const std::string& nodeId, size_t from, size_t to); /**< moves a vehicle from one SUMO instance to another */
+};
+
+class VEINS_API TraCIScenarioManagerShardedAccess {
+public:
+    TraCIScenarioManagerSharded* get()
+    {
+        return FindModule<TraCIScenarioManagerSharded*>::findGlobalModule();
+    };
+};
+
+} // namespace veins
@@ -35,6 +35,16 @@ Define_Module(veins::TraCIScreenRecorder);
 void TraCIScreenRecorder::initialize(int stage)
 {
     if (stage == 0) {
+        asynchronous = par("asynchronous").boolValue();
+        overheadBudget = par("overheadBudget").doubleValue();
+        if (overheadBudget < 0) throw cRuntimeError("overheadBudget must not be negative");
+
+        if (asynchronous) {
+            TraCIScenarioManager* manager = TraCIScenarioManagerAccess().get();
+            ASSERT(manager);
+            manager->subscribe(TraCIScenarioManager::traciTimestepEndSignal, this);
+        }
+
         takeScreenshot = new cMessage("take screenshot");
         takeScreenshot->setSchedulingPriority(1); // this schedules screenshots after TraCI timesteps
         scheduleAt(par("start"), takeScreenshot);
@@ -42,10 +52,40 @@ void TraCIScreenRecorder::initialize(int stage)
     }
 }
 
-void TraCIScreenRecorder::handleMessage(cMessage* msg)
+void TraCIScreenRecorder::receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details)
 {
-    ASSERT(msg == takeScreenshot);
+    ASSERT(signalID == TraCIScenarioManager::traciTimestepEndSignal);
+
+    TraCIScenarioManager* manager = check_and_cast<TraCIScenarioManager*>(source);
+    const auto stepWallTime = manager->getTraciStepWallTime();
+    const double stepTime = std::chrono::duration<double>(stepWallTime - lastStepWallTime).count();
+    lastStepWallTime = stepWallTime;
+
+    // the step following a confirmed screenshot is where the TraCI server renders it, every other step tells what a step costs without one
+    const double averagingWeight = 0.1;
+    if (confirmed) {
+        totalCost += std::max(0.0, stepTime - plainStepTime);
+        confirmed = false;
+    }
+    else if (plainStepTime == 0) {
+        plainStepTime = stepTime;
+    }
+    else {
+        plainStepTime += averagingWeight * (stepTime - plainStepTime);
+    }
+}
+
+bool TraCIScreenRecorder::mustSkip() const
+{
+    if (!asynchronous) return false;
+    if (inFlight) return true;
+    if (overheadBudget == 0 || screenshotsTaken == 0) return false;
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return totalCost > overheadBudget * elapsed;
+}
 
+std::string TraCIScreenRecorder::getFilename()
+{
     // get dirname
     const char* dirname = par("dirname").stringValue();
     if (std::string(dirname) == "") {
@@ -86,6 +126,13 @@ void TraCIScreenRecorder::handleMessage(cMessage* msg)
         filename = buf;
     }
 
+    return filename;
+}
+
+void TraCIScreenRecorder::handleMessage(cMessage* msg)
+{
+    ASSERT(msg == takeScreenshot);
+
     // take screenshot
     TraCIScenarioManager* manager = TraCIScenarioManagerAccess().get();
     ASSERT(manager);
@@ -94,7 +141,27 @@ void TraCIScreenRecorder::handleMessage(cMessage* msg)
         throw cRuntimeError("Cannot create screenshot: TraCI is not connected yet");
     }
     TraCICommandInterface::GuiView view = traci->guiView(par("viewName"));
-    view.takeScreenshot(filename);
+    if (!asynchronous) {
+        view.takeScreenshot(getFilename());
+        screenshotsTaken++;
+    }
+    else if (mustSkip()) {
+        EV_DEBUG << "Skipping screenshot at " << simTime() << (inFlight ? " (previous one still in flight)" : " (overhead budget exceeded)") << std::endl;
+        screenshotsSkipped++;
+    }
+    else {
+        if (screenshotsTaken == 0) {
+            wallStart = std::chrono::steady_clock::now();
+            lastStepWallTime = manager->getTraciStepWallTime();
+        }
+        inFlight = true;
+        view.queueTakeScreenshot(getFilename(), -1, -1, [this](bool success, const std::string& message) {
+            if (!success) throw cRuntimeError("Screenshot failed: %s", message.c_str());
+            inFlight = false;
+            confirmed = true;
+        });
+        screenshotsTaken++;
+    }
 
     // schedule next screenshot
     simtime_t stop = par("stop");
@@ -105,5 +172,12 @@ void TraCIScreenRecorder::handleMessage(cMessage* msg)
 
 void TraCIScreenRecorder::finish()
 {
+    if (asynchronous) {
+        TraCIScenarioManager* manager = TraCIScenarioManagerAccess().get();
+        if (manager) manager->unsubscribe(TraCIScenarioManager::traciTimestepEndSignal, this);
+        recordScalar("screenshotsSkipped", screenshotsSkipped);
+        recordScalar("screenshotCost", totalCost);
+    }
+    recordScalar("screenshotsTaken", screenshotsTaken);
     cancelAndDelete(takeScreenshot);
 }
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "veins/veins.h"
 
 namespace veins {
@@ -35,6 +37,10 @@ namespace veins {
  * The screenshots can then be converted to a video using something along the lines of
  * mencoder 'mf://results/screenshot-*.png' -mf w=800:h=600:fps=25:type=png -ovc lavc -lavcopts vcodec=mpeg4:mbd=2:trell -oac copy -o output.avi
  *
+ * If asynchronous is set, screenshots are queued and sent along with the next simulation step instead of waiting for the
+ * TraCI server to render them. A frame is then skipped while the previous one is still in flight or, if overheadBudget is
+ * set, while the estimated cost of the screenshots taken so far exceeds the given fraction of wall-clock time.
+ *
  * See the Veins website <a href="http://veins.car2x.org/"> for a tutorial, documentation, and publications </a>.
  *
  * @author Christoph Sommer
@@ -42,14 +48,38 @@ namespace veins {
  * @see TraCIScenarioManager
  *
  */
-class VEINS_API TraCIScreenRecorder : public cSimpleModule {
+class VEINS_API TraCIScreenRecorder : public cSimpleModule, public cListener {
 public:
     void initialize(int stage) override;
     void handleMessage(cMessage* msg) override;
     void finish() override;
+    void receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details) override;
+
+protected:
+    /**
+     * returns the absolute file name of the screenshot to take now
+     */
+    std::string getFilename();
+
+    /**
+     * returns whether the screenshot due now should be skipped to stay within overheadBudget
+     */
+    bool mustSkip() const;
 
 protected:
     cMessage* takeScreenshot;
+
+    bool asynchronous; /**< whether screenshots are queued instead of waiting for the TraCI server to take them */
+    double overheadBudget; /**< fraction of wall-clock time asynchronous screenshots may cost (0: unlimited) */
+
+    bool inFlight = false; /**< whether a queued screenshot has not been confirmed yet */
+    bool confirmed = false; /**< whether a screenshot was confirmed, so the next step carries its cost */
+    size_t screenshotsTaken = 0;
+    size_t screenshotsSkipped = 0;
+    std::chrono::steady_clock::time_point wallStart; /**< when the first screenshot was taken */
+    std::chrono::steady_clock::duration lastStepWallTime = std::chrono::steady_clock::duration::zero(); /**< TraCIScenarioManager::getTraciStepWallTime() at the end of the last step */
+    double plainStepTime = 0; /**< moving average of the wall time of steps not carrying a screenshot (in s) */
+    double totalCost = 0; /**< estimated wall time spent on screenshots so far (in s) */
 };
 
 } // namespace veins
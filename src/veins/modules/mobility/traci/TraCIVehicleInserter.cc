@@ -154,32 +154,51 @@ void TraCIVehicleInserter::insertNewVehicle()
 
 void TraCIVehicleInserter::insertVehicles()
 {
+    std::vector<TraCICommandInterface::VehicleAddition> vehicles;
 
     for (std::map<int, std::queue<std::string>>::iterator i = vehicleInsertQueue.begin(); i != vehicleInsertQueue.end();) {
         std::string route = routeIds[i->first];
         EV_DEBUG << "process " << route << std::endl;
-        std::queue<std::string> vehicles = i->second;
         while (!i->second.empty()) {
-            bool suc = false;
             std::string type = i->second.front();
             std::stringstream veh;
             veh << type << "_" << vehicleNameCounter;
             EV_DEBUG << "trying to add " << veh.str() << " with " << route << " vehicle type " << type << std::endl;
 
-            suc = manager->getCommandInterface()->addVehicle(veh.str(), type, route, simTime());
-            if (!suc) {
-                i->second.pop();
-            }
-            else {
-                EV_DEBUG << "successful inserted " << veh.str() << std::endl;
-                queuedVehicles.insert(veh.str());
-                i->second.pop();
-                vehicleNameCounter++;
-            }
+            // vehicle names stay unique even if an insertion fails
+            TraCICommandInterface::VehicleAddition vehicle;
+            vehicle.vehicleId = veh.str();
+            vehicle.vehicleTypeId = type;
+            vehicle.routeId = route;
+            vehicle.emitTime_st = simTime();
+            vehicles.push_back(vehicle);
+            i->second.pop();
+            vehicleNameCounter++;
         }
         std::map<int, std::queue<std::string>>::iterator tmp = i;
         ++tmp;
         vehicleInsertQueue.erase(i);
         i = tmp;
     }
+
+    if (vehicles.empty()) return;
+
+    // sent as one batch along with the upcoming simulation step
+    std::vector<std::string> vehicleIds;
+    vehicleIds.reserve(vehicles.size());
+    for (const auto& vehicle : vehicles) {
+        vehicleIds.push_back(vehicle.vehicleId);
+    }
+    manager->getCommandInterface()->queueAddVehicles(vehicles, [this, vehicleIds](const std::vector<bool>& results) {
+        size_t numFailed = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i]) {
+                queuedVehicles.insert(vehicleIds[i]);
+            }
+            else {
+                numFailed++;
+            }
+        }
+        EV_DEBUG << "successfully inserted " << (results.size() - numFailed) << " of " << results.size() << " vehicles" << std::endl;
+    });
 }
@@ -0,0 +1,80 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/mobility/traci/TraCIVehicleLayer.h"
+
+#include <utility>
+
+using veins::TraCIVehicleLayer;
+
+namespace {
+
+// used for vehicles SUMO reported no size for
+const double defaultLength = 5;
+const double defaultWidth = 1.8;
+
+} // namespace
+
+TraCIVehicleLayer::TraCIVehicleLayer(cCanvas* canvas, const cFigure::Color& color, std::shared_ptr<const MobilityStateStore> stateStore)
+    : canvas(canvas)
+    , figure(new cPathFigure("vehicles"))
+    , stateStore(std::move(stateStore))
+{
+    ASSERT(canvas);
+    figure->setFilled(true);
+    figure->setFillColor(color);
+    figure->setOutlined(false);
+    canvas->addFigure(figure);
+}
+
+TraCIVehicleLayer::~TraCIVehicleLayer()
+{
+    delete canvas->removeFigure(figure);
+}
+
+void TraCIVehicleLayer::add(MobilityStateStore::Handle handle, double length, double width)
+{
+    vehicles[handle] = {(length > 0) ? length : defaultLength, (width > 0) ? width : defaultWidth};
+}
+
+void TraCIVehicleLayer::remove(MobilityStateStore::Handle handle)
+{
+    vehicles.erase(handle);
+}
+
+void TraCIVehicleLayer::update()
+{
+    figure->clearPath();
+    for (const auto& vehicle : vehicles) {
+        if (!stateStore->isValid(vehicle.first)) continue;
+        const Coord front = stateStore->getPosition(vehicle.first);
+        const Coord forward = stateStore->getHeading(vehicle.first).toCoord();
+        const Coord back = forward * -vehicle.second.length;
+        const Coord side = Coord(-forward.y, forward.x) * (vehicle.second.width / 2);
+
+        figure->addMoveTo(front.x + side.x, front.y + side.y);
+        figure->addLineTo(front.x - side.x, front.y - side.y);
+        figure->addLineTo(front.x + back.x - side.x, front.y + back.y - side.y);
+        figure->addLineTo(front.x + back.x + side.x, front.y + back.y + side.y);
+        figure->addClosePath();
+    }
+}
@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/MobilityStateStore.h"
+
+namespace veins {
+
+/**
+ * Draws all managed vehicles as a single canvas figure, redrawn once per TraCI step.
+ *
+ * Meant to replace the hosts' own icons in GUI runs: moving hundreds of icons (by changing their display strings) one at a time
+ * makes the GUI refresh once for every vehicle, while this layer changes only one figure per step.
+ * Vehicles are drawn as rectangles of their length and width, behind their position (i.e., their front bumper) and along their heading,
+ * as read from the world's MobilityStateStore.
+ *
+ * @see TraCIScenarioManager
+ */
+class VEINS_API TraCIVehicleLayer {
+public:
+    /**
+     * Adds the (empty) layer to canvas.
+     */
+    TraCIVehicleLayer(cCanvas* canvas, const cFigure::Color& color, std::shared_ptr<const MobilityStateStore> stateStore);
+    ~TraCIVehicleLayer();
+
+    /**
+     * Starts drawing the host in slot handle of the state store, as a vehicle of the given size (in m).
+     */
+    void add(MobilityStateStore::Handle handle, double length, double width);
+
+    /**
+     * Stops drawing the host in slot handle of the state store.
+     */
+    void remove(MobilityStateStore::Handle handle);
+
+    /**
+     * Redraws all vehicles at their current state.
+     */
+    void update();
+
+    size_t size() const
+    {
+        return vehicles.size();
+    }
+
+protected:
+    struct Size {
+        double length;
+        double width;
+    };
+
+    cCanvas* canvas;
+    cPathFigure* figure;
+    std::shared_ptr<const MobilityStateStore> stateStore;
+    std::unordered_map<MobilityStateStore::Handle, Size> vehicles; /**< drawn vehicles, by slot in stateStore */
+};
+
+} // namespace veins
@@ -20,7 +20,7 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //
 
-#include <set>
+#include <algorithm>
 #include <limits>
 #include "veins/modules/obstacle/MobileHostObstacle.h"
 #include "veins/base/modules/BaseMobility.h"
@@ -31,7 +31,8 @@ using veins::MobileHostObstacle;
 
 namespace {
 
-bool isPointInObstacle(Coord point, const MobileHostObstacle::Coords& shape)
+template <typename Shape>
+bool isPointInObstacle(Coord point, const Shape& shape)
 {
     bool isInside = false;
     auto i = shape.begin();
@@ -65,24 +66,59 @@ double segmentsIntersectAt(Coord p1From, Coord p1To, Coord p2From, Coord p2To)
     return p1Frac;
 }
 
+bool boundsOverlap(const Coord& p, double o, double lw, double x1, double y1, double x2, double y2)
+{
+    double xx1 = p.x - o - lw;
+    double xx2 = p.x + o + lw;
+    double yy1 = p.y - o - lw;
+    double yy2 = p.y + o + lw;
+
+    if (xx2 < x1) return false;
+    if (xx1 > x2) return false;
+    if (yy2 < y1) return false;
+    if (yy1 > y2) return false;
+
+    return true;
+}
+
 } // namespace
 
 MobileHostObstacle::Coords MobileHostObstacle::getShape(simtime_t t) const
+{
+    auto corners = getCorners(t);
+    return Coords(corners.begin(), corners.end());
+}
+
+MobileHostObstacle::Footprint MobileHostObstacle::getFootprint() const
 {
     double l = getLength();
     double o = getHostPositionOffset(); // this is the shift we have to undo in order to (given the OMNeT++ host position) get the car's front bumper position
     double w = getWidth() / 2;
-    const BaseMobility* m = getMobility();
-    Coord p = m->getPositionAt(t);
-    double a = Heading::fromCoord(m->getCurrentOrientation()).getRad();
-
-    Coords shape;
-    shape.push_back(p + Coord(-(l - o), -w).rotatedYaw(-a));
-    shape.push_back(p + Coord(+o, -w).rotatedYaw(-a));
-    shape.push_back(p + Coord(+o, +w).rotatedYaw(-a));
-    shape.push_back(p + Coord(-(l - o), +w).rotatedYaw(-a));
+    double a = Heading::fromCoord(getMobility()->getCurrentOrientation()).getRad();
+
+    Footprint footprint;
+    footprint.cornerOffsets = {{
+        Coord(-(l - o), -w).rotatedYaw(-a),
+        Coord(+o, -w).rotatedYaw(-a),
+        Coord(+o, +w).rotatedYaw(-a),
+        Coord(-(l - o), +w).rotatedYaw(-a),
+    }};
+    footprint.offset = std::abs(o);
+    footprint.reach = std::max(l, w);
+    return footprint;
+}
 
-    return shape;
+std::array<Coord, 4> MobileHostObstacle::getCorners(simtime_t t) const
+{
+    const Footprint footprint = getFootprint();
+    Coord p = getMobility()->getPositionAt(t);
+
+    return {{
+        p + footprint.cornerOffsets[0],
+        p + footprint.cornerOffsets[1],
+        p + footprint.cornerOffsets[2],
+        p + footprint.cornerOffsets[3],
+    }};
 }
 
 bool MobileHostObstacle::maybeInBounds(double x1, double y1, double x2, double y2, simtime_t t) const
@@ -93,36 +129,33 @@ bool MobileHostObstacle::maybeInBounds(double x1, double y1, double x2, double y
     const BaseMobility* m = getMobility();
     Coord p = m->getPositionAt(t);
 
-    double lw = std::max(l, w);
-
-    double xx1 = p.x - std::abs(o) - lw;
-    double xx2 = p.x + std::abs(o) + lw;
-    double yy1 = p.y - std::abs(o) - lw;
-    double yy2 = p.y + std::abs(o) + lw;
-
-    if (xx2 < x1) return false;
-    if (xx1 > x2) return false;
-    if (yy2 < y1) return false;
-    if (yy1 > y2) return false;
+    return boundsOverlap(p, std::abs(o), std::max(l, w), x1, y1, x2, y2);
+}
 
-    return true;
+bool MobileHostObstacle::maybeInBounds(const Coord& position, const Footprint& footprint, double x1, double y1, double x2, double y2)
+{
+    return boundsOverlap(position, footprint.offset, footprint.reach, x1, y1, x2, y2);
 }
 
 double MobileHostObstacle::getIntersectionPoint(const Coord& senderPos, const Coord& receiverPos, simtime_t t) const
 {
-    const double not_a_number = std::numeric_limits<double>::quiet_NaN();
+    return getIntersectionPoint(getCorners(t), senderPos, receiverPos);
+}
 
-    MobileHostObstacle::Coords shape = getShape(t);
+double MobileHostObstacle::getIntersectionPoint(const std::array<Coord, 4>& shape, const Coord& senderPos, const Coord& receiverPos)
+{
+    const double not_a_number = std::numeric_limits<double>::quiet_NaN();
 
     // shortcut if sender is inside
     bool senderInside = isPointInObstacle(senderPos, shape);
     if (senderInside) return 0;
 
     // get a list of points (in [0, 1]) along the line between sender and receiver where the beam intersects with this obstacle
-    std::multiset<double> intersectAt;
+    // (only the closest one is of interest)
+    double firstIntersectAt = std::numeric_limits<double>::infinity();
     bool doesIntersect = false;
-    MobileHostObstacle::Coords::const_iterator i = shape.begin();
-    MobileHostObstacle::Coords::const_iterator j = (shape.rbegin() + 1).base();
+    auto i = shape.begin();
+    auto j = (shape.rbegin() + 1).base();
     for (; i != shape.end(); j = i++) {
         Coord c1 = *i;
         Coord c2 = *j;
@@ -131,7 +164,7 @@ double MobileHostObstacle::getIntersectionPoint(const Coord& senderPos, const Co
         if (inter != -1) {
             doesIntersect = true;
             EV << "intersect: " << inter << endl;
-            intersectAt.insert(inter);
+            firstIntersectAt = std::min(firstIntersectAt, inter);
         }
     }
 
@@ -142,5 +175,5 @@ double MobileHostObstacle::getIntersectionPoint(const Coord& senderPos, const Co
         return not_a_number;
     }
 
-    return (*intersectAt.begin() * senderPos.distance(receiverPos));
+    return (firstIntersectAt * senderPos.distance(receiverPos));
 }
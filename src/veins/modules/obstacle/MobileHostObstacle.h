@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "veins/base/utils/Coord.h"
@@ -96,15 +97,44 @@ public:
         return height;
     }
 
+    /**
+     * footprint of the obstacle relative to its host position, which only changes with the host's orientation (i.e., with a mobility update)
+     */
+    struct Footprint {
+        std::array<Coord, 4> cornerOffsets; /**< corners relative to the host position, in the same order as getShape */
+        double offset; /**< absolute host position offset */
+        double reach; /**< larger of length and half width */
+    };
+
+    /**
+     * return the footprint of the obstacle given its host's current orientation
+     */
+    Footprint getFootprint() const;
+
     Coords getShape(simtime_t t) const;
 
+    /**
+     * return the four corners of the obstacle at time t, in the same order as getShape
+     */
+    std::array<Coord, 4> getCorners(simtime_t t) const;
+
     bool maybeInBounds(double x1, double y1, double x2, double y2, simtime_t t) const;
 
+    /**
+     * like the above, for an obstacle with the given footprint whose host is at position
+     */
+    static bool maybeInBounds(const Coord& position, const Footprint& footprint, double x1, double y1, double x2, double y2);
+
     /**
      * return closest point (in meters) along (senderPos--receiverPos) where this obstacle overlaps, or NAN if it doesn't
      */
     double getIntersectionPoint(const Coord& senderPos, const Coord& receiverPos, simtime_t t) const;
 
+    /**
+     * like the above, for an obstacle with the given corners (see getCorners)
+     */
+    static double getIntersectionPoint(const std::array<Coord, 4>& corners, const Coord& senderPos, const Coord& receiverPos);
+
 protected:
     /**
      * Positions with identiers for all antennas connected to the host of this obstacle.
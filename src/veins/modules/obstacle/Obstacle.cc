@@ -21,6 +21,13 @@
 //
 
 #include <algorithm>
+#include <utility>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "veins/modules/obstacle/Obstacle.h"
 
@@ -48,6 +55,29 @@ void Obstacle::setShape(Coords shape)
         bboxP2.x = std::max(i->x, bboxP2.x);
         bboxP2.y = std::max(i->y, bboxP2.y);
     }
+    updateEdges();
+}
+
+void Obstacle::setShape(Coords shape, Coord bboxP1, Coord bboxP2)
+{
+    coords = std::move(shape);
+    this->bboxP1 = bboxP1;
+    this->bboxP2 = bboxP2;
+    updateEdges();
+}
+
+void Obstacle::updateEdges()
+{
+    const size_t n = coords.size();
+    edges.resize(4 * n);
+    for (size_t k = 0; k < n; ++k) {
+        const Coord& from = coords[k];
+        const Coord& to = coords[(k + n - 1) % n];
+        edges[k] = from.x;
+        edges[n + k] = from.y;
+        edges[2 * n + k] = to.x - from.x;
+        edges[3 * n + k] = to.y - from.y;
+    }
 }
 
 const Obstacle::Coords& Obstacle::getShape() const
@@ -83,45 +113,101 @@ bool Obstacle::containsPoint(Coord point) const
     return isInside;
 }
 
-namespace {
-
-double segmentsIntersectAt(const Coord& p1From, const Coord& p1To, const Coord& p2From, const Coord& p2To)
+std::vector<double> Obstacle::getIntersections(const Coord& senderPos, const Coord& receiverPos) const
 {
-    double p1x = p1To.x - p1From.x;
-    double p1y = p1To.y - p1From.y;
-    double p2x = p2To.x - p2From.x;
-    double p2y = p2To.y - p2From.y;
-    double p1p2x = p1From.x - p2From.x;
-    double p1p2y = p1From.y - p2From.y;
-    double D = (p1x * p2y - p1y * p2x);
+    std::vector<double> intersectAt(coords.size());
+    intersectAt.resize(getIntersections(senderPos, receiverPos, intersectAt.data()));
+    return intersectAt;
+}
 
-    double p1Frac = (p2x * p1p2y - p2y * p1p2x) / D;
-    if (p1Frac < 0 || p1Frac > 1) return -1;
+size_t Obstacle::getIntersections(const Coord& senderPos, const Coord& receiverPos, double* intersectAt) const
+{
+    // for edge k from (x, y) in direction (dx, dy), the beam intersects it at
+    //   p1Frac = (dx * (sender.y - y) - dy * (sender.x - x)) / D
+    // with D = p1x * dy - p1y * dx; the point is on the edge if the corresponding p2Frac is in [0, 1], too
+    // (comparisons are written such that NaN values are accepted, like in the scalar code)
+    const size_t n = coords.size();
+    const double* startX = edges.data();
+    const double* startY = startX + n;
+    const double* dirX = startY + n;
+    const double* dirY = dirX + n;
+    const double p1x = receiverPos.x - senderPos.x;
+    const double p1y = receiverPos.y - senderPos.y;
+    size_t numFound = 0;
+    size_t k = 0;
+
+#if defined(__AVX__)
+    {
+        const __m256d vp1x = _mm256_set1_pd(p1x);
+        const __m256d vp1y = _mm256_set1_pd(p1y);
+        const __m256d senderX = _mm256_set1_pd(senderPos.x);
+        const __m256d senderY = _mm256_set1_pd(senderPos.y);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1);
+        for (; k + 4 <= n; k += 4) {
+            const __m256d p2x = _mm256_loadu_pd(dirX + k);
+            const __m256d p2y = _mm256_loadu_pd(dirY + k);
+            const __m256d p1p2x = _mm256_sub_pd(senderX, _mm256_loadu_pd(startX + k));
+            const __m256d p1p2y = _mm256_sub_pd(senderY, _mm256_loadu_pd(startY + k));
+            const __m256d D = _mm256_sub_pd(_mm256_mul_pd(vp1x, p2y), _mm256_mul_pd(vp1y, p2x));
+            const __m256d p1Frac = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(p2x, p1p2y), _mm256_mul_pd(p2y, p1p2x)), D);
+            const __m256d p2Frac = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(vp1x, p1p2y), _mm256_mul_pd(vp1y, p1p2x)), D);
+            const __m256d p1In = _mm256_and_pd(_mm256_cmp_pd(p1Frac, zero, _CMP_NLT_UQ), _mm256_cmp_pd(p1Frac, one, _CMP_NGT_UQ));
+            const __m256d p2In = _mm256_and_pd(_mm256_cmp_pd(p2Frac, zero, _CMP_NLT_UQ), _mm256_cmp_pd(p2Frac, one, _CMP_NGT_UQ));
+            const int hits = _mm256_movemask_pd(_mm256_and_pd(p1In, p2In));
+            if (hits == 0) continue;
+            double fractions[4];
+            _mm256_storeu_pd(fractions, p1Frac);
+            for (int lane = 0; lane < 4; ++lane) {
+                if (hits & (1 << lane)) intersectAt[numFound++] = fractions[lane];
+            }
+        }
+    }
+#elif defined(__SSE2__)
+    {
+        const __m128d vp1x = _mm_set1_pd(p1x);
+        const __m128d vp1y = _mm_set1_pd(p1y);
+        const __m128d senderX = _mm_set1_pd(senderPos.x);
+        const __m128d senderY = _mm_set1_pd(senderPos.y);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d one = _mm_set1_pd(1);
+        for (; k + 2 <= n; k += 2) {
+            const __m128d p2x = _mm_loadu_pd(dirX + k);
+            const __m128d p2y = _mm_loadu_pd(dirY + k);
+            const __m128d p1p2x = _mm_sub_pd(senderX, _mm_loadu_pd(startX + k));
+            const __m128d p1p2y = _mm_sub_pd(senderY, _mm_loadu_pd(startY + k));
+            const __m128d D = _mm_sub_pd(_mm_mul_pd(vp1x, p2y), _mm_mul_pd(vp1y, p2x));
+            const __m128d p1Frac = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(p2x, p1p2y), _mm_mul_pd(p2y, p1p2x)), D);
+            const __m128d p2Frac = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(vp1x, p1p2y), _mm_mul_pd(vp1y, p1p2x)), D);
+            const __m128d p1In = _mm_and_pd(_mm_cmpnlt_pd(p1Frac, zero), _mm_cmpngt_pd(p1Frac, one));
+            const __m128d p2In = _mm_and_pd(_mm_cmpnlt_pd(p2Frac, zero), _mm_cmpngt_pd(p2Frac, one));
+            const int hits = _mm_movemask_pd(_mm_and_pd(p1In, p2In));
+            if (hits == 0) continue;
+            double fractions[2];
+            _mm_storeu_pd(fractions, p1Frac);
+            if (hits & 1) intersectAt[numFound++] = fractions[0];
+            if (hits & 2) intersectAt[numFound++] = fractions[1];
+        }
+    }
+#endif
 
-    double p2Frac = (p1x * p1p2y - p1y * p1p2x) / D;
-    if (p2Frac < 0 || p2Frac > 1) return -1;
+    for (; k < n; ++k) {
+        const double p2x = dirX[k];
+        const double p2y = dirY[k];
+        const double p1p2x = senderPos.x - startX[k];
+        const double p1p2y = senderPos.y - startY[k];
+        const double D = (p1x * p2y - p1y * p2x);
 
-    return p1Frac;
-}
-} // namespace
+        const double p1Frac = (p2x * p1p2y - p2y * p1p2x) / D;
+        if (p1Frac < 0 || p1Frac > 1) continue;
 
-std::vector<double> Obstacle::getIntersections(const Coord& senderPos, const Coord& receiverPos) const
-{
-    std::vector<double> intersectAt;
-    const Obstacle::Coords& shape = getShape();
-    Obstacle::Coords::const_iterator i = shape.begin();
-    Obstacle::Coords::const_iterator j = (shape.rbegin() + 1).base();
-    for (; i != shape.end(); j = i++) {
-        const Coord& c1 = *i;
-        const Coord& c2 = *j;
+        const double p2Frac = (p1x * p1p2y - p1y * p1p2x) / D;
+        if (p2Frac < 0 || p2Frac > 1) continue;
 
-        double i = segmentsIntersectAt(senderPos, receiverPos, c1, c2);
-        if (i != -1) {
-            intersectAt.push_back(i);
-        }
+        intersectAt[numFound++] = p1Frac;
     }
-    std::sort(intersectAt.begin(), intersectAt.end());
-    return intersectAt;
+    std::sort(intersectAt, intersectAt + numFound);
+    return numFound;
 }
 
 std::string Obstacle::getType() const
@@ -41,6 +41,10 @@ public:
     Obstacle(std::string id, std::string type, double attenuationPerCut, double attenuationPerMeter);
 
     void setShape(Coords shape);
+    /**
+     * set shape and its (already known) bounding box, e.g., when loading from an ObstacleDatabase
+     */
+    void setShape(Coords shape, Coord bboxP1, Coord bboxP2);
     const Coords& getShape() const;
     const Coord getBboxP1() const;
     const Coord getBboxP2() const;
@@ -56,6 +60,13 @@ public:
      */
     std::vector<double> getIntersections(const Coord& senderPos, const Coord& receiverPos) const;
 
+    /**
+     * like getIntersections, but write the (sorted) points to intersectAt, which must have room for getShape().size() values, and return their number
+     *
+     * Tests several edges at once where SIMD instructions are available.
+     */
+    size_t getIntersections(const Coord& senderPos, const Coord& receiverPos, double* intersectAt) const;
+
     AnnotationManager::Annotation* visualRepresentation;
 
 protected:
@@ -66,6 +77,12 @@ protected:
     Coords coords;
     Coord bboxP1;
     Coord bboxP2;
+    std::vector<double> edges; /**< edge k (from vertex k to the one before) as structure of arrays: n start x, n start y, n direction x, n direction y values */
+
+    /**
+     * fill edges from coords
+     */
+    void updateEdges();
 };
 
 } // namespace veins
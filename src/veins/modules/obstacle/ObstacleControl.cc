@@ -20,27 +20,53 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //
 
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <fstream>
 #include <map>
 #include <set>
+#include <cmath>
+#include <random>
 
 #include "veins/modules/obstacle/ObstacleControl.h"
+#include "veins/modules/obstacle/ObstacleDatabase.h"
+#include "veins/modules/obstacle/ObstacleShapes.h"
 #include "veins/base/modules/BaseWorldUtility.h"
+#include "veins/modules/utility/TaskScheduler.h"
 
+using veins::MemoryAccounting;
 using veins::ObstacleControl;
 
 Define_Module(veins::ObstacleControl);
 
 namespace {
 
-veins::BBoxLookup rebuildBBoxLookup(const std::vector<std::unique_ptr<veins::Obstacle>>& obstacleOwner, int gridCellSize = 250)
+std::vector<veins::Obstacle*> getObstaclePointers(const std::vector<std::unique_ptr<veins::Obstacle>>& obstacleOwner)
 {
     std::vector<veins::Obstacle*> obstaclePointers;
     obstaclePointers.reserve(obstacleOwner.size());
     std::transform(obstacleOwner.begin(), obstacleOwner.end(), std::back_inserter(obstaclePointers), [](const std::unique_ptr<veins::Obstacle>& obstacle) { return obstacle.get(); });
+    return obstaclePointers;
+}
+
+veins::BBoxLookup::Box getBBox(veins::Obstacle* o)
+{
+    return veins::BBoxLookup::Box{{o->getBboxP1().x, o->getBboxP1().y}, {o->getBboxP2().x, o->getBboxP2().y}};
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+veins::BBoxLookup rebuildBBoxLookup(const std::vector<std::unique_ptr<veins::Obstacle>>& obstacleOwner, int gridCellSize = 250, veins::WorkerPool* pool = nullptr)
+{
+    const auto start = std::chrono::steady_clock::now();
     auto playgroundSize = veins::FindModule<veins::BaseWorldUtility*>::findGlobalModule()->getPgs();
-    auto bboxFunction = [](veins::Obstacle* o) { return veins::BBoxLookup::Box{{o->getBboxP1().x, o->getBboxP1().y}, {o->getBboxP2().x, o->getBboxP2().y}}; };
-    return veins::BBoxLookup(obstaclePointers, bboxFunction, playgroundSize->x, playgroundSize->y, gridCellSize);
+    veins::BBoxLookup lookup(getObstaclePointers(obstacleOwner), getBBox, playgroundSize->x, playgroundSize->y, gridCellSize, pool);
+    EV_INFO << "Built lookup of " << obstacleOwner.size() << " obstacles in " << secondsSince(start) << " s" << endl;
+    return lookup;
 }
 
 } // anonymous namespace
@@ -54,26 +80,100 @@ void ObstacleControl::initialize(int stage)
     if (stage == 1) {
         obstacleOwner.clear();
         cacheEntries.clear();
+        visibilityMaps.clear();
         isBboxLookupDirty = true;
+        geometryVersion++;
 
         annotations = AnnotationManagerAccess().getIfExists();
         if (annotations) annotationGroup = annotations->createGroup("obstacles");
 
+        memoryRegistration = MemoryAccounting::add("obstacleControl", [this]() { return getMemoryUsage(); });
+
         obstaclesXml = par("obstacles");
         gridCellSize = par("gridCellSize");
         if (gridCellSize < 1) {
             throw cRuntimeError("gridCellSize was %d, but must be a positive integer number", gridCellSize);
         }
 
-        addFromXml(obstaclesXml);
+        int cacheCapacity = par("cacheCapacity");
+        if (cacheCapacity < 0) {
+            throw cRuntimeError("cacheCapacity was %d, but must not be negative", cacheCapacity);
+        }
+        cacheEntries.setCapacity(cacheCapacity);
+        cachePositionQuantization = par("cachePositionQuantization");
+        if (cachePositionQuantization < 0) {
+            throw cRuntimeError("cachePositionQuantization was %f, but must not be negative", cachePositionQuantization);
+        }
+
+        visibilityMapResolution = par("visibilityMapResolution");
+        if (visibilityMapResolution < 0) {
+            throw cRuntimeError("visibilityMapResolution was %f, but must not be negative", visibilityMapResolution);
+        }
+        visibilityMapCacheDir = par("visibilityMapCacheDir").stdstringValue();
+
+        simplificationTolerance = par("simplificationTolerance");
+        if (simplificationTolerance < 0) {
+            throw cRuntimeError("simplificationTolerance was %f, but must not be negative", simplificationTolerance);
+        }
+        mergeTouchingObstacles = par("mergeTouchingObstacles");
+        maxSimplificationError = par("maxSimplificationError");
+
+        int numLoaderThreads = hasPar("numLoaderThreads") ? par("numLoaderThreads").intValue() : 0;
+        if (numLoaderThreads < -1) throw cRuntimeError("numLoaderThreads must not be less than -1");
+        if (numLoaderThreads == -1) loaderPool = TaskScheduler::getSharedPool(this);
+        if (numLoaderThreads > 0) loaderPool = std::make_shared<WorkerPool>(numLoaderThreads);
+
+        std::string obstacleDatabase = par("obstacleDatabase").stdstringValue();
+        bool loadInBackground = hasPar("loadInBackground") ? par("loadInBackground").boolValue() : false;
+        if (obstacleDatabase.empty() && loadInBackground) {
+            std::vector<ObstacleRecord> records;
+            readXml(obstaclesXml, records);
+            startBackgroundLoad(std::move(records));
+        }
+        else if (obstacleDatabase.empty()) {
+            addFromXml(obstaclesXml);
+            preprocessObstacles();
+        }
+        else if (std::ifstream(obstacleDatabase)) {
+            addFromDatabase(obstacleDatabase);
+        }
+        else {
+            addFromXml(obstaclesXml);
+            preprocessObstacles();
+            writeDatabase(obstacleDatabase);
+        }
     }
 }
 
 void ObstacleControl::finish()
 {
+    awaitBackgroundLoad();
+    recordScalar("attenuationCacheHits", cacheEntries.getHits());
+    recordScalar("attenuationCacheMisses", cacheEntries.getMisses());
+    if (usesVisibilityMaps()) recordScalar("visibilityMapLookups", visibilityMapLookups);
     obstacleOwner.clear();
 }
 
+MemoryAccounting::Usage ObstacleControl::getMemoryUsage() const
+{
+    awaitBackgroundLoad();
+    MemoryAccounting::Usage usage;
+    usage.objects = obstacleOwner.size();
+    usage.bytes = MemoryAccounting::bytesOf(obstacleOwner);
+    for (const auto& obstacle : obstacleOwner) {
+        // the edges are stored as four doubles per vertex, see Obstacle::edges
+        const auto& shape = obstacle->getShape();
+        usage.bytes += sizeof(Obstacle) + MemoryAccounting::bytesOf(shape) + 4 * shape.size() * sizeof(double);
+    }
+    if (!isBboxLookupDirty) usage.bytes += bboxLookup.getBytesUsed();
+    // each cache entry is a list node and a hash map node
+    usage.bytes += cacheEntries.size() * (2 * sizeof(CacheKey) + sizeof(double) + 6 * sizeof(void*));
+    usage.bytes += MemoryAccounting::bytesOfNodes(visibilityMaps);
+    for (const auto& visibilityMap : visibilityMaps) usage.bytes += MemoryAccounting::bytesOf(visibilityMap.second.attenuation_dB);
+    usage.bytes += MemoryAccounting::bytesOf(intersectionBuffer) + MemoryAccounting::bytesOf(candidateBuffer) + MemoryAccounting::bytesOfNodes(perCut) + MemoryAccounting::bytesOfNodes(perMeter);
+    return usage;
+}
+
 void ObstacleControl::handleMessage(cMessage* msg)
 {
     if (msg->isSelfMessage()) {
@@ -89,6 +189,30 @@ void ObstacleControl::handleSelfMsg(cMessage* msg)
 }
 
 void ObstacleControl::addFromXml(cXMLElement* xml)
+{
+    awaitBackgroundLoad();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ObstacleRecord> records;
+    readXml(xml, records);
+    const double readTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<Obstacle>> obstacles = makeObstacles(records, loaderPool.get());
+    const double parseTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    obstacleOwner.reserve(obstacleOwner.size() + obstacles.size());
+    for (auto& obstacle : obstacles) {
+        addOwned(std::move(obstacle));
+    }
+    const double addTime = secondsSince(start);
+
+    // the lookup is built on first use (see rebuildBBoxLookup), so obstacles added right after (e.g., from SUMO) are not inserted one by one
+    EV_INFO << "Loaded " << records.size() << " obstacles (" << (loaderPool ? loaderPool->getNumThreads() : 0) << " worker threads): reading " << readTime << " s, parsing shapes " << parseTime << " s, adding " << addTime << " s" << endl;
+}
+
+void ObstacleControl::readXml(cXMLElement* xml, std::vector<ObstacleRecord>& records)
 {
     std::string rootTag = xml->getTagName();
     if (rootTag != "obstacles") {
@@ -128,17 +252,7 @@ void ObstacleControl::addFromXml(cXMLElement* xml)
             ASSERT(e->getAttribute("shape"));
             std::string shape = e->getAttribute("shape");
 
-            Obstacle obs(id, type, getAttenuationPerCut(type), getAttenuationPerMeter(type));
-            std::vector<Coord> sh;
-            cStringTokenizer st(shape.c_str());
-            while (st.hasMoreTokens()) {
-                std::string xy = st.nextToken();
-                std::vector<double> xya = cStringTokenizer(xy.c_str(), ",").asDoubleVector();
-                ASSERT(xya.size() == 2);
-                sh.push_back(Coord(xya[0], xya[1]));
-            }
-            obs.setShape(sh);
-            add(obs);
+            records.push_back({id, type, getAttenuationPerCut(type), getAttenuationPerMeter(type), shape});
         }
         else {
             throw cRuntimeError("Found unknown tag in obstacle definition: \"%s\"", tag.c_str());
@@ -146,8 +260,237 @@ void ObstacleControl::addFromXml(cXMLElement* xml)
     }
 }
 
+veins::Obstacle ObstacleControl::makeObstacle(const ObstacleRecord& record)
+{
+    Obstacle obs(record.id, record.type, record.attenuationPerCut, record.attenuationPerMeter);
+    std::vector<Coord> sh;
+    cStringTokenizer st(record.shape.c_str());
+    while (st.hasMoreTokens()) {
+        std::string xy = st.nextToken();
+        std::vector<double> xya = cStringTokenizer(xy.c_str(), ",").asDoubleVector();
+        ASSERT(xya.size() == 2);
+        sh.push_back(Coord(xya[0], xya[1]));
+    }
+    obs.setShape(sh);
+    return obs;
+}
+
+std::vector<std::unique_ptr<veins::Obstacle>> ObstacleControl::makeObstacles(const std::vector<ObstacleRecord>& records, WorkerPool* pool)
+{
+    std::vector<std::unique_ptr<Obstacle>> obstacles(records.size());
+    auto makeRange = [&records, &obstacles](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            obstacles[i].reset(new Obstacle(makeObstacle(records[i])));
+        }
+    };
+    if (!pool || pool->getNumThreads() == 0 || records.size() < 2) {
+        makeRange(0, records.size());
+        return obstacles;
+    }
+
+    // several ranges per thread, as shapes differ in size
+    const size_t numRanges = std::min(records.size(), 4 * (pool->getNumThreads() + 1));
+    pool->run(numRanges, [&](size_t range) {
+        makeRange(records.size() * range / numRanges, records.size() * (range + 1) / numRanges);
+    });
+    return obstacles;
+}
+
+void ObstacleControl::startBackgroundLoad(std::vector<ObstacleRecord> records)
+{
+    ASSERT(!backgroundLoad.valid());
+
+    // everything the task needs from the simulation is fetched here, on the simulation thread
+    const Coord playgroundSize = *FindModule<BaseWorldUtility*>::findGlobalModule()->getPgs();
+    const int cellSize = gridCellSize;
+    WorkerPool* pool = loaderPool.get();
+    backgroundLoad = std::async(std::launch::async, [records = std::move(records), playgroundSize, cellSize, pool]() {
+        BackgroundLoad loaded;
+        auto start = std::chrono::steady_clock::now();
+        loaded.obstacles = makeObstacles(records, pool);
+        loaded.parseTime = secondsSince(start);
+        start = std::chrono::steady_clock::now();
+        loaded.bboxLookup = BBoxLookup(getObstaclePointers(loaded.obstacles), getBBox, playgroundSize.x, playgroundSize.y, cellSize, pool);
+        loaded.lookupTime = secondsSince(start);
+        return loaded;
+    });
+}
+
+void ObstacleControl::completeBackgroundLoad()
+{
+    // rethrows errors of the task
+    BackgroundLoad loaded = backgroundLoad.get();
+
+    // nothing else could be added while loading, so the lookup covers all obstacles
+    ASSERT(obstacleOwner.empty());
+    obstacleOwner = std::move(loaded.obstacles);
+    for (auto& obstacle : obstacleOwner) {
+        if (annotations) obstacle->visualRepresentation = annotations->drawPolygon(obstacle->getShape(), "red", annotationGroup);
+    }
+    bboxLookup = std::move(loaded.bboxLookup);
+    isBboxLookupDirty = false;
+    cacheEntries.clear();
+    geometryVersion++;
+    EV_INFO << "Loaded " << obstacleOwner.size() << " obstacles in the background (" << (loaderPool ? loaderPool->getNumThreads() : 0) << " worker threads): parsing shapes " << loaded.parseTime << " s, building lookup " << loaded.lookupTime << " s" << endl;
+
+    preprocessObstacles();
+}
+
+void ObstacleControl::addFromDatabase(const std::string& fileName)
+{
+    awaitBackgroundLoad();
+    ObstacleDatabase database(fileName);
+
+    std::vector<std::string> typeNames;
+    for (size_t i = 0; i < database.getNumTypes(); ++i) {
+        typeNames.push_back(database.getTypeName(i));
+        perCut[typeNames.back()] = database.getType(i).attenuationPerCut;
+        perMeter[typeNames.back()] = database.getType(i).attenuationPerMeter;
+    }
+
+    const size_t firstObstacle = obstacleOwner.size();
+    obstacleOwner.reserve(firstObstacle + database.getNumObstacles());
+    for (size_t i = 0; i < database.getNumObstacles(); ++i) {
+        const ObstacleDatabase::ObstacleRecord& record = database.getObstacle(i);
+        const std::string& type = typeNames[record.type];
+        Obstacle obs(database.getObstacleId(i), type, perCut[type], perMeter[type]);
+        obs.setShape(database.getObstacleShape(i), Coord(record.bboxX1, record.bboxY1), Coord(record.bboxX2, record.bboxY2));
+        add(std::move(obs));
+    }
+
+    // the stored cell table is only valid if it covers exactly these obstacles, on the same grid
+    const Coord& playgroundSize = *FindModule<BaseWorldUtility*>::findGlobalModule()->getPgs();
+    if (firstObstacle == 0 && database.hasCellTable(gridCellSize, playgroundSize)) {
+        bboxLookup = BBoxLookup(getObstaclePointers(obstacleOwner), getBBox, database.getCellTable());
+        isBboxLookupDirty = false;
+    }
+    EV_DEBUG << "Loaded " << database.getNumObstacles() << " obstacles from " << fileName << (isBboxLookupDirty ? "" : " (including lookup table)") << endl;
+}
+
+void ObstacleControl::writeDatabase(const std::string& fileName) const
+{
+    awaitBackgroundLoad();
+    // always rebuild, as the cell table must refer to obstacles by their position in obstacleOwner
+    bboxLookup = rebuildBBoxLookup(obstacleOwner, gridCellSize, loaderPool.get());
+    isBboxLookupDirty = false;
+    std::vector<const Obstacle*> obstacles(obstacleOwner.size());
+    std::transform(obstacleOwner.begin(), obstacleOwner.end(), obstacles.begin(), [](const std::unique_ptr<Obstacle>& obstacle) { return obstacle.get(); });
+    const BBoxLookup::CellTable table = bboxLookup.getCellTable();
+    ObstacleDatabase::write(fileName, perCut, perMeter, obstacles, &table, *FindModule<BaseWorldUtility*>::findGlobalModule()->getPgs());
+    EV_DEBUG << "Wrote " << obstacles.size() << " obstacles to " << fileName << endl;
+}
+
+void ObstacleControl::preprocessObstacles()
+{
+    awaitBackgroundLoad();
+    if (obstacleOwner.empty() || (simplificationTolerance <= 0 && !mergeTouchingObstacles)) return;
+
+    // sample links of typical range to compare shadowing before and after (with a fixed seed, so simulation RNGs are not affected)
+    const Coord& playgroundSize = *FindModule<BaseWorldUtility*>::findGlobalModule()->getPgs();
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> posX(0, playgroundSize.x);
+    std::uniform_real_distribution<double> posY(0, playgroundSize.y);
+    std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+    std::uniform_real_distribution<double> distance(0, 500);
+    std::vector<std::pair<Coord, Coord>> links;
+    for (size_t i = 0; i < 1000; ++i) {
+        const Coord sender(posX(rng), posY(rng));
+        const double a = angle(rng);
+        const double d = distance(rng);
+        const Coord receiver(std::min(std::max(sender.x + d * cos(a), 0.0), playgroundSize.x), std::min(std::max(sender.y + d * sin(a), 0.0), playgroundSize.y));
+        links.emplace_back(sender, receiver);
+    }
+    auto attenuation_dB = [this](const std::pair<Coord, Coord>& link) {
+        const double factor = calculateAttenuation(link.first, link.second);
+        return (factor > 1e-30) ? -10 * log10(factor) : 300.0;
+    };
+    std::vector<double> attenuationBefore_dB;
+    std::transform(links.begin(), links.end(), std::back_inserter(attenuationBefore_dB), attenuation_dB);
+    auto countEdges = [this]() {
+        size_t edges = 0;
+        for (auto& obstacle : obstacleOwner) edges += obstacle->getShape().size();
+        return edges;
+    };
+    const size_t edgesBefore = countEdges();
+    const size_t obstaclesBefore = obstacleOwner.size();
+
+    std::vector<Obstacle::Coords> shapes;
+    std::vector<bool> merged(obstacleOwner.size(), false);
+    for (auto& obstacle : obstacleOwner) shapes.push_back(obstacle->getShape());
+
+    if (mergeTouchingObstacles) {
+        // find neighbors via their common edges, then merge until no obstacle has a neighbor of the same type
+        using Edge = std::pair<std::pair<double, double>, std::pair<double, double>>;
+        std::map<Edge, std::vector<size_t>> edgeOwners;
+        auto addEdges = [&edgeOwners, &shapes](size_t i) {
+            const Obstacle::Coords& shape = shapes[i];
+            for (size_t k = 0, l = shape.size() - 1; k < shape.size(); l = k++) {
+                auto p1 = std::make_pair(shape[k].x, shape[k].y);
+                auto p2 = std::make_pair(shape[l].x, shape[l].y);
+                edgeOwners[std::make_pair(std::min(p1, p2), std::max(p1, p2))].push_back(i);
+            }
+        };
+        std::vector<size_t> pending;
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            if (shapes[i].size() < 3) continue;
+            addEdges(i);
+            pending.push_back(i);
+        }
+        while (!pending.empty()) {
+            const size_t i = pending.back();
+            pending.pop_back();
+            if (merged[i]) continue;
+            std::set<size_t> neighbors;
+            const Obstacle::Coords& shape = shapes[i];
+            for (size_t k = 0, l = shape.size() - 1; k < shape.size(); l = k++) {
+                auto p1 = std::make_pair(shape[k].x, shape[k].y);
+                auto p2 = std::make_pair(shape[l].x, shape[l].y);
+                for (size_t j : edgeOwners[std::make_pair(std::min(p1, p2), std::max(p1, p2))]) {
+                    if (j != i && !merged[j] && obstacleOwner[j]->getType() == obstacleOwner[i]->getType()) neighbors.insert(j);
+                }
+            }
+            for (size_t j : neighbors) {
+                Obstacle::Coords mergedShape;
+                if (!mergeShapes(shapes[i], shapes[j], mergedShape)) continue;
+                shapes[i] = std::move(mergedShape);
+                merged[j] = true;
+                addEdges(i);
+                pending.push_back(i);
+                break;
+            }
+        }
+    }
+
+    // replace obstacles by their preprocessed versions (merged obstacles keep the id of one of their parts)
+    std::vector<std::unique_ptr<Obstacle>> processed;
+    for (size_t i = 0; i < obstacleOwner.size(); ++i) {
+        Obstacle* o = obstacleOwner[i].get();
+        if (annotations && o->visualRepresentation) annotations->erase(o->visualRepresentation);
+        if (merged[i]) continue;
+        Obstacle::Coords shape = (simplificationTolerance > 0) ? simplifyShape(shapes[i], simplificationTolerance) : shapes[i];
+        processed.emplace_back(new Obstacle(o->getId(), o->getType(), o->getAttenuationPerCut(), o->getAttenuationPerMeter()));
+        processed.back()->setShape(std::move(shape));
+        if (annotations) processed.back()->visualRepresentation = annotations->drawPolygon(processed.back()->getShape(), "red", annotationGroup);
+    }
+    obstacleOwner = std::move(processed);
+    cacheEntries.clear();
+    isBboxLookupDirty = true;
+    geometryVersion++;
+
+    double maxError_dB = 0;
+    for (size_t i = 0; i < links.size(); ++i) {
+        maxError_dB = std::max(maxError_dB, std::abs(attenuation_dB(links[i]) - attenuationBefore_dB[i]));
+    }
+    cacheEntries.clear();
+    EV_INFO << "Preprocessing obstacles reduced them from " << obstaclesBefore << " to " << obstacleOwner.size() << ", with " << edgesBefore << " to " << countEdges() << " edges, changing shadowing of sample links by up to " << maxError_dB << " dB" << endl;
+    if (maxError_dB > maxSimplificationError) {
+        throw cRuntimeError("Simplifying obstacles changed shadowing by up to %f dB, but maxSimplificationError is %f dB. Lower simplificationTolerance or disable mergeTouchingObstacles", maxError_dB, maxSimplificationError);
+    }
+}
+
 void ObstacleControl::addFromTypeAndShape(std::string id, std::string typeId, std::vector<Coord> shape)
 {
+    awaitBackgroundLoad();
     if (!isTypeSupported(typeId)) {
         throw cRuntimeError("Unsupported obstacle type: \"%s\"", typeId.c_str());
     }
@@ -158,47 +501,69 @@ void ObstacleControl::addFromTypeAndShape(std::string id, std::string typeId, st
 
 void ObstacleControl::add(Obstacle obstacle)
 {
-    Obstacle* o = new Obstacle(obstacle);
-    obstacleOwner.emplace_back(o);
+    awaitBackgroundLoad();
+    addOwned(std::unique_ptr<Obstacle>(new Obstacle(std::move(obstacle))));
+}
+
+void ObstacleControl::addOwned(std::unique_ptr<Obstacle> obstacle)
+{
+    Obstacle* o = obstacle.get();
+    obstacleOwner.push_back(std::move(obstacle));
 
     // visualize using AnnotationManager
     if (annotations) o->visualRepresentation = annotations->drawPolygon(o->getShape(), "red", annotationGroup);
 
-    cacheEntries.clear();
-    isBboxLookupDirty = true;
+    // update an already built lookup in place, so obstacles added at runtime do not trigger a rebuild
+    if (!isBboxLookupDirty) {
+        bboxLookup.insert(o, getBBox(o));
+        if (bboxLookup.needsCompaction()) bboxLookup.compact();
+    }
+    invalidateCachedAttenuation(*o);
 }
 
 void ObstacleControl::erase(const Obstacle* obstacle)
 {
+    awaitBackgroundLoad();
     if (annotations && obstacle->visualRepresentation) annotations->erase(obstacle->visualRepresentation);
+    invalidateCachedAttenuation(*obstacle);
     for (auto itOwner = obstacleOwner.begin(); itOwner != obstacleOwner.end(); ++itOwner) {
         // find owning pointer and remove it to deallocate obstacle
         if (itOwner->get() == obstacle) {
+            if (!isBboxLookupDirty) {
+                bboxLookup.remove(itOwner->get());
+                if (bboxLookup.needsCompaction()) bboxLookup.compact();
+            }
             obstacleOwner.erase(itOwner);
             break;
         }
     }
+}
 
-    cacheEntries.clear();
-    isBboxLookupDirty = true;
+void ObstacleControl::invalidateCachedAttenuation(const Obstacle& obstacle)
+{
+    // links whose (quantized) positions are farther than the quantization from the obstacle's bounding box were not affected by it
+    const BBoxLookup::Box bbox{{obstacle.getBboxP1().x - cachePositionQuantization, obstacle.getBboxP1().y - cachePositionQuantization}, {obstacle.getBboxP2().x + cachePositionQuantization, obstacle.getBboxP2().y + cachePositionQuantization}};
+    cacheEntries.eraseIf([&bbox](const CacheKey& key, double) { return BBoxLookup::segmentTouchesBox({key.x1, key.y1}, {key.x2, key.y2}, bbox); });
+    geometryVersion++;
+    // visibility maps cover all links of a static node, so they are recomputed as a whole
+    for (auto& entry : visibilityMaps) entry.second.attenuation_dB.clear();
 }
 
 std::vector<std::pair<veins::Obstacle*, std::vector<double>>> ObstacleControl::getIntersections(const Coord& senderPos, const Coord& receiverPos) const
 {
+    awaitBackgroundLoad();
+
     std::vector<std::pair<Obstacle*, std::vector<double>>> allIntersections;
 
     // rebuild bounding box lookup structure if dirty (new obstacles added recently)
     if (isBboxLookupDirty) {
-        bboxLookup = rebuildBBoxLookup(obstacleOwner);
+        bboxLookup = rebuildBBoxLookup(obstacleOwner, gridCellSize, loaderPool.get());
         isBboxLookupDirty = false;
     }
 
+    // candidates are free of duplicates
     auto candidateObstacles = bboxLookup.findOverlapping({senderPos.x, senderPos.y}, {receiverPos.x, receiverPos.y});
 
-    // remove duplicates
-    sort(candidateObstacles.begin(), candidateObstacles.end());
-    candidateObstacles.erase(unique(candidateObstacles.begin(), candidateObstacles.end()), candidateObstacles.end());
-
     for (Obstacle* o : candidateObstacles) {
         // if obstacles has neither borders nor matter: bail.
         if (o->getShape().size() < 2) continue;
@@ -210,67 +575,305 @@ std::vector<std::pair<veins::Obstacle*, std::vector<double>>> ObstacleControl::g
     return allIntersections;
 }
 
-double ObstacleControl::calculateAttenuation(const Coord& senderPos, const Coord& receiverPos) const
+void ObstacleControl::checkObstaclesConfigured() const
 {
-    Enter_Method_Silent();
-
     if ((perCut.size() == 0) || (perMeter.size() == 0)) {
         throw cRuntimeError("Unable to use SimpleObstacleShadowing: No obstacle types have been configured");
     }
     if (obstacleOwner.size() == 0) {
         throw cRuntimeError("Unable to use SimpleObstacleShadowing: No obstacles have been added");
     }
+}
+
+double ObstacleControl::calculateAttenuation(const Coord& senderPos, const Coord& receiverPos) const
+{
+    Enter_Method_Silent();
+
+    awaitBackgroundLoad();
+
+    checkObstaclesConfigured();
+
+    // interpolate from visibility map, if one end of the link is a static node
+    if (!visibilityMaps.empty() && !isBuildingVisibilityMap) {
+        if (const VisibilityMap* map = getVisibilityMap(senderPos)) {
+            visibilityMapLookups++;
+            return interpolateVisibilityMap(*map, receiverPos);
+        }
+        if (const VisibilityMap* map = getVisibilityMap(receiverPos)) {
+            visibilityMapLookups++;
+            return interpolateVisibilityMap(*map, senderPos);
+        }
+    }
+
+    // return cached result, if available (not while rasterizing, as those links are unlikely to recur)
+    const CacheKey cacheKey = makeCacheKey(senderPos, receiverPos);
+    if (!isBuildingVisibilityMap) {
+        if (const double* cachedFactor = cacheEntries.find(cacheKey)) {
+            return *cachedFactor;
+        }
+    }
+
+    // rebuild bounding box lookup structure if dirty (new obstacles added recently)
+    if (isBboxLookupDirty) {
+        bboxLookup = rebuildBBoxLookup(obstacleOwner, gridCellSize, loaderPool.get());
+        isBboxLookupDirty = false;
+    }
+
+    const double factor = computeAttenuation(senderPos, receiverPos, candidateBuffer, intersectionBuffer, nullptr);
+
+    // cache result
+    if (!isBuildingVisibilityMap) cacheEntries.insert(cacheKey, factor);
+
+    return factor;
+}
+
+double ObstacleControl::queryAttenuation(const Coord& senderPos, const Coord& receiverPos, QueryScratch& scratch) const
+{
+    checkObstaclesConfigured();
+    if (!isGeometryCommitted()) {
+        throw cRuntimeError("Obstacles were added or erased since the last ObstacleControl::commitGeometry(), so they cannot be queried concurrently");
+    }
+
+    // visibility maps are all computed by commitGeometry()
+    if (!visibilityMaps.empty()) {
+        if (const VisibilityMap* map = findVisibilityMap(senderPos)) {
+            scratch.visibilityMapLookups++;
+            return interpolateVisibilityMap(*map, receiverPos);
+        }
+        if (const VisibilityMap* map = findVisibilityMap(receiverPos)) {
+            scratch.visibilityMapLookups++;
+            return interpolateVisibilityMap(*map, senderPos);
+        }
+    }
+
+    // the private cache is only valid for the geometry it was filled with (scratches may outlive this module and be passed to others)
+    if (scratch.cacheGeometryId != committedGeometryId) {
+        scratch.cache.clear();
+        scratch.cacheGeometryId = committedGeometryId;
+    }
+    const CacheKey cacheKey = makeCacheKey(senderPos, receiverPos);
+    if (const double* cachedFactor = scratch.cache.find(cacheKey)) {
+        return *cachedFactor;
+    }
+
+    const double factor = computeAttenuation(senderPos, receiverPos, scratch.candidates, scratch.intersections, &scratch.lookupState);
+    scratch.cache.insert(cacheKey, factor);
+    return factor;
+}
+
+void ObstacleControl::commitGeometry()
+{
+    Enter_Method_Silent();
+
+    awaitBackgroundLoad();
 
-    // return cached result, if available
-    CacheKey cacheKey(senderPos, receiverPos);
-    CacheEntries::const_iterator cacheEntryIter = cacheEntries.find(cacheKey);
-    if (cacheEntryIter != cacheEntries.end()) {
-        return cacheEntryIter->second;
+    if (isBboxLookupDirty) {
+        bboxLookup = rebuildBBoxLookup(obstacleOwner, gridCellSize, loaderPool.get());
+        isBboxLookupDirty = false;
+    }
+    if (!obstacleOwner.empty()) {
+        for (auto& entry : visibilityMaps) {
+            if (entry.second.attenuation_dB.empty()) buildVisibilityMap(entry.second.nodePos, entry.second);
+        }
     }
+    committedGeometryVersion = geometryVersion;
 
-    // get intersections
-    auto intersections = getIntersections(senderPos, receiverPos);
+    // a new module (of a new run, possibly at the address of a deleted one) never starts from the same id
+    static std::atomic<uint64_t> nextGeometryId(1);
+    committedGeometryId = nextGeometryId++;
+}
 
+double ObstacleControl::computeAttenuation(const Coord& senderPos, const Coord& receiverPos, std::vector<Obstacle*>& candidates, std::vector<double>& intersections, BBoxLookup::QueryState* lookupState) const
+{
+    const double totalDistance = senderPos.distance(receiverPos);
     double factor = 1;
-    for (auto i = intersections.begin(); i != intersections.end(); ++i) {
-        auto o = i->first;
-        auto intersectAt = i->second;
+    if (lookupState) {
+        bboxLookup.findOverlapping({senderPos.x, senderPos.y}, {receiverPos.x, receiverPos.y}, candidates, *lookupState);
+    }
+    else {
+        bboxLookup.findOverlapping({senderPos.x, senderPos.y}, {receiverPos.x, receiverPos.y}, candidates);
+    }
+    for (Obstacle* o : candidates) {
+        // if obstacles has neither borders nor matter: bail.
+        if (o->getShape().size() < 2) continue;
+
+        // get intersections, leaving room for the sender and receiver position in front and at the back
+        const size_t numEdges = o->getShape().size();
+        if (intersections.size() < numEdges + 2) intersections.resize(numEdges + 2);
+        double* intersectAt = intersections.data() + 1;
+        size_t numIntersections = o->getIntersections(senderPos, receiverPos, intersectAt);
 
         // if beam interacts with neither borders nor matter: bail.
         bool senderInside = o->containsPoint(senderPos);
         bool receiverInside = o->containsPoint(receiverPos);
-        if ((intersectAt.size() == 0) && !senderInside && !receiverInside) continue;
+        if ((numIntersections == 0) && !senderInside && !receiverInside) continue;
 
         // remember number of cuts before messing with intersection points
-        double numCuts = intersectAt.size();
+        double numCuts = numIntersections;
 
         // for distance calculation, make sure every other pair of points marks transition through matter and void, respectively.
-        if (senderInside) intersectAt.insert(intersectAt.begin(), 0);
-        if (receiverInside) intersectAt.push_back(1);
-        ASSERT((intersectAt.size() % 2) == 0);
+        if (senderInside) {
+            *(--intersectAt) = 0;
+            numIntersections++;
+        }
+        if (receiverInside) intersectAt[numIntersections++] = 1;
+        ASSERT((numIntersections % 2) == 0);
 
         // sum up distances in matter.
         double fractionInObstacle = 0;
-        for (auto i = intersectAt.begin(); i != intersectAt.end();) {
-            double p1 = *(i++);
-            double p2 = *(i++);
-            fractionInObstacle += (p2 - p1);
+        for (size_t i = 0; i < numIntersections; i += 2) {
+            fractionInObstacle += (intersectAt[i + 1] - intersectAt[i]);
         }
 
         // calculate attenuation
-        double totalDistance = senderPos.distance(receiverPos);
         double attenuation = (o->getAttenuationPerCut() * numCuts) + (o->getAttenuationPerMeter() * fractionInObstacle * totalDistance);
         factor *= pow(10.0, -attenuation / 10.0);
 
         // bail if attenuation is already extremely high
         if (factor < 1e-30) break;
     }
+    return factor;
+}
 
-    // cache result
-    if (cacheEntries.size() >= 1000) cacheEntries.clear();
-    cacheEntries[cacheKey] = factor;
+void ObstacleControl::addStaticNode(const Coord& pos)
+{
+    if (!usesVisibilityMaps()) return;
+    auto inserted = visibilityMaps.emplace(std::make_pair(pos.x, pos.y), VisibilityMap());
+    inserted.first->second.nodePos = pos;
+    // queries of links of this node are to use its map, which commitGeometry() has to compute first
+    if (inserted.second) geometryVersion++;
+}
 
-    return factor;
+const ObstacleControl::VisibilityMap* ObstacleControl::getVisibilityMap(const Coord& pos) const
+{
+    auto it = visibilityMaps.find(std::make_pair(pos.x, pos.y));
+    if (it == visibilityMaps.end()) return nullptr;
+    if (it->second.attenuation_dB.empty()) buildVisibilityMap(pos, it->second);
+    return &it->second;
+}
+
+const ObstacleControl::VisibilityMap* ObstacleControl::findVisibilityMap(const Coord& pos) const
+{
+    auto it = visibilityMaps.find(std::make_pair(pos.x, pos.y));
+    if (it == visibilityMaps.end() || it->second.attenuation_dB.empty()) return nullptr;
+    return &it->second;
+}
+
+void ObstacleControl::buildVisibilityMap(const Coord& pos, VisibilityMap& map) const
+{
+    const Coord& playgroundSize = *FindModule<BaseWorldUtility*>::findGlobalModule()->getPgs();
+    map.numCols = static_cast<size_t>(std::ceil(playgroundSize.x / visibilityMapResolution)) + 1;
+    map.numRows = static_cast<size_t>(std::ceil(playgroundSize.y / visibilityMapResolution)) + 1;
+    const size_t numPoints = map.numCols * map.numRows;
+
+    // try to load a map of the same obstacles, position and resolution from disk
+    std::string fileName;
+    if (!visibilityMapCacheDir.empty()) {
+        std::ostringstream name;
+        name << visibilityMapCacheDir << "/visibility-" << std::hex << getVisibilityMapSignature(pos) << ".bin";
+        fileName = name.str();
+        std::ifstream in(fileName, std::ios::binary);
+        uint64_t storedPoints = 0;
+        if (in && in.read(reinterpret_cast<char*>(&storedPoints), sizeof(storedPoints)) && storedPoints == numPoints) {
+            map.attenuation_dB.resize(numPoints);
+            if (in.read(reinterpret_cast<char*>(map.attenuation_dB.data()), numPoints * sizeof(float))) {
+                EV_DEBUG << "Loaded visibility map for " << pos.info() << " from " << fileName << endl;
+                return;
+            }
+            map.attenuation_dB.clear();
+        }
+    }
+
+    // rasterize attenuation, bypassing visibility maps and the link cache
+    EV_DEBUG << "Computing visibility map for " << pos.info() << " with " << numPoints << " points" << endl;
+    isBuildingVisibilityMap = true;
+    std::vector<float> attenuation_dB(numPoints);
+    for (size_t row = 0; row < map.numRows; ++row) {
+        for (size_t col = 0; col < map.numCols; ++col) {
+            const Coord point(col * visibilityMapResolution, row * visibilityMapResolution, pos.z);
+            const double factor = calculateAttenuation(pos, point);
+            attenuation_dB[col + row * map.numCols] = (factor > 1e-30) ? static_cast<float>(-10 * log10(factor)) : 300.0f;
+        }
+    }
+    isBuildingVisibilityMap = false;
+    map.attenuation_dB = std::move(attenuation_dB);
+
+    if (!fileName.empty()) {
+        std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+        const uint64_t storedPoints = numPoints;
+        out.write(reinterpret_cast<const char*>(&storedPoints), sizeof(storedPoints));
+        out.write(reinterpret_cast<const char*>(map.attenuation_dB.data()), numPoints * sizeof(float));
+        if (!out) EV_WARN << "Could not write visibility map to " << fileName << endl;
+    }
+}
+
+size_t ObstacleControl::getVisibilityMapSignature(const Coord& pos) const
+{
+    // FNV-1a over everything the map depends on
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](double value) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    const Coord& playgroundSize = *FindModule<BaseWorldUtility*>::findGlobalModule()->getPgs();
+    add(pos.x);
+    add(pos.y);
+    add(visibilityMapResolution);
+    add(playgroundSize.x);
+    add(playgroundSize.y);
+    for (auto& obstacle : obstacleOwner) {
+        add(obstacle->getAttenuationPerCut());
+        add(obstacle->getAttenuationPerMeter());
+        for (auto& corner : obstacle->getShape()) {
+            add(corner.x);
+            add(corner.y);
+        }
+    }
+    return static_cast<size_t>(hash);
+}
+
+double ObstacleControl::interpolateVisibilityMap(const VisibilityMap& map, const Coord& pos) const
+{
+    // bilinear interpolation (in dB) between the four grid points surrounding pos
+    const double x = std::min(std::max(pos.x / visibilityMapResolution, 0.0), static_cast<double>(map.numCols - 1));
+    const double y = std::min(std::max(pos.y / visibilityMapResolution, 0.0), static_cast<double>(map.numRows - 1));
+    const size_t col = std::min(static_cast<size_t>(x), map.numCols - 2);
+    const size_t row = std::min(static_cast<size_t>(y), map.numRows - 2);
+    const double fx = x - col;
+    const double fy = y - row;
+    const float* lower = &map.attenuation_dB[col + row * map.numCols];
+    const float* upper = lower + map.numCols;
+    const double attenuation_dB = (1 - fy) * ((1 - fx) * lower[0] + fx * lower[1]) + fy * ((1 - fx) * upper[0] + fx * upper[1]);
+    return pow(10.0, -attenuation_dB / 10.0);
+}
+
+ObstacleControl::CacheKey::CacheKey(const Coord& senderPos, const Coord& receiverPos)
+{
+    const bool inOrder = (senderPos.x < receiverPos.x) || (senderPos.x == receiverPos.x && senderPos.y <= receiverPos.y);
+    const Coord& p1 = inOrder ? senderPos : receiverPos;
+    const Coord& p2 = inOrder ? receiverPos : senderPos;
+    x1 = p1.x;
+    y1 = p1.y;
+    x2 = p2.x;
+    y2 = p2.y;
+}
+
+size_t ObstacleControl::CacheKeyHash::operator()(const CacheKey& k) const
+{
+    size_t seed = 0;
+    for (double v : {k.x1, k.y1, k.x2, k.y2}) {
+        seed ^= std::hash<double>()(v) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+ObstacleControl::CacheKey ObstacleControl::makeCacheKey(const Coord& senderPos, const Coord& receiverPos) const
+{
+    if (cachePositionQuantization <= 0) return CacheKey(senderPos, receiverPos);
+    auto quantize = [this](const Coord& pos) { return Coord(std::round(pos.x / cachePositionQuantization) * cachePositionQuantization, std::round(pos.y / cachePositionQuantization) * cachePositionQuantization); };
+    return CacheKey(quantize(senderPos), quantize(receiverPos));
 }
 
 double ObstacleControl::getAttenuationPerCut(std::string type)
@@ -22,14 +22,24 @@
 
 #pragma once
 
+#include <future>
+#include <map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "veins/veins.h"
 
 #include "veins/base/utils/Coord.h"
+#include "veins/base/utils/LinkGeometry.h"
 #include "veins/modules/obstacle/Obstacle.h"
 #include "veins/modules/world/annotations/AnnotationManager.h"
 #include "veins/modules/utility/BBoxLookup.h"
+#include "veins/modules/utility/LruCache.h"
+#include "veins/base/utils/ModuleRegistry.h"
+#include "veins/base/utils/MemoryAccounting.h"
+#include "veins/base/utils/WorkerPool.h"
 
 namespace veins {
 
@@ -53,6 +63,25 @@ public:
     void handleSelfMsg(cMessage* msg);
 
     void addFromXml(cXMLElement* xml);
+
+    /**
+     * add obstacle types and obstacles from a binary obstacle database (see ObstacleDatabase)
+     *
+     * If nothing was added before and the database holds a lookup table for the current grid, it is used instead of building one.
+     */
+    void addFromDatabase(const std::string& fileName);
+
+    /**
+     * write all obstacle types, obstacles and the lookup table to a binary obstacle database (see ObstacleDatabase)
+     */
+    void writeDatabase(const std::string& fileName) const;
+
+    /**
+     * merge touching obstacles of the same type and simplify obstacle shapes, as configured by simplificationTolerance and mergeTouchingObstacles
+     *
+     * Throws a cRuntimeError if this changes the attenuation of sample links by more than maxSimplificationError.
+     */
+    void preprocessObstacles();
     void addFromTypeAndShape(std::string id, std::string typeId, std::vector<Coord> shape);
     void add(Obstacle obstacle);
     void erase(const Obstacle* obstacle);
@@ -67,38 +96,223 @@ public:
 
     /**
      * calculate additional attenuation by obstacles, return multiplicative factor
+     *
+     * If one end of the link is a static node (see addStaticNode) and visibility maps are enabled, the attenuation is interpolated from the node's visibility map.
      */
     double calculateAttenuation(const Coord& senderPos, const Coord& receiverPos) const;
 
+    /**
+     * calculate additional attenuation by obstacles along link, return multiplicative factor
+     */
+    double calculateAttenuation(const LinkGeometry& link) const
+    {
+        return calculateAttenuation(link.senderPos, link.receiverPos);
+    }
+
+    /**
+     * caller-owned state of queryAttenuation(): scratch buffers, lookup state and a private attenuation cache (one per thread)
+     */
+    struct QueryScratch;
+
+    /**
+     * bring the lookup and the visibility maps of all static nodes up to date with the obstacles, so queryAttenuation() can be used until obstacles are added or erased again
+     */
+    void commitGeometry();
+
+    /**
+     * return whether the geometry was committed (see commitGeometry()) since obstacles were last added or erased
+     */
+    bool isGeometryCommitted() const
+    {
+        return !isBboxLookupDirty && committedGeometryVersion == geometryVersion;
+    }
+
+    /**
+     * calculate additional attenuation by obstacles like calculateAttenuation(), but without using or changing any state of this module (or its annotations)
+     *
+     * Safe to be called concurrently from several threads, as long as each passes a QueryScratch of its own and the geometry is committed (throws a cRuntimeError if not).
+     * Results are those of calculateAttenuation(); only QueryScratch::cache is used for caching, not the cache shared by calculateAttenuation().
+     */
+    double queryAttenuation(const Coord& senderPos, const Coord& receiverPos, QueryScratch& scratch) const;
+
+    /**
+     * return the capacity configured for attenuation caches (see cacheCapacity), e.g., to size the cache of a QueryScratch
+     */
+    size_t getCacheCapacity() const
+    {
+        return cacheEntries.getCapacity();
+    }
+
+    /**
+     * announce the (antenna) position of a node that never moves, e.g., an RSU
+     *
+     * If visibilityMapResolution is positive, a map of the attenuation from this position to every point of a grid covering the playground is created on first use
+     * (or loaded from visibilityMapCacheDir), so obstacle attenuation for all its links becomes a bilinear interpolation.
+     */
+    void addStaticNode(const Coord& pos);
+
+    /**
+     * return whether visibility maps for static nodes are enabled
+     */
+    bool usesVisibilityMaps() const
+    {
+        return visibilityMapResolution > 0;
+    }
+
 protected:
+    /**
+     * Key of the attenuation cache: the (2D) positions of both ends of a link.
+     *
+     * Attenuation does not depend on the direction of a link, so the two positions are stored in a fixed (lexicographic) order.
+     */
     struct CacheKey {
-        const Coord senderPos;
-        const Coord receiverPos;
+        double x1;
+        double y1;
+        double x2;
+        double y2;
 
-        CacheKey(const Coord& senderPos, const Coord& receiverPos)
-            : senderPos(senderPos)
-            , receiverPos(receiverPos)
-        {
-        }
+        CacheKey(const Coord& senderPos, const Coord& receiverPos);
 
-        bool operator<(const CacheKey& o) const
+        bool operator==(const CacheKey& o) const
         {
-            if (senderPos.x < o.senderPos.x) return true;
-            if (senderPos.x > o.senderPos.x) return false;
-            if (senderPos.y < o.senderPos.y) return true;
-            if (senderPos.y > o.senderPos.y) return false;
-            if (receiverPos.x < o.receiverPos.x) return true;
-            if (receiverPos.x > o.receiverPos.x) return false;
-            if (receiverPos.y < o.receiverPos.y) return true;
-            if (receiverPos.y > o.receiverPos.y) return false;
-            return false;
+            return x1 == o.x1 && y1 == o.y1 && x2 == o.x2 && y2 == o.y2;
         }
     };
 
-    typedef std::map<CacheKey, double> CacheEntries;
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& k) const;
+    };
+
+    typedef LruCache<CacheKey, double, CacheKeyHash> CacheEntries;
+
+    /**
+     * Obstacle attenuation (in dB) from a static node to the points of a regular grid covering the playground.
+     */
+    struct VisibilityMap {
+        Coord nodePos; /**< position of the static node, as announced by addStaticNode() */
+        size_t numCols = 0; /**< grid points in x direction */
+        size_t numRows = 0; /**< grid points in y direction */
+        std::vector<float> attenuation_dB; /**< attenuation to grid point (col * resolution, row * resolution) at index col + row * numCols; empty if not computed yet */
+    };
+
+    /**
+     * return the visibility map of the static node at pos (computing or loading it if necessary), or nullptr if pos is no static node
+     */
+    const VisibilityMap* getVisibilityMap(const Coord& pos) const;
+
+    /**
+     * fill the attenuation values of map for the static node at pos, from the disk cache if possible
+     */
+    void buildVisibilityMap(const Coord& pos, VisibilityMap& map) const;
+
+    /**
+     * return a hash of all obstacles and the map's parameters, used to identify matching files in visibilityMapCacheDir
+     */
+    size_t getVisibilityMapSignature(const Coord& pos) const;
+
+    /**
+     * return attenuation factor interpolated from map at pos
+     */
+    double interpolateVisibilityMap(const VisibilityMap& map, const Coord& pos) const;
+
+    /**
+     * return the visibility map of the static node at pos if it has been computed already, nullptr otherwise (never changes any state)
+     */
+    const VisibilityMap* findVisibilityMap(const Coord& pos) const;
+
+    /**
+     * compute the attenuation of the link from the obstacles in bboxLookup, which must be up to date
+     *
+     * @param candidates: scratch buffer for the obstacles whose bounding box the link touches
+     * @param intersections: scratch buffer for the intersection points of the obstacle currently evaluated
+     * @param lookupState: state of the bboxLookup query, nullptr to use the one of bboxLookup itself (not thread safe)
+     */
+    double computeAttenuation(const Coord& senderPos, const Coord& receiverPos, std::vector<Obstacle*>& candidates, std::vector<double>& intersections, BBoxLookup::QueryState* lookupState) const;
+
+    /**
+     * throw a cRuntimeError if there are no obstacle types or no obstacles to compute attenuation from
+     */
+    void checkObstaclesConfigured() const;
+
+    /**
+     * drop cached attenuation of all links that may cross obstacle, after it was added or erased
+     */
+    void invalidateCachedAttenuation(const Obstacle& obstacle);
+
+    /**
+     * return the cache key for a link, with positions quantized to cachePositionQuantization
+     */
+    CacheKey makeCacheKey(const Coord& senderPos, const Coord& receiverPos) const;
+
+    /**
+     * an obstacle as read from an obstacle definition, before its shape is parsed
+     */
+    struct ObstacleRecord {
+        std::string id;
+        std::string type;
+        double attenuationPerCut;
+        double attenuationPerMeter;
+        std::string shape; /**< vertices as in the XML attribute, e.g. "16,0 8,13.8564 -8,13.8564" */
+    };
+
+    /**
+     * obstacles loaded by the background task started when loadInBackground is set, along with their lookup
+     */
+    struct BackgroundLoad {
+        std::vector<std::unique_ptr<Obstacle>> obstacles;
+        BBoxLookup bboxLookup;
+        double parseTime = 0; /**< wall time (in s) spent creating the obstacles */
+        double lookupTime = 0; /**< wall time (in s) spent building their lookup */
+    };
+
+    /**
+     * add the obstacle types of an obstacle definition and append its obstacles to records (in order)
+     */
+    void readXml(cXMLElement* xml, std::vector<ObstacleRecord>& records);
+
+    /**
+     * create the obstacle described by record (touches no simulation state, so it can be called from any thread)
+     */
+    static Obstacle makeObstacle(const ObstacleRecord& record);
+
+    /**
+     * create the obstacles described by records, in order (split into ranges run in parallel if pool is set; touches no simulation state either)
+     */
+    static std::vector<std::unique_ptr<Obstacle>> makeObstacles(const std::vector<ObstacleRecord>& records, WorkerPool* pool);
+
+    /**
+     * take ownership of obstacle, as add() does
+     */
+    void addOwned(std::unique_ptr<Obstacle> obstacle);
+
+    /**
+     * start creating the obstacles of records and building their lookup in a background task
+     */
+    void startBackgroundLoad(std::vector<ObstacleRecord> records);
+
+    /**
+     * wait for the background task started by startBackgroundLoad() (if still outstanding) and take over its obstacles
+     *
+     * Called by all methods using the obstacles, so loading may overlap with the initialization of other modules until obstacles are first needed.
+     */
+    void awaitBackgroundLoad() const
+    {
+        if (backgroundLoad.valid()) const_cast<ObstacleControl*>(this)->completeBackgroundLoad();
+    }
+
+    /**
+     * take over the obstacles of the finished background task, then preprocess them (see preprocessObstacles())
+     */
+    void completeBackgroundLoad();
 
     cXMLElement* obstaclesXml; /**< obstacles to add at startup */
     int gridCellSize = 250; /**< size of square grid tiles for obstacle store */
+    double cachePositionQuantization = 0; /**< grid (in m) that positions are rounded to for cache lookups, 0 to disable */
+    double visibilityMapResolution = 0; /**< grid spacing (in m) of visibility maps of static nodes, 0 to disable */
+    std::string visibilityMapCacheDir; /**< directory to store visibility maps in, empty to only keep them in memory */
+    double simplificationTolerance = 0; /**< distance (in m) up to which vertices are removed from obstacle shapes at startup, 0 to disable */
+    bool mergeTouchingObstacles = false; /**< whether to merge obstacles of the same type that share walls at startup */
+    double maxSimplificationError = 1; /**< maximum change of attenuation (in dB) of sample links allowed by simplifying and merging */
 
     std::vector<std::unique_ptr<Obstacle>> obstacleOwner;
     AnnotationManager* annotations;
@@ -108,6 +322,39 @@ protected:
     mutable CacheEntries cacheEntries;
     mutable BBoxLookup bboxLookup;
     mutable bool isBboxLookupDirty = true;
+    mutable std::vector<double> intersectionBuffer; /**< intersection points of the obstacle currently evaluated by calculateAttenuation */
+    mutable std::vector<Obstacle*> candidateBuffer; /**< obstacles whose bounding box the link currently evaluated by calculateAttenuation touches */
+    mutable std::map<std::pair<double, double>, VisibilityMap> visibilityMaps; /**< visibility maps by 2D position of static nodes */
+    mutable bool isBuildingVisibilityMap = false; /**< set while rasterizing a visibility map, so attenuation is computed from the obstacles, bypassing the cache */
+    mutable size_t visibilityMapLookups = 0; /**< number of attenuations that were interpolated from visibility maps */
+    uint64_t geometryVersion = 0; /**< incremented whenever obstacles are added or erased */
+    uint64_t committedGeometryVersion = 0; /**< geometryVersion as of the last commitGeometry() */
+    uint64_t committedGeometryId = 0; /**< id of the geometry as of the last commitGeometry(), unique among all ObstacleControl modules of the process (unlike geometryVersion) */
+    std::shared_ptr<WorkerPool> loaderPool; /**< worker threads for creating obstacles and building their lookup (nullptr: do so on a single thread) */
+    std::future<BackgroundLoad> backgroundLoad; /**< obstacles still being loaded in the background, see awaitBackgroundLoad() (declared after loaderPool, which it may use, so it is waited for first on destruction) */
+
+private:
+    /**
+     * estimate the memory held by the obstacles, the lookup and the caches, see MemoryAccounting
+     */
+    MemoryAccounting::Usage getMemoryUsage() const;
+
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
+    MemoryAccounting::Registration memoryRegistration; /**< reports getMemoryUsage() as subsystem "obstacleControl" */
+};
+
+struct ObstacleControl::QueryScratch {
+    explicit QueryScratch(size_t cacheCapacity = 0)
+        : cache(cacheCapacity)
+    {
+    }
+
+    std::vector<Obstacle*> candidates; /**< obstacles whose bounding box the link touches */
+    std::vector<double> intersections; /**< intersection points of the obstacle currently evaluated */
+    BBoxLookup::QueryState lookupState; /**< see BBoxLookup::findOverlapping() */
+    CacheEntries cache; /**< attenuation of links queried before (capacity 0: none), valid for the geometry with cacheGeometryId only */
+    uint64_t cacheGeometryId = 0; /**< ObstacleControl::committedGeometryId the cache was filled for (0: none) */
+    size_t visibilityMapLookups = 0; /**< number of attenuations that were interpolated from visibility maps */
 };
 
 class VEINS_API ObstacleControlAccess {
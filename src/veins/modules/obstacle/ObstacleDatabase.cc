@@ -0,0 +1,270 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32) || defined(__CYGWIN__) || defined(_WIN64)
+#define VEINS_OBSTACLEDATABASE_WINDOWS
+#define VEINS_OBSTACLEDATABASE_NO_MMAP
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "veins/modules/obstacle/ObstacleDatabase.h"
+
+using veins::ObstacleDatabase;
+
+namespace {
+
+const char magic[8] = {'V', 'E', 'I', 'N', 'S', 'O', 'B', 'S'};
+
+template <typename T>
+void writeArray(std::ofstream& out, const std::vector<T>& records)
+{
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+}
+
+/**
+ * name of the file to write fileName to before moving it into place, unique per process (as concurrent runs may share a database)
+ */
+std::string temporaryFileName(const std::string& fileName)
+{
+#ifdef VEINS_OBSTACLEDATABASE_WINDOWS
+    return fileName + ".tmp" + std::to_string(_getpid());
+#else
+    return fileName + ".tmp" + std::to_string(getpid());
+#endif
+}
+
+} // namespace
+
+constexpr uint32_t ObstacleDatabase::version;
+
+ObstacleDatabase::ObstacleDatabase(const std::string& fileName)
+{
+    const char* data = nullptr;
+#ifdef VEINS_OBSTACLEDATABASE_NO_MMAP
+    std::ifstream in(fileName, std::ios::binary | std::ios::ate);
+    if (!in) throw cRuntimeError("Could not open obstacle database \"%s\"", fileName.c_str());
+    buffer.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(buffer.data(), buffer.size())) throw cRuntimeError("Could not read obstacle database \"%s\"", fileName.c_str());
+    mappingSize = buffer.size();
+    data = buffer.data();
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) throw cRuntimeError("Could not open obstacle database \"%s\": %s", fileName.c_str(), strerror(errno));
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        throw cRuntimeError("Could not stat obstacle database \"%s\": %s", fileName.c_str(), strerror(errno));
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    if (mappingSize > 0) {
+        mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw cRuntimeError("Could not map obstacle database \"%s\": %s", fileName.c_str(), strerror(errno));
+    }
+    data = static_cast<const char*>(mapping);
+#endif
+
+    // locate and check all arrays
+    if (mappingSize < sizeof(Header)) throw cRuntimeError("Obstacle database \"%s\" is truncated", fileName.c_str());
+    header = reinterpret_cast<const Header*>(data);
+    if (memcmp(header->magic, magic, sizeof(magic)) != 0) throw cRuntimeError("\"%s\" is not an obstacle database", fileName.c_str());
+    if (header->version != version) throw cRuntimeError("Obstacle database \"%s\" has version %u, but expected %u", fileName.c_str(), header->version, version);
+    size_t offset = sizeof(Header);
+    auto locate = [&](uint64_t count, size_t recordSize) {
+        const char* start = data + offset;
+        if (count > (mappingSize - offset) / recordSize) throw cRuntimeError("Obstacle database \"%s\" is truncated", fileName.c_str());
+        offset += count * recordSize;
+        return start;
+    };
+    types = reinterpret_cast<const TypeRecord*>(locate(header->numTypes, sizeof(TypeRecord)));
+    obstacles = reinterpret_cast<const ObstacleRecord*>(locate(header->numObstacles, sizeof(ObstacleRecord)));
+    vertices = reinterpret_cast<const VertexRecord*>(locate(header->numVertices, sizeof(VertexRecord)));
+    cells = reinterpret_cast<const CellRecord*>(locate(header->numCells, sizeof(CellRecord)));
+    cellEntries = reinterpret_cast<const uint64_t*>(locate(header->numCellEntries, sizeof(uint64_t)));
+    strings = locate(header->stringBytes, 1);
+    if (header->numCells != 0 && header->numCells != header->numCols * header->numRows) throw cRuntimeError("Obstacle database \"%s\" has an inconsistent cell table", fileName.c_str());
+    for (size_t i = 0; i < header->numObstacles; ++i) {
+        const ObstacleRecord& o = obstacles[i];
+        if (o.type >= header->numTypes || o.firstVertex + o.numVertices > header->numVertices || o.idOffset + o.idLength > header->stringBytes) {
+            throw cRuntimeError("Obstacle database \"%s\" has an invalid record for obstacle %zu", fileName.c_str(), i);
+        }
+    }
+    for (size_t i = 0; i < header->numTypes; ++i) {
+        if (types[i].nameOffset + types[i].nameLength > header->stringBytes) throw cRuntimeError("Obstacle database \"%s\" has an invalid record for type %zu", fileName.c_str(), i);
+    }
+    for (size_t i = 0; i < header->numCells; ++i) {
+        if (cells[i].index + cells[i].count > header->numCellEntries) throw cRuntimeError("Obstacle database \"%s\" has an invalid cell table", fileName.c_str());
+    }
+    for (size_t i = 0; i < header->numCellEntries; ++i) {
+        if (cellEntries[i] >= header->numObstacles) throw cRuntimeError("Obstacle database \"%s\" has an invalid cell entry", fileName.c_str());
+    }
+}
+
+ObstacleDatabase::~ObstacleDatabase()
+{
+#ifndef VEINS_OBSTACLEDATABASE_NO_MMAP
+    if (mapping) munmap(mapping, mappingSize);
+#endif
+}
+
+void ObstacleDatabase::write(const std::string& fileName, const std::map<std::string, double>& perCut, const std::map<std::string, double>& perMeter, const std::vector<const Obstacle*>& obstacles, const BBoxLookup::CellTable* table, const Coord& playgroundSize)
+{
+    std::string stringTable;
+    auto addString = [&stringTable](const std::string& s, uint64_t& offset, uint64_t& length) {
+        offset = stringTable.size();
+        length = s.size();
+        stringTable += s;
+    };
+
+    std::vector<TypeRecord> typeRecords;
+    std::map<std::string, uint32_t> typeIndex;
+    for (const auto& type : perCut) {
+        auto perMeterIt = perMeter.find(type.first);
+        if (perMeterIt == perMeter.end()) continue;
+        TypeRecord record;
+        record.attenuationPerCut = type.second;
+        record.attenuationPerMeter = perMeterIt->second;
+        addString(type.first, record.nameOffset, record.nameLength);
+        typeIndex[type.first] = static_cast<uint32_t>(typeRecords.size());
+        typeRecords.push_back(record);
+    }
+
+    std::vector<ObstacleRecord> obstacleRecords;
+    std::vector<VertexRecord> vertexRecords;
+    obstacleRecords.reserve(obstacles.size());
+    for (const Obstacle* obstacle : obstacles) {
+        auto type = typeIndex.find(obstacle->getType());
+        if (type == typeIndex.end()) throw cRuntimeError("Obstacle type %s unknown", obstacle->getType().c_str());
+        ObstacleRecord record;
+        record.bboxX1 = obstacle->getBboxP1().x;
+        record.bboxY1 = obstacle->getBboxP1().y;
+        record.bboxX2 = obstacle->getBboxP2().x;
+        record.bboxY2 = obstacle->getBboxP2().y;
+        record.firstVertex = vertexRecords.size();
+        record.numVertices = static_cast<uint32_t>(obstacle->getShape().size());
+        record.type = type->second;
+        addString(obstacle->getId(), record.idOffset, record.idLength);
+        for (const Coord& corner : obstacle->getShape()) vertexRecords.push_back({corner.x, corner.y});
+        obstacleRecords.push_back(record);
+    }
+
+    std::vector<CellRecord> cellRecords;
+    std::vector<uint64_t> entryRecords;
+    if (table) {
+        for (const auto& cell : table->cells) cellRecords.push_back({cell.index, cell.count});
+        entryRecords.assign(table->entries.begin(), table->entries.end());
+    }
+    // keep the string table a multiple of 8 bytes, like all other arrays
+    stringTable.resize((stringTable.size() + 7) / 8 * 8, '\0');
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.numTypes = static_cast<uint32_t>(typeRecords.size());
+    header.numObstacles = obstacleRecords.size();
+    header.numVertices = vertexRecords.size();
+    header.numCells = cellRecords.size();
+    header.numCellEntries = entryRecords.size();
+    header.stringBytes = stringTable.size();
+    header.cellSize = table ? table->cellSize : 0;
+    header.numCols = table ? table->numCols : 0;
+    header.numRows = table ? table->numRows : 0;
+    header.playgroundX = playgroundSize.x;
+    header.playgroundY = playgroundSize.y;
+
+    // write to a temporary file first, so that runs mapping the database never see a partially written one
+    const std::string tmpFileName = temporaryFileName(fileName);
+    {
+        std::ofstream out(tmpFileName, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeArray(out, typeRecords);
+        writeArray(out, obstacleRecords);
+        writeArray(out, vertexRecords);
+        writeArray(out, cellRecords);
+        writeArray(out, entryRecords);
+        out.write(stringTable.data(), stringTable.size());
+        out.close();
+        if (!out) {
+            std::remove(tmpFileName.c_str());
+            throw cRuntimeError("Could not write obstacle database \"%s\"", tmpFileName.c_str());
+        }
+    }
+#ifdef VEINS_OBSTACLEDATABASE_WINDOWS
+    // rename() does not replace existing files here
+    std::remove(fileName.c_str());
+#endif
+    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+        std::remove(tmpFileName.c_str());
+        throw cRuntimeError("Could not rename \"%s\" to \"%s\"", tmpFileName.c_str(), fileName.c_str());
+    }
+}
+
+veins::Obstacle::Coords ObstacleDatabase::getObstacleShape(size_t i) const
+{
+    const ObstacleRecord& o = obstacles[i];
+    Obstacle::Coords shape;
+    shape.reserve(o.numVertices);
+    for (const VertexRecord* v = vertices + o.firstVertex; v != vertices + o.firstVertex + o.numVertices; ++v) {
+        shape.emplace_back(v->x, v->y);
+    }
+    return shape;
+}
+
+bool ObstacleDatabase::hasCellTable(int cellSize, const Coord& playgroundSize) const
+{
+    return header->numCells > 0 && header->cellSize == cellSize && header->playgroundX == playgroundSize.x && header->playgroundY == playgroundSize.y;
+}
+
+veins::BBoxLookup::CellTable ObstacleDatabase::getCellTable() const
+{
+    BBoxLookup::CellTable table;
+    table.cellSize = header->cellSize;
+    table.numCols = header->numCols;
+    table.numRows = header->numRows;
+    table.cells.reserve(header->numCells);
+    for (const CellRecord* cell = cells; cell != cells + header->numCells; ++cell) {
+        table.cells.push_back({static_cast<size_t>(cell->index), static_cast<size_t>(cell->count)});
+    }
+    table.entries.assign(cellEntries, cellEntries + header->numCellEntries);
+    return table;
+}
+
+std::string ObstacleDatabase::getString(uint64_t offset, uint64_t length) const
+{
+    return std::string(strings + offset, length);
+}
@@ -0,0 +1,163 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/Coord.h"
+#include "veins/modules/obstacle/Obstacle.h"
+#include "veins/modules/utility/BBoxLookup.h"
+
+namespace veins {
+
+/**
+ * Read-only, memory-mapped binary file of obstacle types, obstacles and (optionally) the BBoxLookup cell table built for them.
+ *
+ * Used by ObstacleControl to skip parsing XML and assigning obstacles to grid cells at startup.
+ * All numbers are stored in host byte order, so files are meant to be shared between runs on the same kind of machine.
+ * The file is mapped read-only, so parallel runs loading it share its pages.
+ *
+ * The file consists of a Header, followed by the arrays of TypeRecord, ObstacleRecord, VertexRecord, CellRecord and cell entries (uint64_t), and the string table.
+ * All records are multiples of 8 bytes long, so every array is naturally aligned.
+ */
+class VEINS_API ObstacleDatabase {
+public:
+    static constexpr uint32_t version = 1;
+
+    struct Header {
+        char magic[8]; /**< "VEINSOBS" */
+        uint32_t version;
+        uint32_t numTypes;
+        uint64_t numObstacles;
+        uint64_t numVertices;
+        uint64_t numCells; /**< 0 if no cell table is stored */
+        uint64_t numCellEntries;
+        uint64_t stringBytes;
+        int32_t cellSize; /**< grid cell size the cell table was built for */
+        uint32_t reserved;
+        uint64_t numCols;
+        uint64_t numRows;
+        double playgroundX; /**< playground size the cell table was built for */
+        double playgroundY;
+    };
+    struct TypeRecord {
+        double attenuationPerCut;
+        double attenuationPerMeter;
+        uint64_t nameOffset; /**< in string table */
+        uint64_t nameLength;
+    };
+    struct ObstacleRecord {
+        double bboxX1;
+        double bboxY1;
+        double bboxX2;
+        double bboxY2;
+        uint64_t firstVertex;
+        uint32_t numVertices;
+        uint32_t type; /**< index of TypeRecord */
+        uint64_t idOffset; /**< in string table */
+        uint64_t idLength;
+    };
+    struct VertexRecord {
+        double x;
+        double y;
+    };
+    struct CellRecord {
+        uint64_t index;
+        uint64_t count;
+    };
+
+    /**
+     * map fileName, throwing a cRuntimeError if it is missing or not a valid obstacle database
+     */
+    explicit ObstacleDatabase(const std::string& fileName);
+    ~ObstacleDatabase();
+    ObstacleDatabase(const ObstacleDatabase&) = delete;
+    ObstacleDatabase& operator=(const ObstacleDatabase&) = delete;
+
+    /**
+     * write a database of the given obstacle types and obstacles (and cell table, if not nullptr) to fileName
+     *
+     * The file is replaced at once (by renaming a temporary file), so concurrent runs reading it see either the old or the new database.
+     *
+     * Every obstacle's type must be contained in perCut and perMeter.
+     */
+    static void write(const std::string& fileName, const std::map<std::string, double>& perCut, const std::map<std::string, double>& perMeter, const std::vector<const Obstacle*>& obstacles, const BBoxLookup::CellTable* table, const Coord& playgroundSize);
+
+    size_t getNumTypes() const
+    {
+        return header->numTypes;
+    }
+    const TypeRecord& getType(size_t i) const
+    {
+        return types[i];
+    }
+    std::string getTypeName(size_t i) const
+    {
+        return getString(types[i].nameOffset, types[i].nameLength);
+    }
+
+    size_t getNumObstacles() const
+    {
+        return header->numObstacles;
+    }
+    const ObstacleRecord& getObstacle(size_t i) const
+    {
+        return obstacles[i];
+    }
+    std::string getObstacleId(size_t i) const
+    {
+        return getString(obstacles[i].idOffset, obstacles[i].idLength);
+    }
+    Obstacle::Coords getObstacleShape(size_t i) const;
+
+    /**
+     * return whether a cell table for the given grid cell size and playground size is stored
+     */
+    bool hasCellTable(int cellSize, const Coord& playgroundSize) const;
+
+    /**
+     * return the stored cell table (see hasCellTable)
+     */
+    BBoxLookup::CellTable getCellTable() const;
+
+protected:
+    std::string getString(uint64_t offset, uint64_t length) const;
+
+    void* mapping = nullptr; /**< start of the mapped file */
+    size_t mappingSize = 0;
+    std::vector<char> buffer; /**< file contents, on platforms without mmap */
+    const Header* header = nullptr;
+    const TypeRecord* types = nullptr;
+    const ObstacleRecord* obstacles = nullptr;
+    const VertexRecord* vertices = nullptr;
+    const CellRecord* cells = nullptr;
+    const uint64_t* cellEntries = nullptr;
+    const char* strings = nullptr;
+};
+
+} // namespace veins
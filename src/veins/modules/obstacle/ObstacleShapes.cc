@@ -0,0 +1,165 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "veins/modules/obstacle/ObstacleShapes.h"
+
+namespace {
+
+using Coords = veins::Obstacle::Coords;
+
+/**
+ * return shape without a trailing copy of its first vertex (polygon files often close shapes explicitly)
+ */
+Coords openShape(const Coords& shape)
+{
+    Coords open = shape;
+    while (open.size() > 1 && open.front().x == open.back().x && open.front().y == open.back().y) open.pop_back();
+    return open;
+}
+
+/**
+ * return shape with its vertices in counter-clockwise order (in a right-handed x/y plane)
+ */
+Coords counterClockwise(Coords shape)
+{
+    double area = 0;
+    for (size_t i = 0, j = shape.size() - 1; i < shape.size(); j = i++) {
+        area += (shape[j].x - shape[i].x) * (shape[j].y + shape[i].y);
+    }
+    if (area < 0) std::reverse(shape.begin(), shape.end());
+    return shape;
+}
+
+double distanceToSegment(const veins::Coord& p, const veins::Coord& from, const veins::Coord& to)
+{
+    const double dx = to.x - from.x;
+    const double dy = to.y - from.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    double t = (lengthSquared > 0) ? ((p.x - from.x) * dx + (p.y - from.y) * dy) / lengthSquared : 0;
+    t = std::min(std::max(t, 0.0), 1.0);
+    const double ex = from.x + t * dx - p.x;
+    const double ey = from.y + t * dy - p.y;
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+} // namespace
+
+namespace veins {
+
+Obstacle::Coords simplifyShape(const Obstacle::Coords& shape, double tolerance)
+{
+    const Coords ring = openShape(shape);
+    const size_t n = ring.size();
+    if (n < 4) return shape;
+
+    // split the ring at the vertex farthest from the first one, then simplify both chains
+    size_t farthest = 0;
+    double farthestDistance = -1;
+    for (size_t i = 1; i < n; ++i) {
+        const double d = ring[0].distance(ring[i]);
+        if (d > farthestDistance) {
+            farthest = i;
+            farthestDistance = d;
+        }
+    }
+    std::vector<bool> keep(n, false);
+    keep[0] = true;
+    keep[farthest] = true;
+    std::vector<std::pair<size_t, size_t>> chains{{0, farthest}, {farthest, n}}; // index n denotes vertex 0 again
+    while (!chains.empty()) {
+        const size_t from = chains.back().first;
+        const size_t to = chains.back().second;
+        chains.pop_back();
+        size_t worst = from;
+        double worstDistance = tolerance;
+        for (size_t i = from + 1; i < to; ++i) {
+            const double d = distanceToSegment(ring[i], ring[from], ring[to % n]);
+            if (d > worstDistance) {
+                worst = i;
+                worstDistance = d;
+            }
+        }
+        if (worst == from) continue;
+        keep[worst] = true;
+        chains.emplace_back(from, worst);
+        chains.emplace_back(worst, to);
+    }
+
+    Coords simplified;
+    for (size_t i = 0; i < n; ++i) {
+        if (keep[i]) simplified.push_back(ring[i]);
+    }
+    if (simplified.size() < 3) return shape;
+    return simplified;
+}
+
+bool mergeShapes(const Obstacle::Coords& a, const Obstacle::Coords& b, Obstacle::Coords& merged)
+{
+    const Coords ringA = openShape(a);
+    const Coords ringB = openShape(b);
+    if (ringA.size() < 3 || ringB.size() < 3) return false;
+    const Coords ccwA = counterClockwise(ringA);
+    const Coords ccwB = counterClockwise(ringB);
+    const size_t na = ccwA.size();
+    const size_t nb = ccwB.size();
+
+    std::map<std::pair<double, double>, size_t> indexInB;
+    for (size_t i = 0; i < nb; ++i) indexInB.emplace(std::make_pair(ccwB[i].x, ccwB[i].y), i);
+    std::vector<size_t> shared(na, nb); // index in B of each vertex of A, nb if not shared
+    size_t numShared = 0;
+    for (size_t i = 0; i < na; ++i) {
+        auto it = indexInB.find(std::make_pair(ccwA[i].x, ccwA[i].y));
+        if (it == indexInB.end()) continue;
+        shared[i] = it->second;
+        ++numShared;
+    }
+    if (numShared < 2 || numShared >= na || numShared >= nb) return false;
+
+    // the shared vertices must form one run in A, with every step along it being an edge of B in opposite direction
+    size_t start = 0;
+    while (!(shared[start] != nb && shared[(start + na - 1) % na] == nb)) ++start;
+    for (size_t k = 1; k < numShared; ++k) {
+        const size_t i = (start + k) % na;
+        if (shared[i] == nb) return false;
+        if ((shared[i] + 1) % nb != shared[(start + k - 1) % na]) return false;
+    }
+    const size_t end = (start + numShared - 1) % na;
+
+    // walk A from the end of the shared run around to its start, then B from there back to the end of the run
+    merged.clear();
+    for (size_t i = end;; i = (i + 1) % na) {
+        merged.push_back(ccwA[i]);
+        if (i == start) break;
+    }
+    for (size_t j = (shared[start] + 1) % nb; j != shared[end]; j = (j + 1) % nb) {
+        merged.push_back(ccwB[j]);
+    }
+    return merged.size() >= 3;
+}
+
+} // namespace veins
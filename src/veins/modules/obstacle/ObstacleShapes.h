@@ -0,0 +1,45 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins/veins.h"
+
+#include "veins/modules/obstacle/Obstacle.h"
+
+namespace veins {
+
+/**
+ * Return shape (a closed polygon) with all vertices removed that are closer than tolerance to the simplified outline (Douglas-Peucker).
+ *
+ * Shapes of fewer than four vertices, and shapes that would degenerate to fewer than three vertices, are returned unchanged.
+ */
+VEINS_API Obstacle::Coords simplifyShape(const Obstacle::Coords& shape, double tolerance);
+
+/**
+ * Return whether the closed polygons a and b share a contiguous chain of edges (with identical vertices) and nothing else; if so, store their union in merged.
+ *
+ * Only vertices shared exactly are considered touching, as is the case for buildings exported from a common map.
+ */
+VEINS_API bool mergeShapes(const Obstacle::Coords& a, const Obstacle::Coords& b, Obstacle::Coords& merged);
+
+} // namespace veins
@@ -24,6 +24,7 @@
 #include <map>
 #include <set>
 
+#include <algorithm>
 #include <limits>
 #include <cmath>
 
@@ -31,6 +32,9 @@
 #include "veins/base/modules/BaseMobility.h"
 #include "veins/base/connectionManager/ChannelAccess.h"
 #include "veins/base/toolbox/Signal.h"
+#include "veins/base/modules/BaseWorldUtility.h"
+#include "veins/base/utils/FindModule.h"
+#include "veins/base/utils/Logging.h"
 
 using veins::MobileHostObstacle;
 using veins::Signal;
@@ -42,6 +46,13 @@ VehicleObstacleControl::~VehicleObstacleControl() = default;
 
 void VehicleObstacleControl::initialize(int stage)
 {
+    if (stage == 0) {
+        obstacleGrid.cellSize = par("gridCellSize");
+        if (obstacleGrid.cellSize <= 0) {
+            throw cRuntimeError("gridCellSize was %f, but must be positive", obstacleGrid.cellSize);
+        }
+        getSystemModule()->subscribe(BaseMobility::mobilityStateChangedSignal, this);
+    }
     if (stage == 1) {
         annotations = AnnotationManagerAccess().getIfExists();
         if (annotations) {
@@ -52,6 +63,14 @@ void VehicleObstacleControl::initialize(int stage)
 
 void VehicleObstacleControl::finish()
 {
+    getSystemModule()->unsubscribe(BaseMobility::mobilityStateChangedSignal, this);
+}
+
+void VehicleObstacleControl::receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details)
+{
+    if (signalID == BaseMobility::mobilityStateChangedSignal) {
+        isObstacleGridDirty = true;
+    }
 }
 
 void VehicleObstacleControl::handleMessage(cMessage* msg)
@@ -72,6 +91,7 @@ const MobileHostObstacle* VehicleObstacleControl::add(MobileHostObstacle obstacl
 {
     auto* o = new MobileHostObstacle(obstacle);
     vehicleObstacles.push_back(o);
+    isObstacleGridDirty = true;
 
     return o;
 }
@@ -91,34 +111,68 @@ void VehicleObstacleControl::erase(const MobileHostObstacle* obstacle)
     }
     ASSERT(erasedOne);
     delete obstacle;
+    isObstacleGridDirty = true;
 }
 
-Signal VehicleObstacleControl::getVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, Signal attenuationPrototype)
+Signal VehicleObstacleControl::getVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, const Signal& attenuationPrototype)
 {
     Signal attenuation = Signal(attenuationPrototype.getSpectrum());
+    std::vector<double> attenuationDB(attenuation.getNumValues(), 0);
+    addVehicleAttenuationSingle(h1, h2, h, d, d1, attenuation.getSpectrum(), attenuationDB.data());
+    std::copy(attenuationDB.begin(), attenuationDB.end(), attenuation.getValues());
+    return attenuation;
+}
+
+void VehicleObstacleControl::addVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, const Spectrum& spectrum, double* attenuation_dB)
+{
+    addVehicleAttenuationSingle(h1, h2, h, d, d1, spectrum, 0, spectrum.getNumFreqs(), attenuation_dB);
+}
+
+void VehicleObstacleControl::addVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, const Spectrum& spectrum, size_t from, size_t to, double* attenuation_dB)
+{
+    double d2 = d - d1;
+    double y = (h2 - h1) / d * d1 + h1;
+    double H = h - y;
 
-    for (uint16_t i = 0; i < attenuation.getNumValues(); i++) {
-        double freq = attenuation.getSpectrum().freqAt(i);
+    for (size_t i = from; i < to; i++) {
+        double freq = spectrum.freqAt(i);
         double lambda = BaseWorldUtility::speedOfLight() / freq;
-        double d2 = d - d1;
-        double y = (h2 - h1) / d * d1 + h1;
-        double H = h - y;
         double r1 = sqrt(lambda * d1 * d2 / d);
         double V0 = sqrt(2) * H / r1;
 
-        if (V0 <= -0.7) {
-            attenuation.at(i) = 0;
-        }
-        else {
-            attenuation.at(i) = 6.9 + 20 * log10(sqrt(pow((V0 - 0.1), 2) + 1) + V0 - 0.1);
+        if (V0 > -0.7) {
+            attenuation_dB[i] += 6.9 + 20 * log10(sqrt(pow((V0 - 0.1), 2) + 1) + V0 - 0.1);
         }
     }
+}
 
+Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Signal& attenuationPrototype)
+{
+    Signal attenuation(attenuationPrototype.getSpectrum());
+    std::vector<size_t> majorObstacles;
+    std::vector<double> attenuationDB(attenuation.getNumValues(), 0);
+    computeVehicleAttenuationDZ(dz_vec, attenuation.getSpectrum(), attenuationDB.data(), majorObstacles);
+    std::copy(attenuationDB.begin(), attenuationDB.end(), attenuation.getValues());
     return attenuation;
 }
 
-Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, Signal attenuationPrototype)
+void VehicleObstacleControl::computeVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Spectrum& spectrum, double* attenuation_dB, std::vector<size_t>& majorObstacles)
 {
+    computeVehicleAttenuationDZ(dz_vec, spectrum, attenuation_dB, majorObstacles, std::numeric_limits<double>::infinity());
+}
+
+bool VehicleObstacleControl::computeVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Spectrum& spectrum, double* attenuation_dB, std::vector<size_t>& mo, double maxAttenuation_dB)
+{
+    return computeVehicleAttenuationDZ(dz_vec, spectrum, 0, spectrum.getNumFreqs(), attenuation_dB, mo, maxAttenuation_dB);
+}
+
+bool VehicleObstacleControl::computeVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Spectrum& spectrum, size_t from, size_t to, double* attenuation_dB, std::vector<size_t>& mo, double maxAttenuation_dB)
+{
+    ASSERT(from < to && to <= spectrum.getNumFreqs());
+    const bool mayStopEarly = !std::isinf(maxAttenuation_dB);
+    auto exceedsMaxAttenuation = [&]() {
+        return mayStopEarly && (*std::min_element(attenuation_dB + from, attenuation_dB + to) > maxAttenuation_dB);
+    };
 
     // basic sanity check
     ASSERT(dz_vec.size() >= 2);
@@ -137,7 +191,8 @@ Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pa
      * mo0 mo1       mo2  mo3
      * snd                rcv
      */
-    std::vector<size_t> mo; ///< indices of MOs (this includes the sender and receiver)
+    // mo: indices of MOs (this includes the sender and receiver)
+    mo.clear();
     mo.push_back(0);
     for (size_t i = 0;;) {
         double max_slope = -std::numeric_limits<double>::infinity();
@@ -165,8 +220,9 @@ Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pa
     }
     mo.push_back(dz_vec.size() - 1);
 
+    std::fill(attenuation_dB + from, attenuation_dB + to, 0);
+
     // calculate attenuation due to MOs
-    Signal attenuation_mo(attenuationPrototype.getSpectrum());
     for (size_t mm = 0; mm < mo.size() - 2; ++mm) {
         size_t tx = mo[mm];
         size_t ob = mo[mm + 1];
@@ -178,13 +234,11 @@ Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pa
         double d1 = dz_vec[ob].first - dz_vec[tx].first;
         double h = dz_vec[ob].second;
 
-        Signal ad_mo = getVehicleAttenuationSingle(h1, h2, h, d, d1, attenuationPrototype);
-
-        attenuation_mo += ad_mo;
+        addVehicleAttenuationSingle(h1, h2, h, d, d1, spectrum, from, to, attenuation_dB);
+        if (exceedsMaxAttenuation()) return false;
     }
 
     // calculate attenuation due to "small obstacles" (i.e. the ones in-between MOs)
-    Signal attenuation_so(attenuationPrototype.getSpectrum());
     for (size_t i = 0; i < mo.size() - 1; ++i) {
         size_t delta = mo[i + 1] - mo[i];
 
@@ -203,8 +257,8 @@ Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pa
             double d1 = dz_vec[ob].first - dz_vec[tx].first;
             double h = dz_vec[ob].second;
 
-            Signal ad_mo = getVehicleAttenuationSingle(h1, h2, h, d, d1, attenuationPrototype);
-            attenuation_so += ad_mo;
+            addVehicleAttenuationSingle(h1, h2, h, d, d1, spectrum, from, to, attenuation_dB);
+            if (exceedsMaxAttenuation()) return false;
         }
         else {
             // multiple obstacles in-between these two MOs -- use the one closest to their line of sight
@@ -240,8 +294,8 @@ Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pa
             double d1 = dz_vec[ob].first - dz_vec[tx].first;
             double h = dz_vec[ob].second;
 
-            Signal ad_mo = getVehicleAttenuationSingle(h1, h2, h, d, d1, attenuationPrototype);
-            attenuation_so += ad_mo;
+            addVehicleAttenuationSingle(h1, h2, h, d, d1, spectrum, from, to, attenuation_dB);
+            if (exceedsMaxAttenuation()) return false;
         }
     }
 
@@ -270,51 +324,141 @@ Signal VehicleObstacleControl::getVehicleAttenuationDZ(const std::vector<std::pa
         c = -10 * log10((prodS * sumS) / (prodSsum * firstS * lastS));
     }
 
-    return attenuation_mo + attenuation_so + c;
+    for (size_t i = from; i < to; i++) {
+        attenuation_dB[i] += c;
+    }
+    return true;
 }
 
-std::vector<std::pair<double, double>> VehicleObstacleControl::getPotentialObstacles(const AntennaPosition& senderPos_, const AntennaPosition& receiverPos_, const Signal& s) const
+void VehicleObstacleControl::pruneVehicleObstacles(std::vector<std::pair<double, double>>& dz_vec, double lambda, size_t maxObstacles, std::vector<std::pair<double, size_t>>& significance)
 {
-    Enter_Method_Silent();
+    ASSERT(dz_vec.size() >= 2);
 
-    auto senderPos = senderPos_.getPositionAt();
-    auto receiverPos = receiverPos_.getPositionAt();
+    const double h1 = dz_vec.front().second;
+    const double h2 = dz_vec.back().second;
+    const double d = dz_vec.back().first - dz_vec.front().first;
+
+    // knife-edge parameter of each obstacle relative to the line of sight, keeping those within the first Fresnel zone (v > -sqrt(2), i.e., less than one Fresnel radius below the line)
+    significance.clear();
+    for (size_t i = 1; i < dz_vec.size() - 1; ++i) {
+        const double d1 = dz_vec[i].first - dz_vec.front().first;
+        const double d2 = d - d1;
+        const double H = dz_vec[i].second - ((h2 - h1) / d * d1 + h1);
+        const double r1 = sqrt(lambda * d1 * d2 / d);
+        const double v = sqrt(2) * H / r1;
+        if (v > -sqrt(2)) significance.emplace_back(v, i);
+    }
 
-    double senderHeight = senderPos.z;
-    double receiverHeight = receiverPos.z;
+    // most significant first (ties broken by position, so results do not depend on the sort)
+    std::sort(significance.begin(), significance.end(), [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+        return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second);
+    });
+    if ((maxObstacles > 0) && (significance.size() > maxObstacles)) significance.resize(maxObstacles);
+
+    // compact the obstacles kept (plus sender and receiver) in their original order
+    std::sort(significance.begin(), significance.end(), [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+        return a.second < b.second;
+    });
+    size_t kept = 1;
+    for (const auto& obstacle : significance) {
+        dz_vec[kept++] = dz_vec[obstacle.second];
+    }
+    dz_vec[kept++] = dz_vec.back();
+    dz_vec.resize(kept);
+}
 
-    ASSERT(senderHeight > 0);
-    ASSERT(receiverHeight > 0);
+std::vector<std::pair<double, double>> VehicleObstacleControl::getPotentialObstacles(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const Signal& s) const
+{
+    std::vector<std::pair<double, double>> potentialObstacles;
+    getPotentialObstacles(senderPos, receiverPos, s, potentialObstacles);
+    return potentialObstacles;
+}
+
+void VehicleObstacleControl::getPotentialObstacles(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const Signal& s, std::vector<std::pair<double, double>>& potentialObstacles) const
+{
+    getPotentialObstacles(senderPos, receiverPos, LinkGeometry(senderPos.getPositionAt(), receiverPos.getPositionAt()), s, potentialObstacles);
+}
 
-    std::vector<std::pair<double, double>> potentialObstacles; /**< linear position of each obstructing vehicle along (senderPos--receiverPos) */
+void VehicleObstacleControl::getPotentialObstacles(const AntennaPosition& senderPos_, const AntennaPosition& receiverPos_, const LinkGeometry& link, const Signal& s, std::vector<std::pair<double, double>>& potentialObstacles) const
+{
+    Enter_Method_Silent();
 
+    const Coord& senderPos = link.senderPos;
+    const Coord& receiverPos = link.receiverPos;
     simtime_t sStart = s.getSendingStart();
 
-    EV << "searching candidates for transmission from " << senderPos.info() << " -> " << receiverPos.info() << " (" << senderPos.distance(receiverPos) << "meters total)" << std::endl;
-
     if (hasGUI() && annotations) {
         annotations->eraseAll(vehicleAnnotationGroup);
         drawVehicleObstacles(sStart);
         annotations->drawLine(senderPos, receiverPos, "blue", vehicleAnnotationGroup);
     }
 
+    candidateObstacles.clear();
+    findCandidateObstacles(std::min(senderPos.x, receiverPos.x), std::min(senderPos.y, receiverPos.y), std::max(senderPos.x, receiverPos.x), std::max(senderPos.y, receiverPos.y), sStart, candidateObstacles);
+    collectPotentialObstacles(senderPos_, receiverPos_, link, sStart, candidateObstacles, potentialObstacles);
+
+    if (hasGUI() && annotations) {
+        for (const auto& obstacle : potentialObstacles) {
+            Coord hitPos = senderPos + link.direction * obstacle.first;
+            annotations->drawLine(senderPos, hitPos, "red", vehicleAnnotationGroup);
+        }
+    }
+}
+
+void VehicleObstacleControl::queryPotentialObstacles(const AntennaPosition& senderPos_, const AntennaPosition& receiverPos_, const LinkGeometry& link, const Signal& s, std::vector<std::pair<double, double>>& potentialObstacles, QueryScratch& scratch) const
+{
+    if (!isGeometryCommitted()) {
+        throw cRuntimeError("Hosts moved since the last VehicleObstacleControl::commitGeometry(), so they cannot be queried concurrently");
+    }
+
+    const Coord& senderPos = link.senderPos;
+    const Coord& receiverPos = link.receiverPos;
+    simtime_t sStart = s.getSendingStart();
+
+    scratch.candidates.clear();
+    findCandidateObstacles(std::min(senderPos.x, receiverPos.x), std::min(senderPos.y, receiverPos.y), std::max(senderPos.x, receiverPos.x), std::max(senderPos.y, receiverPos.y), sStart, scratch.candidates, scratch.obstacleEpochs, scratch.queryEpoch, scratch.found);
+    collectPotentialObstacles(senderPos_, receiverPos_, link, sStart, scratch.candidates, potentialObstacles);
+}
+
+void VehicleObstacleControl::commitGeometry()
+{
+    Enter_Method_Silent();
+    if (isObstacleGridDirty) rebuildObstacleGrid();
+}
+
+void VehicleObstacleControl::collectPotentialObstacles(const AntennaPosition& senderPos_, const AntennaPosition& receiverPos_, const LinkGeometry& link, simtime_t sStart, const std::vector<const ObstacleGeometry*>& candidates, std::vector<std::pair<double, double>>& potentialObstacles) const
+{
+    const Coord& senderPos = link.senderPos;
+    const Coord& receiverPos = link.receiverPos;
+
+    double senderHeight = senderPos.z;
+    double receiverHeight = receiverPos.z;
+
+    ASSERT(senderHeight > 0);
+    ASSERT(receiverHeight > 0);
+
+    potentialObstacles.clear(); /**< linear position of each obstructing vehicle along (senderPos--receiverPos) */
+
+    VEINS_LOG_TRACE << "searching candidates for transmission from " << senderPos.info() << " -> " << receiverPos.info() << " (" << link.distance << "meters total)" << std::endl;
+
     double x1 = std::min(senderPos.x, receiverPos.x);
     double x2 = std::max(senderPos.x, receiverPos.x);
     double y1 = std::min(senderPos.y, receiverPos.y);
     double y2 = std::max(senderPos.y, receiverPos.y);
 
-    for (auto o : vehicleObstacles) {
-        auto obstacleAntennaPositions = o->getInitialAntennaPositions();
-        double l = o->getLength();
-        double w = o->getWidth();
+    for (auto g : candidates) {
+        const MobileHostObstacle* o = g->obstacle;
+        const auto& obstacleAntennaPositions = o->getInitialAntennaPositions();
         double h = o->getHeight();
 
-        auto hp_approx = o->getMobility()->getPositionAt(simTime());
+        VEINS_LOG_TRACE << "checking vehicle in proximity of " << g->position.info() << " with height: " << h << " width: " << o->getWidth() << " length: " << o->getLength() << endl;
 
-        EV << "checking vehicle in proximity of " << hp_approx.info() << " with height: " << h << " width: " << w << " length: " << l << endl;
-
-        if (!o->maybeInBounds(x1, y1, x2, y2, sStart)) {
-            EV_TRACE << "bounding boxes don't overlap: ignore" << std::endl;
+        // the precomputed bounding boxes hold for the time the grid was built, other times only need the host position
+        const bool atBuildTime = (sStart == obstacleGrid.buildTime);
+        const Coord hostPos = atBuildTime ? g->position : o->getMobility()->getPositionAt(sStart);
+        const bool inBounds = atBuildTime ? !(g->maxX < x1 || g->minX > x2 || g->maxY < y1 || g->minY > y2) : MobileHostObstacle::maybeInBounds(hostPos, g->footprint, x1, y1, x2, y2);
+        if (!inBounds) {
+            VEINS_LOG_TRACE << "bounding boxes don't overlap: ignore" << std::endl;
             continue;
         }
 
@@ -322,45 +466,154 @@ std::vector<std::pair<double, double>> VehicleObstacleControl::getPotentialObsta
         bool ignoreMe = false;
         for (auto obstacleAntenna : obstacleAntennaPositions) {
             if (obstacleAntenna.isSameAntenna(senderPos_)) {
-                EV_TRACE << "...this is the sender: ignore" << std::endl;
+                VEINS_LOG_TRACE << "...this is the sender: ignore" << std::endl;
                 ignoreMe = true;
             }
             if (obstacleAntenna.isSameAntenna(receiverPos_)) {
-                EV_TRACE << "...this is the receiver: ignore" << std::endl;
+                VEINS_LOG_TRACE << "...this is the receiver: ignore" << std::endl;
                 ignoreMe = true;
             }
         }
         if (ignoreMe) continue;
 
         // this is a potential obstacle
-        double p1d = o->getIntersectionPoint(senderPos, receiverPos, sStart);
-        double maxd = senderPos.distance(receiverPos);
+        const std::array<Coord, 4> corners = {{
+            hostPos + g->footprint.cornerOffsets[0],
+            hostPos + g->footprint.cornerOffsets[1],
+            hostPos + g->footprint.cornerOffsets[2],
+            hostPos + g->footprint.cornerOffsets[3],
+        }};
+        double p1d = MobileHostObstacle::getIntersectionPoint(corners, senderPos, receiverPos);
+        double maxd = link.distance;
         if (!std::isnan(p1d) && p1d > 0 && p1d < maxd) {
-            auto it = potentialObstacles.begin();
-            while (true) {
-                if (it == potentialObstacles.end()) {
-                    potentialObstacles.emplace_back(p1d, h);
-                    break;
-                }
-                if (it->first == p1d) { // omit double entries
-                    EV << "two obstacles at same distance " << it->first << " == " << p1d << " height: " << it->second << " =? " << h << std::endl;
-                    break;
-                }
-                if (it->first > p1d) {
-                    potentialObstacles.insert(it, std::make_pair(p1d, h));
-                    break;
-                }
-                ++it;
+            potentialObstacles.emplace_back(p1d, h);
+            VEINS_LOG_TRACE << "\tgot obstacle in 2d-LOS, " << p1d << " meters away from sender" << std::endl;
+        }
+    }
+
+    // sort once by distance (stable insertion sort: lists are short, and std::stable_sort may allocate), omitting double entries (keeping the first one found)
+    for (size_t i = 1; i < potentialObstacles.size(); ++i) {
+        for (size_t j = i; j > 0 && potentialObstacles[j - 1].first > potentialObstacles[j].first; --j) {
+            std::swap(potentialObstacles[j - 1], potentialObstacles[j]);
+        }
+    }
+    auto last = std::unique(potentialObstacles.begin(), potentialObstacles.end(), [](const std::pair<double, double>& a, const std::pair<double, double>& b) {
+        if (a.first != b.first) return false;
+        VEINS_LOG_TRACE << "two obstacles at same distance " << a.first << " == " << b.first << " height: " << a.second << " =? " << b.second << std::endl;
+        return true;
+    });
+    potentialObstacles.erase(last, potentialObstacles.end());
+}
+
+void VehicleObstacleControl::rebuildObstacleGrid() const
+{
+    ObstacleGrid& grid = obstacleGrid;
+    const Coord& playgroundSize = *FindModule<BaseWorldUtility*>::findGlobalModule()->getPgs();
+    grid.numCols = static_cast<size_t>(playgroundSize.x / grid.cellSize) + 1;
+    grid.numRows = static_cast<size_t>(playgroundSize.y / grid.cellSize) + 1;
+    grid.buildTime = simTime();
+    grid.maxSpeed = 0;
+    grid.obstacles.clear();
+    grid.obstacles.reserve(vehicleObstacles.size());
+    for (auto o : vehicleObstacles) {
+        ObstacleGeometry g;
+        g.obstacle = o;
+        g.footprint = o->getFootprint();
+        g.position = o->getMobility()->getPositionAt(grid.buildTime);
+        // same bounding box as MobileHostObstacle::maybeInBounds
+        g.minX = g.position.x - g.footprint.offset - g.footprint.reach;
+        g.maxX = g.position.x + g.footprint.offset + g.footprint.reach;
+        g.minY = g.position.y - g.footprint.offset - g.footprint.reach;
+        g.maxY = g.position.y + g.footprint.offset + g.footprint.reach;
+        grid.obstacles.push_back(g);
+        grid.maxSpeed = std::max(grid.maxSpeed, o->getMobility()->getCurrentSpeed().length());
+    }
+    grid.obstacleEpochs.assign(grid.obstacles.size(), 0);
+    grid.queryEpoch = 0;
+
+    auto cellRange = [&grid](double lo, double hi, size_t numCells) {
+        const size_t first = std::min(static_cast<size_t>(std::max(0.0, lo / grid.cellSize)), numCells - 1);
+        const size_t last = std::min(static_cast<size_t>(std::max(0.0, hi / grid.cellSize)), numCells - 1);
+        return std::make_pair(first, last);
+    };
+
+    struct CellBox {
+        std::pair<size_t, size_t> cols;
+        std::pair<size_t, size_t> rows;
+    };
+    std::vector<CellBox> boxes;
+    boxes.reserve(grid.obstacles.size());
+    std::vector<size_t> cellCounts(grid.numCols * grid.numRows + 1, 0);
+    for (const auto& g : grid.obstacles) {
+        boxes.push_back({cellRange(g.minX, g.maxX, grid.numCols), cellRange(g.minY, g.maxY, grid.numRows)});
+        for (size_t row = boxes.back().rows.first; row <= boxes.back().rows.second; ++row) {
+            for (size_t col = boxes.back().cols.first; col <= boxes.back().cols.second; ++col) {
+                cellCounts[col + row * grid.numCols]++;
             }
-            EV << "\tgot obstacle in 2d-LOS, " << p1d << " meters away from sender" << std::endl;
-            Coord hitPos = senderPos + (receiverPos - senderPos) / senderPos.distance(receiverPos) * p1d;
-            if (hasGUI() && annotations) {
-                annotations->drawLine(senderPos, hitPos, "red", vehicleAnnotationGroup);
+        }
+    }
+
+    // counting sort of (obstacle, cell) entries by cell
+    grid.cellStart.assign(cellCounts.size(), 0);
+    for (size_t i = 1; i < cellCounts.size(); ++i) {
+        grid.cellStart[i] = grid.cellStart[i - 1] + cellCounts[i - 1];
+    }
+    grid.cellEntries.resize(grid.cellStart.back());
+    std::vector<size_t> fill(grid.cellStart.begin(), grid.cellStart.end() - 1);
+    for (size_t index = 0; index < boxes.size(); ++index) {
+        for (size_t row = boxes[index].rows.first; row <= boxes[index].rows.second; ++row) {
+            for (size_t col = boxes[index].cols.first; col <= boxes[index].cols.second; ++col) {
+                grid.cellEntries[fill[col + row * grid.numCols]++] = index;
             }
         }
     }
 
-    return potentialObstacles;
+    isObstacleGridDirty = false;
+}
+
+void VehicleObstacleControl::findCandidateObstacles(double x1, double y1, double x2, double y2, simtime_t t, std::vector<const ObstacleGeometry*>& candidates) const
+{
+    if (isObstacleGridDirty) rebuildObstacleGrid();
+    findCandidateObstacles(x1, y1, x2, y2, t, candidates, obstacleGrid.obstacleEpochs, obstacleGrid.queryEpoch, obstacleGrid.found);
+}
+
+void VehicleObstacleControl::findCandidateObstacles(double x1, double y1, double x2, double y2, simtime_t t, std::vector<const ObstacleGeometry*>& candidates, std::vector<unsigned int>& epochs, unsigned int& epoch, std::vector<size_t>& found) const
+{
+    const ObstacleGrid& grid = obstacleGrid;
+    if (grid.obstacles.empty()) return;
+
+    // stamps of a previous grid may remain, they just must not equal the new epoch
+    if (epochs.size() != grid.obstacles.size()) epochs.assign(grid.obstacles.size(), 0);
+    if (++epoch == 0) {
+        std::fill(epochs.begin(), epochs.end(), 0);
+        epoch = 1;
+    }
+
+    // hosts may have moved (linearly) since buildTime
+    const double margin = grid.maxSpeed * std::abs(SIMTIME_DBL(t - grid.buildTime));
+    const size_t firstCol = std::min(static_cast<size_t>(std::max(0.0, (x1 - margin) / grid.cellSize)), grid.numCols - 1);
+    const size_t lastCol = std::min(static_cast<size_t>(std::max(0.0, (x2 + margin) / grid.cellSize)), grid.numCols - 1);
+    const size_t firstRow = std::min(static_cast<size_t>(std::max(0.0, (y1 - margin) / grid.cellSize)), grid.numRows - 1);
+    const size_t lastRow = std::min(static_cast<size_t>(std::max(0.0, (y2 + margin) / grid.cellSize)), grid.numRows - 1);
+
+    found.clear();
+    for (size_t row = firstRow; row <= lastRow; ++row) {
+        for (size_t col = firstCol; col <= lastCol; ++col) {
+            const size_t cell = col + row * grid.numCols;
+            for (size_t entry = grid.cellStart[cell]; entry < grid.cellStart[cell + 1]; ++entry) {
+                const size_t index = grid.cellEntries[entry];
+                if (epochs[index] == epoch) continue;
+                epochs[index] = epoch;
+                found.push_back(index);
+            }
+        }
+    }
+
+    // keep the order of vehicleObstacles, so results do not depend on the grid
+    std::sort(found.begin(), found.end());
+    for (auto index : found) {
+        candidates.push_back(&grid.obstacles[index]);
+    }
 }
 
 void VehicleObstacleControl::drawVehicleObstacles(const simtime_t& t) const
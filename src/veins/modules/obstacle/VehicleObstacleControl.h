@@ -28,10 +28,13 @@
 
 #include "veins/base/utils/AntennaPosition.h"
 #include "veins/base/utils/Coord.h"
+#include "veins/base/utils/LinkGeometry.h"
 #include "veins/modules/obstacle/Obstacle.h"
 #include "veins/modules/world/annotations/AnnotationManager.h"
 #include "veins/base/utils/Move.h"
 #include "veins/modules/obstacle/MobileHostObstacle.h"
+#include "veins/base/toolbox/Spectrum.h"
+#include "veins/base/utils/ModuleRegistry.h"
 
 namespace veins {
 
@@ -44,7 +47,7 @@ class Signal;
  * Transmissions that cross one of the polygon's lines will have
  * their receive power set to zero.
  */
-class VEINS_API VehicleObstacleControl : public cSimpleModule {
+class VEINS_API VehicleObstacleControl : public cSimpleModule, public cListener {
 public:
     ~VehicleObstacleControl() override;
     void initialize(int stage) override;
@@ -53,9 +56,17 @@ public:
         return 2;
     }
     void finish() override;
+    void finish(cComponent* component, simsignal_t signalID) override
+    {
+        cListener::finish(component, signalID);
+    }
     void handleMessage(cMessage* msg) override;
     void handleSelfMsg(cMessage* msg);
 
+    /** @brief Marks the obstacle grid as outdated whenever a host moved. */
+    using cListener::receiveSignal;
+    void receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details) override;
+
     const MobileHostObstacle* add(MobileHostObstacle obstacle);
     void erase(const MobileHostObstacle* obstacle);
 
@@ -64,6 +75,41 @@ public:
      */
     std::vector<std::pair<double, double>> getPotentialObstacles(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const Signal& s) const;
 
+    /**
+     * get distance and height of potential obstacles (sorted by distance) into a caller-provided buffer, avoiding allocations once the buffer is large enough
+     */
+    void getPotentialObstacles(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const Signal& s, std::vector<std::pair<double, double>>& potentialObstacles) const;
+
+    /**
+     * like the above, but taking positions and distances from link (the geometry of the link between senderPos and receiverPos), instead of computing them
+     */
+    void getPotentialObstacles(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const LinkGeometry& link, const Signal& s, std::vector<std::pair<double, double>>& potentialObstacles) const;
+
+    /**
+     * caller-owned state of queryPotentialObstacles(): scratch buffers and grid query state (one per thread)
+     */
+    struct QueryScratch;
+
+    /**
+     * bring the grid of obstacle bounding boxes up to date with the hosts' current positions, so queryPotentialObstacles() can be used until hosts move (or are added or erased) again
+     */
+    void commitGeometry();
+
+    /**
+     * return whether the geometry was committed (see commitGeometry()) since hosts last moved
+     */
+    bool isGeometryCommitted() const
+    {
+        return !isObstacleGridDirty;
+    }
+
+    /**
+     * get distance and height of potential obstacles like getPotentialObstacles(), but without using or changing any state of this module (and without drawing annotations)
+     *
+     * Safe to be called concurrently from several threads, as long as each passes a QueryScratch of its own and the geometry is committed (throws a cRuntimeError if not).
+     */
+    void queryPotentialObstacles(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const LinkGeometry& link, const Signal& s, std::vector<std::pair<double, double>>& potentialObstacles, QueryScratch& scratch) const;
+
     /**
      * compute attenuation due to (single) vehicle.
      * Calculate impact of vehicles as obstacles according to:
@@ -76,7 +122,17 @@ public:
      * @param d1: distance between sender and obstacle
      * @param attenuationPrototype: a prototype Signal for constructing a Signal containing the attenuation factors for each frequency
      */
-    static Signal getVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, Signal attenuationPrototype);
+    static Signal getVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, const Signal& attenuationPrototype);
+
+    /**
+     * add attenuation (in dB) due to (single) vehicle for each frequency of spectrum to attenuation_dB, see getVehicleAttenuationSingle
+     */
+    static void addVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, const Spectrum& spectrum, double* attenuation_dB);
+
+    /**
+     * like the above, but only for the frequencies of spectrum in [from, to)
+     */
+    static void addVehicleAttenuationSingle(double h1, double h2, double h, double d, double d1, const Spectrum& spectrum, size_t from, size_t to, double* attenuation_dB);
 
     /**
      * compute attenuation due to vehicles.
@@ -86,15 +142,112 @@ public:
      * @param dz_vec: a vector of (distance, height) referring to potential obstacles along the line of sight, starting with the sender and ending with the receiver
      * @param attenuationPrototype: a prototype Signal for constructing a Signal containing the attenuation factors for each frequency
      */
-    static Signal getVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, Signal attenuationPrototype);
+    static Signal getVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Signal& attenuationPrototype);
+
+    /**
+     * store attenuation (in dB) due to vehicles for each frequency of spectrum in attenuation_dB, see getVehicleAttenuationDZ
+     *
+     * @param majorObstacles: scratch buffer for indices of major obstacles, so no allocations happen once it is large enough
+     */
+    static void computeVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Spectrum& spectrum, double* attenuation_dB, std::vector<size_t>& majorObstacles);
+
+    /**
+     * like the above, but stop as soon as the attenuation at every frequency exceeds maxAttenuation_dB (all terms of the model are non-negative, so it can only grow)
+     *
+     * @return false if stopped early (attenuation_dB then holds a partial sum), true otherwise
+     */
+    static bool computeVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Spectrum& spectrum, double* attenuation_dB, std::vector<size_t>& majorObstacles, double maxAttenuation_dB);
+
+    /**
+     * like the above, but only for the frequencies of spectrum in [from, to) (other entries of attenuation_dB are left untouched)
+     */
+    static bool computeVehicleAttenuationDZ(const std::vector<std::pair<double, double>>& dz_vec, const Spectrum& spectrum, size_t from, size_t to, double* attenuation_dB, std::vector<size_t>& majorObstacles, double maxAttenuation_dB);
+
+    /**
+     * reduce the potential obstacles in dz_vec (as passed to computeVehicleAttenuationDZ) to the ones that matter most, trading accuracy for speed.
+     *
+     * Only obstacles intruding into the first Fresnel zone (at wavelength lambda) of the line of sight between sender and receiver are kept,
+     * and of these only the (at most) maxObstacles ones protruding most (relative to the Fresnel radius at their position), in their original order.
+     *
+     * @param maxObstacles: number of obstacles to keep at most (0: no limit)
+     * @param significance: scratch buffer for (knife-edge parameter, index) of obstacles, so no allocations happen once it is large enough
+     */
+    static void pruneVehicleObstacles(std::vector<std::pair<double, double>>& dz_vec, double lambda, size_t maxObstacles, std::vector<std::pair<double, size_t>>& significance);
 
 protected:
+    /**
+     * rebuild the grid of obstacle bounding boxes from the obstacles' current positions
+     */
+    void rebuildObstacleGrid() const;
+
+    /**
+     * geometry of a vehicle obstacle, computed once per rebuild of the grid (i.e., once per mobility update) rather than for every link checked
+     */
+    struct ObstacleGeometry {
+        const MobileHostObstacle* obstacle;
+        MobileHostObstacle::Footprint footprint; /**< oriented bounding box, relative to the host position */
+        Coord position; /**< host position at buildTime */
+        double minX; /**< axis-aligned bounding box at buildTime, as checked by MobileHostObstacle::maybeInBounds */
+        double minY;
+        double maxX;
+        double maxY;
+    };
+
+    /**
+     * return all obstacles whose bounding box at time t might overlap the given box, in the order of vehicleObstacles
+     */
+    void findCandidateObstacles(double x1, double y1, double x2, double y2, simtime_t t, std::vector<const ObstacleGeometry*>& candidates) const;
+
+    /**
+     * like the above, for an up to date grid, but keeping track of the obstacles found in epochs, epoch and found rather than in the grid
+     */
+    void findCandidateObstacles(double x1, double y1, double x2, double y2, simtime_t t, std::vector<const ObstacleGeometry*>& candidates, std::vector<unsigned int>& epochs, unsigned int& epoch, std::vector<size_t>& found) const;
+
+    /**
+     * store distance and height of those of candidates that obstruct the link in potentialObstacles (sorted by distance, without double entries)
+     */
+    void collectPotentialObstacles(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const LinkGeometry& link, simtime_t sStart, const std::vector<const ObstacleGeometry*>& candidates, std::vector<std::pair<double, double>>& potentialObstacles) const;
+
+    mutable std::vector<const ObstacleGeometry*> candidateObstacles; /**< scratch buffer for findCandidateObstacles */
+
     AnnotationManager* annotations;
 
     using VehicleObstacles = std::list<MobileHostObstacle*>;
     VehicleObstacles vehicleObstacles;
     AnnotationManager::Group* vehicleAnnotationGroup;
     void drawVehicleObstacles(const simtime_t& t) const;
+
+    /**
+     * Uniform grid over the bounding boxes of all vehicle obstacles.
+     *
+     * Hosts only change their movement with a mobility update, so the grid is built (lazily) once after hosts moved and shared by all receptions until the next update.
+     * For other points in time, bounding boxes are grown by the distance the fastest host can cover.
+     */
+    struct ObstacleGrid {
+        double cellSize = 50; /**< side length of a square cell */
+        size_t numCols = 0; /**< cells in x direction */
+        size_t numRows = 0; /**< cells in y direction */
+        simtime_t buildTime; /**< time the bounding boxes were computed for */
+        double maxSpeed = 0; /**< largest speed of any obstacle at buildTime */
+        std::vector<ObstacleGeometry> obstacles; /**< geometry of all obstacles, in the order of vehicleObstacles */
+        std::vector<size_t> cellStart; /**< entries of cell i are cellEntries[cellStart[i]] to cellEntries[cellStart[i + 1] - 1] */
+        std::vector<size_t> cellEntries; /**< indices into obstacles, ordered by cell */
+        std::vector<unsigned int> obstacleEpochs; /**< value of queryEpoch when the obstacle was last found */
+        unsigned int queryEpoch = 0; /**< number of the current query */
+        std::vector<size_t> found; /**< scratch buffer for indices found by a query */
+    };
+    mutable ObstacleGrid obstacleGrid;
+    mutable bool isObstacleGridDirty = true;
+
+private:
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
+};
+
+struct VehicleObstacleControl::QueryScratch {
+    std::vector<const ObstacleGeometry*> candidates; /**< obstacles whose bounding box might overlap the link */
+    std::vector<unsigned int> obstacleEpochs; /**< value of queryEpoch when the obstacle (by index in the grid) was last found */
+    unsigned int queryEpoch = 0; /**< number of the current query */
+    std::vector<size_t> found; /**< indices found by the current query */
 };
 
 class VEINS_API VehicleObstacleControlAccess {
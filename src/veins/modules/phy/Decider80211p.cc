@@ -28,15 +28,19 @@
  */
 
 #include "veins/modules/phy/Decider80211p.h"
+#include "veins/base/utils/Profiling.h"
 #include "veins/modules/phy/DeciderResult80211.h"
 #include "veins/modules/messages/Mac80211Pkt_m.h"
 #include "veins/base/toolbox/Signal.h"
 #include "veins/modules/messages/AirFrame11p_m.h"
 #include "veins/modules/phy/NistErrorRate.h"
+#include "veins/modules/phy/TabulatedErrorRate.h"
 #include "veins/modules/utility/ConstsPhy.h"
 
 #include "veins/base/toolbox/SignalUtils.h"
 
+#include <algorithm>
+
 using namespace veins;
 
 simtime_t Decider80211p::processNewSignal(AirFrame* msg)
@@ -47,9 +51,21 @@ simtime_t Decider80211p::processNewSignal(AirFrame* msg)
     // get the receiving power of the Signal at start-time and center frequency
     Signal& signal = frame->getSignal();
 
-    signalStates[frame] = EXPECT_END;
+    if (incrementalSinr) {
+        // the power of each frame is needed in full right away, see incrementalSinr
+        signal.applyAllAnalogueModels();
+    }
+
+    inFlightFrames.push_back({frame, EXPECT_END});
+
+    if (incrementalSinr && currentSignal.first) {
+        trackInterferer(frame);
+    }
+
+    const bool underMinPowerLevel = signal.smallerAtCenterFrequency(minPowerLevel);
+    addReceivedPower(frame);
 
-    if (signal.smallerAtCenterFrequency(minPowerLevel)) {
+    if (underMinPowerLevel) {
 
         // annotate the frame, so that we won't try decoding it at its end
         frame->setUnderMinPowerLevel(true);
@@ -68,21 +84,28 @@ simtime_t Decider80211p::processNewSignal(AirFrame* msg)
         if (phy11p->getRadioState() == Radio::TX) {
             frame->setBitError(true);
             frame->setWasTransmitting(true);
-            EV_TRACE << "AirFrame: " << frame->getId() << " (" << recvPower << ") received, while already sending. Setting BitErrors to true" << std::endl;
+            VEINS_LOG_TRACE << "AirFrame: " << frame->getId() << " (" << recvPower << ") received, while already sending. Setting BitErrors to true" << std::endl;
         }
         else {
 
-            if (!currentSignal.first) {
+            if (frame->getMissedStart()) {
+                // the radio could not sync to this frame at its start, so it is only interference
+                VEINS_LOG_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Start missed. Treating AirFrame as interference." << std::endl;
+            }
+            else if (!currentSignal.first) {
                 // NIC is not yet synced to any frame, so lock and try to decode this frame
                 currentSignal.first = frame;
-                EV_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Trying to receive AirFrame." << std::endl;
+                if (incrementalSinr) {
+                    startSinrTracking(frame);
+                }
+                VEINS_LOG_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Trying to receive AirFrame." << std::endl;
                 if (notifyRxStart) {
-                    phy->sendControlMsgToMac(new cMessage("RxStartStatus", MacToPhyInterface::PHY_RX_START));
+                    phy->sendControlMsgToMac(phy->createControlMsg("RxStartStatus", MacToPhyInterface::PHY_RX_START));
                 }
             }
             else {
                 // NIC is currently trying to decode another frame. this frame will be simply treated as interference
-                EV_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Already synced to another AirFrame. Treating AirFrame as interference." << std::endl;
+                VEINS_LOG_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Already synced to another AirFrame. Treating AirFrame as interference." << std::endl;
             }
 
             // channel turned busy
@@ -95,19 +118,100 @@ simtime_t Decider80211p::processNewSignal(AirFrame* msg)
 
 int Decider80211p::getSignalState(AirFrame* frame)
 {
+    for (const auto& inFlight : inFlightFrames) {
+        if (inFlight.frame == frame) return inFlight.state;
+    }
+    return NEW;
+}
 
-    if (signalStates.find(frame) == signalStates.end()) {
-        return NEW;
+void Decider80211p::startSinrTracking(AirFrame* frame)
+{
+    const Signal& signal = frame->getSignal();
+    trackedStart = signal.getReceptionStart() + PHY_HDR_PREAMBLE_DURATION; // see checkIfSignalOk
+    numTrackedInterferers = 0;
+    trackedInterference.assign(signal.getDataEnd() - signal.getDataStart(), 0);
+
+    double minPower = INFINITY;
+    for (size_t i = signal.getDataStart(); i < signal.getDataEnd(); i++) {
+        minPower = std::min(minPower, signal.at(i));
     }
-    else {
-        return signalStates[frame];
+    trackedMinPower = minPower;
+    trackedMinSnr = minPower / phy->getNoiseFloorValue();
+    trackedMinSinr = trackedMinSnr;
+
+    // frames already on the channel, in order of their reception start
+    for (const auto& inFlight : inFlightFrames) {
+        if (inFlight.frame != frame) trackInterferer(inFlight.frame);
+    }
+}
+
+void Decider80211p::trackInterferer(AirFrame* interfererFrame)
+{
+    // same sweep as SignalUtils::evaluateReception(), advanced by one interferer at a time
+    AirFrame* frame = currentSignal.first;
+    if (interfererFrame->getTreeId() == frame->getTreeId()) return;
+
+    const Signal& signal = frame->getSignal();
+    const Signal& interferer = interfererFrame->getSignal();
+    const simtime_t now = interferer.getReceptionStart();
+    if (interferer.getReceptionEnd() <= trackedStart || now >= signal.getReceptionEnd()) return;
+    ASSERT(interferer.getSpectrum() == signal.getSpectrum());
+
+    const size_t dataStart = signal.getDataStart();
+    const size_t numDataValues = trackedInterference.size();
+
+    // forget interferers that ended before this one started
+    for (size_t k = 0; k < numTrackedInterferers;) {
+        TrackedInterferer& ended = trackedInterferers[k];
+        if (ended.end > now) {
+            k++;
+            continue;
+        }
+        for (size_t i = 0; i < numDataValues; i++) {
+            trackedInterference[i] -= ended.power[i];
+        }
+        std::swap(ended, trackedInterferers[--numTrackedInterferers]);
+    }
+
+    // slots (and their power vectors) are reused for later interferers
+    if (numTrackedInterferers == trackedInterferers.size()) {
+        trackedInterferers.emplace_back();
+    }
+    TrackedInterferer& tracked = trackedInterferers[numTrackedInterferers++];
+    tracked.end = interferer.getReceptionEnd();
+    tracked.power.resize(numDataValues);
+    for (size_t i = 0; i < numDataValues; i++) {
+        tracked.power[i] = interferer.at(dataStart + i);
+        trackedInterference[i] += tracked.power[i];
+    }
+
+    // the interference only grew where the new interferer has data
+    const double noise = phy->getNoiseFloorValue();
+    const size_t from = std::max(interferer.getDataStart(), dataStart);
+    const size_t to = std::min(interferer.getDataEnd(), signal.getDataEnd());
+    for (size_t spectrumIndex = from; spectrumIndex < to; spectrumIndex++) {
+        trackedMinSinr = std::min(trackedMinSinr, signal.at(spectrumIndex) / (trackedInterference[spectrumIndex - dataStart] + noise));
     }
 }
 
 DeciderResult* Decider80211p::checkIfSignalOk(AirFrame* frame)
 {
+    VEINS_PROFILE_SCOPE("Decider80211p::checkIfSignalOk");
     auto frame11p = check_and_cast<AirFrame11p*>(frame);
 
+    if (incrementalSinr) {
+        ASSERT(frame == currentSignal.first);
+        const Signal& s = frame->getSignal();
+        double sinrMin = trackedMinSinr;
+        const double farField = phy->getFarFieldInterference(trackedStart, s.getReceptionEnd(), s.getSpectrum().freqAt(s.getCenterFrequencyIndex()));
+        if (farField > 0) {
+            // lower bound, as if the weakest value of the frame met the strongest interference
+            sinrMin = 1 / (1 / trackedMinSinr + farField / trackedMinPower);
+        }
+        // see below for why the SNR is only needed for collision statistics
+        return decideReception(frame11p, sinrMin, collectCollisionStats ? trackedMinSnr : 1e200);
+    }
+
     Signal& s = frame->getSignal();
     simtime_t start = s.getReceptionStart();
     simtime_t end = s.getReceptionEnd();
@@ -115,16 +219,18 @@ DeciderResult* Decider80211p::checkIfSignalOk(AirFrame* frame)
     start = start + PHY_HDR_PREAMBLE_DURATION; // its ok if something in the training phase is broken
 
     AirFrameVector airFrames;
-    getChannelInfo(start, end, airFrames);
+    getChannelInfoInBand(start, end, s.getSpectrum().freqAt(s.getDataStart()), s.getSpectrum().freqAt(s.getDataEnd() - 1), airFrames);
 
-    double noise = phy->getNoiseFloorValue();
+    // far field interference is taken as constant noise at its strongest during the frame
+    double noise = phy->getNoiseFloorValue() + phy->getFarFieldInterference(start, end, s.getSpectrum().freqAt(s.getCenterFrequencyIndex()));
 
     // Make sure to use the adjusted starting-point (which ignores the preamble)
-    double sinrMin = SignalUtils::getMinSINR(start, end, frame, airFrames, noise);
+    // SINR and SNR are obtained from a single pass over the data interval
+    const SignalUtils::ReceptionEvaluation evaluation = SignalUtils::evaluateReception(start, end, frame, airFrames, noise);
+    double sinrMin = evaluation.minSinr;
     double snrMin;
     if (collectCollisionStats) {
-        // snrMin = SignalUtils::getMinSNR(start, end, frame, noise);
-        snrMin = s.getDataMin() / noise;
+        snrMin = evaluation.minSnr;
     }
     else {
         // just set to any value. if collectCollisionStats != true
@@ -132,7 +238,14 @@ DeciderResult* Decider80211p::checkIfSignalOk(AirFrame* frame)
         snrMin = 1e200;
     }
 
-    double payloadBitrate = getOfdmDatarate(static_cast<MCS>(frame11p->getMcs()), BANDWIDTH_11P);
+    return decideReception(frame11p, sinrMin, snrMin);
+}
+
+DeciderResult* Decider80211p::decideReception(AirFrame11p* frame, double sinrMin, double snrMin)
+{
+    const Signal& s = frame->getSignal();
+
+    double payloadBitrate = OfdmTiming80211p::datarate(static_cast<MCS>(frame->getMcs()));
 
     DeciderResult80211* result = nullptr;
 
@@ -142,22 +255,22 @@ DeciderResult* Decider80211p::checkIfSignalOk(AirFrame* frame)
     switch (packetOk(sinrMin, snrMin, frame->getBitLength(), payloadBitrate)) {
 
     case DECODED:
-        EV_TRACE << "Packet is fine! We can decode it" << std::endl;
+        VEINS_LOG_TRACE << "Packet is fine! We can decode it" << std::endl;
         result = new DeciderResult80211(true, payloadBitrate, sinrMin, recvPower_dBm, false);
         break;
 
     case NOT_DECODED:
         if (!collectCollisionStats) {
-            EV_TRACE << "Packet has bit Errors. Lost " << std::endl;
+            VEINS_LOG_TRACE << "Packet has bit Errors. Lost " << std::endl;
         }
         else {
-            EV_TRACE << "Packet has bit Errors due to low power. Lost " << std::endl;
+            VEINS_LOG_TRACE << "Packet has bit Errors due to low power. Lost " << std::endl;
         }
         result = new DeciderResult80211(false, payloadBitrate, sinrMin, recvPower_dBm, false);
         break;
 
     case COLLISION:
-        EV_TRACE << "Packet has bit Errors due to collision. Lost " << std::endl;
+        VEINS_LOG_TRACE << "Packet has bit Errors due to collision. Lost " << std::endl;
         collisions++;
         result = new DeciderResult80211(false, payloadBitrate, sinrMin, recvPower_dBm, true);
         break;
@@ -170,23 +283,38 @@ DeciderResult* Decider80211p::checkIfSignalOk(AirFrame* frame)
     return result;
 }
 
+double Decider80211p::getChunkSuccessRate(unsigned int datarate, double snr_mW, uint32_t nbits) const
+{
+    if (useTabulatedErrorRate) {
+        return TabulatedErrorRate::getChunkSuccessRate(datarate, BANDWIDTH_11P, snr_mW, nbits);
+    }
+    return NistErrorRate::getChunkSuccessRate(datarate, BANDWIDTH_11P, snr_mW, nbits);
+}
+
 enum Decider80211p::PACKET_OK_RESULT Decider80211p::packetOk(double sinrMin, double snrMin, int lengthMPDU, double bitrate)
 {
+    // fast path: far above or below the range where the outcome is uncertain (the SNR is never below the SINR)
+    if (decisionEpsilon > 0) {
+        const DecisionBounds& bounds = getDecisionBounds(lengthMPDU, bitrate);
+        if (sinrMin >= bounds.acceptSinr) return DECODED;
+        if (sinrMin <= bounds.rejectSinr && (!collectCollisionStats || snrMin <= bounds.rejectSinr)) return NOT_DECODED;
+    }
+
     double packetOkSinr;
     double packetOkSnr;
 
     // compute success rate depending on mcs and bw
-    packetOkSinr = NistErrorRate::getChunkSuccessRate(bitrate, BANDWIDTH_11P, sinrMin, PHY_HDR_SERVICE_LENGTH + lengthMPDU + PHY_TAIL_LENGTH);
+    packetOkSinr = getChunkSuccessRate(bitrate, sinrMin, PHY_HDR_SERVICE_LENGTH + lengthMPDU + PHY_TAIL_LENGTH);
 
     // check if header is broken
-    double headerNoError = NistErrorRate::getChunkSuccessRate(PHY_HDR_BITRATE, BANDWIDTH_11P, sinrMin, PHY_HDR_PLCPSIGNAL_LENGTH);
+    double headerNoError = getChunkSuccessRate(PHY_HDR_BITRATE, sinrMin, PHY_HDR_PLCPSIGNAL_LENGTH);
 
     double headerNoErrorSnr;
     // compute PER also for SNR only
     if (collectCollisionStats) {
 
-        packetOkSnr = NistErrorRate::getChunkSuccessRate(bitrate, BANDWIDTH_11P, snrMin, PHY_HDR_SERVICE_LENGTH + lengthMPDU + PHY_TAIL_LENGTH);
-        headerNoErrorSnr = NistErrorRate::getChunkSuccessRate(PHY_HDR_BITRATE, BANDWIDTH_11P, snrMin, PHY_HDR_PLCPSIGNAL_LENGTH);
+        packetOkSnr = getChunkSuccessRate(bitrate, snrMin, PHY_HDR_SERVICE_LENGTH + lengthMPDU + PHY_TAIL_LENGTH);
+        headerNoErrorSnr = getChunkSuccessRate(PHY_HDR_BITRATE, snrMin, PHY_HDR_PLCPSIGNAL_LENGTH);
 
         // the probability of correct reception without considering the interference
         // MUST be greater or equal than when consider it
@@ -249,13 +377,145 @@ enum Decider80211p::PACKET_OK_RESULT Decider80211p::packetOk(double sinrMin, dou
     }
 }
 
+const Decider80211p::DecisionBounds& Decider80211p::getDecisionBounds(int lengthMPDU, double bitrate)
+{
+    const uint64_t key = (static_cast<uint64_t>(bitrate / 1000) << 32) | static_cast<uint32_t>(lengthMPDU);
+    auto it = decisionBounds.find(key);
+    if (it != decisionBounds.end()) return it->second;
+
+    // probability of decoding both the PLCP header and the rest of the frame, as drawn by packetOk()
+    auto successRate = [&](double sinr_dB) {
+        const double sinr = pow(10, sinr_dB / 10);
+        return getChunkSuccessRate(bitrate, sinr, PHY_HDR_SERVICE_LENGTH + lengthMPDU + PHY_TAIL_LENGTH) * getChunkSuccessRate(PHY_HDR_BITRATE, sinr, PHY_HDR_PLCPSIGNAL_LENGTH);
+    };
+
+    // the success rate grows with the SINR, so both bounds are found by bisection (keeping the side where they hold)
+    const double minSinr_dB = -30;
+    const double maxSinr_dB = 60;
+    const int iterations = 40;
+    DecisionBounds bounds{INFINITY, -INFINITY};
+    if (1 - successRate(maxSinr_dB) <= decisionEpsilon) {
+        double lo = minSinr_dB;
+        double hi = maxSinr_dB;
+        for (int i = 0; i < iterations; i++) {
+            const double mid = (lo + hi) / 2;
+            if (1 - successRate(mid) <= decisionEpsilon) {
+                hi = mid;
+            }
+            else {
+                lo = mid;
+            }
+        }
+        bounds.acceptSinr = pow(10, hi / 10);
+    }
+    if (successRate(minSinr_dB) <= decisionEpsilon) {
+        double lo = minSinr_dB;
+        double hi = maxSinr_dB;
+        for (int i = 0; i < iterations; i++) {
+            const double mid = (lo + hi) / 2;
+            if (successRate(mid) <= decisionEpsilon) {
+                lo = mid;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        bounds.rejectSinr = pow(10, lo / 10);
+    }
+    VEINS_LOG_TRACE << "SINR bounds for " << lengthMPDU << " bits at " << bitrate << " bit/s: reject at or below " << bounds.rejectSinr << ", accept at or above " << bounds.acceptSinr << std::endl;
+    return decisionBounds.emplace(key, bounds).first->second;
+}
+
 bool Decider80211p::cca(simtime_t_cref time, AirFrame* exclude)
+{
+    // far field interference is left out: it changes without an AirFrame starting or ending, so it could not end a busy period it caused
+    const double noise = phy->getNoiseFloorValue();
+
+    if (incrementalSinr) {
+        // analogue models were applied on arrival, so receivedPowerSum is exact (and there is no ChannelInfo to fall back to)
+        ASSERT(time == simTime());
+        double power = 0;
+        if (!receivedPowerSum.empty()) {
+            size_t usedFreqIndex = receivedPowerSpectrum.indexOf(centerFrequency - 5e6);
+            power = receivedPowerSum[usedFreqIndex];
+            auto excluded = receivedPowerContributions.find(exclude);
+            if (excluded != receivedPowerContributions.end()) {
+                power -= excluded->second.at(usedFreqIndex);
+            }
+        }
+        return power < ccaThreshold - noise;
+    }
+
+    // fast path: receivedPowerSum is an upper bound of the power on the channel right now
+    // (assuming all frames on the channel are passed to this decider)
+    if (time == simTime() && !receivedPowerSum.empty()) {
+        // same frequency as evaluateCca()
+        size_t usedFreqIndex = receivedPowerSpectrum.indexOf(centerFrequency - 5e6);
+        double maxPower = receivedPowerSum[usedFreqIndex];
+        auto excluded = receivedPowerContributions.find(exclude);
+        if (excluded != receivedPowerContributions.end()) {
+            maxPower -= excluded->second.at(usedFreqIndex);
+        }
+        if (maxPower < ccaThreshold - noise) {
+            // cross-check against the full evaluation (debug builds only)
+            ASSERT(evaluateCca(time, exclude));
+            return true;
+        }
+    }
+
+    return evaluateCca(time, exclude);
+}
+
+void Decider80211p::addReceivedPower(AirFrame* frame)
+{
+    const Signal& signal = frame->getSignal();
+    if (receivedPowerSum.empty()) {
+        receivedPowerSpectrum = signal.getSpectrum();
+        receivedPowerSum.assign(signal.getNumValues(), 0);
+    }
+    auto& contribution = receivedPowerContributions.emplace(frame, signal).first->second;
+    accumulateReceivedPower(contribution, 1);
+}
+
+void Decider80211p::removeReceivedPower(AirFrame* frame)
+{
+    auto it = receivedPowerContributions.find(frame);
+    if (it == receivedPowerContributions.end()) return;
+
+    accumulateReceivedPower(it->second, -1);
+    receivedPowerContributions.erase(it);
+
+    // start over from exact zero to not accumulate rounding errors
+    if (receivedPowerContributions.empty()) {
+        std::fill(receivedPowerSum.begin(), receivedPowerSum.end(), 0);
+    }
+}
+
+void Decider80211p::refreshReceivedPower(AirFrame* frame)
+{
+    auto it = receivedPowerContributions.find(frame);
+    if (it == receivedPowerContributions.end()) return;
+
+    accumulateReceivedPower(it->second, -1);
+    it->second = frame->getSignal();
+    accumulateReceivedPower(it->second, 1);
+}
+
+void Decider80211p::accumulateReceivedPower(const Signal& contribution, double sign)
+{
+    ASSERT(contribution.getNumValues() == receivedPowerSum.size());
+    for (size_t i = 0; i < receivedPowerSum.size(); i++) {
+        receivedPowerSum[i] += sign * contribution.at(i);
+    }
+}
+
+bool Decider80211p::evaluateCca(simtime_t_cref time, AirFrame* exclude)
 {
 
     AirFrameVector airFrames;
 
-    // collect all AirFrames that intersect with [start, end]
-    getChannelInfo(time, time, airFrames);
+    // collect all AirFrames that intersect with [start, end] and have power at the frequency checked below
+    getChannelInfoInBand(time, time, centerFrequency - 5e6, centerFrequency - 5e6, airFrames);
 
     // In the reference implementation only centerFrequenvy - 5e6 (half bandwidth) is checked!
     // Although this is wrong, the same is done here to reproduce original results
@@ -264,6 +524,11 @@ bool Decider80211p::cca(simtime_t_cref time, AirFrame* exclude)
     if (airFrames.size() > 0) {
         size_t usedFreqIndex = airFrames.front()->getSignal().getSpectrum().indexOf(centerFrequency - 5e6);
         isChannelIdle = SignalUtils::isChannelPowerBelowThreshold(time, airFrames, usedFreqIndex, ccaThreshold - minPower, exclude);
+
+        // analogue models might have been applied, tighten the cached upper bound
+        for (auto frame : airFrames) {
+            refreshReceivedPower(frame);
+        }
     }
 
     return isChannelIdle;
@@ -282,18 +547,23 @@ simtime_t Decider80211p::processSignalEnd(AirFrame* msg)
     bool whileSending = false;
 
     // remove this frame from our current signals
-    signalStates.erase(frame);
+    auto inFlight = std::find_if(inFlightFrames.begin(), inFlightFrames.end(), [frame](const InFlightFrame& x) { return x.frame == frame; });
+    if (inFlight != inFlightFrames.end()) inFlightFrames.erase(inFlight);
+    removeReceivedPower(frame);
 
     DeciderResult* result;
+    ReceptionRecord::Outcome outcome;
 
     if (frame->getUnderMinPowerLevel()) {
         // this frame was not even detected by the radio card
         result = new DeciderResult80211(false, 0, 0, recvPower_dBm);
+        outcome = ReceptionRecord::Outcome::undetected;
     }
     else if (frame->getWasTransmitting() || phy11p->getRadioState() == Radio::TX) {
         // this frame was received while sending
         whileSending = true;
         result = new DeciderResult80211(false, 0, 0, recvPower_dBm);
+        outcome = ReceptionRecord::Outcome::whileSending;
     }
     else {
 
@@ -302,6 +572,12 @@ simtime_t Decider80211p::processSignalEnd(AirFrame* msg)
             // check if the snr is above the Decider's specific threshold,
             // i.e. the Decider has received it correctly
             result = checkIfSignalOk(frame);
+            if (result->isSignalCorrect()) {
+                outcome = ReceptionRecord::Outcome::received;
+            }
+            else {
+                outcome = static_cast<DeciderResult80211*>(result)->isCollision() ? ReceptionRecord::Outcome::collision : ReceptionRecord::Outcome::bitError;
+            }
 
             // after having tried to decode the frame, the NIC is no more synced to the frame
             // and it is ready for syncing on a new one
@@ -310,54 +586,67 @@ simtime_t Decider80211p::processSignalEnd(AirFrame* msg)
         else {
             // if this is not the frame we are synced on, we cannot receive it
             result = new DeciderResult80211(false, 0, 0, recvPower_dBm);
+            outcome = ReceptionRecord::Outcome::notSynced;
         }
     }
 
+    if (receptionRecorder) {
+        auto result80211 = static_cast<DeciderResult80211*>(result);
+        ReceptionRecord record;
+        record.receiverId = owner->getId();
+        record.senderId = frame->getSenderModuleId();
+        record.time = simTime().raw();
+        record.rssi_dBm = result80211->getRecvPower_dBm();
+        record.sinr_dB = 10 * log10(result80211->getSnr());
+        record.outcome = outcome;
+        receptionRecorder->record(record, frame->getTreeId());
+    }
+
     if (result->isSignalCorrect()) {
-        EV_TRACE << "packet was received correctly, it is now handed to upper layer...\n";
+        VEINS_LOG_TRACE << "packet was received correctly, it is now handed to upper layer...\n";
         // go on with processing this AirFrame, send it to the Mac-Layer
         if (notifyRxStart) {
-            phy->sendControlMsgToMac(new cMessage("RxStartStatus", MacToPhyInterface::PHY_RX_END_WITH_SUCCESS));
+            phy->sendControlMsgToMac(phy->createControlMsg("RxStartStatus", MacToPhyInterface::PHY_RX_END_WITH_SUCCESS));
         }
         phy->sendUp(frame, result);
     }
     else {
         if (frame->getUnderMinPowerLevel()) {
-            EV_TRACE << "packet was not detected by the card. power was under minPowerLevel threshold\n";
+            VEINS_LOG_TRACE << "packet was not detected by the card. power was under minPowerLevel threshold\n";
         }
         else if (whileSending) {
-            EV_TRACE << "packet was received while sending, sending it as control message to upper layer\n";
-            phy->sendControlMsgToMac(new cMessage("Error", RECWHILESEND));
+            VEINS_LOG_TRACE << "packet was received while sending, sending it as control message to upper layer\n";
+            phy->sendControlMsgToMac(phy->createControlMsg("Error", RECWHILESEND));
         }
         else {
-            EV_TRACE << "packet was not received correctly, sending it as control message to upper layer\n";
+            VEINS_LOG_TRACE << "packet was not received correctly, sending it as control message to upper layer\n";
             if (notifyRxStart) {
-                phy->sendControlMsgToMac(new cMessage("RxStartStatus", MacToPhyInterface::PHY_RX_END_WITH_FAILURE));
+                phy->sendControlMsgToMac(phy->createControlMsg("RxStartStatus", MacToPhyInterface::PHY_RX_END_WITH_FAILURE));
             }
 
             if (((DeciderResult80211*) result)->isCollision()) {
-                phy->sendControlMsgToMac(new cMessage("Error", Decider80211p::COLLISION));
+                phy->sendControlMsgToMac(phy->createControlMsg("Error", Decider80211p::COLLISION));
             }
             else {
-                phy->sendControlMsgToMac(new cMessage("Error", BITERROR));
+                phy->sendControlMsgToMac(phy->createControlMsg("Error", BITERROR));
             }
         }
         delete result;
     }
 
     if (phy11p->getRadioState() == Radio::TX) {
-        EV_TRACE << "I'm currently sending\n";
+        VEINS_LOG_TRACE << "I'm currently sending\n";
     }
     // check if channel is idle now
     // we declare channel busy if CCA tells us so, or if we are currently
     // decoding a frame
     else if (cca(simTime(), frame) == false || currentSignal.first != 0) {
-        EV_TRACE << "Channel not yet idle!\n";
+        VEINS_LOG_TRACE << "Channel not yet idle!\n";
     }
     else {
         // might have been idle before (when the packet rxpower was below sens)
         if (isChannelIdle != true) {
-            EV_TRACE << "Channel idle now!\n";
+            VEINS_LOG_TRACE << "Channel idle now!\n";
             setChannelIdleStatus(true);
         }
     }
@@ -368,9 +657,9 @@ void Decider80211p::setChannelIdleStatus(bool isIdle)
 {
     isChannelIdle = isIdle;
     if (isIdle)
-        phy->sendControlMsgToMac(new cMessage("ChannelStatus", Mac80211pToPhy11pInterface::CHANNEL_IDLE));
+        phy->sendControlMsgToMac(phy->createControlMsg("ChannelStatus", Mac80211pToPhy11pInterface::CHANNEL_IDLE));
     else
-        phy->sendControlMsgToMac(new cMessage("ChannelStatus", Mac80211pToPhy11pInterface::CHANNEL_BUSY));
+        phy->sendControlMsgToMac(phy->createControlMsg("ChannelStatus", Mac80211pToPhy11pInterface::CHANNEL_BUSY));
 }
 
 void Decider80211p::changeFrequency(double freq)
@@ -388,6 +677,22 @@ void Decider80211p::setCCAThreshold(double ccaThreshold_dBm)
     ccaThreshold = pow(10, ccaThreshold_dBm / 10);
 }
 
+void Decider80211p::setUseTabulatedErrorRate(bool enable)
+{
+    useTabulatedErrorRate = enable;
+    decisionBounds.clear();
+    if (useTabulatedErrorRate) {
+        TabulatedErrorRate::initialize();
+    }
+}
+
+void Decider80211p::setDecisionEpsilon(double epsilon)
+{
+    if (epsilon < 0 || epsilon >= 0.5) throw cRuntimeError("Decider80211p: decisionEpsilon must be in [0, 0.5)");
+    decisionEpsilon = epsilon;
+    decisionBounds.clear();
+}
+
 void Decider80211p::setNotifyRxStart(bool enable)
 {
     notifyRxStart = enable;
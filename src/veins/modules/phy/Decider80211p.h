@@ -24,15 +24,21 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "veins/base/phyLayer/BaseDecider.h"
+#include "veins/base/toolbox/Signal.h"
 #include "veins/modules/utility/Consts80211p.h"
 #include "veins/modules/mac/ieee80211p/Mac80211pToPhy11pInterface.h"
 #include "veins/modules/phy/Decider80211pToPhy80211pInterface.h"
+#include "veins/modules/utility/ReceptionRecorder.h"
 
 namespace veins {
 
 using veins::AirFrame;
 
+class AirFrame11p;
+
 /**
  * @brief
  * Based on Decider80211.h from Karl Wessel
@@ -106,7 +112,35 @@ protected:
 
     std::string myPath;
     Decider80211pToPhy80211pInterface* phy11p;
-    std::map<AirFrame*, int> signalStates;
+
+    /** @brief State of a frame passed to this decider and not yet ended */
+    struct InFlightFrame {
+        AirFrame* frame;
+        int state;
+    };
+
+    /**
+     * @brief Frames passed to this decider and not yet ended, in order of arrival (and, thus, of reception start).
+     *
+     * Only a handful of frames overlap at any time, so a linear scan beats a map.
+     */
+    std::vector<InFlightFrame> inFlightFrames;
+
+    /**
+     * @brief Received power of all frames passed to this decider and not yet ended, summed up per frequency.
+     *
+     * Each frame contributes its power as last evaluated. Analogue models applied later
+     * (during thresholding) never increase power, so this is an upper bound of the power
+     * currently on the channel and lets cca() declare the channel idle with a single comparison.
+     * Accumulated in double, even if Signal stores its values as float.
+     */
+    std::vector<double> receivedPowerSum;
+
+    /** @brief The spectrum the values of receivedPowerSum belong to */
+    Spectrum receivedPowerSpectrum;
+
+    /** @brief The contribution of each frame to receivedPowerSum */
+    std::map<AirFrame*, Signal> receivedPowerContributions;
 
     /** @brief enable/disable statistics collection for collisions
      *
@@ -122,6 +156,66 @@ protected:
     /** @brief notify PHY-RXSTART.indication  */
     bool notifyRxStart;
 
+    /** @brief use TabulatedErrorRate instead of NistErrorRate to compute chunk success rates */
+    bool useTabulatedErrorRate = false;
+
+    /**
+     * @brief probability of a wrong outcome up to which packetOk() decides by SINR bounds alone (0: always draw)
+     *
+     * For each bitrate and frame length, the SINR above which a frame is decoded with a probability of at least
+     * 1 - decisionEpsilon, and the one below which it is decoded with a probability of at most decisionEpsilon,
+     * are computed once. Frames outside these bounds are decided without evaluating error rates or drawing random numbers
+     * (which shifts the random number stream against a run without bounds).
+     */
+    double decisionEpsilon = 0;
+
+    /** @brief SINRs (in mW) around the range in which the outcome of a reception is uncertain, see decisionEpsilon */
+    struct DecisionBounds {
+        double acceptSinr; ///< decode frames at or above (INFINITY: never)
+        double rejectSinr; ///< lose frames at or below (-INFINITY: never)
+    };
+
+    /** @brief DecisionBounds computed so far, by bitrate (in kbit/s, upper 32 bits) and MPDU length (lower 32 bits) */
+    std::unordered_map<uint64_t, DecisionBounds> decisionBounds;
+
+    /** @brief where to report processed receptions to (if any) */
+    ReceptionRecorder* receptionRecorder = nullptr;
+
+    /**
+     * @brief track the minimum SINR of the frame currently synced to while its interferers arrive
+     *
+     * If set, analogue models are applied to every frame on arrival, the minimum SINR of the
+     * synced frame is updated with each interferer, and the decision at its end no longer looks
+     * at the frames that overlapped it. Neither this nor cca() need the ChannelInfo then, so the
+     * phy drops frames when they end (see usesChannelInfo()).
+     * Results equal those of the full evaluation up to rounding, but analogue models are applied
+     * in a different order (which matters to models drawing random numbers).
+     */
+    bool incrementalSinr = false;
+
+    /** @brief An interferer of the synced frame, with its power over the data part of the synced frame */
+    struct TrackedInterferer {
+        simtime_t end;
+        std::vector<double> power;
+    };
+
+    /** @brief Interferers of the synced frame not yet ended at the start of the last one (only the first numTrackedInterferers are in use) */
+    std::vector<TrackedInterferer> trackedInterferers;
+    size_t numTrackedInterferers = 0;
+
+    /** @brief Summed power of the tracked interferers over the data part of the synced frame */
+    std::vector<double> trackedInterference;
+
+    /** @brief Start of the interval of the synced frame the SINR is tracked for (its preamble is ignored) */
+    simtime_t trackedStart;
+
+    /** @brief Minimum SINR and SNR over the data part of the synced frame so far */
+    double trackedMinSinr = 0;
+    double trackedMinSnr = 0;
+
+    /** @brief Minimum power over the data part of the synced frame (to account for far field interference, see checkIfSignalOk()) */
+    double trackedMinPower = 0;
+
 protected:
     /**
      * @brief Checks a mapping against a specific threshold (element-wise).
@@ -133,6 +227,13 @@ protected:
      */
     virtual DeciderResult* checkIfSignalOk(AirFrame* frame);
 
+    /**
+     * @brief Decides whether the passed frame is received, given the minimum SINR and SNR over its data part.
+     *
+     * The SNR is only used if collectCollisionStats is set, to tell collisions from bit errors.
+     */
+    DeciderResult* decideReception(AirFrame11p* frame, double sinrMin, double snrMin);
+
     simtime_t processNewSignal(AirFrame* frame) override;
 
     /**
@@ -146,9 +247,36 @@ protected:
      */
     simtime_t processSignalEnd(AirFrame* frame) override;
 
+    /** @brief Adds the current power of a new frame to receivedPowerSum */
+    virtual void addReceivedPower(AirFrame* frame);
+
+    /** @brief Removes the contribution of an ended frame from receivedPowerSum */
+    virtual void removeReceivedPower(AirFrame* frame);
+
+    /** @brief Adds (sign 1) or subtracts (sign -1) the given contribution to receivedPowerSum */
+    void accumulateReceivedPower(const Signal& contribution, double sign);
+
+    /** @brief Replaces the contribution of a frame in receivedPowerSum by its current (possibly further attenuated) power */
+    void refreshReceivedPower(AirFrame* frame);
+
+    /** @brief Starts tracking the SINR of a newly synced frame, accounting for all other frames already on the channel */
+    void startSinrTracking(AirFrame* frame);
+
+    /** @brief Updates the minimum SINR of the synced frame with a newly arrived interferer */
+    void trackInterferer(AirFrame* interferer);
+
+    /** @brief Full CCA evaluation of all frames on the channel, applying analogue models as needed */
+    bool evaluateCca(simtime_t_cref time, AirFrame* exclude);
+
+    /** @brief computes the probability of receiving a chunk of nbits without error, using NistErrorRate or TabulatedErrorRate */
+    double getChunkSuccessRate(unsigned int datarate, double snr_mW, uint32_t nbits) const;
+
     /** @brief computes if packet is ok or has errors*/
     enum PACKET_OK_RESULT packetOk(double snirMin, double snrMin, int lengthMPDU, double bitrate);
 
+    /** @brief returns (computing them on first use) the DecisionBounds of frames of the given length and bitrate */
+    const DecisionBounds& getDecisionBounds(int lengthMPDU, double bitrate);
+
 public:
     /**
      * @brief Initializes the Decider with a pointer to its PhyLayer and
@@ -174,7 +302,12 @@ public:
         this->myPath = myPath;
     }
 
-    bool cca(simtime_t_cref, AirFrame*);
+    /**
+     * @brief Returns whether the channel is idle at the passed time, not counting the passed frame (if any).
+     *
+     * Only AirFrames count, far field interference (see DeciderToPhyInterface::getFarFieldInterference()) lowers the SINR of receptions only.
+     */
+    virtual bool cca(simtime_t_cref, AirFrame*);
     int getSignalState(AirFrame* frame) override;
     ~Decider80211p() override;
 
@@ -192,6 +325,16 @@ public:
 
     void setChannelIdleStatus(bool isIdle) override;
 
+    /**
+     * @brief enables/disables the use of TabulatedErrorRate (precomputing its tables if needed)
+     */
+    void setUseTabulatedErrorRate(bool enable);
+
+    /**
+     * @brief sets the probability of a wrong outcome up to which receptions are decided by SINR bounds alone (see decisionEpsilon)
+     */
+    void setDecisionEpsilon(double epsilon);
+
     /**
      * @brief invoke this method when the phy layer is also finalized,
      * so that statistics recorded by the decider can be written to
@@ -210,10 +353,42 @@ public:
      */
     void switchToTx() override;
 
+    /**
+     * @brief AirFrames are only processed at their start and end.
+     */
+    bool needsIntermediateProcessing() const override
+    {
+        return false;
+    }
+
+    /**
+     * @brief The ChannelInfo is not needed when tracking the SINR incrementally.
+     */
+    bool usesChannelInfo() const override
+    {
+        return !incrementalSinr;
+    }
+
     /**
      * @brief notify PHY-RXSTART.indication
      */
     void setNotifyRxStart(bool enable);
+
+    /**
+     * @brief enables/disables incremental tracking of the SINR (see incrementalSinr)
+     */
+    void setIncrementalSinr(bool enable)
+    {
+        incrementalSinr = enable;
+    }
+
+    /**
+     * @brief sets the recorder to report each processed reception to (or nullptr for none)
+     */
+    void setReceptionRecorder(ReceptionRecorder* recorder)
+    {
+        receptionRecorder = recorder;
+    }
 };
 
 } // namespace veins
@@ -0,0 +1,112 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/phy/Decider80211pAbstract.h"
+
+#include <algorithm>
+
+#include "veins/modules/messages/AirFrame11p_m.h"
+
+using namespace veins;
+
+Decider80211pAbstract::Decider80211pAbstract(cComponent* owner, DeciderToPhyInterface* phy, double minPowerLevel, double ccaThreshold, bool allowTxDuringRx, double centerFrequency, simtime_t channelLoadInterval, int myIndex, bool collectCollisionStatistics)
+    : Decider80211p(owner, phy, minPowerLevel, ccaThreshold, allowTxDuringRx, centerFrequency, myIndex, collectCollisionStatistics)
+    , channelLoad(channelLoadInterval, simTime())
+{
+    // all the abstraction saves would be lost on computing error rates from scratch
+    setUseTabulatedErrorRate(true);
+}
+
+void Decider80211pAbstract::updateChannelLoad(simtime_t_cref now)
+{
+    if (channelLoadBusy && busyUntil <= now) {
+        channelLoad.setBusy(busyUntil, false);
+        channelLoadBusy = false;
+    }
+
+    const long numIntervals = channelLoad.getNumIntervals(now);
+    if (numIntervals != numLoadIntervals) {
+        // keep the last mean power if no frames started, the busy ratio then tells how much of it there was
+        if (busyDuration > 0) lastMeanBusyPower = busyEnergy / busyDuration;
+        busyEnergy = 0;
+        busyDuration = 0;
+        numLoadIntervals = numIntervals;
+    }
+}
+
+double Decider80211pAbstract::getInterferencePower(simtime_t_cref now)
+{
+    updateChannelLoad(now);
+    return channelLoad.getLastRatio(now) * lastMeanBusyPower;
+}
+
+DeciderResult* Decider80211pAbstract::checkIfSignalOk(AirFrame* frame)
+{
+    if (hybrid && phy11p->isHighFidelityReception()) return Decider80211p::checkIfSignalOk(frame);
+
+    auto frame11p = check_and_cast<AirFrame11p*>(frame);
+
+    Signal& s = frame->getSignal();
+    s.applyAllAnalogueModels();
+    const double recvPower = s.getAtCenterFrequency();
+
+    const double noise = phy->getNoiseFloorValue();
+    const double interference = getInterferencePower(simTime());
+
+    // see Decider80211p::checkIfSignalOk for why the SNR is only needed for collision statistics
+    const double sinr = recvPower / (noise + interference);
+    const double snr = collectCollisionStats ? recvPower / noise : 1e200;
+
+    return decideReception(frame11p, sinr, snr);
+}
+
+void Decider80211pAbstract::addReceivedPower(AirFrame* frame)
+{
+    const simtime_t now = simTime();
+    updateChannelLoad(now);
+
+    Signal& signal = frame->getSignal();
+    if (signal.smallerAtCenterFrequency(ccaThreshold - phy->getNoiseFloorValue())) return;
+
+    if (!channelLoadBusy) {
+        channelLoad.setBusy(now, true);
+        channelLoadBusy = true;
+    }
+    busyUntil = std::max(busyUntil, signal.getReceptionEnd());
+
+    signal.applyAllAnalogueModels();
+    const double duration = signal.getDuration().dbl();
+    busyEnergy += signal.getAtCenterFrequency() * duration;
+    busyDuration += duration;
+}
+
+void Decider80211pAbstract::removeReceivedPower(AirFrame* frame)
+{
+}
+
+bool Decider80211pAbstract::cca(simtime_t_cref time, AirFrame* exclude)
+{
+    updateChannelLoad(time);
+    // without the received power of frames tracked by Decider80211p::addReceivedPower, only the full evaluation applies
+    if (hybrid && phy11p->isHighFidelityReception()) return evaluateCca(time, exclude);
+    return phy->getNoiseFloorValue() < ccaThreshold && busyUntil <= time;
+}
@@ -0,0 +1,121 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins/modules/phy/Decider80211p.h"
+#include "veins/modules/utility/ChannelBusyRatio.h"
+
+namespace veins {
+
+/**
+ * @brief Abstracted (statistical) variant of Decider80211p for very large scenarios.
+ *
+ * Decides the reception of each frame from its received power and a tabulated
+ * error rate (see TabulatedErrorRate), without looking at the other AirFrames on
+ * the channel: the phy keeps none of them in its ChannelInfo (see usesChannelInfo()).
+ *
+ * Interference is modeled from the aggregate channel load instead: the channel
+ * busy ratio of the last measurement interval times the mean received power of
+ * the frames that kept the channel busy then. The channel counts as busy while
+ * any single frame is received with a power above the CCA threshold.
+ *
+ * Synchronization, reception while sending, signalling to the mac and
+ * statistics are those of Decider80211p.
+ *
+ * In hybrid mode (see setHybrid()), the phy keeps AirFrames in its ChannelInfo,
+ * and receptions (and CCA) are evaluated in full like Decider80211p does whenever
+ * the phy tells they are high fidelity (see Decider80211pToPhy80211pInterface::isHighFidelityReception()).
+ *
+ * @ingroup decider
+ *
+ * @see Decider80211p
+ * @see ChannelBusyRatio
+ */
+class VEINS_API Decider80211pAbstract : public Decider80211p {
+protected:
+    /** @brief Channel load seen by this decider, from the busy periods tracked by addReceivedPower() */
+    ChannelBusyRatio channelLoad;
+
+    /** @brief Whether channelLoad was last told the channel is busy */
+    bool channelLoadBusy = false;
+
+    /** @brief The end of the last frame received above the CCA threshold */
+    simtime_t busyUntil = 0;
+
+    /** @brief The number of intervals of channelLoad that had completed when it was last updated */
+    long numLoadIntervals = 0;
+
+    /** @brief Sum of received power times duration of the frames above the CCA threshold starting in the current interval */
+    double busyEnergy = 0;
+
+    /** @brief Sum of the durations of the frames above the CCA threshold starting in the current interval */
+    double busyDuration = 0;
+
+    /** @brief Mean received power of the frames above the CCA threshold in the last complete interval */
+    double lastMeanBusyPower = 0;
+
+    /** @brief Whether high fidelity receptions are evaluated in full */
+    bool hybrid = false;
+
+protected:
+    /** @brief Closes the busy period of channelLoad (if it ended) and the measurement intervals that completed before now */
+    void updateChannelLoad(simtime_t_cref now);
+
+    /** @brief Returns the interference power assumed for a frame received now */
+    double getInterferencePower(simtime_t_cref now);
+
+    /** @brief Decides from the received power of the frame and the interference assumed by getInterferencePower() */
+    DeciderResult* checkIfSignalOk(AirFrame* frame) override;
+
+    /** @brief Marks the channel busy until the end of the frame, if it is received above the CCA threshold */
+    void addReceivedPower(AirFrame* frame) override;
+
+    /** @brief Nothing to do, frames are not tracked individually */
+    void removeReceivedPower(AirFrame* frame) override;
+
+public:
+    /**
+     * @brief Initializes the Decider like Decider80211p, measuring channel load over intervals of the passed length.
+     */
+    Decider80211pAbstract(cComponent* owner, DeciderToPhyInterface* phy, double minPowerLevel, double ccaThreshold, bool allowTxDuringRx, double centerFrequency, simtime_t channelLoadInterval, int myIndex = -1, bool collectCollisionStatistics = false);
+
+    bool cca(simtime_t_cref time, AirFrame* exclude) override;
+
+    /**
+     * @brief Sets whether high fidelity receptions are evaluated in full (must be set before the first AirFrame arrives).
+     */
+    void setHybrid(bool enable)
+    {
+        hybrid = enable;
+    }
+
+    /**
+     * @brief Other AirFrames are only looked at in hybrid mode, otherwise the phy need not keep them.
+     */
+    bool usesChannelInfo() const override
+    {
+        return hybrid;
+    }
+};
+
+} // namespace veins
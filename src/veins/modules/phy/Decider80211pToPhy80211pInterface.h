@@ -36,6 +36,14 @@ class VEINS_API Decider80211pToPhy80211pInterface {
 public:
     virtual ~Decider80211pToPhy80211pInterface(){};
     virtual int getRadioState() = 0;
+
+    /**
+     * @brief Returns whether a reception right now is to be evaluated in full (rather than abstracted, see Decider80211pAbstract).
+     */
+    virtual bool isHighFidelityReception()
+    {
+        return true;
+    }
 };
 
 } // namespace veins
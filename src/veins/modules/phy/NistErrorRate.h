@@ -37,6 +37,18 @@ public:
 
     static double getChunkSuccessRate(unsigned int datarate, enum Bandwidth bw, double snr_mW, uint32_t nbits);
 
+    /**
+     * Return the probability of a bit error after decoding for the given MCS at the given SNR.
+     *
+     * A chunk of nbits bits is received correctly with probability (1 - getCodedBer())^nbits,
+     * this is what getChunkSuccessRate() computes.
+     *
+     * \param mcs the modulation and coding scheme
+     * \param snr_mW snr value
+     * \return the coded bit error rate (0 if the uncoded BER is 0)
+     */
+    static double getCodedBer(MCS mcs, double snr_mW);
+
 private:
     /**
      * Return the coded BER for the given p and b.
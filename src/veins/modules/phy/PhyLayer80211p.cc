@@ -27,7 +27,11 @@
 
 #include "veins/modules/phy/PhyLayer80211p.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "veins/modules/phy/Decider80211p.h"
+#include "veins/modules/phy/Decider80211pAbstract.h"
 #include "veins/modules/analogueModel/SimplePathlossModel.h"
 #include "veins/modules/analogueModel/BreakpointPathlossModel.h"
 #include "veins/modules/analogueModel/PERModel.h"
@@ -35,10 +39,13 @@
 #include "veins/modules/analogueModel/VehicleObstacleShadowing.h"
 #include "veins/modules/analogueModel/TwoRayInterferenceModel.h"
 #include "veins/modules/analogueModel/NakagamiFading.h"
+#include "veins/modules/analogueModel/CorrelatedShadowing.h"
 #include "veins/base/connectionManager/BaseConnectionManager.h"
 #include "veins/modules/utility/Consts80211p.h"
 #include "veins/modules/messages/AirFrame11p_m.h"
 #include "veins/modules/utility/MacToPhyControlInfo11p.h"
+#include "veins/base/modules/BaseMobility.h"
+#include "veins/base/utils/FindModule.h"
 
 using namespace veins;
 
@@ -46,14 +53,30 @@ using std::unique_ptr;
 
 Define_Module(veins::PhyLayer80211p);
 
+PhyLayer80211p::~PhyLayer80211p()
+{
+    for (auto frame : offChannelAirFrames) {
+        delete frame;
+    }
+}
+
 void PhyLayer80211p::initialize(int stage)
 {
     if (stage == 0) {
         // get ccaThreshold before calling BasePhyLayer::initialize() which instantiates the deciders
         ccaThreshold = pow(10, par("ccaThreshold").doubleValue() / 10);
         allowTxDuringRx = par("allowTxDuringRx").boolValue();
+        useTabulatedErrorRate = par("useTabulatedErrorRate").boolValue();
+        incrementalSinr = par("incrementalSinr").boolValue();
+        decisionEpsilon = par("decisionEpsilon").doubleValue();
+        skipUndecodableAirFrames = par("skipUndecodableAirFrames").boolValue();
         collectCollisionStatistics = par("collectCollisionStatistics").boolValue();
 
+        highFidelityRegion.addRectangles(par("highFidelityRects").stdstringValue());
+        highFidelityRegion.addPolygons(par("highFidelityPolygons").stdstringValue());
+        highFidelityRsus = cStringTokenizer(par("highFidelityRsus").stringValue()).asVector();
+        highFidelityRsuDistance = par("highFidelityRsuDistance").doubleValue();
+
         // Create frequency mappings and initialize spectrum for signal representation
         Spectrum::Frequencies freqs;
         for (auto& channel : IEEE80211ChannelFrequencies) {
@@ -64,6 +87,46 @@ void PhyLayer80211p::initialize(int stage)
         overallSpectrum = Spectrum(freqs);
     }
     BasePhyLayer::initialize(stage);
+    if (stage == 0) {
+        // a shared SimpleObstacleShadowing was created by another phy, so initializeSimpleObstacleShadowing did not run for this one
+        auto isObstacleShadowing = [](const std::shared_ptr<AnalogueModel>& model) { return dynamic_cast<SimpleObstacleShadowing*>(model.get()) != nullptr; };
+        if (!obstacleControl && (std::any_of(analogueModels.begin(), analogueModels.end(), isObstacleShadowing) || std::any_of(analogueModelsThresholding.begin(), analogueModelsThresholding.end(), isObstacleShadowing))) {
+            obstacleControl = ObstacleControlAccess().getIfExists();
+        }
+    }
+    if (stage == 1) {
+        // hosts with a plain BaseMobility never move, so obstacle attenuation of all their links can be precomputed
+        auto mobility = dynamic_cast<BaseMobility*>(findHost()->getSubmodule("mobility"));
+        if (obstacleControl && obstacleControl->usesVisibilityMaps() && mobility && std::string(mobility->getNedTypeName()) == "org.car2x.veins.base.modules.BaseMobility") {
+            // same antenna position as computed by ChannelAccess::receiveSignal
+            auto heading = Heading::fromCoord(mobility->getCurrentOrientation());
+            obstacleControl->addStaticNode(mobility->getPositionAt(simTime()) + antennaOffset.rotatedYaw(-heading.getRad()));
+        }
+    }
+}
+
+void PhyLayer80211p::resetForReuse(int stage)
+{
+    if (stage == 0) {
+        for (auto frame : offChannelAirFrames) {
+            delete frame;
+        }
+        offChannelAirFrames.clear();
+        numOffChannelAirFrames = 0;
+        numCaughtUpAirFrames = 0;
+        // might have been changed via setCCAThreshold(), the deciders are instantiated with it by BasePhyLayer::resetForReuse()
+        ccaThreshold = pow(10, par("ccaThreshold").doubleValue() / 10);
+    }
+    BasePhyLayer::resetForReuse(stage);
+}
+
+void PhyLayer80211p::finish()
+{
+    BasePhyLayer::finish();
+    if (skipUndecodableAirFrames) {
+        recordScalar("airFramesOffChannel", numOffChannelAirFrames);
+        recordScalar("airFramesOffChannelCaughtUp", numCaughtUpAirFrames);
+    }
 }
 
 unique_ptr<AnalogueModel> PhyLayer80211p::getAnalogueModelFromName(std::string name, ParameterMap& params)
@@ -91,6 +154,9 @@ unique_ptr<AnalogueModel> PhyLayer80211p::getAnalogueModelFromName(std::string n
     else if (name == "NakagamiFading") {
         return initializeNakagamiFading(params);
     }
+    else if (name == "CorrelatedShadowing") {
+        return initializeCorrelatedShadowing(params);
+    }
     return BasePhyLayer::getAnalogueModelFromName(name, params);
 }
 
@@ -142,11 +208,17 @@ unique_ptr<AnalogueModel> PhyLayer80211p::initializeBreakpointPathlossModel(Para
         // check whether alpha is not smaller than specified in ConnectionManager
     }
 
+    bool recordPathlosses = true;
+    it = params.find("recordPathlosses");
+    if (it != params.end()) {
+        recordPathlosses = it->second.boolValue();
+    }
+
     if (alpha1 == -1 || alpha2 == -1 || breakpointDistance == -1 || L01 == -1 || L02 == -1) {
         throw cRuntimeError("Undefined parameters for breakpointPathlossModel. Please check your configuration.");
     }
 
-    return make_unique<BreakpointPathlossModel>(this, L01, L02, alpha1, alpha2, breakpointDistance, useTorus, playgroundSize);
+    return make_unique<BreakpointPathlossModel>(this, L01, L02, alpha1, alpha2, breakpointDistance, useTorus, playgroundSize, recordPathlosses);
 }
 
 unique_ptr<AnalogueModel> PhyLayer80211p::initializeTwoRayInterferenceModel(ParameterMap& params)
@@ -165,7 +237,34 @@ unique_ptr<AnalogueModel> PhyLayer80211p::initializeNakagamiFading(ParameterMap&
     if (constM) {
         m = params["m"].doubleValue();
     }
-    return make_unique<NakagamiFading>(this, constM, m);
+    bool useCounterRng = false;
+    ParameterMap::iterator it = params.find("useCounterRng");
+    if (it != params.end()) {
+        useCounterRng = it->second.boolValue();
+    }
+    uint64_t counterRngSeed = useCounterRng ? CounterRng::drawSeed(getRNG(0)) : 0;
+    return make_unique<NakagamiFading>(this, constM, m, useCounterRng, counterRngSeed);
+}
+
+unique_ptr<AnalogueModel> PhyLayer80211p::initializeCorrelatedShadowing(ParameterMap& params)
+{
+    if (params.count("sigma") == 0 || params.count("decorrelationDistance") == 0) throw cRuntimeError("CorrelatedShadowing needs the parameters sigma and decorrelationDistance");
+    double sigma = params["sigma"].doubleValue();
+    double decorrelationDistance = params["decorrelationDistance"].doubleValue();
+    double resolution = params.count("resolution") ? params["resolution"].doubleValue() : decorrelationDistance / 4;
+    if (decorrelationDistance <= 0 || resolution <= 0) throw cRuntimeError("CorrelatedShadowing needs a positive decorrelationDistance and resolution");
+    const bool hasSeed = params.count("seed") != 0;
+    const uint64_t seed = hasSeed ? static_cast<uint64_t>(params["seed"].longValue()) : 0;
+    const Coord playgroundSize = *(world->getPgs());
+
+    // phys configured alike share one field (and its drawn seed)
+    std::ostringstream key;
+    key.precision(17);
+    key << playgroundSize.x << ' ' << playgroundSize.y << ' ' << resolution << ' ' << decorrelationDistance << ' ' << (hasSeed ? std::to_string(seed) : "auto");
+    auto field = phyConfigCache->getShadowingField(key.str(), [&]() {
+        return ShadowingField(playgroundSize, resolution, decorrelationDistance, hasSeed ? seed : CounterRng::drawSeed(getRNG(0)));
+    });
+    return make_unique<CorrelatedShadowing>(this, field, sigma);
 }
 
 unique_ptr<AnalogueModel> PhyLayer80211p::initializeSimplePathlossModel(ParameterMap& params)
@@ -220,6 +319,10 @@ unique_ptr<Decider> PhyLayer80211p::getDeciderFromName(std::string name, Paramet
         protocolId = IEEE_80211;
         return initializeDecider80211p(params);
     }
+    if (name == "Decider80211pAbstract") {
+        protocolId = IEEE_80211;
+        return initializeDecider80211pAbstract(params);
+    }
     return BasePhyLayer::getDeciderFromName(name, params);
 }
 
@@ -234,6 +337,7 @@ unique_ptr<AnalogueModel> PhyLayer80211p::initializeSimpleObstacleShadowing(Para
 
     ObstacleControl* obstacleControlP = ObstacleControlAccess().getIfExists();
     if (!obstacleControlP) throw cRuntimeError("initializeSimpleObstacleShadowing(): cannot find ObstacleControl module");
+    obstacleControl = obstacleControlP;
     return make_unique<SimpleObstacleShadowing>(this, *obstacleControlP, useTorus, playgroundSize);
 }
 
@@ -248,14 +352,49 @@ unique_ptr<AnalogueModel> PhyLayer80211p::initializeVehicleObstacleShadowing(Par
 
     VehicleObstacleControl* vehicleObstacleControlP = VehicleObstacleControlAccess().getIfExists();
     if (!vehicleObstacleControlP) throw cRuntimeError("initializeVehicleObstacleShadowing(): cannot find VehicleObstacleControl module");
-    return make_unique<VehicleObstacleShadowing>(this, *vehicleObstacleControlP, useTorus, playgroundSize);
+    auto model = make_unique<VehicleObstacleShadowing>(this, *vehicleObstacleControlP, useTorus, playgroundSize);
+
+    it = params.find("approximate");
+    if (it != params.end() && it->second.boolValue()) {
+        int maxObstacles = 0;
+        it = params.find("maxObstacles");
+        if (it != params.end()) maxObstacles = it->second.longValue();
+        if (maxObstacles < 0) throw cRuntimeError("initializeVehicleObstacleShadowing(): maxObstacles must not be negative");
+        bool dropBelowSensitivity = true;
+        it = params.find("dropBelowSensitivity");
+        if (it != params.end()) dropBelowSensitivity = it->second.boolValue();
+        model->setApproximation(maxObstacles, dropBelowSensitivity ? getReceptionPowerThreshold() : 0);
+    }
+    return unique_ptr<AnalogueModel>(std::move(model));
 }
 
 unique_ptr<Decider> PhyLayer80211p::initializeDecider80211p(ParameterMap& params)
 {
     double centerFreq = params["centerFrequency"];
+    listeningFrequency = centerFreq;
     auto dec = make_unique<Decider80211p>(this, this, minPowerLevel, ccaThreshold, allowTxDuringRx, centerFreq, findHost()->getIndex(), collectCollisionStatistics);
     dec->setPath(getParentModule()->getFullPath());
+    dec->setUseTabulatedErrorRate(useTabulatedErrorRate);
+    dec->setIncrementalSinr(incrementalSinr);
+    dec->setDecisionEpsilon(decisionEpsilon);
+    dec->setReceptionRecorder(ReceptionRecorder::find());
+    return unique_ptr<Decider>(std::move(dec));
+}
+
+unique_ptr<Decider> PhyLayer80211p::initializeDecider80211pAbstract(ParameterMap& params)
+{
+    double centerFreq = params["centerFrequency"];
+    listeningFrequency = centerFreq;
+    simtime_t channelLoadInterval = 0.1;
+    ParameterMap::iterator it = params.find("channelLoadInterval");
+    if (it != params.end()) {
+        channelLoadInterval = it->second.doubleValue();
+        if (channelLoadInterval <= 0) throw cRuntimeError("Decider80211pAbstract: channelLoadInterval must be positive");
+    }
+    auto dec = make_unique<Decider80211pAbstract>(this, this, minPowerLevel, ccaThreshold, allowTxDuringRx, centerFreq, channelLoadInterval, findHost()->getIndex(), collectCollisionStatistics);
+    dec->setPath(getParentModule()->getFullPath());
+    dec->setHybrid(hasHighFidelityRegion());
+    dec->setReceptionRecorder(ReceptionRecorder::find());
     return unique_ptr<Decider>(std::move(dec));
 }
 
@@ -266,6 +405,69 @@ void PhyLayer80211p::changeListeningChannel(Channel channel)
 
     double freq = IEEE80211ChannelFrequencies.at(channel);
     dec->changeFrequency(freq);
+    listeningFrequency = freq;
+
+    // frames set aside while tuned elsewhere may be on the new channel
+    if (!offChannelAirFrames.empty()) updateOffChannelAirFrames();
+}
+
+void PhyLayer80211p::handleAirFrameStartReceive(AirFrame* frame)
+{
+    auto frame11p = dynamic_cast<AirFrame11p*>(frame);
+    if (!skipUndecodableAirFrames || !frame11p) {
+        BasePhyLayer::handleAirFrameStartReceive(frame);
+        return;
+    }
+
+    if (!overlapsListeningChannel(frame->getSignal())) {
+        // neither decodable nor interference on this channel: no filtering unless the radio tunes to it before it ends
+        if (usePropagationDelay) {
+            Signal& s = frame->getSignal();
+            s.setPropagationDelay(simTime() - s.getSendingStart());
+        }
+        VEINS_LOG_TRACE << "AirFrame " << frame->getId() << " has no power in the listened channel, setting it aside." << endl;
+        updateOffChannelAirFrames();
+        offChannelAirFrames.push_back(frame11p);
+        numOffChannelAirFrames++;
+        return;
+    }
+
+    // while switching, the radio cannot sync to the frame, but it still interferes (and counts for CCA) once switching is done
+    if (getRadioState() == Radio::SWITCHING) frame11p->setMissedStart(true);
+    BasePhyLayer::handleAirFrameStartReceive(frame);
+}
+
+bool PhyLayer80211p::overlapsListeningChannel(const Signal& signal) const
+{
+    // the bins of two channels (center frequency +-5 MHz, see attachSignal()) overlap if their centers are at most 10 MHz apart
+    const double centerFrequency = signal.getSpectrum().freqAt(signal.getCenterFrequencyIndex());
+    return std::abs(centerFrequency - listeningFrequency) < 10e6 + 1;
+}
+
+void PhyLayer80211p::updateOffChannelAirFrames()
+{
+    std::vector<AirFrame11p*> tunedTo;
+    auto kept = offChannelAirFrames.begin();
+    for (auto frame : offChannelAirFrames) {
+        if (frame->getSignal().getReceptionEnd() <= simTime()) {
+            delete frame;
+        }
+        else if (overlapsListeningChannel(frame->getSignal())) {
+            tunedTo.push_back(frame);
+        }
+        else {
+            *kept++ = frame;
+        }
+    }
+    offChannelAirFrames.erase(kept, offChannelAirFrames.end());
+
+    // the radio missed their start, so they only interfere from now on
+    for (auto frame : tunedTo) {
+        VEINS_LOG_TRACE << "Tuned to the channel of AirFrame " << frame->getId() << ", receiving it as interference." << endl;
+        frame->setMissedStart(true);
+        numCaughtUpAirFrames++;
+        startReceiving(frame);
+    }
 }
 
 void PhyLayer80211p::handleSelfMessage(cMessage* msg)
@@ -275,7 +477,7 @@ void PhyLayer80211p::handleSelfMessage(cMessage* msg)
     // transmission overBasePhyLayer::
     case TX_OVER: {
         ASSERT(msg == txOverTimer);
-        sendControlMsgToMac(new cMessage("Transmission over", TX_OVER));
+        sendControlMsgToMac(createControlMsg("Transmission over", TX_OVER));
         // check if there is another packet on the chan, and change the chan-state to idle
         Decider80211p* dec = dynamic_cast<Decider80211p*>(decider.get());
         ASSERT(dec);
@@ -330,17 +532,55 @@ void PhyLayer80211p::attachSignal(AirFrame* airFrame, cObject* ctrlInfo)
     airFrame->setMcs(static_cast<int>(ctrlInfo11p->mcs));
 }
 
+simtime_t PhyLayer80211p::getTransmissionDuration(cPacket* macPkt, cObject* ctrlInfo) const
+{
+    const auto ctrlInfo11p = check_and_cast<MacToPhyControlInfo11p*>(ctrlInfo);
+    return getFrameDuration(macPkt->getBitLength(), ctrlInfo11p->mcs);
+}
+
 int PhyLayer80211p::getRadioState()
 {
     return BasePhyLayer::getRadioState();
 };
 
+bool PhyLayer80211p::hasHighFidelityRegion() const
+{
+    return highFidelityRegion.hasConstraints() || !highFidelityRsus.empty();
+}
+
+bool PhyLayer80211p::isHighFidelityReception()
+{
+    const Coord position = antennaPosition.getPositionAt();
+    if (highFidelityRegion.onAnyShape(TraCICoord(position.x, position.y))) return true;
+
+    if (highFidelityRsuPositions.size() != highFidelityRsus.size()) {
+        // RSUs might not have been initialized when this phy was
+        highFidelityRsuPositions.clear();
+        for (const auto& path : highFidelityRsus) {
+            cModule* rsu = getSimulation()->getModuleByPath(path.c_str());
+            BaseMobility* mobility = rsu ? FindModule<BaseMobility*>::findSubModule(rsu) : nullptr;
+            if (!mobility) throw cRuntimeError("highFidelityRsus: cannot find the mobility of module \"%s\"", path.c_str());
+            highFidelityRsuPositions.push_back(mobility->getPositionAt(simTime()));
+        }
+    }
+    const double sqrDistance = highFidelityRsuDistance * highFidelityRsuDistance;
+    for (const auto& rsuPosition : highFidelityRsuPositions) {
+        if (position.sqrdist(rsuPosition) <= sqrDistance) return true;
+    }
+    return false;
+}
+
 simtime_t PhyLayer80211p::setRadioState(int rs)
 {
     if (rs == Radio::TX) decider->switchToTx();
     return BasePhyLayer::setRadioState(rs);
 }
 
+double PhyLayer80211p::getReceptionPowerThreshold() const
+{
+    return std::min(minPowerLevel, ccaThreshold);
+}
+
 void PhyLayer80211p::setCCAThreshold(double ccaThreshold_dBm)
 {
     ccaThreshold = pow(10, ccaThreshold_dBm / 10);
@@ -374,9 +614,7 @@ void PhyLayer80211p::requestChannelStatusIfIdle()
 
 simtime_t PhyLayer80211p::getFrameDuration(int payloadLengthBits, MCS mcs) const
 {
-    Enter_Method_Silent();
     ASSERT(mcs != MCS::undefined);
-    auto ndbps = getNDBPS(mcs);
     // calculate frame duration according to Equation (17-29) of the IEEE 802.11-2007 standard
-    return PHY_HDR_PREAMBLE_DURATION + PHY_HDR_PLCPSIGNAL_DURATION + T_SYM_80211P * ceil(static_cast<double>(16 + payloadLengthBits + 6) / (ndbps));
+    return SimTime(OfdmTiming80211p::frameDuration_ns(payloadLengthBits, mcs), SIMTIME_NS);
 }
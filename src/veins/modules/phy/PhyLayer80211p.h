@@ -30,6 +30,8 @@
 #include "veins/base/connectionManager/BaseConnectionManager.h"
 #include "veins/modules/phy/Decider80211pToPhy80211pInterface.h"
 #include "veins/base/utils/Move.h"
+#include "veins/modules/obstacle/ObstacleControl.h"
+#include "veins/modules/mobility/traci/TraCIRegionOfInterest.h"
 
 namespace veins {
 
@@ -46,7 +48,17 @@ namespace veins {
  */
 class VEINS_API PhyLayer80211p : public BasePhyLayer, public Mac80211pToPhy11pInterface, public Decider80211pToPhy80211pInterface {
 public:
+    ~PhyLayer80211p() override;
     void initialize(int stage) override;
+    void finish() override;
+    bool isReusable() const override
+    {
+        return true;
+    }
+    /**
+     * @brief Drop the AirFrames set aside for being off channel, then reset like BasePhyLayer::resetForReuse()
+     */
+    void resetForReuse(int stage) override;
     /**
      * @brief Set the carrier sense threshold
      * @param ccaThreshold_dBm the cca threshold in dBm
@@ -67,6 +79,13 @@ public:
     void requestChannelStatusIfIdle() override;
 
 protected:
+    /**
+     * @brief Returns the lower of minPowerLevel and the CCA threshold (in mW).
+     *
+     * Frames below minPowerLevel can still make the channel busy.
+     */
+    double getReceptionPowerThreshold() const override;
+
     /** @brief CCA threshold. See Decider80211p for details */
     double ccaThreshold;
 
@@ -79,6 +98,45 @@ protected:
      */
     bool allowTxDuringRx;
 
+    /** @brief use precomputed error rate tables instead of evaluating the NIST error model for every frame */
+    bool useTabulatedErrorRate;
+
+    /** @brief track the SINR of the synced frame incrementally, see Decider80211p::incrementalSinr */
+    bool incrementalSinr;
+
+    /** @brief probability of a wrong outcome up to which receptions are decided by SINR bounds alone, see Decider80211p::decisionEpsilon */
+    double decisionEpsilon;
+
+    /** @brief defer reception processing of frames that cannot be decoded, see the NED parameter of the same name */
+    bool skipUndecodableAirFrames;
+
+    /** @brief center frequency of the channel the decider listens to */
+    double listeningFrequency = 0;
+
+    /** @brief frames that arrived without power in the listened channel, kept unfiltered until they end or the radio tunes to them */
+    std::vector<AirFrame11p*> offChannelAirFrames;
+
+    long numOffChannelAirFrames = 0; ///< Number of received AirFrames that arrived without power in the listened channel.
+    long numCaughtUpAirFrames = 0; ///< Number of those filtered after all, when the radio tuned to their channel before they ended.
+
+    /** @brief ObstacleControl used by SimpleObstacleShadowing, if any */
+    ObstacleControl* obstacleControl = nullptr;
+
+    /** @brief Region (in playground coordinates) within which Decider80211pAbstract evaluates receptions in full */
+    TraCIRegionOfInterest highFidelityRegion;
+
+    /** @brief Paths of the (stationary) modules around which Decider80211pAbstract evaluates receptions in full */
+    std::vector<std::string> highFidelityRsus;
+
+    /** @brief Positions of highFidelityRsus, looked up on first use */
+    std::vector<Coord> highFidelityRsuPositions;
+
+    /** @brief Distance from highFidelityRsus within which Decider80211pAbstract evaluates receptions in full */
+    double highFidelityRsuDistance;
+
+    /** @brief Returns whether any high fidelity region (highFidelityRegion or highFidelityRsus) is configured */
+    bool hasHighFidelityRegion() const;
+
     enum ProtocolIds {
         IEEE_80211 = 12123
     };
@@ -105,6 +163,8 @@ protected:
     /**
      * @brief Creates and initializes a BreakpointPathlossModel with the
      * passed parameter values.
+     *
+     * Parameter recordPathlosses (default true) records each pathloss; set it to false to let alike phys share the model.
      */
     virtual std::unique_ptr<AnalogueModel> initializeBreakpointPathlossModel(ParameterMap& params);
 
@@ -139,6 +199,12 @@ protected:
      */
     std::unique_ptr<AnalogueModel> initializeNakagamiFading(ParameterMap& params);
 
+    /**
+     * @brief Creates and initializes a CorrelatedShadowing with the
+     * passed parameter values, sharing its field with the other phys configured alike.
+     */
+    std::unique_ptr<AnalogueModel> initializeCorrelatedShadowing(ParameterMap& params);
+
     /**
      * @brief Creates and returns an instance of the Decider with the specified
      * name.
@@ -146,6 +212,7 @@ protected:
      * Is able to initialize the following Deciders:
      *
      * - Decider80211p
+     * - Decider80211pAbstract
      */
     virtual std::unique_ptr<Decider> getDeciderFromName(std::string name, ParameterMap& params) override;
 
@@ -154,6 +221,11 @@ protected:
      */
     virtual std::unique_ptr<Decider> initializeDecider80211p(ParameterMap& params);
 
+    /**
+     * @brief Initializes a new Decider80211pAbstract from the passed parameter map.
+     */
+    virtual std::unique_ptr<Decider> initializeDecider80211pAbstract(ParameterMap& params);
+
     /**
      * Create a protocol-specific AirFrame
      * Overloaded to create a specialize AirFrame11p.
@@ -171,12 +243,40 @@ protected:
      */
     void attachSignal(AirFrame* airFrame, cObject* ctrlInfo) override;
 
+    /**
+     * Return the duration attachSignal() computes for the passed message and control info.
+     *
+     * @note The control info must be of type MacToPhyControlInfo11p
+     */
+    simtime_t getTransmissionDuration(cPacket* macPkt, cObject* ctrlInfo) const override;
+
     void changeListeningChannel(Channel channel) override;
 
+    /**
+     * @brief With skipUndecodableAirFrames, sets aside frames without power in the listened channel (unfiltered) and marks
+     * frames arriving while the radio switches as interference only, before receiving the rest as usual.
+     */
+    void handleAirFrameStartReceive(AirFrame* frame) override;
+
+    /**
+     * @brief Returns whether the signal has power in any frequency bin of the listened channel (its center frequency +-5 MHz).
+     */
+    bool overlapsListeningChannel(const Signal& signal) const;
+
+    /**
+     * @brief Deletes the set aside frames that have ended, and starts receiving those (still on the air) overlapping the listened channel.
+     */
+    void updateOffChannelAirFrames();
+
     virtual simtime_t getFrameDuration(int payloadLengthBits, MCS mcs) const override;
 
     void handleSelfMessage(cMessage* msg) override;
     int getRadioState() override;
+
+    /**
+     * @brief Returns whether this phy's antenna is within the high fidelity region.
+     */
+    bool isHighFidelityReception() override;
     simtime_t setRadioState(int rs) override;
 };
 
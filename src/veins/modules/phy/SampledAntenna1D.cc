@@ -24,13 +24,47 @@
 #include "veins/modules/phy/SampledAntenna1D.h"
 #include "veins/base/utils/FWMath.h"
 
+#include <algorithm>
+
 using namespace veins;
 
-SampledAntenna1D::SampledAntenna1D(std::vector<double>& values, std::string offsetType, std::vector<double>& offsetParams, std::string rotationType, std::vector<double>& rotationParams, cRNG* rng)
-    : antennaGains(values.size() + 1)
+const size_t SampledAntenna1D::GainTable::numSectors;
+
+SampledAntenna1D::GainTable::GainTable(const std::vector<double>& samples)
 {
-    distance = (2 * M_PI) / values.size();
+    // tabulate linear gains at (at least) 4096 points, including all sample points
+    const size_t pointsPerSample = (4096 + samples.size() - 1) / samples.size();
+    const size_t tableSize = pointsPerSample * samples.size();
+    scale = tableSize / (2 * M_PI);
+    gains.resize(tableSize + 1);
+    for (size_t i = 0; i < tableSize; i++) {
+        const size_t baseElement = i / pointsPerSample;
+        // the value of 0 degrees is also the one of 360 degrees
+        const double nextSample = samples[(baseElement + 1) % samples.size()];
+        const double offset = double(i % pointsPerSample) / pointsPerSample;
+        gains[i] = FWMath::dBm2mW(samples[baseElement] + offset * (nextSample - samples[baseElement]));
+    }
+    gains[tableSize] = gains[0];
+
+    // gains are interpolated linearly, so the largest gain of a sector is at one of its table entries (including both ends)
+    std::vector<double> sectorMax(numSectors, 0);
+    for (size_t i = 0; i < tableSize; i++) {
+        const size_t sector = i * numSectors / tableSize;
+        sectorMax[sector] = std::max(sectorMax[sector], gains[i]);
+        // an entry at the start of a sector also ends the previous one (the first one ends the last sector)
+        if ((i * numSectors) % tableSize == 0) {
+            const size_t previous = (sector + numSectors - 1) % numSectors;
+            sectorMax[previous] = std::max(sectorMax[previous], gains[i]);
+        }
+    }
+    sectorBounds.resize(numSectors);
+    for (size_t i = 0; i < numSectors; i++) {
+        sectorBounds[i] = std::max({sectorMax[(i + numSectors - 1) % numSectors], sectorMax[i], sectorMax[(i + 1) % numSectors]});
+    }
+}
 
+SampledAntenna1D::SampledAntenna1D(std::vector<double>& values, std::string offsetType, std::vector<double>& offsetParams, std::string rotationType, std::vector<double>& rotationParams, cRNG* rng)
+{
     // instantiate a random number generator for sample offsets if one is specified
     cRandom* offsetGen = nullptr;
     if (offsetType == "uniform") {
@@ -53,23 +87,10 @@ SampledAntenna1D::SampledAntenna1D(std::vector<double>& values, std::string offs
     }
 
     // determine random rotation of the antenna if specified
-    cRandom* rotationGen = nullptr;
-    if (rotationType == "uniform") {
-        rotationGen = new cUniform(rng, rotationParams[0], rotationParams[1]);
-    }
-    else if (rotationType == "normal") {
-        rotationGen = new cNormal(rng, rotationParams[0], rotationParams[1]);
-    }
-    else if (rotationType == "triang") {
-        rotationGen = new cTriang(rng, rotationParams[0], rotationParams[1], rotationParams[2]);
-    }
-    rotation = (rotationGen == nullptr) ? 0 : rotationGen->draw();
-    if (rotationGen != nullptr) delete rotationGen;
-
-    // transform to rad
-    rotation *= (M_PI / 180);
+    rotation = drawRotation(rotationType, rotationParams, rng);
 
     // copy values and apply offset
+    std::vector<double> antennaGains(values.size());
     for (unsigned int i = 0; i < values.size(); i++) {
         double offset = 0;
         if (offsetGen != nullptr) {
@@ -81,41 +102,90 @@ SampledAntenna1D::SampledAntenna1D(std::vector<double>& values, std::string offs
     }
     if (offsetGen != nullptr) delete offsetGen;
 
-    // assign the value of 0 degrees to 360 degrees as well to assure correct interpolation (size allocated already before)
-    antennaGains[values.size()] = antennaGains[0];
+    gainTable = std::make_shared<const GainTable>(antennaGains);
 }
 
-SampledAntenna1D::~SampledAntenna1D()
+SampledAntenna1D::SampledAntenna1D(std::shared_ptr<const GainTable> gainTable, std::string rotationType, std::vector<double>& rotationParams, cRNG* rng)
+    : gainTable(std::move(gainTable))
+    , rotation(drawRotation(rotationType, rotationParams, rng))
 {
 }
 
-double SampledAntenna1D::getGain(Coord ownPos, Coord ownOrient, Coord otherPos)
+double SampledAntenna1D::drawRotation(const std::string& rotationType, const std::vector<double>& rotationParams, cRNG* rng)
 {
-    // get the line of sight vector
-    Coord los = otherPos - ownPos;
-    // calculate angle using atan2
-    double angle = atan2(los.y, los.x) - atan2(ownOrient.y, ownOrient.x);
+    cRandom* rotationGen = nullptr;
+    if (rotationType == "uniform") {
+        rotationGen = new cUniform(rng, rotationParams[0], rotationParams[1]);
+    }
+    else if (rotationType == "normal") {
+        rotationGen = new cNormal(rng, rotationParams[0], rotationParams[1]);
+    }
+    else if (rotationType == "triang") {
+        rotationGen = new cTriang(rng, rotationParams[0], rotationParams[1], rotationParams[2]);
+    }
+    double rotation = (rotationGen == nullptr) ? 0 : rotationGen->draw();
+    if (rotationGen != nullptr) delete rotationGen;
 
+    // transform to rad
+    return rotation * (M_PI / 180);
+}
+
+double SampledAntenna1D::normalizeAngle(double angle) const
+{
     // apply possible rotation
     angle -= rotation;
 
     // make sure angle is within [0, 2*M_PI)
     angle = fmod(angle, 2 * M_PI);
     if (angle < 0) angle += 2 * M_PI;
+    return angle;
+}
 
-    // calculate antennaGain
-    size_t baseElement = angle / distance;
-    double offset = (angle - (baseElement * distance)) / distance;
+double SampledAntenna1D::lookupGain(double angle) const
+{
+    angle = normalizeAngle(angle);
 
-    // make sure to not address an element out of antennaGains (baseElement == lastElement implies that offset is zero)
-    ASSERT((baseElement < antennaGains.size()) && (baseElement != antennaGains.size() - 1 || offset == 0));
+    // interpolate between neighboring table entries
+    const std::vector<double>& gains = gainTable->gains;
+    const double position = angle * gainTable->scale;
+    const size_t index = std::min(size_t(position), gains.size() - 2);
+    const double offset = position - index;
 
-    double gainValue = antennaGains[baseElement];
-    if (offset > 0) {
-        gainValue += offset * (antennaGains[baseElement + 1] - antennaGains[baseElement]);
+    return gains[index] + offset * (gains[index + 1] - gains[index]);
+}
+
+double SampledAntenna1D::getGain(Coord ownPos, Coord ownOrient, Coord otherPos)
+{
+    // get the line of sight vector
+    Coord los = otherPos - ownPos;
+    // angle between orientation and line of sight, using a single atan2
+    double angle = atan2(ownOrient.x * los.y - ownOrient.y * los.x, ownOrient.x * los.x + ownOrient.y * los.y);
+
+    return lookupGain(angle);
+}
+
+double SampledAntenna1D::getGain(const LinkGeometry& link, const Coord& ownOrient, bool atSender)
+{
+    // the line of sight points to the other end of the link
+    const double losX = atSender ? link.delta.x : -link.delta.x;
+    const double losY = atSender ? link.delta.y : -link.delta.y;
+    return lookupGain(atan2(ownOrient.x * losY - ownOrient.y * losX, ownOrient.x * losX + ownOrient.y * losY));
+}
+
+void SampledAntenna1D::getGains(const Coord& ownPos, const Coord& ownOrient, const Coord* otherPositions, size_t count, double* gains)
+{
+    for (size_t i = 0; i < count; i++) {
+        const double losX = otherPositions[i].x - ownPos.x;
+        const double losY = otherPositions[i].y - ownPos.y;
+        gains[i] = lookupGain(atan2(ownOrient.x * losY - ownOrient.y * losX, ownOrient.x * losX + ownOrient.y * losY));
     }
+}
 
-    return FWMath::dBm2mW(gainValue);
+double SampledAntenna1D::getGainBound(const Coord& ownOrient, const Coord& los)
+{
+    const double angle = normalizeAngle(atan2(ownOrient.x * los.y - ownOrient.y * los.x, ownOrient.x * los.x + ownOrient.y * los.y));
+    const size_t sector = std::min(size_t(angle * GainTable::numSectors / (2 * M_PI)), GainTable::numSectors - 1);
+    return gainTable->sectorBounds[sector];
 }
 
 double SampledAntenna1D::getLastAngle()
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "veins/base/phyLayer/Antenna.h"
+#include <memory>
 #include <vector>
 
 namespace veins {
@@ -35,7 +36,9 @@ namespace veins {
  * The user has to provide the samples, which are assumed to be distributed equidistantly.
  * As the power is assumed to be relative to an isotropic radiator, the values have to be given in dBi.
  * The values are stored in a mapping automatically supporting linear interpolation between samples.
+ * On construction, the (linear) gain is tabulated on a fine uniform grid of angles, so each gain query only needs one angle computation and a table lookup.
  * Optional randomness in terms of sample offsets and antenna rotation is supported.
+ * Antennas without random offsets can share one immutable GainTable, leaving only their rotation as per-antenna state.
  *
  * * An example antenna.xml for this Antenna can be the following:
  * @verbatim
@@ -68,6 +71,36 @@ namespace veins {
  */
 class VEINS_API SampledAntenna1D : public Antenna {
 public:
+    /**
+     * @brief The (linear) gain of an antenna pattern at tableSize equidistant angles in [0, 2*M_PI], with the first entry repeated at the end.
+     *
+     * The table contains every sample point, so it reproduces the samples exactly.
+     * Never modified after construction, so it can be shared by any number of antennas.
+     */
+    struct GainTable {
+        /**
+         * @brief Tabulates the gain of the given samples (in dBi, distributed equidistantly).
+         */
+        explicit GainTable(const std::vector<double>& samples);
+
+        std::vector<double> gains;
+
+        /**
+         * @brief Number of table entries per rad.
+         */
+        double scale;
+
+        /**
+         * @brief Number of equal sectors of sectorBounds.
+         */
+        static const size_t numSectors = 64;
+
+        /**
+         * @brief The largest gain within each sector and its two neighbours (sector i starting at angle i * 2 * M_PI / numSectors).
+         */
+        std::vector<double> sectorBounds;
+    };
+
     /**
      * @brief Constructor for the sampled antenna.
      *
@@ -81,11 +114,16 @@ public:
     SampledAntenna1D(std::vector<double>& values, std::string offsetType, std::vector<double>& offsetParams, std::string rotationType, std::vector<double>& rotationParams, cRNG* rng);
 
     /**
-     * @brief Destructor of the sampled antenna.
+     * @brief Constructor for a sampled antenna using a (shared) gain table without random offsets.
+     *
+     * Draws the same random numbers as the constructor above without offsets.
      *
-     * Deletes the mapping used for storing the antenna samples.
+     * @param gainTable         - the tabulated samples of the antenna
+     * @param rotationType      - name of random distribution to use for the random rotation of the whole antenna
+     * @param rotationParams    - contains the parameters for the rotation random distribution
+     * @param rng               - pointer to the random number generator to use
      */
-    ~SampledAntenna1D() override;
+    SampledAntenna1D(std::shared_ptr<const GainTable> gainTable, std::string rotationType, std::vector<double>& rotationParams, cRNG* rng);
 
     /**
      * @brief Calculates this antenna's gain based on the direction the signal is coming from/sent in.
@@ -98,14 +136,40 @@ public:
      */
     double getGain(Coord ownPos, Coord ownOrient, Coord otherPos) override;
 
+    /**
+     * @brief Like the above, taking the line of sight from link instead of computing it.
+     */
+    double getGain(const LinkGeometry& link, const Coord& ownOrient, bool atSender) override;
+
+    void getGains(const Coord& ownPos, const Coord& ownOrient, const Coord* otherPositions, size_t count, double* gains) override;
+
+    /**
+     * @brief Returns the largest gain of the sector (of the gain table) containing los and its neighbouring sectors.
+     */
+    double getGainBound(const Coord& ownOrient, const Coord& los) override;
+
     double getLastAngle() override;
 
 private:
     /**
-     * @brief Used to store the antenna's samples.
+     * @brief Returns the (linear) gain at the given angle (in rad, relative to the orientation of the antenna) from gainTable.
+     */
+    double lookupGain(double angle) const;
+
+    /**
+     * @brief Normalizes the given angle (in rad, relative to the orientation of the antenna) to [0, 2*M_PI), applying the rotation.
+     */
+    double normalizeAngle(double angle) const;
+
+    /**
+     * @brief Draws the random rotation (in rad) from the given distribution, or returns 0 if none is specified.
+     */
+    static double drawRotation(const std::string& rotationType, const std::vector<double>& rotationParams, cRNG* rng);
+
+    /**
+     * @brief The gain table, either private (if random offsets are applied) or shared.
      */
-    std::vector<double> antennaGains;
-    double distance;
+    std::shared_ptr<const GainTable> gainTable;
 
     /**
      * @brief An optional random rotation of the antenna is stored in this field and applied every time
@@ -0,0 +1,106 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/phy/TabulatedErrorRate.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "veins/modules/phy/NistErrorRate.h"
+
+using namespace veins;
+
+constexpr double TabulatedErrorRate::minSnr_dB;
+constexpr double TabulatedErrorRate::maxSnr_dB;
+constexpr double TabulatedErrorRate::step_dB;
+
+namespace {
+
+constexpr size_t numMcs = 8;
+
+/**
+ * Tables of log(-log(1 - codedBer)) over log(snr_mW), one per MCS.
+ *
+ * Interpolating in this domain is accurate since the coded BER falls roughly
+ * exponentially with the SNR; the chunk success rate then is
+ * exp(-nbits * exp(value)).
+ */
+struct ErrorRateTables {
+    double logSnrMin;
+    double logSnrStep;
+    std::array<std::vector<double>, numMcs> values;
+
+    ErrorRateTables()
+        : logSnrMin(TabulatedErrorRate::minSnr_dB / 10 * std::log(10.0))
+        , logSnrStep(TabulatedErrorRate::step_dB / 10 * std::log(10.0))
+    {
+        const size_t numEntries = static_cast<size_t>(std::round((TabulatedErrorRate::maxSnr_dB - TabulatedErrorRate::minSnr_dB) / TabulatedErrorRate::step_dB)) + 1;
+        for (size_t mcs = 0; mcs < numMcs; mcs++) {
+            values[mcs].reserve(numEntries);
+            for (size_t i = 0; i < numEntries; i++) {
+                const double snr = std::exp(logSnrMin + i * logSnrStep);
+                const double pe = NistErrorRate::getCodedBer(static_cast<MCS>(mcs), snr);
+                // non-finite for pe == 0 and pe == 1, lookups then use the analytic model
+                values[mcs].push_back(std::log(-std::log1p(-pe)));
+            }
+        }
+    }
+};
+
+const ErrorRateTables& getTables()
+{
+    static const ErrorRateTables tables;
+    return tables;
+}
+
+} // namespace
+
+void TabulatedErrorRate::initialize()
+{
+    getTables();
+}
+
+double TabulatedErrorRate::getChunkSuccessRate(unsigned int datarate, enum Bandwidth bw, double snr_mW, uint32_t nbits)
+{
+    const MCS mcs = getMCS(datarate, bw);
+    ASSERT2(mcs != MCS::undefined, "Invalid MCS chosen");
+
+    const ErrorRateTables& tables = getTables();
+    const std::vector<double>& table = tables.values[static_cast<size_t>(mcs)];
+
+    if (snr_mW > 0) {
+        const double position = (std::log(snr_mW) - tables.logSnrMin) / tables.logSnrStep;
+        if (position >= 0 && position < table.size() - 1) {
+            const size_t index = static_cast<size_t>(position);
+            const double fraction = position - index;
+            const double lower = table[index];
+            const double upper = table[index + 1];
+            if (std::isfinite(lower) && std::isfinite(upper)) {
+                return std::exp(-static_cast<double>(nbits) * std::exp(lower + fraction * (upper - lower)));
+            }
+        }
+    }
+
+    return NistErrorRate::getChunkSuccessRate(datarate, bw, snr_mW, nbits);
+}
@@ -0,0 +1,64 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <stdint.h>
+
+#include "veins/veins.h"
+
+#include "veins/modules/utility/ConstsPhy.h"
+
+namespace veins {
+
+/**
+ * Table-driven variant of NistErrorRate.
+ *
+ * The coded bit error rate of NistErrorRate is precomputed for every MCS on a
+ * dense SNR grid (from minSnr_dB to maxSnr_dB, in steps of step_dB) and
+ * interpolated on lookup, replacing the polynomial evaluation of each call by
+ * two table reads, a log and two exps. The chunk length enters exactly, so a
+ * single table per MCS serves all frame lengths.
+ *
+ * SNRs outside the table are passed on to NistErrorRate, which stays the
+ * reference implementation.
+ */
+class VEINS_API TabulatedErrorRate {
+public:
+    static constexpr double minSnr_dB = -10;
+    static constexpr double maxSnr_dB = 40;
+    static constexpr double step_dB = 0.05;
+
+    /**
+     * Same as NistErrorRate::getChunkSuccessRate(), but interpolated from precomputed tables.
+     */
+    static double getChunkSuccessRate(unsigned int datarate, enum Bandwidth bw, double snr_mW, uint32_t nbits);
+
+    /**
+     * Precompute the tables (if not done yet).
+     *
+     * Optional, the first lookup does the same.
+     */
+    static void initialize();
+};
+
+} // namespace veins
@@ -0,0 +1,171 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/utility/AppTask.h"
+
+#include <algorithm>
+#include <functional>
+
+using veins::AppTask;
+using veins::AppTaskScheduler;
+
+AppTaskScheduler::AppTaskScheduler(cSimpleModule* owner)
+    : owner(owner)
+{
+}
+
+AppTaskScheduler::~AppTaskScheduler()
+{
+    if (wakeupMessage) owner->cancelAndDelete(wakeupMessage);
+}
+
+void AppTaskScheduler::start(AppTask& task)
+{
+    task.awaitToken = 0;
+    task.resumePoint = 0;
+    resume(task, nullptr);
+}
+
+void AppTaskScheduler::cancel(AppTask& task)
+{
+    task.awaitToken = 0;
+    task.resumePoint = -1;
+
+    // forget the task entirely, so it may be deleted afterwards
+    auto ofTask = [&task](const Timeout& timeout) { return timeout.task == &task; };
+    auto removed = std::remove_if(timeouts.begin(), timeouts.end(), ofTask);
+    if (removed != timeouts.end()) {
+        timeouts.erase(removed, timeouts.end());
+        std::make_heap(timeouts.begin(), timeouts.end(), std::greater<Timeout>());
+        reschedule();
+    }
+    for (auto& typeWaiters : waiters) {
+        typeWaiters.erase(std::remove_if(typeWaiters.begin(), typeWaiters.end(), [&task](const Waiter& waiter) { return waiter.task == &task; }), typeWaiters.end());
+    }
+}
+
+void AppTaskScheduler::reset()
+{
+    timeouts.clear();
+    for (auto& typeWaiters : waiters) typeWaiters.clear();
+    if (wakeupMessage) owner->cancelEvent(wakeupMessage);
+    numResumes = 0;
+}
+
+uint64_t AppTaskScheduler::awaitTokenOf(AppTask& task)
+{
+    ASSERT(!task.isDone());
+    if (task.awaitToken == 0) task.awaitToken = nextToken++;
+    return task.awaitToken;
+}
+
+bool AppTaskScheduler::timeoutAfter(AppTask& task, simtime_t delay)
+{
+    return timeoutAt(task, simTime() + delay);
+}
+
+bool AppTaskScheduler::timeoutAt(AppTask& task, simtime_t time)
+{
+    if (time < simTime()) throw cRuntimeError("AppTask timeout at %s lies in the past", time.str().c_str());
+    timeouts.push_back({time, awaitTokenOf(task), &task});
+    std::push_heap(timeouts.begin(), timeouts.end(), std::greater<Timeout>());
+    reschedule();
+    return true;
+}
+
+bool AppTaskScheduler::waitFor(AppTask& task, int eventType)
+{
+    if (eventType < 0) throw cRuntimeError("AppTask event types must not be negative");
+    if (static_cast<size_t>(eventType) >= waiters.size()) waiters.resize(eventType + 1);
+    waiters[eventType].push_back({awaitTokenOf(task), &task});
+    return true;
+}
+
+void AppTaskScheduler::notify(int eventType, cObject* event)
+{
+    if (!hasWaiters(eventType)) return;
+
+    // tasks resumed here may wait for the same type again, which must not resume them for this event
+    resumed.clear();
+    std::swap(resumed, waiters[eventType]);
+    for (const Waiter& waiter : resumed) {
+        if (waiter.task->awaitToken != waiter.token) continue;
+        resume(*waiter.task, event);
+    }
+    resumed.clear();
+}
+
+bool AppTaskScheduler::handleMessage(cMessage* msg)
+{
+    if (msg != wakeupMessage || !wakeupMessage) return false;
+
+    const simtime_t now = simTime();
+    while (!timeouts.empty() && timeouts.front().time <= now) {
+        const Timeout timeout = timeouts.front();
+        std::pop_heap(timeouts.begin(), timeouts.end(), std::greater<Timeout>());
+        timeouts.pop_back();
+        if (timeout.task->awaitToken != timeout.token) continue;
+        resume(*timeout.task, nullptr);
+    }
+    reschedule();
+    return true;
+}
+
+void AppTaskScheduler::resume(AppTask& task, cObject* event)
+{
+    // whichever await comes first ends all others of the task
+    const uint64_t token = task.awaitToken;
+    task.awaitToken = 0;
+    if (token != 0) {
+        // also drop its waiters (timeouts of ended awaits are skipped by reschedule()), so that types no event arrives for do not pile them up
+        for (auto& typeWaiters : waiters) {
+            typeWaiters.erase(std::remove_if(typeWaiters.begin(), typeWaiters.end(), [token](const Waiter& waiter) { return waiter.token == token; }), typeWaiters.end());
+        }
+    }
+    cObject* previousEvent = currentEvent;
+    currentEvent = event;
+    numResumes++;
+    task.resume();
+    currentEvent = previousEvent;
+}
+
+void AppTaskScheduler::reschedule()
+{
+    // drop timeouts of earlier awaits, so they neither hold the message nor grow the heap
+    while (!timeouts.empty() && timeouts.front().task->awaitToken != timeouts.front().token) {
+        std::pop_heap(timeouts.begin(), timeouts.end(), std::greater<Timeout>());
+        timeouts.pop_back();
+    }
+
+    if (timeouts.empty()) {
+        if (wakeupMessage && wakeupMessage->isScheduled()) owner->cancelEvent(wakeupMessage);
+        return;
+    }
+
+    if (!wakeupMessage) wakeupMessage = new cMessage("appTaskWakeup", wakeupKind);
+    const simtime_t earliest = timeouts.front().time;
+    if (wakeupMessage->isScheduled()) {
+        if (wakeupMessage->getArrivalTime() == earliest) return;
+        owner->cancelEvent(wakeupMessage);
+    }
+    owner->scheduleAt(earliest, wakeupMessage);
+}
@@ -0,0 +1,265 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+class AppTaskScheduler;
+
+/**
+ * A resumable piece of application logic, run by an AppTaskScheduler.
+ *
+ * Lets protocols be written as straight-line code that waits for time to pass or for messages to arrive,
+ * instead of state machines spread over self-messages and timer callbacks.
+ * Tasks are stackless: their state lives in the members of the (application owned) task object, the point
+ * to continue at in resumePoint. Subclasses implement resume() using the VEINS_TASK_* macros:
+ *
+ *     struct Exchange : public AppTask {
+ *         AppTaskScheduler& tasks;
+ *         int retries = 0;
+ *         void resume() override
+ *         {
+ *             VEINS_TASK_BEGIN();
+ *             while (retries++ < 3) {
+ *                 sendRequest();
+ *                 VEINS_TASK_AWAIT(tasks.waitFor(*this, REPLY_TYPE) && tasks.timeoutAfter(*this, 0.1));
+ *                 if (tasks.getEvent()) break; // got a reply, not a timeout
+ *             }
+ *             VEINS_TASK_END();
+ *         }
+ *     };
+ *
+ * Like with any switch based coroutine, locals do not survive an await (keep them in members), and awaits
+ * must not be placed inside nested switch statements.
+ */
+class VEINS_API AppTask {
+public:
+    virtual ~AppTask() = default;
+
+    /**
+     * Returns whether the task ran to its end (or was never started).
+     */
+    bool isDone() const
+    {
+        return resumePoint < 0;
+    }
+
+    /**
+     * Returns whether the task is suspended in an await.
+     */
+    bool isWaiting() const
+    {
+        return awaitToken != 0;
+    }
+
+protected:
+    /**
+     * Runs the task from resumePoint up to its next await (or its end).
+     */
+    virtual void resume() = 0;
+
+    int resumePoint = -1; ///< where resume() continues: 0 at the start, -1 once done, else the line of the last await
+
+private:
+    friend class AppTaskScheduler;
+
+    uint64_t awaitToken = 0; ///< identifies the current await, so wake-ups of cancelled or earlier awaits are ignored (0: not waiting)
+};
+
+/**
+ * Start of the body of AppTask::resume().
+ */
+#define VEINS_TASK_BEGIN() \
+    switch (resumePoint) { \
+    case 0:
+
+/**
+ * Suspends the task until the awaits registered by the expression (a chain of AppTaskScheduler calls joined by &&) resume it.
+ *
+ * Whichever of the registered awaits happens first resumes the task, the others are dropped.
+ */
+#define VEINS_TASK_AWAIT(awaits) \
+    do { \
+        resumePoint = __LINE__; \
+        if (awaits) return; \
+    case __LINE__:; \
+    } while (0)
+
+/**
+ * End of the body of AppTask::resume().
+ */
+#define VEINS_TASK_END() \
+    } \
+    resumePoint = -1
+
+/**
+ * Runs the AppTasks of one module, multiplexing all their timeouts onto a single self-message.
+ *
+ * Awaiting costs no allocations (once the internal queues have grown to the module's needs) and no
+ * events beyond the one self-message scheduled for the earliest timeout. Events (e.g., received messages)
+ * resume the tasks waiting for their type when the module calls notify().
+ *
+ * To use, call handleMessage() for self-messages (it returns true for its own one) and notify() for
+ * events of interest, as DemoBaseApplLayer does for all received frames (by their message type).
+ */
+class VEINS_API AppTaskScheduler {
+public:
+    /**
+     * Kind of the self-message used for timeouts (chosen to not collide with the kinds of other self-messages).
+     */
+    static const short wakeupKind = 0x7ffe;
+
+    explicit AppTaskScheduler(cSimpleModule* owner);
+
+    /**
+     * Cancels and deletes the self-message. Tasks are owned by the application.
+     */
+    ~AppTaskScheduler();
+
+    AppTaskScheduler(const AppTaskScheduler&) = delete;
+    AppTaskScheduler& operator=(const AppTaskScheduler&) = delete;
+
+    /**
+     * (Re)starts a task from its beginning, running it up to its first await.
+     */
+    void start(AppTask& task);
+
+    /**
+     * Stops a task where it is, dropping its awaits. It is done afterwards.
+     *
+     * Tasks must be cancelled (or have run to their end) before they are deleted.
+     */
+    void cancel(AppTask& task);
+
+    /**
+     * Await: resumes the task after the given delay (with getEvent() returning nullptr).
+     *
+     * @return true, so awaits can be chained in VEINS_TASK_AWAIT()
+     */
+    bool timeoutAfter(AppTask& task, simtime_t delay);
+
+    /**
+     * Await: resumes the task at the given (absolute) time, see timeoutAfter().
+     */
+    bool timeoutAt(AppTask& task, simtime_t time);
+
+    /**
+     * Await: resumes the task with the next event of the given type passed to notify() (with getEvent() returning it).
+     */
+    bool waitFor(AppTask& task, int eventType);
+
+    /**
+     * Resumes all tasks waiting for events of the given type.
+     *
+     * The event only needs to live until this returns, tasks must copy what they need.
+     */
+    void notify(int eventType, cObject* event);
+
+    /**
+     * Returns whether any task waits for events of the given type (so the caller may skip building an event otherwise).
+     */
+    bool hasWaiters(int eventType) const
+    {
+        return (eventType >= 0) && (static_cast<size_t>(eventType) < waiters.size()) && !waiters[eventType].empty();
+    }
+
+    /**
+     * Returns the event that resumed the running task, nullptr if it was resumed by a timeout (or started).
+     */
+    cObject* getEvent() const
+    {
+        return currentEvent;
+    }
+
+    /**
+     * Resumes the tasks whose timeouts are due if msg is the self-message of this scheduler.
+     *
+     * @return true if msg was the self-message of this scheduler
+     */
+    bool handleMessage(cMessage* msg);
+
+    /**
+     * Returns the number of times tasks were resumed so far.
+     */
+    uint64_t getNumResumes() const
+    {
+        return numResumes;
+    }
+
+    /**
+     * Drops all awaits of all tasks and counts resumes from zero again, e.g., when the owner is reused for another vehicle.
+     *
+     * The tasks themselves are not touched (they might have been deleted already), they are never resumed again unless they are (re)started.
+     */
+    void reset();
+
+private:
+    /** @brief A pending timeout of a task.*/
+    struct Timeout {
+        simtime_t time;
+        uint64_t token; ///< awaitToken of the task when the timeout was registered, also orders timeouts of the same time
+        AppTask* task;
+
+        bool operator>(const Timeout& other) const
+        {
+            return (time > other.time) || ((time == other.time) && (token > other.token));
+        }
+    };
+
+    /** @brief A task waiting for an event.*/
+    struct Waiter {
+        uint64_t token;
+        AppTask* task;
+    };
+
+    /**
+     * Returns the token of the task's current await, starting a new await if the task is not waiting yet.
+     */
+    uint64_t awaitTokenOf(AppTask& task);
+
+    /**
+     * Resumes a task, ending its current await.
+     */
+    void resume(AppTask& task, cObject* event);
+
+    /**
+     * Makes sure wakeupMessage is scheduled for the earliest pending timeout (if any).
+     */
+    void reschedule();
+
+    cSimpleModule* const owner; ///< module the self-message belongs to
+    cMessage* wakeupMessage = nullptr; ///< self-message for timeouts, created on first use
+    std::vector<Timeout> timeouts; ///< min-heap of pending timeouts (including ones of earlier awaits, which are skipped)
+    std::vector<std::vector<Waiter>> waiters; ///< tasks waiting for an event, by event type (removed once their await ends)
+    std::vector<Waiter> resumed; ///< scratch space of notify(), kept to reuse its storage
+    uint64_t nextToken = 1; ///< token of the next await
+    cObject* currentEvent = nullptr; ///< see getEvent()
+    uint64_t numResumes = 0; ///< see getNumResumes()
+};
+
+} // namespace veins
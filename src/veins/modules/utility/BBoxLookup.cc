@@ -21,8 +21,17 @@
 //
 
 #include <cmath>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
 
 #include "veins/modules/utility/BBoxLookup.h"
+#include "veins/base/utils/MemoryAccounting.h"
+#include "veins/base/utils/WorkerPool.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace {
 
@@ -86,11 +95,47 @@ bool intersects(const Ray& ray, const Box& box)
     return (tmin < ray.length) && (tmax > 0);
 }
 
+/**
+ * Number of boxes whose overlap with the query box is checked at once by findOverlapping (at most the number of bits of the mask returned by overlapMask).
+ */
+constexpr size_t scanBlockSize = 8;
+
+/**
+ * Return a mask with bit k set if box first + k (of the count boxes given as arrays of their coordinates) overlaps query.
+ *
+ * Boxes with inverted coordinates (like removed entries) never overlap.
+ */
+unsigned int overlapMask(const double* minX, const double* minY, const double* maxX, const double* maxY, size_t first, size_t count, const Box& query)
+{
+    unsigned int mask = 0;
+    size_t k = 0;
+#ifdef __SSE2__
+    // two boxes per instruction
+    const __m128d queryMinX = _mm_set1_pd(query.p1.x);
+    const __m128d queryMinY = _mm_set1_pd(query.p1.y);
+    const __m128d queryMaxX = _mm_set1_pd(query.p2.x);
+    const __m128d queryMaxY = _mm_set1_pd(query.p2.y);
+    for (; k + 2 <= count; k += 2) {
+        const size_t i = first + k;
+        const __m128d overlapsX = _mm_and_pd(_mm_cmpge_pd(_mm_loadu_pd(maxX + i), queryMinX), _mm_cmple_pd(_mm_loadu_pd(minX + i), queryMaxX));
+        const __m128d overlapsY = _mm_and_pd(_mm_cmpge_pd(_mm_loadu_pd(maxY + i), queryMinY), _mm_cmple_pd(_mm_loadu_pd(minY + i), queryMaxY));
+        mask |= static_cast<unsigned int>(_mm_movemask_pd(_mm_and_pd(overlapsX, overlapsY))) << k;
+    }
+#endif
+    // without branches, so compilers may vectorize this, too
+    for (; k < count; ++k) {
+        const size_t i = first + k;
+        const bool overlaps = (maxX[i] >= query.p1.x) & (minX[i] <= query.p2.x) & (maxY[i] >= query.p1.y) & (minY[i] <= query.p2.y);
+        mask |= static_cast<unsigned int>(overlaps) << k;
+    }
+    return mask;
+}
+
 } // anonymous namespace
 
 namespace veins {
 
-BBoxLookup::BBoxLookup(const std::vector<Obstacle*>& obstacles, std::function<BBoxLookup::Box(Obstacle*)> makeBBox, double scenarioX, double scenarioY, int cellSize)
+BBoxLookup::BBoxLookup(const std::vector<Obstacle*>& obstacles, std::function<BBoxLookup::Box(Obstacle*)> makeBBox, double scenarioX, double scenarioY, int cellSize, WorkerPool* pool)
     : bboxes()
     , obstacleLookup()
     , bboxCells()
@@ -98,106 +143,408 @@ BBoxLookup::BBoxLookup(const std::vector<Obstacle*>& obstacles, std::function<BB
     , numCols(std::floor(scenarioX / cellSize) + 1)
     , numRows(std::floor(scenarioY / cellSize) + 1)
 {
-    // phase 1: build unordered collection of cells
-    // initialize proto-cells (cells in non-contiguos memory)
     ASSERT(scenarioX > 0);
     ASSERT(scenarioY > 0);
     ASSERT(numCols * cellSize >= scenarioX);
     ASSERT(numRows * cellSize >= scenarioY);
     const size_t numCells = numCols * numRows;
-    std::vector<std::vector<BBoxLookup::Box>> protoCells(numCells);
-    std::vector<std::vector<Obstacle*>> protoLookup(numCells);
-    // fill protoCells with boundingBoxes
+    const size_t numObstacles = obstacles.size();
+
+    // obstacles are split into contiguous chunks, so entries of each cell end up in the order of obstacles, however many chunks there are
+    const size_t numChunks = std::max(size_t(1), std::min(numObstacles, pool ? pool->getNumThreads() + 1 : 1));
+    auto runChunks = [pool, numChunks](const std::function<void(size_t)>& task) {
+        if (pool && numChunks > 1) {
+            pool->run(numChunks, task);
+        }
+        else {
+            for (size_t chunk = 0; chunk < numChunks; ++chunk) task(chunk);
+        }
+    };
+    auto chunkBegin = [numObstacles, numChunks](size_t chunk) {
+        return numObstacles * chunk / numChunks;
+    };
+
+    // phase 1: compute bounding boxes and count the entries each chunk adds to each cell
+    obstacleBoxes.resize(numObstacles);
+    std::vector<size_t> chunkCells(numChunks * numCells, 0); /**< entries of cell i from chunk c at c * numCells + i (later: where they start) */
+    runChunks([&](size_t chunk) {
+        size_t* counts = &chunkCells[chunk * numCells];
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+            obstacleBoxes[i] = makeBBox(obstacles[i]);
+            forEachCell(obstacleBoxes[i], [this, counts](size_t col, size_t row) {
+                counts[col + row * numCols]++;
+            });
+        }
+    });
+
+    // phase 2: lay out cells in contiguous memory, each chunk's entries after those of the chunks before it
+    bboxCells.resize(numCells);
     size_t numEntries = 0;
-    for (const auto obstaclePtr : obstacles) {
-        auto bbox = makeBBox(obstaclePtr);
-        const size_t fromCol = std::min(size_t(std::max(0, int(bbox.p1.x / cellSize))), numCols - 1);
-        const size_t toCol = std::min(size_t(std::max(0, int(bbox.p2.x / cellSize))), numCols - 1);
-        const size_t fromRow = std::min(size_t(std::max(0, int(bbox.p1.y / cellSize))), numRows - 1);
-        const size_t toRow = std::min(size_t(std::max(0, int(bbox.p2.y / cellSize))), numRows - 1);
-        for (size_t row = fromRow; row <= toRow; ++row) {
-            for (size_t col = fromCol; col <= toCol; ++col) {
-                ASSERT(row >= 0);
-                ASSERT(col >= 0);
-                ASSERT(row < numRows);
-                ASSERT(col < numCols);
-                const size_t cellIndex = col + row * numCols;
-                protoCells[cellIndex].push_back(bbox);
-                protoLookup[cellIndex].push_back(obstaclePtr);
-                ++numEntries;
-                ASSERT(protoCells[cellIndex].size() == protoLookup[cellIndex].size());
-            }
+    for (size_t cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+        bboxCells[cellIndex].index = numEntries;
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+            const size_t count = chunkCells[chunk * numCells + cellIndex];
+            chunkCells[chunk * numCells + cellIndex] = numEntries;
+            numEntries += count;
         }
+        bboxCells[cellIndex].count = numEntries - bboxCells[cellIndex].index;
     }
 
-    // phase 2: derive read-only data structure with fast lookup
-    bboxes.reserve(numEntries);
-    obstacleLookup.reserve(numEntries);
-    bboxCells.reserve(numCells);
-    size_t index = 0;
-    for (size_t row = 0; row < numRows; ++row) {
-        for (size_t col = 0; col < numCols; ++col) {
-            const size_t cellIndex = col + row * numCols;
-            auto& currentCell = protoCells.at(cellIndex);
-            auto& currentLookup = protoLookup.at(cellIndex);
-            ASSERT(currentCell.size() == currentLookup.size());
-            const size_t count = currentCell.size();
-            // copy over bboxes and obstacle lookups (in strict order)
-            for (size_t entryIndex = 0; entryIndex < count; ++entryIndex) {
-                bboxes.push_back(currentCell.at(entryIndex));
-                obstacleLookup.push_back(currentLookup.at(entryIndex));
-            }
-            // create lookup table for this cell
-            bboxCells.push_back({index, count});
-            // forward index to begin of next cell
-            index += count;
-            ASSERT(bboxes.size() == index);
+    // phase 3: fill in the entries
+    bboxes.resize(numEntries);
+    obstacleLookup.resize(numEntries);
+    obstacleIndices.resize(numEntries);
+    runChunks([&](size_t chunk) {
+        size_t* next = &chunkCells[chunk * numCells];
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+            forEachCell(obstacleBoxes[i], [&](size_t col, size_t row) {
+                const size_t entry = next[col + row * numCols]++;
+                bboxes.set(entry, obstacleBoxes[i]);
+                obstacleLookup[entry] = obstacles[i];
+                obstacleIndices[entry] = i;
+            });
         }
+    });
+
+    // phase 4: number obstacles by their position in obstacles, for deduplication of query results
+    obstaclesByNumber = obstacles;
+    obstacleNumbers.reserve(numObstacles);
+    for (size_t i = 0; i < numObstacles; ++i) {
+        obstacleNumbers.emplace(obstacles[i], i);
     }
-    ASSERT(bboxes.size() == numEntries);
-    ASSERT(bboxes.size() == obstacleLookup.size());
+    obstacleEpochs.assign(numObstacles, 0);
+}
+
+BBoxLookup::BBoxLookup(const std::vector<Obstacle*>& obstacles, std::function<BBoxLookup::Box(Obstacle*)> makeBBox, const CellTable& table)
+    : bboxes()
+    , obstacleLookup()
+    , bboxCells(table.cells)
+    , cellSize(table.cellSize)
+    , numCols(table.numCols)
+    , numRows(table.numRows)
+    , obstacleIndices(table.entries)
+{
+    ASSERT(cellSize > 0);
+    ASSERT(bboxCells.size() == numCols * numRows);
+    obstacleBoxes.reserve(obstacles.size());
+    std::transform(obstacles.begin(), obstacles.end(), std::back_inserter(obstacleBoxes), makeBBox);
+    bboxes.reserve(obstacleIndices.size());
+    obstacleLookup.reserve(obstacleIndices.size());
+    for (size_t obstacleIndex : obstacleIndices) {
+        ASSERT(obstacleIndex < obstacles.size());
+        bboxes.push_back(obstacleBoxes[obstacleIndex]);
+        obstacleLookup.push_back(obstacles[obstacleIndex]);
+    }
+    obstaclesByNumber = obstacles;
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+        obstacleNumbers.emplace(obstacles[i], i);
+    }
+    obstacleEpochs.assign(obstacles.size(), 0);
+}
+
+BBoxLookup::CellTable BBoxLookup::getCellTable() const
+{
+    ASSERT(!isModified);
+    CellTable table;
+    table.cellSize = cellSize;
+    table.numCols = numCols;
+    table.numRows = numRows;
+    table.cells = bboxCells;
+    table.entries = obstacleIndices;
+    return table;
+}
+
+size_t BBoxLookup::getBytesUsed() const
+{
+    size_t bytes = bboxes.getBytesUsed() + MemoryAccounting::bytesOf(obstacleLookup) + MemoryAccounting::bytesOf(bboxCells) + MemoryAccounting::bytesOf(obstacleIndices) + MemoryAccounting::bytesOf(obstacleEpochs);
+    bytes += MemoryAccounting::bytesOfNodes(obstacleNumbers) + MemoryAccounting::bytesOf(obstaclesByNumber) + MemoryAccounting::bytesOf(obstacleBoxes) + MemoryAccounting::bytesOf(insertedEntries) + dirtyCells.capacity() / 8;
+    for (const auto& cellEntries : insertedEntries) bytes += MemoryAccounting::bytesOf(cellEntries);
+    return bytes;
 }
 
 std::vector<Obstacle*> BBoxLookup::findOverlapping(Point sender, Point receiver) const
 {
     std::vector<Obstacle*> overlappingObstacles;
+    findOverlapping(sender, receiver, overlappingObstacles);
+    return overlappingObstacles;
+}
+
+void BBoxLookup::findOverlapping(Point sender, Point receiver, std::vector<Obstacle*>& overlappingObstacles) const
+{
+    findOverlapping(sender, receiver, overlappingObstacles, obstacleEpochs, queryEpoch);
+}
+
+void BBoxLookup::findOverlapping(Point sender, Point receiver, std::vector<Obstacle*>& overlappingObstacles, QueryState& state) const
+{
+    // obstacles inserted since the state was last used have not been returned yet
+    if (state.obstacleEpochs.size() < obstaclesByNumber.size()) state.obstacleEpochs.resize(obstaclesByNumber.size(), 0);
+    findOverlapping(sender, receiver, overlappingObstacles, state.obstacleEpochs, state.queryEpoch);
+}
+
+void BBoxLookup::findOverlapping(Point sender, Point receiver, std::vector<Obstacle*>& overlappingObstacles, std::vector<unsigned int>& epochs, unsigned int& epoch) const
+{
+    overlappingObstacles.clear();
     const Box bbox{
         {std::min(sender.x, receiver.x), std::min(sender.y, receiver.y)},
         {std::max(sender.x, receiver.x), std::max(sender.y, receiver.y)},
     };
 
+    // start a new query: obstacles stamped with the current epoch have already been reported
+    if (++epoch == 0) {
+        std::fill(epochs.begin(), epochs.end(), 0);
+        epoch = 1;
+    }
+
+    // precompute transmission ray properties
+    const Ray ray = makeRay(sender, receiver);
+
+    auto visitCell = [&](size_t col, size_t row) {
+        // derive cell for current cell coordinates
+        const size_t cellIndex = col + row * numCols;
+        const BBoxCell& cell = bboxCells.at(cellIndex);
+        // iterate over bboxes in each cell, a block at a time
+        const size_t cellEnd = cell.index + cell.count;
+        for (size_t block = cell.index; block < cellEnd; block += scanBlockSize) {
+            // check for overlap with bbox (fast rejection, also rejects removed entries)
+            unsigned int overlaps = overlapMask(bboxes.minX.data(), bboxes.minY.data(), bboxes.maxX.data(), bboxes.maxY.data(), block, std::min(scanBlockSize, cellEnd - block), bbox);
+            for (size_t bboxIndex = block; overlaps != 0; ++bboxIndex, overlaps >>= 1) {
+                if (!(overlaps & 1)) continue;
+                // skip obstacles already found in another cell
+                const size_t obstacleIndex = obstacleIndices[bboxIndex];
+                if (epochs[obstacleIndex] == epoch) continue;
+                // derive corresponding obstacle
+                if (!intersects(ray, bboxes.get(bboxIndex))) continue;
+                epochs[obstacleIndex] = epoch;
+                overlappingObstacles.push_back(obstacleLookup[bboxIndex]);
+            }
+        }
+        // iterate over entries inserted since the last compaction
+        if (insertedEntries.empty()) return;
+        for (const InsertedEntry& entry : insertedEntries[cellIndex]) {
+            const Box& current = entry.bbox;
+            if (current.p2.x < bbox.p1.x || current.p1.x > bbox.p2.x || current.p2.y < bbox.p1.y || current.p1.y > bbox.p2.y) continue;
+            if (epochs[entry.obstacleIndex] == epoch) continue;
+            if (!intersects(ray, current)) continue;
+            epochs[entry.obstacleIndex] = epoch;
+            overlappingObstacles.push_back(obstaclesByNumber[entry.obstacleIndex]);
+        }
+    };
+
     // determine coordinates for all cells touched by bbox
     const size_t firstCol = std::min(size_t(std::max(0, int(bbox.p1.x / cellSize))), numCols - 1);
     const size_t lastCol = std::min(size_t(std::max(0, int(bbox.p2.x / cellSize))), numCols - 1);
     const size_t firstRow = std::min(size_t(std::max(0, int(bbox.p1.y / cellSize))), numRows - 1);
     const size_t lastRow = std::min(size_t(std::max(0, int(bbox.p2.y / cellSize))), numRows - 1);
     ASSERT(lastCol < numCols && lastRow < numRows);
-    // precompute transmission ray properties
-    const Ray ray = makeRay(sender, receiver);
-    // iterate over cells
-    for (size_t row = firstRow; row <= lastRow; ++row) {
-        for (size_t col = firstCol; col <= lastCol; ++col) {
-            // skip cell if ray does not intersect with the cell.
-            const Box cellBox = {{static_cast<double>(col * cellSize), static_cast<double>(row * cellSize)}, {static_cast<double>((col + 1) * cellSize), static_cast<double>((row + 1) * cellSize)}};
-            if (!intersects(ray, cellBox)) continue;
-            // derive cell for current cell coordinates
-            const size_t cellIndex = col + row * numCols;
-            const BBoxCell& cell = bboxCells.at(cellIndex);
-            // iterate over bboxes in each cell
+
+    const double gridX = static_cast<double>(numCols * cellSize);
+    const double gridY = static_cast<double>(numRows * cellSize);
+    const bool insideGrid = bbox.p1.x >= 0 && bbox.p1.y >= 0 && bbox.p2.x < gridX && bbox.p2.y < gridY;
+    if (!insideGrid) {
+        // cells at the border also hold everything outside the grid; iterate over all cells of bbox that the ray intersects
+        for (size_t row = firstRow; row <= lastRow; ++row) {
+            for (size_t col = firstCol; col <= lastCol; ++col) {
+                // skip cell if ray does not intersect with the cell.
+                const Box cellBox = {{static_cast<double>(col * cellSize), static_cast<double>(row * cellSize)}, {static_cast<double>((col + 1) * cellSize), static_cast<double>((row + 1) * cellSize)}};
+                if (!intersects(ray, cellBox)) continue;
+                visitCell(col, row);
+            }
+        }
+        return;
+    }
+
+    // walk along the cells crossed by the ray (Amanatides and Woo, "A Fast Voxel Traversal Algorithm for Ray Tracing", Eurographics 1987)
+    const double dx = receiver.x - sender.x;
+    const double dy = receiver.y - sender.y;
+    size_t col = std::min(size_t(sender.x / cellSize), numCols - 1);
+    size_t row = std::min(size_t(sender.y / cellSize), numRows - 1);
+    const size_t endCol = std::min(size_t(receiver.x / cellSize), numCols - 1);
+    const size_t endRow = std::min(size_t(receiver.y / cellSize), numRows - 1);
+    // ray parameter (in [0, 1]) at which the next column/row boundary is crossed, and the parameter distance between boundaries
+    double tMaxX = (dx > 0) ? ((col + 1) * cellSize - sender.x) / dx : (dx < 0) ? (col * cellSize - sender.x) / dx : INFINITY;
+    double tMaxY = (dy > 0) ? ((row + 1) * cellSize - sender.y) / dy : (dy < 0) ? (row * cellSize - sender.y) / dy : INFINITY;
+    const double tDeltaX = (dx != 0) ? cellSize / std::abs(dx) : INFINITY;
+    const double tDeltaY = (dy != 0) ? cellSize / std::abs(dy) : INFINITY;
+
+    // every step moves one column or row closer to the receiver's cell
+    visitCell(col, row);
+    while (col != endCol || row != endRow) {
+        const bool stepX = (row == endRow) || (col != endCol && tMaxX < tMaxY);
+        if (stepX) {
+            col = (dx > 0) ? col + 1 : col - 1;
+            tMaxX += tDeltaX;
+        }
+        else {
+            row = (dy > 0) ? row + 1 : row - 1;
+            tMaxY += tDeltaY;
+        }
+        visitCell(col, row);
+    }
+}
+
+void BBoxLookup::insert(Obstacle* obstacle, const Box& bbox)
+{
+    ASSERT(numCols > 0 && numRows > 0);
+    ASSERT(obstacleNumbers.find(obstacle) == obstacleNumbers.end());
+    const size_t obstacleIndex = obstaclesByNumber.size();
+    obstacleNumbers.emplace(obstacle, obstacleIndex);
+    obstaclesByNumber.push_back(obstacle);
+    obstacleBoxes.push_back(bbox);
+    obstacleEpochs.push_back(0);
+    if (insertedEntries.empty()) insertedEntries.resize(bboxCells.size());
+    if (dirtyCells.empty()) dirtyCells.assign(bboxCells.size(), false);
+    forEachCell(bbox, [&](size_t col, size_t row) {
+        const size_t cellIndex = col + row * numCols;
+        insertedEntries[cellIndex].push_back({bbox, obstacleIndex});
+        dirtyCells[cellIndex] = true;
+        ++numPendingChanges;
+    });
+    isModified = true;
+}
+
+bool BBoxLookup::remove(Obstacle* obstacle)
+{
+    auto it = obstacleNumbers.find(obstacle);
+    if (it == obstacleNumbers.end()) return false;
+    const size_t obstacleIndex = it->second;
+    obstacleNumbers.erase(it);
+    obstaclesByNumber[obstacleIndex] = nullptr;
+
+    // entries in the contiguous storage are replaced by an empty box, which never passes the overlap check of findOverlapping
+    const Box empty{{INFINITY, INFINITY}, {-INFINITY, -INFINITY}};
+    if (dirtyCells.empty()) dirtyCells.assign(bboxCells.size(), false);
+    forEachCell(obstacleBoxes[obstacleIndex], [&](size_t col, size_t row) {
+        const size_t cellIndex = col + row * numCols;
+        const BBoxCell& cell = bboxCells[cellIndex];
+        for (size_t bboxIndex = cell.index; bboxIndex < cell.index + cell.count; ++bboxIndex) {
+            if (obstacleIndices[bboxIndex] != obstacleIndex) continue;
+            bboxes.set(bboxIndex, empty);
+            ++numPendingChanges;
+        }
+        if (!insertedEntries.empty()) {
+            auto& inserted = insertedEntries[cellIndex];
+            inserted.erase(std::remove_if(inserted.begin(), inserted.end(), [obstacleIndex](const InsertedEntry& entry) { return entry.obstacleIndex == obstacleIndex; }), inserted.end());
+        }
+        dirtyCells[cellIndex] = true;
+    });
+    isModified = true;
+    return true;
+}
+
+bool BBoxLookup::needsCompaction() const
+{
+    return numPendingChanges > std::max(size_t(64), bboxes.size() / 8);
+}
+
+void BBoxLookup::compact()
+{
+    if (dirtyCells.empty()) return;
+    BoxArrays newBboxes;
+    std::vector<Obstacle*> newObstacleLookup;
+    std::vector<size_t> newObstacleIndices;
+    newBboxes.reserve(bboxes.size() + numPendingChanges);
+    newObstacleLookup.reserve(bboxes.size() + numPendingChanges);
+    newObstacleIndices.reserve(bboxes.size() + numPendingChanges);
+    for (size_t cellIndex = 0; cellIndex < bboxCells.size(); ++cellIndex) {
+        BBoxCell& cell = bboxCells[cellIndex];
+        const size_t index = newBboxes.size();
+        if (!dirtyCells[cellIndex]) {
+            // copy unchanged cells as a whole
+            newBboxes.append(bboxes, cell.index, cell.count);
+            newObstacleLookup.insert(newObstacleLookup.end(), obstacleLookup.begin() + cell.index, obstacleLookup.begin() + cell.index + cell.count);
+            newObstacleIndices.insert(newObstacleIndices.end(), obstacleIndices.begin() + cell.index, obstacleIndices.begin() + cell.index + cell.count);
+        }
+        else {
             for (size_t bboxIndex = cell.index; bboxIndex < cell.index + cell.count; ++bboxIndex) {
-                const Box& current = bboxes.at(bboxIndex);
-                // check for overlap with bbox (fast rejection)
-                if (current.p2.x < bbox.p1.x) continue;
-                if (current.p1.x > bbox.p2.x) continue;
-                if (current.p2.y < bbox.p1.y) continue;
-                if (current.p1.y > bbox.p2.y) continue;
-                // derive corresponding obstacle
-                if (!intersects(ray, current)) continue;
-                overlappingObstacles.push_back(obstacleLookup.at(bboxIndex));
+                if (!obstaclesByNumber[obstacleIndices[bboxIndex]]) continue;
+                newBboxes.push_back(bboxes.get(bboxIndex));
+                newObstacleLookup.push_back(obstacleLookup[bboxIndex]);
+                newObstacleIndices.push_back(obstacleIndices[bboxIndex]);
+            }
+            if (!insertedEntries.empty()) {
+                for (const InsertedEntry& entry : insertedEntries[cellIndex]) {
+                    newBboxes.push_back(entry.bbox);
+                    newObstacleLookup.push_back(obstaclesByNumber[entry.obstacleIndex]);
+                    newObstacleIndices.push_back(entry.obstacleIndex);
+                }
             }
         }
+        cell = {index, newBboxes.size() - index};
     }
-    return overlappingObstacles;
+    bboxes = std::move(newBboxes);
+    obstacleLookup = std::move(newObstacleLookup);
+    obstacleIndices = std::move(newObstacleIndices);
+    insertedEntries.clear();
+    dirtyCells.clear();
+    numPendingChanges = 0;
+}
+
+void BBoxLookup::BoxArrays::resize(size_t n)
+{
+    minX.resize(n);
+    minY.resize(n);
+    maxX.resize(n);
+    maxY.resize(n);
+}
+
+void BBoxLookup::BoxArrays::reserve(size_t n)
+{
+    minX.reserve(n);
+    minY.reserve(n);
+    maxX.reserve(n);
+    maxY.reserve(n);
+}
+
+void BBoxLookup::BoxArrays::set(size_t i, const Box& box)
+{
+    minX[i] = box.p1.x;
+    minY[i] = box.p1.y;
+    maxX[i] = box.p2.x;
+    maxY[i] = box.p2.y;
+}
+
+void BBoxLookup::BoxArrays::push_back(const Box& box)
+{
+    minX.push_back(box.p1.x);
+    minY.push_back(box.p1.y);
+    maxX.push_back(box.p2.x);
+    maxY.push_back(box.p2.y);
+}
+
+void BBoxLookup::BoxArrays::append(const BoxArrays& other, size_t first, size_t count)
+{
+    minX.insert(minX.end(), other.minX.begin() + first, other.minX.begin() + first + count);
+    minY.insert(minY.end(), other.minY.begin() + first, other.minY.begin() + first + count);
+    maxX.insert(maxX.end(), other.maxX.begin() + first, other.maxX.begin() + first + count);
+    maxY.insert(maxY.end(), other.maxY.begin() + first, other.maxY.begin() + first + count);
+}
+
+size_t BBoxLookup::BoxArrays::getBytesUsed() const
+{
+    return MemoryAccounting::bytesOf(minX) + MemoryAccounting::bytesOf(minY) + MemoryAccounting::bytesOf(maxX) + MemoryAccounting::bytesOf(maxY);
+}
+
+bool BBoxLookup::segmentTouchesBox(Point a, Point b, const Box& box)
+{
+    // Liang-Barsky clipping of the segment against box
+    double t0 = 0;
+    double t1 = 1;
+    const double d[2] = {b.x - a.x, b.y - a.y};
+    const double lo[2] = {box.p1.x - a.x, box.p1.y - a.y};
+    const double hi[2] = {box.p2.x - a.x, box.p2.y - a.y};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (d[axis] == 0) {
+            if (lo[axis] > 0 || hi[axis] < 0) return false;
+            continue;
+        }
+        double tLo = lo[axis] / d[axis];
+        double tHi = hi[axis] / d[axis];
+        if (tLo > tHi) std::swap(tLo, tHi);
+        t0 = std::max(t0, tLo);
+        t1 = std::min(t1, tHi);
+        if (t0 > t1) return false;
+    }
+    return true;
 }
 
 } // namespace veins
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 #include "veins/veins.h"
@@ -31,6 +32,7 @@
 namespace veins {
 
 class Obstacle;
+class WorkerPool;
 
 /**
  * Fast grid-based spatial datastructure to find obstacles (geometric shapes) in a bounding box.
@@ -49,9 +51,6 @@ public:
         double x;
         double y;
     };
-    // array of stucts approach
-    // cache line size: 64byte = 8 x 8-byte double = 2 bboxes per line
-    // bbox coordinates are inherently local, if i check x1, i likely also check the other
     struct Box {
         Point p1;
         Point p2;
@@ -61,24 +60,170 @@ public:
         size_t count; /**< number of elements in this cell; index + number = index of last element */
     };
 
+    /**
+     * Grid layout and cell contents of a BBoxLookup, independent of obstacle instances (e.g., for storing it in a file).
+     */
+    struct CellTable {
+        int cellSize = 0;
+        size_t numCols = 0;
+        size_t numRows = 0;
+        std::vector<BBoxCell> cells; /**< flattened matrix of numCols * numRows cells */
+        std::vector<size_t> entries; /**< position (in the list of obstacles the lookup was built from) of the obstacle of each cell entry, ordered by cells */
+    };
+
     BBoxLookup() = default;
-    BBoxLookup(const std::vector<Obstacle*>& obstacles, std::function<BBoxLookup::Box(Obstacle*)> makeBBox, double scenarioX, double scenarioY, int cellSize = 250);
+
+    /**
+     * Build a lookup for obstacles, assigning them to cells by a two-pass counting sort (counting the entries of each cell, then filling them in).
+     *
+     * If pool is set, both passes are split into contiguous ranges of obstacles run in parallel (so makeBBox must be safe to be called concurrently).
+     * The result does not depend on the number of threads.
+     */
+    BBoxLookup(const std::vector<Obstacle*>& obstacles, std::function<BBoxLookup::Box(Obstacle*)> makeBBox, double scenarioX, double scenarioY, int cellSize = 250, WorkerPool* pool = nullptr);
+
+    /**
+     * Restore a lookup from a cell table previously returned by getCellTable() for the same list of obstacles.
+     *
+     * Skips assigning obstacles to cells, which dominates construction time for large numbers of obstacles.
+     */
+    BBoxLookup(const std::vector<Obstacle*>& obstacles, std::function<BBoxLookup::Box(Obstacle*)> makeBBox, const CellTable& table);
+
+    /**
+     * Return the grid layout and cell contents of this lookup.
+     *
+     * Must not be called after insert() or remove(), as entries would no longer refer to positions in the original list of obstacles.
+     */
+    CellTable getCellTable() const;
+
+    /**
+     * Add an obstacle with bounding box bbox, without rebuilding the lookup.
+     *
+     * The obstacle is kept in a per-cell list of insertions until the next call of compact().
+     */
+    void insert(Obstacle* obstacle, const Box& bbox);
+
+    /**
+     * Remove an obstacle, without rebuilding the lookup; returns false if it was not found.
+     */
+    bool remove(Obstacle* obstacle);
+
+    /**
+     * Return whether enough insertions and removals have accumulated that compact() should be called.
+     */
+    bool needsCompaction() const;
+
+    /**
+     * Merge insertions into the contiguous cell storage and drop removed entries, rewriting only the cells changed since the last compaction.
+     */
+    void compact();
+
+    /**
+     * Return whether the segment from a to b touches box.
+     */
+    static bool segmentTouchesBox(Point a, Point b, const Box& box);
 
     /**
      * Return all obstacles which have their bounding box touched by the transmission from sender to receiver.
      *
      * The obstacles itself may not actually overlap with transmission (false positives are possible).
+     * Each obstacle is returned at most once.
+     * Only the grid cells crossed by the transmission are visited.
      */
     std::vector<Obstacle*> findOverlapping(Point sender, Point receiver) const;
 
+    /**
+     * Like findOverlapping(), but write the obstacles to out (clearing it first), reusing its storage.
+     */
+    void findOverlapping(Point sender, Point receiver, std::vector<Obstacle*>& out) const;
+
+    /**
+     * Which obstacles a query has already returned, kept by the caller of the findOverlapping() below (one per thread).
+     */
+    struct QueryState {
+        std::vector<unsigned int> obstacleEpochs; /**< value of queryEpoch when the obstacle with this number was last returned */
+        unsigned int queryEpoch = 0; /**< number of the current query */
+    };
+
+    /**
+     * Like findOverlapping(), but keeping track of the obstacles returned in state rather than in this lookup.
+     *
+     * Concurrent calls (each with a state of its own) are safe as long as the lookup is not modified.
+     */
+    void findOverlapping(Point sender, Point receiver, std::vector<Obstacle*>& out, QueryState& state) const;
+
+    /**
+     * Return the (approximate) number of bytes held by the lookup, see MemoryAccounting.
+     */
+    size_t getBytesUsed() const;
+
 private:
+    /**
+     * Bounding boxes as one array per coordinate (structure of arrays), so the overlap check of findOverlapping() can test several boxes per instruction.
+     */
+    struct BoxArrays {
+        std::vector<double> minX; /**< p1.x of each box */
+        std::vector<double> minY; /**< p1.y of each box */
+        std::vector<double> maxX; /**< p2.x of each box */
+        std::vector<double> maxY; /**< p2.y of each box */
+
+        size_t size() const
+        {
+            return minX.size();
+        }
+        void resize(size_t n);
+        void reserve(size_t n);
+        void set(size_t i, const Box& box);
+        Box get(size_t i) const
+        {
+            return {{minX[i], minY[i]}, {maxX[i], maxY[i]}};
+        }
+        void push_back(const Box& box);
+        /** append count boxes of other, starting at first */
+        void append(const BoxArrays& other, size_t first, size_t count);
+        size_t getBytesUsed() const;
+    };
+
+    void findOverlapping(Point sender, Point receiver, std::vector<Obstacle*>& out, std::vector<unsigned int>& epochs, unsigned int& epoch) const;
+
     // NOTE: obstacles may occur multiple times in bboxes/obstacleLookup (if they are in multiple cells)
-    std::vector<Box> bboxes; /**< ALL bboxes in one chunck of contiguos memory, ordered by cells */
+    BoxArrays bboxes; /**< ALL bboxes in one chunck of contiguos memory, ordered by cells */
     std::vector<Obstacle*> obstacleLookup; /**< bboxes[i] belongs to instance in obstacleLookup[i] */
     std::vector<BBoxCell> bboxCells; /**< flattened matrix of X * Y BBoxCell instances */
     int cellSize = 0;
     size_t numCols = 0; /**< X BBoxCell instances in a row */
     size_t numRows = 0; /**< Y BBoxCell instances in a column */
+    std::vector<size_t> obstacleIndices; /**< bboxes[i] belongs to the obstacle at position obstacleIndices[i] of the list the lookup was built from */
+    mutable std::vector<unsigned int> obstacleEpochs; /**< value of queryEpoch when the obstacle with this number was last returned */
+    mutable unsigned int queryEpoch = 0; /**< number of the current query of findOverlapping */
+
+    struct InsertedEntry {
+        Box bbox;
+        size_t obstacleIndex;
+    };
+    std::unordered_map<Obstacle*, size_t> obstacleNumbers; /**< number of each obstacle (as used in obstacleIndices) */
+    std::vector<Obstacle*> obstaclesByNumber; /**< obstacle with each number, nullptr once removed */
+    std::vector<Box> obstacleBoxes; /**< bounding box of the obstacle with each number */
+    std::vector<std::vector<InsertedEntry>> insertedEntries; /**< per cell: entries added by insert() since the last compaction (empty if there are none in any cell) */
+    std::vector<bool> dirtyCells; /**< per cell: whether it was changed by insert() or remove() since the last compaction (empty if no cell was) */
+    size_t numPendingChanges = 0; /**< number of cell entries inserted or removed since the last compaction */
+    bool isModified = false; /**< whether insert() or remove() was ever called */
+
+    /**
+     * call f(col, row) for all cells covered by bbox
+     */
+    template <typename F>
+    void forEachCell(const Box& bbox, F f) const
+    {
+        const size_t fromCol = std::min(size_t(std::max(0, int(bbox.p1.x / cellSize))), numCols - 1);
+        const size_t toCol = std::min(size_t(std::max(0, int(bbox.p2.x / cellSize))), numCols - 1);
+        const size_t fromRow = std::min(size_t(std::max(0, int(bbox.p1.y / cellSize))), numRows - 1);
+        const size_t toRow = std::min(size_t(std::max(0, int(bbox.p2.y / cellSize))), numRows - 1);
+        for (size_t row = fromRow; row <= toRow; ++row) {
+            for (size_t col = fromCol; col <= toCol; ++col) {
+                f(col, row);
+            }
+        }
+    }
 };
 
 } // namespace veins
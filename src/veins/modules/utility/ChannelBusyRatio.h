@@ -0,0 +1,109 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief Tracks the channel busy ratio (CBR) over consecutive measurement intervals from busy/idle edges.
+ *
+ * The tracker keeps only the busy time accumulated in the current interval and the ratio of the last complete one,
+ * so every edge and every query costs O(1) regardless of the number of edges per interval.
+ * Intervals are closed lazily on the next edge or query, so no timer is needed.
+ */
+class VEINS_API ChannelBusyRatio {
+public:
+    ChannelBusyRatio(simtime_t interval = 0.1, simtime_t now = 0)
+        : interval(interval)
+        , intervalStart(now)
+        , lastEdge(now)
+    {
+        ASSERT(interval > 0);
+    }
+
+    /** @brief Records that the channel turned busy (or idle) at the given time. */
+    void setBusy(simtime_t now, bool isBusy)
+    {
+        advance(now);
+        if (busy) busyTime += now - lastEdge;
+        lastEdge = now;
+        busy = isBusy;
+    }
+
+    /** @brief Returns the CBR of the last complete measurement interval (0 before the first interval completed). */
+    double getLastRatio(simtime_t now)
+    {
+        advance(now);
+        return lastRatio;
+    }
+
+    /**
+     * @brief Returns the number of measurement intervals completed so far.
+     *
+     * Lets callers react to a new CBR value without keeping a timer of their own.
+     */
+    long getNumIntervals(simtime_t now)
+    {
+        advance(now);
+        return numIntervals;
+    }
+
+    simtime_t getInterval() const
+    {
+        return interval;
+    }
+
+private:
+    /** @brief Closes all measurement intervals that ended before now. */
+    void advance(simtime_t now)
+    {
+        ASSERT(now >= lastEdge);
+        simtime_t intervalEnd = intervalStart + interval;
+        if (now < intervalEnd) return;
+
+        // close the interval the last edge fell into
+        if (busy) busyTime += intervalEnd - lastEdge;
+        lastRatio = busyTime / interval;
+
+        // every further interval that ended before now saw no edge at all
+        int64_t skipped = static_cast<int64_t>(((now - intervalEnd) / interval));
+        if (skipped > 0) lastRatio = busy ? 1 : 0;
+
+        numIntervals += 1 + skipped;
+        intervalStart = intervalEnd + interval * skipped;
+        lastEdge = intervalStart;
+        busyTime = 0;
+    }
+
+    simtime_t interval;
+    simtime_t intervalStart;
+    simtime_t lastEdge;
+    simtime_t busyTime = 0;
+    bool busy = false;
+    double lastRatio = 0;
+    long numIntervals = 0;
+};
+
+} // namespace veins
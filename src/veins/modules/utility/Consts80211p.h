@@ -118,6 +118,12 @@ const unsigned CWMIN_11P = 15;
  */
 const unsigned CWMAX_11P = 1023;
 
+/** @brief Length (in bits) of an A-MSDU subframe header (DA, SA, and Length fields)
+ *
+ * as defined in 8.3.2.2 A-MSDU format in the IEEE 802.11-2012 standard
+ */
+const int AMSDU_SUBFRAME_HEADER_LENGTH = 112;
+
 /** @brief 1609.4 slot length
  *
  * as defined in Table H.1 in the IEEE 1609.4-2010 standard
@@ -133,6 +139,14 @@ const SimTime GUARD_INTERVAL_11P = SimTime().setRaw(4000000000UL);
 
 const Bandwidth BANDWIDTH_11P = Bandwidth::ofdm_10_mhz;
 
+/** @brief OFDM timing for the channel bandwidth used by 802.11p */
+using OfdmTiming80211p = OfdmTiming<BANDWIDTH_11P>;
+
+static_assert(OfdmTiming80211p::slotLength_ns == 13000, "slot length of OfdmTiming80211p must match SLOTLENGTH_11P");
+static_assert(OfdmTiming80211p::sifs_ns == 32000, "SIFS of OfdmTiming80211p must match SIFS_11P");
+static_assert(OfdmTiming80211p::preambleDuration_ns == 32000, "preamble duration of OfdmTiming80211p must match PHY_HDR_PREAMBLE_DURATION");
+static_assert(OfdmTiming80211p::datarate(MCS::ofdm_bpsk_r_1_2) == 3000000, "datarates of OfdmTiming80211p must match BITRATES_80211P");
+
 /** @brief Channels as reserved by the FCC
  *
  */
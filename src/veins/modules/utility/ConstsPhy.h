@@ -241,4 +241,63 @@ inline MCS getMCS(uint64_t datarate, Bandwidth bw)
     return MCS::undefined;
 }
 
+/** @brief Number of data bits per OFDM symbol, indexed by MCS (see getNDBPS) */
+constexpr uint32_t OFDM_NDBPS[] = {24, 36, 48, 72, 96, 144, 192, 216};
+
+/**
+ * @brief OFDM PHY timing for a fixed channel bandwidth, usable in constant expressions.
+ *
+ * Durations are integral nanoseconds as defined in Table 18-17 (Timing-related parameters) of the IEEE 802.11-2012 standard,
+ * so frame durations can be computed in integer arithmetic and without branching on the bandwidth.
+ * They are exact for the bandwidths defined in Bandwidth.
+ * Functions taking an MCS require it to be defined (i.e., not MCS::undefined).
+ */
+template <Bandwidth bw>
+struct VEINS_API OfdmTiming {
+    /** @brief factor by which all durations are longer than for 20 MHz channels */
+    static constexpr int64_t stretch = (bw == Bandwidth::ofdm_5_mhz) ? 4 : (bw == Bandwidth::ofdm_10_mhz) ? 2 : 1;
+
+    static constexpr int64_t symbolDuration_ns = 4000 * stretch;
+    static constexpr int64_t preambleDuration_ns = 16000 * stretch;
+    static constexpr int64_t signalDuration_ns = 4000 * stretch;
+    static constexpr int64_t sifs_ns = 16000 * stretch;
+    static constexpr int64_t slotLength_ns = 5000 + 4000 * stretch;
+
+    /** @brief length (in bits) of the SERVICE field and the tail bits, which are coded along with the payload */
+    static constexpr int64_t serviceAndTailLength = 16 + 6;
+
+    /** @brief returns the datarate in bits per second */
+    static constexpr uint64_t datarate(MCS mcs)
+    {
+        return OFDM_NDBPS[static_cast<int>(mcs)] * 1000000000ULL / symbolDuration_ns;
+    }
+
+    /** @brief returns the number of OFDM symbols needed for the given payload */
+    static constexpr int64_t numSymbols(int64_t payloadLengthBits, MCS mcs)
+    {
+        return (serviceAndTailLength + payloadLengthBits + OFDM_NDBPS[static_cast<int>(mcs)] - 1) / OFDM_NDBPS[static_cast<int>(mcs)];
+    }
+
+    /** @brief returns the duration of a frame with the given payload, see Equation (18-29) of the IEEE 802.11-2012 standard */
+    static constexpr int64_t frameDuration_ns(int64_t payloadLengthBits, MCS mcs)
+    {
+        return preambleDuration_ns + signalDuration_ns + symbolDuration_ns * numSymbols(payloadLengthBits, mcs);
+    }
+};
+
+template <Bandwidth bw>
+constexpr int64_t OfdmTiming<bw>::stretch;
+template <Bandwidth bw>
+constexpr int64_t OfdmTiming<bw>::symbolDuration_ns;
+template <Bandwidth bw>
+constexpr int64_t OfdmTiming<bw>::preambleDuration_ns;
+template <Bandwidth bw>
+constexpr int64_t OfdmTiming<bw>::signalDuration_ns;
+template <Bandwidth bw>
+constexpr int64_t OfdmTiming<bw>::sifs_ns;
+template <Bandwidth bw>
+constexpr int64_t OfdmTiming<bw>::slotLength_ns;
+template <Bandwidth bw>
+constexpr int64_t OfdmTiming<bw>::serviceAndTailLength;
+
 } // namespace veins
@@ -25,6 +25,8 @@
 
 #include "veins/veins.h"
 
+#include "veins/base/utils/Logging.h"
+
 namespace veins {
 
 /**
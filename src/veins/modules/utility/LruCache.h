@@ -0,0 +1,157 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * Bounded key-value cache with least-recently-used eviction.
+ *
+ * Lookups and insertions run in (amortized) constant time.
+ * Once capacity entries are stored, inserting a new key evicts the entry that was used least recently.
+ * Keeps track of the number of cache hits and misses observed by find().
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class LruCache {
+public:
+    explicit LruCache(size_t capacity = 1000)
+        : capacity(capacity)
+    {
+    }
+
+    /**
+     * Return a pointer to the value stored for key (marking it as most recently used), or nullptr if there is none.
+     *
+     * The pointer stays valid until the entry is evicted or the cache is cleared.
+     */
+    const Value* find(const Key& key)
+    {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * Store value for key as the most recently used entry, evicting the least recently used entry if the cache is full.
+     */
+    void insert(const Key& key, Value value)
+    {
+        if (capacity == 0) return;
+        auto it = index.find(key);
+        if (it != index.end()) {
+            it->second->second = std::move(value);
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+        if (entries.size() >= capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(key, std::move(value));
+        index.emplace(key, entries.begin());
+    }
+
+    /**
+     * Remove all entries (but keep hit and miss statistics).
+     */
+    void clear()
+    {
+        index.clear();
+        entries.clear();
+    }
+
+    /**
+     * Remove all entries for which predicate(key, value) returns true, returning their number.
+     */
+    template <typename Predicate>
+    size_t eraseIf(Predicate predicate)
+    {
+        size_t erased = 0;
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (!predicate(it->first, it->second)) {
+                ++it;
+                continue;
+            }
+            index.erase(it->first);
+            it = entries.erase(it);
+            ++erased;
+        }
+        return erased;
+    }
+
+    /**
+     * Change the maximum number of entries, evicting least recently used entries if necessary.
+     */
+    void setCapacity(size_t newCapacity)
+    {
+        capacity = newCapacity;
+        while (entries.size() > capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    size_t getCapacity() const
+    {
+        return capacity;
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    size_t getHits() const
+    {
+        return hits;
+    }
+
+    size_t getMisses() const
+    {
+        return misses;
+    }
+
+private:
+    using Entries = std::list<std::pair<Key, Value>>;
+
+    size_t capacity; /**< maximum number of entries */
+    Entries entries; /**< entries, most recently used first */
+    std::unordered_map<Key, typename Entries::iterator, Hash, KeyEqual> index; /**< position of each key in entries */
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,278 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/utility/ReceptionRecordWriter.h"
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+using namespace veins;
+
+namespace {
+
+const char MAGIC[] = "VEINSREC";
+const size_t MAGIC_LENGTH = 8;
+const uint8_t VERSION = 1;
+const size_t NUM_COLUMNS = 6;
+const double MAX_CENTI_DB = 1e9;
+
+void putVarint(uint64_t value, std::string& out)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+uint64_t getVarint(const std::string& in, size_t& pos)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) throw cRuntimeError("ReceptionRecordWriter: truncated file");
+        const uint8_t byte = static_cast<uint8_t>(in[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    throw cRuntimeError("ReceptionRecordWriter: malformed varint");
+}
+
+uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putDeltas(const std::vector<int64_t>& values, std::string& column)
+{
+    int64_t previous = 0;
+    for (int64_t value : values) {
+        putVarint(zigzag(value - previous), column);
+        previous = value;
+    }
+}
+
+int64_t quantize(double dB)
+{
+    // also maps NaN and -inf (e.g., the SINR of an undetected frame) to the lower bound
+    const double centi = dB * 100;
+    if (!(centi >= -MAX_CENTI_DB)) return static_cast<int64_t>(-MAX_CENTI_DB);
+    if (centi > MAX_CENTI_DB) return static_cast<int64_t>(MAX_CENTI_DB);
+    return std::llround(centi);
+}
+
+} // namespace
+
+void ReceptionRecordWriter::Batch::reserve(size_t n)
+{
+    receiverIds.reserve(n);
+    senderIds.reserve(n);
+    times.reserve(n);
+    rssis.reserve(n);
+    sinrs.reserve(n);
+    outcomes.reserve(n);
+}
+
+void ReceptionRecordWriter::Batch::clear()
+{
+    receiverIds.clear();
+    senderIds.clear();
+    times.clear();
+    rssis.clear();
+    sinrs.clear();
+    outcomes.clear();
+}
+
+ReceptionRecordWriter::ReceptionRecordWriter(const std::string& fileName, size_t batchSize)
+    : batchSize(batchSize)
+{
+    if (batchSize == 0) throw cRuntimeError("ReceptionRecordWriter: batchSize must be positive");
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) throw cRuntimeError("ReceptionRecordWriter: cannot open \"%s\" for writing", fileName.c_str());
+    std::fwrite(MAGIC, 1, MAGIC_LENGTH, file);
+    std::fputc(VERSION, file);
+
+    current.reserve(batchSize);
+    writer = std::thread(&ReceptionRecordWriter::writerLoop, this);
+}
+
+ReceptionRecordWriter::~ReceptionRecordWriter()
+{
+    if (!file) return;
+    try {
+        close();
+    }
+    catch (const std::exception&) {
+        // nobody left to tell
+    }
+}
+
+void ReceptionRecordWriter::append(const ReceptionRecord& record)
+{
+    ASSERT(file);
+    current.receiverIds.push_back(record.receiverId);
+    current.senderIds.push_back(record.senderId);
+    current.times.push_back(record.time);
+    current.rssis.push_back(quantize(record.rssi_dBm));
+    current.sinrs.push_back(quantize(record.sinr_dB));
+    current.outcomes.push_back(static_cast<uint8_t>(record.outcome));
+    ++numRecords;
+    if (current.size() >= batchSize) handOver();
+}
+
+void ReceptionRecordWriter::handOver()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(current));
+        if (!spare.empty()) {
+            current = std::move(spare.back());
+            spare.pop_back();
+        }
+        else {
+            current = Batch();
+        }
+    }
+    wakeup.notify_one();
+    current.clear();
+    current.reserve(batchSize);
+}
+
+void ReceptionRecordWriter::close()
+{
+    if (!file) return;
+    if (current.size() > 0) handOver();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    writer.join();
+
+    const bool closeFailed = std::fclose(file) != 0;
+    file = nullptr;
+    if (writeFailed || closeFailed) throw cRuntimeError("ReceptionRecordWriter: could not write all records");
+}
+
+void ReceptionRecordWriter::writerLoop()
+{
+    std::string block;
+    while (true) {
+        Batch batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) return;
+            batch = std::move(pending.front());
+            pending.pop_front();
+        }
+
+        block.clear();
+        encode(batch, block);
+        const bool ok = std::fwrite(block.data(), 1, block.size(), file) == block.size();
+
+        batch.clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ok) writeFailed = true;
+        spare.push_back(std::move(batch));
+    }
+}
+
+void ReceptionRecordWriter::encode(const Batch& batch, std::string& out) const
+{
+    putVarint(batch.size(), out);
+
+    std::string column;
+    auto putColumn = [&out, &column]() {
+        putVarint(column.size(), out);
+        out += column;
+        column.clear();
+    };
+    putDeltas(batch.receiverIds, column);
+    putColumn();
+    putDeltas(batch.senderIds, column);
+    putColumn();
+    putDeltas(batch.times, column);
+    putColumn();
+    putDeltas(batch.rssis, column);
+    putColumn();
+    putDeltas(batch.sinrs, column);
+    putColumn();
+    column.assign(batch.outcomes.begin(), batch.outcomes.end());
+    putColumn();
+}
+
+std::vector<ReceptionRecord> ReceptionRecordWriter::readFile(const std::string& fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in) throw cRuntimeError("ReceptionRecordWriter: cannot open \"%s\" for reading", fileName.c_str());
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < MAGIC_LENGTH + 1 || data.compare(0, MAGIC_LENGTH, MAGIC) != 0) throw cRuntimeError("ReceptionRecordWriter: \"%s\" is not a reception record file", fileName.c_str());
+    if (static_cast<uint8_t>(data[MAGIC_LENGTH]) != VERSION) throw cRuntimeError("ReceptionRecordWriter: unsupported version of \"%s\"", fileName.c_str());
+
+    std::vector<ReceptionRecord> records;
+    size_t pos = MAGIC_LENGTH + 1;
+    while (pos < data.size()) {
+        const size_t n = getVarint(data, pos);
+        const size_t first = records.size();
+        records.resize(first + n);
+        for (size_t c = 0; c < NUM_COLUMNS; ++c) {
+            const size_t length = getVarint(data, pos);
+            const size_t end = pos + length;
+            if (end > data.size()) throw cRuntimeError("ReceptionRecordWriter: truncated file");
+            int64_t value = 0;
+            for (size_t i = first; i < first + n; ++i) {
+                ReceptionRecord& record = records[i];
+                if (c == NUM_COLUMNS - 1) {
+                    if (pos >= end) throw cRuntimeError("ReceptionRecordWriter: truncated column");
+                    record.outcome = static_cast<ReceptionRecord::Outcome>(data[pos++]);
+                    continue;
+                }
+                value += unzigzag(getVarint(data, pos));
+                switch (c) {
+                case 0:
+                    record.receiverId = static_cast<int32_t>(value);
+                    break;
+                case 1:
+                    record.senderId = static_cast<int32_t>(value);
+                    break;
+                case 2:
+                    record.time = value;
+                    break;
+                case 3:
+                    record.rssi_dBm = value / 100.0;
+                    break;
+                default:
+                    record.sinr_dB = value / 100.0;
+                    break;
+                }
+            }
+            if (pos != end) throw cRuntimeError("ReceptionRecordWriter: malformed column");
+        }
+    }
+    return records;
+}
@@ -0,0 +1,146 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * @brief One reception of a frame, as recorded by a ReceptionRecorder.
+ */
+struct VEINS_API ReceptionRecord {
+    enum class Outcome : uint8_t {
+        received = 0, ///< decoded correctly
+        bitError, ///< not decoded: too little power for the bitrate
+        collision, ///< not decoded: too much interference
+        whileSending, ///< arrived while the receiver was transmitting
+        notSynced, ///< arrived while the receiver was synced to another frame
+        undetected, ///< below the minimum power level of the receiver
+    };
+
+    int32_t receiverId = -1; ///< id of the receiving module
+    int32_t senderId = -1; ///< id of the sending module
+    int64_t time = 0; ///< end of the reception, in raw simulation time
+    double rssi_dBm = 0; ///< received power
+    double sinr_dB = 0; ///< minimum SINR over the frame (if it was decoded at all)
+    Outcome outcome = Outcome::received;
+};
+
+/**
+ * @brief Writes ReceptionRecords to a file in a compact columnar format, on a background thread.
+ *
+ * Records are gathered in batches of batchSize; full batches are handed to a writer thread, which encodes and writes them.
+ * The calling thread only waits for a mutex to pass on a batch, never for the file.
+ *
+ * The file starts with the 8 bytes "VEINSREC" followed by a version byte (1), and then holds one block per batch.
+ * All integers are LEB128 varints; signed values are zigzag encoded.
+ * A block holds its number of records, then 6 columns (receiverId, senderId, time, rssi, sinr, outcome), each preceded by its length in bytes.
+ * All columns but the outcome (one byte per record) hold the differences between successive values of the block (the first one relative to 0),
+ * rssi and sinr being quantized to hundredths of a dB (and clamped to +-10^7 dB).
+ */
+class VEINS_API ReceptionRecordWriter {
+public:
+    /**
+     * @brief Opens (and truncates) the file and starts the writer thread.
+     */
+    ReceptionRecordWriter(const std::string& fileName, size_t batchSize = 65536);
+
+    /**
+     * @brief Writes all pending records and closes the file, see close().
+     */
+    ~ReceptionRecordWriter();
+
+    ReceptionRecordWriter(const ReceptionRecordWriter&) = delete;
+    ReceptionRecordWriter& operator=(const ReceptionRecordWriter&) = delete;
+
+    void append(const ReceptionRecord& record);
+
+    /**
+     * @brief Writes all pending records, stops the writer thread, and closes the file.
+     *
+     * Throws if writing failed; afterwards, no more records may be appended.
+     */
+    void close();
+
+    /**
+     * @brief Returns the number of records appended so far.
+     */
+    uint64_t getNumRecords() const
+    {
+        return numRecords;
+    }
+
+    /**
+     * @brief Reads back all records of a file written by a ReceptionRecordWriter (for tests and tools).
+     */
+    static std::vector<ReceptionRecord> readFile(const std::string& fileName);
+
+private:
+    /**
+     * @brief Records of one block, stored by column.
+     */
+    struct Batch {
+        std::vector<int64_t> receiverIds;
+        std::vector<int64_t> senderIds;
+        std::vector<int64_t> times;
+        std::vector<int64_t> rssis; ///< hundredths of dBm
+        std::vector<int64_t> sinrs; ///< hundredths of dB
+        std::vector<uint8_t> outcomes;
+
+        size_t size() const
+        {
+            return outcomes.size();
+        }
+        void reserve(size_t n);
+        void clear();
+    };
+
+    void writerLoop();
+    void encode(const Batch& batch, std::string& out) const;
+    void handOver();
+
+    size_t batchSize;
+    std::FILE* file;
+    uint64_t numRecords = 0;
+    Batch current; ///< batch being filled by the calling thread
+
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<Batch> pending; ///< full batches waiting to be written
+    std::vector<Batch> spare; ///< written batches, kept to reuse their storage
+    bool stopping = false;
+    bool writeFailed = false;
+};
+
+} // namespace veins
@@ -0,0 +1,83 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/utility/ReceptionRecorder.h"
+
+#include "veins/base/utils/CounterRng.h"
+
+using namespace veins;
+
+Define_Module(veins::ReceptionRecorder);
+
+namespace {
+
+const char* const OUTCOME_NAMES[] = {"received", "bitError", "collision", "whileSending", "notSynced", "undetected"};
+
+} // namespace
+
+ReceptionRecorder* ReceptionRecorder::find()
+{
+    for (cModule* const module : ModuleRegistry::getGlobalModules()) {
+        if (auto recorder = dynamic_cast<ReceptionRecorder*>(module)) return recorder;
+    }
+    return nullptr;
+}
+
+void ReceptionRecorder::initialize()
+{
+    for (const std::string& name : cStringTokenizer(par("outcomes").stringValue()).asVector()) {
+        size_t i = 0;
+        while (i < recordOutcome.size() && name != OUTCOME_NAMES[i]) ++i;
+        if (i == recordOutcome.size()) throw cRuntimeError("Unknown outcome \"%s\" (must be one of \"received\", \"bitError\", \"collision\", \"whileSending\", \"notSynced\", \"undetected\")", name.c_str());
+        recordOutcome[i] = true;
+    }
+
+    sampling = par("sampling").doubleValue();
+    if (sampling < 0 || sampling > 1) throw cRuntimeError("sampling must be between 0 and 1");
+    if (sampling < 1) samplingSeed = CounterRng::drawSeed(getRNG(0));
+
+    int batchSize = par("batchSize");
+    if (batchSize <= 0) throw cRuntimeError("batchSize must be positive");
+    writer = make_unique<ReceptionRecordWriter>(par("fileName").stdstringValue(), batchSize);
+}
+
+void ReceptionRecorder::handleMessage(cMessage* msg)
+{
+    throw cRuntimeError("ReceptionRecorder does not handle messages");
+}
+
+void ReceptionRecorder::record(const ReceptionRecord& record, long transmissionId)
+{
+    if (!writer || !recordOutcome[static_cast<size_t>(record.outcome)]) return;
+    if (sampling < 1) {
+        CounterRng rng(samplingSeed, CounterRng::Purpose::sampling, static_cast<uint32_t>(transmissionId), static_cast<uint32_t>(record.receiverId));
+        if (rng.dblrand() >= sampling) return;
+    }
+    writer->append(record);
+}
+
+void ReceptionRecorder::finish()
+{
+    if (!writer) return;
+    recordScalar("recordedReceptions", writer->getNumRecords());
+    writer->close();
+}
@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/ModuleRegistry.h"
+#include "veins/modules/utility/ReceptionRecordWriter.h"
+
+namespace veins {
+
+/**
+ * @brief Records every reception of a frame (receiver, sender, time, RSSI, SINR, outcome) to a file of its own.
+ *
+ * Meant for statistics that would otherwise take a cOutVector entry per reception.
+ * Records are written by a ReceptionRecordWriter on a background thread, so the simulation never waits for the file.
+ * Which receptions are recorded is chosen by their outcome and by sampling; sampling decides per (transmission, receiver)
+ * with a CounterRng of its own, so enabling it does not change the simulation's random numbers.
+ *
+ * Deciders find the recorder with find(); if the network has none, nothing is recorded.
+ *
+ * @see Decider80211p
+ */
+class VEINS_API ReceptionRecorder : public cSimpleModule {
+public:
+    /**
+     * @brief Returns the recorder of the network, or nullptr if there is none.
+     *
+     * Only consults the ModuleRegistry, so it is cheap for networks without a recorder.
+     */
+    static ReceptionRecorder* find();
+
+    /**
+     * @brief Records the reception if its outcome is recorded and it is sampled.
+     *
+     * @param transmissionId the same for all receptions of one transmission (e.g., the AirFrame's tree id)
+     */
+    void record(const ReceptionRecord& record, long transmissionId);
+
+    /**
+     * @brief Returns the number of receptions recorded so far.
+     */
+    uint64_t getNumRecorded() const
+    {
+        return writer ? writer->getNumRecords() : 0;
+    }
+
+protected:
+    void initialize() override;
+    void handleMessage(cMessage* msg) override;
+    void finish() override;
+
+    std::unique_ptr<ReceptionRecordWriter> writer;
+    std::array<bool, 6> recordOutcome = {}; ///< whether to record receptions with an outcome, indexed by ReceptionRecord::Outcome
+    double sampling = 1; ///< fraction of receptions to record
+    uint64_t samplingSeed = 0;
+
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
+};
+
+} // namespace veins
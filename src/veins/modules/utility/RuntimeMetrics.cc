@@ -0,0 +1,180 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/utility/RuntimeMetrics.h"
+
+#include <cstdio>
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "veins/base/connectionManager/BaseConnectionManager.h"
+#include "veins/base/utils/FindModule.h"
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+
+using namespace veins;
+
+Define_Module(veins::RuntimeMetrics);
+
+namespace {
+
+const simsignal_t traciTimestepBeginSignal = cComponent::registerSignal("org_car2x_veins_modules_mobility_traciTimestepBegin");
+const simsignal_t traciTimestepEndSignal = cComponent::registerSignal("org_car2x_veins_modules_mobility_traciTimestepEnd");
+const simsignal_t traciStepWaitTimeSignal = cComponent::registerSignal("org_car2x_veins_modules_mobility_traciStepWaitTime");
+
+void writeGauge(std::ostream& out, const char* name, const char* help, double value)
+{
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " gauge\n";
+    out << name << " " << value << "\n";
+}
+
+} // namespace
+
+void RuntimeMetrics::initialize()
+{
+    fileName = par("fileName").stdstringValue();
+    double intervalSeconds = par("interval");
+    if (intervalSeconds <= 0) throw cRuntimeError("interval must be positive");
+    interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(intervalSeconds));
+    triggerSignal = registerSignal(par("triggerSignal").stringValue());
+
+    lastExportWallTime = std::chrono::steady_clock::now();
+    lastExportSimTime = simTime();
+    lastExportEventNumber = getSimulation()->getEventNumber();
+    stepWallTime = std::chrono::steady_clock::duration::zero();
+
+    cModule* systemModule = getSimulation()->getSystemModule();
+    systemModule->subscribe(traciTimestepBeginSignal, this);
+    systemModule->subscribe(traciTimestepEndSignal, this);
+    systemModule->subscribe(traciStepWaitTimeSignal, this);
+    if (triggerSignal != traciTimestepEndSignal) systemModule->subscribe(triggerSignal, this);
+}
+
+void RuntimeMetrics::handleMessage(cMessage* msg)
+{
+    throw cRuntimeError("RuntimeMetrics does not handle messages");
+}
+
+void RuntimeMetrics::finish()
+{
+    exportMetrics();
+
+    cModule* systemModule = getSimulation()->getSystemModule();
+    systemModule->unsubscribe(traciTimestepBeginSignal, this);
+    systemModule->unsubscribe(traciTimestepEndSignal, this);
+    systemModule->unsubscribe(traciStepWaitTimeSignal, this);
+    if (triggerSignal != traciTimestepEndSignal) systemModule->unsubscribe(triggerSignal, this);
+}
+
+void RuntimeMetrics::receiveSignal(cComponent* source, simsignal_t signalID, bool b, cObject* details)
+{
+    if (signalID == triggerSignal) checkExport();
+}
+
+void RuntimeMetrics::receiveSignal(cComponent* source, simsignal_t signalID, long l, cObject* details)
+{
+    if (signalID == triggerSignal) checkExport();
+}
+
+void RuntimeMetrics::receiveSignal(cComponent* source, simsignal_t signalID, double d, cObject* details)
+{
+    if (signalID == traciStepWaitTimeSignal) {
+        stepWaitTime += d;
+        numStepWaits++;
+    }
+    if (signalID == triggerSignal) checkExport();
+}
+
+void RuntimeMetrics::receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details)
+{
+    if (signalID == traciTimestepBeginSignal) {
+        stepWallStart = std::chrono::steady_clock::now();
+        inStep = true;
+    }
+    else if (signalID == traciTimestepEndSignal && inStep) {
+        stepWallTime += std::chrono::steady_clock::now() - stepWallStart;
+        numSteps++;
+        inStep = false;
+    }
+    if (signalID == triggerSignal) checkExport();
+}
+
+void RuntimeMetrics::receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details)
+{
+    if (signalID == triggerSignal) checkExport();
+}
+
+void RuntimeMetrics::checkExport()
+{
+    if (std::chrono::steady_clock::now() - lastExportWallTime < interval) return;
+    exportMetrics();
+}
+
+void RuntimeMetrics::exportMetrics()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const double wallSeconds = std::chrono::duration<double>(now - lastExportWallTime).count();
+    const int64_t eventNumber = getSimulation()->getEventNumber();
+
+    // look the other modules up lazily, they may not have been created when this module was initialized
+    if (!manager) manager = FindModule<TraCIScenarioManager*>::findGlobalModule();
+    if (!connectionManager) connectionManager = FindModule<BaseConnectionManager*>::findGlobalModule();
+
+    // write to a temporary file first, so readers never see a partially written one
+    const std::string tmpFileName = fileName + ".tmp";
+    {
+        std::ofstream out(tmpFileName, std::ios::trunc);
+        if (!out) throw cRuntimeError("Could not open \"%s\" for writing", tmpFileName.c_str());
+        writeGauge(out, "veins_simulated_seconds", "Current simulation time", simTime().dbl());
+        writeGauge(out, "veins_simulated_seconds_per_wall_second", "Simulated seconds per wall-clock second since the last export", wallSeconds > 0 ? (simTime() - lastExportSimTime).dbl() / wallSeconds : 0);
+        writeGauge(out, "veins_events_per_wall_second", "Events per wall-clock second since the last export", wallSeconds > 0 ? (eventNumber - lastExportEventNumber) / wallSeconds : 0);
+        writeGauge(out, "veins_future_events", "Number of events in the future event set", getSimulation()->getFES()->getLength());
+        if (manager) writeGauge(out, "veins_managed_vehicles", "Number of vehicles with a module", manager->getManagedHosts().size());
+        if (numSteps > 0) writeGauge(out, "veins_traci_step_seconds", "Mean wall-clock time of a TraCI step since the last export", std::chrono::duration<double>(stepWallTime).count() / numSteps);
+        if (numStepWaits > 0) writeGauge(out, "veins_traci_wait_seconds", "Mean wall-clock time spent waiting for the TraCI server per step since the last export", stepWaitTime / numStepWaits);
+        if (connectionManager) writeGauge(out, "veins_connections", "Number of connections between nics", connectionManager->getNumConnections());
+        if (uint64_t rss = getResidentSetSize()) writeGauge(out, "veins_resident_set_bytes", "Resident set size of the simulation process", rss);
+    }
+    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) throw cRuntimeError("Could not rename \"%s\" to \"%s\"", tmpFileName.c_str(), fileName.c_str());
+
+    lastExportWallTime = now;
+    lastExportSimTime = simTime();
+    lastExportEventNumber = eventNumber;
+    stepWallTime = std::chrono::steady_clock::duration::zero();
+    numSteps = 0;
+    stepWaitTime = 0;
+    numStepWaits = 0;
+}
+
+uint64_t RuntimeMetrics::getResidentSetSize()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (statm >> size >> resident) return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
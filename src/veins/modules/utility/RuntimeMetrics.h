@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+class BaseConnectionManager;
+class TraCIScenarioManager;
+
+/**
+ * @brief Regularly writes runtime metrics of a (long-running) simulation to a file in the Prometheus text format.
+ *
+ * Metrics are exported at a wall-clock interval, checked whenever triggerSignal is emitted (by default, at the end of
+ * each TraCI step), so the module schedules no events of its own. The file is rewritten atomically, so it can be read at any
+ * time, e.g., by the textfile collector of a Prometheus node exporter.
+ *
+ * Exported are simulated seconds per wall second, events per wall second, the size of the future event set, the number of
+ * managed vehicles, the wall time of TraCI steps (and the time spent waiting for the TraCI server, if recordStepTimes of
+ * the TraCIScenarioManager is set), the number of connections of the connection manager, and the resident set size.
+ */
+class VEINS_API RuntimeMetrics : public cSimpleModule, public cListener {
+public:
+    void receiveSignal(cComponent* source, simsignal_t signalID, bool b, cObject* details) override;
+    void receiveSignal(cComponent* source, simsignal_t signalID, long l, cObject* details) override;
+    void receiveSignal(cComponent* source, simsignal_t signalID, double d, cObject* details) override;
+    void receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details) override;
+    void receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details) override;
+
+protected:
+    void initialize() override;
+    void handleMessage(cMessage* msg) override;
+    void finish() override;
+
+    /** @brief Exports the metrics if the interval has passed since the last export */
+    void checkExport();
+
+    /** @brief Writes the metrics accumulated since the last export */
+    void exportMetrics();
+
+    /** @brief Returns the resident set size of this process in bytes (0 if unknown) */
+    static uint64_t getResidentSetSize();
+
+    std::string fileName;
+    std::chrono::steady_clock::duration interval;
+    simsignal_t triggerSignal;
+    TraCIScenarioManager* manager = nullptr;
+    BaseConnectionManager* connectionManager = nullptr;
+
+    std::chrono::steady_clock::time_point lastExportWallTime;
+    simtime_t lastExportSimTime;
+    int64_t lastExportEventNumber = 0;
+
+    std::chrono::steady_clock::time_point stepWallStart;
+    bool inStep = false;
+    std::chrono::steady_clock::duration stepWallTime; ///< total wall time of the TraCI steps since the last export
+    uint64_t numSteps = 0; ///< number of TraCI steps since the last export
+    double stepWaitTime = 0; ///< total time spent waiting for the TraCI server since the last export
+    uint64_t numStepWaits = 0;
+};
+
+} // namespace veins
@@ -25,6 +25,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace veins {
 
@@ -36,25 +37,57 @@ struct SignalPayload {
     cObject* details;
 };
 
-template <typename Payload>
-class SignalCallbackListener : public cListener {
+/**
+ * Base of the listeners managed by SignalManager: subscribes to one signal of one module.
+ *
+ * Subscribes upon construction and unsubscribes (if still subscribed) upon destruction.
+ */
+class VEINS_API SignalListenerBase : public cListener {
 public:
-    using Callback = std::function<void (SignalPayload<Payload>)>;
-    SignalCallbackListener(Callback callback, cModule* receptor, simsignal_t signal)
-        : callback(callback)
-        , receptor(receptor)
+    SignalListenerBase(cModule* receptor, simsignal_t signal)
+        : receptor(receptor)
         , signal(signal)
     {
-        receptor->subscribe(signal, this);
     }
 
-    ~SignalCallbackListener()
+    ~SignalListenerBase() override
+    {
+        unsubscribe();
+    }
+
+    /**
+     * Subscribes again after unsubscribe() (has no effect if still subscribed).
+     */
+    void subscribe()
+    {
+        if (getSubscribeCount() == 0) {
+            receptor->subscribe(signal, this);
+        }
+    }
+
+    void unsubscribe()
     {
         if (getSubscribeCount() > 0) {
             receptor->unsubscribe(signal, this);
         }
     }
 
+protected:
+    cModule* const receptor;
+    const simsignal_t signal;
+};
+
+template <typename Payload>
+class SignalCallbackListener : public SignalListenerBase {
+public:
+    using Callback = std::function<void (SignalPayload<Payload>)>;
+    SignalCallbackListener(Callback callback, cModule* receptor, simsignal_t signal)
+        : SignalListenerBase(receptor, signal)
+        , callback(callback)
+    {
+        subscribe();
+    }
+
     virtual void receiveSignal(cComponent* source, simsignal_t signalID, Payload p, cObject* details) override
     {
         ASSERT(signalID == signal);
@@ -63,8 +96,34 @@ public:
 
 private:
     const Callback callback;
-    cModule* const receptor;
-    const simsignal_t signal;
+};
+
+/**
+ * Listener calling a member function of a receiver, without the indirection (and copies) of std::function.
+ *
+ * The payload is passed by reference, the receiver must outlive the listener.
+ */
+template <typename Payload, typename Receiver>
+class SignalMemberListener : public SignalListenerBase {
+public:
+    using Method = void (Receiver::*)(const SignalPayload<Payload>&);
+    SignalMemberListener(Receiver* receiver, Method method, cModule* receptor, simsignal_t signal)
+        : SignalListenerBase(receptor, signal)
+        , receiver(receiver)
+        , method(method)
+    {
+        subscribe();
+    }
+
+    void receiveSignal(cComponent* source, simsignal_t signalID, Payload p, cObject* details) override
+    {
+        // every listener is subscribed to a single signal, so there is no need to check signalID
+        (receiver->*method)(SignalPayload<Payload>{source, signalID, p, details});
+    }
+
+private:
+    Receiver* const receiver;
+    const Method method;
 };
 
 class VEINS_API SignalManager {
@@ -105,8 +164,49 @@ public:
         callbacks.emplace_back(std::move(callbackListener));
     }
 
+    /**
+     * Subscribes a member function of receiver, e.g., subscribeMember(host, BaseMobility::mobilityStateChangedSignal, this, &MyApp::onMobilityChanged).
+     *
+     * The payload type is deduced from the member function, which needs to take a const SignalPayload<Payload>& with Payload one of the types of cIListener::receiveSignal.
+     * Preferable to subscribeCallback for high-rate signals.
+     */
+    template <typename Payload, typename Receiver>
+    void subscribeMember(cModule* receptor, simsignal_t signal, Receiver* receiver, void (Receiver::*method)(const SignalPayload<Payload>&))
+    {
+        auto memberListener = make_unique<SignalMemberListener<Payload, Receiver>>(receiver, method, receptor, signal);
+        callbacks.emplace_back(std::move(memberListener));
+    }
+
+    /**
+     * Temporarily unsubscribes all callbacks, e.g., while a module is kept for reuse.
+     */
+    void unsubscribeAll()
+    {
+        for (auto& callback : callbacks) {
+            callback->unsubscribe();
+        }
+    }
+
+    /**
+     * Subscribes all callbacks again after unsubscribeAll().
+     */
+    void resubscribeAll()
+    {
+        for (auto& callback : callbacks) {
+            callback->subscribe();
+        }
+    }
+
+    /**
+     * Unsubscribes and removes all callbacks.
+     */
+    void clear()
+    {
+        callbacks.clear();
+    }
+
 private:
-    std::vector<std::unique_ptr<cListener>> callbacks;
+    std::vector<std::unique_ptr<SignalListenerBase>> callbacks;
 };
 
 } // namespace veins
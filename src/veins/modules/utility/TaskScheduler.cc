@@ -0,0 +1,89 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/utility/TaskScheduler.h"
+
+#include "veins/base/utils/WorkerPool.h"
+
+using namespace veins;
+
+Define_Module(veins::TaskScheduler);
+
+TaskScheduler* TaskScheduler::find()
+{
+    for (cModule* const module : ModuleRegistry::getGlobalModules()) {
+        if (auto scheduler = dynamic_cast<TaskScheduler*>(module)) return scheduler;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<WorkerPool> TaskScheduler::getSharedPool(const cModule* user)
+{
+    TaskScheduler* scheduler = find();
+    if (!scheduler) throw cRuntimeError("%s is configured to use the shared worker threads (-1), but the network has no TaskScheduler", user->getFullPath().c_str());
+    return scheduler->getPool();
+}
+
+std::shared_ptr<WorkerPool> TaskScheduler::getPool()
+{
+    // users may ask during their initialization, before this module's
+    if (poolCreated) return pool;
+    poolCreated = true;
+
+    const int numThreads = par("numThreads");
+    if (numThreads < 0) throw cRuntimeError("numThreads must not be negative");
+    if (par("serial").boolValue() || numThreads == 0) return pool;
+
+    pool = std::make_shared<WorkerPool>(numThreads);
+    std::vector<int> cpus;
+    for (const std::string& cpu : cStringTokenizer(par("cpuAffinity").stringValue()).asVector()) {
+        try {
+            cpus.push_back(std::stoi(cpu));
+        }
+        catch (const std::exception&) {
+            throw cRuntimeError("cpuAffinity must be a list of CPU numbers, but contains \"%s\"", cpu.c_str());
+        }
+    }
+    if (!pool->setAffinity(cpus)) {
+        EV_WARN << "Could not pin worker threads to CPUs " << par("cpuAffinity").stringValue() << endl;
+    }
+    return pool;
+}
+
+void TaskScheduler::initialize()
+{
+    getPool();
+    taskRngSeed = CounterRng::drawSeed(getRNG(0));
+    initialized = true;
+    EV_INFO << "Running parallel tasks on " << (pool ? pool->getNumThreads() : 0) << " worker threads" << endl;
+}
+
+void TaskScheduler::handleMessage(cMessage* msg)
+{
+    throw cRuntimeError("TaskScheduler does not handle messages");
+}
+
+CounterRng TaskScheduler::getTaskRng(uint32_t runId, uint32_t task) const
+{
+    ASSERT(initialized);
+    return CounterRng(taskRngSeed, CounterRng::Purpose::task, runId, task);
+}
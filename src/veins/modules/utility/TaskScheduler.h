@@ -0,0 +1,93 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/CounterRng.h"
+#include "veins/base/utils/ModuleRegistry.h"
+
+namespace veins {
+
+class WorkerPool;
+
+/**
+ * @brief Worker threads shared by all parallel features of a simulation, configured in one place.
+ *
+ * Subsystems that run work in parallel (ObstacleControl, TraCIScenarioManager, BaseConnectionManager) use the pool of
+ * the scheduler instead of starting threads of their own if their number of threads is set to -1.
+ * Tasks are handed out to the threads one at a time as they become idle, so uneven tasks balance themselves.
+ *
+ * Determinism contract for tasks run on the pool:
+ * - a task writes its results only to a slot of its own (e.g., indexed by its task number), which the caller applies
+ *   on the simulation thread in task order after the run returns;
+ * - random numbers are drawn only from the stream returned by getTaskRng() for the task, never from module RNGs.
+ * Results then do not depend on the number of threads or on which thread ran a task, and serial runs are identical.
+ *
+ * @see WorkerPool
+ */
+class VEINS_API TaskScheduler : public cSimpleModule {
+public:
+    /**
+     * @brief Returns the scheduler of the network, or nullptr if there is none.
+     */
+    static TaskScheduler* find();
+
+    /**
+     * @brief Returns the shared pool for a subsystem whose number of threads was set to -1, or nullptr to run serially.
+     *
+     * Throws if the network has no scheduler. May be called before the scheduler is initialized.
+     *
+     * @param user the module asking, for error messages
+     */
+    static std::shared_ptr<WorkerPool> getSharedPool(const cModule* user);
+
+    /**
+     * @brief Returns the pool (creating it on first use), or nullptr if tasks are to be run serially.
+     */
+    std::shared_ptr<WorkerPool> getPool();
+
+    /**
+     * @brief Returns the random numbers of task number task of the run identified by runId (e.g., a transmission id).
+     *
+     * The same arguments always yield the same numbers, no matter which thread draws them or in which order.
+     * Only valid once the scheduler is initialized.
+     */
+    CounterRng getTaskRng(uint32_t runId, uint32_t task) const;
+
+protected:
+    void initialize() override;
+    void handleMessage(cMessage* msg) override;
+
+    std::shared_ptr<WorkerPool> pool; /**< nullptr until created by getPool(), or if tasks are run serially */
+    bool poolCreated = false;
+    uint64_t taskRngSeed = 0;
+    bool initialized = false;
+
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
+};
+
+} // namespace veins
@@ -160,8 +160,11 @@ omnetpp::simtime_t TimerSpecification::next()
     return next_absolute;
 }
 
-TimerManager::TimerManager(omnetpp::cSimpleModule* parent)
+TimerManager::TimerManager(omnetpp::cSimpleModule* parent, Backend backend)
     : parent_(parent)
+    , backend_(backend)
+    , multiplexMessage_(nullptr)
+    , nextHandle_(1)
 {
     ASSERT(parent_);
 }
@@ -171,10 +174,18 @@ TimerManager::~TimerManager()
     for (const auto& timer : timers_) {
         parent_->cancelAndDelete(timer.first);
     }
+    if (multiplexMessage_) {
+        parent_->cancelAndDelete(multiplexMessage_);
+    }
 }
 
 bool TimerManager::handleMessage(omnetpp::cMessage* message)
 {
+    if (multiplexMessage_ && message == multiplexMessage_) {
+        handleMultiplexedTimers();
+        return true;
+    }
+
     auto* timerMessage = dynamic_cast<TimerMessage*>(message);
     if (!timerMessage) {
         return false;
@@ -204,11 +215,67 @@ bool TimerManager::handleMessage(omnetpp::cMessage* message)
     return true;
 }
 
+void TimerManager::handleMultiplexedTimers()
+{
+    while (!deadlines_.empty() && deadlines_.begin()->first <= simTime()) {
+        const TimerHandle handle = deadlines_.begin()->second;
+        deadlines_.erase(deadlines_.begin());
+
+        auto timer = multiplexedTimers_.find(handle);
+        ASSERT(timer != multiplexedTimers_.end());
+        timer->second.deadline = deadlines_.end();
+        ASSERT(timer->second.specification.valid() && timer->second.specification.validOccurence(simTime()));
+
+        timer->second.specification.callback_(handle);
+
+        timer = multiplexedTimers_.find(handle); // the callback might have created or cancelled timers
+        if (timer != multiplexedTimers_.end()) {
+            const auto nextEvent = timer->second.specification.next();
+            if (nextEvent < 0) {
+                multiplexedTimers_.erase(timer);
+            }
+            else {
+                timer->second.deadline = deadlines_.emplace(nextEvent, handle);
+            }
+        }
+    }
+
+    rescheduleMultiplexMessage();
+}
+
+void TimerManager::rescheduleMultiplexMessage()
+{
+    if (!multiplexMessage_) {
+        multiplexMessage_ = new TimerMessage("multiplexed timers");
+    }
+
+    if (deadlines_.empty()) {
+        if (multiplexMessage_->isScheduled()) parent_->cancelEvent(multiplexMessage_);
+        return;
+    }
+
+    const simtime_t earliest = deadlines_.begin()->first;
+    if (multiplexMessage_->isScheduled()) {
+        if (multiplexMessage_->getArrivalTime() == earliest) return;
+        parent_->cancelEvent(multiplexMessage_);
+    }
+    parent_->scheduleAt(earliest, multiplexMessage_);
+}
+
 TimerManager::TimerHandle TimerManager::create(TimerSpecification timerSpecification, const std::string name)
 {
     ASSERT(timerSpecification.valid());
     timerSpecification.finalize();
 
+    if (backend_ == Backend::multiplexed) {
+        const TimerHandle handle = nextHandle_++;
+        const simtime_t start = timerSpecification.start_;
+        MultiplexedTimer timer{std::move(timerSpecification), deadlines_.emplace(start, handle)};
+        multiplexedTimers_.emplace(handle, std::move(timer));
+        rescheduleMultiplexMessage();
+        return handle;
+    }
+
     const auto ret = timers_.insert(std::make_pair(new TimerMessage(name), std::move(timerSpecification)));
     ASSERT(ret.second);
     parent_->scheduleAt(ret.first->second.start_, ret.first->first);
@@ -218,6 +285,17 @@ TimerManager::TimerHandle TimerManager::create(TimerSpecification timerSpecifica
 
 void TimerManager::cancel(TimerManager::TimerHandle handle)
 {
+    if (backend_ == Backend::multiplexed) {
+        auto timer = multiplexedTimers_.find(handle);
+        if (timer != multiplexedTimers_.end()) {
+            // a timer cancelled from its own callback has no deadline
+            if (timer->second.deadline != deadlines_.end()) deadlines_.erase(timer->second.deadline);
+            multiplexedTimers_.erase(timer);
+            rescheduleMultiplexMessage();
+        }
+        return;
+    }
+
     const auto entryMatchesHandle = [handle](const std::pair<TimerMessage*, TimerSpecification>& entry) { return entry.first->getId() == handle; };
     auto timer = std::find_if(timers_.begin(), timers_.end(), entryMatchesHandle);
     if (timer != timers_.end()) {
@@ -24,6 +24,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #include "veins/veins.h"
 
@@ -220,7 +221,21 @@ public:
     using TimerList = std::map<TimerMessage*, TimerSpecification>;
     using TimerHandle = long;
 
-    TimerManager(omnetpp::cSimpleModule* parent);
+    /**
+     * How timers are mapped to events.
+     */
+    enum class Backend {
+        messages, ///< one self-message per timer
+        multiplexed ///< one self-message for all timers of this TimerManager, scheduled for the earliest of them
+    };
+
+    /**
+     * Create a TimerManager for the given module.
+     *
+     * With Backend::multiplexed, the future event set holds at most one event per TimerManager, no matter how many timers are active, and (periodic) timers do not need a message of their own.
+     * This pays off for modules running many timers.
+     */
+    TimerManager(omnetpp::cSimpleModule* parent, Backend backend = Backend::messages);
 
     /**
      * Destroy this module.
@@ -241,7 +256,7 @@ public:
      * Create a new timer.
      *
      * @param timerSpecification Parameters for the new timer
-     * @param name The timer's name
+     * @param name The timer's name (ignored by Backend::multiplexed)
      * @return A handle for the timer.
      *
      * @see cancel
@@ -259,8 +274,34 @@ public:
     void cancel(TimerHandle handle);
 
 private:
+    using Deadlines = std::multimap<omnetpp::simtime_t, TimerHandle>;
+
+    /**
+     * A timer of Backend::multiplexed.
+     */
+    struct MultiplexedTimer {
+        TimerSpecification specification;
+        Deadlines::iterator deadline; ///< entry in deadlines_, for cancelling in constant time
+    };
+
+    /**
+     * Fires all multiplexed timers that are due.
+     */
+    void handleMultiplexedTimers();
+
+    /**
+     * Makes sure multiplexMessage_ is scheduled for the earliest deadline (if any).
+     */
+    void rescheduleMultiplexMessage();
+
     TimerList timers_; ///< List of all active Timers.
     omnetpp::cSimpleModule* const parent_; ///< A pointer to the module which owns this TimerManager.
+    const Backend backend_; ///< How timers are mapped to events.
+
+    TimerMessage* multiplexMessage_; ///< The self-message of Backend::multiplexed.
+    std::unordered_map<TimerHandle, MultiplexedTimer> multiplexedTimers_; ///< Active timers of Backend::multiplexed, by handle.
+    Deadlines deadlines_; ///< Next occurence of every multiplexed timer, timers due at the same time in order of scheduling.
+    TimerHandle nextHandle_; ///< Handle of the next multiplexed timer.
 };
 
 } // namespace veins
@@ -22,6 +22,8 @@
 
 // AnnotationManager - manages annotations on the OMNeT++ canvas
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <cmath>
 
@@ -32,6 +34,8 @@
 Define_Module(veins::AnnotationManager);
 
 using veins::AnnotationManager;
+using veins::MemoryAccounting;
+using veins::TraCICommandInterface;
 using veins::TraCIScenarioManager;
 using veins::TraCIScenarioManagerAccess;
 
@@ -39,17 +43,29 @@ namespace {
 const short EVT_SCHEDULED_ERASE = 3;
 }
 
+int AnnotationManager::numEnabled = 0;
+
 void AnnotationManager::initialize()
 {
+    updateEnabled();
+
     scheduledEraseEvts.clear();
 
     annotations.clear();
     groups.clear();
 
+    memoryRegistration = MemoryAccounting::add("annotations", [this]() { return getMemoryUsage(); });
+
     annotationLayer = new cGroupFigure();
     cCanvas* canvas = getParentModule()->getCanvas();
     canvas->addFigure(annotationLayer, canvas->findFigure("submodules"));
 
+    batchTraciUpdates = par("batchTraciUpdates").boolValue();
+    traciUpdateInterval = par("traciUpdateInterval");
+    if (traciUpdateInterval < SIMTIME_ZERO) throw cRuntimeError("traciUpdateInterval must not be negative");
+    lastTraciUpdate = simTime() - traciUpdateInterval;
+    if (batchTraciUpdates) getSimulation()->getSystemModule()->subscribe(TraCIScenarioManager::traciTimestepBeginSignal, this);
+
     annotationsXml = par("annotations");
     addFromXml(annotationsXml);
 }
@@ -57,10 +73,25 @@ void AnnotationManager::initialize()
 void AnnotationManager::finish()
 {
     hideAll();
+
+    if (batchTraciUpdates) {
+        flushTraciUpdates(true);
+        getSimulation()->getSystemModule()->unsubscribe(TraCIScenarioManager::traciTimestepBeginSignal, this);
+        recordScalar("traciUpdatesSent", numTraciUpdatesSent);
+        recordScalar("traciUpdatesAvoided", numTraciUpdatesAvoided);
+    }
+}
+
+void AnnotationManager::receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details)
+{
+    // queued updates ride along with the query of the time step that is about to begin
+    if (signalID == TraCIScenarioManager::traciTimestepBeginSignal) flushTraciUpdates(false);
 }
 
 AnnotationManager::~AnnotationManager()
 {
+    if (enabled) numEnabled--;
+
     while (scheduledEraseEvts.begin() != scheduledEraseEvts.end()) {
         cancelAndDelete(*scheduledEraseEvts.begin());
         scheduledEraseEvts.erase(scheduledEraseEvts.begin());
@@ -80,6 +111,19 @@ AnnotationManager::~AnnotationManager()
     groups.clear();
 }
 
+MemoryAccounting::Usage AnnotationManager::getMemoryUsage() const
+{
+    MemoryAccounting::Usage usage;
+    usage.objects = annotations.size() + groups.size();
+    usage.bytes = MemoryAccounting::bytesOfNodes(annotations) + MemoryAccounting::bytesOfNodes(groups) + groups.size() * sizeof(Group);
+    for (const Annotation* annotation : annotations) {
+        // count all annotations as large as the largest kind, plus the vertices of polygons
+        usage.bytes += std::max(sizeof(Point), std::max(sizeof(Line), sizeof(Polygon)));
+        if (auto polygon = dynamic_cast<const Polygon*>(annotation)) usage.bytes += MemoryAccounting::bytesOfNodes(polygon->coords);
+    }
+    return usage;
+}
+
 void AnnotationManager::handleMessage(cMessage* msg)
 {
     if (msg->isSelfMessage()) {
@@ -106,9 +150,17 @@ void AnnotationManager::handleSelfMsg(cMessage* msg)
     throw cRuntimeError("unknown self message type");
 }
 
+void AnnotationManager::updateEnabled()
+{
+    const bool wasEnabled = enabled;
+    enabled = hasGUI() || par("draw").boolValue();
+    numEnabled += int(enabled) - int(wasEnabled);
+}
+
 void AnnotationManager::handleParameterChange(const char* parname)
 {
     if (parname && (std::string(parname) == "draw")) {
+        updateEnabled();
         if (par("draw")) {
             showAll();
         }
@@ -200,7 +252,7 @@ AnnotationManager::Group* AnnotationManager::createGroup(std::string title)
     return group;
 }
 
-AnnotationManager::Point* AnnotationManager::drawPoint(Coord p, std::string color, std::string text, Group* group)
+AnnotationManager::Point* AnnotationManager::addPoint(const Coord& p, const std::string& color, const std::string& text, Group* group)
 {
     Point* o = new Point(p, color, text);
     o->group = group;
@@ -212,7 +264,7 @@ AnnotationManager::Point* AnnotationManager::drawPoint(Coord p, std::string colo
     return o;
 }
 
-AnnotationManager::Line* AnnotationManager::drawLine(Coord p1, Coord p2, std::string color, Group* group)
+AnnotationManager::Line* AnnotationManager::addLine(const Coord& p1, const Coord& p2, const std::string& color, Group* group)
 {
     Line* l = new Line(p1, p2, color);
     l->group = group;
@@ -224,7 +276,7 @@ AnnotationManager::Line* AnnotationManager::drawLine(Coord p1, Coord p2, std::st
     return l;
 }
 
-AnnotationManager::Polygon* AnnotationManager::drawPolygon(std::list<Coord> coords, std::string color, Group* group)
+AnnotationManager::Polygon* AnnotationManager::addPolygon(const std::list<Coord>& coords, const std::string& color, Group* group)
 {
     Polygon* p = new Polygon(coords, color);
     p->group = group;
@@ -236,12 +288,7 @@ AnnotationManager::Polygon* AnnotationManager::drawPolygon(std::list<Coord> coor
     return p;
 }
 
-AnnotationManager::Polygon* AnnotationManager::drawPolygon(std::vector<Coord> coords, std::string color, Group* group)
-{
-    return drawPolygon(std::list<Coord>(coords.begin(), coords.end()), color, group);
-}
-
-void AnnotationManager::drawBubble(Coord p1, std::string text)
+void AnnotationManager::showBubble(const Coord& p1, const std::string& text)
 {
     std::string pxOld = getDisplayString().getTagArg("p", 0);
     std::string pyOld = getDisplayString().getTagArg("p", 1);
@@ -270,6 +317,7 @@ void AnnotationManager::drawBubble(Coord p1, std::string text)
 
 void AnnotationManager::erase(const Annotation* annotation)
 {
+    if (!annotation) return;
     hide(annotation);
     annotations.remove(const_cast<Annotation*>(annotation));
     delete annotation;
@@ -291,6 +339,8 @@ void AnnotationManager::scheduleErase(simtime_t deltaT, Annotation* annotation)
 {
     Enter_Method_Silent();
 
+    if (!annotation) return;
+
     cMessage* evt = new cMessage("erase", EVT_SCHEDULED_ERASE);
     evt->setContextPointer(annotation);
 
@@ -301,24 +351,9 @@ void AnnotationManager::scheduleErase(simtime_t deltaT, Annotation* annotation)
 
 void AnnotationManager::show(const Annotation* annotation)
 {
-    if (annotation->figure) return;
-
-    if (const Point* o = dynamic_cast<const Point*>(annotation)) {
-
-        if (hasGUI()) {
-            // no corresponding TkEnv representation
-        }
-
-        TraCIScenarioManager* traci = TraCIScenarioManagerAccess().get();
-        if (traci && traci->isConnected()) {
-            std::stringstream nameBuilder;
-            nameBuilder << o->text << " " << getEnvir()->getUniqueNumber();
-            traci->getCommandInterface()->addPoi(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(o->color), 6, o->pos);
-            annotation->traciPoiIds.push_back(nameBuilder.str());
-        }
-    }
-    else if (const Line* l = dynamic_cast<const Line*>(annotation)) {
+    if (!annotation || annotation->figure) return;
 
+    if (const Line* l = dynamic_cast<const Line*>(annotation)) {
         if (hasGUI()) {
             cLineFigure* figure = new cLineFigure();
             figure->setStart(cFigure::Point(l->p1.x, l->p1.y));
@@ -327,17 +362,6 @@ void AnnotationManager::show(const Annotation* annotation)
             annotation->figure = figure;
             annotationLayer->addFigure(annotation->figure);
         }
-
-        TraCIScenarioManager* traci = TraCIScenarioManagerAccess().get();
-        if (traci && traci->isConnected()) {
-            std::list<Coord> coords;
-            coords.push_back(l->p1);
-            coords.push_back(l->p2);
-            std::stringstream nameBuilder;
-            nameBuilder << "Annotation" << getEnvir()->getUniqueNumber();
-            traci->getCommandInterface()->addPolygon(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(l->color), false, 5, coords);
-            annotation->traciLineIds.push_back(nameBuilder.str());
-        }
     }
     else if (const Polygon* p = dynamic_cast<const Polygon*>(annotation)) {
 
@@ -355,14 +379,69 @@ void AnnotationManager::show(const Annotation* annotation)
             annotation->figure = figure;
             annotationLayer->addFigure(annotation->figure);
         }
+    }
+    else if (!dynamic_cast<const Point*>(annotation)) {
+        // points have no corresponding TkEnv representation
+        throw cRuntimeError("unknown Annotation type");
+    }
+
+    if (batchTraciUpdates) {
+        // only note the change, unless SUMO shows (or is about to show) the annotation already
+        if (annotation->pendingShow || !getTraciIds(getTraciObjectKind(annotation), annotation).empty()) return;
+        annotation->pendingShow = nextPendingShow++;
+        pendingShows[annotation->pendingShow] = annotation;
+        return;
+    }
+
+    if (getMirrorTraci()) showInTraci(annotation, false);
+}
+
+TraCIScenarioManager* AnnotationManager::getMirrorTraci()
+{
+    TraCIScenarioManager* traci = TraCIScenarioManagerAccess().get();
+    if (!traci || !traci->isConnected() || traci->isReadOnly()) return nullptr;
+    return traci;
+}
+
+void AnnotationManager::showInTraci(const Annotation* annotation, bool queue)
+{
+    TraCICommandInterface* commandIfc = TraCIScenarioManagerAccess().get()->getCommandInterface();
 
-        TraCIScenarioManager* traci = TraCIScenarioManagerAccess().get();
-        if (traci && traci->isConnected()) {
-            std::stringstream nameBuilder;
-            nameBuilder << "Annotation" << getEnvir()->getUniqueNumber();
-            traci->getCommandInterface()->addPolygon(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(p->color), false, 4, p->coords);
-            annotation->traciPolygonsIds.push_back(nameBuilder.str());
+    if (const Point* o = dynamic_cast<const Point*>(annotation)) {
+        std::stringstream nameBuilder;
+        nameBuilder << o->text << " " << getEnvir()->getUniqueNumber();
+        if (queue) {
+            commandIfc->queueAddPoi(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(o->color), 6, o->pos);
+        }
+        else {
+            commandIfc->addPoi(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(o->color), 6, o->pos);
+        }
+        annotation->traciPoiIds.push_back(nameBuilder.str());
+    }
+    else if (const Line* l = dynamic_cast<const Line*>(annotation)) {
+        std::list<Coord> coords;
+        coords.push_back(l->p1);
+        coords.push_back(l->p2);
+        std::stringstream nameBuilder;
+        nameBuilder << "Annotation" << getEnvir()->getUniqueNumber();
+        if (queue) {
+            commandIfc->queueAddPolygon(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(l->color), false, 5, coords);
+        }
+        else {
+            commandIfc->addPolygon(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(l->color), false, 5, coords);
         }
+        annotation->traciLineIds.push_back(nameBuilder.str());
+    }
+    else if (const Polygon* p = dynamic_cast<const Polygon*>(annotation)) {
+        std::stringstream nameBuilder;
+        nameBuilder << "Annotation" << getEnvir()->getUniqueNumber();
+        if (queue) {
+            commandIfc->queueAddPolygon(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(p->color), false, 4, p->coords);
+        }
+        else {
+            commandIfc->addPolygon(nameBuilder.str(), "Annotation", TraCIColor::fromTkColor(p->color), false, 4, p->coords);
+        }
+        annotation->traciPolygonsIds.push_back(nameBuilder.str());
     }
     else {
         throw cRuntimeError("unknown Annotation type");
@@ -371,13 +450,34 @@ void AnnotationManager::show(const Annotation* annotation)
 
 void AnnotationManager::hide(const Annotation* annotation)
 {
+    if (!annotation) return;
+
     if (annotation->figure) {
         delete annotationLayer->removeFigure(annotation->figure);
         annotation->figure = nullptr;
     }
 
-    TraCIScenarioManager* traci = TraCIScenarioManagerAccess().get();
-    if (traci && traci->isConnected()) {
+    if (batchTraciUpdates) {
+        // an annotation shown and hidden between two batches never reaches SUMO
+        if (annotation->pendingShow) {
+            pendingShows.erase(annotation->pendingShow);
+            annotation->pendingShow = 0;
+            numTraciUpdatesAvoided += 2;
+        }
+        for (TraciObjectKind kind : {TraciObjectKind::polygon, TraciObjectKind::line, TraciObjectKind::poi}) {
+            std::list<std::string>& ids = getTraciIds(kind, annotation);
+            if (ids.empty()) continue;
+            const std::string key = getTraciObjectKey(kind, annotation);
+            for (std::string& id : ids) {
+                pendingRemovals.emplace(key, std::make_pair(kind, std::move(id)));
+            }
+            ids.clear();
+        }
+        return;
+    }
+
+    TraCIScenarioManager* traci = getMirrorTraci();
+    if (traci) {
         for (std::list<std::string>::const_iterator i = annotation->traciPolygonsIds.begin(); i != annotation->traciPolygonsIds.end(); ++i) {
             std::string id = *i;
             traci->getCommandInterface()->polygon(id).remove(3);
@@ -396,6 +496,97 @@ void AnnotationManager::hide(const Annotation* annotation)
     }
 }
 
+AnnotationManager::TraciObjectKind AnnotationManager::getTraciObjectKind(const Annotation* annotation)
+{
+    if (dynamic_cast<const Point*>(annotation)) return TraciObjectKind::poi;
+    if (dynamic_cast<const Line*>(annotation)) return TraciObjectKind::line;
+    if (dynamic_cast<const Polygon*>(annotation)) return TraciObjectKind::polygon;
+    throw cRuntimeError("unknown Annotation type");
+}
+
+std::list<std::string>& AnnotationManager::getTraciIds(TraciObjectKind kind, const Annotation* annotation)
+{
+    switch (kind) {
+    case TraciObjectKind::poi:
+        return annotation->traciPoiIds;
+    case TraciObjectKind::line:
+        return annotation->traciLineIds;
+    case TraciObjectKind::polygon:
+        return annotation->traciPolygonsIds;
+    }
+    throw cRuntimeError("unknown TraCI object kind");
+}
+
+std::string AnnotationManager::getTraciObjectKey(TraciObjectKind kind, const Annotation* annotation)
+{
+    // objects are only reused if they look exactly the same, so print coordinates without rounding
+    std::ostringstream key;
+    key.precision(std::numeric_limits<double>::max_digits10);
+    key << static_cast<int>(kind);
+    if (const Point* o = dynamic_cast<const Point*>(annotation)) {
+        key << ' ' << o->color << ' ' << o->pos.x << ' ' << o->pos.y << ' ' << o->text;
+    }
+    else if (const Line* l = dynamic_cast<const Line*>(annotation)) {
+        key << ' ' << l->color << ' ' << l->p1.x << ' ' << l->p1.y << ' ' << l->p2.x << ' ' << l->p2.y;
+    }
+    else if (const Polygon* p = dynamic_cast<const Polygon*>(annotation)) {
+        key << ' ' << p->color;
+        for (const Coord& coord : p->coords) key << ' ' << coord.x << ' ' << coord.y;
+    }
+    return key.str();
+}
+
+void AnnotationManager::flushTraciUpdates(bool force)
+{
+    if (pendingShows.empty() && pendingRemovals.empty()) return;
+    if (!force && simTime() - lastTraciUpdate < traciUpdateInterval) return;
+
+    TraCIScenarioManager* traci = getMirrorTraci();
+    if (!traci) {
+        // like unbatched updates, changes while not connected (or connected read-only) never reach SUMO
+        for (auto& pending : pendingShows) pending.second->pendingShow = 0;
+        pendingShows.clear();
+        pendingRemovals.clear();
+        return;
+    }
+    lastTraciUpdate = simTime();
+
+    for (auto& pending : pendingShows) {
+        const Annotation* annotation = pending.second;
+        annotation->pendingShow = 0;
+
+        // an identical object about to be removed shows this annotation just as well
+        const TraciObjectKind kind = getTraciObjectKind(annotation);
+        auto removal = pendingRemovals.find(getTraciObjectKey(kind, annotation));
+        if (removal != pendingRemovals.end()) {
+            getTraciIds(kind, annotation).push_back(std::move(removal->second.second));
+            pendingRemovals.erase(removal);
+            numTraciUpdatesAvoided += 2;
+            continue;
+        }
+
+        showInTraci(annotation, true);
+        numTraciUpdatesSent++;
+    }
+    pendingShows.clear();
+
+    TraCICommandInterface* commandIfc = traci->getCommandInterface();
+    for (auto& removal : pendingRemovals) {
+        const TraciObjectKind kind = removal.second.first;
+        const std::string& id = removal.second.second;
+        if (kind == TraciObjectKind::poi) {
+            commandIfc->poi(id).queueRemove(static_cast<int32_t>(kind));
+        }
+        else {
+            commandIfc->polygon(id).queueRemove(static_cast<int32_t>(kind));
+        }
+        numTraciUpdatesSent++;
+    }
+    pendingRemovals.clear();
+
+    if (force) commandIfc->flushQueries();
+}
+
 void AnnotationManager::showAll(Group* group)
 {
     for (Annotations::const_iterator i = annotations.begin(); i != annotations.end(); ++i) {
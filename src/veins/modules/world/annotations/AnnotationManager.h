@@ -25,18 +25,30 @@
 #pragma once
 
 #include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "veins/veins.h"
 
 #include "veins/base/utils/FindModule.h"
 #include "veins/base/utils/Coord.h"
+#include "veins/base/utils/ModuleRegistry.h"
+#include "veins/base/utils/MemoryAccounting.h"
 
 namespace veins {
 
+class TraCIScenarioManager;
+
 /**
  * manages annotations on the OMNeT++ canvas.
+ *
+ * Annotations are also mirrored to SUMO-GUI (if connected via TraCI, unless the connection is read-only). By default, every show() and hide() does so with a query of its own.
+ * With batchTraciUpdates set, they only note the change, and all changes are sent together at the begin of the next TraCI time step
+ * (riding along with its query, see TraCIConnection::queueQuery), after diffing them against what SUMO shows already.
  */
-class VEINS_API AnnotationManager : public cSimpleModule {
+class VEINS_API AnnotationManager : public cSimpleModule, public cListener {
 public:
     class VEINS_API Group;
 
@@ -45,6 +57,7 @@ public:
         Annotation()
             : group(nullptr)
             , figure(nullptr)
+            , pendingShow(0)
         {
         }
         virtual ~Annotation()
@@ -61,6 +74,8 @@ public:
         mutable std::list<std::string> traciPoiIds;
         mutable std::list<std::string> traciLineIds;
         mutable std::list<std::string> traciPolygonsIds;
+
+        mutable uint64_t pendingShow; /**< key in pendingShows while waiting for the next batch of TraCI updates, 0 otherwise */
     };
 
     class VEINS_API Point : public Annotation {
@@ -143,14 +158,60 @@ public:
     void handleMessage(cMessage* msg) override;
     void handleSelfMsg(cMessage* msg);
     void handleParameterChange(const char* parname) override;
+    void receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details) override;
 
     void addFromXml(cXMLElement* xml);
     Group* createGroup(std::string title = "untitled");
-    Point* drawPoint(Coord p, std::string color, std::string text, Group* group = nullptr);
-    Line* drawLine(Coord p1, Coord p2, std::string color, Group* group = nullptr);
-    Polygon* drawPolygon(std::list<Coord> coords, std::string color, Group* group = nullptr);
-    Polygon* drawPolygon(std::vector<Coord> coords, std::string color, Group* group = nullptr);
-    void drawBubble(Coord p1, std::string text);
+
+    /**
+     * return whether annotations are kept at all
+     *
+     * Annotations can never become visible when running without GUI and with draw set to false.
+     * In this (headless) case, all draw methods return nullptr without creating anything,
+     * and callers that need to format strings or collect points for an annotation should check this first.
+     */
+    bool isEnabled() const
+    {
+        return enabled;
+    }
+
+    /**
+     * return whether any AnnotationManager keeps annotations (see isEnabled), without looking up the module
+     */
+    static bool isEnabledGlobally()
+    {
+        return numEnabled > 0;
+    }
+
+    Point* drawPoint(const Coord& p, const std::string& color, const std::string& text, Group* group = nullptr)
+    {
+        if (!enabled) return nullptr;
+        return addPoint(p, color, text, group);
+    }
+    Line* drawLine(const Coord& p1, const Coord& p2, const std::string& color, Group* group = nullptr)
+    {
+        if (!enabled) return nullptr;
+        return addLine(p1, p2, color, group);
+    }
+    Polygon* drawPolygon(const std::list<Coord>& coords, const std::string& color, Group* group = nullptr)
+    {
+        if (!enabled) return nullptr;
+        return addPolygon(coords, color, group);
+    }
+    Polygon* drawPolygon(const std::vector<Coord>& coords, const std::string& color, Group* group = nullptr)
+    {
+        if (!enabled) return nullptr;
+        return addPolygon(std::list<Coord>(coords.begin(), coords.end()), color, group);
+    }
+    void drawBubble(const Coord& p1, const std::string& text)
+    {
+        if (!enabled) return;
+        showBubble(p1, text);
+    }
+
+    /**
+     * erase annotation (ignoring nullptr, as returned by draw methods while headless)
+     */
     void erase(const Annotation* annotation);
     void eraseAll(Group* group = nullptr);
     void scheduleErase(simtime_t deltaT, Annotation* annotation);
@@ -164,6 +225,19 @@ protected:
     using Annotations = std::list<Annotation*>;
     using Groups = std::list<Group*>;
 
+    Point* addPoint(const Coord& p, const std::string& color, const std::string& text, Group* group);
+    Line* addLine(const Coord& p1, const Coord& p2, const std::string& color, Group* group);
+    Polygon* addPolygon(const std::list<Coord>& coords, const std::string& color, Group* group);
+    void showBubble(const Coord& p1, const std::string& text);
+
+    /**
+     * update enabled (and numEnabled) from the GUI and the draw parameter
+     */
+    void updateEnabled();
+
+    bool enabled = false; /**< whether annotations are kept (see isEnabled), only counted in numEnabled once initialized */
+    static int numEnabled; /**< number of AnnotationManager instances that keep annotations */
+
     cXMLElement* annotationsXml; /**< annotations to add at startup */
 
     std::list<cMessage*> scheduledEraseEvts;
@@ -172,6 +246,67 @@ protected:
     Groups groups;
 
     cGroupFigure* annotationLayer;
+
+    /**
+     * kinds of objects annotations are shown as in SUMO-GUI (with the layer each is removed from)
+     */
+    enum class TraciObjectKind {
+        polygon = 3,
+        line = 4,
+        poi = 5
+    };
+
+    /**
+     * returns a key that is the same for (and only for) annotations shown by identical SUMO objects of the given kind
+     */
+    static std::string getTraciObjectKey(TraciObjectKind kind, const Annotation* annotation);
+
+    /**
+     * returns the kind of SUMO object annotation is shown as
+     */
+    static TraciObjectKind getTraciObjectKind(const Annotation* annotation);
+
+    /**
+     * returns the ids of the SUMO objects of the given kind that show annotation
+     */
+    static std::list<std::string>& getTraciIds(TraciObjectKind kind, const Annotation* annotation);
+
+    /**
+     * returns the scenario manager if annotations are to be mirrored to SUMO-GUI, i.e., if it is connected and may change the state of SUMO, or nullptr
+     */
+    static TraCIScenarioManager* getMirrorTraci();
+
+    /**
+     * sends (or, if queue is set, queues) the TraCI command that shows annotation in SUMO-GUI
+     */
+    void showInTraci(const Annotation* annotation, bool queue);
+
+    /**
+     * queues all TraCI updates noted since the last batch, replacing pairs of removals and additions of identical objects by reusing the removed one
+     * @param force: whether to send the updates (and flush the queue) regardless of traciUpdateInterval
+     */
+    void flushTraciUpdates(bool force);
+
+    bool batchTraciUpdates; /**< whether show() and hide() defer TraCI updates to the next time step */
+    simtime_t traciUpdateInterval; /**< minimum time between two batches of TraCI updates */
+    simtime_t lastTraciUpdate; /**< time the last batch of TraCI updates was sent */
+
+    uint64_t nextPendingShow = 1; /**< key of the next annotation added to pendingShows */
+    std::map<uint64_t, const Annotation*> pendingShows; /**< annotations to show in the next batch, in the order of their show() */
+
+    std::multimap<std::string, std::pair<TraciObjectKind, std::string>> pendingRemovals; /**< kinds and ids of SUMO objects to remove in the next batch, by getTraciObjectKey() */
+
+    long numTraciUpdatesSent = 0; /**< number of additions and removals sent to SUMO */
+    long numTraciUpdatesAvoided = 0; /**< number of additions and removals batching made unnecessary */
+
+    /**
+     * estimate the memory held by all annotations and groups, see MemoryAccounting
+     */
+    MemoryAccounting::Usage getMemoryUsage() const;
+
+private:
+    GlobalModuleRegistration globalModuleRegistration{this}; /**< makes this module known to FindModule::findGlobalModule() */
+    MemoryAccounting::Registration memoryRegistration; /**< reports getMemoryUsage() as subsystem "annotations" */
 };
 
 class VEINS_API AnnotationManagerAccess {
@@ -40,11 +40,16 @@ TraCITrafficLightInterface::TraCITrafficLightInterface()
     , tlCommandInterface(nullptr)
     , external_id("")
     , position()
+    , lazyProgramFetching(false)
+    , hasProgramDefinition(false)
+    , hasControlledLinks(false)
+    , initialStatePending(false)
     , programDefinition()
     , currentLogicId("")
     , currentPhaseNr(-1)
     , nextSwitchTime()
     , inOnlineSignalState(false)
+    , changed(false)
 {
 }
 
@@ -67,11 +72,13 @@ Coord TraCITrafficLightInterface::getPosition() const
 }
 std::list<std::list<TraCITrafficLightLink>> TraCITrafficLightInterface::getControlledLinks()
 {
+    fetchControlledLinks();
     return controlledLinks;
 }
 
-TraCITrafficLightProgram::Logic TraCITrafficLightInterface::getCurrentLogic() const
+const TraCITrafficLightProgram::Logic& TraCITrafficLightInterface::getCurrentLogic() const
 {
+    fetchProgramDefinition();
     return programDefinition.getLogic(currentLogicId);
 }
 
@@ -85,7 +92,7 @@ int TraCITrafficLightInterface::getCurrentPhaseId() const
     return currentPhaseNr;
 }
 
-TraCITrafficLightProgram::Phase TraCITrafficLightInterface::getCurrentPhase() const
+const TraCITrafficLightProgram::Phase& TraCITrafficLightInterface::getCurrentPhase() const
 {
     return getCurrentLogic().phases[currentPhaseNr];
 }
@@ -103,7 +110,7 @@ simtime_t TraCITrafficLightInterface::getRemainingDuration() const
 std::string TraCITrafficLightInterface::getCurrentState() const
 {
     if (isInOnlineSignalState()) {
-        return currentSignalState;
+        return currentSignalState.str();
     }
     else {
         return getCurrentPhase().state;
@@ -115,20 +122,54 @@ bool TraCITrafficLightInterface::isInOnlineSignalState() const
     return inOnlineSignalState;
 }
 
+const TraCITrafficLightState& TraCITrafficLightInterface::getCurrentSignalState() const
+{
+    return currentSignalState;
+}
+
+bool TraCITrafficLightInterface::resetChanged()
+{
+    bool wasChanged = changed;
+    changed = false;
+    return wasChanged;
+}
+
+void TraCITrafficLightInterface::setInitialStateReceived()
+{
+    initialStatePending = false;
+}
+
 void TraCITrafficLightInterface::setProgramDefinition(const TraCITrafficLightProgram& programDefinition)
 {
     this->programDefinition = programDefinition;
+    hasProgramDefinition = true;
 }
 
 void TraCITrafficLightInterface::setControlledLinks(const std::list<std::list<TraCITrafficLightLink>>& controlledLinks)
 {
     this->controlledLinks = controlledLinks;
+    hasControlledLinks = true;
+}
+
+void TraCITrafficLightInterface::fetchProgramDefinition() const
+{
+    if (hasProgramDefinition) return;
+    programDefinition = getTlCommandInterface()->getProgramDefinition();
+    hasProgramDefinition = true;
+}
+
+void TraCITrafficLightInterface::fetchControlledLinks() const
+{
+    if (hasControlledLinks) return;
+    controlledLinks = getTlCommandInterface()->getControlledLinks();
+    hasControlledLinks = true;
 }
 
 void TraCITrafficLightInterface::setCurrentLogicById(const std::string& logicId, bool setSumo)
 {
     if (setSumo) {
         ASSERT(logicId != "online");
+        fetchProgramDefinition();
         if (!programDefinition.hasLogic(logicId)) {
             throw cRuntimeError("Logic '%s' not found in program of TraCITrafficLightInterface %s", logicId.c_str(), external_id.c_str());
         }
@@ -169,11 +210,12 @@ void TraCITrafficLightInterface::setCurrentState(const std::string& state, bool
         const std::string newValueInSumo = tlCommandInterface->getCurrentState();
         ASSERT(newValueInSumo == state);
     }
-    if (currentSignalState != state) {
-        sendChangeMsg(TrafficLightAtrributeType::STATE, state, currentSignalState);
+    TraCITrafficLightState newSignalState(state);
+    if (currentSignalState != newSignalState) {
+        sendChangeMsg(TrafficLightAtrributeType::STATE, state, currentSignalState.str());
+        currentSignalState = newSignalState;
     }
     inOnlineSignalState = true;
-    currentSignalState = state;
 }
 
 void TraCITrafficLightInterface::setNextSwitch(const simtime_t& newNextSwitch, bool setSumo)
@@ -224,12 +266,19 @@ void TraCITrafficLightInterface::initialize()
 {
     ASSERT(isPreInitialized);
     isPreInitialized = false;
+    lazyProgramFetching = par("lazyProgramFetching").boolValue();
+    if (lazyProgramFetching) {
+        // the state arrives with the subscription result, the program and links once asked for
+        getTlCommandInterface();
+        initialStatePending = true;
+        return;
+    }
     setProgramDefinition(getTlCommandInterface()->getProgramDefinition());
     setControlledLinks(getTlCommandInterface()->getControlledLinks());
     currentLogicId = getTlCommandInterface()->getCurrentProgramID();
     currentPhaseNr = getTlCommandInterface()->getCurrentPhaseIndex();
     nextSwitchTime = getTlCommandInterface()->getAssumedNextSwitchTime();
-    currentSignalState = getTlCommandInterface()->getCurrentState();
+    currentSignalState = TraCITrafficLightState(getTlCommandInterface()->getCurrentState());
 }
 
 void TraCITrafficLightInterface::handleMessage(cMessage* msg)
@@ -268,6 +317,9 @@ void TraCITrafficLightInterface::handleChangeCommandMessage(cMessage* msg)
 void TraCITrafficLightInterface::sendChangeMsg(int changedAttribute, const std::string newValue, const std::string oldValue)
 {
     Enter_Method_Silent();
+    // the first state reported by the subscription is no change
+    if (initialStatePending) return;
+    changed = true;
     TraCITrafficLightMessage* pMsg = new TraCITrafficLightMessage("TrafficLightChangeMessage");
     pMsg->setTlId(external_id.c_str());
     pMsg->setChangedAttribute(changedAttribute);
@@ -27,6 +27,7 @@
 #include "veins/modules/mobility/traci/TraCIScenarioManager.h"
 #include "veins/modules/mobility/traci/TraCICommandInterface.h"
 #include "veins/modules/world/traci/trafficLight/TraCITrafficLightProgram.h"
+#include "veins/modules/world/traci/trafficLight/TraCITrafficLightState.h"
 
 namespace veins {
 
@@ -69,16 +70,33 @@ public:
         return tlCommandInterface;
     }
 
+    /**
+     * returns the links controlled by each signal (fetched from SUMO on first use if lazyProgramFetching is set)
+     */
     virtual std::list<std::list<TraCITrafficLightLink>> getControlledLinks();
     virtual Coord getPosition() const;
-    virtual TraCITrafficLightProgram::Logic getCurrentLogic() const;
+    virtual const TraCITrafficLightProgram::Logic& getCurrentLogic() const;
     virtual std::string getCurrentLogicId() const;
     virtual int getCurrentPhaseId() const;
-    virtual TraCITrafficLightProgram::Phase getCurrentPhase() const;
+    virtual const TraCITrafficLightProgram::Phase& getCurrentPhase() const;
     virtual simtime_t getAssumedNextSwitch() const;
     virtual simtime_t getRemainingDuration() const;
     virtual std::string getCurrentState() const;
     virtual bool isInOnlineSignalState() const;
+    /**
+     * returns the last signal state reported by SUMO in its packed encoding
+     */
+    virtual const TraCITrafficLightState& getCurrentSignalState() const;
+
+    /**
+     * returns whether any attribute changed since the last call, and clears the flag
+     */
+    virtual bool resetChanged();
+
+    /**
+     * marks the state set by the first subscription result as the initial one (see lazyProgramFetching), so later changes are reported
+     */
+    virtual void setInitialStateReceived();
 
     virtual void setProgramDefinition(const TraCITrafficLightProgram& programDefinition);
     virtual void setControlledLinks(const std::list<std::list<TraCITrafficLightLink>>& controlledLinks);
@@ -93,6 +111,10 @@ protected:
     void handleMessage(cMessage* msg) override;
     virtual void handleChangeCommandMessage(cMessage* msg);
     virtual void sendChangeMsg(int changedAttribute, const std::string newValue, const std::string oldValue);
+    /** fetches programDefinition from SUMO unless already done */
+    virtual void fetchProgramDefinition() const;
+    /** fetches controlledLinks from SUMO unless already done */
+    virtual void fetchControlledLinks() const;
 
     bool isPreInitialized; /**< true if preInitialize() has been called immediately before initialize() */
     simtime_t updateInterval; /**< ScenarioManager's update interval */
@@ -106,14 +128,19 @@ protected:
     std::string external_id; /**< id used on the other end of TraCI */
     Coord position; /**< position of the traffic light */
 
-    TraCITrafficLightProgram programDefinition; /**< full definition of program (all logics) */
-    std::list<std::list<TraCITrafficLightLink>> controlledLinks; /**< controlledLinks[signal][link] */
+    bool lazyProgramFetching; /**< whether programDefinition and controlledLinks are only fetched when first needed */
+    mutable bool hasProgramDefinition; /**< whether programDefinition was fetched (or set) */
+    mutable bool hasControlledLinks; /**< whether controlledLinks were fetched (or set) */
+    bool initialStatePending; /**< whether the current state is still to be taken from the first subscription result (and changes are not reported) */
+    mutable TraCITrafficLightProgram programDefinition; /**< full definition of program (all logics) */
+    mutable std::list<std::list<TraCITrafficLightLink>> controlledLinks; /**< controlledLinks[signal][link] */
     // std::list< std::list<TraCITrafficLightLink> > controlledLanes; /**< controlledLanes[signal][link] */
     std::string currentLogicId; /**< id of the currently active logic */
     int currentPhaseNr; /**< current phase of the current program */
     simtime_t nextSwitchTime; /**< predicted next phase switch time (absolute timestamp) */
-    std::string currentSignalState; /**< current state of the signals (rRgGyY-String) */
+    TraCITrafficLightState currentSignalState; /**< current state of the signals (packed rRgGyY-String) */
     bool inOnlineSignalState; /**< whether the TLS is currently set to a manual (i.e. online) phase state */
+    bool changed; /**< whether any attribute changed since the last call to resetChanged() */
 };
 
 } // namespace veins
@@ -47,7 +47,7 @@ void TraCITrafficLightProgram::addLogic(const Logic& logic)
     logics[logic.id] = logic;
 }
 
-TraCITrafficLightProgram::Logic TraCITrafficLightProgram::getLogic(const std::string& lid) const
+const TraCITrafficLightProgram::Logic& TraCITrafficLightProgram::getLogic(const std::string& lid) const
 {
     return logics.at(lid);
 }
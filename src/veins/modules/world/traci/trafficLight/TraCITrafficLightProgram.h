@@ -54,7 +54,7 @@ public:
     TraCITrafficLightProgram(std::string id = "");
 
     void addLogic(const Logic& logic);
-    TraCITrafficLightProgram::Logic getLogic(const std::string& lid) const;
+    const TraCITrafficLightProgram::Logic& getLogic(const std::string& lid) const;
     bool hasLogic(const std::string& lid) const;
 
 private:
@@ -0,0 +1,58 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins/modules/world/traci/trafficLight/TraCITrafficLightState.h"
+
+using veins::TraCITrafficLightState;
+
+namespace {
+
+const char linkStates[] = "rRgGyYuoOs";
+const size_t numLinkStates = sizeof(linkStates) - 1;
+
+} // namespace
+
+TraCITrafficLightState::TraCITrafficLightState(const std::string& state)
+    : numLinks(state.size())
+    , words((state.size() + linksPerWord - 1) / linksPerWord, 0)
+{
+    for (size_t i = 0; i < state.size(); ++i) {
+        const char* code = std::char_traits<char>::find(linkStates, numLinkStates, state[i]);
+        if (!code) throw cRuntimeError("Unknown link state '%c' in traffic light state \"%s\"", state[i], state.c_str());
+        words[i / linksPerWord] |= static_cast<uint64_t>(code - linkStates) << (4 * (i % linksPerWord));
+    }
+}
+
+std::string TraCITrafficLightState::str() const
+{
+    std::string state(numLinks, ' ');
+    for (size_t i = 0; i < numLinks; ++i) {
+        state[i] = getLinkState(i);
+    }
+    return state;
+}
+
+char TraCITrafficLightState::getLinkState(size_t i) const
+{
+    ASSERT(i < numLinks);
+    return linkStates[(words[i / linksPerWord] >> (4 * (i % linksPerWord))) & 0xf];
+}
@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "veins/veins.h"
+
+namespace veins {
+
+/**
+ * Signal state of all links controlled by a traffic light, packed into 4 bits per link.
+ *
+ * Holds the same information as a SUMO red-yellow-green state string (e.g., "rrGGyy"),
+ * but compares by a few integer comparisons rather than character by character.
+ */
+class VEINS_API TraCITrafficLightState {
+public:
+    TraCITrafficLightState() = default;
+
+    /**
+     * encodes a SUMO red-yellow-green state string (consisting of the characters "rRgGyYuoOs")
+     */
+    explicit TraCITrafficLightState(const std::string& state);
+
+    /**
+     * returns the SUMO red-yellow-green state string
+     */
+    std::string str() const;
+
+    /**
+     * returns the number of links
+     */
+    size_t size() const
+    {
+        return numLinks;
+    }
+
+    /**
+     * returns the SUMO state character of link i
+     */
+    char getLinkState(size_t i) const;
+
+    bool operator==(const TraCITrafficLightState& other) const
+    {
+        return (numLinks == other.numLinks) && (words == other.words);
+    }
+    bool operator!=(const TraCITrafficLightState& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static const size_t linksPerWord = 16;
+
+    size_t numLinks = 0;
+    std::vector<uint64_t> words;
+};
+
+} // namespace veins
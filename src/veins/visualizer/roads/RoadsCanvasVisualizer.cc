@@ -49,21 +49,28 @@ void RoadsCanvasVisualizer::initialize(int stage)
         canvas->addFigure(figures);
 
         auto onTraciInitialized = [this, manager](veins::SignalPayload<bool> payload) {
-            TraCICommandInterface* traci = manager->getCommandInterface();
-            ASSERT(traci);
-
             std::string colorStr = par("lineColor");
             auto color = cFigure::Color(colorStr.c_str());
             double width = par("lineWidth");
             bool zoom = par("lineWidthZoom");
-
-            auto laneIds = traci->getLaneIds();
-            for (auto laneId : laneIds) {
-                auto coords = traci->lane(laneId).getShape();
-
-                auto line = createLine(coords, color, width, zoom);
-                figures->addFigure(line);
+            double tileSize = par("tileSize");
+            int lodLevels = par("lodLevels");
+            lodPixelTolerance = par("lodPixelTolerance");
+            if (tileSize <= 0) throw cRuntimeError("tileSize was %f, but must be positive", tileSize);
+            if (lodLevels < 1) throw cRuntimeError("lodLevels was %d, but must be at least 1", lodLevels);
+            numLevels = lodLevels;
+
+            for (const auto& batch : RoadsGeometry::collect(manager, tileSize, numLevels, lodPixelTolerance)) {
+                TileFigures tile;
+                for (const auto& lines : batch.levels) {
+                    cPathFigure* path = createPath(lines, color, width, zoom);
+                    path->setVisible(tile.levels.empty());
+                    figures->addFigure(path);
+                    tile.levels.push_back(path);
+                }
+                tiles.push_back(tile);
             }
+            shownLevel = 0;
         };
         signalManager.subscribeCallback(manager, TraCIScenarioManager::traciInitializedSignal, onTraciInitialized);
     }
@@ -78,18 +85,37 @@ void RoadsCanvasVisualizer::finish()
 {
 }
 
-cPolylineFigure* RoadsCanvasVisualizer::createLine(const std::list<veins::Coord>& coords, cFigure::Color color, double width, bool zoom)
+void RoadsCanvasVisualizer::refreshDisplay() const
 {
-    std::vector<cFigure::Point> points;
-    for (auto coord : coords) {
-        points.push_back(cFigure::Point(coord.x, coord.y));
+    if (tiles.empty()) return;
+
+    // pick the level of detail matching the zoom level of the network's canvas (1 pixel per m when not zoomed)
+    double scale = 1;
+#if OMNETPP_VERSION >= 0x501
+    scale = getEnvir()->getZoomLevel(getParentModule());
+#endif
+    const size_t level = RoadsGeometry::getLevelForScale(scale, numLevels, lodPixelTolerance);
+    if (level == shownLevel) return;
+    for (const auto& tile : tiles) {
+        tile.levels[shownLevel]->setVisible(false);
+        tile.levels[level]->setVisible(true);
     }
+    shownLevel = level;
+}
 
-    auto* line = new cPolylineFigure();
-    line->setPoints(points);
-    line->setLineColor(color);
-    line->setLineWidth(width);
-    line->setZoomLineWidth(zoom);
+cPathFigure* RoadsCanvasVisualizer::createPath(const std::vector<RoadsGeometry::Line>& lines, cFigure::Color color, double width, bool zoom)
+{
+    auto* path = new cPathFigure();
+    for (const auto& line : lines) {
+        path->addMoveTo(line.front().x, line.front().y);
+        for (size_t i = 1; i < line.size(); ++i) {
+            path->addLineTo(line[i].x, line[i].y);
+        }
+    }
+    path->setFilled(false);
+    path->setLineColor(color);
+    path->setLineWidth(width);
+    path->setZoomLineWidth(zoom);
 
-    return line;
+    return path;
 }
@@ -26,6 +26,7 @@
 
 #include "veins/base/utils/Coord.h"
 #include "veins/modules/utility/SignalManager.h"
+#include "veins/visualizer/roads/RoadsGeometry.h"
 
 namespace veins {
 
@@ -33,6 +34,9 @@ namespace veins {
  * @brief
  * Simple support module to visualize road network as received via TraCI.
  *
+ * Lanes are drawn as a few path figures per road class and tile, with coarser levels of detail shown when zoomed out.
+ * Tiles let the GUI skip figures outside of the visible area.
+ *
  * See the Veins website <a href="http://veins.car2x.org/"> for a tutorial, documentation, and publications </a>.
  *
  * @author Christoph Sommer
@@ -45,12 +49,24 @@ public:
     void initialize(int stage) override;
     void handleMessage(cMessage* msg) override;
     void finish() override;
+    void refreshDisplay() const override;
 
 protected:
     veins::SignalManager signalManager;
     cGroupFigure* figures;
 
-    cPolylineFigure* createLine(const std::list<veins::Coord>& coords, cFigure::Color color, double width, bool zoom);
+    /**
+     * all lanes of one road class in one tile, one figure per level of detail (see RoadsGeometry)
+     */
+    struct TileFigures {
+        std::vector<cPathFigure*> levels;
+    };
+    std::vector<TileFigures> tiles;
+    size_t numLevels = 1;
+    double lodPixelTolerance = 1; /**< maximum error (in pixels) of simplified lane shapes */
+    mutable size_t shownLevel = 0; /**< level of detail currently visible */
+
+    cPathFigure* createPath(const std::vector<RoadsGeometry::Line>& lines, cFigure::Color color, double width, bool zoom);
 };
 
 } // namespace veins
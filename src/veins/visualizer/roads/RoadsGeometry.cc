@@ -0,0 +1,174 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <cmath>
+#include <map>
+#include <tuple>
+
+#include "veins/visualizer/roads/RoadsGeometry.h"
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+#include "veins/modules/mobility/traci/TraCICommandInterface.h"
+#include "veins/modules/mobility/traci/TraCIConnection.h"
+
+using veins::RoadsGeometry;
+
+namespace {
+
+struct LaneShape {
+    std::string roadClass;
+    RoadsGeometry::Line shape;
+};
+
+std::vector<LaneShape> getLaneShapes(veins::TraCIScenarioManager* manager)
+{
+    std::vector<LaneShape> lanes;
+
+    if (const veins::SumoNetwork* network = manager->getSumoNetwork()) {
+        std::map<std::string, std::string> edgeClasses;
+        for (const auto& edge : network->getEdges()) {
+            edgeClasses[edge.id] = (edge.function == "internal") ? "internal" : (edge.type.empty() ? "road" : edge.type);
+        }
+        lanes.reserve(network->getLanes().size());
+        for (const auto& lane : network->getLanes()) {
+            LaneShape l{edgeClasses[lane.edgeId], {}};
+            l.shape.reserve(lane.shape.size());
+            for (const auto& point : lane.shape) l.shape.push_back(manager->getConnection()->traci2omnet(point));
+            lanes.push_back(std::move(l));
+        }
+        return lanes;
+    }
+
+    // fetch all shapes in a single round trip (and restore the previous caching mode afterwards)
+    veins::TraCICommandInterface* traci = manager->getCommandInterface();
+    ASSERT(traci);
+    const bool wasCaching = traci->isCachingStaticQueries();
+    if (!wasCaching) traci->setStaticQueryCaching(true);
+    traci->prewarmStaticQueryCache();
+    for (const auto& laneId : traci->getLaneIds()) {
+        const auto coords = traci->lane(laneId).getShape();
+        lanes.push_back({(!laneId.empty() && laneId[0] == ':') ? "internal" : "road", RoadsGeometry::Line(coords.begin(), coords.end())});
+    }
+    if (!wasCaching) traci->setStaticQueryCaching(false);
+    return lanes;
+}
+
+double length(const RoadsGeometry::Line& line)
+{
+    double sum = 0;
+    for (size_t i = 1; i < line.size(); ++i) sum += line[i - 1].distance(line[i]);
+    return sum;
+}
+
+double distanceToSegment(const veins::Coord& p, const veins::Coord& from, const veins::Coord& to)
+{
+    const double dx = to.x - from.x;
+    const double dy = to.y - from.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    double t = (lengthSquared > 0) ? ((p.x - from.x) * dx + (p.y - from.y) * dy) / lengthSquared : 0;
+    t = std::min(std::max(t, 0.0), 1.0);
+    const double ex = from.x + t * dx - p.x;
+    const double ey = from.y + t * dy - p.y;
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+} // namespace
+
+std::vector<RoadsGeometry::Batch> RoadsGeometry::collect(TraCIScenarioManager* manager, double tileSize, size_t numLevels, double pixelTolerance)
+{
+    ASSERT(tileSize > 0);
+    ASSERT(numLevels > 0);
+
+    std::vector<Batch> batches;
+    std::map<std::tuple<std::string, int, int>, size_t> batchIndex;
+    for (const auto& lane : getLaneShapes(manager)) {
+        if (lane.shape.size() < 2) continue;
+
+        // assign lanes to the tile of their bounding box center
+        Coord p1 = lane.shape.front();
+        Coord p2 = lane.shape.front();
+        for (const auto& point : lane.shape) {
+            p1 = Coord(std::min(p1.x, point.x), std::min(p1.y, point.y));
+            p2 = Coord(std::max(p2.x, point.x), std::max(p2.y, point.y));
+        }
+        const int col = static_cast<int>(std::floor((p1.x + p2.x) / 2 / tileSize));
+        const int row = static_cast<int>(std::floor((p1.y + p2.y) / 2 / tileSize));
+        auto inserted = batchIndex.emplace(std::make_tuple(lane.roadClass, col, row), batches.size());
+        if (inserted.second) batches.push_back({lane.roadClass, col, row, std::vector<std::vector<Line>>(numLevels)});
+        Batch& batch = batches[inserted.first->second];
+
+        batch.levels[0].push_back(lane.shape);
+        for (size_t level = 1; level < numLevels; ++level) {
+            if (level >= 2 && lane.roadClass == "internal") break;
+            const double tolerance = getLevelTolerance(level, pixelTolerance);
+            // lanes shorter than the tolerance would be drawn as (at most) a dot
+            if (length(lane.shape) < tolerance) break;
+            batch.levels[level].push_back(simplify(lane.shape, tolerance));
+        }
+    }
+    return batches;
+}
+
+double RoadsGeometry::getLevelTolerance(size_t level, double pixelTolerance)
+{
+    return (level == 0) ? 0 : pixelTolerance * std::pow(4.0, static_cast<double>(level - 1));
+}
+
+size_t RoadsGeometry::getLevelForScale(double scale, size_t numLevels, double pixelTolerance)
+{
+    size_t level = 0;
+    while (level + 1 < numLevels && getLevelTolerance(level + 1, pixelTolerance) * scale <= pixelTolerance) ++level;
+    return level;
+}
+
+RoadsGeometry::Line RoadsGeometry::simplify(const Line& line, double tolerance)
+{
+    if (line.size() < 3 || tolerance <= 0) return line;
+
+    std::vector<bool> keep(line.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+    std::vector<std::pair<size_t, size_t>> chains{{0, line.size() - 1}};
+    while (!chains.empty()) {
+        const size_t from = chains.back().first;
+        const size_t to = chains.back().second;
+        chains.pop_back();
+        size_t worst = from;
+        double worstDistance = tolerance;
+        for (size_t i = from + 1; i < to; ++i) {
+            const double d = distanceToSegment(line[i], line[from], line[to]);
+            if (d > worstDistance) {
+                worst = i;
+                worstDistance = d;
+            }
+        }
+        if (worst == from) continue;
+        keep[worst] = true;
+        chains.emplace_back(from, worst);
+        chains.emplace_back(worst, to);
+    }
+
+    Line simplified;
+    for (size_t i = 0; i < line.size(); ++i) {
+        if (keep[i]) simplified.push_back(line[i]);
+    }
+    return simplified;
+}
@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/utils/Coord.h"
+
+namespace veins {
+
+class TraCIScenarioManager;
+
+/**
+ * Lane geometry of the road network, prepared for drawing: grouped into batches by road class and square tile,
+ * with simplified versions for coarser levels of detail.
+ *
+ * Used by RoadsCanvasVisualizer and RoadsOsgVisualizer.
+ */
+class VEINS_API RoadsGeometry {
+public:
+    using Line = std::vector<Coord>;
+
+    struct Batch {
+        std::string roadClass; /**< edge type (from the SUMO network file), "internal" for lanes inside junctions, or "road" if unknown */
+        int col; /**< tile column */
+        int row; /**< tile row */
+        std::vector<std::vector<Line>> levels; /**< lane shapes at each level of detail, from full detail to coarsest */
+    };
+
+    /**
+     * Collect the shapes of all lanes, from the SUMO network file of manager if one was given, else via (cached) TraCI queries.
+     *
+     * Level k (for k > 0) is simplified with tolerance (in m) pixelTolerance * 4^(k - 1), internal lanes are dropped from level 2 onwards.
+     */
+    static std::vector<Batch> collect(TraCIScenarioManager* manager, double tileSize, size_t numLevels, double pixelTolerance);
+
+    /**
+     * Return the simplification tolerance (in m) of level, see collect().
+     */
+    static double getLevelTolerance(size_t level, double pixelTolerance);
+
+    /**
+     * Return the coarsest level whose simplification tolerance corresponds to at most pixelTolerance pixels when drawn at scale (pixels per m).
+     */
+    static size_t getLevelForScale(double scale, size_t numLevels, double pixelTolerance);
+
+    /**
+     * Return line without the vertices that are closer than tolerance to the simplified line (Douglas-Peucker), keeping both ends.
+     */
+    static Line simplify(const Line& line, double tolerance);
+};
+
+} // namespace veins
@@ -22,10 +22,13 @@
 
 #include "veins/visualizer/roads/RoadsOsgVisualizer.h"
 
+#include <cfloat>
+
 #ifdef WITH_OSG
 #include <osg/Geode>
 #include <osg/Geometry>
 #include <osg/Group>
+#include <osg/LOD>
 #include <osg/LineWidth>
 #include <osg/Material>
 #endif // ifdef WITH_OSG
@@ -67,19 +70,24 @@ void RoadsOsgVisualizer::initialize(int stage)
         scene->addChild(figures);
 
         auto onTraciInitialized = [this, manager](veins::SignalPayload<bool> payload) {
-            TraCICommandInterface* traci = manager->getCommandInterface();
-            ASSERT(traci);
-
             std::string colorStr = par("lineColor");
             auto color = cFigure::Color(colorStr.c_str());
             double width = par("lineWidth");
-
-            auto laneIds = traci->getLaneIds();
-            for (auto laneId : laneIds) {
-                auto coords = traci->lane(laneId).getShape();
-
-                auto line = createLine(coords, color, width);
-                figures->addChild(line);
+            double tileSize = par("tileSize");
+            int lodLevels = par("lodLevels");
+            double lodPixelTolerance = par("lodPixelTolerance");
+            if (tileSize <= 0) throw cRuntimeError("tileSize was %f, but must be positive", tileSize);
+            if (lodLevels < 1) throw cRuntimeError("lodLevels was %d, but must be at least 1", lodLevels);
+
+            for (const auto& batch : RoadsGeometry::collect(manager, tileSize, lodLevels, lodPixelTolerance)) {
+                // a pixel covers roughly 1/500 of the viewing distance, so level k is accurate enough from 500 times its tolerance (in pixels) on
+                auto lod = new osg::LOD();
+                for (size_t level = 0; level < batch.levels.size(); ++level) {
+                    const float from = 500 * RoadsGeometry::getLevelTolerance(level, lodPixelTolerance) / lodPixelTolerance;
+                    const float to = (level + 1 < batch.levels.size()) ? 500 * RoadsGeometry::getLevelTolerance(level + 1, lodPixelTolerance) / lodPixelTolerance : FLT_MAX;
+                    lod->addChild(createLines(batch.levels[level], color, width), from, to);
+                }
+                figures->addChild(lod);
             }
         };
         signalManager.subscribeCallback(manager, TraCIScenarioManager::traciInitializedSignal, onTraciInitialized);
@@ -95,20 +103,20 @@ void RoadsOsgVisualizer::finish()
 {
 }
 
-osg::Geode* RoadsOsgVisualizer::createLine(const std::list<veins::Coord>& coords, cFigure::Color color, double width)
+osg::Geode* RoadsOsgVisualizer::createLines(const std::vector<RoadsGeometry::Line>& lines, cFigure::Color color, double width)
 {
     auto verts = new osg::Vec3Array();
-    for (auto coord : coords) {
-        verts->push_back(osg::Vec3(coord.x, coord.y, coord.z));
-    }
-
-    auto primitiveSet = new osg::DrawArrays(osg::PrimitiveSet::LINE_STRIP);
-    primitiveSet->setFirst(0);
-    primitiveSet->setCount(verts->size());
-
     auto geometry = new osg::Geometry();
+    for (const auto& line : lines) {
+        auto primitiveSet = new osg::DrawArrays(osg::PrimitiveSet::LINE_STRIP);
+        primitiveSet->setFirst(verts->size());
+        for (const auto& coord : line) {
+            verts->push_back(osg::Vec3(coord.x, coord.y, coord.z));
+        }
+        primitiveSet->setCount(line.size());
+        geometry->addPrimitiveSet(primitiveSet);
+    }
     geometry->setVertexArray(verts);
-    geometry->addPrimitiveSet(primitiveSet);
 
     osg::Vec4 colorVec(color.red / 255.0, color.green / 255.0, color.blue / 255.0, 1.0);
 
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <vector>
+
 #ifdef WITH_OSG
 namespace osg {
 class Geode;
@@ -33,6 +35,7 @@ class Group;
 
 #include "veins/base/utils/Coord.h"
 #include "veins/modules/utility/SignalManager.h"
+#include "veins/visualizer/roads/RoadsGeometry.h"
 
 namespace veins {
 
@@ -40,6 +43,9 @@ namespace veins {
  * @brief
  * Simple support module to visualize road network as received via TraCI.
  *
+ * Lanes are drawn as one geometry per road class and tile, with coarser levels of detail shown at larger viewing distances.
+ * Tiles let OpenSceneGraph cull geometry outside of the view.
+ *
  * See the Veins website <a href="http://veins.car2x.org/"> for a tutorial, documentation, and publications </a>.
  *
  * @author Christoph Sommer
@@ -58,7 +64,7 @@ protected:
     veins::SignalManager signalManager;
     osg::Group* figures;
 
-    osg::Geode* createLine(const std::list<veins::Coord>& coords, cFigure::Color color, double width);
+    osg::Geode* createLines(const std::vector<RoadsGeometry::Line>& lines, cFigure::Color color, double width);
 #endif // WITH_OSG
 };
 
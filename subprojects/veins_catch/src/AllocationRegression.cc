@@ -0,0 +1,205 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "veins/base/toolbox/Signal.h"
+#include "veins/base/toolbox/SignalUtils.h"
+#include "veins/base/toolbox/Spectrum.h"
+#include "veins/base/messages/AirFrame_m.h"
+#include "veins/modules/analogueModel/SimplePathlossModel.h"
+#include "veins/modules/analogueModel/TwoRayInterferenceModel.h"
+#include "veins/modules/mobility/traci/TraCIBuffer.h"
+#include "veins/modules/utility/BBoxLookup.h"
+#include "testutils/AllocationCounter.h"
+#include "testutils/Simulation.h"
+#include "testutils/Component.h"
+
+using namespace veins;
+
+namespace {
+
+// number of repetitions of an operation in steady state
+const size_t repetitions = 100;
+
+Spectrum makeSpectrum()
+{
+    const double centerFreq = 5.9e9;
+    return Spectrum({centerFreq - 5e6, centerFreq, centerFreq + 5e6});
+}
+
+AirFrame* makeAirFrame(const Spectrum& spectrum, simtime_t start, simtime_t length, double power)
+{
+    Signal s(spectrum, start, length);
+    s = power;
+    auto frame = new AirFrame();
+    frame->setSignal(s);
+    return frame;
+}
+
+} // namespace
+
+SCENARIO("Signal arithmetic does not allocate", "[allocation]")
+{
+    const Spectrum spectrum = makeSpectrum();
+    Signal a(spectrum);
+    Signal b(spectrum);
+    Signal c(spectrum);
+    a = 1;
+    b = 2;
+
+    AllocationCounter counter;
+    for (size_t i = 0; i < repetitions; ++i) {
+        a += b;
+        a -= b;
+        a *= b;
+        a /= b;
+        a *= 0.5;
+        a += 1;
+        c = a;
+        c = a * b + 1;
+    }
+    const size_t allocations = counter.getAllocations();
+    REQUIRE(allocations == 0);
+}
+
+SCENARIO("getMinSINR does not allocate in steady state", "[allocation]")
+{
+    const Spectrum spectrum = makeSpectrum();
+    AirFrame* signalFrame = makeAirFrame(spectrum, 0, 0.001, 1e-6);
+    SignalUtils::AirFrameVector interfererFrames;
+    for (size_t i = 0; i < 8; ++i) {
+        interfererFrames.push_back(makeAirFrame(spectrum, 0.0001 * i, 0.0005, 1e-9 * (i + 1)));
+    }
+    interfererFrames.push_back(signalFrame);
+
+    // warm up
+    const double minSinr = SignalUtils::getMinSINR(0, 0.001, signalFrame, interfererFrames, 1e-11);
+
+    AllocationCounter counter;
+    double result = 0;
+    for (size_t i = 0; i < repetitions; ++i) {
+        result = SignalUtils::getMinSINR(0, 0.001, signalFrame, interfererFrames, 1e-11);
+    }
+    const size_t allocations = counter.getAllocations();
+    REQUIRE(allocations == 0);
+    REQUIRE(result == minSinr);
+
+    for (auto frame : interfererFrames) delete frame;
+}
+
+SCENARIO("TraCIBuffer decoding does not allocate in steady state", "[allocation]")
+{
+    TraCIBuffer buf;
+    for (size_t i = 0; i < 16; ++i) {
+        buf << static_cast<uint8_t>(i) << static_cast<int32_t>(i) << 13.5 * i << std::string("a vehicle id, beyond any small string buffer ") + std::to_string(i);
+    }
+    std::string id;
+
+    auto decode = [&buf, &id]() {
+        double sum = 0;
+        buf.rewind();
+        while (!buf.eof()) {
+            sum += buf.read<uint8_t>();
+            sum += buf.read<int32_t>();
+            sum += buf.read<double>();
+            buf.readInto(id);
+        }
+        return sum;
+    };
+
+    // warm up
+    const double expected = decode();
+
+    AllocationCounter counter;
+    double sum = 0;
+    for (size_t i = 0; i < repetitions; ++i) sum = decode();
+    const size_t allocations = counter.getAllocations();
+    REQUIRE(allocations == 0);
+    REQUIRE(sum == expected);
+}
+
+SCENARIO("BBoxLookup::findOverlapping does not allocate when reusing its result", "[allocation]")
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> posX(0, 1000);
+    std::uniform_real_distribution<double> posY(0, 800);
+    std::uniform_real_distribution<double> extent(1, 150);
+
+    // obstacles are only used as opaque handles
+    std::vector<BBoxLookup::Box> boxes;
+    std::vector<Obstacle*> obstacles;
+    for (size_t i = 0; i < 200; ++i) {
+        const double x = posX(rng);
+        const double y = posY(rng);
+        boxes.push_back({{x, y}, {std::min(x + extent(rng), 999.0), std::min(y + extent(rng), 799.0)}});
+        obstacles.push_back(reinterpret_cast<Obstacle*>(i + 1));
+    }
+    BBoxLookup lookup(obstacles, [&boxes](Obstacle* o) { return boxes[reinterpret_cast<size_t>(o) - 1]; }, 1000, 800, 100);
+
+    std::vector<std::pair<BBoxLookup::Point, BBoxLookup::Point>> links;
+    for (size_t i = 0; i < repetitions; ++i) links.push_back({{posX(rng), posY(rng)}, {posX(rng), posY(rng)}});
+
+    // warm up (the longest diagonal crosses most obstacles)
+    std::vector<Obstacle*> found;
+    found.reserve(obstacles.size());
+    lookup.findOverlapping({0, 0}, {999, 799}, found);
+
+    AllocationCounter counter;
+    size_t numFound = 0;
+    for (const auto& link : links) {
+        lookup.findOverlapping(link.first, link.second, found);
+        numFound += found.size();
+    }
+    const size_t allocations = counter.getAllocations();
+    REQUIRE(allocations == 0);
+    REQUIRE(numFound > 0);
+}
+
+SCENARIO("filterSignal of a typical model chain does not allocate", "[allocation]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    DummyComponent dc(&ds);
+    SimplePathlossModel pathloss(&dc, 2.0, false, {0, 0, 0});
+    TwoRayInterferenceModel twoRay(&dc, 1.02);
+
+    int dummyId = -1;
+    Signal original(makeSpectrum(), 0, 0.001);
+    original = 1;
+    original.setSenderPoa({{dummyId, Coord(0, 0, 2), Coord(0, 0, 0), simTime()}, {}, nullptr});
+    original.setReceiverPoa({{dummyId, Coord(100, 0, 2), Coord(0, 0, 0), simTime()}, {}, nullptr});
+    Signal s = original;
+
+    AllocationCounter counter;
+    for (size_t i = 0; i < repetitions; ++i) {
+        s = original;
+        pathloss.filterSignal(&s);
+        twoRay.filterSignal(&s);
+    }
+    const size_t allocations = counter.getAllocations();
+    REQUIRE(allocations == 0);
+    REQUIRE(s.at(1) < 1e-6);
+}
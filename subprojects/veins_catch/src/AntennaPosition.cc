@@ -76,3 +76,23 @@ SCENARIO("Using AntennaPosition", "[toolbox]")
         }
     }
 }
+
+SCENARIO("Using AntennaPosition with acceleration", "[toolbox]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+
+    GIVEN("An AntennaPosition at (0, 0, 0) moving by (10, 0, 0) each second after 0, decelerating by 2 each second")
+    {
+        auto p = AntennaPosition(1, Coord(0, 0, 0), Coord(10, 0, 0), Coord(-2, 0, 0), SimTime(0, SIMTIME_S));
+
+        THEN("its x value at t=1 is 9")
+        {
+            REQUIRE(p.getPositionAt(1).x == Approx(9));
+        }
+        THEN("it comes to a halt at x=25 instead of reversing")
+        {
+            REQUIRE(p.getPositionAt(5).x == Approx(25));
+            REQUIRE(p.getPositionAt(10).x == Approx(25));
+        }
+    }
+}
@@ -0,0 +1,217 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/Simulation.h"
+
+#include "veins/modules/utility/AppTask.h"
+
+using veins::AppTask;
+using veins::AppTaskScheduler;
+
+namespace {
+
+class CountingTask : public AppTask {
+public:
+    CountingTask(AppTaskScheduler& tasks)
+        : tasks(tasks)
+    {
+    }
+
+    AppTaskScheduler& tasks;
+    int received = 0;
+    omnetpp::cObject* lastEvent = nullptr;
+
+protected:
+    void resume() override
+    {
+        VEINS_TASK_BEGIN();
+        while (received < 3) {
+            VEINS_TASK_AWAIT(tasks.waitFor(*this, 2));
+            lastEvent = tasks.getEvent();
+            received++;
+        }
+        VEINS_TASK_END();
+    }
+};
+
+/**
+ * Waits for events of type 5, giving up after each timeout and trying again (up to a number of attempts)
+ */
+class RetryingTask : public AppTask {
+public:
+    RetryingTask(AppTaskScheduler& tasks)
+        : tasks(tasks)
+    {
+    }
+
+    AppTaskScheduler& tasks;
+    int attempts = 0;
+    int timeouts = 0;
+
+protected:
+    void resume() override
+    {
+        VEINS_TASK_BEGIN();
+        while (attempts++ < 3) {
+            VEINS_TASK_AWAIT(tasks.waitFor(*this, 5) && tasks.timeoutAfter(*this, 0));
+            if (tasks.getEvent()) break;
+            timeouts++;
+        }
+        VEINS_TASK_END();
+    }
+};
+
+/**
+ * Module owning the self-message of an AppTaskScheduler, remembering it instead of scheduling it
+ */
+class WakeupModule : public omnetpp::cSimpleModule {
+public:
+    omnetpp::cMessage* scheduled = nullptr;
+
+    void scheduleAt(omnetpp::simtime_t t, omnetpp::cMessage* msg) override
+    {
+        scheduled = msg;
+    }
+
+    omnetpp::cMessage* cancelEvent(omnetpp::cMessage* msg) override
+    {
+        if (msg == scheduled) scheduled = nullptr;
+        return msg;
+    }
+};
+
+} // namespace
+
+SCENARIO("AppTask", "[apptask]")
+{
+    GIVEN("A scheduler and a task waiting for three events of type 2")
+    {
+        AppTaskScheduler tasks(nullptr);
+        CountingTask task(tasks);
+        omnetpp::cMessage event;
+
+        REQUIRE(task.isDone());
+        tasks.start(task);
+        REQUIRE(task.isWaiting());
+        REQUIRE(tasks.hasWaiters(2));
+        REQUIRE_FALSE(tasks.hasWaiters(1));
+
+        WHEN("events of other types are notified")
+        {
+            tasks.notify(1, &event);
+            tasks.notify(3, &event);
+            THEN("the task is not resumed")
+            {
+                REQUIRE(task.received == 0);
+                REQUIRE(tasks.getNumResumes() == 1);
+            }
+        }
+        WHEN("three events of type 2 are notified")
+        {
+            tasks.notify(2, &event);
+            REQUIRE(task.received == 1);
+            REQUIRE(task.lastEvent == &event);
+            tasks.notify(2, &event);
+            tasks.notify(2, &event);
+            THEN("the task runs to its end, consuming one event per await")
+            {
+                REQUIRE(task.received == 3);
+                REQUIRE(task.isDone());
+                REQUIRE_FALSE(task.isWaiting());
+                REQUIRE_FALSE(tasks.hasWaiters(2));
+                tasks.notify(2, &event);
+                REQUIRE(task.received == 3);
+            }
+        }
+        WHEN("the task is cancelled")
+        {
+            tasks.cancel(task);
+            tasks.notify(2, &event);
+            THEN("it is done and no longer resumed")
+            {
+                REQUIRE(task.isDone());
+                REQUIRE(task.received == 0);
+                REQUIRE_FALSE(tasks.hasWaiters(2));
+            }
+        }
+    }
+}
+
+SCENARIO("AppTask with timeouts", "[apptask]")
+{
+    DummySimulation ds(new omnetpp::cNullEnvir(0, nullptr, nullptr));
+
+    GIVEN("A task waiting for an event of type 5 or a timeout, three times")
+    {
+        WakeupModule module;
+        AppTaskScheduler tasks(&module);
+        RetryingTask task(tasks);
+        tasks.start(task);
+        REQUIRE(module.scheduled);
+        REQUIRE(tasks.hasWaiters(5));
+
+        WHEN("an event arrives first")
+        {
+            omnetpp::cMessage event;
+            tasks.notify(5, &event);
+
+            THEN("the task ends and its timeout no longer resumes it")
+            {
+                REQUIRE(task.isDone());
+                REQUIRE(task.timeouts == 0);
+                omnetpp::cMessage* wakeup = module.scheduled;
+                module.scheduled = nullptr;
+                REQUIRE(tasks.handleMessage(wakeup));
+                REQUIRE(tasks.getNumResumes() == 2);
+            }
+        }
+        WHEN("the timeouts fire (each due at once, so they are all handled by one wakeup)")
+        {
+            omnetpp::cMessage* wakeup = module.scheduled;
+            module.scheduled = nullptr;
+            REQUIRE(tasks.handleMessage(wakeup));
+
+            THEN("the task ends without leaving waiters behind")
+            {
+                REQUIRE(task.timeouts == 3);
+                REQUIRE(task.isDone());
+                REQUIRE_FALSE(tasks.hasWaiters(5));
+            }
+        }
+        WHEN("the scheduler is reset")
+        {
+            tasks.reset();
+
+            THEN("the task is forgotten until it is started again")
+            {
+                REQUIRE_FALSE(module.scheduled);
+                REQUIRE_FALSE(tasks.hasWaiters(5));
+                REQUIRE(tasks.getNumResumes() == 0);
+                tasks.start(task);
+                REQUIRE(module.scheduled);
+                REQUIRE(tasks.hasWaiters(5));
+            }
+        }
+    }
+}
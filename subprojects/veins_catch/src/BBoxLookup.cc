@@ -0,0 +1,209 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "veins/modules/utility/BBoxLookup.h"
+#include "veins/base/utils/WorkerPool.h"
+
+using veins::BBoxLookup;
+using veins::Obstacle;
+using veins::WorkerPool;
+
+namespace {
+
+// return whether the segment from a to b crosses box (Liang-Barsky clipping)
+bool segmentCrossesBox(BBoxLookup::Point a, BBoxLookup::Point b, BBoxLookup::Box box)
+{
+    double t0 = 0;
+    double t1 = 1;
+    const double d[2] = {b.x - a.x, b.y - a.y};
+    const double lo[2] = {box.p1.x - a.x, box.p1.y - a.y};
+    const double hi[2] = {box.p2.x - a.x, box.p2.y - a.y};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (d[axis] == 0) {
+            if (lo[axis] > 0 || hi[axis] < 0) return false;
+            continue;
+        }
+        double tLo = lo[axis] / d[axis];
+        double tHi = hi[axis] / d[axis];
+        if (tLo > tHi) std::swap(tLo, tHi);
+        t0 = std::max(t0, tLo);
+        t1 = std::min(t1, tHi);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SCENARIO("BBoxLookup finds obstacles along a transmission", "[obstacle]")
+{
+    GIVEN("Random boxes on a 1000m x 800m playground with 100m cells")
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> posX(0, 1000);
+        std::uniform_real_distribution<double> posY(0, 800);
+        std::uniform_real_distribution<double> extent(1, 150);
+
+        // obstacles are only used as opaque handles
+        std::vector<BBoxLookup::Box> boxes;
+        std::vector<Obstacle*> obstacles;
+        for (size_t i = 0; i < 200; ++i) {
+            const double x = posX(rng);
+            const double y = posY(rng);
+            boxes.push_back({{x, y}, {std::min(x + extent(rng), 999.0), std::min(y + extent(rng), 799.0)}});
+            obstacles.push_back(reinterpret_cast<Obstacle*>(i + 1));
+        }
+        BBoxLookup lookup(obstacles, [&boxes](Obstacle* o) { return boxes[reinterpret_cast<size_t>(o) - 1]; }, 1000, 800, 100);
+
+        THEN("each query returns exactly the obstacles whose bounding box the transmission crosses, without duplicates")
+        {
+            for (size_t query = 0; query < 500; ++query) {
+                const BBoxLookup::Point sender{posX(rng), posY(rng)};
+                const BBoxLookup::Point receiver{posX(rng), posY(rng)};
+
+                std::vector<Obstacle*> expected;
+                for (size_t i = 0; i < boxes.size(); ++i) {
+                    if (segmentCrossesBox(sender, receiver, boxes[i])) expected.push_back(obstacles[i]);
+                }
+                auto found = lookup.findOverlapping(sender, receiver);
+                const size_t numFound = found.size();
+                std::sort(found.begin(), found.end());
+                REQUIRE(std::unique(found.begin(), found.end()) == found.end());
+                REQUIRE(numFound == expected.size());
+                REQUIRE(found == expected);
+            }
+        }
+
+        WHEN("every other obstacle is removed and new ones are inserted incrementally")
+        {
+            std::vector<BBoxLookup::Box> newBoxes = boxes;
+            std::vector<Obstacle*> remaining;
+            for (size_t i = 0; i < obstacles.size(); ++i) {
+                if (i % 2 == 0) {
+                    REQUIRE(lookup.remove(obstacles[i]));
+                }
+                else {
+                    remaining.push_back(obstacles[i]);
+                }
+            }
+            for (size_t i = 200; i < 300; ++i) {
+                const double x = posX(rng);
+                const double y = posY(rng);
+                newBoxes.push_back({{x, y}, {std::min(x + extent(rng), 999.0), std::min(y + extent(rng), 799.0)}});
+                Obstacle* o = reinterpret_cast<Obstacle*>(i + 1);
+                lookup.insert(o, newBoxes.back());
+                remaining.push_back(o);
+            }
+            BBoxLookup rebuilt(remaining, [&newBoxes](Obstacle* o) { return newBoxes[reinterpret_cast<size_t>(o) - 1]; }, 1000, 800, 100);
+
+            THEN("queries return the same obstacles as a lookup built from scratch, before and after compaction")
+            {
+                REQUIRE_FALSE(lookup.remove(obstacles[0]));
+                for (bool compacted : {false, true}) {
+                    if (compacted) lookup.compact();
+                    for (size_t query = 0; query < 200; ++query) {
+                        const BBoxLookup::Point sender{posX(rng), posY(rng)};
+                        const BBoxLookup::Point receiver{posX(rng), posY(rng)};
+                        auto found = lookup.findOverlapping(sender, receiver);
+                        auto expected = rebuilt.findOverlapping(sender, receiver);
+                        std::sort(found.begin(), found.end());
+                        std::sort(expected.begin(), expected.end());
+                        REQUIRE(found == expected);
+                    }
+                }
+            }
+        }
+
+        WHEN("queries are run with a caller-owned query state")
+        {
+            BBoxLookup::QueryState state;
+
+            THEN("each query returns the same obstacles as one using the lookup's own state")
+            {
+                std::vector<Obstacle*> found;
+                for (size_t query = 0; query < 500; ++query) {
+                    const BBoxLookup::Point sender{posX(rng), posY(rng)};
+                    const BBoxLookup::Point receiver{posX(rng), posY(rng)};
+                    lookup.findOverlapping(sender, receiver, found, state);
+                    REQUIRE(found == lookup.findOverlapping(sender, receiver));
+                }
+            }
+        }
+
+        WHEN("the lookup is restored from its cell table")
+        {
+            BBoxLookup restored(obstacles, [&boxes](Obstacle* o) { return boxes[reinterpret_cast<size_t>(o) - 1]; }, lookup.getCellTable());
+
+            THEN("each query returns the same obstacles as the original lookup")
+            {
+                for (size_t query = 0; query < 500; ++query) {
+                    const BBoxLookup::Point sender{posX(rng), posY(rng)};
+                    const BBoxLookup::Point receiver{posX(rng), posY(rng)};
+                    REQUIRE(restored.findOverlapping(sender, receiver) == lookup.findOverlapping(sender, receiver));
+                }
+            }
+        }
+
+        WHEN("all boxes are in the same cell")
+        {
+            BBoxLookup dense(obstacles, [&boxes](Obstacle* o) { return boxes[reinterpret_cast<size_t>(o) - 1]; }, 1000, 800, 1000);
+
+            THEN("each query returns the same obstacles as with smaller cells, in the order they were given")
+            {
+                for (size_t query = 0; query < 500; ++query) {
+                    const BBoxLookup::Point sender{posX(rng), posY(rng)};
+                    const BBoxLookup::Point receiver{posX(rng), posY(rng)};
+                    auto found = dense.findOverlapping(sender, receiver);
+                    auto expected = lookup.findOverlapping(sender, receiver);
+                    std::sort(expected.begin(), expected.end());
+                    REQUIRE(found == expected);
+                }
+            }
+        }
+
+        WHEN("the lookup is built by several threads")
+        {
+            WorkerPool pool(3);
+            BBoxLookup parallel(obstacles, [&boxes](Obstacle* o) { return boxes[reinterpret_cast<size_t>(o) - 1]; }, 1000, 800, 100, &pool);
+
+            THEN("it has the same cell table as the one built by a single thread")
+            {
+                const BBoxLookup::CellTable expected = lookup.getCellTable();
+                const BBoxLookup::CellTable table = parallel.getCellTable();
+                REQUIRE(table.numCols == expected.numCols);
+                REQUIRE(table.numRows == expected.numRows);
+                REQUIRE(table.entries == expected.entries);
+                REQUIRE(table.cells.size() == expected.cells.size());
+                for (size_t i = 0; i < table.cells.size(); ++i) {
+                    REQUIRE(table.cells[i].index == expected.cells[i].index);
+                    REQUIRE(table.cells[i].count == expected.cells[i].count);
+                }
+            }
+        }
+    }
+}
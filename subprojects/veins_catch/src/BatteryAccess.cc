@@ -0,0 +1,148 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/Simulation.h"
+
+#include "veins/base/modules/BaseBattery.h"
+#include "veins/base/modules/BatteryAccess.h"
+
+using namespace veins;
+
+namespace {
+
+/**
+ * Battery that sums up the energy drawn from it
+ */
+class SummingBattery : public BaseBattery {
+public:
+    using BaseBattery::integrateLazyDraws;
+
+    int registerDevice(const std::string& name, int numAccounts) override
+    {
+        return 0;
+    }
+
+    void draw(int drainID, DrawAmount& amount, int account) override
+    {
+        REQUIRE(amount.getType() == DrawAmount::ENERGY);
+        energy += amount.getValue();
+        numDraws++;
+    }
+
+    double getVoltage() const override
+    {
+        return 3;
+    }
+
+    double estimateResidualRelative() const override
+    {
+        return 1;
+    }
+
+    double estimateResidualAbs() const override
+    {
+        return 0;
+    }
+
+    HostState::States getState() const override
+    {
+        return HostState::ACTIVE;
+    }
+
+    size_t getNumLazyDevices() const
+    {
+        return lazyDevices.size();
+    }
+
+    double energy = 0;
+    int numDraws = 0;
+};
+
+/**
+ * Device drawing lazily from a battery, registered with it like registerWithBattery() does for a module with lazyBatteryDraw set
+ */
+class LazyDevice : public BatteryAccess {
+public:
+    void useBattery(BaseBattery* battery)
+    {
+        this->battery = battery;
+        lazyBatteryDraw = true;
+        pendingDraws.assign(1, PendingDraw());
+        battery->registerLazyDevice(this);
+    }
+
+    using BatteryAccess::drawEnergy;
+};
+
+} // namespace
+
+SCENARIO("BaseBattery flushes each lazy device once", "[battery]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    SummingBattery battery;
+    LazyDevice device;
+    device.useBattery(&battery);
+
+    WHEN("the device draws energy")
+    {
+        device.drawEnergy(5, 0);
+        device.drawEnergy(2, 0);
+
+        THEN("nothing is drawn from the battery until it integrates lazy draws")
+        {
+            REQUIRE(battery.numDraws == 0);
+            battery.integrateLazyDraws();
+            REQUIRE(battery.numDraws == 1);
+            REQUIRE(battery.energy == Approx(7));
+        }
+    }
+
+    WHEN("the device is registered again (e.g., after being reset for reuse) and draws energy")
+    {
+        battery.registerLazyDevice(&device);
+        device.drawEnergy(5, 0);
+        battery.integrateLazyDraws();
+
+        THEN("its draws are flushed once")
+        {
+            REQUIRE(battery.getNumLazyDevices() == 1);
+            REQUIRE(battery.numDraws == 1);
+            REQUIRE(battery.energy == Approx(5));
+        }
+
+        AND_WHEN("it is unregistered after drawing more")
+        {
+            device.drawEnergy(1, 0);
+            battery.unregisterLazyDevice(&device);
+            battery.integrateLazyDraws();
+
+            THEN("the battery no longer flushes it")
+            {
+                REQUIRE(battery.getNumLazyDevices() == 0);
+                REQUIRE(battery.numDraws == 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,169 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "veins/base/utils/CalendarQueue.h"
+
+namespace {
+
+struct Item {
+    int64_t time = 0;
+    short priority = 0;
+    int position = -1;
+};
+
+struct ItemPosition {
+    static int& of(Item* item)
+    {
+        return item->position;
+    }
+};
+
+using Queue = veins::CalendarQueue<Item, ItemPosition>;
+
+} // namespace
+
+SCENARIO("CalendarQueue returns items in the order of time, priority, and insertion", "[calendarQueue]")
+{
+    GIVEN("Items at the same time with different priorities")
+    {
+        Queue queue(10);
+        std::vector<Item> items(6);
+        const short priorities[] = {1, 0, 1, 0, -1, 0};
+        for (size_t i = 0; i < items.size(); ++i) {
+            items[i].time = 100;
+            items[i].priority = priorities[i];
+            queue.insert(&items[i], queue.makeKey(items[i].time, items[i].priority));
+        }
+        THEN("They come out by priority, then in insertion order")
+        {
+            std::vector<Item*> order;
+            while (Item* item = queue.removeFirst()) order.push_back(item);
+            REQUIRE(order == std::vector<Item*>({&items[4], &items[1], &items[3], &items[5], &items[0], &items[2]}));
+            REQUIRE(queue.empty());
+            for (auto& item : items) REQUIRE(item.position == -1);
+        }
+    }
+
+    GIVEN("A random mix of insertions, removals, and bursts")
+    {
+        std::mt19937 rng(42);
+        Queue queue(1);
+        std::vector<std::unique_ptr<Item>> items;
+        std::set<std::tuple<int64_t, short, uint64_t, Item*>> reference;
+        int64_t now = 0;
+
+        auto insert = [&](int64_t time) {
+            items.emplace_back(new Item());
+            Item* item = items.back().get();
+            item->time = time;
+            item->priority = static_cast<short>(rng() % 3) - 1;
+            const Queue::Key key = queue.makeKey(item->time, item->priority);
+            queue.insert(item, key);
+            reference.emplace(key.time, key.priority, key.sequence, item);
+        };
+
+        THEN("It agrees with a sorted reference and stays consistent while growing and shrinking")
+        {
+            bool consistent = true;
+            size_t maxBuckets = 0;
+            for (size_t step = 0; step < 20000 && consistent; ++step) {
+                const unsigned op = rng() % 10;
+                if (op < 4 || reference.empty()) {
+                    // spread over the next second, in ms
+                    insert(now + static_cast<int64_t>(rng() % 1000000));
+                }
+                else if (op < 5) {
+                    // a burst of items at the same time
+                    const int64_t time = now + static_cast<int64_t>(rng() % 1000);
+                    for (int i = 0; i < 50; ++i) insert(time);
+                }
+                else if (op < 6) {
+                    // cancel a random queued item
+                    auto it = reference.begin();
+                    std::advance(it, rng() % reference.size());
+                    Item* item = std::get<3>(*it);
+                    consistent &= queue.remove(item, item->time) == item;
+                    consistent &= queue.remove(item, item->time) == nullptr;
+                    reference.erase(it);
+                }
+                else {
+                    Queue::Key key;
+                    Item* first = queue.peekFirst();
+                    Item* removed = queue.removeFirst(&key);
+                    consistent &= first == removed && removed == std::get<3>(*reference.begin());
+                    consistent &= key.time == removed->time && key.sequence == std::get<2>(*reference.begin());
+                    consistent &= removed->position == -1;
+                    now = key.time;
+                    reference.erase(reference.begin());
+                }
+                consistent &= queue.size() == reference.size();
+                maxBuckets = std::max(maxBuckets, queue.getNumBuckets());
+            }
+            REQUIRE(consistent);
+            REQUIRE(maxBuckets > 16);
+
+            // drain
+            while (!reference.empty() && consistent) {
+                consistent &= queue.removeFirst() == std::get<3>(*reference.begin());
+                reference.erase(reference.begin());
+            }
+            REQUIRE(consistent);
+            REQUIRE(queue.empty());
+            REQUIRE(queue.getNumBuckets() == 16);
+        }
+    }
+
+    GIVEN("Items far apart")
+    {
+        Queue queue(1);
+        std::vector<Item> items(100);
+        for (size_t i = 0; i < items.size(); ++i) {
+            items[i].time = static_cast<int64_t>(items.size() - i) * 1000000000;
+            queue.insert(&items[i], queue.makeKey(items[i].time, 0));
+        }
+        THEN("They are still found in order")
+        {
+            for (size_t i = items.size(); i-- > 0;) {
+                REQUIRE(queue.removeFirst() == &items[i]);
+            }
+        }
+        WHEN("The queue is cleared")
+        {
+            queue.clear();
+            THEN("It is empty and no item is queued any more")
+            {
+                REQUIRE(queue.empty());
+                REQUIRE(queue.peekFirst() == nullptr);
+                for (auto& item : items) REQUIRE(item.position == -1);
+            }
+        }
+    }
+}
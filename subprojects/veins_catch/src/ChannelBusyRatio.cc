@@ -0,0 +1,106 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/Simulation.h"
+
+#include "veins/modules/utility/ChannelBusyRatio.h"
+#include "veins/modules/mac/ieee80211p/ReactiveDcc.h"
+
+using namespace veins;
+
+SCENARIO("ChannelBusyRatio", "[cbr]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+
+    GIVEN("A tracker with 100 ms intervals starting at 0 s")
+    {
+        ChannelBusyRatio cbr(0.1, 0);
+
+        THEN("it reports 0 before the first interval completed")
+        {
+            cbr.setBusy(0.01, true);
+            REQUIRE(cbr.getLastRatio(0.05) == 0);
+            REQUIRE(cbr.getNumIntervals(0.05) == 0);
+        }
+
+        WHEN("the channel is busy for 10 ms twice in the first interval")
+        {
+            cbr.setBusy(0.01, true);
+            cbr.setBusy(0.02, false);
+            cbr.setBusy(0.05, true);
+            cbr.setBusy(0.06, false);
+
+            THEN("the first interval has a CBR of 0.2")
+            {
+                REQUIRE(cbr.getLastRatio(0.15) == Approx(0.2));
+                REQUIRE(cbr.getNumIntervals(0.15) == 1);
+            }
+        }
+
+        WHEN("the channel turns busy within the first interval and stays busy")
+        {
+            cbr.setBusy(0.075, true);
+
+            THEN("busy time is split at interval boundaries and skipped intervals count as fully busy")
+            {
+                REQUIRE(cbr.getLastRatio(0.12) == Approx(0.25));
+                REQUIRE(cbr.getLastRatio(0.35) == Approx(1));
+                REQUIRE(cbr.getNumIntervals(0.35) == 3);
+            }
+
+            AND_WHEN("it turns idle again in the middle of the fourth interval")
+            {
+                cbr.setBusy(0.34, false);
+
+                THEN("the fourth interval has a CBR of 0.4")
+                {
+                    REQUIRE(cbr.getLastRatio(0.41) == Approx(0.4));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("ReactiveDcc", "[dcc]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+
+    GIVEN("A controller with relaxed, active, and restrictive states")
+    {
+        ReactiveDcc dcc({{0, 1000, 0.05}, {0.3, 100, 0.1}, {0.6, 1, 1}});
+
+        THEN("it starts relaxed and moves to the state for each CBR")
+        {
+            REQUIRE(dcc.getStateIndex() == 0);
+            REQUIRE(dcc.update(0.45));
+            REQUIRE(dcc.getStateIndex() == 1);
+            REQUIRE(dcc.getState().maxTxPower_mW == 100);
+            REQUIRE_FALSE(dcc.update(0.5));
+            REQUIRE(dcc.update(0.9));
+            REQUIRE(dcc.getStateIndex() == 2);
+            REQUIRE(dcc.update(0.1));
+            REQUIRE(dcc.getStateIndex() == 0);
+        }
+    }
+}
@@ -0,0 +1,199 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+
+#include "veins/base/phyLayer/ChannelInfo.h"
+#include "testutils/Simulation.h"
+
+using namespace veins;
+
+namespace {
+
+AirFrame* createAirFrame(simtime_t duration)
+{
+    AirFrame* frame = new AirFrame();
+    frame->setDuration(duration);
+    return frame;
+}
+
+AirFrame* createAirFrame(simtime_t duration, const Spectrum& spectrum, size_t dataStart, size_t dataEnd)
+{
+    AirFrame* frame = createAirFrame(duration);
+    Signal signal(spectrum);
+    signal.setDataStart(dataStart);
+    signal.setDataEnd(dataEnd);
+    frame->setSignal(signal);
+    return frame;
+}
+
+} // namespace
+
+SCENARIO("ChannelInfo keeps track of intersecting AirFrames", "[phyLayer]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+    GIVEN("A ChannelInfo with AirFrames a (0 to 10), b (2 to 7) and c (8 to 18)")
+    {
+        ChannelInfo channelInfo;
+        ChannelInfo::AirFrameVector out;
+        AirFrame* a = createAirFrame(10);
+        AirFrame* b = createAirFrame(5);
+        AirFrame* c = createAirFrame(10);
+        channelInfo.addAirFrame(a, 0);
+        channelInfo.addAirFrame(b, 2);
+        channelInfo.addAirFrame(c, 8);
+
+        THEN("intersection queries return exactly the overlapping AirFrames")
+        {
+            channelInfo.getAirFrames(1, 1, out);
+            REQUIRE(out.size() == 1);
+            REQUIRE(out.front() == a);
+            out.clear();
+
+            channelInfo.getAirFrames(7, 9, out);
+            REQUIRE(out.size() == 3);
+        }
+        WHEN("b is removed")
+        {
+            REQUIRE(channelInfo.removeAirFrame(b) == 0);
+            THEN("it is still returned because it intersects with the active AirFrame a")
+            {
+                channelInfo.getAirFrames(3, 4, out);
+                REQUIRE(out.size() == 2);
+            }
+            WHEN("a is removed as well")
+            {
+                REQUIRE(channelInfo.removeAirFrame(a) == 0);
+                THEN("b is discarded, but a is kept as it intersects with the active AirFrame c")
+                {
+                    channelInfo.getAirFrames(0, 20, out);
+                    REQUIRE(out.size() == 2);
+                    REQUIRE(std::find(out.begin(), out.end(), a) != out.end());
+                    REQUIRE(std::find(out.begin(), out.end(), c) != out.end());
+                }
+                WHEN("c is removed as well")
+                {
+                    THEN("the channel is empty")
+                    {
+                        REQUIRE(channelInfo.removeAirFrame(c) == -1);
+                        REQUIRE(channelInfo.isChannelEmpty());
+                    }
+                }
+            }
+        }
+        // ChannelInfo does not delete the AirFrames it still holds on destruction
+        ChannelInfo::AirFrameVector remaining;
+        channelInfo.getAirFrames(0, 20, remaining);
+        for (auto frame : remaining) {
+            delete frame;
+        }
+    }
+}
+
+SCENARIO("ChannelInfo partitioned by band returns only AirFrames of overlapping bands", "[phyLayer]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+    GIVEN("A partitioned ChannelInfo with AirFrames a (0 to 10, indices 0 to 2), b (2 to 7, indices 2 to 4) and c (8 to 10, indices 6 to 8)")
+    {
+        const Spectrum spectrum({1, 2, 3, 4, 5, 6, 7, 8, 9});
+        ChannelInfo channelInfo;
+        channelInfo.setPartitionedByBand(true);
+        ChannelInfo::AirFrameVector out;
+        AirFrame* a = createAirFrame(10, spectrum, 0, 2);
+        AirFrame* b = createAirFrame(5, spectrum, 2, 4);
+        AirFrame* c = createAirFrame(2, spectrum, 6, 8);
+        channelInfo.addAirFrame(a, 0);
+        channelInfo.addAirFrame(b, 2);
+        channelInfo.addAirFrame(c, 8);
+
+        THEN("band queries skip AirFrames of other bands")
+        {
+            channelInfo.getAirFrames(5, 5, 0, 2, out);
+            REQUIRE(out == ChannelInfo::AirFrameVector({a}));
+            out.clear();
+
+            channelInfo.getAirFrames(5, 5, 2, 3, out);
+            REQUIRE(out == ChannelInfo::AirFrameVector({b, a}));
+            out.clear();
+
+            channelInfo.getAirFrames(5, 5, 5, 6, out);
+            REQUIRE(out.empty());
+        }
+        THEN("a query of the whole spectrum returns the AirFrames in the same order as an unpartitioned query")
+        {
+            ChannelInfo::AirFrameVector all;
+            channelInfo.getAirFrames(0, 10, all);
+            channelInfo.getAirFrames(0, 10, 0, 9, out);
+            REQUIRE(out == all);
+            REQUIRE(out == ChannelInfo::AirFrameVector({b, a, c}));
+        }
+        WHEN("b and then a are removed")
+        {
+            channelInfo.removeAirFrame(b);
+            channelInfo.removeAirFrame(a);
+            THEN("b is discarded from its band, but a is still returned for its band")
+            {
+                channelInfo.getAirFrames(0, 10, 2, 4, out);
+                REQUIRE(out == ChannelInfo::AirFrameVector({a}));
+            }
+        }
+        ChannelInfo::AirFrameVector remaining;
+        channelInfo.getAirFrames(0, 20, remaining);
+        for (auto frame : remaining) {
+            delete frame;
+        }
+    }
+}
+
+SCENARIO("ChannelInfo compacting inactive AirFrames deletes their payload", "[phyLayer]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+    GIVEN("A compacting ChannelInfo with AirFrames a (0 to 10) and b (2 to 7), b carrying a packet of 100 bytes")
+    {
+        ChannelInfo channelInfo;
+        channelInfo.setCompactingInactive(true);
+        ChannelInfo::AirFrameVector out;
+        AirFrame* a = createAirFrame(10);
+        AirFrame* b = createAirFrame(5);
+        cPacket* packet = new cPacket();
+        packet->setByteLength(100);
+        b->encapsulate(packet);
+        channelInfo.addAirFrame(a, 0);
+        channelInfo.addAirFrame(b, 2);
+
+        WHEN("b is removed")
+        {
+            channelInfo.removeAirFrame(b);
+            THEN("it is still returned, but without its packet")
+            {
+                channelInfo.getAirFrames(3, 3, out);
+                REQUIRE(out.size() == 2);
+                REQUIRE(std::find(out.begin(), out.end(), b) != out.end());
+                REQUIRE(b->getEncapsulatedPacket() == nullptr);
+                REQUIRE(b->getDuration() == 5);
+                REQUIRE(channelInfo.getCompactedBytes() == 100);
+            }
+        }
+    }
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/Simulation.h"
+
+#include "veins/modules/messages/CompactSafetyMessage.h"
+
+using veins::CompactSafetyMessage;
+using veins::Coord;
+
+SCENARIO("CompactSafetyMessage", "[messages]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    GIVEN("A CompactSafetyMessage with sender position and speed set")
+    {
+        CompactSafetyMessage bsm;
+        bsm.setSenderPos(Coord(1234.5, 678.25, 1.895));
+        bsm.setSenderSpeed(Coord(13.9, -2.5, 0));
+
+        THEN("it reports the values in single precision and the compact message type")
+        {
+            REQUIRE(bsm.getSenderPos().x == Approx(1234.5));
+            REQUIRE(bsm.getSenderPos().y == Approx(678.25));
+            REQUIRE(bsm.getSenderPos().z == Approx(1.895));
+            REQUIRE(bsm.getSenderSpeed().x == Approx(13.9));
+            REQUIRE(bsm.getSenderSpeed().y == Approx(-2.5));
+            REQUIRE(bsm.getMessageType() == CompactSafetyMessage::messageTypeId);
+        }
+
+        WHEN("it is duplicated")
+        {
+            CompactSafetyMessage* copy = bsm.dup();
+
+            THEN("the copy carries the same payload")
+            {
+                REQUIRE(copy->getSenderPos() == bsm.getSenderPos());
+                REQUIRE(copy->getSenderSpeed() == bsm.getSenderSpeed());
+                REQUIRE(copy->getMessageType() == CompactSafetyMessage::messageTypeId);
+            }
+
+            delete copy;
+        }
+    }
+}
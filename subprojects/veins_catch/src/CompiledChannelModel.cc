@@ -0,0 +1,191 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "veins/base/phyLayer/CompiledChannelModel.h"
+#include "veins/modules/analogueModel/SimplePathlossModel.h"
+#include "veins/modules/analogueModel/TwoRayInterferenceModel.h"
+#include "veins/base/toolbox/Spectrum.h"
+#include "veins/base/toolbox/Signal.h"
+#include "testutils/Simulation.h"
+#include "testutils/Component.h"
+#include "testutils/DummyAnalogueModel.h"
+
+using namespace veins;
+
+namespace {
+
+int dummyId = -1;
+
+AntennaPosition createDummyAntennaPosition(Coord c)
+{
+    return AntennaPosition(dummyId, c, Coord(0, 0, 0), simTime());
+}
+
+} // namespace
+
+SCENARIO("CompiledChannelModel", "[analogueModel]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    DummyComponent dc(&ds);
+    double centerFreq = 5.9e9;
+    std::vector<double> freqs = {centerFreq - 5e6, centerFreq, centerFreq + 5e6};
+    Spectrum spec(freqs);
+
+    AnalogueModelList models;
+    models.emplace_back(new SimplePathlossModel(&dc, 2.0, false, {0, 0, 0}));
+    models.emplace_back(new TwoRayInterferenceModel(&dc, 1.02));
+    models.emplace_back(new DummyAnalogueModel(&dc, 0.5));
+    models.emplace_back(new SimplePathlossModel(&dc, 2.2, false, {0, 0, 0}));
+
+    GIVEN("A chain of two path loss models, two ray interference, and a model without kernel")
+    {
+        CompiledChannelModel compiled(models);
+
+        THEN("all but the custom model are fused")
+        {
+            REQUIRE(compiled.getNumFusedModels() == 3);
+        }
+
+        WHEN("a signal sent from (0, 0) is received at (150, 30)")
+        {
+            const Coord senderPos(0, 0, 2);
+            const Coord receiverPos(150, 30, 1.5);
+
+            Signal expected(spec);
+            expected = 1;
+            expected.setSenderPoa({createDummyAntennaPosition(senderPos), {}, nullptr});
+            expected.setReceiverPoa({createDummyAntennaPosition(receiverPos), {}, nullptr});
+            Signal s(expected);
+
+            for (auto& model : models) {
+                model->filterSignal(&expected);
+            }
+            compiled.filterSignal(&s, LinkGeometry(senderPos, receiverPos));
+
+            THEN("it is attenuated just like by applying the models one by one")
+            {
+                for (size_t i = 0; i < freqs.size(); ++i) {
+                    REQUIRE(s.at(i) == Approx(expected.at(i)).epsilon(1e-12));
+                }
+            }
+        }
+
+        WHEN("the receiver is within one meter")
+        {
+            const Coord senderPos(0, 0, 2);
+            const Coord receiverPos(0.5, 0, 2);
+
+            Signal expected(spec);
+            expected = 1;
+            expected.setSenderPoa({createDummyAntennaPosition(senderPos), {}, nullptr});
+            expected.setReceiverPoa({createDummyAntennaPosition(receiverPos), {}, nullptr});
+            Signal s(expected);
+
+            for (auto& model : models) {
+                model->filterSignal(&expected);
+            }
+            compiled.filterSignal(&s, LinkGeometry(senderPos, receiverPos));
+
+            THEN("path loss is skipped just like by applying the models one by one")
+            {
+                for (size_t i = 0; i < freqs.size(); ++i) {
+                    REQUIRE(s.at(i) == Approx(expected.at(i)).epsilon(1e-12));
+                }
+            }
+        }
+
+        WHEN("the filter window of a signal is restricted to its data frequency range")
+        {
+            const Coord senderPos(0, 0, 2);
+            const Coord receiverPos(150, 30, 1.5);
+
+            Signal expected(spec);
+            expected = 1;
+            expected.setSenderPoa({createDummyAntennaPosition(senderPos), {}, nullptr});
+            expected.setReceiverPoa({createDummyAntennaPosition(receiverPos), {}, nullptr});
+            Signal s(expected);
+            s.setDataStart(1);
+            s.setDataEnd(1);
+            s.restrictFilterWindow(0);
+            Signal restricted(s);
+
+            for (auto& model : models) {
+                model->filterSignal(&expected);
+                model->filterSignal(&restricted);
+            }
+            compiled.filterSignal(&s, LinkGeometry(senderPos, receiverPos));
+
+            THEN("only the frequencies in the window are attenuated, there is no power at the others")
+            {
+                REQUIRE(s.getFilterStart() == 1);
+                REQUIRE(s.getFilterEnd() == 2);
+                REQUIRE(s.at(1) == Approx(expected.at(1)).epsilon(1e-12));
+                REQUIRE(restricted.at(1) == Approx(expected.at(1)).epsilon(1e-12));
+                REQUIRE(s.at(0) == 0);
+                REQUIRE(s.at(2) == 0);
+                REQUIRE(restricted.at(0) == 0);
+                REQUIRE(restricted.at(2) == 0);
+            }
+        }
+
+        WHEN("a signal sent from (0, 0) is filtered for several receivers in one batch")
+        {
+            const Coord senderPos(0, 0, 2);
+            const std::vector<Coord> receiverPositions = {{150, 30, 1.5}, {0.5, 0, 2}, {-400, 20, 1.5}};
+
+            std::vector<Signal> expected;
+            std::vector<Signal> batch;
+            std::vector<LinkGeometry> links;
+            for (const Coord& receiverPos : receiverPositions) {
+                Signal s(spec);
+                s = 1;
+                s.setSenderPoa({createDummyAntennaPosition(senderPos), {}, nullptr});
+                s.setReceiverPoa({createDummyAntennaPosition(receiverPos), {}, nullptr});
+                expected.push_back(s);
+                batch.push_back(s);
+                links.emplace_back(senderPos, receiverPos);
+            }
+            std::vector<Signal*> signals;
+            std::vector<const LinkGeometry*> linkPointers;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                compiled.filterSignal(&expected[i], links[i]);
+                signals.push_back(&batch[i]);
+                linkPointers.push_back(&links[i]);
+            }
+            compiled.filterSignals(signals.data(), linkPointers.data(), signals.size());
+
+            THEN("every signal is attenuated exactly like when filtering it on its own")
+            {
+                for (size_t j = 0; j < batch.size(); ++j) {
+                    for (size_t i = 0; i < freqs.size(); ++i) {
+                        REQUIRE(batch[j].at(i) == expected[j].at(i));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <vector>
+
+#include "testutils/ConnectionManager.h"
+#include "testutils/Simulation.h"
+
+using namespace veins;
+
+SCENARIO("Connections padded by the update slack cover pairs that close in without being re-checked", "[connectionManager]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    for (bool useFlatGrid : {true, false}) {
+        GIVEN("a maximum interference distance of 100m, a slack of 10m, and two nics about to be out of range (flat grid: " << useFlatGrid << ")")
+        {
+            GridConnectionManager connectionManager(Coord(2000, 2000, 0), 100, useFlatGrid, 10);
+            DummyNic nic;
+            DummyNic other;
+            connectionManager.registerNic(&other, nullptr, Coord(1110.2, 1000, 0), Heading(0));
+            connectionManager.registerNic(&nic, nullptr, Coord(989.9, 1000, 0), Heading(0));
+
+            WHEN("the other drifts away unchecked, the nic is checked, and both then close in by less than the slack each")
+            {
+                connectionManager.updateNicPos(other.getId(), Coord(1120.1, 1000, 0), Heading(0));
+                connectionManager.updateNicPos(nic.getId(), Coord(1000, 1000, 0), Heading(0));
+                connectionManager.updateNicPos(other.getId(), Coord(1100.3, 1000, 0), Heading(0));
+                connectionManager.updateNicPos(nic.getId(), Coord(1009.9, 1000, 0), Heading(0));
+
+                THEN("the nics, now 90.4m apart, are connected")
+                {
+                    REQUIRE(connectionManager.getNeighbourIds(&nic) == std::vector<int>{other.getId()});
+                    REQUIRE(connectionManager.getNeighbourIds(&other) == std::vector<int>{nic.getId()});
+                }
+
+                AND_WHEN("the nic is unregistered")
+                {
+                    connectionManager.unregisterNic(&nic);
+
+                    THEN("the other is left without connections")
+                    {
+                        REQUIRE(connectionManager.getNeighbourIds(&other).empty());
+                    }
+                }
+            }
+        }
+    }
+}
@@ -22,6 +22,8 @@
 
 #include "catch2/catch.hpp"
 
+#include <vector>
+
 #include "veins/base/utils/Coord.h"
 
 using veins::Coord;
@@ -73,4 +75,44 @@ SCENARIO("Coord", "[coord]")
             }
         }
     }
+
+    GIVEN("A Coord and a list of five other Coords")
+    {
+        auto from = Coord(1, 2, 3);
+        std::vector<Coord> to = {Coord(1, 2, 3), Coord(4, 6, 3), Coord(-1, 0, 0), Coord(100, -50, 7), Coord(0.5, 2.5, 3)};
+
+        WHEN("calculating all squared distances at once")
+        {
+            std::vector<double> out(to.size());
+            veins::distancesSquared(from, to.data(), to.size(), out.data());
+
+            THEN("each matches sqrdist")
+            {
+                for (size_t i = 0; i < to.size(); ++i) {
+                    REQUIRE(out[i] == from.sqrdist(to[i]));
+                }
+            }
+        }
+
+        WHEN("calculating all squared distances at once from separate arrays")
+        {
+            std::vector<double> xs, ys, zs;
+            for (const auto& c : to) {
+                xs.push_back(c.x);
+                ys.push_back(c.y);
+                zs.push_back(c.z);
+            }
+            std::vector<double> out(to.size());
+            veins::distancesSquared(from, xs.data(), ys.data(), zs.data(), to.size(), out.data());
+
+            THEN("each matches sqrdist exactly")
+            {
+                REQUIRE(out[0] == 0);
+                REQUIRE(out[1] == 25);
+                for (size_t i = 0; i < to.size(); ++i) {
+                    REQUIRE(out[i] == from.sqrdist(to[i]));
+                }
+            }
+        }
+    }
 }
@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <cmath>
+#include <memory>
+
+#include "veins/modules/analogueModel/CorrelatedShadowing.h"
+#include "veins/base/toolbox/Spectrum.h"
+#include "veins/base/toolbox/Signal.h"
+#include "testutils/Simulation.h"
+#include "testutils/Component.h"
+
+using namespace veins;
+
+namespace {
+
+int dummyId = -1;
+
+AntennaPosition createDummyAntennaPosition(Coord c)
+{
+    return AntennaPosition(dummyId, c, Coord(0, 0, 0), simTime());
+}
+
+} // namespace
+
+SCENARIO("ShadowingField", "[analogueModel]")
+{
+    GIVEN("A field over 2000 x 2000 m with a resolution of 5 m and a decorrelation distance of 20 m")
+    {
+        const Coord size(2000, 2000);
+        ShadowingField field(size, 5, 20, 42);
+
+        THEN("its samples have zero mean and unit variance")
+        {
+            double sum = 0;
+            double sqrSum = 0;
+            size_t n = 0;
+            for (double x = 0; x <= 2000; x += 5) {
+                for (double y = 0; y <= 2000; y += 5) {
+                    const double v = field.at(Coord(x, y));
+                    sum += v;
+                    sqrSum += v * v;
+                    ++n;
+                }
+            }
+            REQUIRE(n == field.getNumSamples());
+            const double mean = sum / n;
+            REQUIRE(mean == Approx(0).margin(0.1));
+            REQUIRE(sqrSum / n - mean * mean == Approx(1).epsilon(0.1));
+        }
+
+        THEN("samples one decorrelation distance apart are correlated by about 1/e")
+        {
+            double product = 0;
+            size_t n = 0;
+            for (double x = 0; x + 20 <= 2000; x += 5) {
+                for (double y = 0; y <= 2000; y += 5) {
+                    product += field.at(Coord(x, y)) * field.at(Coord(x + 20, y));
+                    ++n;
+                }
+            }
+            REQUIRE(product / n == Approx(std::exp(-1)).margin(0.05));
+        }
+
+        THEN("it only depends on its parameters and seed")
+        {
+            ShadowingField same(size, 5, 20, 42);
+            ShadowingField other(size, 5, 20, 43);
+            REQUIRE(same.at(Coord(123.4, 567.8)) == field.at(Coord(123.4, 567.8)));
+            REQUIRE(other.at(Coord(123.4, 567.8)) != field.at(Coord(123.4, 567.8)));
+        }
+
+        THEN("values between samples are interpolated, positions outside are clamped")
+        {
+            const double a = field.at(Coord(100, 100));
+            const double b = field.at(Coord(105, 100));
+            REQUIRE(field.at(Coord(102.5, 100)) == Approx((a + b) / 2));
+            REQUIRE(field.at(Coord(-50, 2500)) == field.at(Coord(0, 2000)));
+        }
+    }
+}
+
+SCENARIO("CorrelatedShadowing", "[analogueModel]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    DummyComponent dc(&ds);
+    Spectrum spec({5.89e9, 5.9e9});
+    auto field = std::make_shared<const ShadowingField>(Coord(1000, 1000), 5, 20, 7);
+    CorrelatedShadowing shadowing(&dc, field, 6);
+
+    GIVEN("A signal sent from (100, 200) to (400, 250)")
+    {
+        const Coord senderPos(100, 200, 2);
+        const Coord receiverPos(400, 250, 2);
+        Signal s(spec);
+        s = 1;
+        s.setSenderPoa({createDummyAntennaPosition(senderPos), {}, nullptr});
+        s.setReceiverPoa({createDummyAntennaPosition(receiverPos), {}, nullptr});
+        shadowing.filterSignal(&s);
+
+        THEN("all frequencies are attenuated by the factor of the link, which is the same in both directions")
+        {
+            const double factor = shadowing.getFactor(senderPos, receiverPos);
+            REQUIRE(s.at(0) == Approx(factor));
+            REQUIRE(s.at(1) == Approx(factor));
+            REQUIRE(shadowing.getFactor(receiverPos, senderPos) == Approx(factor));
+        }
+
+        THEN("the kernel yields the same factor")
+        {
+            const AnalogueModelKernel kernel = shadowing.getKernel();
+            REQUIRE(kernel.factor != nullptr);
+            REQUIRE(kernel.factor(shadowing, LinkGeometry(senderPos, receiverPos), 1) == Approx(s.at(0)));
+        }
+    }
+}
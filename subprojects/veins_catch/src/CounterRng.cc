@@ -0,0 +1,96 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/base/utils/CounterRng.h"
+
+using veins::CounterRng;
+
+SCENARIO("CounterRng", "[counterRng]")
+{
+    GIVEN("The Philox4x32-10 block function")
+    {
+        THEN("it matches the known answers of the reference implementation")
+        {
+            REQUIRE(CounterRng::philox({0, 0, 0, 0}, 0, 0) == CounterRng::Block({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+            REQUIRE(CounterRng::philox({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, 0xffffffff, 0xffffffff) == CounterRng::Block({0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+            REQUIRE(CounterRng::philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, 0xa4093822, 0x299f31d0) == CounterRng::Block({0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+        }
+    }
+
+    GIVEN("Streams for two receivers of the same transmission")
+    {
+        const uint64_t seed = 42;
+
+        THEN("a stream does not depend on draws from other streams")
+        {
+            CounterRng a(seed, CounterRng::Purpose::fading, 7, 1);
+            CounterRng b(seed, CounterRng::Purpose::fading, 7, 2);
+            const double first = a.gamma_d(1.5, 2);
+            for (int i = 0; i < 100; i++) b.dblrand();
+
+            CounterRng again(seed, CounterRng::Purpose::fading, 7, 1);
+            REQUIRE(again.gamma_d(1.5, 2) == first);
+
+            CounterRng other(seed, CounterRng::Purpose::fading, 7, 2);
+            REQUIRE(other.gamma_d(1.5, 2) != first);
+        }
+
+        THEN("streams of different purposes differ")
+        {
+            CounterRng fading(seed, CounterRng::Purpose::fading, 7, 1);
+            CounterRng backoff(seed, CounterRng::Purpose::backoff, 7, 1);
+            REQUIRE(fading.nextUint32() != backoff.nextUint32());
+        }
+    }
+
+    GIVEN("A stream")
+    {
+        CounterRng rng(1, CounterRng::Purpose::backoff, 3);
+
+        THEN("intuniform stays within its bounds and reaches both")
+        {
+            bool sawMin = false;
+            bool sawMax = false;
+            for (int i = 0; i < 1000; i++) {
+                int value = rng.intuniform(0, 15);
+                REQUIRE(value >= 0);
+                REQUIRE(value <= 15);
+                sawMin |= value == 0;
+                sawMax |= value == 15;
+            }
+            REQUIRE(sawMin);
+            REQUIRE(sawMax);
+        }
+
+        THEN("gamma_d has mean alpha * theta")
+        {
+            for (double alpha : {0.75, 1.5}) {
+                double sum = 0;
+                const int n = 20000;
+                for (int i = 0; i < n; i++) sum += rng.gamma_d(alpha, 2);
+                REQUIRE(sum / n == Approx(alpha * 2).epsilon(0.05));
+            }
+        }
+    }
+}
@@ -0,0 +1,149 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "testutils/DeciderPhy.h"
+#include "testutils/Simulation.h"
+
+#include "veins/modules/phy/Decider80211pAbstract.h"
+
+using namespace veins;
+
+namespace {
+
+const double noise = 1e-10;
+const double threshold = 1e-9;
+
+/**
+ * Decider80211pAbstract measuring channel load over 10 ms, exposing the interference it assumes
+ */
+class AbstractDecider : public Decider80211pAbstract {
+public:
+    AbstractDecider(DeciderPhy* phy)
+        : Decider80211pAbstract(nullptr, phy, 1e-11, threshold, false, 5.89e9, SimTime(10, SIMTIME_MS))
+    {
+    }
+
+    /** @brief Passes a frame starting now, as the phy does */
+    void receive(AirFrame* frame)
+    {
+        processNewSignal(frame);
+    }
+
+    double getInterferenceAt(simtime_t_cref time)
+    {
+        return getInterferencePower(time);
+    }
+};
+
+} // namespace
+
+SCENARIO("Decider80211pAbstract tells the channel busy while frames above the CCA threshold are received", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    // frames must outlive the decider, which keeps pointers to them
+    std::vector<std::unique_ptr<AirFrame11p>> frames;
+    DeciderPhy phy;
+    phy.noise = noise;
+    AbstractDecider decider(&phy);
+
+    GIVEN("no frames")
+    {
+        THEN("the channel is idle")
+        {
+            REQUIRE(decider.cca(0, nullptr));
+        }
+    }
+
+    GIVEN("a frame below the CCA threshold")
+    {
+        frames.push_back(createAirFrame11p(0, SimTime(1, SIMTIME_MS), 5e-10));
+        decider.receive(frames.back().get());
+
+        THEN("the channel stays idle")
+        {
+            REQUIRE(decider.cca(0, nullptr));
+        }
+    }
+
+    GIVEN("two overlapping frames above the CCA threshold")
+    {
+        frames.push_back(createAirFrame11p(0, SimTime(3, SIMTIME_MS), 2e-9));
+        decider.receive(frames.back().get());
+        frames.push_back(createAirFrame11p(0, SimTime(1, SIMTIME_MS), 4e-9));
+        decider.receive(frames.back().get());
+
+        THEN("the channel is busy until the longer one ends")
+        {
+            REQUIRE_FALSE(decider.cca(0, nullptr));
+            REQUIRE_FALSE(decider.cca(SimTime(2, SIMTIME_MS), nullptr));
+            REQUIRE(decider.cca(SimTime(3, SIMTIME_MS), nullptr));
+        }
+    }
+
+    GIVEN("a noise floor above the CCA threshold")
+    {
+        phy.noise = 2 * threshold;
+
+        THEN("the channel is busy without any frames")
+        {
+            REQUIRE_FALSE(decider.cca(0, nullptr));
+        }
+    }
+}
+
+SCENARIO("Decider80211pAbstract assumes interference from the channel load of the last interval", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    std::vector<std::unique_ptr<AirFrame11p>> frames;
+    DeciderPhy phy;
+    phy.noise = noise;
+    AbstractDecider decider(&phy);
+
+    GIVEN("frames above and below the CCA threshold in the first interval")
+    {
+        frames.push_back(createAirFrame11p(0, SimTime(1, SIMTIME_MS), 2e-9));
+        frames.push_back(createAirFrame11p(0, SimTime(3, SIMTIME_MS), 4e-9));
+        frames.push_back(createAirFrame11p(0, SimTime(5, SIMTIME_MS), 5e-10));
+        for (auto& frame : frames) decider.receive(frame.get());
+
+        THEN("there is none before the interval completed")
+        {
+            REQUIRE(decider.getInterferenceAt(SimTime(5, SIMTIME_MS)) == 0);
+        }
+        THEN("it is the busy ratio times the mean power of the frames above the threshold in the next interval")
+        {
+            // busy for 3 of 10 ms, with frames of 2e-9 for 1 ms and 4e-9 for 3 ms
+            REQUIRE(decider.getInterferenceAt(SimTime(15, SIMTIME_MS)) == Approx(0.3 * (2e-9 * 1 + 4e-9 * 3) / 4));
+        }
+        THEN("there is none once an interval without load completed")
+        {
+            REQUIRE(decider.getInterferenceAt(SimTime(25, SIMTIME_MS)) == 0);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <memory>
+
+#include "testutils/DeciderPhy.h"
+#include "testutils/Simulation.h"
+
+#include "veins/modules/phy/Decider80211p.h"
+
+using namespace veins;
+
+namespace {
+
+/**
+ * Decider80211p receiving frames the way the phy passes them, decoding only frames above the CCA threshold
+ */
+class CcaDecider : public Decider80211p {
+public:
+    CcaDecider(DeciderPhy* phy, double ccaThreshold, bool incremental)
+        : Decider80211p(nullptr, phy, ccaThreshold, ccaThreshold, false, 5.89e9)
+    {
+        setIncrementalSinr(incremental);
+    }
+
+    /** @brief Passes a frame starting now, as the phy does */
+    void receive(AirFrame* frame)
+    {
+        processNewSignal(frame);
+    }
+};
+
+} // namespace
+
+SCENARIO("Decider80211p leaves far field interference out of CCA", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    const double threshold = 1e-9;
+
+    for (bool incremental : {false, true}) {
+        GIVEN("far field interference above the CCA threshold (incremental SINR: " << incremental << ")")
+        {
+            DeciderPhy phy;
+            phy.noise = 1e-11;
+            phy.farField = 10 * threshold;
+            CcaDecider decider(&phy, threshold, incremental);
+
+            THEN("the channel is idle without frames")
+            {
+                REQUIRE(decider.cca(0, nullptr));
+            }
+
+            WHEN("a frame below the CCA threshold arrives")
+            {
+                std::unique_ptr<AirFrame11p> frame = createAirFrame11p(0, SimTime(1, SIMTIME_MS), threshold / 2);
+                phy.frames.push_back(frame.get());
+                decider.receive(frame.get());
+                THEN("the channel stays idle")
+                {
+                    REQUIRE(decider.cca(0, nullptr));
+                    REQUIRE(phy.numChannelBusy == 0);
+                }
+            }
+
+            WHEN("a frame above the CCA threshold arrives")
+            {
+                std::unique_ptr<AirFrame11p> frame = createAirFrame11p(0, SimTime(1, SIMTIME_MS), 2 * threshold);
+                phy.frames.push_back(frame.get());
+                decider.receive(frame.get());
+                THEN("the channel is busy until it ends")
+                {
+                    REQUIRE_FALSE(decider.cca(0, nullptr));
+                    REQUIRE(decider.cca(0, frame.get()));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/DeciderPhy.h"
+#include "testutils/Simulation.h"
+
+#include "veins/modules/phy/Decider80211p.h"
+#include "veins/modules/utility/Consts80211p.h"
+
+using namespace veins;
+
+namespace {
+
+/**
+ * Decider80211p exposing its SINR bounds and the decision by them
+ */
+class BoundedDecider : public Decider80211p {
+public:
+    BoundedDecider(DeciderPhy* phy)
+        : Decider80211p(nullptr, phy, 1e-15, 1e-15, false, 5.89e9)
+    {
+    }
+
+    double getAcceptSinr(int lengthMPDU, double bitrate)
+    {
+        return getDecisionBounds(lengthMPDU, bitrate).acceptSinr;
+    }
+
+    double getRejectSinr(int lengthMPDU, double bitrate)
+    {
+        return getDecisionBounds(lengthMPDU, bitrate).rejectSinr;
+    }
+
+    bool isCached(int lengthMPDU, double bitrate)
+    {
+        return &getDecisionBounds(lengthMPDU, bitrate) == &getDecisionBounds(lengthMPDU, bitrate);
+    }
+
+    PACKET_OK_RESULT decide(double sinr, double snr, int lengthMPDU, double bitrate)
+    {
+        return packetOk(sinr, snr, lengthMPDU, bitrate);
+    }
+
+    /** @brief Probability of decoding header and payload at the given SINR, as packetOk() draws it */
+    double getSuccessRate(double sinr, int lengthMPDU, double bitrate) const
+    {
+        return getChunkSuccessRate(bitrate, sinr, PHY_HDR_SERVICE_LENGTH + lengthMPDU + PHY_TAIL_LENGTH) * getChunkSuccessRate(PHY_HDR_BITRATE, sinr, PHY_HDR_PLCPSIGNAL_LENGTH);
+    }
+};
+
+} // namespace
+
+SCENARIO("Decider80211p decides receptions outside its SINR bounds without error rates", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    DeciderPhy phy;
+    BoundedDecider decider(&phy);
+    const double epsilon = 1e-3;
+    const int lengthMPDU = 8 * 400;
+
+    GIVEN("a decider with a decision epsilon")
+    {
+        decider.setDecisionEpsilon(epsilon);
+
+        for (double bitrate : {6e6, 12e6, 27e6}) {
+            const double accept = decider.getAcceptSinr(lengthMPDU, bitrate);
+            const double reject = decider.getRejectSinr(lengthMPDU, bitrate);
+
+            THEN("the bounds at " << bitrate << " bit/s are as tight as epsilon allows")
+            {
+                REQUIRE(reject < accept);
+                REQUIRE(1 - decider.getSuccessRate(accept, lengthMPDU, bitrate) <= epsilon);
+                REQUIRE(1 - decider.getSuccessRate(accept / 1.01, lengthMPDU, bitrate) > epsilon);
+                REQUIRE(decider.getSuccessRate(reject, lengthMPDU, bitrate) <= epsilon);
+                REQUIRE(decider.getSuccessRate(reject * 1.01, lengthMPDU, bitrate) > epsilon);
+                REQUIRE(decider.isCached(lengthMPDU, bitrate));
+            }
+
+            THEN("frames at " << bitrate << " bit/s outside the bounds are decided by them")
+            {
+                REQUIRE(decider.decide(accept, accept, lengthMPDU, bitrate) == Decider80211p::DECODED);
+                REQUIRE(decider.decide(accept * 100, accept * 100, lengthMPDU, bitrate) == Decider80211p::DECODED);
+                REQUIRE(decider.decide(reject, reject, lengthMPDU, bitrate) == Decider80211p::NOT_DECODED);
+                REQUIRE(decider.decide(reject / 100, reject / 100, lengthMPDU, bitrate) == Decider80211p::NOT_DECODED);
+            }
+        }
+
+        THEN("longer frames need a higher SINR to be accepted")
+        {
+            REQUIRE(decider.getAcceptSinr(2 * lengthMPDU, 6e6) > decider.getAcceptSinr(lengthMPDU, 6e6));
+        }
+
+        AND_WHEN("the epsilon is lowered")
+        {
+            const double accept = decider.getAcceptSinr(lengthMPDU, 6e6);
+            const double reject = decider.getRejectSinr(lengthMPDU, 6e6);
+            decider.setDecisionEpsilon(epsilon / 10);
+            THEN("the bounds are recomputed further apart")
+            {
+                REQUIRE(decider.getAcceptSinr(lengthMPDU, 6e6) > accept);
+                REQUIRE(decider.getRejectSinr(lengthMPDU, 6e6) < reject);
+            }
+        }
+    }
+
+    WHEN("an epsilon of at least 0.5 is set")
+    {
+        THEN("it is refused")
+        {
+            REQUIRE_THROWS_AS(decider.setDecisionEpsilon(0.5), cRuntimeError);
+        }
+    }
+}
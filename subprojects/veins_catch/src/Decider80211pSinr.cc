@@ -0,0 +1,178 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "testutils/DeciderPhy.h"
+#include "testutils/Differential.h"
+#include "testutils/Simulation.h"
+
+#include "veins/base/toolbox/SignalUtils.h"
+#include "veins/modules/phy/Decider80211p.h"
+
+using namespace veins;
+
+namespace {
+
+/**
+ * Decider80211p tracking the SINR of the frame it syncs to, exposing what it tracked
+ */
+class TrackingDecider : public Decider80211p {
+public:
+    TrackingDecider(DeciderPhy* phy)
+        : Decider80211p(nullptr, phy, 1e-15, 1e-15, false, 5.89e9)
+    {
+        setIncrementalSinr(true);
+    }
+
+    /** @brief Passes a frame starting now, as the phy does */
+    void receive(AirFrame* frame)
+    {
+        processNewSignal(frame);
+    }
+
+    AirFrame* getSyncedFrame() const
+    {
+        return currentSignal.first;
+    }
+
+    double getTrackedMinSinr() const
+    {
+        return trackedMinSinr;
+    }
+
+    simtime_t getTrackedStart() const
+    {
+        return trackedStart;
+    }
+};
+
+/** @brief Minimum SINR over the data part of frame (without its preamble), as the full evaluation at its end computes it */
+double referenceMinSinr(AirFrame* frame, DeciderPhy& phy)
+{
+    const Signal& signal = frame->getSignal();
+    const simtime_t start = signal.getReceptionStart() + PHY_HDR_PREAMBLE_DURATION;
+    return SignalUtils::evaluateReception(start, signal.getReceptionEnd(), frame, phy.frames, phy.getNoiseFloorValue()).minSinr;
+}
+
+/** @brief Passes all frames to the decider in the order of their reception start (frames not to sync to must have their start missed) */
+void receiveAll(TrackingDecider& decider, DeciderPhy& phy, std::vector<std::unique_ptr<AirFrame11p>>& frames)
+{
+    std::stable_sort(frames.begin(), frames.end(), [](const std::unique_ptr<AirFrame11p>& a, const std::unique_ptr<AirFrame11p>& b) { return a->getSignal().getReceptionStart() < b->getSignal().getReceptionStart(); });
+    for (auto& frame : frames) {
+        phy.frames.push_back(frame.get());
+        decider.receive(frame.get());
+    }
+}
+
+} // namespace
+
+SCENARIO("Decider80211p tracks the same minimum SINR as the full evaluation", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    const double noise = 1e-10;
+    const simtime_t start = SimTime(1, SIMTIME_MS);
+    const simtime_t duration = SimTime(500, SIMTIME_US);
+
+    GIVEN("a frame interfered by two frames one after the other")
+    {
+        // frames must outlive the decider, which keeps pointers to them
+        std::vector<std::unique_ptr<AirFrame11p>> frames;
+        DeciderPhy phy;
+        phy.noise = noise;
+        TrackingDecider decider(&phy);
+
+        frames.push_back(createAirFrame11p(start, duration, 1e-6));
+        AirFrame* target = frames.back().get();
+        frames.push_back(createAirFrame11p(start + SimTime(100, SIMTIME_US), SimTime(100, SIMTIME_US), 1e-8));
+        frames.push_back(createAirFrame11p(start + SimTime(200, SIMTIME_US), SimTime(100, SIMTIME_US), 4e-8));
+        receiveAll(decider, phy, frames);
+
+        THEN("the SINR is limited by the stronger interferer alone")
+        {
+            REQUIRE(decider.getSyncedFrame() == target);
+            REQUIRE(decider.getTrackedMinSinr() == Approx(1e-6 / (4e-8 + noise)));
+            REQUIRE(decider.getTrackedMinSinr() == Approx(referenceMinSinr(target, phy)));
+        }
+    }
+
+    GIVEN("a frame interfered by a frame ending within its preamble")
+    {
+        std::vector<std::unique_ptr<AirFrame11p>> frames;
+        DeciderPhy phy;
+        phy.noise = noise;
+        TrackingDecider decider(&phy);
+
+        frames.push_back(createAirFrame11p(start, duration, 1e-6));
+        AirFrame* target = frames.back().get();
+        frames.push_back(createAirFrame11p(start - SimTime(100, SIMTIME_US), SimTime(120, SIMTIME_US), 1e-6));
+        frames.back()->setMissedStart(true);
+        frames.push_back(createAirFrame11p(start + SimTime(10, SIMTIME_US), SimTime(20, SIMTIME_US), 1e-6));
+        receiveAll(decider, phy, frames);
+
+        THEN("the SINR is the SNR")
+        {
+            REQUIRE(decider.getSyncedFrame() == target);
+            REQUIRE(decider.getTrackedStart() == start + PHY_HDR_PREAMBLE_DURATION);
+            REQUIRE(decider.getTrackedMinSinr() == Approx(1e-6 / noise));
+            REQUIRE(decider.getTrackedMinSinr() == Approx(referenceMinSinr(target, phy)));
+        }
+    }
+
+    GIVEN("frames interfered by random overlapping frames, some of them already on the channel")
+    {
+        DifferentialInputs inputs(103);
+        Deviation deviation(0, 1e-9);
+
+        for (int round = 0; round < 200; round++) {
+            std::vector<std::unique_ptr<AirFrame11p>> frames;
+            DeciderPhy phy;
+            phy.noise = noise;
+            TrackingDecider decider(&phy);
+
+            frames.push_back(createAirFrame11p(start, duration, inputs.logUniform(1e-9, 1e-6)));
+            AirFrame* target = frames.back().get();
+            const long numInterferers = inputs.integer(0, 12);
+            for (long i = 0; i < numInterferers; i++) {
+                // whole microseconds, so that interferers also start exactly when others end
+                const simtime_t interfererStart = start + SimTime(inputs.integer(-400, 550), SIMTIME_US);
+                frames.push_back(createAirFrame11p(interfererStart, SimTime(inputs.integer(10, 400), SIMTIME_US), inputs.logUniform(1e-11, 1e-6)));
+                if (interfererStart <= start) frames.back()->setMissedStart(true);
+            }
+            receiveAll(decider, phy, frames);
+
+            REQUIRE(decider.getSyncedFrame() == target);
+            deviation.add(referenceMinSinr(target, phy), decider.getTrackedMinSinr());
+        }
+
+        THEN("the tracked minimum SINR matches SignalUtils::evaluateReception")
+        {
+            INFO(deviation);
+            REQUIRE(deviation.isWithinTolerance());
+        }
+    }
+}
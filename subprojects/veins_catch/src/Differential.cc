@@ -0,0 +1,353 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "veins/base/phyLayer/ChannelInfo.h"
+#include "veins/base/phyLayer/CompiledChannelModel.h"
+#include "veins/base/toolbox/Signal.h"
+#include "veins/base/toolbox/Spectrum.h"
+#include "veins/modules/analogueModel/SimplePathlossModel.h"
+#include "veins/modules/analogueModel/TwoRayInterferenceModel.h"
+#include "veins/modules/phy/Decider80211p.h"
+#include "veins/modules/phy/NistErrorRate.h"
+#include "veins/modules/phy/TabulatedErrorRate.h"
+#include "testutils/ConnectionManager.h"
+#include "testutils/DeciderPhy.h"
+#include "testutils/Differential.h"
+#include "testutils/Simulation.h"
+#include "testutils/Component.h"
+
+using namespace veins;
+
+SCENARIO("Deviation", "[differential]")
+{
+    GIVEN("A deviation with an absolute tolerance of 1e-3 and a relative tolerance of 1e-2")
+    {
+        Deviation d(1e-3, 1e-2);
+
+        WHEN("values deviate by less than either tolerance")
+        {
+            d.add(1, 1.005);
+            d.add(0, 5e-4);
+            d.add(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+            d.add(std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+
+            THEN("they are within tolerance, and the maximum deviations are reported")
+            {
+                REQUIRE(d.isWithinTolerance());
+                REQUIRE(d.getCount() == 4);
+                REQUIRE(d.getMaxAbsolute() == Approx(5e-3));
+                REQUIRE(d.getMaxRelative() == std::numeric_limits<double>::infinity());
+            }
+        }
+
+        WHEN("values deviate by more than both tolerances, or only one of them is NaN")
+        {
+            d.add(1, 1);
+            d.add(10, 10.5);
+            d.add(1, std::numeric_limits<double>::quiet_NaN());
+
+            THEN("they are outside tolerance, and the worst input is reported")
+            {
+                REQUIRE_FALSE(d.isWithinTolerance());
+                REQUIRE(d.getNumOutside() == 2);
+                REQUIRE(d.getWorstIndex() == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("Recorded inputs", "[differential]")
+{
+    GIVEN("A file of recorded inputs with comments and both kinds of separators")
+    {
+        const char* path = "differential_inputs.tmp";
+        {
+            std::ofstream file(path);
+            file << "# snr, nbits\n1.5, 24\n\n2e3 1000\n";
+        }
+        const auto inputs = readRecordedInputs(path);
+        std::remove(path);
+
+        THEN("every line yields one input")
+        {
+            REQUIRE(inputs.size() == 2);
+            REQUIRE(inputs[0] == std::vector<double>({1.5, 24}));
+            REQUIRE(inputs[1] == std::vector<double>({2e3, 1000}));
+        }
+    }
+}
+
+SCENARIO("TabulatedErrorRate vs NistErrorRate on random inputs", "[differential]")
+{
+    struct Input {
+        unsigned int datarate;
+        double snr;
+        uint32_t nbits;
+    };
+    const std::vector<unsigned int> datarates = {3000000, 4500000, 6000000, 9000000, 12000000, 18000000, 24000000, 27000000};
+    DifferentialInputs random(133);
+    const auto inputs = random.generate(20000, [&datarates](DifferentialInputs& r) {
+        return Input{datarates[r.integer(0, datarates.size() - 1)], r.logUniform(1e-2, 1e5), static_cast<uint32_t>(r.integer(24, 20000))};
+    });
+
+    const Deviation d = compareImplementations(
+        inputs,
+        [](const Input& in) { return NistErrorRate::getChunkSuccessRate(in.datarate, Bandwidth::ofdm_10_mhz, in.snr, in.nbits); },
+        [](const Input& in) { return TabulatedErrorRate::getChunkSuccessRate(in.datarate, Bandwidth::ofdm_10_mhz, in.snr, in.nbits); },
+        1e-4,
+        0);
+    INFO(d);
+    REQUIRE(d.isWithinTolerance());
+}
+
+SCENARIO("CompiledChannelModel vs the analogue model chain on random links", "[differential]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    DummyComponent dc(&ds);
+    Spectrum spec({5.885e9, 5.89e9, 5.895e9});
+
+    AnalogueModelList models;
+    models.emplace_back(new SimplePathlossModel(&dc, 2.2, false, {0, 0, 0}));
+    models.emplace_back(new TwoRayInterferenceModel(&dc, 1.02));
+    CompiledChannelModel compiled(models);
+
+    DifferentialInputs random(1331);
+    const auto links = random.generate(2000, [](DifferentialInputs& r) {
+        return LinkGeometry(Coord(r.uniform(0, 2000), r.uniform(0, 2000), r.uniform(1, 3)), Coord(r.uniform(0, 2000), r.uniform(0, 2000), r.uniform(1, 3)));
+    });
+
+    Deviation d(0, 1e-12);
+    for (const LinkGeometry& link : links) {
+        Signal reference(spec);
+        reference = 1;
+        reference.setSenderPoa({AntennaPosition(-1, link.senderPos, Coord(0, 0, 0), simTime()), {}, nullptr});
+        reference.setReceiverPoa({AntennaPosition(-1, link.receiverPos, Coord(0, 0, 0), simTime()), {}, nullptr});
+        Signal optimised(reference);
+        for (auto& model : models) {
+            model->filterSignal(&reference);
+        }
+        compiled.filterSignal(&optimised, link);
+        for (size_t i = 0; i < spec.getNumFreqs(); ++i) {
+            d.add(reference.at(i), optimised.at(i));
+        }
+    }
+    INFO(d);
+    REQUIRE(d.isWithinTolerance());
+}
+
+namespace {
+
+/**
+ * Decider80211p summing the received power incrementally, exposing its bookkeeping and the full CCA evaluation
+ */
+class IncrementalCcaDecider : public Decider80211p {
+public:
+    IncrementalCcaDecider(DeciderPhy* phy, double ccaThreshold)
+        : Decider80211p(nullptr, phy, 1e-15, ccaThreshold, false, 5.89e9)
+    {
+        setIncrementalSinr(true);
+    }
+
+    /** @brief Adds a frame to the received power, as processNewSignal() does */
+    void add(AirFrame* frame)
+    {
+        frame->getSignal().applyAllAnalogueModels();
+        addReceivedPower(frame);
+    }
+
+    /** @brief Removes a frame from the received power, as processSignalEnd() does */
+    void remove(AirFrame* frame)
+    {
+        removeReceivedPower(frame);
+    }
+
+    bool fullCca(AirFrame* exclude)
+    {
+        return evaluateCca(simTime(), exclude);
+    }
+};
+
+/** @brief Returns whether the band of frame overlaps the spectrum indices [low, high) */
+bool isInBand(AirFrame* frame, size_t low, size_t high)
+{
+    const Signal& signal = frame->getSignal();
+    return signal.getDataStart() < high && signal.getDataEnd() > low;
+}
+
+} // namespace
+
+SCENARIO("Incremental CCA of Decider80211p vs the full evaluation on random channels", "[differential]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    const double noise = 1e-10;
+    DifferentialInputs random(1332);
+    Deviation d(0, 0);
+
+    for (int round = 0; round < 500; round++) {
+        // frames must outlive the decider, which keeps pointers to them
+        std::vector<std::unique_ptr<AirFrame11p>> frames;
+        DeciderPhy phy;
+        phy.noise = noise;
+        IncrementalCcaDecider decider(&phy, noise + random.logUniform(1e-11, 1e-6));
+
+        // all frames are on the channel now (at time 0), some of them end (and are removed) before the check
+        const long numFrames = random.integer(0, 12);
+        for (long i = 0; i < numFrames; i++) {
+            const simtime_t start = -SimTime(random.integer(0, 400), SIMTIME_US);
+            frames.push_back(createAirFrame11p(start, -start + SimTime(random.integer(1, 400), SIMTIME_US), random.logUniform(1e-11, 1e-6)));
+            phy.frames.push_back(frames.back().get());
+            decider.add(frames.back().get());
+        }
+        for (auto& frame : frames) {
+            if (random.uniform(0, 1) >= 0.3) continue;
+            decider.remove(frame.get());
+            phy.frames.erase(std::find(phy.frames.begin(), phy.frames.end(), frame.get()));
+        }
+        AirFrame* exclude = (!phy.frames.empty() && random.uniform(0, 1) < 0.5) ? *std::next(phy.frames.begin(), random.integer(0, phy.frames.size() - 1)) : nullptr;
+
+        // the full evaluation refreshes the sums, so it goes last
+        const bool optimised = decider.cca(simTime(), exclude);
+        d.add(decider.fullCca(exclude), optimised);
+    }
+    INFO(d);
+    REQUIRE(d.isWithinTolerance());
+}
+
+SCENARIO("ChannelInfo partitioned by band vs its unpartitioned lists on random frames", "[differential]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    const Spectrum spectrum({1, 2, 3, 4, 5, 6, 7, 8, 9});
+    ChannelInfo channelInfo;
+    channelInfo.setPartitionedByBand(true);
+
+    DifferentialInputs random(1333);
+    size_t numQueries = 0;
+    size_t numMismatches = 0;
+    std::multimap<simtime_t, AirFrame*> activeByEnd;
+    simtime_t now = 0;
+
+    for (int step = 0; step < 1000; step++) {
+        now += SimTime(random.integer(0, 100), SIMTIME_US);
+
+        // frames ending by now are removed in the order of their ends, as the phy does
+        while (!activeByEnd.empty() && activeByEnd.begin()->first <= now) {
+            channelInfo.removeAirFrame(activeByEnd.begin()->second);
+            activeByEnd.erase(activeByEnd.begin());
+        }
+        const size_t dataStart = random.integer(0, 7);
+        AirFrame* frame = new AirFrame();
+        frame->setDuration(SimTime(random.integer(1, 500), SIMTIME_US));
+        Signal signal(spectrum);
+        signal.setDataStart(dataStart);
+        signal.setDataEnd(random.integer(dataStart + 1, 8));
+        frame->setSignal(signal);
+        channelInfo.addAirFrame(frame, now);
+        activeByEnd.emplace(now + frame->getDuration(), frame);
+
+        for (int query = 0; query < 3; query++) {
+            const simtime_t from = now - SimTime(random.integer(0, 1000), SIMTIME_US);
+            const simtime_t to = from + SimTime(random.integer(0, 1000), SIMTIME_US);
+            const size_t low = random.integer(0, 8);
+            const size_t high = random.integer(low + 1, 9);
+
+            ChannelInfo::AirFrameVector all;
+            channelInfo.getAirFrames(from, to, all);
+            ChannelInfo::AirFrameVector reference;
+            std::copy_if(all.begin(), all.end(), std::back_inserter(reference), [low, high](AirFrame* frame) { return isInBand(frame, low, high); });
+            ChannelInfo::AirFrameVector optimised;
+            channelInfo.getAirFrames(from, to, low, high, optimised);
+
+            numQueries++;
+            if (optimised != reference) numMismatches++;
+        }
+    }
+
+    INFO(numMismatches << " of " << numQueries << " queries returned other AirFrames (or in another order) than the filtered unpartitioned query");
+    REQUIRE(numMismatches == 0);
+
+    // ChannelInfo does not delete the AirFrames it still holds on destruction
+    ChannelInfo::AirFrameVector remaining;
+    channelInfo.getAirFrames(0, now + 1, remaining);
+    for (auto frame : remaining) {
+        delete frame;
+    }
+}
+
+SCENARIO("Flat and nested grid of the connection manager vs checking all pairs on random moves", "[differential]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    const Coord playground(2000, 2000, 0);
+    const double maxDistance = 150;
+    GridConnectionManager flat(playground, maxDistance, true);
+    GridConnectionManager nested(playground, maxDistance, false);
+
+    DifferentialInputs random(1334);
+    std::vector<std::unique_ptr<DummyNic>> nics;
+    std::vector<Coord> positions;
+    for (int i = 0; i < 100; i++) {
+        nics.emplace_back(new DummyNic());
+        positions.emplace_back(random.uniform(0, playground.x), random.uniform(0, playground.y), 0);
+        flat.registerNic(nics.back().get(), nullptr, positions.back(), Heading(0));
+        nested.registerNic(nics.back().get(), nullptr, positions.back(), Heading(0));
+    }
+
+    size_t numChecks = 0;
+    size_t numMismatches = 0;
+    for (int round = 0; round < 20; round++) {
+        for (size_t i = 0; i < nics.size(); i++) {
+            // a random walk of up to 100 m, sometimes crossing cells
+            positions[i].x = std::min(playground.x, std::max(0.0, positions[i].x + random.uniform(-100, 100)));
+            positions[i].y = std::min(playground.y, std::max(0.0, positions[i].y + random.uniform(-100, 100)));
+            flat.updateNicPos(nics[i]->getId(), positions[i], Heading(0));
+            nested.updateNicPos(nics[i]->getId(), positions[i], Heading(0));
+        }
+
+        for (size_t i = 0; i < nics.size(); i++) {
+            std::vector<int> reference;
+            for (size_t j = 0; j < nics.size(); j++) {
+                if (j != i && positions[i].sqrdist(positions[j]) <= maxDistance * maxDistance) reference.push_back(nics[j]->getId());
+            }
+            std::sort(reference.begin(), reference.end());
+
+            numChecks++;
+            if (flat.getNeighbourIds(nics[i].get()) != reference || nested.getNeighbourIds(nics[i].get()) != reference) numMismatches++;
+        }
+    }
+
+    INFO(numMismatches << " of " << numChecks << " neighbour sets differed from checking all pairs");
+    REQUIRE(numMismatches == 0);
+}
@@ -0,0 +1,104 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <cmath>
+
+#include "veins/base/connectionManager/FarFieldInterference.h"
+#include "veins/base/modules/BaseWorldUtility.h"
+
+using namespace veins;
+
+namespace {
+
+const double frequency = 5.89e9;
+
+double freeSpace(double power, double distance)
+{
+    const double wavelength = BaseWorldUtility::speedOfLight() / frequency;
+    return power * wavelength * wavelength / (16.0 * M_PI * M_PI) / (distance * distance);
+}
+
+} // namespace
+
+SCENARIO("FarFieldInterference", "[farfield]")
+{
+    GIVEN("Aggregation in 100m cells and 1ms slices, with a near field of 300m")
+    {
+        FarFieldInterference farField(300, 100, SimTime(1, SIMTIME_MS), SimTime(10, SIMTIME_MS), 2);
+        const Coord sender(50, 50);
+
+        THEN("receivers are in the far field beyond 300m from the center of the sender's cell")
+        {
+            REQUIRE_FALSE(farField.isFarField(sender, Coord(350, 50)));
+            REQUIRE(farField.isFarField(sender, Coord(351, 50)));
+            REQUIRE(farField.isFarField(Coord(0, 0), Coord(351, 50)));
+        }
+
+        WHEN("a transmission covers half of a slice")
+        {
+            farField.add(sender, frequency, 1, SimTime(0), SimTime(500, SIMTIME_US));
+
+            THEN("its power is averaged over the slice and attenuated from the cell center")
+            {
+                REQUIRE(farField.getNumTransmissions() == 1);
+                REQUIRE(farField.getMaxPower(Coord(1050, 50), frequency, SimTime(0), SimTime(200, SIMTIME_US), 2000) == Approx(freeSpace(0.5, 1000)));
+            }
+            THEN("it does not interfere with other frequencies, later slices, or receivers in its near field or beyond maxDistance")
+            {
+                REQUIRE(farField.getMaxPower(Coord(1050, 50), 5.9e9, SimTime(0), SimTime(0), 2000) == 0);
+                REQUIRE(farField.getMaxPower(Coord(1050, 50), frequency, SimTime(1, SIMTIME_MS), SimTime(2, SIMTIME_MS), 2000) == 0);
+                REQUIRE(farField.getMaxPower(Coord(250, 50), frequency, SimTime(0), SimTime(0), 2000) == 0);
+                REQUIRE(farField.getMaxPower(Coord(1050, 50), frequency, SimTime(0), SimTime(0), 500) == 0);
+            }
+        }
+
+        WHEN("transmissions of two cells overlap in a slice and another one spans two slices")
+        {
+            farField.add(sender, frequency, 1, SimTime(0), SimTime(1, SIMTIME_MS));
+            farField.add(Coord(150, 50), frequency, 1, SimTime(0), SimTime(1, SIMTIME_MS));
+            farField.add(sender, frequency, 4, SimTime(1500, SIMTIME_US), SimTime(2500, SIMTIME_US));
+
+            THEN("each slice sums the cells, and the maximum over the slices is returned")
+            {
+                REQUIRE(farField.getNumSummaries() == 4);
+                const Coord receiver(1050, 50);
+                REQUIRE(farField.getMaxPower(receiver, frequency, SimTime(0), SimTime(0), 2000) == Approx(freeSpace(1, 1000) + freeSpace(1, 900)));
+                REQUIRE(farField.getMaxPower(receiver, frequency, SimTime(1, SIMTIME_MS), SimTime(3, SIMTIME_MS), 2000) == Approx(freeSpace(2, 1000)));
+                REQUIRE(farField.getMaxPower(receiver, frequency, SimTime(0), SimTime(3, SIMTIME_MS), 2000) == Approx(freeSpace(1, 1000) + freeSpace(1, 900)));
+            }
+            THEN("slices older than the retention are forgotten")
+            {
+                farField.add(sender, frequency, 1, SimTime(13, SIMTIME_MS), SimTime(14, SIMTIME_MS));
+                REQUIRE(farField.getNumSummaries() == 1);
+                REQUIRE(farField.getMaxPower(Coord(1050, 50), frequency, SimTime(0), SimTime(3, SIMTIME_MS), 2000) == 0);
+            }
+        }
+
+        THEN("an invalid configuration is rejected")
+        {
+            REQUIRE_THROWS(FarFieldInterference(50, 100, SimTime(1, SIMTIME_MS), SimTime(10, SIMTIME_MS), 2));
+            REQUIRE_THROWS(FarFieldInterference(300, 100, SimTime(0), SimTime(10, SIMTIME_MS), 2));
+        }
+    }
+}
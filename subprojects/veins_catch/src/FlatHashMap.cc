@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <string>
+
+#include "veins/base/utils/FlatHashMap.h"
+
+using veins::FlatHashMap;
+
+SCENARIO("FlatHashMap lookups", "[toolbox]")
+{
+    GIVEN("An empty FlatHashMap")
+    {
+        FlatHashMap<std::string> map;
+
+        THEN("no key is found")
+        {
+            REQUIRE(map.size() == 0);
+            REQUIRE(map.find(0) == nullptr);
+            REQUIRE(map.find(42) == nullptr);
+        }
+        WHEN("values are inserted")
+        {
+            map[0] = "zero";
+            map[42] = "forty-two";
+            THEN("they are found by their keys")
+            {
+                REQUIRE(map.size() == 2);
+                REQUIRE(*map.find(0) == "zero");
+                REQUIRE(*map.find(42) == "forty-two");
+                REQUIRE(map.find(1) == nullptr);
+            }
+            THEN("inserting an existing key returns its value")
+            {
+                REQUIRE(map[42] == "forty-two");
+                REQUIRE(map.size() == 2);
+            }
+        }
+        WHEN("many more values are inserted than it initially had room for")
+        {
+            const size_t initialCapacity = map.capacity();
+            for (uint64_t i = 0; i < 1000; ++i) {
+                map[i << 21] = std::to_string(i);
+            }
+            THEN("it grows, keeping all values and staying at most half full")
+            {
+                REQUIRE(map.capacity() > initialCapacity);
+                REQUIRE(map.size() == 1000);
+                REQUIRE(2 * map.size() <= map.capacity());
+                for (uint64_t i = 0; i < 1000; ++i) {
+                    REQUIRE(map.find(i << 21) != nullptr);
+                    REQUIRE(*map.find(i << 21) == std::to_string(i));
+                }
+                REQUIRE(map.find(1000 << 21) == nullptr);
+            }
+        }
+    }
+}
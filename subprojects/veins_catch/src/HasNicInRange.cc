@@ -0,0 +1,80 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/ConnectionManager.h"
+#include "testutils/Simulation.h"
+
+using namespace veins;
+
+namespace {
+
+class BatchingConnectionManager : public GridConnectionManager {
+public:
+    BatchingConnectionManager(const Coord& playground, double maxDistance, bool useFlatGrid)
+        : GridConnectionManager(playground, maxDistance, useFlatGrid)
+    {
+        batchPositionUpdates = true;
+    }
+};
+
+} // namespace
+
+SCENARIO("BaseConnectionManager::hasNicInRange with batched position updates", "[connectionManager]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    for (bool useFlatGrid : {true, false}) {
+        GIVEN("a maximum interference distance of 100m and a nic far from the origin (flat grid: " << useFlatGrid << ")")
+        {
+            BatchingConnectionManager connectionManager(Coord(2000, 2000, 0), 100, useFlatGrid);
+            DummyNic nic;
+            connectionManager.registerNic(&nic, nullptr, Coord(1500, 1500, 0), Heading(0));
+            connectionManager.commitPositionUpdates();
+            REQUIRE_FALSE(connectionManager.hasNicInRange(Coord(50, 50, 0)));
+
+            WHEN("the nic moves next to the origin without the move being committed")
+            {
+                connectionManager.updateNicPos(nic.getId(), Coord(10, 10, 0), Heading(0));
+
+                THEN("it is found at its new position, but not at its old one")
+                {
+                    REQUIRE(connectionManager.hasNicInRange(Coord(50, 50, 0)));
+                    REQUIRE_FALSE(connectionManager.hasNicInRange(Coord(1500, 1500, 0)));
+                    REQUIRE_FALSE(connectionManager.hasNicInRange(Coord(50, 50, 0), nic.getId()));
+                }
+
+                AND_WHEN("the move is committed")
+                {
+                    connectionManager.commitPositionUpdates();
+
+                    THEN("the result is the same")
+                    {
+                        REQUIRE(connectionManager.hasNicInRange(Coord(50, 50, 0)));
+                        REQUIRE_FALSE(connectionManager.hasNicInRange(Coord(1500, 1500, 0)));
+                    }
+                }
+            }
+        }
+    }
+}
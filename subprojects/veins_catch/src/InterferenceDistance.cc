@@ -0,0 +1,139 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "testutils/ConnectionManager.h"
+#include "testutils/Simulation.h"
+
+#include "veins/base/connectionManager/ChannelAccess.h"
+#include "veins/base/connectionManager/NicEntry.h"
+
+using namespace veins;
+
+namespace {
+
+/**
+ * Nic being its own host that records which connected nics sendToChannel() considers, without sending to any
+ */
+class ReachRecorder : public ChannelAccess {
+public:
+    ReachRecorder(BaseConnectionManager& connectionManager, Coord pos)
+    {
+        getSimulation()->registerComponent(this);
+        cc = &connectionManager;
+        useSendDirect = true;
+        usePropagationDelay = false;
+        antennaPosition = AntennaPosition(getId(), pos, Coord(0, 0, 0), 0);
+        connectionManager.registerNic(this, this, pos, Heading(0));
+    }
+
+    cModule* getParentModule() const override
+    {
+        return const_cast<ReachRecorder*>(this);
+    }
+
+    /** @brief Returns the ids of the nics a packet sent now would be considered for, in ascending order */
+    std::vector<int> send()
+    {
+        considered.clear();
+        sendToChannel(new cPacket());
+        std::sort(considered.begin(), considered.end());
+        return considered;
+    }
+
+protected:
+    bool isReceiverReachable(cPacket*, const NicEntry* nic) override
+    {
+        considered.push_back(nic->nicId);
+        return false;
+    }
+
+private:
+    std::vector<int> considered;
+};
+
+} // namespace
+
+SCENARIO("ChannelAccess limits transmissions to a fraction of the maximum interference distance", "[connectionManager]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    GridConnectionManager connectionManager(Coord(1000, 1000, 0), 100, true);
+    ReachRecorder sender(connectionManager, Coord(500, 500, 0));
+    DummyNic near;
+    DummyNic middle;
+    DummyNic far;
+    connectionManager.registerNic(&near, nullptr, Coord(530, 500, 0), Heading(0));
+    connectionManager.registerNic(&middle, nullptr, Coord(500, 560, 0), Heading(0));
+    connectionManager.registerNic(&far, nullptr, Coord(410, 500, 0), Heading(0));
+    std::vector<int> all{near.getId(), middle.getId(), far.getId()};
+    std::sort(all.begin(), all.end());
+
+    WHEN("the reach is not reduced")
+    {
+        THEN("all connected nics are considered")
+        {
+            REQUIRE(sender.getInterferenceDistanceFactor() == 1);
+            REQUIRE(sender.send() == all);
+        }
+    }
+
+    WHEN("the reach is reduced to 0.7 and then to 0.5 of the maximum interference distance")
+    {
+        sender.setInterferenceDistanceFactor(0.7);
+        std::vector<int> nearAndMiddle{near.getId(), middle.getId()};
+        std::sort(nearAndMiddle.begin(), nearAndMiddle.end());
+        REQUIRE(sender.send() == nearAndMiddle);
+
+        sender.setInterferenceDistanceFactor(0.5);
+        THEN("only the nics within it are considered, while all stay connected")
+        {
+            REQUIRE(sender.send() == std::vector<int>{near.getId()});
+            REQUIRE(connectionManager.getNeighbourIds(&sender) == all);
+        }
+
+        AND_WHEN("it is restored")
+        {
+            sender.setInterferenceDistanceFactor(1);
+            THEN("all connected nics are considered again")
+            {
+                REQUIRE(sender.send() == all);
+            }
+        }
+    }
+
+    WHEN("factors outside [0, 1] are set")
+    {
+        THEN("they are clamped")
+        {
+            sender.setInterferenceDistanceFactor(2);
+            REQUIRE(sender.getInterferenceDistanceFactor() == 1);
+            sender.setInterferenceDistanceFactor(-1);
+            REQUIRE(sender.getInterferenceDistanceFactor() == 0);
+            REQUIRE(sender.send().empty());
+        }
+    }
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "veins/base/utils/IntraNicDispatcher.h"
+
+using veins::IntraNicDispatcher;
+
+namespace {
+
+// records what it receives, optionally answering each message with one to the other layer
+class RecordingLayer : public IntraNicDispatcher::Receiver {
+public:
+    RecordingLayer(std::string name, std::vector<std::string>& log)
+        : name(name)
+        , log(log)
+    {
+    }
+
+    void receiveFromNic(cMessage* msg, bool control) override
+    {
+        log.push_back(name + (control ? ":control" : ":data"));
+        if (reply) {
+            std::function<void()> replyNow = reply;
+            reply = nullptr;
+            replyNow();
+            log.push_back(name + ":done");
+        }
+    }
+
+    std::string name;
+    std::vector<std::string>& log;
+    std::function<void()> reply;
+};
+
+} // namespace
+
+SCENARIO("IntraNicDispatcher delivers without re-entering the sending layer", "[intraNicDispatcher]")
+{
+    std::vector<std::string> log;
+    RecordingLayer phy("phy", log);
+    RecordingLayer mac("mac", log);
+    IntraNicDispatcher dispatcher;
+    dispatcher.setLower(&phy);
+    dispatcher.setUpper(&mac);
+    cMessage* msg = reinterpret_cast<cMessage*>(&log); // never dereferenced
+
+    WHEN("a message is posted while no layer is busy")
+    {
+        dispatcher.postUp(msg, true);
+        THEN("it is delivered right away")
+        {
+            REQUIRE(log == std::vector<std::string>{"mac:control"});
+            REQUIRE(dispatcher.getNumDelivered() == 1);
+        }
+    }
+
+    WHEN("messages are posted while a layer is busy")
+    {
+        {
+            IntraNicDispatcher::Activation activation(&dispatcher);
+            dispatcher.postUp(msg, false);
+            dispatcher.postUp(msg, true);
+            log.push_back("phy:done");
+        }
+        THEN("they are delivered in order once it is done")
+        {
+            REQUIRE(log == std::vector<std::string>{"phy:done", "mac:data", "mac:control"});
+        }
+    }
+
+    WHEN("the receiver answers while handling a message")
+    {
+        mac.reply = [&]() { dispatcher.postDown(msg, false); };
+        dispatcher.postUp(msg, true);
+        THEN("the answer is delivered after the receiver returned")
+        {
+            REQUIRE(log == std::vector<std::string>{"mac:control", "mac:done", "phy:data"});
+            REQUIRE(dispatcher.getNumDelivered() == 2);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/DeciderPhy.h"
+#include "testutils/Simulation.h"
+
+#include "veins/base/phyLayer/BasePhyLayer.h"
+#include "veins/base/phyLayer/Decider.h"
+
+using namespace veins;
+
+namespace {
+
+// a phy without decider whose culling is configured as initialize() would
+class CullingPhy : public BasePhyLayer {
+public:
+    CullingPhy(bool cull, double noiseFloor, double margin)
+    {
+        noiseFloorValue = noiseFloor;
+        cullIrrelevantAirFrames = cull;
+        irrelevantAirFramePower = noiseFloor * pow(10, -margin / 10);
+    }
+
+    // hands the frame to the phy as handleAirFrameStartReceive() would, which takes ownership
+    void receive(std::unique_ptr<AirFrame11p> frame)
+    {
+        frame->setSignalFiltered(true);
+        startReceiving(frame.release());
+    }
+
+    size_t getNumOnChannel()
+    {
+        return channelInfo.getNumAirFrames();
+    }
+
+    long getNumIrrelevant() const
+    {
+        return numIrrelevantAirFrames;
+    }
+};
+
+} // namespace
+
+SCENARIO("BasePhyLayer drops AirFrames far below the noise floor", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    const double noise = 1e-10;
+
+    GIVEN("a phy culling frames more than 20 dB below the noise floor")
+    {
+        CullingPhy phy(true, noise, 20);
+
+        WHEN("a frame just above the margin arrives")
+        {
+            phy.receive(createAirFrame11p(0, 0.001, noise / 90));
+            THEN("it is put on the channel")
+            {
+                REQUIRE(phy.getNumOnChannel() == 1);
+                REQUIRE(phy.getNumIrrelevant() == 0);
+            }
+        }
+
+        WHEN("a frame just below the margin arrives")
+        {
+            phy.receive(createAirFrame11p(0, 0.001, noise / 110));
+            THEN("it is dropped and counted")
+            {
+                REQUIRE(phy.getNumOnChannel() == 0);
+                REQUIRE(phy.getNumIrrelevant() == 1);
+            }
+        }
+    }
+
+    GIVEN("a phy not culling frames")
+    {
+        CullingPhy phy(false, noise, 20);
+
+        WHEN("a frame far below the noise floor arrives")
+        {
+            phy.receive(createAirFrame11p(0, 0.001, noise / 1e6));
+            THEN("it is put on the channel all the same")
+            {
+                REQUIRE(phy.getNumOnChannel() == 1);
+                REQUIRE(phy.getNumIrrelevant() == 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,271 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <fstream>
+#include <random>
+#include <regex>
+#include <sstream>
+
+#include "veins/base/phyLayer/DeciderToPhyInterface.h"
+#include "veins/base/toolbox/Signal.h"
+#include "veins/base/toolbox/SignalUtils.h"
+#include "veins/base/messages/AirFrame_m.h"
+#include "veins/modules/analogueModel/TwoRayInterferenceModel.h"
+#include "veins/modules/mobility/traci/TraCIBuffer.h"
+#include "veins/modules/phy/NistErrorRate.h"
+#include "veins/modules/utility/BBoxLookup.h"
+#include "veins/modules/utility/Consts80211p.h"
+#include "testutils/Simulation.h"
+#include "testutils/Component.h"
+
+using namespace veins;
+using AirFrameVector = DeciderToPhyInterface::AirFrameVector;
+
+// Kernel benchmarks, not run by default (hidden tag). Start with
+//   veins_catch "[benchmark]"
+// and add "-r xml -o benchmarks.xml" to get the results (mean, standard deviation, outliers) in a machine-readable format.
+
+namespace {
+
+// spectrum resembling the one of PhyLayer80211p: edges and center of 7 channels
+Spectrum makeSpectrum()
+{
+    Spectrum::Frequencies freqs;
+    for (size_t i = 0; i < 21; i++) {
+        freqs.push_back(5.855e9 + i * 5e6);
+    }
+    return Spectrum(freqs);
+}
+
+// signal covering the data interval of one channel
+Signal makeSignal(const Spectrum& spectrum, AnalogueModelList* analogueModels)
+{
+    Signal signal(spectrum);
+    signal.at(9) = 1;
+    signal.at(10) = 1;
+    signal.at(11) = 1;
+    signal.setDataStart(9);
+    signal.setDataEnd(11);
+    signal.setCenterFrequencyIndex(10);
+    signal.setAnalogueModelList(analogueModels);
+    signal.setTiming(0, 10);
+    return signal;
+}
+
+// bounding boxes of the buildings of the erlangen example, or nothing if its polygon file cannot be found
+std::vector<BBoxLookup::Box> loadErlangenBoxes()
+{
+    std::vector<BBoxLookup::Box> boxes;
+    for (const char* path : {"../../examples/veins/erlangen.poly.xml", "../../../examples/veins/erlangen.poly.xml"}) {
+        std::ifstream in(path);
+        if (!in) continue;
+        std::stringstream content;
+        content << in.rdbuf();
+        const std::string xml = content.str();
+        const std::regex shapeAttribute("shape=\"([^\"]*)\"");
+        for (auto shape = std::sregex_iterator(xml.begin(), xml.end(), shapeAttribute); shape != std::sregex_iterator(); ++shape) {
+            std::istringstream points((*shape)[1].str());
+            BBoxLookup::Box box{{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()}, {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()}};
+            double x, y;
+            char comma;
+            while (points >> x >> comma >> y) {
+                box.p1.x = std::min(box.p1.x, x);
+                box.p1.y = std::min(box.p1.y, y);
+                box.p2.x = std::max(box.p2.x, x);
+                box.p2.y = std::max(box.p2.y, y);
+            }
+            if (box.p1.x <= box.p2.x) boxes.push_back(box);
+        }
+        break;
+    }
+    return boxes;
+}
+
+} // namespace
+
+TEST_CASE("Benchmark Signal kernels", "[.][benchmark]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+
+    const Spectrum spectrum = makeSpectrum();
+    AnalogueModelList analogueModels;
+    Signal signal = makeSignal(spectrum, &analogueModels);
+    Signal accumulator(spectrum);
+
+    BENCHMARK("Signal += and -=")
+    {
+        accumulator += signal;
+        accumulator -= signal;
+        return accumulator.getMax();
+    };
+
+    BENCHMARK("Signal *= double")
+    {
+        accumulator *= 1.0000001;
+        return accumulator.at(10);
+    };
+
+    AirFrame signalFrame;
+    signalFrame.setSignal(signal);
+
+    for (size_t numInterferers : {8, 64, 256}) {
+        std::vector<std::unique_ptr<AirFrame>> interfererFrameOwner; // for automatic deletion (RAII)
+        AirFrameVector interfererFrames;
+        for (size_t i = 0; i < numInterferers; i++) {
+            Signal interferer(signal);
+            interferer *= 1e-3 * (i + 1);
+            interferer.setTiming(10.0 * i / numInterferers, 5);
+            interfererFrameOwner.emplace_back(new AirFrame());
+            interfererFrameOwner.back()->setSignal(interferer);
+            interfererFrames.push_back(interfererFrameOwner.back().get());
+        }
+
+        BENCHMARK("SignalUtils::getMinSINR, " + std::to_string(numInterferers) + " interferers")
+        {
+            return SignalUtils::getMinSINR(0, 10, &signalFrame, interfererFrames, 1e-9);
+        };
+
+        BENCHMARK("SignalUtils::evaluateReception, " + std::to_string(numInterferers) + " interferers")
+        {
+            return SignalUtils::evaluateReception(0, 10, &signalFrame, interfererFrames, 1e-9).minSinr;
+        };
+    }
+}
+
+TEST_CASE("Benchmark NistErrorRate", "[.][benchmark]")
+{
+    BENCHMARK("NistErrorRate::getChunkSuccessRate, 6 Mbit/s, 2400 bits")
+    {
+        return NistErrorRate::getChunkSuccessRate(6000000, Bandwidth::ofdm_10_mhz, 10.0, 2400);
+    };
+
+    BENCHMARK("NistErrorRate::getChunkSuccessRate, 27 Mbit/s, 2400 bits")
+    {
+        return NistErrorRate::getChunkSuccessRate(27000000, Bandwidth::ofdm_10_mhz, 300.0, 2400);
+    };
+}
+
+TEST_CASE("Benchmark TwoRayInterferenceModel", "[.][benchmark]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    DummyComponent dc(&ds);
+
+    const Spectrum spectrum = makeSpectrum();
+    AnalogueModelList analogueModels;
+    TwoRayInterferenceModel model(&dc, 1.02);
+    Signal signal = makeSignal(spectrum, &analogueModels);
+    int dummyId = -1;
+    signal.setSenderPoa({{dummyId, Coord(0, 0, 2), Coord(0, 0, 0), simTime()}, {}, nullptr});
+    signal.setReceiverPoa({{dummyId, Coord(250, 0, 2), Coord(0, 0, 0), simTime()}, {}, nullptr});
+
+    BENCHMARK_ADVANCED("TwoRayInterferenceModel::filterSignal")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Signal> signals(meter.runs(), signal);
+        meter.measure([&model, &signals](int i) {
+            model.filterSignal(&signals[i]);
+            return signals[i].at(10);
+        });
+    };
+}
+
+TEST_CASE("Benchmark BBoxLookup", "[.][benchmark]")
+{
+    std::vector<BBoxLookup::Box> boxes = loadErlangenBoxes();
+    if (boxes.empty()) {
+        WARN("erlangen.poly.xml not found, using random boxes instead");
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> pos(0, 2500);
+        std::uniform_real_distribution<double> extent(5, 50);
+        for (size_t i = 0; i < 2000; ++i) {
+            const double x = pos(rng);
+            const double y = pos(rng);
+            boxes.push_back({{x, y}, {x + extent(rng), y + extent(rng)}});
+        }
+    }
+
+    // move the boxes to the origin, as done for the playground
+    BBoxLookup::Point minCorner{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    BBoxLookup::Point maxCorner{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (const auto& box : boxes) {
+        minCorner.x = std::min(minCorner.x, box.p1.x);
+        minCorner.y = std::min(minCorner.y, box.p1.y);
+        maxCorner.x = std::max(maxCorner.x, box.p2.x);
+        maxCorner.y = std::max(maxCorner.y, box.p2.y);
+    }
+    std::vector<Obstacle*> obstacles; // only used as opaque handles
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        boxes[i].p1.x -= minCorner.x;
+        boxes[i].p1.y -= minCorner.y;
+        boxes[i].p2.x -= minCorner.x;
+        boxes[i].p2.y -= minCorner.y;
+        obstacles.push_back(reinterpret_cast<Obstacle*>(i + 1));
+    }
+    const double sizeX = maxCorner.x - minCorner.x;
+    const double sizeY = maxCorner.y - minCorner.y;
+    BBoxLookup lookup(obstacles, [&boxes](Obstacle* o) { return boxes[reinterpret_cast<size_t>(o) - 1]; }, sizeX, sizeY);
+
+    // links of up to 500m between random positions
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> posX(0, sizeX);
+    std::uniform_real_distribution<double> posY(0, sizeY);
+    std::uniform_real_distribution<double> offset(-250, 250);
+    std::vector<std::pair<BBoxLookup::Point, BBoxLookup::Point>> links;
+    for (size_t i = 0; i < 1000; ++i) {
+        const BBoxLookup::Point sender{posX(rng), posY(rng)};
+        const BBoxLookup::Point receiver{std::min(std::max(sender.x + offset(rng), 0.0), sizeX), std::min(std::max(sender.y + offset(rng), 0.0), sizeY)};
+        links.emplace_back(sender, receiver);
+    }
+
+    size_t next = 0;
+    BENCHMARK("BBoxLookup::findOverlapping, " + std::to_string(boxes.size()) + " obstacles")
+    {
+        const auto& link = links[next++ % links.size()];
+        return lookup.findOverlapping(link.first, link.second).size();
+    };
+}
+
+TEST_CASE("Benchmark TraCIBuffer decoding", "[.][benchmark]")
+{
+    // variables of 1000 vehicles, as in (simplified) vehicle subscription results
+    const size_t numVehicles = 1000;
+    TraCIBuffer encoded;
+    for (size_t i = 0; i < numVehicles; ++i) {
+        encoded << ("veh" + std::to_string(i)) << 1000.0 + i << 2000.0 - i << std::string("edge_1234_0") << 13.9 << 90.0 << static_cast<int32_t>(8);
+    }
+    const std::string message = encoded.str();
+
+    BENCHMARK("TraCIBuffer decoding of " + std::to_string(numVehicles) + " vehicles")
+    {
+        TraCIBuffer buf(message);
+        double sum = 0;
+        for (size_t i = 0; i < numVehicles; ++i) {
+            std::string id = buf.read<std::string>();
+            double xy[2];
+            buf.readArray(xy, 2);
+            std::string edge = buf.read<std::string>();
+            sum += xy[0] + xy[1] + buf.read<double>() + buf.read<double>() + buf.read<int32_t>() + id.size() + edge.size();
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,125 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/mobility/traci/LaneIndex.h"
+
+using namespace veins;
+
+namespace {
+
+SumoNetwork::Lane makeLane(std::string id, std::vector<TraCICoord> shape, double length = 0)
+{
+    SumoNetwork::Lane lane;
+    lane.id = id;
+    lane.edgeId = id.substr(0, id.find('_'));
+    lane.length = length;
+    lane.width = SumoNetwork::defaultLaneWidth;
+    lane.shape = shape;
+    return lane;
+}
+
+} // namespace
+
+SCENARIO("LaneIndex", "[traci]")
+{
+    GIVEN("Two parallel lanes running east and an L-shaped lane, in cells of 10 m")
+    {
+        std::vector<SumoNetwork::Lane> lanes;
+        lanes.push_back(makeLane("east_0", {{0, 0}, {100, 0}}));
+        lanes.push_back(makeLane("east_1", {{0, 3.2}, {100, 3.2}}));
+        lanes.push_back(makeLane("bend_0", {{200, 0}, {200, 100}, {300, 100}}, 400));
+        LaneIndex index(lanes, 10);
+
+        THEN("all segments are indexed")
+        {
+            REQUIRE(index.getNumSegments() == 4);
+        }
+
+        WHEN("a position between the parallel lanes, closer to the right one, is matched")
+        {
+            const auto m = index.match(TraCICoord(42, 1), 5);
+            THEN("the right lane is found, with the position along it and the offset to its left")
+            {
+                REQUIRE(m);
+                REQUIRE(m.lane->id == "east_0");
+                REQUIRE(m.lanePosition == Approx(42));
+                REQUIRE(m.lateralOffset == Approx(1));
+                REQUIRE(m.distance == Approx(1));
+            }
+            THEN("both lanes are nearby, nearest first")
+            {
+                const auto all = index.matchAll(TraCICoord(42, 1), 5);
+                REQUIRE(all.size() == 2);
+                REQUIRE(all[0].lane->id == "east_0");
+                REQUIRE(all[1].lane->id == "east_1");
+                REQUIRE(all[1].lateralOffset == Approx(-2.2));
+            }
+        }
+
+        WHEN("a position next to the second segment of the bend is matched")
+        {
+            const auto m = index.match(TraCICoord(250, 98), 5);
+            THEN("its lane position covers the first segment, scaled to the lane's length")
+            {
+                REQUIRE(m);
+                REQUIRE(m.lane->id == "bend_0");
+                REQUIRE(m.lanePosition == Approx((100 + 50) * 2));
+                REQUIRE(m.lateralOffset == Approx(-2));
+                REQUIRE(m.point.x == Approx(250));
+                REQUIRE(m.point.y == Approx(100));
+            }
+        }
+
+        WHEN("a position is farther than maxDistance from all lanes")
+        {
+            THEN("there is no match")
+            {
+                REQUIRE_FALSE(index.match(TraCICoord(150, 50), 20));
+                REQUIRE_FALSE(index.match(TraCICoord(-500, -500), 20));
+                REQUIRE(index.matchAll(TraCICoord(150, 50), 20).empty());
+            }
+        }
+
+        WHEN("positions all over the network are matched")
+        {
+            THEN("a radius covering the network finds every lane, and match agrees with the nearest one")
+            {
+                for (double x = -20; x <= 320; x += 7.3) {
+                    for (double y = -20; y <= 120; y += 5.1) {
+                        const auto all = index.matchAll(TraCICoord(x, y), 1e9);
+                        REQUIRE(all.size() == 3);
+                        const auto m = index.match(TraCICoord(x, y), 8);
+                        if (all[0].distance <= 8) {
+                            REQUIRE(m);
+                            REQUIRE(m.distance == Approx(all[0].distance));
+                        }
+                        else {
+                            REQUIRE_FALSE(m);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
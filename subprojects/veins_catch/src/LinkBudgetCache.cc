@@ -0,0 +1,158 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/AirFrame.h"
+#include "testutils/DummyAnalogueModel.h"
+#include "testutils/Simulation.h"
+
+#include "veins/base/modules/BaseWorldUtility.h"
+#include "veins/base/phyLayer/BasePhyLayer.h"
+#include "veins/base/phyLayer/Decider.h"
+#include "veins/modules/analogueModel/BreakpointPathlossModel.h"
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+
+using namespace veins;
+
+namespace {
+
+/**
+ * DummyAnalogueModel that counts how often it filters a signal
+ */
+class CountingAnalogueModel : public DummyAnalogueModel {
+public:
+    CountingAnalogueModel(double factor, bool deterministic)
+        : DummyAnalogueModel(nullptr, factor)
+        , deterministic(deterministic)
+    {
+    }
+
+    void filterSignal(Signal* signal) override
+    {
+        ++numFiltered;
+        DummyAnalogueModel::filterSignal(signal);
+    }
+
+    bool isDeterministic() const override
+    {
+        return deterministic;
+    }
+
+    int numFiltered = 0;
+
+private:
+    const bool deterministic;
+};
+
+/**
+ * phy that caches link budgets for the passed models, without being part of a network
+ */
+class LinkBudgetPhy : public BasePhyLayer {
+public:
+    LinkBudgetPhy(BaseWorldUtility* world, std::shared_ptr<AnalogueModel> deterministic, std::shared_ptr<AnalogueModel> perFrame)
+    {
+        this->world = world;
+        cacheLinkBudgets = true;
+        fuseAnalogueModels = false;
+        analogueModelsDeterministic.push_back(deterministic);
+        analogueModelsPerFrame.push_back(perFrame);
+    }
+
+    using BasePhyLayer::applyCachedAnalogueModels;
+};
+
+} // namespace
+
+SCENARIO("BasePhyLayer caches the attenuation of deterministic analogue models per link and time step", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    BaseWorldUtility world;
+    auto deterministic = std::make_shared<CountingAnalogueModel>(0.5, true);
+    auto perFrame = std::make_shared<CountingAnalogueModel>(0.1, false);
+    LinkBudgetPhy phy(&world, deterministic, perFrame);
+
+    const double centerFreq = 5.89e9;
+    const LinkGeometry link(Coord(0, 0), Coord(100, 0));
+    AirFrame first = createAirframe(centerFreq, 10e6, 0, 0.001, 1);
+    phy.applyCachedAnalogueModels(&first, first.getSignal(), link);
+
+    THEN("the first frame is attenuated by all models")
+    {
+        REQUIRE(first.getSignal().atFrequency(centerFreq) == Approx(0.05));
+        REQUIRE(deterministic->numFiltered == 1);
+        REQUIRE(perFrame->numFiltered == 1);
+    }
+
+    WHEN("another frame is received on the same link")
+    {
+        AirFrame second = createAirframe(centerFreq, 10e6, 0.01, 0.001, 2);
+        phy.applyCachedAnalogueModels(&second, second.getSignal(), link);
+
+        THEN("it is attenuated alike, reusing the cached link budget")
+        {
+            REQUIRE(second.getSignal().atFrequency(centerFreq) == Approx(0.1));
+            REQUIRE(deterministic->numFiltered == 1);
+            REQUIRE(perFrame->numFiltered == 2);
+        }
+    }
+
+    WHEN("another frame is received after the sender moved")
+    {
+        AirFrame second = createAirframe(centerFreq, 10e6, 0.01, 0.001, 1);
+        phy.applyCachedAnalogueModels(&second, second.getSignal(), LinkGeometry(Coord(10, 0), Coord(100, 0)));
+
+        THEN("the link budget is computed again")
+        {
+            REQUIRE(second.getSignal().atFrequency(centerFreq) == Approx(0.05));
+            REQUIRE(deterministic->numFiltered == 2);
+        }
+    }
+
+    WHEN("another frame is received on the same link in the next time step")
+    {
+        world.receiveSignal(nullptr, TraCIScenarioManager::traciTimestepBeginSignal, SimTime(1), nullptr);
+        AirFrame second = createAirframe(centerFreq, 10e6, 1, 0.001, 1);
+        phy.applyCachedAnalogueModels(&second, second.getSignal(), link);
+
+        THEN("the link budget is computed again")
+        {
+            REQUIRE(second.getSignal().atFrequency(centerFreq) == Approx(0.05));
+            REQUIRE(deterministic->numFiltered == 2);
+        }
+    }
+}
+
+TEST_CASE("BreakpointPathlossModel is deterministic only while it does not record pathlosses", "[phy]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    const Coord playgroundSize(1000, 1000);
+
+    BreakpointPathlossModel recording(nullptr, 40, 58, 2, 3.3, 8, false, playgroundSize);
+    REQUIRE_FALSE(recording.isDeterministic());
+    REQUIRE_FALSE(recording.isShareable());
+
+    BreakpointPathlossModel silent(nullptr, 40, 58, 2, 3.3, 8, false, playgroundSize, false);
+    REQUIRE(silent.isDeterministic());
+    REQUIRE(silent.isShareable());
+}
@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/base/utils/LinkGeometry.h"
+
+using veins::Coord;
+using veins::LinkGeometry;
+
+SCENARIO("LinkGeometry", "[linkGeometry]")
+{
+    GIVEN("A link from (1, 2, 1) to (4, -2, 13)")
+    {
+        const Coord senderPos(1, 2, 1);
+        const Coord receiverPos(4, -2, 13);
+        const LinkGeometry link(senderPos, receiverPos);
+
+        THEN("its distances match those of Coord")
+        {
+            REQUIRE(link.sqrDistance == receiverPos.sqrdist(senderPos));
+            REQUIRE(link.distance == 13);
+            REQUIRE(link.distance2D == 5);
+        }
+
+        THEN("its direction is a unit vector from sender to receiver")
+        {
+            REQUIRE(link.direction.x == Approx(3.0 / 13));
+            REQUIRE(link.direction.y == Approx(-4.0 / 13));
+            REQUIRE(link.direction.z == Approx(12.0 / 13));
+            REQUIRE(link.direction.length() == Approx(1));
+        }
+
+        THEN("its azimuth and elevation point from sender to receiver")
+        {
+            // y points south, so the receiver is to the north east
+            REQUIRE(link.getAzimuth() == Approx(atan2(4, 3)));
+            REQUIRE(link.getElevation() == Approx(atan2(12, 5)));
+        }
+    }
+
+    GIVEN("A link between two antennas at the same position")
+    {
+        const LinkGeometry link(Coord(1, 2, 3), Coord(1, 2, 3));
+
+        THEN("its distance and direction are zero")
+        {
+            REQUIRE(link.distance == 0);
+            REQUIRE(link.direction.length() == 0);
+        }
+    }
+}
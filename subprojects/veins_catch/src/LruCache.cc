@@ -0,0 +1,91 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <string>
+
+#include "veins/modules/utility/LruCache.h"
+
+using veins::LruCache;
+
+SCENARIO("LruCache eviction", "[utility]")
+{
+    GIVEN("A cache with capacity 2 holding two entries")
+    {
+        LruCache<int, std::string> cache(2);
+        cache.insert(1, "one");
+        cache.insert(2, "two");
+
+        THEN("both entries can be found")
+        {
+            REQUIRE(cache.size() == 2);
+            REQUIRE(*cache.find(1) == "one");
+            REQUIRE(*cache.find(2) == "two");
+            REQUIRE(cache.getHits() == 2);
+            REQUIRE(cache.getMisses() == 0);
+        }
+        WHEN("the older entry is used and a third one is inserted")
+        {
+            cache.find(1);
+            cache.insert(3, "three");
+            THEN("the least recently used entry is evicted")
+            {
+                REQUIRE(cache.size() == 2);
+                REQUIRE(cache.find(2) == nullptr);
+                REQUIRE(*cache.find(1) == "one");
+                REQUIRE(*cache.find(3) == "three");
+                REQUIRE(cache.getMisses() == 1);
+            }
+        }
+        WHEN("an existing key is inserted again")
+        {
+            cache.insert(1, "uno");
+            THEN("its value is replaced without evicting anything")
+            {
+                REQUIRE(cache.size() == 2);
+                REQUIRE(*cache.find(1) == "uno");
+                REQUIRE(*cache.find(2) == "two");
+            }
+        }
+        WHEN("the capacity is reduced to 1")
+        {
+            cache.setCapacity(1);
+            THEN("only the most recently inserted entry is kept")
+            {
+                REQUIRE(cache.size() == 1);
+                REQUIRE(*cache.find(2) == "two");
+            }
+        }
+        WHEN("entries matching a predicate are erased")
+        {
+            const size_t erased = cache.eraseIf([](int key, const std::string&) { return key == 1; });
+            THEN("only the other entries are kept")
+            {
+                REQUIRE(erased == 1);
+                REQUIRE(cache.size() == 1);
+                REQUIRE(cache.find(1) == nullptr);
+                REQUIRE(*cache.find(2) == "two");
+            }
+        }
+    }
+}
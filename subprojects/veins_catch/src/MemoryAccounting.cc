@@ -0,0 +1,93 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <map>
+#include <vector>
+
+#include "veins/base/utils/MemoryAccounting.h"
+
+using veins::MemoryAccounting;
+
+SCENARIO("MemoryAccounting sums up the usage of registered reporters", "[memoryAccounting]")
+{
+    GIVEN("Two reporters of one subsystem and one of another")
+    {
+        auto reportUsage = [](size_t objects, size_t bytes) {
+            return [objects, bytes]() {
+                MemoryAccounting::Usage usage;
+                usage.objects = objects;
+                usage.bytes = bytes;
+                return usage;
+            };
+        };
+        auto first = MemoryAccounting::add("test.a", reportUsage(1, 10));
+        auto second = MemoryAccounting::add("test.a", reportUsage(2, 20));
+        auto third = MemoryAccounting::add("test.b", reportUsage(3, 30));
+        THEN("Their usage is summed per subsystem")
+        {
+            auto usage = MemoryAccounting::collect();
+            REQUIRE(usage["test.a"].objects == 3);
+            REQUIRE(usage["test.a"].bytes == 30);
+            REQUIRE(usage["test.b"].objects == 3);
+            REQUIRE(usage["test.b"].bytes == 30);
+        }
+        WHEN("A registration is reset")
+        {
+            second.reset();
+            THEN("Its reporter is no longer called")
+            {
+                REQUIRE(MemoryAccounting::collect()["test.a"].bytes == 10);
+            }
+        }
+        WHEN("A registration is moved and the moved-from one destroyed")
+        {
+            {
+                auto moved = std::move(third);
+                MemoryAccounting::Registration empty;
+                empty = std::move(moved);
+                third = std::move(empty);
+            }
+            THEN("Its reporter stays registered")
+            {
+                REQUIRE(MemoryAccounting::collect()["test.b"].bytes == 30);
+            }
+        }
+    }
+    GIVEN("No reporter of a subsystem")
+    {
+        THEN("The subsystem is not reported")
+        {
+            REQUIRE(MemoryAccounting::collect().count("test.c") == 0);
+        }
+    }
+}
+
+TEST_CASE("MemoryAccounting estimates container sizes", "[memoryAccounting]")
+{
+    std::vector<double> values;
+    values.reserve(8);
+    REQUIRE(MemoryAccounting::bytesOf(values) == 8 * sizeof(double));
+    std::map<int, int> nodes{{1, 1}, {2, 2}};
+    REQUIRE(MemoryAccounting::bytesOfNodes(nodes) >= 2 * sizeof(std::pair<const int, int>));
+}
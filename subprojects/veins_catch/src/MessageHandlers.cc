@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "testutils/Simulation.h"
+
+#include "veins/modules/application/ieee80211p/DemoBaseApplLayer.h"
+
+using namespace veins;
+
+namespace {
+
+// an application that only logs which of its handlers received a frame
+class HandlerLog : public DemoBaseApplLayer {
+public:
+    HandlerLog()
+    {
+        // initialize() is never called, which would create these
+        sendBeaconEvt = nullptr;
+        sendWSAEvt = nullptr;
+        receivedWSMs = 0;
+    }
+
+    void registerLogging(int messageType, std::string name)
+    {
+        registerMessageHandler(messageType, [this, name](BaseFrame1609_4*) { log.push_back(name); });
+    }
+
+    void receive(int messageType)
+    {
+        BaseFrame1609_4* wsm = new BaseFrame1609_4();
+        wsm->setMessageType(messageType);
+        handleLowerMsg(wsm);
+    }
+
+    uint32_t getNumWSMs() const
+    {
+        return receivedWSMs;
+    }
+
+    using DemoBaseApplLayer::registerMessageHandler;
+
+    std::vector<std::string> log;
+
+protected:
+    void onWSM(BaseFrame1609_4*) override
+    {
+        log.push_back("onWSM");
+    }
+};
+
+} // namespace
+
+SCENARIO("DemoBaseApplLayer dispatches received frames by message type", "[application]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    HandlerLog app;
+    const int custom = DemoBaseApplLayer::FIRST_CUSTOM_MESSAGE_TYPE;
+
+    GIVEN("handlers for a custom message type and for the BSM type")
+    {
+        app.registerLogging(custom, "custom");
+        app.registerLogging(DemoBaseApplLayer::BSM_TYPE, "bsm");
+
+        WHEN("frames of these types arrive")
+        {
+            app.receive(custom);
+            app.receive(DemoBaseApplLayer::BSM_TYPE);
+            app.receive(custom);
+            THEN("each reaches the handler of its type")
+            {
+                REQUIRE(app.log == std::vector<std::string>{"custom", "bsm", "custom"});
+                REQUIRE(app.getNumWSMs() == 0);
+            }
+        }
+
+        WHEN("frames of types without a handler arrive, inside and beyond the table")
+        {
+            app.receive(DemoBaseApplLayer::WSA_TYPE);
+            app.receive(custom + 100);
+            THEN("they reach onWSM")
+            {
+                REQUIRE(app.log == std::vector<std::string>{"onWSM", "onWSM"});
+                REQUIRE(app.getNumWSMs() == 2);
+            }
+        }
+
+        WHEN("the handler of a type is registered again")
+        {
+            app.registerLogging(custom, "replaced");
+            app.receive(custom);
+            THEN("only the new one is called")
+            {
+                REQUIRE(app.log == std::vector<std::string>{"replaced"});
+            }
+        }
+    }
+
+    WHEN("a handler is registered for a negative message type")
+    {
+        THEN("it is refused")
+        {
+            REQUIRE_THROWS_AS(app.registerMessageHandler(-1, [](BaseFrame1609_4*) {}), cRuntimeError);
+        }
+    }
+}
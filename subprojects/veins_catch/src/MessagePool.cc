@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/Simulation.h"
+
+#include "veins/base/utils/MessagePool.h"
+
+using veins::MessagePool;
+
+SCENARIO("MessagePool", "[messagepool]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    GIVEN("A MessagePool keeping at most 2 free messages")
+    {
+        MessagePool pool(2);
+
+        WHEN("a message is acquired, released and acquired again")
+        {
+            cMessage* first = pool.acquire("first", 1);
+            pool.release(first);
+            cMessage* second = pool.acquire("second", 2);
+
+            THEN("the same object is handed out with the new name and kind")
+            {
+                REQUIRE(second == first);
+                REQUIRE(std::string(second->getName()) == "second");
+                REQUIRE(second->getKind() == 2);
+                REQUIRE(pool.getAllocations() == 1);
+                REQUIRE(pool.getReuses() == 1);
+            }
+
+            pool.release(second);
+        }
+
+        WHEN("more messages are released than the pool keeps")
+        {
+            cMessage* a = pool.acquire("a", 0);
+            cMessage* b = pool.acquire("b", 0);
+            cMessage* c = pool.acquire("c", 0);
+            pool.release(a);
+            pool.release(b);
+            pool.release(c);
+
+            THEN("the surplus is deleted")
+            {
+                REQUIRE(pool.getAllocations() == 3);
+                REQUIRE(pool.getFreeCount() == 2);
+            }
+        }
+    }
+}
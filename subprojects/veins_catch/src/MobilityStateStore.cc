@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/base/utils/MobilityStateStore.h"
+
+using veins::Coord;
+using veins::Heading;
+using veins::MobilityStateStore;
+
+SCENARIO("MobilityStateStore", "[mobility]")
+{
+    GIVEN("A store with two hosts")
+    {
+        MobilityStateStore store;
+        auto a = store.acquire(10);
+        auto b = store.acquire(11);
+        store.set(a, Coord(1, 2, 3), Heading(0), 10, 5);
+        store.set(b, Coord(100, 200), Heading(M_PI / 2), 2, 5);
+
+        THEN("each state is read back")
+        {
+            REQUIRE(store.size() == 2);
+            REQUIRE(store.getPosition(a) == Coord(1, 2, 3));
+            REQUIRE(store.getSpeed(b) == Approx(2));
+            REQUIRE(store.getHostId(b) == 11);
+            REQUIRE(store.getXs()[b] == Approx(100));
+        }
+        THEN("positions are extrapolated along heading and speed")
+        {
+            Coord pa = store.getPositionAt(a, 6);
+            REQUIRE(pa.x == Approx(11));
+            REQUIRE(pa.y == Approx(2));
+            Coord pb = store.getPositionAt(b, 7);
+            REQUIRE(pb.x == Approx(100));
+            REQUIRE(pb.y == Approx(196));
+        }
+        WHEN("a host is released")
+        {
+            store.release(a);
+            THEN("its slot is free and reused next")
+            {
+                REQUIRE_FALSE(store.isValid(a));
+                REQUIRE(store.getHostIds()[a] == -1);
+                auto c = store.acquire(12);
+                REQUIRE(c == a);
+                REQUIRE(store.size() == 2);
+                REQUIRE(store.getPosition(c) == Coord());
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/base/utils/Coord.h"
+#include "veins/base/utils/Move.h"
+
+using namespace veins;
+
+SCENARIO("Move with acceleration", "[mobility]")
+{
+    Move move;
+    move.setStart(Coord(0, 0), SimTime(10));
+    move.setDirectionByVector(Coord(1, 0));
+    move.setSpeed(10);
+
+    GIVEN("an accelerating host approaching a border 100m ahead")
+    {
+        move.setAcceleration(2);
+
+        WHEN("computing when it reaches the border")
+        {
+            const double t = move.getTravelTime(100);
+
+            THEN("it is there sooner than at its initial speed, and faster")
+            {
+                REQUIRE(t < 10);
+                REQUIRE(move.getPositionAt(SimTime(10) + t).x == Approx(100).margin(1e-6));
+                REQUIRE(move.getSpeedAt(SimTime(10) + t) == Approx(10 + 2 * t));
+            }
+        }
+    }
+
+    GIVEN("a decelerating host")
+    {
+        move.setAcceleration(-2);
+
+        THEN("it halts after 5s and 25m, without reversing")
+        {
+            REQUIRE(move.getTravelTime(100) == Approx(5));
+            REQUIRE(move.getTravelTime(16) == Approx(2));
+            REQUIRE(move.getSpeedAt(SimTime(13)) == Approx(4));
+            REQUIRE(move.getSpeedAt(SimTime(20)) == 0);
+            REQUIRE(move.getPositionAt(SimTime(20)).x == Approx(25));
+        }
+    }
+
+    GIVEN("a host at constant speed")
+    {
+        THEN("the travel time is distance over speed")
+        {
+            REQUIRE(move.getTravelTime(100) == Approx(10));
+            REQUIRE(move.getSpeedAt(SimTime(100)) == 10);
+        }
+    }
+}
@@ -0,0 +1,216 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "testutils/ConnectionManager.h"
+#include "testutils/Simulation.h"
+
+using namespace veins;
+
+namespace {
+
+/**
+ * Counts the changes of the neighbours of a nic, unsubscribing on the first change of one kind
+ */
+class ChangeCounter : public NeighbourListener {
+public:
+    enum class Unsubscribe {
+        never,
+        onEntered,
+        onLeft,
+    };
+
+    int numEntered = 0;
+    int numLeft = 0;
+
+    ChangeCounter(BaseConnectionManager& connectionManager, cModule* nic, Unsubscribe unsubscribe)
+        : connectionManager(connectionManager)
+        , nic(nic)
+        , unsubscribe(unsubscribe)
+    {
+        connectionManager.subscribeNeighbourChanges(nic, this);
+    }
+
+    void neighbourEntered(cModule*, cModule*) override
+    {
+        numEntered++;
+        if (unsubscribe == Unsubscribe::onEntered) connectionManager.unsubscribeNeighbourChanges(nic, this);
+    }
+
+    void neighbourLeft(cModule*, cModule*) override
+    {
+        numLeft++;
+        if (unsubscribe == Unsubscribe::onLeft) connectionManager.unsubscribeNeighbourChanges(nic, this);
+    }
+
+private:
+    BaseConnectionManager& connectionManager;
+    cModule* nic;
+    Unsubscribe unsubscribe;
+};
+
+/**
+ * Unsubscribes (and deletes) another listener of the same nic on the first change
+ */
+class Unsubscriber : public NeighbourListener {
+public:
+    Unsubscriber(BaseConnectionManager& connectionManager, cModule* nic, ChangeCounter*& victim)
+        : connectionManager(connectionManager)
+        , nic(nic)
+        , victim(victim)
+    {
+        connectionManager.subscribeNeighbourChanges(nic, this);
+    }
+
+    void neighbourEntered(cModule*, cModule*) override
+    {
+        dropVictim();
+    }
+
+    void neighbourLeft(cModule*, cModule*) override
+    {
+        dropVictim();
+    }
+
+private:
+    void dropVictim()
+    {
+        if (!victim) return;
+        connectionManager.unsubscribeNeighbourChanges(nic, victim);
+        delete victim;
+        victim = nullptr;
+    }
+
+    BaseConnectionManager& connectionManager;
+    cModule* nic;
+    ChangeCounter*& victim;
+};
+
+} // namespace
+
+SCENARIO("Neighbour listeners may unsubscribe while being notified", "[connectionManager]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    DummyNic nic;
+    DummyNic other;
+    GridConnectionManager connectionManager(Coord(1000, 1000, 0), 100, true);
+
+    GIVEN("two nics out of range, the first one listened to by a listener unsubscribing when a neighbour enters, followed by two others")
+    {
+        connectionManager.registerNic(&nic, nullptr, Coord(0, 0, 0), Heading(0));
+        connectionManager.registerNic(&other, nullptr, Coord(500, 0, 0), Heading(0));
+        ChangeCounter unsubscribing(connectionManager, &nic, ChangeCounter::Unsubscribe::onEntered);
+        ChangeCounter counting(connectionManager, &nic, ChangeCounter::Unsubscribe::never);
+        ChangeCounter alsoCounting(connectionManager, &nic, ChangeCounter::Unsubscribe::never);
+
+        WHEN("the other nic moves into range")
+        {
+            connectionManager.updateNicPos(other.getId(), Coord(50, 0, 0), Heading(0));
+
+            THEN("all listeners are notified once")
+            {
+                REQUIRE(unsubscribing.numEntered == 1);
+                REQUIRE(counting.numEntered == 1);
+                REQUIRE(alsoCounting.numEntered == 1);
+            }
+
+            AND_WHEN("it moves out of range again")
+            {
+                connectionManager.updateNicPos(other.getId(), Coord(500, 0, 0), Heading(0));
+
+                THEN("only the listeners still subscribed are notified")
+                {
+                    REQUIRE(unsubscribing.numLeft == 0);
+                    REQUIRE(counting.numLeft == 1);
+                    REQUIRE(alsoCounting.numLeft == 1);
+                }
+            }
+        }
+    }
+
+    GIVEN("two nics in range, the first one listened to by a listener unsubscribing when a neighbour leaves, followed by two others")
+    {
+        connectionManager.registerNic(&nic, nullptr, Coord(0, 0, 0), Heading(0));
+        connectionManager.registerNic(&other, nullptr, Coord(50, 0, 0), Heading(0));
+        ChangeCounter unsubscribing(connectionManager, &nic, ChangeCounter::Unsubscribe::onLeft);
+        ChangeCounter counting(connectionManager, &nic, ChangeCounter::Unsubscribe::never);
+        ChangeCounter alsoCounting(connectionManager, &nic, ChangeCounter::Unsubscribe::never);
+
+        WHEN("the other nic moves out of range")
+        {
+            connectionManager.updateNicPos(other.getId(), Coord(500, 0, 0), Heading(0));
+
+            THEN("all listeners are notified once")
+            {
+                REQUIRE(unsubscribing.numLeft == 1);
+                REQUIRE(counting.numLeft == 1);
+                REQUIRE(alsoCounting.numLeft == 1);
+            }
+        }
+
+        WHEN("the other nic is unregistered")
+        {
+            connectionManager.unregisterNic(&other);
+
+            THEN("all listeners are notified once")
+            {
+                REQUIRE(unsubscribing.numLeft == 1);
+                REQUIRE(counting.numLeft == 1);
+                REQUIRE(alsoCounting.numLeft == 1);
+            }
+        }
+    }
+
+    GIVEN("two nics out of range, the first one listened to by a listener unsubscribing and deleting the listener after it, followed by another")
+    {
+        connectionManager.registerNic(&nic, nullptr, Coord(0, 0, 0), Heading(0));
+        connectionManager.registerNic(&other, nullptr, Coord(500, 0, 0), Heading(0));
+        ChangeCounter* victim = nullptr;
+        Unsubscriber unsubscriber(connectionManager, &nic, victim);
+        victim = new ChangeCounter(connectionManager, &nic, ChangeCounter::Unsubscribe::never);
+        ChangeCounter counting(connectionManager, &nic, ChangeCounter::Unsubscribe::never);
+
+        WHEN("the other nic moves into range")
+        {
+            connectionManager.updateNicPos(other.getId(), Coord(50, 0, 0), Heading(0));
+
+            THEN("the deleted listener is skipped and the remaining ones are notified")
+            {
+                REQUIRE(victim == nullptr);
+                REQUIRE(counting.numEntered == 1);
+            }
+
+            AND_WHEN("it moves out of range again")
+            {
+                connectionManager.updateNicPos(other.getId(), Coord(500, 0, 0), Heading(0));
+
+                THEN("the remaining listeners are notified")
+                {
+                    REQUIRE(counting.numLeft == 1);
+                }
+            }
+        }
+        delete victim;
+    }
+}
@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include "veins/modules/obstacle/Obstacle.h"
+
+using veins::Coord;
+using veins::Obstacle;
+
+namespace {
+
+// straightforward per-edge segment intersection, as a reference for the vectorised implementation
+std::vector<double> referenceIntersections(const Obstacle::Coords& shape, const Coord& sender, const Coord& receiver)
+{
+    std::vector<double> intersectAt;
+    for (size_t i = 0, j = shape.size() - 1; i < shape.size(); j = i++) {
+        const double p1x = receiver.x - sender.x;
+        const double p1y = receiver.y - sender.y;
+        const double p2x = shape[j].x - shape[i].x;
+        const double p2y = shape[j].y - shape[i].y;
+        const double p1p2x = sender.x - shape[i].x;
+        const double p1p2y = sender.y - shape[i].y;
+        const double D = p1x * p2y - p1y * p2x;
+        const double p1Frac = (p2x * p1p2y - p2y * p1p2x) / D;
+        const double p2Frac = (p1x * p1p2y - p1y * p1p2x) / D;
+        if (p1Frac < 0 || p1Frac > 1 || p2Frac < 0 || p2Frac > 1) continue;
+        intersectAt.push_back(p1Frac);
+    }
+    std::sort(intersectAt.begin(), intersectAt.end());
+    return intersectAt;
+}
+
+} // namespace
+
+SCENARIO("Intersecting beams with obstacles", "[obstacle]")
+{
+    GIVEN("Random polygons with 3 to 20 vertices")
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> pos(0, 100);
+        std::uniform_int_distribution<size_t> numVertices(3, 20);
+
+        THEN("intersections match a per-edge computation, both as a vector and in a caller-provided buffer")
+        {
+            for (size_t polygon = 0; polygon < 200; ++polygon) {
+                Obstacle::Coords shape(numVertices(rng));
+                for (auto& corner : shape) corner = Coord(pos(rng), pos(rng));
+                Obstacle obstacle("o", "building", 9, 0.4);
+                obstacle.setShape(shape);
+
+                const Coord sender(pos(rng), pos(rng));
+                const Coord receiver(pos(rng), pos(rng));
+                const std::vector<double> expected = referenceIntersections(shape, sender, receiver);
+                REQUIRE(obstacle.getIntersections(sender, receiver) == expected);
+
+                std::vector<double> buffer(shape.size());
+                const size_t numFound = obstacle.getIntersections(sender, receiver, buffer.data());
+                REQUIRE(std::vector<double>(buffer.begin(), buffer.begin() + numFound) == expected);
+            }
+        }
+    }
+}
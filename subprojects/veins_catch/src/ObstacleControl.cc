@@ -0,0 +1,171 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <new>
+#include <random>
+
+#include "veins/base/modules/BaseWorldUtility.h"
+#include "veins/modules/obstacle/ObstacleControl.h"
+#include "testutils/Simulation.h"
+
+using veins::BaseWorldUtility;
+using veins::Coord;
+using veins::Obstacle;
+using veins::ObstacleControl;
+
+namespace {
+
+/**
+ * world utility of a 1000 m x 1000 m playground, set up without being part of a network
+ */
+class TestWorld : public BaseWorldUtility {
+public:
+    TestWorld()
+    {
+        playgroundSize = Coord(1000, 1000, 0);
+        useTorusFlag = false;
+        use2DFlag = true;
+        airFrameId = 0;
+        isInitialized = true;
+    }
+};
+
+/**
+ * ObstacleControl set up without being part of a network: no annotations, one obstacle type
+ */
+class TestObstacleControl : public ObstacleControl {
+public:
+    TestObstacleControl()
+    {
+        annotations = nullptr;
+        perCut["building"] = 9;
+        perMeter["building"] = 0.4;
+        cacheEntries.setCapacity(64);
+    }
+};
+
+Obstacle makeBuilding(double x, double y, double size)
+{
+    Obstacle obstacle("", "building", 9, 0.4);
+    obstacle.setShape({Coord(x, y), Coord(x + size, y), Coord(x + size, y + size), Coord(x, y + size)});
+    return obstacle;
+}
+
+} // namespace
+
+SCENARIO("ObstacleControl::queryAttenuation", "[obstacles]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+
+    GIVEN("A grid of buildings")
+    {
+        TestWorld world; // obstacles are looked up on its playground
+        TestObstacleControl obstacles;
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 10; ++j) {
+                obstacles.add(makeBuilding(i * 100 + 10, j * 100 + 10, 60));
+            }
+        }
+
+        THEN("it refuses queries before the geometry is committed")
+        {
+            ObstacleControl::QueryScratch scratch;
+            REQUIRE_FALSE(obstacles.isGeometryCommitted());
+            REQUIRE_THROWS(obstacles.queryAttenuation(Coord(0, 0), Coord(500, 500), scratch));
+        }
+
+        WHEN("the geometry is committed")
+        {
+            obstacles.commitGeometry();
+            REQUIRE(obstacles.isGeometryCommitted());
+
+            THEN("queries yield the attenuation calculateAttenuation() yields, with and without a cache of their own")
+            {
+                ObstacleControl::QueryScratch uncached;
+                ObstacleControl::QueryScratch cached(obstacles.getCacheCapacity());
+                std::mt19937 rng(42);
+                std::uniform_real_distribution<double> coordinate(0, 1000);
+                for (int k = 0; k < 200; ++k) {
+                    const Coord senderPos(coordinate(rng), coordinate(rng));
+                    const Coord receiverPos(coordinate(rng), coordinate(rng));
+                    const double expected = obstacles.calculateAttenuation(senderPos, receiverPos);
+                    REQUIRE(obstacles.queryAttenuation(senderPos, receiverPos, uncached) == Approx(expected));
+                    REQUIRE(obstacles.queryAttenuation(senderPos, receiverPos, cached) == Approx(expected));
+                    // again, now from the cache
+                    REQUIRE(obstacles.queryAttenuation(senderPos, receiverPos, cached) == Approx(expected));
+                }
+            }
+
+            THEN("adding an obstacle requires committing again, after which queries see it")
+            {
+                ObstacleControl::QueryScratch scratch(obstacles.getCacheCapacity());
+                const Coord senderPos(80, 5);
+                const Coord receiverPos(80, 95);
+                REQUIRE(obstacles.queryAttenuation(senderPos, receiverPos, scratch) == Approx(1));
+
+                obstacles.add(makeBuilding(75, 40, 10));
+                REQUIRE_FALSE(obstacles.isGeometryCommitted());
+                obstacles.commitGeometry();
+                const double expected = obstacles.calculateAttenuation(senderPos, receiverPos);
+                REQUIRE(expected < 1);
+                REQUIRE(obstacles.queryAttenuation(senderPos, receiverPos, scratch) == Approx(expected));
+            }
+        }
+    }
+}
+
+SCENARIO("ObstacleControl::queryAttenuation with a scratch outliving its module", "[obstacles]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr));
+    TestWorld world;
+    ObstacleControl::QueryScratch scratch(64);
+    const Coord senderPos(80, 5);
+    const Coord receiverPos(80, 95);
+
+    GIVEN("A scratch that cached a link without obstacles")
+    {
+        // the next module is built at the same address, with as many obstacles (so as the same geometryVersion)
+        alignas(TestObstacleControl) unsigned char storage[sizeof(TestObstacleControl)];
+        TestObstacleControl* obstacles = new (storage) TestObstacleControl();
+        obstacles->add(makeBuilding(500, 500, 10));
+        obstacles->commitGeometry();
+        REQUIRE(obstacles->queryAttenuation(senderPos, receiverPos, scratch) == Approx(1));
+        obstacles->~TestObstacleControl();
+
+        WHEN("a module with an obstacle on that link takes the place of the old one")
+        {
+            obstacles = new (storage) TestObstacleControl();
+            obstacles->add(makeBuilding(75, 40, 10));
+            obstacles->commitGeometry();
+            const double expected = obstacles->calculateAttenuation(senderPos, receiverPos);
+
+            THEN("queries with the scratch see the new obstacle")
+            {
+                REQUIRE(expected < 1);
+                REQUIRE(obstacles->queryAttenuation(senderPos, receiverPos, scratch) == Approx(expected));
+            }
+            obstacles->~TestObstacleControl();
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <cstdio>
+
+#include "veins/modules/obstacle/ObstacleDatabase.h"
+
+using veins::BBoxLookup;
+using veins::Coord;
+using veins::Obstacle;
+using veins::ObstacleDatabase;
+
+SCENARIO("ObstacleDatabase stores obstacles and their lookup table", "[obstacle]")
+{
+    GIVEN("Two obstacles of different types and a lookup table for them")
+    {
+        const std::map<std::string, double> perCut{{"building", 9}, {"wall", 3}};
+        const std::map<std::string, double> perMeter{{"building", 0.4}, {"wall", 0}};
+        Obstacle house("house#0", "building", 9, 0.4);
+        house.setShape({Coord(10, 10), Coord(60, 10), Coord(60, 40), Coord(10, 40)});
+        Obstacle fence("fence#0", "wall", 3, 0);
+        fence.setShape({Coord(100, 0), Coord(300, 150)});
+        std::vector<Obstacle*> obstacles{&house, &fence};
+        auto getBBox = [](Obstacle* o) { return BBoxLookup::Box{{o->getBboxP1().x, o->getBboxP1().y}, {o->getBboxP2().x, o->getBboxP2().y}}; };
+        BBoxLookup lookup(obstacles, getBBox, 400, 200, 100);
+        const BBoxLookup::CellTable table = lookup.getCellTable();
+        const std::string fileName = "ObstacleDatabase.test.bin";
+
+        WHEN("they are written to a database and read back")
+        {
+            ObstacleDatabase::write(fileName, perCut, perMeter, {&house, &fence}, &table, Coord(400, 200));
+            ObstacleDatabase database(fileName);
+            std::remove(fileName.c_str());
+
+            THEN("types, obstacles and shapes are preserved")
+            {
+                REQUIRE(database.getNumTypes() == 2);
+                REQUIRE(database.getTypeName(0) == "building");
+                REQUIRE(database.getType(0).attenuationPerCut == 9);
+                REQUIRE(database.getType(0).attenuationPerMeter == 0.4);
+                REQUIRE(database.getNumObstacles() == 2);
+                REQUIRE(database.getObstacleId(1) == "fence#0");
+                REQUIRE(database.getTypeName(database.getObstacle(1).type) == "wall");
+                REQUIRE(database.getObstacle(0).bboxX2 == 60);
+                REQUIRE(database.getObstacleShape(0) == house.getShape());
+                REQUIRE(database.getObstacleShape(1) == fence.getShape());
+            }
+            THEN("the lookup table is only offered for the grid it was built for")
+            {
+                REQUIRE(database.hasCellTable(100, Coord(400, 200)));
+                REQUIRE_FALSE(database.hasCellTable(250, Coord(400, 200)));
+                REQUIRE_FALSE(database.hasCellTable(100, Coord(500, 200)));
+                const BBoxLookup::CellTable stored = database.getCellTable();
+                REQUIRE(stored.numCols == table.numCols);
+                REQUIRE(stored.numRows == table.numRows);
+                REQUIRE(stored.entries == table.entries);
+                BBoxLookup restored(obstacles, getBBox, stored);
+                REQUIRE(restored.findOverlapping({20, 0}, {20, 199}) == std::vector<Obstacle*>{&house});
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/obstacle/ObstacleShapes.h"
+
+using veins::Coord;
+using veins::Obstacle;
+
+SCENARIO("Simplifying obstacle shapes", "[obstacle]")
+{
+    GIVEN("A square with a closing vertex and nearly collinear vertices along its edges")
+    {
+        const Obstacle::Coords shape{Coord(0, 0), Coord(5, 0.1), Coord(10, 0), Coord(10, 5), Coord(9.95, 7), Coord(10, 10), Coord(0, 10), Coord(0, 0)};
+
+        THEN("simplifying within 0.2m leaves only the corners")
+        {
+            const Obstacle::Coords simplified = veins::simplifyShape(shape, 0.2);
+            REQUIRE(simplified == Obstacle::Coords{Coord(0, 0), Coord(10, 0), Coord(10, 10), Coord(0, 10)});
+        }
+        THEN("simplifying within 0.01m keeps all distinct vertices")
+        {
+            REQUIRE(veins::simplifyShape(shape, 0.01).size() == 7);
+        }
+    }
+    GIVEN("A triangle")
+    {
+        const Obstacle::Coords shape{Coord(0, 0), Coord(10, 0), Coord(5, 1)};
+
+        THEN("it is never simplified")
+        {
+            REQUIRE(veins::simplifyShape(shape, 100) == shape);
+        }
+    }
+}
+
+SCENARIO("Merging obstacle shapes", "[obstacle]")
+{
+    GIVEN("Two squares sharing a wall, in opposite orientation")
+    {
+        const Obstacle::Coords left{Coord(0, 0), Coord(10, 0), Coord(10, 5), Coord(10, 10), Coord(0, 10)};
+        const Obstacle::Coords right{Coord(10, 0), Coord(10, 5), Coord(10, 10), Coord(20, 10), Coord(20, 0)};
+
+        THEN("they merge into their outline")
+        {
+            Obstacle::Coords merged;
+            REQUIRE(veins::mergeShapes(left, right, merged));
+            REQUIRE(merged == Obstacle::Coords{Coord(10, 10), Coord(0, 10), Coord(0, 0), Coord(10, 0), Coord(20, 0), Coord(20, 10)});
+        }
+    }
+    GIVEN("Two squares touching in a single corner")
+    {
+        const Obstacle::Coords a{Coord(0, 0), Coord(10, 0), Coord(10, 10), Coord(0, 10)};
+        const Obstacle::Coords b{Coord(10, 10), Coord(20, 10), Coord(20, 20), Coord(10, 20)};
+
+        THEN("they are not merged")
+        {
+            Obstacle::Coords merged;
+            REQUIRE_FALSE(veins::mergeShapes(a, b, merged));
+        }
+    }
+}
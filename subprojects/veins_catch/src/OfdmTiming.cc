@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+#include "veins/modules/utility/Consts80211p.h"
+#include "testutils/Simulation.h"
+
+using namespace veins;
+
+namespace {
+
+const MCS allMcs[] = {MCS::ofdm_bpsk_r_1_2, MCS::ofdm_bpsk_r_3_4, MCS::ofdm_qpsk_r_1_2, MCS::ofdm_qpsk_r_3_4, MCS::ofdm_qam16_r_1_2, MCS::ofdm_qam16_r_3_4, MCS::ofdm_qam64_r_2_3, MCS::ofdm_qam64_r_3_4};
+
+// frame duration (in seconds) computed like PhyLayer80211p used to, in floating point
+double referenceFrameDuration(int payloadLengthBits, MCS mcs)
+{
+    return PHY_HDR_PREAMBLE_DURATION + PHY_HDR_PLCPSIGNAL_DURATION + T_SYM_80211P * ceil(static_cast<double>(16 + payloadLengthBits + 6) / (getNDBPS(mcs)));
+}
+
+} // namespace
+
+SCENARIO("OfdmTiming", "[ofdmtiming]")
+{
+    GIVEN("The OFDM timing of 802.11p")
+    {
+        THEN("datarates match the runtime lookup for every MCS")
+        {
+            for (auto mcs : allMcs) {
+                REQUIRE(OfdmTiming80211p::datarate(mcs) == getOfdmDatarate(mcs, BANDWIDTH_11P));
+            }
+        }
+
+        THEN("frame durations match the floating point formula for every MCS and payload length")
+        {
+            bool allMatch = true;
+            for (auto mcs : allMcs) {
+                for (int bits = 0; bits <= 4 * 8 * 1500; bits += 8) {
+                    double expected = referenceFrameDuration(bits, mcs);
+                    double actual = OfdmTiming80211p::frameDuration_ns(bits, mcs) * 1e-9;
+                    allMatch = allMatch && std::abs(actual - expected) < 1e-12;
+                }
+            }
+            REQUIRE(allMatch);
+        }
+    }
+
+    GIVEN("The OFDM timing of 20 MHz channels")
+    {
+        using OfdmTiming20 = OfdmTiming<Bandwidth::ofdm_20_mhz>;
+
+        THEN("it uses the 802.11a values")
+        {
+            REQUIRE(OfdmTiming20::slotLength_ns == 9000);
+            REQUIRE(OfdmTiming20::sifs_ns == 16000);
+            REQUIRE(OfdmTiming20::datarate(MCS::ofdm_qam64_r_3_4) == 54000000);
+            REQUIRE(OfdmTiming20::frameDuration_ns(100 * 8, MCS::ofdm_bpsk_r_1_2) == 20000 + 4000 * 35);
+        }
+    }
+}
+
+// Not run by default (hidden tag), start with: veins_catch "[benchmark]"
+TEST_CASE("Benchmark frame duration computation", "[.][benchmark]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+
+    const size_t repetitions = 1000000;
+    simtime_t accumulator = 0;
+
+    auto measureNanoseconds = [&](std::function<simtime_t(int, MCS)> frameDuration) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < repetitions; i++) {
+            accumulator += frameDuration(static_cast<int>(i % 12000), allMcs[i % 8]);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / repetitions;
+    };
+
+    const double floatingPoint = measureNanoseconds([](int bits, MCS mcs) { return simtime_t(referenceFrameDuration(bits, mcs)); });
+    const double table = measureNanoseconds([](int bits, MCS mcs) { return SimTime(OfdmTiming80211p::frameDuration_ns(bits, mcs), SIMTIME_NS); });
+
+    WARN("frame duration via floating point formula: " << floatingPoint << " ns per frame");
+    WARN("frame duration via OfdmTiming80211p: " << table << " ns per frame");
+    REQUIRE(accumulator > 0);
+}
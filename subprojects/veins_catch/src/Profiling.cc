@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+
+#include "veins/base/utils/Profiling.h"
+
+using veins::ProfileCounter;
+using veins::ProfileScope;
+
+SCENARIO("ProfileCounter accumulates calls and time", "[profiling]")
+{
+    GIVEN("A counter")
+    {
+        ProfileCounter counter("test");
+        THEN("It is registered")
+        {
+            auto all = ProfileCounter::getAll();
+            REQUIRE(std::find(all.begin(), all.end(), &counter) != all.end());
+        }
+        WHEN("Durations are added")
+        {
+            counter.add(std::chrono::milliseconds(2));
+            counter.add(std::chrono::milliseconds(3));
+            THEN("Calls and time add up")
+            {
+                REQUIRE(counter.getCalls() == 2);
+                REQUIRE(counter.getSeconds() == Approx(0.005));
+            }
+            AND_WHEN("It is reset")
+            {
+                counter.reset();
+                THEN("It is empty again")
+                {
+                    REQUIRE(counter.getCalls() == 0);
+                    REQUIRE(counter.getSeconds() == 0);
+                }
+            }
+        }
+        WHEN("Another counter is destroyed")
+        {
+            ProfileCounter* destroyed;
+            {
+                ProfileCounter other("other");
+                destroyed = &other;
+            }
+            THEN("Only that one is deregistered")
+            {
+                auto all = ProfileCounter::getAll();
+                REQUIRE(std::find(all.begin(), all.end(), destroyed) == all.end());
+                REQUIRE(std::find(all.begin(), all.end(), &counter) != all.end());
+            }
+        }
+        WHEN("A scope ends")
+        {
+            {
+                ProfileScope scope(counter);
+            }
+            THEN("It was counted")
+            {
+                REQUIRE(counter.getCalls() == 1);
+                REQUIRE(counter.getSeconds() >= 0);
+            }
+        }
+    }
+}
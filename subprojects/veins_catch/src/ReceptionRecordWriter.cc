@@ -0,0 +1,80 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#include "veins/modules/utility/ReceptionRecordWriter.h"
+
+using veins::ReceptionRecord;
+using veins::ReceptionRecordWriter;
+
+SCENARIO("ReceptionRecordWriter writes records in columnar blocks", "[receptionRecorder]")
+{
+    GIVEN("Records spanning several batches")
+    {
+        std::vector<ReceptionRecord> records;
+        for (int i = 0; i < 25; i++) {
+            ReceptionRecord record;
+            record.receiverId = 7 + i % 3;
+            record.senderId = 100 - i;
+            record.time = int64_t(1000000000000) * i;
+            record.rssi_dBm = -85.25 + i;
+            record.sinr_dB = 12.5 - i;
+            record.outcome = static_cast<ReceptionRecord::Outcome>(i % 6);
+            records.push_back(record);
+        }
+        records[3].sinr_dB = -std::numeric_limits<double>::infinity();
+        const std::string fileName = "ReceptionRecordWriter.test.rec";
+
+        WHEN("they are written in batches of 10 and read back")
+        {
+            {
+                ReceptionRecordWriter writer(fileName, 10);
+                for (auto& record : records) writer.append(record);
+                REQUIRE(writer.getNumRecords() == records.size());
+            }
+            const std::vector<ReceptionRecord> read = ReceptionRecordWriter::readFile(fileName);
+            std::remove(fileName.c_str());
+
+            THEN("all records are preserved, with powers to a hundredth of a dB")
+            {
+                REQUIRE(read.size() == records.size());
+                for (size_t i = 0; i < read.size(); i++) {
+                    REQUIRE(read[i].receiverId == records[i].receiverId);
+                    REQUIRE(read[i].senderId == records[i].senderId);
+                    REQUIRE(read[i].time == records[i].time);
+                    REQUIRE(read[i].rssi_dBm == Approx(records[i].rssi_dBm).margin(0.005));
+                    REQUIRE(read[i].outcome == records[i].outcome);
+                    if (i != 3) REQUIRE(read[i].sinr_dB == Approx(records[i].sinr_dB).margin(0.005));
+                }
+            }
+            THEN("a SINR of -inf is clamped")
+            {
+                REQUIRE(read[3].sinr_dB == -1e7);
+            }
+        }
+    }
+}
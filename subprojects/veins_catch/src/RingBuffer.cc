@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <deque>
+
+#include "veins/base/utils/RingBuffer.h"
+
+using veins::RingBuffer;
+
+SCENARIO("RingBuffer", "[ringbuffer]")
+{
+    GIVEN("A RingBuffer with a capacity of 3")
+    {
+        RingBuffer<int> ring(3);
+
+        WHEN("it is filled, drained in part and refilled so that it wraps around")
+        {
+            ring.push(1);
+            ring.push(2);
+            ring.push(3);
+            ring.pop();
+            ring.push(4);
+
+            THEN("it is full and keeps FIFO order")
+            {
+                REQUIRE(ring.full());
+                REQUIRE(ring.capacity() == 3);
+                REQUIRE(ring.front() == 2);
+                REQUIRE(ring[1] == 3);
+                REQUIRE(ring.back() == 4);
+            }
+
+            AND_WHEN("an element in the middle is erased")
+            {
+                ring.erase(1);
+
+                THEN("the others keep their order")
+                {
+                    REQUIRE(ring.size() == 2);
+                    REQUIRE(ring.front() == 2);
+                    REQUIRE(ring.back() == 4);
+                    REQUIRE_FALSE(ring.full());
+                }
+            }
+        }
+    }
+
+    GIVEN("An unbounded RingBuffer and a reference std::deque")
+    {
+        RingBuffer<int> ring;
+        std::deque<int> reference;
+
+        WHEN("a long sequence of pushes and pops is applied to both")
+        {
+            for (int i = 0; i < 1000; i++) {
+                ring.push(i);
+                reference.push_back(i);
+                if (i % 3 == 0) {
+                    ring.pop();
+                    reference.pop_front();
+                }
+            }
+
+            THEN("both hold the same elements")
+            {
+                REQUIRE(ring.capacity() == 0);
+                REQUIRE_FALSE(ring.full());
+                REQUIRE(ring.size() == reference.size());
+                bool same = true;
+                for (size_t i = 0; i < reference.size(); i++) {
+                    same = same && (ring[i] == reference[i]);
+                }
+                REQUIRE(same);
+            }
+        }
+    }
+}
@@ -64,5 +64,65 @@ SCENARIO("Using SampledAntenna1D", "[toolbox]")
             double gain = p.getGain(ownPos, ownOrient, otherPos);
             REQUIRE(gain == Approx(res));
         }
+
+        THEN("gains queried in a batch match individual queries")
+        {
+            std::vector<Coord> others;
+            for (int i = 0; i < 16; i++) {
+                others.emplace_back(cos(i * 0.4), sin(i * 0.4), 0);
+            }
+            std::vector<double> gains(others.size());
+            p.getGains(Coord(0, 0, 0), Coord(1, 0, 0), others.data(), others.size(), gains.data());
+            for (size_t i = 0; i < others.size(); i++) {
+                REQUIRE(gains[i] == Approx(p.getGain(Coord(0, 0, 0), Coord(1, 0, 0), others[i])));
+            }
+        }
+
+        THEN("an antenna using a shared gain table of the same samples returns the same gains")
+        {
+            auto table = std::make_shared<const SampledAntenna1D::GainTable>(values);
+            auto q = SampledAntenna1D(table, rotationType, rotationParams, rng);
+            for (auto& check : checks) {
+                REQUIRE(q.getGain(std::get<0>(check), std::get<2>(check), std::get<1>(check)) == p.getGain(std::get<0>(check), std::get<2>(check), std::get<1>(check)));
+            }
+        }
+
+        THEN("gains towards either end of a link match individual queries")
+        {
+            const Coord senderPos(3, 4, 1.5);
+            const Coord receiverPos(-7, 12, 2);
+            const veins::LinkGeometry link(senderPos, receiverPos);
+            const Coord ownOrient(0.6, -0.8, 0);
+            REQUIRE(p.getGain(link, ownOrient, true) == p.getGain(senderPos, ownOrient, receiverPos));
+            REQUIRE(p.getGain(link, ownOrient, false) == p.getGain(receiverPos, ownOrient, senderPos));
+        }
+
+        THEN("gain bounds are not below the gain in any direction close to the line of sight")
+        {
+            const Coord ownOrient(0.6, -0.8, 0);
+            for (int i = 0; i < 360; i++) {
+                const Coord los(cos(i * M_PI / 180), sin(i * M_PI / 180), 0);
+                const double bound = p.getGainBound(ownOrient, los);
+                for (int offset = -5; offset <= 5; offset++) {
+                    const Coord other(cos((i + offset) * M_PI / 180), sin((i + offset) * M_PI / 180), 0);
+                    REQUIRE(bound >= p.getGain(Coord(0, 0, 0), ownOrient, other));
+                }
+            }
+        }
+    }
+
+    GIVEN("A SampledAntenna1D with a deep null to its back")
+    {
+        std::vector<double> values = {10, 0, -40, -40, -40, 0};
+        std::string rotationType = "";
+        std::vector<double> rotationParams;
+        auto table = std::make_shared<const SampledAntenna1D::GainTable>(values);
+        auto p = SampledAntenna1D(table, rotationType, rotationParams, nullptr);
+
+        THEN("the gain bound is that of the null to its back and that of the main lobe to its front")
+        {
+            REQUIRE(p.getGainBound(Coord(1, 0, 0), Coord(-1, 0, 0)) < FWMath::dBm2mW(-35));
+            REQUIRE(p.getGainBound(Coord(1, 0, 0), Coord(1, 0, 0)) == Approx(FWMath::dBm2mW(10)));
+        }
     }
 }
@@ -0,0 +1,75 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "veins/base/utils/SharedDataRegistry.h"
+
+using veins::SharedDataRegistry;
+
+SCENARIO("SharedDataRegistry builds each entry once", "[utils]")
+{
+    SharedDataRegistry::clear();
+
+    GIVEN("A registry with one vector stored under a key")
+    {
+        int builds = 0;
+        auto create = [&builds]() {
+            builds++;
+            return std::vector<int>{1, 2, 3};
+        };
+        auto first = SharedDataRegistry::getOrCreate<std::vector<int>>("key", create);
+
+        THEN("asking again returns the same data without building it again")
+        {
+            auto second = SharedDataRegistry::getOrCreate<std::vector<int>>("key", create);
+            REQUIRE(second == first);
+            REQUIRE(builds == 1);
+            REQUIRE(*second == std::vector<int>{1, 2, 3});
+        }
+        THEN("other keys and other types get their own entries")
+        {
+            auto otherKey = SharedDataRegistry::getOrCreate<std::vector<int>>("other", create);
+            auto otherType = SharedDataRegistry::getOrCreate<std::string>("key", []() { return std::string("text"); });
+            REQUIRE(otherKey != first);
+            REQUIRE(builds == 2);
+            REQUIRE(*otherType == "text");
+            REQUIRE(SharedDataRegistry::size() == 3);
+        }
+        WHEN("the registry is cleared")
+        {
+            SharedDataRegistry::clear();
+            THEN("data already handed out stays valid and is built anew on the next request")
+            {
+                REQUIRE(*first == std::vector<int>{1, 2, 3});
+                auto rebuilt = SharedDataRegistry::getOrCreate<std::vector<int>>("key", create);
+                REQUIRE(rebuilt != first);
+                REQUIRE(builds == 2);
+            }
+        }
+    }
+
+    SharedDataRegistry::clear();
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <vector>
+
+#include "veins/base/utils/SharedPayload.h"
+
+using veins::SharedPayload;
+
+SCENARIO("SharedPayload", "[toolbox]")
+{
+    GIVEN("A payload made from a vector of 4096 bytes")
+    {
+        std::vector<uint8_t> bytes(4096);
+        for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<uint8_t>(i * 7);
+        const std::vector<uint8_t> expected = bytes;
+        const uint8_t* storage = bytes.data();
+        SharedPayload payload(std::move(bytes));
+
+        THEN("it holds the bytes, taken over without copying")
+        {
+            REQUIRE(payload.size() == expected.size());
+            REQUIRE(payload.data() == storage);
+            REQUIRE(std::vector<uint8_t>(payload.data(), payload.data() + payload.size()) == expected);
+        }
+
+        WHEN("it is copied")
+        {
+            SharedPayload copy = payload;
+            SharedPayload assigned;
+            assigned = copy;
+
+            THEN("the copies share its bytes")
+            {
+                REQUIRE(copy.sharesBytesWith(payload));
+                REQUIRE(assigned.data() == payload.data());
+                REQUIRE(assigned == payload);
+            }
+        }
+
+        WHEN("another payload is made from a copy of the same bytes")
+        {
+            SharedPayload other(expected.data(), expected.size());
+
+            THEN("it is equal, but does not share the bytes")
+            {
+                REQUIRE(other == payload);
+                REQUIRE_FALSE(other.sharesBytesWith(payload));
+            }
+        }
+    }
+
+    GIVEN("An empty payload")
+    {
+        SharedPayload payload;
+
+        THEN("it holds no bytes, like one made from no bytes")
+        {
+            REQUIRE(payload.empty());
+            REQUIRE(payload.data() == nullptr);
+            REQUIRE(payload == SharedPayload(std::vector<uint8_t>()));
+            REQUIRE(payload != SharedPayload("x", 1));
+        }
+    }
+}
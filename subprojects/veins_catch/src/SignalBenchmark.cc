@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+
+#include <chrono>
+
+#include "veins/base/phyLayer/DeciderToPhyInterface.h"
+#include "veins/base/toolbox/Spectrum.h"
+#include "veins/base/toolbox/Signal.h"
+#include "veins/base/toolbox/SignalUtils.h"
+#include "veins/base/messages/AirFrame_m.h"
+#include "testutils/Simulation.h"
+
+using namespace veins;
+using AirFrameVector = DeciderToPhyInterface::AirFrameVector;
+
+namespace {
+
+// run the passed function repeatedly and return the mean duration of one run in nanoseconds
+template <typename F>
+double measureNanoseconds(size_t repetitions, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repetitions; i++) {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / repetitions;
+}
+
+} // namespace
+
+// Not run by default (hidden tag), start with: veins_catch "[benchmark]"
+TEST_CASE("Benchmark Signal arithmetic on SignalUtils workloads", "[.][benchmark]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+
+    // spectrum resembling the one of PhyLayer80211p: edges and center of 7 channels, data interval is one channel
+    Spectrum::Frequencies freqs;
+    for (size_t i = 0; i < 21; i++) {
+        freqs.push_back(5.855e9 + i * 5e6);
+    }
+    Spectrum spectrum(freqs);
+    AnalogueModelList analogueModels;
+
+    Signal signal(spectrum);
+    signal.at(9) = 1;
+    signal.at(10) = 1;
+    signal.at(11) = 1;
+    signal.setDataStart(9);
+    signal.setDataEnd(11);
+    signal.setCenterFrequencyIndex(10);
+    signal.setAnalogueModelList(&analogueModels);
+    signal.setTiming(0, 10);
+
+    AirFrame signalFrame;
+    signalFrame.setSignal(signal);
+
+    std::vector<std::unique_ptr<AirFrame>> interfererFrameOwner; // for automatic deletion (RAII)
+    AirFrameVector interfererFrames;
+    for (size_t i = 0; i < 64; i++) {
+        Signal interferer(signal);
+        interferer *= 1e-3 * (i + 1);
+        interferer.setTiming(0.1 * i, 5);
+        interfererFrameOwner.emplace_back(new AirFrame());
+        interfererFrameOwner.back()->setSignal(interferer);
+        interfererFrames.push_back(interfererFrameOwner.back().get());
+    }
+
+    const size_t repetitions = 10000;
+    Signal accumulator(spectrum);
+    const Signal& interferer = interfererFrames.front()->getSignal();
+
+    const double fullSignal = measureNanoseconds(repetitions * 64, [&]() {
+        accumulator += interferer;
+        accumulator -= interferer;
+    });
+    const double dataInterval = measureNanoseconds(repetitions * 64, [&]() {
+        accumulator.addInRange(interferer, signal.getDataStart(), signal.getDataEnd());
+        accumulator.subtractInRange(interferer, signal.getDataStart(), signal.getDataEnd());
+    });
+    double minSinr = 0;
+    const double getMinSinr = measureNanoseconds(repetitions, [&]() {
+        minSinr = SignalUtils::getMinSINR(0, 10, &signalFrame, interfererFrames, 1e-9);
+    });
+
+    WARN("Signal +=/-= over all " << spectrum.getNumFreqs() << " values: " << fullSignal << " ns");
+    WARN("Signal addInRange/subtractInRange over data interval: " << dataInterval << " ns");
+    WARN("SignalUtils::getMinSINR with " << interfererFrames.size() << " interferers: " << getMinSinr << " ns");
+
+    REQUIRE(accumulator.getMax() == 0);
+    REQUIRE(minSinr > 0);
+}
@@ -31,6 +31,9 @@
 #include "testutils/Component.h"
 #include "testutils/DummyAnalogueModel.h"
 
+#include <cmath>
+#include <limits>
+
 using namespace veins;
 using AirFrameVector = DeciderToPhyInterface::AirFrameVector;
 
@@ -677,6 +680,60 @@ SCENARIO("Signal Compound Assignment Operators (Two Signals)", "[toolbox]")
     }
 }
 
+SCENARIO("Signal Arithmetic on a Frequency Index Range", "[toolbox]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+    GIVEN("A spectrum with frequencies (1,2,3,4,5,6) and two signals (1,1,1,1,1,1), (1,2,3,4,5,6)")
+    {
+        Spectrum::Frequencies freqs = {1, 2, 3, 4, 5, 6};
+
+        Spectrum spectrum(freqs);
+
+        Signal signal1(spectrum);
+        signal1 = 1;
+
+        Signal signal2(spectrum);
+        for (size_t i = 0; i < signal2.getNumValues(); i++) {
+            signal2.at(i) = i + 1;
+        }
+
+        WHEN("signal2 is added to signal1 in the range [1, 4)")
+        {
+            Signal sum = signal1;
+            sum.addInRange(signal2, 1, 4);
+            THEN("result is (1,3,4,5,1,1)")
+            {
+                REQUIRE(sum.at(0) == 1);
+                REQUIRE(sum.at(1) == 3);
+                REQUIRE(sum.at(2) == 4);
+                REQUIRE(sum.at(3) == 5);
+                REQUIRE(sum.at(4) == 1);
+                REQUIRE(sum.at(5) == 1);
+            }
+            WHEN("signal2 is substracted again in the same range")
+            {
+                sum.subtractInRange(signal2, 1, 4);
+                THEN("result is signal1 again")
+                {
+                    for (size_t i = 0; i < sum.getNumValues(); i++) {
+                        REQUIRE(sum.at(i) == signal1.at(i));
+                    }
+                }
+            }
+        }
+        WHEN("both spectra are created from the same frequencies")
+        {
+            Spectrum spectrumClone(freqs);
+            THEN("signals on both spectra can be combined")
+            {
+                Signal signal3(spectrumClone);
+                signal3 += signal2;
+                REQUIRE(signal3.at(5) == 6);
+            }
+        }
+    }
+}
+
 SCENARIO("Signal Thresholding (smaller)", "[toolbox]")
 {
     DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
@@ -1236,3 +1293,56 @@ SCENARIO("SignalUtils::getMinSINR treats signal start/end as inclusive/exclusive
         }
     }
 }
+
+SCENARIO("SignalUtils SINR deviation caused by the precision of Signal::Value", "[toolbox]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so simtime_t works
+    GIVEN("A signal and eight interferers of widely differing power on a spectrum of 21 frequencies, all overlapping for the whole time")
+    {
+        Spectrum::Frequencies freqs;
+        for (int i = 0; i < 21; i++) {
+            freqs.push_back(5.85e9 + i * 5e6);
+        }
+        Spectrum spectrum(freqs);
+        AnalogueModelList analogueModels;
+        const double noise = 1e-10;
+
+        // powers (in mW) as computed in double, before being stored in Signal::Value
+        auto power = [](int signal, size_t freqIndex) { return 1e-3 * pow(10, -0.7 * signal - 0.01 * freqIndex) * (1 + 0.123456789 * signal); };
+
+        std::vector<AirFrame> frames(9);
+        AirFrameVector interfererFrames;
+        for (int f = 0; f < 9; f++) {
+            Signal signal(spectrum);
+            for (size_t i = 0; i < spectrum.getNumFreqs(); i++) {
+                signal.at(i) = power(f, i);
+            }
+            signal.setDataStart(0);
+            signal.setDataEnd(spectrum.getNumFreqs() - 1);
+            signal.setCenterFrequencyIndex(10);
+            signal.setAnalogueModelList(&analogueModels);
+            signal.setTiming(5, 10);
+            frames[f].setSignal(signal);
+            if (f > 0) interfererFrames.push_back(&frames[f]);
+        }
+
+        WHEN("the min SINR is evaluated")
+        {
+            double minSinr = SignalUtils::getMinSINR(5, 15, &frames[0], interfererFrames, noise);
+            THEN("it deviates from the SINR computed in double by no more than a few units of the precision of Signal::Value")
+            {
+                double expected = INFINITY;
+                for (size_t i = 0; i < spectrum.getNumFreqs(); i++) {
+                    double interference = 0;
+                    for (int f = 1; f < 9; f++) {
+                        interference += power(f, i);
+                    }
+                    expected = std::min(expected, power(0, i) / (interference + noise));
+                }
+                const double deviation = std::abs(minSinr - expected) / expected;
+                INFO("relative SINR deviation is " << deviation);
+                REQUIRE(deviation <= 4 * std::numeric_limits<Signal::Value>::epsilon());
+            }
+        }
+    }
+}
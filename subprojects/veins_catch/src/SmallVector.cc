@@ -0,0 +1,107 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "veins/base/utils/SmallVector.h"
+
+using veins::SmallVector;
+
+SCENARIO("SmallVector storage", "[toolbox]")
+{
+    GIVEN("A SmallVector with inline capacity 4 holding three values")
+    {
+        SmallVector<double, 4> small(3, 1.5);
+
+        THEN("the values are stored inline and initialized")
+        {
+            REQUIRE(small.size() == 3);
+            REQUIRE(small.isInline());
+            for (auto value : small) {
+                REQUIRE(value == 1.5);
+            }
+        }
+        THEN("accessing an index out of range raises an error")
+        {
+            REQUIRE_THROWS_AS(small.at(3), std::out_of_range);
+        }
+        WHEN("it is copied")
+        {
+            SmallVector<double, 4> copy(small);
+            copy.at(0) = 2;
+            THEN("the copy is stored inline and independent of the original")
+            {
+                REQUIRE(copy.isInline());
+                REQUIRE(copy.at(0) == 2);
+                REQUIRE(small.at(0) == 1.5);
+            }
+        }
+    }
+    GIVEN("A SmallVector with inline capacity 4 holding six values")
+    {
+        SmallVector<double, 4> large(6, 0);
+        for (size_t i = 0; i < large.size(); i++) {
+            large[i] = i;
+        }
+
+        THEN("the values are stored on the heap")
+        {
+            REQUIRE(large.size() == 6);
+            REQUIRE(!large.isInline());
+            REQUIRE(large.at(5) == 5);
+        }
+        WHEN("it is copied")
+        {
+            SmallVector<double, 4> copy;
+            copy = large;
+            THEN("the copy owns its own values")
+            {
+                REQUIRE(copy.size() == 6);
+                REQUIRE(copy.data() != large.data());
+                REQUIRE(copy.at(5) == 5);
+            }
+        }
+        WHEN("it is moved")
+        {
+            const double* values = large.data();
+            SmallVector<double, 4> moved(std::move(large));
+            THEN("the values are taken over without copying")
+            {
+                REQUIRE(moved.data() == values);
+                REQUIRE(moved.size() == 6);
+            }
+        }
+        WHEN("a small one is assigned to it")
+        {
+            large = SmallVector<double, 4>(2, 3);
+            THEN("the values are stored inline again")
+            {
+                REQUIRE(large.isInline());
+                REQUIRE(large.size() == 2);
+                REQUIRE(large.at(1) == 3);
+            }
+        }
+    }
+}
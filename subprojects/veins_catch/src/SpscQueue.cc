@@ -0,0 +1,133 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <string>
+#include <thread>
+
+#include "veins/base/utils/SpscQueue.h"
+
+using veins::SpscQueue;
+
+SCENARIO("SpscQueue", "[spscqueue]")
+{
+    GIVEN("A SpscQueue with a capacity of 2")
+    {
+        SpscQueue<std::string> queue(2);
+
+        WHEN("it is filled")
+        {
+            std::string a = "a";
+            std::string b = "b";
+            std::string c = "c";
+            REQUIRE(queue.tryPush(a));
+            REQUIRE(queue.tryPush(b));
+
+            THEN("further pushes fail without touching the value")
+            {
+                REQUIRE_FALSE(queue.tryPush(c));
+                REQUIRE(c == "c");
+            }
+
+            THEN("elements come out in order, and the queue ends up empty")
+            {
+                std::string out;
+                REQUIRE(queue.tryPop(out));
+                REQUIRE(out == "a");
+                REQUIRE(queue.tryPop(out));
+                REQUIRE(out == "b");
+                REQUIRE(queue.empty());
+                REQUIRE_FALSE(queue.tryPop(out));
+                REQUIRE(out == "b");
+            }
+        }
+
+        WHEN("a string is pushed and popped")
+        {
+            std::string in;
+            in.reserve(1000);
+            const char* storage = in.data();
+            in = "x";
+            std::string out;
+            REQUIRE(queue.tryPush(in));
+            REQUIRE(queue.tryPop(out));
+
+            THEN("its storage is passed on instead of being copied")
+            {
+                REQUIRE(out == "x");
+                REQUIRE(out.data() == storage);
+            }
+        }
+    }
+
+    GIVEN("A SpscQueue with a capacity of 1")
+    {
+        SpscQueue<std::string> queue(1);
+
+        WHEN("the consumer trades in a string for each one it pops")
+        {
+            std::string traded;
+            traded.reserve(1000);
+            const char* storage = traded.data();
+            std::string in = "a";
+            REQUIRE(queue.tryPush(in));
+            REQUIRE(queue.tryPop(traded));
+            in = "b";
+            REQUIRE(queue.tryPush(in));
+            std::string out;
+            REQUIRE(queue.tryPop(out));
+            in = "c";
+            REQUIRE(queue.tryPush(in));
+
+            THEN("the producer gets its storage back once the slot comes round again")
+            {
+                REQUIRE(in.data() == storage);
+            }
+        }
+    }
+
+    GIVEN("A producer thread pushing many numbers through a small queue")
+    {
+        SpscQueue<int> queue(4);
+        const int count = 100000;
+        std::thread producer([&queue]() {
+            for (int i = 0; i < count; ++i) {
+                int value = i;
+                while (!queue.tryPush(value)) std::this_thread::yield();
+            }
+        });
+
+        THEN("the consumer receives all of them in order")
+        {
+            bool inOrder = true;
+            for (int expected = 0; expected < count; ++expected) {
+                int value = -1;
+                while (!queue.tryPop(value)) std::this_thread::yield();
+                if (value != expected) inOrder = false;
+            }
+            producer.join();
+            REQUIRE(inOrder);
+            REQUIRE(queue.empty());
+        }
+    }
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <cmath>
+
+#include "veins/modules/phy/NistErrorRate.h"
+#include "veins/modules/phy/TabulatedErrorRate.h"
+
+using namespace veins;
+
+SCENARIO("TabulatedErrorRate approximates NistErrorRate", "[phy]")
+{
+    GIVEN("All 10 MHz data rates and chunk lengths from a PLCP header to a long frame")
+    {
+        const std::vector<unsigned int> datarates = {3000000, 4500000, 6000000, 9000000, 12000000, 18000000, 24000000, 27000000};
+        const std::vector<uint32_t> chunkLengths = {24, 100, 1000, 8000, 20000};
+
+        WHEN("chunk success rates are looked up for SNRs from -20 dB to 50 dB")
+        {
+            double maxError = 0;
+            for (auto datarate : datarates) {
+                for (auto nbits : chunkLengths) {
+                    for (double snr_dB = -20; snr_dB <= 50; snr_dB += 0.0137) {
+                        const double snr = std::pow(10, snr_dB / 10);
+                        const double exact = NistErrorRate::getChunkSuccessRate(datarate, Bandwidth::ofdm_10_mhz, snr, nbits);
+                        const double tabulated = TabulatedErrorRate::getChunkSuccessRate(datarate, Bandwidth::ofdm_10_mhz, snr, nbits);
+                        maxError = std::max(maxError, std::abs(exact - tabulated));
+                    }
+                }
+            }
+            THEN("the interpolation error stays below 1e-4")
+            {
+                REQUIRE(maxError < 1e-4);
+            }
+        }
+        WHEN("the SNR lies outside of the table")
+        {
+            THEN("the result is the one of NistErrorRate")
+            {
+                REQUIRE(TabulatedErrorRate::getChunkSuccessRate(6000000, Bandwidth::ofdm_10_mhz, 1e-3, 24) == NistErrorRate::getChunkSuccessRate(6000000, Bandwidth::ofdm_10_mhz, 1e-3, 24));
+                REQUIRE(TabulatedErrorRate::getChunkSuccessRate(6000000, Bandwidth::ofdm_10_mhz, 1e5, 1000) == NistErrorRate::getChunkSuccessRate(6000000, Bandwidth::ofdm_10_mhz, 1e5, 1000));
+            }
+        }
+    }
+}
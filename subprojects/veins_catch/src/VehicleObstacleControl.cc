@@ -22,9 +22,13 @@
 
 #include "catch2/catch.hpp"
 
+#include <limits>
+#include <random>
+
 #include "veins/modules/obstacle/VehicleObstacleControl.h"
 #include "veins/base/toolbox/Spectrum.h"
 #include "veins/base/toolbox/Signal.h"
+#include "testutils/AllocationCounter.h"
 #include "testutils/Simulation.h"
 
 using veins::Coord;
@@ -108,4 +112,111 @@ SCENARIO("Using VehicleObstacleControl", "[vehicleObstacles]")
             REQUIRE(r.at(0) == Approx(2 * r_des + r_corr));
         }
     }
+
+    GIVEN("Scratch buffers that have been used for a computation before")
+    {
+        std::vector<std::pair<double, double>> dz_vec = {{0, 5}, {3, 5}, {7, 5}, {10, 5}};
+        Spectrum spectrum({5.88e9, 5.89e9, 5.9e9});
+        std::vector<double> attenuation(spectrum.getNumFreqs());
+        std::vector<size_t> majorObstacles;
+        VehicleObstacleControl::computeVehicleAttenuationDZ(dz_vec, spectrum, attenuation.data(), majorObstacles);
+
+        WHEN("the attenuation is computed again")
+        {
+            AllocationCounter counter;
+            VehicleObstacleControl::computeVehicleAttenuationDZ(dz_vec, spectrum, attenuation.data(), majorObstacles);
+            const size_t allocations = counter.getAllocations();
+
+            THEN("no heap allocations happen and the result matches the Signal based computation")
+            {
+                REQUIRE(allocations == 0);
+                auto r = VehicleObstacleControl::getVehicleAttenuationDZ(dz_vec, Signal(spectrum));
+                for (size_t i = 0; i < spectrum.getNumFreqs(); i++) {
+                    REQUIRE(attenuation[i] == Approx(r.at(i)));
+                }
+            }
+        }
+    }
+
+    GIVEN("An obstacle far below the first Fresnel zone of a link")
+    {
+        std::vector<std::pair<double, double>> dz_vec = {{0, 5}, {50, 1}, {100, 5}};
+        std::vector<std::pair<double, size_t>> significance;
+
+        THEN("Pruning removes it")
+        {
+            VehicleObstacleControl::pruneVehicleObstacles(dz_vec, 0.05, 0, significance);
+            REQUIRE(dz_vec.size() == 2);
+        }
+    }
+
+    GIVEN("Links through a traffic jam")
+    {
+        Spectrum spectrum({5.89e9});
+        const double lambda = 299792458.0 / 5.89e9;
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> gap(4.5, 9);
+        std::uniform_real_distribution<double> carHeight(0.8, 1.6);
+        std::bernoulli_distribution isTruck(0.1);
+
+        std::vector<std::vector<std::pair<double, double>>> links;
+        for (size_t numVehicles = 1; numVehicles < 25; ++numVehicles) {
+            for (int i = 0; i < 10; ++i) {
+                std::vector<std::pair<double, double>> dz_vec = {{0, 1.895}};
+                double x = 0;
+                for (size_t j = 0; j < numVehicles; ++j) {
+                    x += gap(rng);
+                    dz_vec.emplace_back(x, isTruck(rng) ? 3.2 : carHeight(rng));
+                }
+                dz_vec.emplace_back(x + gap(rng), 1.895);
+                links.push_back(dz_vec);
+            }
+        }
+
+        std::vector<size_t> majorObstacles;
+        std::vector<std::pair<double, size_t>> significance;
+        auto attenuation = [&](const std::vector<std::pair<double, double>>& dz_vec) {
+            double attenuation_dB = 0;
+            if (dz_vec.size() > 2) VehicleObstacleControl::computeVehicleAttenuationDZ(dz_vec, spectrum, &attenuation_dB, majorObstacles);
+            return attenuation_dB;
+        };
+
+        WHEN("Only the 5 most significant obstacles are considered")
+        {
+            // beyond 20 dB of loss, links through a jam are lost either way
+            double maxError = 0;
+            for (auto dz_vec : links) {
+                const double exact = attenuation(dz_vec);
+                VehicleObstacleControl::pruneVehicleObstacles(dz_vec, lambda, 5, significance);
+                REQUIRE(dz_vec.size() <= 7);
+                if (exact < 20) maxError = std::max(maxError, std::abs(attenuation(dz_vec) - exact));
+            }
+            WARN("Largest error of attenuation below 20 dB when considering 5 obstacles: " << maxError << " dB");
+
+            THEN("The attenuation stays within 3 dB of the exact model")
+            {
+                REQUIRE(maxError < 3);
+            }
+        }
+
+        WHEN("The computation stops once obstacles attenuate a link by more than 20 dB")
+        {
+            THEN("It only stops for links the full computation attenuates by more than 20 dB")
+            {
+                size_t stopped = 0;
+                for (const auto& dz_vec : links) {
+                    const double exact = attenuation(dz_vec);
+                    double partial_dB = 0;
+                    if (VehicleObstacleControl::computeVehicleAttenuationDZ(dz_vec, spectrum, &partial_dB, majorObstacles, 20)) {
+                        REQUIRE(partial_dB == exact);
+                    }
+                    else {
+                        REQUIRE(exact > 20);
+                        stopped++;
+                    }
+                }
+                REQUIRE(stopped > 0);
+            }
+        }
+    }
 }
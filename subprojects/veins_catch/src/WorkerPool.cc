@@ -0,0 +1,118 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "veins/base/utils/Logging.h"
+#include "veins/base/utils/WorkerPool.h"
+
+using veins::WorkerPool;
+
+SCENARIO("WorkerPool", "[workerpool]")
+{
+    for (size_t numThreads : {0, 1, 4}) {
+        GIVEN("A WorkerPool with " << numThreads << " worker threads")
+        {
+            WorkerPool pool(numThreads);
+
+            THEN("it reports its number of threads")
+            {
+                REQUIRE(pool.getNumThreads() == numThreads);
+            }
+
+            WHEN("running 1000 tasks that each write their own slot, twice")
+            {
+                std::vector<size_t> results(1000, 0);
+                for (int round = 0; round < 2; ++round) {
+                    pool.run(results.size(), [&results](size_t i) { results[i] += i * i; });
+                }
+
+                THEN("every task ran exactly once per round")
+                {
+                    for (size_t i = 0; i < results.size(); ++i) {
+                        REQUIRE(results[i] == 2 * i * i);
+                    }
+                }
+            }
+
+            WHEN("a task throws")
+            {
+                auto runThrowing = [&pool]() {
+                    pool.run(100, [](size_t i) {
+                        if (i == 42) throw std::runtime_error("task failed");
+                    });
+                };
+
+                THEN("the exception is rethrown to the caller")
+                {
+                    REQUIRE_THROWS_AS(runThrowing(), std::runtime_error);
+                }
+
+                THEN("the pool can still be used afterwards")
+                {
+                    REQUIRE_THROWS(runThrowing());
+                    std::vector<int> results(10, 0);
+                    pool.run(results.size(), [&results](size_t i) { results[i] = 1; });
+                    REQUIRE(std::count(results.begin(), results.end(), 1) == 10);
+                }
+            }
+
+            WHEN("tasks record whether they run on a worker thread")
+            {
+                const std::thread::id caller = std::this_thread::get_id();
+                std::vector<char> onWorker(1000);
+                std::vector<char> onCaller(1000);
+                pool.run(onWorker.size(), [&](size_t i) {
+                    onWorker[i] = veins::isWorkerThread();
+                    onCaller[i] = std::this_thread::get_id() == caller;
+                });
+
+                THEN("exactly those not on the calling thread do")
+                {
+                    REQUIRE_FALSE(veins::isWorkerThread());
+                    for (size_t i = 0; i < onWorker.size(); ++i) {
+                        REQUIRE(onWorker[i] != onCaller[i]);
+                    }
+                }
+            }
+
+            WHEN("a task runs tasks of its own on the same pool")
+            {
+                std::vector<size_t> results(100, 0);
+                pool.run(10, [&pool, &results](size_t i) {
+                    pool.run(10, [&results, i](size_t j) { results[i * 10 + j] = i * 10 + j; });
+                });
+
+                THEN("all of them ran exactly once")
+                {
+                    for (size_t i = 0; i < results.size(); ++i) {
+                        REQUIRE(results[i] == i);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Counts the heap allocations (calls of the global operator new) of the calling thread since its construction.
+ *
+ * The counting operator new is defined in AllocationCounter.cc, so it is in effect for all tests of veins_catch.
+ * Tests of hot paths warm up first (so containers reach their steady state size), then assert that repeating
+ * the operation does not allocate.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter()
+        : start(getTotal())
+    {
+    }
+
+    /** @brief Returns the number of allocations of the calling thread since construction. */
+    size_t getAllocations() const
+    {
+        return getTotal() - start;
+    }
+
+    /** @brief Returns the number of allocations of the calling thread since it was started. */
+    static size_t getTotal();
+
+private:
+    size_t start;
+};
@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/connectionManager/BaseConnectionManager.h"
+
+/**
+ * Connection manager connecting nics up to a fixed distance apart (re-checking them after moving by slack), with its grid set up like initialize() would, but without needing parameters or a world utility module
+ */
+class GridConnectionManager : public veins::BaseConnectionManager {
+public:
+    GridConnectionManager(const veins::Coord& playground, double maxDistance, bool useFlatGrid, double slack = 0)
+        : playground(playground)
+        , maxDistance(maxDistance)
+    {
+        playgroundSize = &this->playground;
+        useTorus = false;
+        drawMIR = false;
+        sendDirect = true;
+        this->useFlatGrid = useFlatGrid;
+        useSparseGrid = false;
+        connectOnSend = false;
+        batchPositionUpdates = false;
+        connectionUpdateSlack = slack;
+        maxInterferenceDistance = calcInterfDist();
+        const double connectionDistance = getMaxConnectionDistance();
+        maxDistSquared = connectionDistance * connectionDistance;
+
+        // cells of at least connectionDistance, or a single one if a grid of at most 3x3x3 cells would make all cells neighbours anyway
+        gridDim.x = std::max(1, static_cast<int>(playground.x / connectionDistance));
+        gridDim.y = std::max(1, static_cast<int>(playground.y / connectionDistance));
+        gridDim.z = std::max(1, static_cast<int>(playground.z / connectionDistance));
+        if (gridDim.x <= 3 && gridDim.y <= 3 && gridDim.z <= 3) gridDim.x = gridDim.y = gridDim.z = 1;
+        if (useFlatGrid) {
+            flatGrid.resize(static_cast<size_t>(gridDim.x) * gridDim.y * gridDim.z);
+        }
+        else {
+            nicGrid.assign(gridDim.x, NicMatrix(gridDim.y, RowVector(gridDim.z)));
+        }
+        findDistance = veins::Coord(std::max(playground.x, connectionDistance), std::max(playground.y, connectionDistance), std::max(playground.z, connectionDistance));
+        if (gridDim.x != 1) findDistance.x = playground.x / gridDim.x;
+        if (gridDim.y != 1) findDistance.y = playground.y / gridDim.y;
+        if (gridDim.z != 1) findDistance.z = playground.z / gridDim.z;
+        findDistance += veins::Coord(0.001, 0.001, 0.001);
+    }
+
+    double calcInterfDist() override
+    {
+        return maxDistance;
+    }
+
+    /** @brief Returns the module ids of the nics connected to nic, in ascending order */
+    std::vector<int> getNeighbourIds(const omnetpp::cModule* nic)
+    {
+        std::vector<int> ids;
+        for (const auto& connection : nics.at(nic->getId())->getGateList()) ids.push_back(connection.first->nicId);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+private:
+    const veins::Coord playground;
+    const double maxDistance;
+};
+
+/**
+ * Nic a connection manager can send to directly, being its own host
+ */
+class DummyNic : public omnetpp::cSimpleModule {
+public:
+    DummyNic()
+    {
+        omnetpp::getSimulation()->registerComponent(this);
+        addGate("radioIn", omnetpp::cGate::INPUT);
+    }
+
+    omnetpp::cModule* getParentModule() const override
+    {
+        return const_cast<DummyNic*>(this);
+    }
+};
@@ -0,0 +1,131 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+#pragma once
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "veins/veins.h"
+
+#include "veins/base/phyLayer/AnalogueModel.h"
+#include "veins/base/phyLayer/DeciderToPhyInterface.h"
+#include "veins/base/phyLayer/PhyUtils.h"
+#include "veins/modules/mac/ieee80211p/Mac80211pToPhy11pInterface.h"
+#include "veins/modules/messages/AirFrame11p_m.h"
+#include "veins/modules/phy/Decider80211pToPhy80211pInterface.h"
+
+namespace veins {
+
+/**
+ * Stands in for PhyLayer80211p towards a Decider80211p: keeps the frames on the channel in a list and counts the messages sent to the MAC.
+ */
+class DeciderPhy : public DeciderToPhyInterface, public Decider80211pToPhy80211pInterface {
+public:
+    /** @brief Frames returned by getChannelInfo() (if they intersect the requested interval) */
+    AirFrameVector frames;
+    double noise = 1e-10;
+    double farField = 0;
+    int radioState = Radio::RX;
+    int numChannelBusy = 0;
+    int numChannelIdle = 0;
+    int numSentUp = 0;
+
+    void getChannelInfo(simtime_t_cref from, simtime_t_cref to, AirFrameVector& out) override
+    {
+        for (auto frame : frames) {
+            const Signal& signal = frame->getSignal();
+            if (signal.getReceptionEnd() > from && signal.getReceptionStart() <= to) out.push_back(frame);
+        }
+    }
+
+    double getFarFieldInterference(simtime_t_cref, simtime_t_cref, double) override
+    {
+        return farField;
+    }
+
+    double getNoiseFloorValue() override
+    {
+        return noise;
+    }
+
+    void sendControlMsgToMac(cMessage* msg) override
+    {
+        if (msg->getKind() == Mac80211pToPhy11pInterface::CHANNEL_BUSY) numChannelBusy++;
+        if (msg->getKind() == Mac80211pToPhy11pInterface::CHANNEL_IDLE) numChannelIdle++;
+        delete msg;
+    }
+
+    cMessage* createControlMsg(const char* name, short kind) override
+    {
+        return new cMessage(name, kind);
+    }
+
+    void sendUp(AirFrame*, DeciderResult* result) override
+    {
+        numSentUp++;
+        delete result;
+    }
+
+    BaseWorldUtility* getWorldUtility() override
+    {
+        return nullptr;
+    }
+
+    void recordScalar(const char*, double, const char*) override
+    {
+    }
+
+    int getCurrentRadioChannel() override
+    {
+        return 0;
+    }
+
+    int getRadioState() override
+    {
+        return radioState;
+    }
+};
+
+/**
+ * Returns a frame with the same power on each of the 5 values of a 10 MHz channel at 5.89 GHz (the middle 3 carrying data), owned by the caller.
+ */
+inline std::unique_ptr<AirFrame11p> createAirFrame11p(simtime_t start, simtime_t duration, double power)
+{
+    // kept alive for all frames, as signals only point to their analogue models
+    static AnalogueModelList noAnalogueModels;
+
+    const double center = 5.89e9;
+    Signal signal(Spectrum({center - 10e6, center - 5e6, center, center + 5e6, center + 10e6}), start, duration);
+    for (size_t i = 0; i < 5; i++) signal.at(i) = power;
+    signal.setDataStart(1);
+    signal.setDataEnd(3);
+    signal.setCenterFrequencyIndex(2);
+    signal.setAnalogueModelList(&noAnalogueModels);
+
+    std::unique_ptr<AirFrame11p> frame(new AirFrame11p());
+    frame->setSignal(signal);
+    frame->setDuration(duration);
+    return frame;
+}
+
+} // namespace veins
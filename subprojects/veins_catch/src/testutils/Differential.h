@@ -0,0 +1,210 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Deviations of an optimised implementation from its reference implementation, collected over many inputs.
+ *
+ * A value is within tolerance if it deviates from the reference by at most absoluteTolerance or by at most relativeTolerance
+ * times the magnitude of the reference (like Catch's Approx with margin and epsilon). NaNs only match NaNs.
+ * Print a Deviation (e.g., with INFO) to see the maximum deviations and the worst input when a check fails.
+ */
+class Deviation {
+public:
+    Deviation(double absoluteTolerance = 0, double relativeTolerance = 0)
+        : absoluteTolerance(absoluteTolerance)
+        , relativeTolerance(relativeTolerance)
+    {
+    }
+
+    /** @brief Adds the results of both implementations for the next input. */
+    void add(double reference, double optimised)
+    {
+        double absolute = std::abs(optimised - reference);
+        double relative = reference != 0 ? absolute / std::abs(reference) : (absolute != 0 ? std::numeric_limits<double>::infinity() : 0);
+        if (std::isnan(reference) || std::isnan(optimised)) {
+            absolute = relative = (std::isnan(reference) && std::isnan(optimised)) ? 0 : std::numeric_limits<double>::infinity();
+        }
+        else if (reference == optimised) {
+            // also covers infinities of the same sign
+            absolute = relative = 0;
+        }
+
+        const bool within = absolute <= absoluteTolerance || relative <= relativeTolerance;
+        if (!within) {
+            if (numOutside == 0 || absolute > worstOutsideAbsolute) {
+                worstIndex = count;
+                worstReference = reference;
+                worstOptimised = optimised;
+                worstOutsideAbsolute = absolute;
+            }
+            ++numOutside;
+        }
+        if (absolute > maxAbsolute) maxAbsolute = absolute;
+        if (relative > maxRelative) maxRelative = relative;
+        ++count;
+    }
+
+    /** @brief Returns whether all values added so far are within tolerance. */
+    bool isWithinTolerance() const
+    {
+        return numOutside == 0;
+    }
+
+    double getMaxAbsolute() const
+    {
+        return maxAbsolute;
+    }
+
+    double getMaxRelative() const
+    {
+        return maxRelative;
+    }
+
+    size_t getCount() const
+    {
+        return count;
+    }
+
+    size_t getNumOutside() const
+    {
+        return numOutside;
+    }
+
+    /** @brief Returns the index of the input (in the order of add()) deviating most among those outside tolerance. */
+    size_t getWorstIndex() const
+    {
+        return worstIndex;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Deviation& d)
+    {
+        os << d.count << " values, max absolute deviation " << d.maxAbsolute << ", max relative deviation " << d.maxRelative;
+        if (d.numOutside > 0) {
+            os << ", " << d.numOutside << " outside tolerance (worst: input " << d.worstIndex << ", reference " << d.worstReference << ", optimised " << d.worstOptimised << ")";
+        }
+        return os;
+    }
+
+private:
+    double absoluteTolerance;
+    double relativeTolerance;
+    double maxAbsolute = 0;
+    double maxRelative = 0;
+    size_t count = 0;
+    size_t numOutside = 0;
+    size_t worstIndex = 0;
+    double worstReference = 0;
+    double worstOptimised = 0;
+    double worstOutsideAbsolute = 0;
+};
+
+/**
+ * Reproducible random inputs for differential tests: a generator with a fixed seed, so failures can be replayed.
+ */
+class DifferentialInputs {
+public:
+    explicit DifferentialInputs(uint64_t seed = 1)
+        : generator(seed)
+    {
+    }
+
+    /** @brief Returns a number drawn uniformly from [a, b). */
+    double uniform(double a, double b)
+    {
+        return std::uniform_real_distribution<double>(a, b)(generator);
+    }
+
+    /** @brief Returns a number drawn from [a, b) (both positive) with a uniformly distributed logarithm, e.g., for powers spanning many decades. */
+    double logUniform(double a, double b)
+    {
+        return std::exp(uniform(std::log(a), std::log(b)));
+    }
+
+    /** @brief Returns an integer drawn uniformly from [a, b]. */
+    long integer(long a, long b)
+    {
+        return std::uniform_int_distribution<long>(a, b)(generator);
+    }
+
+    /** @brief Returns count inputs made by calling make(*this). */
+    template <typename Make>
+    auto generate(size_t count, Make make) -> std::vector<decltype(make(*this))>
+    {
+        std::vector<decltype(make(*this))> inputs;
+        inputs.reserve(count);
+        for (size_t i = 0; i < count; ++i) inputs.push_back(make(*this));
+        return inputs;
+    }
+
+private:
+    std::mt19937_64 generator;
+};
+
+/**
+ * Runs the reference and the optimised implementation (both taking an input and returning a double) on all inputs side by side.
+ */
+template <typename Input, typename Reference, typename Optimised>
+Deviation compareImplementations(const std::vector<Input>& inputs, Reference reference, Optimised optimised, double absoluteTolerance, double relativeTolerance)
+{
+    Deviation deviation(absoluteTolerance, relativeTolerance);
+    for (const Input& input : inputs) {
+        deviation.add(reference(input), optimised(input));
+    }
+    return deviation;
+}
+
+/**
+ * Reads recorded inputs from a text file: one input per line, made of numbers separated by whitespace or commas.
+ * Empty lines and lines starting with '#' are skipped.
+ */
+inline std::vector<std::vector<double>> readRecordedInputs(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("cannot open recorded inputs " + path);
+    std::vector<std::vector<double>> inputs;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        for (char& c : line) {
+            if (c == ',') c = ' ';
+        }
+        std::istringstream values(line);
+        std::vector<double> input;
+        double value;
+        while (values >> value) input.push_back(value);
+        if (!input.empty()) inputs.push_back(std::move(input));
+    }
+    return inputs;
+}
@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/mobility/traci/TraCIBuffer.h"
+
+/**
+ * Minimal TraCI server on a unix domain socket (so POSIX only).
+ *
+ * Answers the first message it receives with a canned response, then waits for the client to hang up.
+ * Connect to it with TraCIConnection::connect(owner, server.getHost().c_str(), 0).
+ */
+class FakeTraCIServer {
+public:
+    FakeTraCIServer()
+        : path("/tmp/veins_catch_traci_" + std::to_string(::getpid()) + "_" + std::to_string(nextId()++) + ".sock")
+    {
+        listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        REQUIRE(listenSocket >= 0);
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        ::unlink(path.c_str());
+        REQUIRE(::bind(listenSocket, (sockaddr*) &address, sizeof(address)) == 0);
+        REQUIRE(::listen(listenSocket, 1) == 0);
+    }
+    ~FakeTraCIServer()
+    {
+        join();
+        ::close(listenSocket);
+        ::unlink(path.c_str());
+    }
+
+    /**
+     * accepts a client in the background and answers its first message with response (a message without its length)
+     */
+    void serve(std::string response)
+    {
+        thread = std::thread([this, response]() {
+            int client = ::accept(listenSocket, nullptr, nullptr);
+            if (client < 0) return;
+            std::string length(sizeof(uint32_t), '\0');
+            if (readFully(client, &length[0], length.size())) {
+                uint32_t messageLength;
+                veins::TraCIBuffer(length) >> messageLength;
+                request = length + std::string(messageLength - sizeof(uint32_t), '\0');
+                if (readFully(client, &request[sizeof(uint32_t)], request.size() - sizeof(uint32_t))) {
+                    veins::TraCIBuffer message;
+                    message << static_cast<uint32_t>(sizeof(uint32_t) + response.size());
+                    std::string bytes = message.str() + response;
+                    for (size_t sent = 0; sent < bytes.size();) {
+                        ssize_t written = ::write(client, bytes.data() + sent, bytes.size() - sent);
+                        if (written <= 0) break;
+                        sent += written;
+                    }
+                }
+                char buf[4096];
+                while (::read(client, buf, sizeof(buf)) > 0) {
+                }
+            }
+            ::close(client);
+        });
+    }
+
+    /**
+     * waits for the client to hang up
+     */
+    void join()
+    {
+        if (thread.joinable()) thread.join();
+    }
+
+    /**
+     * returns the first message received (including its length), valid after join()
+     */
+    const std::string& getRequest() const
+    {
+        return request;
+    }
+
+    std::string getHost() const
+    {
+        return "unix:" + path;
+    }
+
+private:
+    static bool readFully(int socket, char* buf, size_t length)
+    {
+        for (size_t received = 0; received < length;) {
+            ssize_t n = ::read(socket, buf + received, length - received);
+            if (n <= 0) return false;
+            received += n;
+        }
+        return true;
+    }
+
+    static int& nextId()
+    {
+        static int id = 0;
+        return id;
+    }
+
+    std::string path;
+    int listenSocket;
+    std::thread thread;
+    std::string request;
+};
@@ -0,0 +1,67 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/mobility/traci/SumoNetwork.h"
+
+using veins::SumoNetwork;
+
+SCENARIO("SumoNetwork parses shapes of SUMO network files", "[traci]")
+{
+    GIVEN("A shape of two points")
+    {
+        auto shape = SumoNetwork::parseShape("1.50,-2.00 100,200.25");
+        THEN("both points are read")
+        {
+            REQUIRE(shape.size() == 2);
+            REQUIRE(shape[0].x == Approx(1.5));
+            REQUIRE(shape[0].y == Approx(-2));
+            REQUIRE(shape[1].x == Approx(100));
+            REQUIRE(shape[1].y == Approx(200.25));
+        }
+    }
+    GIVEN("A three-dimensional shape")
+    {
+        auto shape = SumoNetwork::parseShape("1,2,3 4,5,6");
+        THEN("the z component is ignored")
+        {
+            REQUIRE(shape.size() == 2);
+            REQUIRE(shape[1].x == Approx(4));
+            REQUIRE(shape[1].y == Approx(5));
+        }
+    }
+    GIVEN("An empty shape")
+    {
+        THEN("no points are read")
+        {
+            REQUIRE(SumoNetwork::parseShape("").empty());
+        }
+    }
+    GIVEN("A malformed shape")
+    {
+        THEN("parsing fails")
+        {
+            REQUIRE_THROWS(SumoNetwork::parseShape("1;2 3,4"));
+        }
+    }
+}
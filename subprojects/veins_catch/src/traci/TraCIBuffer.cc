@@ -0,0 +1,162 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins/modules/mobility/traci/TraCIBuffer.h"
+
+using veins::TraCIBuffer;
+
+SCENARIO("TraCIBuffer uses network byte order", "[traci]")
+{
+    GIVEN("A buffer holding an integer and a string")
+    {
+        TraCIBuffer buf;
+        buf << static_cast<uint32_t>(0x01020304) << std::string("veh0");
+
+        THEN("The bytes are stored big-endian and length-prefixed")
+        {
+            REQUIRE(buf.str() == std::string("\x01\x02\x03\x04\x00\x00\x00\x04veh0", 12));
+        }
+        THEN("Reading returns the values written")
+        {
+            REQUIRE(buf.read<uint32_t>() == 0x01020304);
+            REQUIRE(buf.read<std::string>() == "veh0");
+            REQUIRE(buf.eof());
+        }
+    }
+}
+
+SCENARIO("TraCIBuffer reads strings into existing ones", "[traci]")
+{
+    GIVEN("A buffer holding a long and a short string")
+    {
+        TraCIBuffer buf;
+        buf << std::string("a rather long vehicle id, beyond any small string buffer") << std::string("v1");
+
+        WHEN("Both are read into the same string")
+        {
+            std::string id;
+            buf >> id;
+            std::string first = id;
+            size_t capacity = id.capacity();
+            buf >> id;
+
+            THEN("The string holds each one in turn, keeping its storage")
+            {
+                REQUIRE(first == "a rather long vehicle id, beyond any small string buffer");
+                REQUIRE(id == "v1");
+                REQUIRE(id.capacity() == capacity);
+                REQUIRE(buf.eof());
+            }
+        }
+    }
+}
+
+SCENARIO("TraCIBuffer decodes bulk payloads", "[traci]")
+{
+    GIVEN("A buffer holding a string list followed by two doubles")
+    {
+        TraCIBuffer buf;
+        buf << std::list<std::string>{"a", "bc", ""} << 1.5 << -2.25;
+
+        WHEN("The string list is read as a whole")
+        {
+            auto ids = buf.read<std::list<std::string>>();
+            THEN("All elements are recovered")
+            {
+                REQUIRE(ids == std::list<std::string>{"a", "bc", ""});
+            }
+            AND_WHEN("The doubles are read as an array")
+            {
+                double xy[2];
+                buf.readArray(xy, 2);
+                THEN("Both values are recovered and the buffer is exhausted")
+                {
+                    REQUIRE(xy[0] == 1.5);
+                    REQUIRE(xy[1] == -2.25);
+                    REQUIRE(buf.eof());
+                }
+            }
+        }
+        WHEN("The strings are skipped")
+        {
+            REQUIRE(buf.read<uint32_t>() == 3);
+            buf.skipStrings(3);
+            THEN("The doubles follow")
+            {
+                REQUIRE(buf.read<double>() == 1.5);
+            }
+        }
+    }
+    GIVEN("A buffer holding only two bytes")
+    {
+        TraCIBuffer buf(std::string("\x00\x01", 2));
+        THEN("Reading a four-byte value raises an error")
+        {
+            REQUIRE_THROWS(buf.read<uint32_t>());
+        }
+    }
+}
+
+SCENARIO("TraCIBuffer splits a message into commands", "[traci]")
+{
+    GIVEN("A buffer holding a short and an extended-length command")
+    {
+        TraCIBuffer buf;
+        buf << static_cast<uint8_t>(3) << static_cast<uint8_t>(0xa4) << static_cast<uint8_t>(7);
+        buf << static_cast<uint8_t>(0) << static_cast<uint32_t>(7) << static_cast<uint8_t>(0xe4) << static_cast<uint8_t>(8);
+
+        THEN("Each command is returned including its length field")
+        {
+            REQUIRE(buf.readCommand() == std::string("\x03\xa4\x07", 3));
+            REQUIRE(buf.readCommand() == std::string("\x00\x00\x00\x00\x07\xe4\x08", 7));
+            REQUIRE(buf.eof());
+        }
+        WHEN("The commands are read into one reused buffer")
+        {
+            TraCIBuffer command;
+            buf.readCommand(command);
+            uint8_t length;
+            command >> length;
+            command.rewind();
+
+            THEN("The buffer holds each command in turn, starting at its length field")
+            {
+                REQUIRE(length == 3);
+                REQUIRE(command.read<uint8_t>() == 3);
+                buf.readCommand(command);
+                REQUIRE(command.str() == std::string("\x00\x00\x00\x00\x07\xe4\x08", 7));
+                REQUIRE(command.read<uint8_t>() == 0);
+                REQUIRE(buf.eof());
+            }
+        }
+    }
+    GIVEN("A buffer holding a truncated command")
+    {
+        TraCIBuffer buf;
+        buf << static_cast<uint8_t>(5) << static_cast<uint8_t>(0xa4);
+        THEN("Reading it raises an error")
+        {
+            REQUIRE_THROWS(buf.readCommand());
+        }
+    }
+}
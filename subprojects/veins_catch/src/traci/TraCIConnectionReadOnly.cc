@@ -0,0 +1,119 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/mobility/traci/TraCIConnection.h"
+#include "veins/modules/mobility/traci/TraCIConstants.h"
+
+using namespace veins;
+using namespace veins::TraCIConstants;
+
+TEST_CASE("TraCIConnection::isWriteCommand", "[traci]")
+{
+    REQUIRE(TraCIConnection::isWriteCommand(CMD_LOAD));
+    REQUIRE(TraCIConnection::isWriteCommand(CMD_SETORDER));
+    REQUIRE(TraCIConnection::isWriteCommand(CMD_SET_TL_VARIABLE));
+    REQUIRE(TraCIConnection::isWriteCommand(CMD_SET_VEHICLE_VARIABLE));
+    REQUIRE(TraCIConnection::isWriteCommand(CMD_SET_POLYGON_VARIABLE));
+    REQUIRE(TraCIConnection::isWriteCommand(CMD_SET_PERSON_VARIABLE));
+
+    REQUIRE_FALSE(TraCIConnection::isWriteCommand(CMD_GETVERSION));
+    REQUIRE_FALSE(TraCIConnection::isWriteCommand(CMD_SIMSTEP));
+    REQUIRE_FALSE(TraCIConnection::isWriteCommand(CMD_CLOSE));
+    REQUIRE_FALSE(TraCIConnection::isWriteCommand(CMD_GET_SIM_VARIABLE));
+    REQUIRE_FALSE(TraCIConnection::isWriteCommand(CMD_GET_VEHICLE_VARIABLE));
+    REQUIRE_FALSE(TraCIConnection::isWriteCommand(CMD_SUBSCRIBE_VEHICLE_VARIABLE));
+}
+
+#if !defined(_WIN32) && !defined(__WIN32__) && !defined(WIN32) && !defined(__CYGWIN__) && !defined(_WIN64)
+
+#include <memory>
+
+#include "testutils/FakeTraCIServer.h"
+#include "testutils/Simulation.h"
+
+namespace {
+
+/**
+ * builds the response to a command that has no result beyond its status
+ */
+std::string makeStatusResponse(uint8_t commandId)
+{
+    TraCIBuffer buf;
+    buf << static_cast<uint8_t>(1 + 1 + 1 + sizeof(uint32_t)) << commandId << RTYPE_OK << std::string("");
+    return buf.str();
+}
+
+/**
+ * returns the id of the first command in a message received by FakeTraCIServer
+ */
+uint8_t getFirstCommandId(const std::string& request)
+{
+    REQUIRE(request.size() > sizeof(uint32_t) + 1);
+    return static_cast<uint8_t>(request[sizeof(uint32_t) + 1]);
+}
+
+} // namespace
+
+SCENARIO("A read-only TraCIConnection refuses write commands before sending them", "[traci]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so logging works
+
+    GIVEN("A read-only connection")
+    {
+        FakeTraCIServer server;
+        server.serve(makeStatusResponse(CMD_GET_SIM_VARIABLE));
+        std::unique_ptr<TraCIConnection> connection(TraCIConnection::connect(nullptr, server.getHost().c_str(), 0));
+        connection->setReadOnly(true);
+
+        THEN("write commands fail, whichever way they are sent, and the server receives only the next read command")
+        {
+            REQUIRE_THROWS(connection->query(CMD_SET_POLYGON_VARIABLE));
+            REQUIRE_THROWS(connection->queueQuery(CMD_SET_VEHICLE_VARIABLE, TraCIBuffer(), 1));
+            REQUIRE_THROWS(connection->sendPending(CMD_LOAD));
+            REQUIRE_FALSE(connection->hasPending());
+
+            connection->query(CMD_GET_SIM_VARIABLE);
+            connection.reset();
+            server.join();
+            REQUIRE(getFirstCommandId(server.getRequest()) == CMD_GET_SIM_VARIABLE);
+        }
+    }
+
+    GIVEN("A connection that is not read-only")
+    {
+        FakeTraCIServer server;
+        server.serve(makeStatusResponse(CMD_SET_POLYGON_VARIABLE));
+        std::unique_ptr<TraCIConnection> connection(TraCIConnection::connect(nullptr, server.getHost().c_str(), 0));
+
+        THEN("write commands are sent")
+        {
+            connection->query(CMD_SET_POLYGON_VARIABLE);
+            connection.reset();
+            server.join();
+            REQUIRE(getFirstCommandId(server.getRequest()) == CMD_SET_POLYGON_VARIABLE);
+        }
+    }
+}
+
+#endif
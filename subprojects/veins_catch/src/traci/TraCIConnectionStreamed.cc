@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#if !defined(_WIN32) && !defined(__WIN32__) && !defined(WIN32) && !defined(__CYGWIN__) && !defined(_WIN64)
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "testutils/FakeTraCIServer.h"
+#include "testutils/Simulation.h"
+
+#include "veins/modules/mobility/traci/TraCIConnection.h"
+#include "veins/modules/mobility/traci/TraCIConstants.h"
+
+using namespace veins;
+using namespace veins::TraCIConstants;
+
+namespace {
+
+/**
+ * builds the response to a simulation step holding count one-byte subscription responses, the i-th carrying i % 256
+ */
+std::string makeStepResponse(uint32_t count)
+{
+    TraCIBuffer buf;
+    buf << static_cast<uint8_t>(1 + 1 + 1 + sizeof(uint32_t)) << CMD_SIMSTEP << RTYPE_OK << std::string("");
+    buf << count;
+    for (uint32_t i = 0; i < count; ++i) {
+        buf << static_cast<uint8_t>(3) << RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE << static_cast<uint8_t>(i % 256);
+    }
+    return buf.str();
+}
+
+} // namespace
+
+SCENARIO("TraCIConnection streams the commands of a response", "[traci]")
+{
+    DummySimulation ds(new cNullEnvir(0, nullptr, nullptr)); // necessary so logging works
+
+    GIVEN("A server answering a simulation step with more commands than the stream queue holds")
+    {
+        const uint32_t count = 3000;
+        FakeTraCIServer server;
+        server.serve(makeStepResponse(count));
+        std::unique_ptr<TraCIConnection> connection(TraCIConnection::connect(nullptr, server.getHost().c_str(), 0));
+        connection->sendPending(CMD_SIMSTEP);
+        REQUIRE(connection->receivePendingStreamed() == count);
+
+        THEN("all commands are handed out in order")
+        {
+            TraCIBuffer command;
+            uint32_t i = 0;
+            while (connection->nextStreamedCommand(command)) {
+                uint8_t length;
+                uint8_t commandId;
+                uint8_t value;
+                command >> length >> commandId >> value;
+                REQUIRE(commandId == RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE);
+                REQUIRE(value == i % 256);
+                ++i;
+            }
+            REQUIRE(i == count);
+        }
+        THEN("the connection can be destroyed while the queue is full")
+        {
+            TraCIBuffer command;
+            REQUIRE(connection->nextStreamedCommand(command));
+            // give the I/O thread time to fill the queue and block on it
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            connection.reset();
+            SUCCEED("the I/O thread stopped");
+        }
+    }
+}
+
+#endif
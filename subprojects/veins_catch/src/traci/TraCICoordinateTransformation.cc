@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //
 
+#include <vector>
+
 #include "catch2/catch.hpp"
 #include "veins/modules/mobility/traci/TraCICoord.h"
 #include "veins/modules/mobility/traci/TraCICoordinateTransformation.h"
@@ -100,3 +102,53 @@ SCENARIO("TraCICoordinateTransformation correctly translates for Erlangen bounda
         }
     }
 }
+
+SCENARIO("TraCICoordinateTransformation converts arrays like single values", "[netbound]")
+{
+    GIVEN("The boundaries from the Erlangen scenario and a few coordinates and headings")
+    {
+        TraCICoordinateTransformation nb{{644465.09, 5491786.25}, {647071.55, 5494795.98}, 25};
+        std::vector<TraCICoord> traciCoords = {{646854.991, 5493242.54}, {644465.09, 5491786.25}, {647071.55, 5494795.98}, {645000.5, 5492000.25}};
+        std::vector<double> xy;
+        for (const auto& coord : traciCoords) {
+            xy.push_back(coord.x);
+            xy.push_back(coord.y);
+        }
+        std::vector<OmnetCoord> omnetCoords = {{2414.90142, 1578.44161}, {0, 0}, {25, 25}, {1000.125, 3000.5}};
+        std::vector<double> traciHeadings = {-114.542, 0, 90, 179.5, -180, 359};
+
+        THEN("traci coords translate to the same omnet coords")
+        {
+            std::vector<OmnetCoord> result(traciCoords.size());
+            nb.traci2omnet(traciCoords.data(), traciCoords.size(), result.data());
+            for (size_t i = 0; i < traciCoords.size(); ++i) {
+                REQUIRE(result[i] == nb.traci2omnet(traciCoords[i]));
+            }
+        }
+        THEN("interleaved traci coords translate to the same omnet coords")
+        {
+            std::vector<OmnetCoord> result(traciCoords.size());
+            nb.traci2omnet(xy.data(), traciCoords.size(), result.data());
+            for (size_t i = 0; i < traciCoords.size(); ++i) {
+                REQUIRE(result[i] == nb.traci2omnet(traciCoords[i]));
+            }
+        }
+        THEN("omnet coords translate to the same traci coords")
+        {
+            std::vector<TraCICoord> result(omnetCoords.size());
+            nb.omnet2traci(omnetCoords.data(), omnetCoords.size(), result.data());
+            for (size_t i = 0; i < omnetCoords.size(); ++i) {
+                REQUIRE(result[i].x == nb.omnet2traci(omnetCoords[i]).x);
+                REQUIRE(result[i].y == nb.omnet2traci(omnetCoords[i]).y);
+            }
+        }
+        THEN("traci headings translate to the same omnet headings")
+        {
+            std::vector<Heading> result(traciHeadings.size(), Heading(0));
+            nb.traci2omnetHeading(traciHeadings.data(), traciHeadings.size(), result.data());
+            for (size_t i = 0; i < traciHeadings.size(); ++i) {
+                REQUIRE(result[i].getRad() == nb.traci2omnetHeading(traciHeadings[i]).getRad());
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/mobility/traci/TraCIBuffer.h"
+#include "veins/modules/mobility/traci/TraCIConstants.h"
+#include "veins/modules/mobility/traci/TraCIDetectorStates.h"
+
+using namespace veins::TraCIConstants;
+using veins::TraCIBuffer;
+using veins::TraCIDetectorStates;
+
+namespace {
+
+TraCIBuffer laneAreaResult(int32_t vehicles, int32_t halting, double speed, double occupancy, double jam)
+{
+    TraCIBuffer buf;
+    buf << static_cast<uint8_t>(5);
+    buf << LAST_STEP_VEHICLE_NUMBER << RTYPE_OK << TYPE_INTEGER << vehicles;
+    buf << LAST_STEP_VEHICLE_HALTING_NUMBER << RTYPE_OK << TYPE_INTEGER << halting;
+    buf << LAST_STEP_MEAN_SPEED << RTYPE_OK << TYPE_DOUBLE << speed;
+    buf << LAST_STEP_OCCUPANCY << RTYPE_OK << TYPE_DOUBLE << occupancy;
+    buf << JAM_LENGTH_METERS << RTYPE_OK << TYPE_DOUBLE << jam;
+    return buf;
+}
+
+} // namespace
+
+SCENARIO("TraCIDetectorStates keeps the latest detector values", "[traci]")
+{
+    GIVEN("A table with a lane area detector and an induction loop")
+    {
+        TraCIDetectorStates states;
+        size_t e2 = states.add("e2_0", TraCIDetectorStates::Kind::LANE_AREA);
+        size_t e1 = states.add("e1_0", TraCIDetectorStates::Kind::INDUCTION_LOOP);
+        THEN("Both can be found by id and index")
+        {
+            REQUIRE(states.size() == 2);
+            REQUIRE(states.add("e2_0", TraCIDetectorStates::Kind::LANE_AREA) == e2);
+            REQUIRE(states.indexOf("e1_0") == static_cast<int>(e1));
+            REQUIRE(states.getId(e2) == "e2_0");
+            REQUIRE(states.find("e3_0") == nullptr);
+        }
+        WHEN("A subscription result for the lane area detector is decoded")
+        {
+            TraCIBuffer buf = laneAreaResult(4, 2, 3.5, 40, 21.5);
+            bool changed = states.update("e2_0", buf);
+            THEN("Its values are stored and reported as changed")
+            {
+                REQUIRE(changed);
+                REQUIRE(buf.eof());
+                const TraCIDetectorStates::State& state = states.get(e2);
+                REQUIRE(state.vehicleNumber == 4);
+                REQUIRE(state.haltingNumber == 2);
+                REQUIRE(state.meanSpeed == 3.5);
+                REQUIRE(state.occupancy == 40);
+                REQUIRE(state.jamLength == 21.5);
+            }
+            THEN("An identical result is not reported as changed")
+            {
+                TraCIBuffer same = laneAreaResult(4, 2, 3.5, 40, 21.5);
+                REQUIRE_FALSE(states.update("e2_0", same));
+            }
+        }
+        WHEN("An induction loop result only advances the time since detection")
+        {
+            TraCIBuffer buf;
+            buf << static_cast<uint8_t>(1) << LAST_STEP_TIME_SINCE_DETECTION << RTYPE_OK << TYPE_DOUBLE << 7.0;
+            THEN("It is stored but not reported as changed")
+            {
+                REQUIRE_FALSE(states.update("e1_0", buf));
+                REQUIRE(states.find("e1_0")->timeSinceDetection == 7.0);
+            }
+        }
+        WHEN("A result for an unknown detector is decoded")
+        {
+            TraCIBuffer buf = laneAreaResult(1, 0, 1, 1, 0);
+            THEN("Decoding throws")
+            {
+                REQUIRE_THROWS(states.update("e2_1", buf));
+            }
+        }
+    }
+}
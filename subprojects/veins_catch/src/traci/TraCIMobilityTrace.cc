@@ -0,0 +1,116 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "veins/modules/mobility/traci/TraCIMobilityTrace.h"
+
+using veins::TraCICoord;
+using veins::TraCIMobilityTraceReader;
+using veins::TraCIMobilityTraceStep;
+using veins::TraCIMobilityTraceVehicle;
+using veins::TraCIMobilityTraceWriter;
+
+namespace {
+
+TraCIMobilityTraceVehicle makeVehicle(std::string id, std::string typeId, double x, double y, std::string edge)
+{
+    TraCIMobilityTraceVehicle vehicle;
+    vehicle.id = id;
+    vehicle.typeId = typeId;
+    vehicle.position = TraCICoord(x, y);
+    vehicle.edge = edge;
+    vehicle.speed = 13.5;
+    vehicle.angle = 90;
+    vehicle.signals = 8;
+    vehicle.length = 5;
+    vehicle.height = 1.5;
+    vehicle.width = 1.8;
+    return vehicle;
+}
+
+} // namespace
+
+SCENARIO("TraCIMobilityTrace replays what was recorded", "[traci]")
+{
+    GIVEN("A trace of two steps")
+    {
+        // create the file right away, so no other process can take its name
+        char fileNameTemplate[] = "TraCIMobilityTrace.test.XXXXXX";
+        const int fd = mkstemp(fileNameTemplate);
+        REQUIRE(fd != -1);
+        close(fd);
+        const std::string fileName = fileNameTemplate;
+        {
+            TraCIMobilityTraceWriter writer(fileName, TraCICoord(-10, -20), TraCICoord(1000, 2000));
+            writer.beginStep(1);
+            writer.addVehicle(makeVehicle("car0", "passenger", 10.004, 20, "e1"));
+            writer.addVehicle(makeVehicle("car1", "bus", 500, 600, "e1"));
+            writer.beginStep(2);
+            REQUIRE(writer.hasVehicle("car0"));
+            writer.addVehicle(makeVehicle("car0", "", 12.5, 19, "e2"));
+            writer.addArrival("car1");
+            REQUIRE_FALSE(writer.hasVehicle("car1"));
+        }
+        TraCIMobilityTraceReader reader(fileName);
+        TraCIMobilityTraceStep step;
+
+        THEN("the network bounds are read")
+        {
+            REQUIRE(reader.getTopLeft().x == Approx(-10));
+            REQUIRE(reader.getBottomRight().y == Approx(2000));
+        }
+        THEN("vehicles are read with their first position")
+        {
+            REQUIRE(reader.readStep(step));
+            REQUIRE(step.time == Approx(1));
+            REQUIRE(step.vehicles.size() == 2);
+            REQUIRE(step.vehicles[0].id == "car0");
+            REQUIRE(step.vehicles[0].typeId == "passenger");
+            REQUIRE(step.vehicles[0].position.x == Approx(10.0));
+            REQUIRE(step.vehicles[0].edge == "e1");
+            REQUIRE(step.vehicles[0].speed == Approx(13.5));
+            REQUIRE(step.vehicles[0].signals == 8);
+            REQUIRE(step.vehicles[1].typeId == "bus");
+            REQUIRE(step.arrived.empty());
+        }
+        THEN("later positions, types, and arrivals are restored")
+        {
+            REQUIRE(reader.readStep(step));
+            REQUIRE(reader.readStep(step));
+            REQUIRE(step.time == Approx(2));
+            REQUIRE(step.vehicles.size() == 1);
+            REQUIRE(step.vehicles[0].typeId == "passenger");
+            REQUIRE(step.vehicles[0].position.x == Approx(12.5));
+            REQUIRE(step.vehicles[0].position.y == Approx(19));
+            REQUIRE(step.vehicles[0].edge == "e2");
+            REQUIRE(step.arrived.size() == 1);
+            REQUIRE(step.arrived[0] == "car1");
+            REQUIRE_FALSE(reader.readStep(step));
+        }
+        std::remove(fileName.c_str());
+    }
+}
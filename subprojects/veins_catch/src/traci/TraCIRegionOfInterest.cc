@@ -0,0 +1,110 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/mobility/traci/TraCIRegionOfInterest.h"
+
+using veins::TraCICoord;
+using veins::TraCIRegionOfInterest;
+
+SCENARIO("TraCIRegionOfInterest checks positions against rectangles and polygons", "[traci]")
+{
+    GIVEN("A region of interest without constraints")
+    {
+        TraCIRegionOfInterest roi;
+        THEN("nothing is part of it")
+        {
+            REQUIRE_FALSE(roi.hasConstraints());
+            REQUIRE_FALSE(roi.onAnyShape(TraCICoord(0, 0)));
+            REQUIRE_FALSE(roi.partOfRoads("hwy1"));
+        }
+    }
+    GIVEN("A region of interest made up of two rectangles and a triangle")
+    {
+        TraCIRegionOfInterest roi;
+        roi.addRectangles("0,0-10,10 20,20-30,30");
+        roi.addPolygons("100,0-200,0-100,100");
+        REQUIRE(roi.hasConstraints());
+        REQUIRE(roi.getRectangles().size() == 2);
+        REQUIRE(roi.getPolygons().size() == 1);
+        THEN("positions on the rectangles are found, including their borders")
+        {
+            REQUIRE(roi.onAnyShape(TraCICoord(5, 5)));
+            REQUIRE(roi.onAnyShape(TraCICoord(10, 10)));
+            REQUIRE(roi.onAnyShape(TraCICoord(25, 20)));
+            REQUIRE(roi.onAnyRectangle(TraCICoord(25, 20)));
+        }
+        THEN("positions inside the triangle are found, but only on polygons")
+        {
+            REQUIRE(roi.onAnyShape(TraCICoord(110, 10)));
+            REQUIRE_FALSE(roi.onAnyRectangle(TraCICoord(110, 10)));
+        }
+        THEN("positions outside all shapes are not found")
+        {
+            REQUIRE_FALSE(roi.onAnyShape(TraCICoord(15, 15)));
+            REQUIRE_FALSE(roi.onAnyShape(TraCICoord(190, 90)));
+            REQUIRE_FALSE(roi.onAnyShape(TraCICoord(-1, 5)));
+            REQUIRE_FALSE(roi.onAnyShape(TraCICoord(250, 5)));
+        }
+        WHEN("the region of interest is cleared")
+        {
+            roi.clear();
+            THEN("nothing is part of it anymore")
+            {
+                REQUIRE_FALSE(roi.hasConstraints());
+                REQUIRE_FALSE(roi.onAnyShape(TraCICoord(5, 5)));
+            }
+        }
+    }
+    GIVEN("A region of interest made up of many small rectangles")
+    {
+        TraCIRegionOfInterest roi;
+        std::string rects;
+        for (int i = 0; i < 400; ++i) {
+            double x = (i % 20) * 100;
+            double y = (i / 20) * 100;
+            rects += (i ? " " : "") + std::to_string(x) + "," + std::to_string(y) + "-" + std::to_string(x + 10) + "," + std::to_string(y + 10);
+        }
+        roi.addRectangles(rects);
+        THEN("exactly the positions on one of them are found")
+        {
+            for (int i = 0; i < 400; ++i) {
+                double x = (i % 20) * 100;
+                double y = (i / 20) * 100;
+                REQUIRE(roi.onAnyShape(TraCICoord(x + 5, y + 5)));
+                REQUIRE_FALSE(roi.onAnyShape(TraCICoord(x + 50, y + 50)));
+            }
+        }
+    }
+    GIVEN("Road constraints")
+    {
+        TraCIRegionOfInterest roi;
+        roi.addRoads("hwy1 hwy2");
+        THEN("only the given roads are part of it")
+        {
+            REQUIRE(roi.partOfRoads("hwy1"));
+            REQUIRE(roi.partOfRoads("hwy2"));
+            REQUIRE_FALSE(roi.partOfRoads("hwy3"));
+        }
+    }
+}
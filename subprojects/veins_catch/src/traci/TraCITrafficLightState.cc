@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+
+#include "veins/modules/world/traci/trafficLight/TraCITrafficLightState.h"
+
+using veins::TraCITrafficLightState;
+
+SCENARIO("TraCITrafficLightState packs signal states", "[traci]")
+{
+    GIVEN("A state string spanning more than one word")
+    {
+        std::string s = "rRgGyYuoOsrRgGyYuoOsGGr";
+        TraCITrafficLightState state(s);
+        THEN("It decodes to the same string")
+        {
+            REQUIRE(state.size() == s.size());
+            REQUIRE(state.str() == s);
+            REQUIRE(state.getLinkState(11) == 'R');
+        }
+        THEN("It equals a state built from the same string")
+        {
+            REQUIRE(state == TraCITrafficLightState(s));
+        }
+        WHEN("A single link changes")
+        {
+            std::string t = s;
+            t[20] = 'y';
+            THEN("The states differ")
+            {
+                REQUIRE(state != TraCITrafficLightState(t));
+            }
+        }
+        WHEN("The state is a prefix of another")
+        {
+            THEN("The states differ")
+            {
+                REQUIRE(state != TraCITrafficLightState(s + "r"));
+            }
+        }
+    }
+    GIVEN("An invalid state string")
+    {
+        THEN("Encoding it throws")
+        {
+            REQUIRE_THROWS(TraCITrafficLightState("rGx"));
+        }
+    }
+}
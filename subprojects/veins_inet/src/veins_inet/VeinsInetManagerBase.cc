@@ -68,9 +68,29 @@ void VeinsInetManagerBase::updateModulePosition(cModule* mod, const Coord& p, co
 {
     TraCIScenarioManager::updateModulePosition(mod, p, edge, speed, heading, signals);
 
-    // update position in VeinsInetMobility
+    // update position in VeinsInetMobility once all vehicles of this step are known, see commitModuleUpdates()
     auto mobilityModules = getSubmodulesOfType<VeinsInetMobility>(mod);
     for (auto inetmm : mobilityModules) {
-        inetmm->nextPosition(inet::Coord(p.x, p.y), edge, speed, heading.getRad());
+        if (numPendingMobilityUpdates == pendingMobilityUpdates.size()) pendingMobilityUpdates.emplace_back();
+        PendingMobilityUpdate& update = pendingMobilityUpdates[numPendingMobilityUpdates++];
+        update.moduleId = inetmm->getId();
+        update.position = inet::Coord(p.x, p.y);
+        update.edge.assign(edge);
+        update.speed = speed;
+        update.angle = heading.getRad();
     }
 }
+
+void VeinsInetManagerBase::commitModuleUpdates()
+{
+    TraCIScenarioManager::commitModuleUpdates();
+
+    for (size_t i = 0; i < numPendingMobilityUpdates; ++i) {
+        const PendingMobilityUpdate& update = pendingMobilityUpdates[i];
+        // the vehicle might have been removed since
+        auto inetmm = dynamic_cast<VeinsInetMobility*>(getSimulation()->getModule(update.moduleId));
+        if (!inetmm) continue;
+        inetmm->nextPosition(update.position, update.edge, update.speed, update.angle);
+    }
+    numPendingMobilityUpdates = 0;
+}
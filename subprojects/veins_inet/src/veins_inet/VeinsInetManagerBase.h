@@ -22,10 +22,13 @@
 
 #pragma once
 
+#include <vector>
+
 #include "veins_inet/veins_inet.h"
 
 #include "veins/modules/mobility/traci/TraCIScenarioManager.h"
 #include "veins/modules/utility/SignalManager.h"
+#include "inet/common/geometry/common/Coord.h"
 
 namespace veins {
 
@@ -48,7 +51,25 @@ public:
     virtual void updateModulePosition(cModule* mod, const Coord& p, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals) override;
 
 protected:
+    /**
+     * @brief Applies the mobility updates of all vehicles of this step to their VeinsInetMobility modules at once.
+     */
+    void commitModuleUpdates() override;
+
+    /**
+     * @brief Update of a VeinsInetMobility module deferred until commitModuleUpdates().
+     */
+    struct PendingMobilityUpdate {
+        int moduleId;
+        inet::Coord position;
+        std::string edge;
+        double speed;
+        double angle;
+    };
+
     SignalManager signalManager;
+    std::vector<PendingMobilityUpdate> pendingMobilityUpdates; /**< only the first numPendingMobilityUpdates are valid; kept to reuse their storage */
+    size_t numPendingMobilityUpdates = 0;
 };
 
 class VEINS_INET_API VeinsInetManagerBaseAccess {
@@ -51,8 +51,8 @@ void VeinsInetMobility::preInitialize(std::string external_id, const inet::Coord
     Enter_Method_Silent();
     this->external_id = external_id;
     lastPosition = position;
-    lastVelocity = inet::Coord(cos(angle), -sin(angle)) * speed;
-    lastOrientation = inet::Quaternion(inet::EulerAngles(rad(-angle), rad(0.0), rad(0.0)));
+    setAngle(angle);
+    lastVelocity = lastDirection * speed;
 }
 
 void VeinsInetMobility::initialize(int stage)
@@ -68,21 +68,32 @@ void VeinsInetMobility::nextPosition(const inet::Coord& position, std::string ro
     Enter_Method_Silent();
 
     lastPosition = position;
-    lastVelocity = inet::Coord(cos(angle), -sin(angle)) * speed;
-    lastOrientation = inet::Quaternion(inet::EulerAngles(rad(-angle), rad(0.0), rad(0.0)));
-
-    // Update display string to show node is getting updates
-    auto hostMod = getParentModule();
-    if (std::string(hostMod->getDisplayString().getTagArg("veins", 0)) == ". ") {
-        hostMod->getDisplayString().setTagArg("veins", 0, " .");
-    }
-    else {
-        hostMod->getDisplayString().setTagArg("veins", 0, ". ");
+    setAngle(angle);
+    lastVelocity = lastDirection * speed;
+
+    // Update display string to show node is getting updates (only to be seen in a GUI)
+    if (hasGUI()) {
+        auto hostMod = getParentModule();
+        if (std::string(hostMod->getDisplayString().getTagArg("veins", 0)) == ". ") {
+            hostMod->getDisplayString().setTagArg("veins", 0, " .");
+        }
+        else {
+            hostMod->getDisplayString().setTagArg("veins", 0, ". ");
+        }
     }
 
     emitMobilityStateChangedSignal();
 }
 
+void VeinsInetMobility::setAngle(double angle)
+{
+    // vehicles mostly go straight, so most updates can skip the trigonometry
+    if (angle == lastAngle) return;
+    lastAngle = angle;
+    lastDirection = inet::Coord(cos(angle), -sin(angle));
+    lastOrientation = inet::Quaternion(inet::EulerAngles(rad(-angle), rad(0.0), rad(0.0)));
+}
+
 #if INET_VERSION >= 0x0403
 const inet::Coord& VeinsInetMobility::getCurrentPosition()
 {
@@ -31,6 +31,8 @@ namespace omnetpp {
 }
 using namespace omnetpp;
 
+#include <limits>
+
 #include "inet/mobility/base/MobilityBase.h"
 
 #include "veins_inet/veins_inet.h"
@@ -84,6 +86,15 @@ protected:
     /** @brief The last angular velocity that was set by nextPosition(). */
     inet::Quaternion lastAngularVelocity;
 
+    /** @brief The angle (in rad) lastOrientation and lastDirection were computed for. */
+    double lastAngle = std::numeric_limits<double>::quiet_NaN();
+
+    /** @brief Unit vector pointing along lastAngle. */
+    inet::Coord lastDirection;
+
+    /** @brief Recomputes lastOrientation and lastDirection, unless the angle is unchanged. */
+    void setAngle(double angle);
+
     mutable TraCIScenarioManager* manager = nullptr; /**< cached value */
     mutable TraCICommandInterface* commandInterface = nullptr; /**< cached value */
     mutable TraCICommandInterface::Vehicle* vehicleCommandInterface = nullptr; /**< cached value */
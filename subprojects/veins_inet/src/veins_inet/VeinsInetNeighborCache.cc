@@ -0,0 +1,152 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins_inet/VeinsInetNeighborCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "inet/mobility/contract/IMobility.h"
+
+using veins::VeinsInetNeighborCache;
+using inet::physicallayer::IRadio;
+
+Define_Module(veins::VeinsInetNeighborCache);
+
+void VeinsInetNeighborCache::initialize(int stage)
+{
+    if (stage == inet::INITSTAGE_LOCAL) {
+        radioMedium = check_and_cast<inet::physicallayer::RadioMedium*>(getParentModule());
+        cellSize = par("cellSize");
+        if (cellSize < 0) throw cRuntimeError("cellSize must not be negative");
+
+        // any radio moving invalidates the grid
+        auto onMove = [this](SignalPayload<cObject*>) { dirty = true; };
+        signalManager.subscribeCallback(getSystemModule(), inet::IMobility::mobilityStateChangedSignal, onMove);
+    }
+}
+
+void VeinsInetNeighborCache::handleMessage(cMessage* msg)
+{
+    throw cRuntimeError("VeinsInetNeighborCache does not handle messages");
+}
+
+void VeinsInetNeighborCache::finish()
+{
+    recordScalar("gridRebuilds", numRebuilds);
+}
+
+void VeinsInetNeighborCache::addRadio(const IRadio* radio)
+{
+    radios.push_back(radio);
+    dirty = true;
+}
+
+void VeinsInetNeighborCache::removeRadio(const IRadio* radio)
+{
+    auto it = std::find(radios.begin(), radios.end(), radio);
+    if (it == radios.end()) throw cRuntimeError("Cannot remove radio that was never added");
+    radios.erase(it);
+    dirty = true;
+}
+
+void VeinsInetNeighborCache::rebuild(double size) const
+{
+    gridCellSize = size;
+
+    double maxX = 0;
+    double maxY = 0;
+    gridMinX = 0;
+    gridMinY = 0;
+    for (size_t i = 0; i < radios.size(); ++i) {
+        const inet::Coord pos = radios[i]->getAntenna()->getMobility()->getCurrentPosition();
+        if (i == 0 || pos.x < gridMinX) gridMinX = pos.x;
+        if (i == 0 || pos.y < gridMinY) gridMinY = pos.y;
+        if (i == 0 || pos.x > maxX) maxX = pos.x;
+        if (i == 0 || pos.y > maxY) maxY = pos.y;
+    }
+    gridColumns = static_cast<int>((maxX - gridMinX) / gridCellSize) + 1;
+    gridRows = static_cast<int>((maxY - gridMinY) / gridCellSize) + 1;
+
+    for (auto& cell : cells) {
+        cell.radios.clear();
+        cell.xs.clear();
+        cell.ys.clear();
+        cell.zs.clear();
+    }
+    cells.resize(static_cast<size_t>(gridColumns) * gridRows);
+
+    for (const IRadio* radio : radios) {
+        const inet::Coord pos = radio->getAntenna()->getMobility()->getCurrentPosition();
+        const int column = static_cast<int>((pos.x - gridMinX) / gridCellSize);
+        const int row = static_cast<int>((pos.y - gridMinY) / gridCellSize);
+        Cell& cell = cells[static_cast<size_t>(row) * gridColumns + column];
+        cell.radios.push_back(radio);
+        cell.xs.push_back(pos.x);
+        cell.ys.push_back(pos.y);
+        cell.zs.push_back(pos.z);
+    }
+
+    dirty = false;
+    ++numRebuilds;
+}
+
+void VeinsInetNeighborCache::sendToNeighbors(IRadio* transmitter, const WirelessSignal* signal, double range) const
+{
+    // without a (finite) range, every radio is a neighbor
+    if (!(range < std::numeric_limits<double>::infinity())) {
+        for (const IRadio* radio : radios) {
+            radioMedium->sendToRadio(transmitter, radio, signal);
+        }
+        return;
+    }
+
+    const double size = cellSize > 0 ? cellSize : (gridCellSize > 0 ? gridCellSize : range);
+    if (dirty || size != gridCellSize) rebuild(size);
+    if (radios.empty()) return;
+
+    const inet::Coord inetPos = transmitter->getAntenna()->getMobility()->getCurrentPosition();
+    const Coord pos(inetPos.x, inetPos.y, inetPos.z);
+    const double sqrRange = range * range;
+    const int reach = static_cast<int>(std::ceil(range / gridCellSize));
+    const int column = static_cast<int>(std::floor((pos.x - gridMinX) / gridCellSize));
+    const int row = static_cast<int>(std::floor((pos.y - gridMinY) / gridCellSize));
+
+    for (int r = std::max(0, row - reach); r <= std::min(gridRows - 1, row + reach); ++r) {
+        for (int c = std::max(0, column - reach); c <= std::min(gridColumns - 1, column + reach); ++c) {
+            const Cell& cell = cells[static_cast<size_t>(r) * gridColumns + c];
+            const size_t n = cell.radios.size();
+            if (n == 0) continue;
+            sqrDistances.resize(n);
+            distancesSquared(pos, cell.xs.data(), cell.ys.data(), cell.zs.data(), n, sqrDistances.data());
+            for (size_t i = 0; i < n; ++i) {
+                if (sqrDistances[i] <= sqrRange) radioMedium->sendToRadio(transmitter, cell.radios[i], signal);
+            }
+        }
+    }
+}
+
+std::ostream& VeinsInetNeighborCache::printToStream(std::ostream& stream, int level, int evFlags) const
+{
+    return stream << "VeinsInetNeighborCache, " << radios.size() << " radios";
+}
@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins_inet/veins_inet.h"
+
+#if INET_VERSION >= 0x0403
+#include "inet/physicallayer/wireless/common/contract/packetlevel/INeighborCache.h"
+#include "inet/physicallayer/wireless/common/medium/RadioMedium.h"
+#else
+#include "inet/physicallayer/contract/packetlevel/INeighborCache.h"
+#include "inet/physicallayer/common/packetlevel/RadioMedium.h"
+#endif
+
+#include "veins/base/utils/Coord.h"
+#include "veins/modules/utility/SignalManager.h"
+
+namespace veins {
+
+/**
+ * @brief Neighbor cache of an INET radio medium that finds receivers the way veins' ConnectionManager does.
+ *
+ * Radios are kept in a grid of square cells (as large as the range of a transmission, unless cellSize is set).
+ * A transmission is only passed to the radios of the cells within range, and of those only to radios that are within range,
+ * checked in one batch per cell (see veins::distancesSquared()).
+ *
+ * Unlike INET's GridNeighborCache, the grid is not refilled periodically (with a margin for movement in between), but exactly when needed:
+ * the grid is rebuilt before the first transmission after any radio was added, removed, or moved.
+ * As VeinsInetMobility moves all vehicles at once per TraCI time step, this happens at most once per step.
+ */
+class VEINS_INET_API VeinsInetNeighborCache : public cSimpleModule, public inet::physicallayer::INeighborCache {
+public:
+#if INET_VERSION >= 0x0403
+    using WirelessSignal = inet::physicallayer::IWirelessSignal;
+#else
+    using WirelessSignal = inet::physicallayer::ISignal;
+#endif
+
+    void addRadio(const inet::physicallayer::IRadio* radio) override;
+    void removeRadio(const inet::physicallayer::IRadio* radio) override;
+    void sendToNeighbors(inet::physicallayer::IRadio* transmitter, const WirelessSignal* signal, double range) const override;
+
+    std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+
+    /**
+     * @brief Returns how often the grid was rebuilt so far.
+     */
+    long getNumRebuilds() const
+    {
+        return numRebuilds;
+    }
+
+protected:
+    /**
+     * @brief Radios of one grid cell, with their positions as of the last rebuild.
+     */
+    struct Cell {
+        std::vector<const inet::physicallayer::IRadio*> radios;
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<double> zs;
+    };
+
+    int numInitStages() const override
+    {
+        return inet::NUM_INIT_STAGES;
+    }
+    void initialize(int stage) override;
+    void handleMessage(cMessage* msg) override;
+    void finish() override;
+
+    /** @brief Sorts all radios into cells of the given size. */
+    void rebuild(double cellSize) const;
+
+    inet::physicallayer::RadioMedium* radioMedium = nullptr;
+    std::vector<const inet::physicallayer::IRadio*> radios;
+    double cellSize = 0; ///< as configured (0: the range of the first transmission)
+    SignalManager signalManager;
+
+    // the grid, rebuilt lazily by sendToNeighbors
+    mutable bool dirty = true;
+    mutable std::vector<Cell> cells; ///< row by row (kept to reuse their storage)
+    mutable double gridCellSize = 0;
+    mutable double gridMinX = 0;
+    mutable double gridMinY = 0;
+    mutable int gridColumns = 0;
+    mutable int gridRows = 0;
+    mutable std::vector<double> sqrDistances; ///< scratch space for range checks
+    mutable long numRebuilds = 0;
+};
+
+} // namespace veins
@@ -0,0 +1,58 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins_inet/VeinsInetObstacleLoss.h"
+
+using veins::VeinsInetObstacleLoss;
+
+Define_Module(veins::VeinsInetObstacleLoss);
+
+void VeinsInetObstacleLoss::initialize(int stage)
+{
+    if (stage == inet::INITSTAGE_LOCAL) {
+        obstacleControl = ObstacleControlAccess().getIfExists();
+        if (!obstacleControl) throw cRuntimeError("VeinsInetObstacleLoss needs an ObstacleControl module named obstacles in the network");
+    }
+}
+
+void VeinsInetObstacleLoss::handleMessage(cMessage* msg)
+{
+    throw cRuntimeError("VeinsInetObstacleLoss does not handle messages");
+}
+
+void VeinsInetObstacleLoss::finish()
+{
+    recordScalar("obstacleLossComputations", numComputations);
+}
+
+double VeinsInetObstacleLoss::computeObstacleLoss(inet::Hz frequency, const inet::Coord& transmissionPosition, const inet::Coord& receptionPosition) const
+{
+    numComputations++;
+    const Coord senderPos(transmissionPosition.x, transmissionPosition.y, transmissionPosition.z);
+    const Coord receiverPos(receptionPosition.x, receptionPosition.y, receptionPosition.z);
+    return obstacleControl->calculateAttenuation(senderPos, receiverPos);
+}
+
+std::ostream& VeinsInetObstacleLoss::printToStream(std::ostream& stream, int level, int evFlags) const
+{
+    return stream << "VeinsInetObstacleLoss";
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2026 Veins contributors
+//
+// Documentation for these modules is at http://veins.car2x.org/
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins_inet/veins_inet.h"
+
+#if INET_VERSION >= 0x0403
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IObstacleLoss.h"
+#else
+#include "inet/physicallayer/contract/packetlevel/IObstacleLoss.h"
+#endif
+
+#include "veins/modules/obstacle/ObstacleControl.h"
+
+namespace veins {
+
+/**
+ * @brief Obstacle loss of an INET radio medium that is computed by veins' ObstacleControl.
+ *
+ * Obstacles are those of the ObstacleControl module of the network (named obstacles), i.e., the polygons it loaded or that
+ * the TraCI scenario manager added from SUMO, rather than the objects of INET's physical environment.
+ * Lookups hence use its spatial index and attenuation cache.
+ * INET and veins share the same coordinates (see VeinsInetMobility), so positions are passed on unchanged.
+ *
+ * The attenuation model of ObstacleControl (per wall cut and per meter within obstacles) does not depend on the frequency.
+ */
+class VEINS_INET_API VeinsInetObstacleLoss : public cSimpleModule, public inet::physicallayer::IObstacleLoss {
+public:
+    double computeObstacleLoss(inet::Hz frequency, const inet::Coord& transmissionPosition, const inet::Coord& receptionPosition) const override;
+
+    std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+
+protected:
+    int numInitStages() const override
+    {
+        return inet::NUM_INIT_STAGES;
+    }
+    void initialize(int stage) override;
+    void handleMessage(cMessage* msg) override;
+    void finish() override;
+
+    ObstacleControl* obstacleControl = nullptr;
+    mutable long numComputations = 0;
+};
+
+} // namespace veins
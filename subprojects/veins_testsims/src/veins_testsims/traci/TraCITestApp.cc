@@ -145,7 +145,7 @@ void TraCITestApp::performTest(const simtime_t t)
             assertTrue("(TraCICommandInterface::addVehicle) command reports success", r);
         }
         if (t == 30) {
-            std::map<std::string, cModule*>::const_iterator i = mobility->getManager()->getManagedHosts().find("testVehicle0");
+            auto i = mobility->getManager()->getManagedHosts().find("testVehicle0");
             bool r = (i != mobility->getManager()->getManagedHosts().end());
             assertTrue("(TraCICommandInterface::addVehicle) vehicle now driving", r);
             if (r) {